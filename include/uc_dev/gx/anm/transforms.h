@@ -4,6 +4,7 @@
 #include <uc_dev/gx/structs.h>
 #include <uc_dev/math/quaternion.h>
 #include <uc_dev/math/graphics.h>
+#include <uc_dev/math/geometry.h>
 
 namespace uc
 {
@@ -26,6 +27,9 @@ namespace uc
             //concatenates all transforms from the root to the children
             std::vector< math::float4x4 >  local_to_world_joints2(const lip::skeleton* s, const std::vector<math::float4x4>& local_transforms, math::afloat4x4 locomotion_transform = math::identity_matrix());
             std::vector< gx::position_3d > skeleton_positions(const lip::skeleton* skeleton, const std::vector< math::float4x4>& local_transforms, math::afloat4x4 locomotion_transform = math::identity_matrix());
+
+            //bounds of the joint bounding volumes moved into the pose. joints are the concatenated transforms from local_to_world_joints2
+            math::aabb skeleton_bounds(const lip::skeleton* s, const std::vector<math::float4x4>& joints);
         }
     }
 }
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <uc_dev/gx/cmd/commands.h>
+#include <uc_dev/gx/cmd/command_stream.h>
+#include <uc_dev/gx/cmd/resource_state_tracker.h>
+#include <uc_dev/gx/cmd/null_backend.h>
+#include <uc_dev/gx/cmd/state_filter.h>
+#include <uc_dev/gx/cmd/indirect_draw_buffer.h>
+#include <uc_dev/gx/cmd/render_queue.h>
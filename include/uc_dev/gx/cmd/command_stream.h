@@ -0,0 +1,363 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <uc_dev/gx/cmd/commands.h>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+            //linear buffer of commands, recorded by the render worlds and replayed by a backend
+            //the memory is kept across reset, so a stream recorded every frame stops allocating after the first frames
+            //not thread safe, record one stream per thread
+            class command_stream
+            {
+                public:
+
+                explicit command_stream(size_t block_size = 64 * 1024);
+
+                command_stream(const command_stream&) = delete;
+                command_stream& operator=(const command_stream&) = delete;
+
+                command_stream(command_stream&&) = default;
+                command_stream& operator=(command_stream&&) = default;
+
+                //drops the commands, keeps the memory
+                void reset();
+
+                uint32_t command_count() const
+                {
+                    return m_command_count;
+                }
+
+                //bytes of the commands
+                size_t size() const;
+
+                //bytes of the blocks
+                size_t capacity() const;
+
+                void set_graphics_pipeline_state(const void* p)
+                {
+                    push<set_graphics_pipeline_state_command>()->m_pipeline_state = p;
+                }
+
+                void set_compute_pipeline_state(const void* p)
+                {
+                    push<set_compute_pipeline_state_command>()->m_pipeline_state = p;
+                }
+
+                void set_descriptor_heaps()
+                {
+                    push<set_descriptor_heaps_command>();
+                }
+
+                void set_render_targets(view color, view depth)
+                {
+                    auto c      = push<set_render_targets_command>();
+                    c->m_color  = color;
+                    c->m_depth  = depth;
+                }
+
+                void clear_render_target(view target)
+                {
+                    push<clear_render_target_command>()->m_target = target;
+                }
+
+                void clear_depth_stencil(view target, uint32_t flags, float depth, uint32_t stencil)
+                {
+                    auto c          = push<clear_depth_stencil_command>();
+                    c->m_target     = target;
+                    c->m_depth      = depth;
+                    c->m_stencil    = stencil;
+                    c->m_flags      = flags;
+                }
+
+                void set_view_port(const view_port& v)
+                {
+                    push<set_view_port_command>()->m_view_port = v;
+                }
+
+                void set_scissor_rectangle(const rectangle& r)
+                {
+                    push<set_scissor_rectangle_command>()->m_rectangle = r;
+                }
+
+                void set_primitive_topology(uint32_t topology)
+                {
+                    push<set_primitive_topology_command>()->m_topology = topology;
+                }
+
+                void set_vertex_buffer(uint32_t slot, const vertex_buffer_view& v)
+                {
+                    auto c      = push<set_vertex_buffer_command>();
+                    c->m_slot   = slot;
+                    c->m_view   = v;
+                }
+
+                void set_index_buffer(const index_buffer_view& v)
+                {
+                    push<set_index_buffer_command>()->m_view = v;
+                }
+
+                void set_graphics_constant_buffer(uint32_t root_index, const void* buffer, size_t byte_count)
+                {
+                    push_constants<set_graphics_constant_buffer_command>(root_index, 0, buffer, byte_count);
+                }
+
+                void set_compute_constant_buffer(uint32_t root_index, const void* buffer, size_t byte_count)
+                {
+                    push_constants<set_compute_constant_buffer_command>(root_index, 0, buffer, byte_count);
+                }
+
+                void set_graphics_dynamic_constant_buffer(uint32_t root_index, uint32_t offset, const void* buffer, size_t byte_count)
+                {
+                    push_constants<set_graphics_dynamic_constant_buffer_command>(root_index, offset, buffer, byte_count);
+                }
+
+                void set_compute_dynamic_constant_buffer(uint32_t root_index, uint32_t offset, const void* buffer, size_t byte_count)
+                {
+                    push_constants<set_compute_dynamic_constant_buffer_command>(root_index, offset, buffer, byte_count);
+                }
+
+                void set_graphics_dynamic_descriptor(uint32_t root_index, uint64_t descriptor, uint32_t offset = 0)
+                {
+                    push_descriptor<set_graphics_dynamic_descriptor_command>(root_index, offset, descriptor);
+                }
+
+                void set_compute_dynamic_descriptor(uint32_t root_index, uint64_t descriptor, uint32_t offset = 0)
+                {
+                    push_descriptor<set_compute_dynamic_descriptor_command>(root_index, offset, descriptor);
+                }
+
+                void set_graphics_root_constant(uint32_t root_index, uint32_t value)
+                {
+                    auto c              = push<set_graphics_root_constant_command>();
+                    c->m_root_index     = root_index;
+                    c->m_value          = value;
+                }
+
+                void set_graphics_bindless_table(uint32_t root_index)
+                {
+                    push<set_graphics_bindless_table_command>()->m_root_index = root_index;
+                }
+
+                void set_graphics_dynamic_srv_buffer(uint32_t root_index, const void* buffer, size_t byte_count)
+                {
+                    push_constants<set_graphics_dynamic_srv_buffer_command>(root_index, 0, buffer, byte_count);
+                }
+
+                void track_resource(const void* resource, uint32_t state, uint32_t subresource_count = 1)
+                {
+                    auto c                  = push<track_resource_command>();
+                    c->m_resource           = resource;
+                    c->m_state              = state;
+                    c->m_subresource_count  = subresource_count;
+                }
+
+                //from the tracked state
+                void transition_resource(const void* resource, uint32_t after)
+                {
+                    push_transition(resource, all_subresources, resource_state_unknown, after, barrier_flags_none);
+                }
+
+                //before is used if the resource is not tracked
+                void transition_resource(const void* resource, uint32_t before, uint32_t after)
+                {
+                    push_transition(resource, all_subresources, before, after, barrier_flags_none);
+                }
+
+                void transition_subresource(const void* resource, uint32_t subresource, uint32_t after)
+                {
+                    push_transition(resource, subresource, resource_state_unknown, after, barrier_flags_none);
+                }
+
+                void begin_transition_resource(const void* resource, uint32_t after)
+                {
+                    push_transition(resource, all_subresources, resource_state_unknown, after, barrier_flags_begin_only);
+                }
+
+                void end_transition_resource(const void* resource)
+                {
+                    push_transition(resource, all_subresources, resource_state_unknown, resource_state_unknown, barrier_flags_end_only);
+                }
+
+                void aliasing_barrier(const void* before, const void* after)
+                {
+                    auto c                  = push<aliasing_barrier_command>();
+                    c->m_before             = before;
+                    c->m_after              = after;
+                }
+
+                void draw_instanced(uint32_t vertex_count_per_instance, uint32_t instance_count, uint32_t start_vertex_location = 0, uint32_t start_instance_location = 0)
+                {
+                    auto c                          = push<draw_instanced_command>();
+                    c->m_vertex_count_per_instance  = vertex_count_per_instance;
+                    c->m_instance_count             = instance_count;
+                    c->m_start_vertex_location      = start_vertex_location;
+                    c->m_start_instance_location    = start_instance_location;
+                }
+
+                void draw_indexed_instanced(uint32_t index_count_per_instance, uint32_t instance_count, uint32_t start_index_location, int32_t base_vertex_location, uint32_t start_instance_location)
+                {
+                    auto c                          = push<draw_indexed_instanced_command>();
+                    c->m_index_count_per_instance   = index_count_per_instance;
+                    c->m_instance_count             = instance_count;
+                    c->m_start_index_location       = start_index_location;
+                    c->m_base_vertex_location       = base_vertex_location;
+                    c->m_start_instance_location    = start_instance_location;
+                }
+
+                //root_index is the root constant the signature writes the draw ids to
+                void draw_indexed_indirect(const void* signature, uint32_t root_index, const draw_indexed_instance_arguments arguments[], uint32_t count)
+                {
+                    auto byte_count     = count * sizeof(draw_indexed_instance_arguments);
+                    auto c              = push<draw_indexed_indirect_command>(byte_count);
+                    c->m_signature      = signature;
+                    c->m_count          = count;
+                    c->m_root_index     = root_index;
+                    std::memcpy(const_cast<void*>(payload(c)), arguments, byte_count);
+                }
+
+                void dispatch(uint32_t thread_group_count_x, uint32_t thread_group_count_y = 1, uint32_t thread_group_count_z = 1)
+                {
+                    auto c                      = push<dispatch_command>();
+                    c->m_thread_group_count_x   = thread_group_count_x;
+                    c->m_thread_group_count_y   = thread_group_count_y;
+                    c->m_thread_group_count_z   = thread_group_count_z;
+                }
+
+                void begin_event(const wchar_t* label)
+                {
+                    auto length = static_cast<uint32_t>(std::wcslen(label) + 1);
+                    auto c      = push<begin_event_command>(length * sizeof(wchar_t));
+                    c->m_length = length;
+                    std::memcpy(const_cast<void*>(payload(c)), label, length * sizeof(wchar_t));
+                }
+
+                void end_event()
+                {
+                    push<end_event_command>();
+                }
+
+                //visits the commands in the recorded order
+                template <typename function_t> void for_each(function_t&& f) const
+                {
+                    for (auto i = 0U; i < m_blocks.size() && i <= m_block; ++i)
+                    {
+                        auto&& b     = m_blocks[i];
+                        auto   begin = b.m_data;
+                        auto   end   = begin + b.m_size;
+
+                        while (begin < end)
+                        {
+                            auto c = reinterpret_cast<const command*>(begin);
+                            f(c);
+                            begin += c->m_size;
+                        }
+                    }
+                }
+
+                private:
+
+                struct block
+                {
+                    std::unique_ptr<uint64_t[]> m_storage;          //8 byte aligned
+                    uint8_t*                    m_data      = nullptr;
+                    size_t                      m_size      = 0;
+                    size_t                      m_capacity  = 0;
+                };
+
+                std::vector<block>  m_blocks;
+                uint32_t            m_block         = 0;
+                uint32_t            m_command_count = 0;
+                size_t              m_block_size;
+
+                void* allocate(size_t size);
+
+                template <typename t> t* push(size_t payload_size = 0)
+                {
+                    const auto size = static_cast<uint32_t>( ((sizeof(t) + 7) & ~std::size_t(7)) + ((payload_size + 7) & ~std::size_t(7)) );
+                    auto c      = new (allocate(size)) t();
+                    c->m_type   = t::type;
+                    c->m_size   = size;
+                    m_command_count++;
+                    return c;
+                }
+
+                template <typename t> void push_constants(uint32_t root_index, uint32_t offset, const void* buffer, size_t byte_count)
+                {
+                    auto c              = push<t>(byte_count);
+                    c->m_root_index     = root_index;
+                    c->m_offset         = offset;
+                    c->m_byte_count     = static_cast<uint32_t>(byte_count);
+                    std::memcpy(const_cast<void*>(payload(c)), buffer, byte_count);
+                }
+
+                void push_transition(const void* resource, uint32_t subresource, uint32_t before, uint32_t after, uint32_t flags)
+                {
+                    auto c              = push<transition_resource_command>();
+                    c->m_resource       = resource;
+                    c->m_subresource    = subresource;
+                    c->m_before         = before;
+                    c->m_after          = after;
+                    c->m_flags          = flags;
+                }
+
+                template <typename t> void push_descriptor(uint32_t root_index, uint32_t offset, uint64_t descriptor)
+                {
+                    auto c              = push<t>();
+                    c->m_root_index     = root_index;
+                    c->m_offset         = offset;
+                    c->m_descriptor     = descriptor;
+                }
+            };
+
+            //replays the stream, the backend has an on() overload for every command
+            template <typename backend_t> inline void execute(const command_stream& s, backend_t& b)
+            {
+                s.for_each([&b](const command* c)
+                {
+                    switch (c->m_type)
+                    {
+                        case command_type::set_graphics_pipeline_state:             b.on(*static_cast<const set_graphics_pipeline_state_command*>(c)); break;
+                        case command_type::set_compute_pipeline_state:              b.on(*static_cast<const set_compute_pipeline_state_command*>(c)); break;
+                        case command_type::set_descriptor_heaps:                    b.on(*static_cast<const set_descriptor_heaps_command*>(c)); break;
+                        case command_type::set_render_targets:                      b.on(*static_cast<const set_render_targets_command*>(c)); break;
+                        case command_type::clear_render_target:                     b.on(*static_cast<const clear_render_target_command*>(c)); break;
+                        case command_type::clear_depth_stencil:                     b.on(*static_cast<const clear_depth_stencil_command*>(c)); break;
+                        case command_type::set_view_port:                           b.on(*static_cast<const set_view_port_command*>(c)); break;
+                        case command_type::set_scissor_rectangle:                   b.on(*static_cast<const set_scissor_rectangle_command*>(c)); break;
+                        case command_type::set_primitive_topology:                  b.on(*static_cast<const set_primitive_topology_command*>(c)); break;
+                        case command_type::set_vertex_buffer:                       b.on(*static_cast<const set_vertex_buffer_command*>(c)); break;
+                        case command_type::set_index_buffer:                        b.on(*static_cast<const set_index_buffer_command*>(c)); break;
+                        case command_type::set_graphics_constant_buffer:            b.on(*static_cast<const set_graphics_constant_buffer_command*>(c)); break;
+                        case command_type::set_compute_constant_buffer:             b.on(*static_cast<const set_compute_constant_buffer_command*>(c)); break;
+                        case command_type::set_graphics_dynamic_constant_buffer:    b.on(*static_cast<const set_graphics_dynamic_constant_buffer_command*>(c)); break;
+                        case command_type::set_compute_dynamic_constant_buffer:     b.on(*static_cast<const set_compute_dynamic_constant_buffer_command*>(c)); break;
+                        case command_type::set_graphics_dynamic_descriptor:         b.on(*static_cast<const set_graphics_dynamic_descriptor_command*>(c)); break;
+                        case command_type::set_compute_dynamic_descriptor:          b.on(*static_cast<const set_compute_dynamic_descriptor_command*>(c)); break;
+                        case command_type::transition_resource:                     b.on(*static_cast<const transition_resource_command*>(c)); break;
+                        case command_type::draw_instanced:                          b.on(*static_cast<const draw_instanced_command*>(c)); break;
+                        case command_type::draw_indexed_instanced:                  b.on(*static_cast<const draw_indexed_instanced_command*>(c)); break;
+                        case command_type::dispatch:                                b.on(*static_cast<const dispatch_command*>(c)); break;
+                        case command_type::begin_event:                             b.on(*static_cast<const begin_event_command*>(c)); break;
+                        case command_type::end_event:                               b.on(*static_cast<const end_event_command*>(c)); break;
+                        case command_type::track_resource:                          b.on(*static_cast<const track_resource_command*>(c)); break;
+                        case command_type::aliasing_barrier:                        b.on(*static_cast<const aliasing_barrier_command*>(c)); break;
+                        case command_type::set_graphics_root_constant:              b.on(*static_cast<const set_graphics_root_constant_command*>(c)); break;
+                        case command_type::set_graphics_bindless_table:             b.on(*static_cast<const set_graphics_bindless_table_command*>(c)); break;
+                        case command_type::set_graphics_dynamic_srv_buffer:         b.on(*static_cast<const set_graphics_dynamic_srv_buffer_command*>(c)); break;
+                        case command_type::draw_indexed_indirect:                   b.on(*static_cast<const draw_indexed_indirect_command*>(c)); break;
+                        default: break;
+                    }
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,399 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <uc_dev/gx/cmd/indirect_draw_buffer.h>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+            //the commands of a command_stream, plain data, so the streams can be recorded, validated and replayed without a device
+            //the handles are the objects of the backend, the stream only compares them
+            enum class command_type : uint16_t
+            {
+                set_graphics_pipeline_state,
+                set_compute_pipeline_state,
+                set_descriptor_heaps,
+                set_render_targets,
+                clear_render_target,
+                clear_depth_stencil,
+                set_view_port,
+                set_scissor_rectangle,
+                set_primitive_topology,
+                set_vertex_buffer,
+                set_index_buffer,
+                set_graphics_constant_buffer,
+                set_compute_constant_buffer,
+                set_graphics_dynamic_constant_buffer,
+                set_compute_dynamic_constant_buffer,
+                set_graphics_dynamic_descriptor,
+                set_compute_dynamic_descriptor,
+                transition_resource,
+                draw_instanced,
+                draw_indexed_instanced,
+                dispatch,
+                begin_event,
+                end_event,
+                track_resource,
+                aliasing_barrier,
+                set_graphics_root_constant,
+                set_graphics_bindless_table,
+                set_graphics_dynamic_srv_buffer,
+                draw_indexed_indirect,
+                count
+            };
+
+            //values of D3D_PRIMITIVE_TOPOLOGY
+            enum primitive_topology : uint32_t
+            {
+                primitive_topology_undefined        = 0,
+                primitive_topology_point_list       = 1,
+                primitive_topology_line_list        = 2,
+                primitive_topology_line_strip       = 3,
+                primitive_topology_triangle_list    = 4,
+                primitive_topology_triangle_strip   = 5
+            };
+
+            //values of DXGI_FORMAT
+            enum index_format : uint32_t
+            {
+                index_format_unknown                = 0,
+                index_format_r32_uint               = 42,
+                index_format_r16_uint               = 57
+            };
+
+            enum clear_flags : uint32_t
+            {
+                clear_depth                         = 0x1,
+                clear_stencil                       = 0x2
+            };
+
+            //values of D3D12_RESOURCE_STATES
+            enum resource_state : uint32_t
+            {
+                resource_state_common                       = 0,
+                resource_state_vertex_and_constant_buffer   = 0x1,
+                resource_state_index_buffer                 = 0x2,
+                resource_state_render_target                = 0x4,
+                resource_state_unordered_access             = 0x8,
+                resource_state_depth_write                  = 0x10,
+                resource_state_depth_read                   = 0x20,
+                resource_state_non_pixel_shader_resource    = 0x40,
+                resource_state_pixel_shader_resource        = 0x80,
+                resource_state_stream_out                   = 0x100,
+                resource_state_indirect_argument            = 0x200,
+                resource_state_copy_dest                    = 0x400,
+                resource_state_copy_source                  = 0x800,
+                resource_state_resolve_dest                 = 0x1000,
+                resource_state_resolve_source               = 0x2000,
+
+                resource_state_read_only                    = 0x1 | 0x2 | 0x20 | 0x40 | 0x80 | 0x200 | 0x800 | 0x2000,
+
+                resource_state_unknown                      = 0xFFFFFFFF
+            };
+
+            //values of D3D12_RESOURCE_BARRIER_FLAGS
+            enum barrier_flags : uint32_t
+            {
+                barrier_flags_none                          = 0,
+                barrier_flags_begin_only                    = 0x1,
+                barrier_flags_end_only                      = 0x2
+            };
+
+            //D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
+            const uint32_t all_subresources = 0xFFFFFFFF;
+
+            enum class view_type : uint32_t
+            {
+                none,
+                back_buffer,
+                color_buffer,
+                depth_buffer,
+                depth_stencil_buffer
+            };
+
+            //render target or depth buffer, the backend casts m_resource by m_type
+            struct view
+            {
+                const void* m_resource  = nullptr;
+                view_type   m_type      = view_type::none;
+            };
+
+            //layout of D3D12_VIEWPORT
+            struct view_port
+            {
+                float m_top_left_x;
+                float m_top_left_y;
+                float m_width;
+                float m_height;
+                float m_min_depth;
+                float m_max_depth;
+            };
+
+            //layout of D3D12_RECT
+            struct rectangle
+            {
+                int32_t m_left;
+                int32_t m_top;
+                int32_t m_right;
+                int32_t m_bottom;
+            };
+
+            //layout of D3D12_VERTEX_BUFFER_VIEW
+            struct vertex_buffer_view
+            {
+                uint64_t m_address;
+                uint32_t m_size;
+                uint32_t m_stride;
+            };
+
+            //layout of D3D12_INDEX_BUFFER_VIEW
+            struct index_buffer_view
+            {
+                uint64_t        m_address;
+                uint32_t        m_size;
+                index_format    m_format;
+            };
+
+            //every command starts with the header, m_size includes the header and the payload and keeps the next command 8 byte aligned
+            struct command
+            {
+                command_type    m_type;
+                uint16_t        m_reserved;
+                uint32_t        m_size;
+            };
+
+            struct set_graphics_pipeline_state_command : command
+            {
+                static constexpr command_type type = command_type::set_graphics_pipeline_state;
+                const void*     m_pipeline_state;
+            };
+
+            struct set_compute_pipeline_state_command : command
+            {
+                static constexpr command_type type = command_type::set_compute_pipeline_state;
+                const void*     m_pipeline_state;
+            };
+
+            //the shader visible heaps of the frame
+            struct set_descriptor_heaps_command : command
+            {
+                static constexpr command_type type = command_type::set_descriptor_heaps;
+            };
+
+            struct set_render_targets_command : command
+            {
+                static constexpr command_type type = command_type::set_render_targets;
+                view            m_color;
+                view            m_depth;
+            };
+
+            struct clear_render_target_command : command
+            {
+                static constexpr command_type type = command_type::clear_render_target;
+                view            m_target;
+            };
+
+            struct clear_depth_stencil_command : command
+            {
+                static constexpr command_type type = command_type::clear_depth_stencil;
+                view            m_target;
+                float           m_depth;
+                uint32_t        m_stencil;
+                uint32_t        m_flags;        //clear_flags
+            };
+
+            struct set_view_port_command : command
+            {
+                static constexpr command_type type = command_type::set_view_port;
+                view_port       m_view_port;
+            };
+
+            struct set_scissor_rectangle_command : command
+            {
+                static constexpr command_type type = command_type::set_scissor_rectangle;
+                rectangle       m_rectangle;
+            };
+
+            struct set_primitive_topology_command : command
+            {
+                static constexpr command_type type = command_type::set_primitive_topology;
+                uint32_t        m_topology;
+            };
+
+            struct set_vertex_buffer_command : command
+            {
+                static constexpr command_type type = command_type::set_vertex_buffer;
+                uint32_t            m_slot;
+                vertex_buffer_view  m_view;
+            };
+
+            struct set_index_buffer_command : command
+            {
+                static constexpr command_type type = command_type::set_index_buffer;
+                index_buffer_view   m_view;
+            };
+
+            //the constants follow the command, the backend copies them to the upload memory when it replays the stream
+            struct constant_buffer_command : command
+            {
+                uint32_t        m_root_index;
+                uint32_t        m_offset;       //in the descriptor table, for the dynamic constant buffers
+                uint32_t        m_byte_count;
+            };
+
+            struct set_graphics_constant_buffer_command : constant_buffer_command
+            {
+                static constexpr command_type type = command_type::set_graphics_constant_buffer;
+            };
+
+            struct set_compute_constant_buffer_command : constant_buffer_command
+            {
+                static constexpr command_type type = command_type::set_compute_constant_buffer;
+            };
+
+            struct set_graphics_dynamic_constant_buffer_command : constant_buffer_command
+            {
+                static constexpr command_type type = command_type::set_graphics_dynamic_constant_buffer;
+            };
+
+            struct set_compute_dynamic_constant_buffer_command : constant_buffer_command
+            {
+                static constexpr command_type type = command_type::set_compute_dynamic_constant_buffer;
+            };
+
+            //the buffer follows the command, the backend uploads it and binds its address as a root shader resource view
+            struct set_graphics_dynamic_srv_buffer_command : constant_buffer_command
+            {
+                static constexpr command_type type = command_type::set_graphics_dynamic_srv_buffer;
+            };
+
+            struct set_graphics_root_constant_command : command
+            {
+                static constexpr command_type type = command_type::set_graphics_root_constant;
+                uint32_t        m_root_index;
+                uint32_t        m_value;
+            };
+
+            //the bindless table of the frame descriptor heap
+            struct set_graphics_bindless_table_command : command
+            {
+                static constexpr command_type type = command_type::set_graphics_bindless_table;
+                uint32_t        m_root_index;
+            };
+
+            struct dynamic_descriptor_command : command
+            {
+                uint32_t        m_root_index;
+                uint32_t        m_offset;
+                uint64_t        m_descriptor;   //cpu descriptor handle
+            };
+
+            struct set_graphics_dynamic_descriptor_command : dynamic_descriptor_command
+            {
+                static constexpr command_type type = command_type::set_graphics_dynamic_descriptor;
+            };
+
+            struct set_compute_dynamic_descriptor_command : dynamic_descriptor_command
+            {
+                static constexpr command_type type = command_type::set_compute_dynamic_descriptor;
+            };
+
+            //the state the resource is in at this point of the stream, no barrier
+            struct track_resource_command : command
+            {
+                static constexpr command_type type = command_type::track_resource;
+                const void*     m_resource;
+                uint32_t        m_state;
+                uint32_t        m_subresource_count;
+            };
+
+            //m_before is resource_state_unknown for the transitions from the tracked state
+            //m_flags begin_only starts a split barrier, end_only ends it
+            struct transition_resource_command : command
+            {
+                static constexpr command_type type = command_type::transition_resource;
+                const void*     m_resource;
+                uint32_t        m_subresource;
+                uint32_t        m_before;       //D3D12_RESOURCE_STATES
+                uint32_t        m_after;
+                uint32_t        m_flags;        //barrier_flags
+            };
+
+            //m_after takes over the memory of m_before, placed resources in the same heap, m_before may be null
+            struct aliasing_barrier_command : command
+            {
+                static constexpr command_type type = command_type::aliasing_barrier;
+                const void*     m_before;
+                const void*     m_after;
+            };
+
+            struct draw_instanced_command : command
+            {
+                static constexpr command_type type = command_type::draw_instanced;
+                uint32_t        m_vertex_count_per_instance;
+                uint32_t        m_instance_count;
+                uint32_t        m_start_vertex_location;
+                uint32_t        m_start_instance_location;
+            };
+
+            struct draw_indexed_instanced_command : command
+            {
+                static constexpr command_type type = command_type::draw_indexed_instanced;
+                uint32_t        m_index_count_per_instance;
+                uint32_t        m_instance_count;
+                uint32_t        m_start_index_location;
+                int32_t         m_base_vertex_location;
+                uint32_t        m_start_instance_location;
+            };
+
+            //the arguments follow the command, draw_indexed_instance_arguments, the backend uploads them and executes the signature
+            //the signature writes the draw id to the root constant at m_root_index, so the last id stays there after the draws
+            struct draw_indexed_indirect_command : command
+            {
+                static constexpr command_type type = command_type::draw_indexed_indirect;
+                const void*     m_signature;
+                uint32_t        m_count;
+                uint32_t        m_root_index;
+            };
+
+            struct dispatch_command : command
+            {
+                static constexpr command_type type = command_type::dispatch;
+                uint32_t        m_thread_group_count_x;
+                uint32_t        m_thread_group_count_y;
+                uint32_t        m_thread_group_count_z;
+            };
+
+            //the zero terminated label follows the command
+            struct begin_event_command : command
+            {
+                static constexpr command_type type = command_type::begin_event;
+                uint32_t        m_length;       //characters, with the terminating zero
+            };
+
+            struct end_event_command : command
+            {
+                static constexpr command_type type = command_type::end_event;
+            };
+
+            //the bytes after the command, constants or labels
+            template <typename t> inline const void* payload(const t* c)
+            {
+                return reinterpret_cast<const uint8_t*>(c) + ((sizeof(t) + 7) & ~std::size_t(7));
+            }
+
+            inline const wchar_t* label(const begin_event_command* c)
+            {
+                return reinterpret_cast<const wchar_t*>(payload(c));
+            }
+
+            inline const draw_indexed_instance_arguments* arguments(const draw_indexed_indirect_command* c)
+            {
+                return reinterpret_cast<const draw_indexed_instance_arguments*>(payload(c));
+            }
+        }
+    }
+}
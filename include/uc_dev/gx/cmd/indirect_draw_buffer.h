@@ -0,0 +1,118 @@
+#pragma once
+
+#include <assert.h>
+#include <cstdint>
+#include <vector>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+            //arguments of one indexed draw, laid out as D3D12_DRAW_INDEXED_ARGUMENTS, so the array is the argument buffer of an indirect draw
+            struct draw_indexed_arguments
+            {
+                uint32_t        m_index_count_per_instance;
+                uint32_t        m_instance_count;
+                uint32_t        m_start_index_location;
+                int32_t         m_base_vertex_location;
+                uint32_t        m_start_instance_location;
+            };
+
+            static_assert(sizeof(draw_indexed_arguments) == 20, "draw_indexed_arguments must match D3D12_DRAW_INDEXED_ARGUMENTS");
+
+            //one draw of an indirect draw with a draw id, the id goes to a root constant before the draw arguments
+            //the shaders fetch the instance data with the id, so the draws of many instances need no binds in between
+            struct draw_indexed_instance_arguments
+            {
+                uint32_t                m_instance;
+                draw_indexed_arguments  m_draw;
+            };
+
+            static_assert(sizeof(draw_indexed_instance_arguments) == 24, "draw_indexed_instance_arguments must match a 32 bit constant followed by D3D12_DRAW_INDEXED_ARGUMENTS");
+
+            //scene wide instance data and indirect draw arguments, built on the cpu in one pass over the scene
+            //the instances are uploaded as one structured buffer and all draws go in one indirect draw
+            template <typename instance_t>
+            class indirect_draw_buffer
+            {
+                public:
+
+                //starts the draws of a new instance
+                uint32_t add_instance(const instance_t& instance)
+                {
+                    auto r = static_cast<uint32_t>(m_instances.size());
+                    m_instances.push_back(instance);
+                    return r;
+                }
+
+                //adds a draw to the last instance, a draw which continues the index range of the previous one of the same instance extends it
+                void add_draw(uint32_t index_count, uint32_t start_index, int32_t base_vertex)
+                {
+                    assert(!m_instances.empty());
+
+                    if (index_count == 0)
+                    {
+                        return;
+                    }
+
+                    auto instance = static_cast<uint32_t>(m_instances.size() - 1);
+
+                    if (!m_arguments.empty())
+                    {
+                        auto&& last = m_arguments.back();
+
+                        if (last.m_instance == instance && last.m_draw.m_base_vertex_location == base_vertex && last.m_draw.m_start_index_location + last.m_draw.m_index_count_per_instance == start_index)
+                        {
+                            last.m_draw.m_index_count_per_instance += index_count;
+                            return;
+                        }
+                    }
+
+                    m_arguments.push_back({ instance, { index_count, 1, start_index, base_vertex, 0 } });
+                }
+
+                //adds the primitive ranges of a mesh, the ranges have m_begin and size() in indices from base_index
+                template <typename ranges_t>
+                void add_draws(const ranges_t& ranges, uint32_t base_index, int32_t base_vertex)
+                {
+                    for (auto&& r : ranges)
+                    {
+                        add_draw(static_cast<uint32_t>(r.size()), static_cast<uint32_t>(r.m_begin) + base_index, base_vertex);
+                    }
+                }
+
+                const std::vector<draw_indexed_instance_arguments>& arguments() const
+                {
+                    return m_arguments;
+                }
+
+                const std::vector<instance_t>& instances() const
+                {
+                    return m_instances;
+                }
+
+                uint32_t draw_count() const
+                {
+                    return static_cast<uint32_t>(m_arguments.size());
+                }
+
+                uint32_t instance_count() const
+                {
+                    return static_cast<uint32_t>(m_instances.size());
+                }
+
+                //keeps the memory for the next frame
+                void clear()
+                {
+                    m_arguments.clear();
+                    m_instances.clear();
+                }
+
+                private:
+
+                std::vector<draw_indexed_instance_arguments>    m_arguments;
+                std::vector<instance_t>                         m_instances;
+            };
+        }
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <uc_dev/gx/cmd/command_stream.h>
+#include <uc_dev/gx/cmd/resource_state_tracker.h>
+#include <uc_dev/gx/cmd/state_filter.h>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+            struct null_backend_statistics
+            {
+                std::array<uint32_t, static_cast<uint32_t>(command_type::count)> m_commands = {};
+
+                uint32_t m_draws                = 0;
+                uint64_t m_vertices             = 0;    //vertices or indices, times the instances
+                uint32_t m_dispatches           = 0;
+                uint64_t m_thread_groups        = 0;
+                uint64_t m_constant_bytes       = 0;    //uploaded, the repeated root constants are dropped
+                uint32_t m_transitions          = 0;
+                uint32_t m_barriers             = 0;    //after the elimination and the merging of the transitions
+                uint32_t m_barrier_batches      = 0;
+                uint32_t m_aliasing_barriers    = 0;
+                uint32_t m_pipeline_changes     = 0;
+            };
+
+            //replays the streams without a device
+            //counts the work and checks the state the draws and dispatches need, for benchmarks and for validation of the recording code
+            class null_backend
+            {
+                public:
+
+                void on(const set_graphics_pipeline_state_command& c);
+                void on(const set_compute_pipeline_state_command& c);
+                void on(const set_descriptor_heaps_command& c);
+                void on(const set_render_targets_command& c);
+                void on(const clear_render_target_command& c);
+                void on(const clear_depth_stencil_command& c);
+                void on(const set_view_port_command& c);
+                void on(const set_scissor_rectangle_command& c);
+                void on(const set_primitive_topology_command& c);
+                void on(const set_vertex_buffer_command& c);
+                void on(const set_index_buffer_command& c);
+                void on(const set_graphics_constant_buffer_command& c);
+                void on(const set_compute_constant_buffer_command& c);
+                void on(const set_graphics_dynamic_constant_buffer_command& c);
+                void on(const set_compute_dynamic_constant_buffer_command& c);
+                void on(const set_graphics_dynamic_descriptor_command& c);
+                void on(const set_compute_dynamic_descriptor_command& c);
+                void on(const transition_resource_command& c);
+                void on(const draw_instanced_command& c);
+                void on(const draw_indexed_instanced_command& c);
+                void on(const dispatch_command& c);
+                void on(const begin_event_command& c);
+                void on(const end_event_command& c);
+                void on(const track_resource_command& c);
+                void on(const aliasing_barrier_command& c);
+                void on(const set_graphics_root_constant_command& c);
+                void on(const set_graphics_bindless_table_command& c);
+                void on(const set_graphics_dynamic_srv_buffer_command& c);
+                void on(const draw_indexed_indirect_command& c);
+
+                //checks the state at the end of the stream, the events must be balanced
+                void finish();
+
+                //clears the state and the statistics
+                void reset();
+
+                const null_backend_statistics& statistics() const
+                {
+                    return m_statistics;
+                }
+
+                const resource_state_tracker& resource_states() const
+                {
+                    return m_resource_states;
+                }
+
+                //the state commands a context would issue and drop
+                const state_filter_statistics& state_statistics() const
+                {
+                    return m_state_filter.statistics();
+                }
+
+                uint32_t error_count() const
+                {
+                    return m_error_count;
+                }
+
+                //the first errors, the rest are only counted
+                const std::vector<std::string>& errors() const
+                {
+                    return m_errors;
+                }
+
+                private:
+
+                null_backend_statistics     m_statistics;
+                resource_state_tracker      m_resource_states;
+                state_filter                m_state_filter;
+                std::vector<std::string>    m_errors;
+                uint32_t                    m_error_count       = 0;
+                uint32_t                    m_command           = 0;    //index of the command in the replay, for the errors
+
+                const void*                 m_graphics_pso      = nullptr;
+                const void*                 m_compute_pso       = nullptr;
+                const void*                 m_last_pso          = nullptr;
+                uint32_t                    m_topology          = primitive_topology_undefined;
+                bool                        m_view_port         = false;
+                bool                        m_index_buffer      = false;
+                uint32_t                    m_event_depth       = 0;
+
+                void count(command_type t);
+                void error(const char* message);
+                void check_root_index(uint32_t root_index);
+                void pipeline_change(const void* pso);
+                void flush_barriers();
+            };
+
+            //replays the stream on a new null backend, returns it with the statistics and the errors
+            inline null_backend validate(const command_stream& s)
+            {
+                null_backend b;
+                execute(s, b);
+                b.finish();
+                return b;
+            }
+        }
+    }
+}
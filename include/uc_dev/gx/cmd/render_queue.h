@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <cstdint>
+#include <vector>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+            //64 bit sort key of a draw, the high bits are sorted first
+            //opaque:       pass:4 | 0:1 | pso:12 | material:20 | depth:24 | 0:3, front to back, so the state changes are minimised first
+            //translucent:  pass:4 | 1:1 | depth:24 | pso:12 | material:20 | 0:3, back to front, the order of the blending wins over the state changes
+            namespace sort_key
+            {
+                const uint32_t pass_bits        = 4;
+                const uint32_t pso_bits         = 12;
+                const uint32_t material_bits    = 20;
+                const uint32_t depth_bits       = 24;
+
+                const uint32_t pass_shift       = 60;
+                const uint32_t translucent_bit  = 59;
+
+                //depth in [0, 1], for example the view depth between the near and the far planes
+                inline uint64_t quantize_depth(float depth)
+                {
+                    const float max_depth = static_cast<float>((1U << depth_bits) - 1);
+                    auto d = std::min(std::max(depth, 0.0f), 1.0f);
+                    return static_cast<uint64_t>(d * max_depth);
+                }
+
+                inline uint64_t opaque(uint32_t pass, uint32_t pso, uint32_t material, float depth)
+                {
+                    assert(pass < (1U << pass_bits) && pso < (1U << pso_bits) && material < (1U << material_bits));
+
+                    return (static_cast<uint64_t>(pass) << pass_shift)
+                        | (static_cast<uint64_t>(pso) << 47)
+                        | (static_cast<uint64_t>(material) << 27)
+                        | (quantize_depth(depth) << 3);
+                }
+
+                inline uint64_t translucent(uint32_t pass, uint32_t pso, uint32_t material, float depth)
+                {
+                    assert(pass < (1U << pass_bits) && pso < (1U << pso_bits) && material < (1U << material_bits));
+
+                    const uint64_t max_depth = (1U << depth_bits) - 1;
+
+                    return (static_cast<uint64_t>(pass) << pass_shift)
+                        | (1ULL << translucent_bit)
+                        | ((max_depth - quantize_depth(depth)) << 35)
+                        | (static_cast<uint64_t>(pso) << 23)
+                        | (static_cast<uint64_t>(material) << 3);
+                }
+
+                inline uint32_t pass(uint64_t key)
+                {
+                    return static_cast<uint32_t>(key >> pass_shift);
+                }
+
+                inline bool is_translucent(uint64_t key)
+                {
+                    return ((key >> translucent_bit) & 1) != 0;
+                }
+
+                inline uint32_t pso(uint64_t key)
+                {
+                    return static_cast<uint32_t>(key >> (is_translucent(key) ? 23 : 47)) & ((1U << pso_bits) - 1);
+                }
+
+                inline uint32_t material(uint64_t key)
+                {
+                    return static_cast<uint32_t>(key >> (is_translucent(key) ? 3 : 27)) & ((1U << material_bits) - 1);
+                }
+            }
+
+            //a draw in a queue, m_draw is the index of the draw in the data of the caller
+            struct render_item
+            {
+                uint64_t        m_key;
+                uint32_t        m_draw;
+            };
+
+            //stable lsd radix sort by m_key, 8 bits per pass, the passes where all keys share the digit are skipped
+            //scratch is the second buffer of the passes, keep it between the frames to keep its memory
+            void radix_sort(std::vector<render_item>& items, std::vector<render_item>& scratch);
+
+            //draws of a frame, the jobs fill one bucket each in parallel, then sort() orders them by key for the replay
+            //the draws with equal keys keep the order of the jobs and the order they were added in
+            class render_queue
+            {
+                public:
+
+                class bucket
+                {
+                    public:
+
+                    void add(uint64_t key, uint32_t draw)
+                    {
+                        m_items.push_back({ key, draw });
+                    }
+
+                    private:
+
+                    friend class render_queue;
+
+                    std::vector<render_item>    m_items;
+                    //the buckets are filled by different threads, keep them on different cache lines
+                    uint8_t                     m_padding[64 - sizeof(std::vector<render_item>)];
+                };
+
+                //clears the queue and prepares a bucket per job, keeps the memory of the previous frame
+                void begin(uint32_t job_count)
+                {
+                    m_buckets.resize(std::max(job_count, 1U));
+
+                    for (auto&& b : m_buckets)
+                    {
+                        b.m_items.clear();
+                    }
+
+                    m_items.clear();
+                }
+
+                bucket& operator[](uint32_t job)
+                {
+                    return m_buckets[job];
+                }
+
+                uint32_t bucket_count() const
+                {
+                    return static_cast<uint32_t>(m_buckets.size());
+                }
+
+                //joins the buckets in the order of the jobs and sorts the items by key
+                void sort();
+
+                const std::vector<render_item>& items() const
+                {
+                    return m_items;
+                }
+
+                size_t size() const
+                {
+                    return m_items.size();
+                }
+
+                private:
+
+                std::vector<bucket>         m_buckets;
+                std::vector<render_item>    m_items;
+                std::vector<render_item>    m_scratch;
+            };
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <uc_dev/gx/cmd/commands.h>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+            struct barrier
+            {
+                const void*     m_resource;
+                uint32_t        m_subresource;
+                uint32_t        m_before;
+                uint32_t        m_after;
+                uint32_t        m_flags;
+            };
+
+            struct resource_state_statistics
+            {
+                uint32_t m_transitions  = 0;    //requested
+                uint32_t m_eliminated   = 0;    //already in the state
+                uint32_t m_merged       = 0;    //folded into a pending barrier
+                uint32_t m_collapsed    = 0;    //per subresource barriers folded into one barrier of all subresources
+                uint32_t m_barriers     = 0;    //flushed
+                uint32_t m_flushes      = 0;    //flushes with barriers
+                uint32_t m_unknown      = 0;    //transitions of resources without a known state
+            };
+
+            //tracks the states of the resources of one command list and builds the barriers
+            //the transitions are deferred until flush, a transition of a pending barrier replaces its target,
+            //a transition to the current state, or to a read state the resource is already in, is dropped
+            //when every subresource has a pending barrier between the same two states, the barriers become one barrier of all subresources
+            //flush right before the draws, dispatches, clears and copies, so there is one batch per use
+            class resource_state_tracker
+            {
+                public:
+
+                //declares the state of the resource, for example at the start of the pass that owns it
+                //subresource_count is needed only for transitions of single subresources
+                void track(const void* resource, uint32_t state, uint32_t subresource_count = 1);
+
+                //transitions the resource to after, the before state comes from the tracker
+                //expected_before is used only if the resource is not tracked yet, it is the before state of the callers which know it
+                //returns false if the state of the resource is unknown
+                bool transition(const void* resource, uint32_t after, uint32_t subresource = all_subresources, uint32_t expected_before = resource_state_unknown);
+
+                //starts a split barrier, the next transition or end_transition of the resource ends it
+                //the resource must not be used in between
+                bool begin_transition(const void* resource, uint32_t after);
+
+                void end_transition(const void* resource);
+
+                //ends the open split barriers, before the command list is closed
+                void end_transitions();
+
+                //current state, resource_state_unknown if not tracked or the subresources differ
+                uint32_t state(const void* resource, uint32_t subresource = all_subresources) const;
+
+                uint32_t pending_count() const
+                {
+                    return static_cast<uint32_t>(m_pending.size());
+                }
+
+                //calls f(const barrier*, uint32_t count) with the pending barriers, if any
+                template <typename function_t> uint32_t flush(function_t&& f)
+                {
+                    auto size = static_cast<uint32_t>(m_pending.size());
+
+                    if (size > 0)
+                    {
+                        f(&m_pending[0], size);
+                        m_pending.clear();
+                        m_statistics.m_barriers += size;
+                        m_statistics.m_flushes++;
+                    }
+
+                    return size;
+                }
+
+                const resource_state_statistics& statistics() const
+                {
+                    return m_statistics;
+                }
+
+                //forgets the resources and the barriers, keeps the memory
+                void reset();
+
+                private:
+
+                struct tracked_resource
+                {
+                    uint32_t                m_state             = resource_state_unknown;
+                    uint32_t                m_subresource_count = 1;
+                    uint32_t                m_split_before      = resource_state_unknown;
+                    uint32_t                m_split_after       = resource_state_unknown;
+                    std::vector<uint32_t>   m_subresources;     //per subresource states, empty if all are in m_state
+                };
+
+                std::unordered_map<const void*, tracked_resource>   m_resources;
+                std::vector<barrier>                                m_pending;
+                resource_state_statistics                           m_statistics;
+
+                void add_barrier(const void* resource, uint32_t subresource, uint32_t& state, uint32_t after);
+                void collapse_barriers(const void* resource, uint32_t subresource_count);
+                void end_transition(const void* resource, tracked_resource& r);
+            };
+        }
+    }
+}
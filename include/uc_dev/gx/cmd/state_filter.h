@@ -0,0 +1,308 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <uc_dev/gx/cmd/commands.h>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+            enum class bind_point : uint32_t
+            {
+                graphics,
+                compute,
+                count
+            };
+
+            //the calls the filter can drop
+            enum class state_call : uint32_t
+            {
+                pipeline_state,
+                root_signature,
+                descriptor_heaps,
+                primitive_topology,
+                vertex_buffers,
+                index_buffer,
+                constant_buffer,
+                count
+            };
+
+            struct state_filter_statistics
+            {
+                std::array<uint32_t, static_cast<uint32_t>(state_call::count)> m_issued     = {};
+                std::array<uint32_t, static_cast<uint32_t>(state_call::count)> m_filtered   = {};
+
+                uint32_t issued() const
+                {
+                    uint32_t r = 0;
+                    for (auto i : m_issued) r += i;
+                    return r;
+                }
+
+                uint32_t filtered() const
+                {
+                    uint32_t r = 0;
+                    for (auto i : m_filtered) r += i;
+                    return r;
+                }
+
+                state_filter_statistics& operator+=(const state_filter_statistics& o)
+                {
+                    for (auto i = 0U; i < m_issued.size(); ++i)
+                    {
+                        m_issued[i]     += o.m_issued[i];
+                        m_filtered[i]   += o.m_filtered[i];
+                    }
+
+                    return *this;
+                }
+            };
+
+            //shadow copy of the state of one command list
+            //the set_ functions record the new state and return false if the command list has it already, so the call can be dropped
+            //a new command list starts with an unknown state, invalidate() when the list is reset
+            class state_filter
+            {
+                public:
+
+                static const uint32_t max_root_parameters   = 64;   //the root signatures are at most 64 dwords
+                static const uint32_t max_vertex_buffers    = 32;   //D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT
+                static const uint32_t max_descriptor_heaps  = 2;    //cbv_srv_uav and sampler
+
+                //the pipeline state is shared by graphics and compute
+                bool set_pipeline_state(const void* p)
+                {
+                    bool redundant = (m_valid & valid_pipeline_state) && m_pipeline_state == p;
+
+                    m_pipeline_state = p;
+                    m_valid         |= valid_pipeline_state;
+
+                    return issue(state_call::pipeline_state, redundant);
+                }
+
+                //a new root signature resets the root arguments of its bind point
+                bool set_root_signature(bind_point b, const void* r)
+                {
+                    auto&& s        = m_bind_points[static_cast<uint32_t>(b)];
+                    bool redundant  = s.m_root_signature_valid && s.m_root_signature == r;
+
+                    if (!redundant)
+                    {
+                        s.m_root_signature          = r;
+                        s.m_root_signature_valid    = true;
+                        s.m_constant_buffers_valid  = 0;
+                    }
+
+                    return issue(state_call::root_signature, redundant);
+                }
+
+                template <typename t>
+                bool set_descriptor_heaps(t* const heaps[], uint32_t count)
+                {
+                    bool redundant = (m_valid & valid_descriptor_heaps) && count <= max_descriptor_heaps && m_descriptor_heap_count == count;
+
+                    for (auto i = 0U; redundant && i < count; ++i)
+                    {
+                        redundant = m_descriptor_heaps[i] == heaps[i];
+                    }
+
+                    if (count <= max_descriptor_heaps)
+                    {
+                        for (auto i = 0U; i < count; ++i)
+                        {
+                            m_descriptor_heaps[i] = heaps[i];
+                        }
+
+                        m_descriptor_heap_count = count;
+                        m_valid                |= valid_descriptor_heaps;
+                    }
+                    else
+                    {
+                        m_valid &= ~valid_descriptor_heaps;
+                    }
+
+                    return issue(state_call::descriptor_heaps, redundant);
+                }
+
+                bool set_primitive_topology(uint32_t topology)
+                {
+                    bool redundant = (m_valid & valid_primitive_topology) && m_primitive_topology == topology;
+
+                    m_primitive_topology    = topology;
+                    m_valid                |= valid_primitive_topology;
+
+                    return issue(state_call::primitive_topology, redundant);
+                }
+
+                //one call for the range of slots, dropped only if all slots have the views
+                bool set_vertex_buffers(uint32_t slot, uint32_t count, const vertex_buffer_view views[])
+                {
+                    bool redundant = slot + count <= max_vertex_buffers;
+
+                    for (auto i = 0U; redundant && i < count; ++i)
+                    {
+                        redundant = (m_vertex_buffers_valid & (1U << (slot + i))) && equal(m_vertex_buffers[slot + i], views[i]);
+                    }
+
+                    for (auto i = 0U; i < count && slot + i < max_vertex_buffers; ++i)
+                    {
+                        m_vertex_buffers[slot + i]  = views[i];
+                        m_vertex_buffers_valid     |= 1U << (slot + i);
+                    }
+
+                    return issue(state_call::vertex_buffers, redundant);
+                }
+
+                bool set_index_buffer(const index_buffer_view& v)
+                {
+                    bool redundant = (m_valid & valid_index_buffer) && equal(m_index_buffer, v);
+
+                    m_index_buffer  = v;
+                    m_valid        |= valid_index_buffer;
+
+                    return issue(state_call::index_buffer, redundant);
+                }
+
+                //root constant buffer view at a gpu address
+                bool set_constant_buffer(bind_point b, uint32_t root_index, uint64_t address)
+                {
+                    if (root_index >= max_root_parameters)
+                    {
+                        return issue(state_call::constant_buffer, false);
+                    }
+
+                    auto&& s        = m_bind_points[static_cast<uint32_t>(b)];
+                    auto   bit      = uint64_t(1) << root_index;
+                    auto&& c        = s.m_constant_buffers[root_index];
+                    bool redundant  = (s.m_constant_buffers_valid & bit) && c.m_address == address && c.m_address != 0;
+
+                    c.m_address     = address;
+                    c.m_bytes.clear();
+                    s.m_constant_buffers_valid |= bit;
+
+                    return issue(state_call::constant_buffer, redundant);
+                }
+
+                //root constant buffer view of constants the caller uploads, true if the bytes differ from the last upload to the root index
+                //the upload memory is write combined, so the filter keeps its own copy of the bytes to compare against
+                bool set_constants(bind_point b, uint32_t root_index, const void* buffer, std::size_t byte_count)
+                {
+                    if (root_index >= max_root_parameters)
+                    {
+                        return issue(state_call::constant_buffer, false);
+                    }
+
+                    auto&& s        = m_bind_points[static_cast<uint32_t>(b)];
+                    auto   bit      = uint64_t(1) << root_index;
+                    auto&& c        = s.m_constant_buffers[root_index];
+                    bool redundant  = (s.m_constant_buffers_valid & bit) && c.m_address == 0 && !c.m_bytes.empty() && c.m_bytes.size() == byte_count && std::memcmp(c.m_bytes.data(), buffer, byte_count) == 0;
+
+                    if (!redundant)
+                    {
+                        auto bytes = static_cast<const uint8_t*>(buffer);
+                        c.m_address = 0;
+                        c.m_bytes.assign(bytes, bytes + byte_count);
+                        s.m_constant_buffers_valid |= bit;
+                    }
+
+                    return issue(state_call::constant_buffer, redundant);
+                }
+
+                //a root argument the command list changed behind the filter, as the root constant an indirect command signature writes
+                void invalidate_root_argument(bind_point b, uint32_t root_index)
+                {
+                    if (root_index < max_root_parameters)
+                    {
+                        m_bind_points[static_cast<uint32_t>(b)].m_constant_buffers_valid &= ~(uint64_t(1) << root_index);
+                    }
+                }
+
+                //the state of a new command list
+                void invalidate()
+                {
+                    m_valid                 = 0;
+                    m_vertex_buffers_valid  = 0;
+
+                    for (auto&& s : m_bind_points)
+                    {
+                        s.m_root_signature_valid    = false;
+                        s.m_constant_buffers_valid  = 0;
+                    }
+                }
+
+                const state_filter_statistics& statistics() const
+                {
+                    return m_statistics;
+                }
+
+                void reset_statistics()
+                {
+                    m_statistics = state_filter_statistics();
+                }
+
+                private:
+
+                enum valid_flags : uint32_t
+                {
+                    valid_pipeline_state        = 0x1,
+                    valid_descriptor_heaps      = 0x2,
+                    valid_primitive_topology    = 0x4,
+                    valid_index_buffer          = 0x8
+                };
+
+                struct constant_buffer
+                {
+                    uint64_t                m_address = 0;  //0 for the uploaded constants
+                    std::vector<uint8_t>    m_bytes;
+                };
+
+                struct bind_point_state
+                {
+                    const void*                                         m_root_signature            = nullptr;
+                    bool                                                m_root_signature_valid      = false;
+                    uint64_t                                            m_constant_buffers_valid    = 0;
+                    std::array<constant_buffer, max_root_parameters>    m_constant_buffers;
+                };
+
+                bool issue(state_call c, bool redundant)
+                {
+                    if (redundant)
+                    {
+                        m_statistics.m_filtered[static_cast<uint32_t>(c)]++;
+                    }
+                    else
+                    {
+                        m_statistics.m_issued[static_cast<uint32_t>(c)]++;
+                    }
+
+                    return !redundant;
+                }
+
+                static bool equal(const vertex_buffer_view& a, const vertex_buffer_view& b)
+                {
+                    return a.m_address == b.m_address && a.m_size == b.m_size && a.m_stride == b.m_stride;
+                }
+
+                static bool equal(const index_buffer_view& a, const index_buffer_view& b)
+                {
+                    return a.m_address == b.m_address && a.m_size == b.m_size && a.m_format == b.m_format;
+                }
+
+                uint32_t                                                                m_valid                 = 0;
+                const void*                                                             m_pipeline_state        = nullptr;
+                std::array<const void*, max_descriptor_heaps>                           m_descriptor_heaps      = {};
+                uint32_t                                                                m_descriptor_heap_count = 0;
+                uint32_t                                                                m_primitive_topology    = 0;
+                uint32_t                                                                m_vertex_buffers_valid  = 0;
+                std::array<vertex_buffer_view, max_vertex_buffers>                      m_vertex_buffers        = {};
+                index_buffer_view                                                       m_index_buffer          = {};
+                std::array<bind_point_state, static_cast<uint32_t>(bind_point::count)>  m_bind_points;
+                state_filter_statistics                                                 m_statistics;
+            };
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <uc_dev/math/math.h>
+
+namespace uc {
+    namespace lip
+    {
+        struct model;
+        struct primitive_range;
+    }
+
+    namespace gx {
+        namespace cull {
+
+            //4 wide bounding volume hierarchy over static items (objects, primitive ranges), one item per leaf
+            //built with binned sah, nodes are stored depth first, so parents come before their children
+            class bvh
+            {
+                public:
+
+                static const uint32_t invalid   = 0xFFFFFFFF;
+                static const uint32_t leaf      = 0x80000000;
+
+                struct node
+                {
+                    math::aabb4 m_bounds;       //bounds of the 4 children, empty slots are inverted boxes
+                    uint32_t    m_child[4];     //node index, leaf | item index, or invalid for empty slots
+                };
+
+                void build(const math::aabb* bounds, uint32_t count);
+
+                //updates the node bounds for moving items, the topology is kept. bounds are in the order passed to build
+                void refit(const math::aabb* bounds);
+
+                //conservative, items that straddle a plane are reported
+                void query(const math::frustum_planes& f, std::vector<uint32_t>& items) const;
+
+                //items whose bounds are hit by the ray in [0, t_max]
+                void query(math::afloat4 origin, math::afloat4 direction, float t_max, std::vector<uint32_t>& items) const;
+
+                //items whose bounds overlap the sphere
+                void query(math::afloat4 center, float radius, std::vector<uint32_t>& items) const;
+
+                uint32_t size() const
+                {
+                    return m_size;
+                }
+
+                //levels of the 4 wide tree, sizes the traversal stacks
+                uint32_t depth() const
+                {
+                    return m_depth;
+                }
+
+                uint32_t node_count() const
+                {
+                    return static_cast<uint32_t>(m_nodes.size());
+                }
+
+                const node* nodes() const
+                {
+                    return m_nodes.data();
+                }
+
+                private:
+
+                std::vector< node >     m_nodes;
+                uint32_t                m_size  = 0;
+                uint32_t                m_depth = 0;
+            };
+
+            //bounds of every primitive range of a model, to build a bvh over the parts of a mesh
+            std::vector< math::aabb > primitive_range_bounds(const lip::model* m, const lip::primitive_range* ranges, uint32_t range_count);
+        }
+    }
+}
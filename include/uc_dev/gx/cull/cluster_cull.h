@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+#include <uc_dev/math/math.h>
+
+namespace uc {
+    namespace lip {
+        struct meshlet_bounds;
+        struct meshlets;
+    }
+
+    namespace gx {
+        namespace cull {
+
+            //frustum and normal cone test of meshlets, conservative, clusters that straddle a plane are reported as visible
+            //the planes and the eye are in the space of the bounds, the model space, for the skinned models it is the bind pose
+            //visible must have room for count entries, returns the number of visible clusters
+            uint32_t cluster_cull(const math::frustum_planes& f, math::afloat4 eye, const lip::meshlet_bounds* b, uint32_t count, uint32_t first_cluster, uint32_t* visible);
+
+            //culls the meshlets of one primitive range, visible gets the meshlet indices
+            void cluster_cull(const math::frustum_planes& f, math::afloat4 eye, const lip::meshlets& m, uint32_t range, std::vector<uint32_t>& visible);
+        }
+    }
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <uc_dev/gx/cull/object_bounds.h>
+#include <uc_dev/gx/cull/frustum_cull.h>
+#include <uc_dev/gx/cull/bvh.h>
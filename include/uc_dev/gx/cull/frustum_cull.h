@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include <uc_dev/math/math.h>
+
+namespace uc {
+    namespace gx {
+        namespace cull {
+
+            class object_bounds;
+
+            //conservative test, objects that straddle a plane are reported as visible
+            //visible lists are compacted and sorted by object index
+            void frustum_cull(const math::frustum_planes& f, const object_bounds& b, std::vector<uint32_t>& visible);
+
+            //culls against several views (camera, shadow cascades) in one pass over the bounds
+            void frustum_cull(const math::frustum_planes* f, uint32_t view_count, const object_bounds& b, std::vector<uint32_t>* visible);
+
+            namespace details
+            {
+                //the kernels write up to 8 entries past the returned count, visible must have room for the padded object count
+                //first_object is the index of the first object in the first block
+                uint32_t frustum_cull_sse(const math::frustum_planes* f, const math::aabb4* b, uint32_t block_count, uint32_t first_object, uint32_t* visible);
+                uint32_t frustum_cull_avx2(const math::frustum_planes* f, const math::aabb4* b, uint32_t block_count, uint32_t first_object, uint32_t* visible);
+            }
+        }
+    }
+}
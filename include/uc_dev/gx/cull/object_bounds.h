@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+#include <uc_dev/math/math.h>
+
+namespace uc {
+    namespace gx {
+        namespace cull {
+
+            //scene object bounds, kept in aabb4 soa form for the simd culling
+            class object_bounds
+            {
+                public:
+
+                uint32_t add(const math::aabb& b);
+                void     set(uint32_t object, const math::aabb& b);
+                void     clear();
+
+                //number of objects
+                uint32_t size() const
+                {
+                    return m_size;
+                }
+
+                //number of aabb4 blocks, 4 objects per block, the last one is padded
+                uint32_t block_count() const
+                {
+                    return static_cast<uint32_t>(m_blocks.size());
+                }
+
+                const math::aabb4* blocks() const
+                {
+                    return m_blocks.data();
+                }
+
+                private:
+                std::vector< math::aabb4 >   m_blocks;
+                uint32_t                     m_size = 0;
+            };
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace uc {
+    namespace gx {
+        namespace drs {
+
+            //measured times of a frame, a time which is not available is 0
+            struct frame_timing
+            {
+                float m_cpu_ms = 0.0f;  //recording and submission, without the waits for the gpu and the present
+                float m_gpu_ms = 0.0f;  //from the first to the last timestamp of the frame
+            };
+
+            struct dynamic_resolution_settings
+            {
+                float    m_target_ms        = 15.5f;    //below 16.6 ms, so the frame holds 60 hz with some headroom
+                float    m_min_scale        = 0.5f;
+                float    m_max_scale        = 1.0f;
+                float    m_scale_step       = 0.025f;   //the scales are multiples of it, so small corrections do not change the buffer sizes
+
+                //hysteresis, the scale goes down above lower * target and up below raise * target, in between it holds
+                float    m_lower_threshold  = 1.0f;
+                float    m_raise_threshold  = 0.85f;
+
+                float    m_smoothing        = 0.25f;    //weight of a new measurement in the filtered frame time
+
+                //pid gains, the error is the relative change of the scale which would meet the target
+                float    m_kp               = 0.6f;
+                float    m_ki               = 0.05f;
+                float    m_kd               = 0.2f;
+                float    m_integral_limit   = 1.0f;
+                float    m_max_change       = 0.1f;     //of the scale per update
+
+                //the measurements arrive a few frames late, after a change wait for the frames rendered at the new scale
+                uint32_t m_settle_frames    = 4;
+            };
+
+            //chooses the render scale from the measured frame times
+            //the gpu time follows the number of pixels, so the scale which meets the target is scale * sqrt(target / time)
+            //the controller does not depend on the device, so recorded traces can be replayed against it
+            class dynamic_resolution_controller
+            {
+                public:
+
+                explicit dynamic_resolution_controller(const dynamic_resolution_settings& s = dynamic_resolution_settings());
+
+                //feeds the times of a completed frame, returns the scale for the next frame
+                float update(const frame_timing& t);
+
+                //starts over at scale, for example after the user chose it
+                void reset(float scale = 1.0f);
+
+                float scale() const
+                {
+                    return m_output;
+                }
+
+                //the frame time the controller reacts to
+                float filtered_ms() const
+                {
+                    return m_filtered_ms;
+                }
+
+                const dynamic_resolution_settings& settings() const
+                {
+                    return m_settings;
+                }
+
+                void set_settings(const dynamic_resolution_settings& s);
+
+                private:
+
+                float quantize(float scale) const;
+
+                dynamic_resolution_settings m_settings;
+
+                float       m_scale             = 1.0f;     //continuous
+                float       m_output            = 1.0f;     //quantized
+                float       m_filtered_ms       = 0.0f;
+                float       m_integral          = 0.0f;
+                float       m_previous_error    = 0.0f;
+                uint32_t    m_settle            = 0;
+                bool        m_measured          = false;
+            };
+
+            //a frame of a recorded trace, the times and the scale the frame was rendered at
+            struct trace_frame
+            {
+                frame_timing m_timing;
+                float        m_scale = 1.0f;
+            };
+
+            //replays a recorded trace, the gpu times are moved to the scales the controller chose by the ratio of the pixel counts
+            //the times of a frame reach the controller latency frames after the scale of the frame was chosen
+            //returns the scale of every frame
+            std::vector<float> replay(dynamic_resolution_controller& c, const std::vector<trace_frame>& trace, uint32_t latency = 4);
+        }
+    }
+}
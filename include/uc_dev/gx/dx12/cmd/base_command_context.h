@@ -1,7 +1,10 @@
 #pragma once
 
 #include <queue>
+#include <vector>
 
+#include <uc_dev/gx/cmd/resource_state_tracker.h>
+#include <uc_dev/gx/cmd/state_filter.h>
 #include <uc_dev/util/noncopyable.h>
 #include <uc_dev/gx/dx12/api/helpers.h>
 #include <uc_dev/gx/dx12/cmd/command_queue.h>
@@ -37,9 +40,9 @@ namespace uc
                 const graphics_pipeline_state*          m_graphics_pipeline_state = nullptr;
                 const compute_pipeline_state*           m_compute_pipeline_state  = nullptr;
 
-                static const uint32_t                   barrier_count = 16;
-                D3D12_RESOURCE_BARRIER                  m_resource_bariers[barrier_count];
-                uint32_t                                m_resource_bariers_count = 0;
+                cmd::resource_state_tracker             m_resource_states;              //states of the resources in the command list, deferred barriers
+                std::vector<D3D12_RESOURCE_BARRIER>     m_resource_barriers;            //scratch for the flush
+                cmd::state_filter                       m_state_filter;                 //state of the command list, drops the redundant calls
 
                 gpu_base_command_context( gpu_resource_create_context* rc, gpu_command_manager* m, gpu_command_queue* q ) : 
                 m_command_manager(m)
@@ -54,23 +57,37 @@ namespace uc
                     m_command_list.m_list->GetDevice( __uuidof(ID3D12Device), reinterpret_cast<void**>(m_device.GetAddressOf()));
                 }
 
+                //prepares a pooled context for the next use, the gpu must be done with its previous work
                 void reset()
                 {
+                    release_command_list();
                     m_command_list = std::move(m_command_manager->create_command_list( gpu_command_manager::list_type( m_command_queue->type() )));
                     m_descriptor_cache.reset();
                     m_upload_allocator.reset();
                     m_descriptor_handle_cache0.reset();
                     m_descriptor_handle_cache1.reset();
-                    m_resource_bariers_count = 0;
+                    m_resource_states.reset();
+                    m_state_filter.invalidate();
+                    m_state_filter.reset_statistics();
                     m_compute_pipeline_state = nullptr;
                     m_graphics_pipeline_state = nullptr;
                 }
 
                 ~gpu_base_command_context()
+                {
+                    release_command_list();
+                }
+
+                private:
+
+                //the list of a context which was not submitted
+                void release_command_list()
                 {
                     if (m_command_list.m_allocator)
                     {
+                        m_command_list.m_list->Close();
                         m_command_manager->free_command_list(0, m_command_list);
+                        m_command_list.reset();
                     }
                 }
             };
@@ -15,6 +15,8 @@
 #include <uc_dev/gx/dx12/cmd/graphics_compute_command_context_utils.h>
 #include <uc_dev/gx/dx12/cmd/compute_command_context_utils.h>
 #include <uc_dev/gx/dx12/cmd/copy_command_context_utils.h>
+#include <uc_dev/gx/dx12/cmd/parallel_command_context.h>
 
 
 
+#include <uc_dev/gx/dx12/cmd/frame_timer.h>
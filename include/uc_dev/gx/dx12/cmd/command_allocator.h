@@ -4,7 +4,9 @@
 
 #include <uc_dev/util/noncopyable.h>
 #include <uc_dev/gx/dx12/api/helpers.h>
+#include <uc_dev/gx/dx12/gpu/frames_in_flight.h>
 #include <uc_dev/gx/dx12/cmd/command_queue.h>
+#include <uc_dev/gx/dx12/cmd/per_thread.h>
 
 namespace uc
 {
@@ -14,6 +16,7 @@ namespace uc
         {
 
             //holds per thread data
+            //the recording threads allocate and free in their own slots, sync must not run concurrently with them
             class gpu_direct_command_allocator : public util::noncopyable
             {
                 public:
@@ -27,61 +30,73 @@ namespace uc
 
                 ID3D12CommandAllocator* allocate()
                 {
-                    std::lock_guard< std::mutex> g(m_allocators_mutex);
-                    auto&& ready = m_ready_allocators_direct[m_frame_index];
+                    auto frame_index = m_frame_index.load(std::memory_order_relaxed);
+                    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> r0;
 
-                    if ( ready.empty() )
+                    auto take = [&r0, frame_index](allocators& a)
                     {
-                        auto r0 = create_command_allocator(m_device.Get(), static_cast< D3D12_COMMAND_LIST_TYPE >(m_queue->type()));
-                        auto r  = r0.Detach();
-                        r->Reset();
-                        return r;
-                    }
-                    else
-                    {
-                        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> r0 = ready.back();
-                        
-                        ready.pop_back();
+                        auto&& ready = a.m_ready[frame_index];
 
-                        auto r = r0.Detach();
-                        r->Reset();
+                        if (ready.empty())
+                        {
+                            return false;
+                        }
 
-                        return r;
+                        r0 = std::move(ready.back());
+                        ready.pop_back();
+                        return true;
+                    };
+
+                    //the contexts are often freed on the submitting thread, so the recording threads take from its slot
+                    if (!m_allocators.local(take) && !m_allocators.steal(take))
+                    {
+                        r0 = create_command_allocator(m_device.Get(), static_cast< D3D12_COMMAND_LIST_TYPE >(m_queue->type()));
                     }
+
+                    auto r = r0.Detach();
+                    r->Reset();
+                    return r;
                 }
 
                 void free( gpu_fence_value, ID3D12CommandAllocator* r0 )
                 {
-                    std::lock_guard< std::mutex> g(m_allocators_mutex);
-                    auto&& retired = m_retired_allocators_direct[m_frame_index];
+                    auto frame_index = m_frame_index.load(std::memory_order_relaxed);
 
                     Microsoft::WRL::ComPtr<ID3D12CommandAllocator> r;
                     r.Attach(r0);
 
-                    retired.push_back(r);
+                    m_allocators.local([&r, frame_index](allocators& a)
+                    {
+                        a.m_retired[frame_index].push_back(std::move(r));
+                    });
                 }
 
                 void sync()
                 {
-                    m_frame_index++;
-                    m_frame_index %= 3;
+                    auto frame_index = next_frame_index(m_frame_index.load(std::memory_order_relaxed));
 
-                    std::lock_guard< std::mutex> g(m_allocators_mutex);
+                    m_allocators.for_each([frame_index](allocators& a)
+                    {
+                        a.m_ready[frame_index].swap(a.m_retired[frame_index]);
+                    });
 
-                    m_ready_allocators_direct[m_frame_index].swap(m_retired_allocators_direct[m_frame_index]);
+                    m_frame_index.store(frame_index, std::memory_order_relaxed);
                 }
 
                 private:
 
+                struct allocators
+                {
+                    std::vector< Microsoft::WRL::ComPtr<ID3D12CommandAllocator> >   m_ready[max_frames_in_flight];
+                    std::vector< Microsoft::WRL::ComPtr<ID3D12CommandAllocator> >   m_retired[max_frames_in_flight];
+                };
+
                 Microsoft::WRL::ComPtr<ID3D12Device >                                                       m_device;
                 gpu_command_queue*                                                                          m_queue;
 
-                std::mutex                                                                                  m_allocators_mutex;
+                per_thread<allocators>                                                                      m_allocators;
 
-                std::vector< Microsoft::WRL::ComPtr<ID3D12CommandAllocator> >                               m_ready_allocators_direct[3];
-                std::vector< Microsoft::WRL::ComPtr<ID3D12CommandAllocator> >                               m_retired_allocators_direct[3];
-                
-                uint64_t                                                                                    m_frame_index = 0;
+                std::atomic<uint32_t>                                                                       m_frame_index { 0 };
 
             };
 
@@ -96,65 +96,114 @@ namespace uc
 
                 gpu_fence finish()
                 {
+                    close();
+
+                    auto v = m_command_queue->execute_command_list(m_command_list.m_list.Get());
+                    retire(v);
+
+                    return v;
+                }
+
+                //ends the recording, for the contexts which are executed together with others
+                void close()
+                {
+                    m_resource_states.end_transitions();
                     flush_resource_barriers();
 
                     throw_if_failed(list()->Close());
+                }
 
-                    auto v = m_command_queue->execute_command_list(m_command_list.m_list.Get());
+                //returns the closed list to the command manager, after it was executed
+                void retire(gpu_fence v)
+                {
                     m_command_manager->free_command_list(v.m_value, m_command_list);
                     m_command_list.reset();
+                }
 
-                    return v;
+                ID3D12CommandList* command_list() const
+                {
+                    return m_command_list.m_list.Get();
                 }
 
+                //one batch with all pending barriers, called before the draws, dispatches, clears and copies
                 void flush_resource_barriers()
                 {
-                    if (m_resource_bariers_count > 0)
+                    m_resource_states.flush([this](const cmd::barrier* b, uint32_t count)
                     {
-                        list()->ResourceBarrier(m_resource_bariers_count, &m_resource_bariers[0]);
-                        m_resource_bariers_count = 0;
-                    }
+                        m_resource_barriers.resize(count);
+
+                        for (auto i = 0U; i < count; ++i)
+                        {
+                            D3D12_RESOURCE_BARRIER& d   = m_resource_barriers[i];
+
+                            d.Type                      = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                            d.Flags                     = static_cast<D3D12_RESOURCE_BARRIER_FLAGS>(b[i].m_flags);
+                            d.Transition.pResource      = static_cast<const gpu_virtual_resource*>(b[i].m_resource)->resource();
+                            d.Transition.Subresource    = b[i].m_subresource;
+                            d.Transition.StateBefore    = static_cast<D3D12_RESOURCE_STATES>(b[i].m_before);
+                            d.Transition.StateAfter     = static_cast<D3D12_RESOURCE_STATES>(b[i].m_after);
+                        }
+
+                        list()->ResourceBarrier(count, &m_resource_barriers[0]);
+                    });
+                }
+
+                //the state of the resource when the command list starts to use it, no barrier
+                void track_resource(const gpu_virtual_resource* r, D3D12_RESOURCE_STATES state, uint32_t subresource_count = 1)
+                {
+                    m_resource_states.track(r, static_cast<uint32_t>(state), subresource_count);
                 }
 
+                //old_state is used only if the resource is not tracked yet, the tracked state wins
                 void transition_resource(const gpu_virtual_resource* r, D3D12_RESOURCE_STATES old_state, D3D12_RESOURCE_STATES new_state)
                 {
-                    //todo: check the same states, before flush
+                    m_resource_states.transition(r, static_cast<uint32_t>(new_state), cmd::all_subresources, static_cast<uint32_t>(old_state));
+                }
 
-                    if (m_resource_bariers_count == barrier_count)
+                //the before state comes from the tracker, throws if the resource is not tracked, as no barrier can be built
+                void transition_resource(const gpu_virtual_resource* r, D3D12_RESOURCE_STATES new_state)
+                {
+                    if (!m_resource_states.transition(r, static_cast<uint32_t>(new_state)))
                     {
-                        flush_resource_barriers();
+                        throw exception("transition of a resource without a known state, track it or pass the old state");
                     }
+                }
 
-                    D3D12_RESOURCE_BARRIER  d = {};
-
-                    d.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-                    d.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-                    d.Transition.pResource = r->resource();
-                    d.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-                    d.Transition.StateBefore = old_state;
-                    d.Transition.StateAfter = new_state;
-
-                    bool add = true;
-
-                    for (int32_t i = m_resource_bariers_count - 1; i >= 0; --i)
+                void transition_subresource(const gpu_virtual_resource* r, uint32_t subresource, D3D12_RESOURCE_STATES new_state)
+                {
+                    if (!m_resource_states.transition(r, static_cast<uint32_t>(new_state), subresource))
                     {
-                        if ( m_resource_bariers[i].Transition.pResource == d.Transition.pResource )
-                        {
-                            if (memcmp(&m_resource_bariers[i],&d, sizeof(d)) == 0)
-                            {
-                                add = false;
-                                break;
-                            }
-                        }
+                        throw exception("transition of a subresource without a known state, track the resource with its subresource count");
                     }
+                }
 
-                    if (add)
+                //split barrier, the gpu can overlap the transition with the work until the next transition of the resource
+                void begin_transition_resource(const gpu_virtual_resource* r, D3D12_RESOURCE_STATES new_state)
+                {
+                    if (!m_resource_states.begin_transition(r, static_cast<uint32_t>(new_state)))
                     {
-                        D3D12_RESOURCE_BARRIER& desc = m_resource_bariers[m_resource_bariers_count++];
-                        desc = d;
+                        throw exception("transition of a resource without a known state, track it or pass the old state");
                     }
                 }
 
+                void end_transition_resource(const gpu_virtual_resource* r)
+                {
+                    m_resource_states.end_transition(r);
+                }
+
+                //after takes over the memory of before, placed resources which alias in one heap, before may be null
+                void aliasing_barrier(const gpu_virtual_resource* before, const gpu_virtual_resource* after)
+                {
+                    flush_resource_barriers();
+
+                    D3D12_RESOURCE_BARRIER d        = {};
+                    d.Type                          = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+                    d.Aliasing.pResourceBefore      = before != nullptr ? before->resource() : nullptr;
+                    d.Aliasing.pResourceAfter       = after->resource();
+
+                    list()->ResourceBarrier(1, &d);
+                }
+
                 void copy_buffer_region( gpu_virtual_resource* destination, uint64_t destination_offset, gpu_virtual_resource* source, uint64_t source_offset, uint64_t byte_count)
                 {
                     flush_resource_barriers();
@@ -202,19 +251,37 @@ namespace uc
                     PIXSetMarker(list(), 0, label);
                 }
 
+                //writes the gpu timestamp when the preceding work is done
+                void end_timestamp_query(ID3D12QueryHeap* heap, uint32_t index)
+                {
+                    list()->EndQuery(heap, D3D12_QUERY_TYPE_TIMESTAMP, index);
+                }
+
+                //copies count timestamps as uint64_t ticks to the read back buffer at offset
+                void resolve_timestamp_queries(ID3D12QueryHeap* heap, uint32_t begin, uint32_t count, gpu_virtual_resource* destination, uint64_t offset)
+                {
+                    list()->ResolveQueryData(heap, D3D12_QUERY_TYPE_TIMESTAMP, begin, count, destination->resource(), offset);
+                }
+
                 descriptor_handle srv()
                 {
-                    return m_rc->frame_cpu_srv_heap()->allocate();
+                    return m_descriptor_cache.allocate_srv();
                 }
 
                 descriptor_handle uav()
                 {
-                    return m_rc->frame_cpu_srv_heap()->allocate();
+                    return m_descriptor_cache.allocate_srv();
                 }
 
                 descriptor_handle cbv()
                 {
-                    return m_rc->frame_cpu_srv_heap()->allocate();
+                    return m_descriptor_cache.allocate_srv();
+                }
+
+                //issued versus dropped state calls since the context was created
+                const cmd::state_filter_statistics& state_statistics() const
+                {
+                    return m_state_filter.statistics();
                 }
 
                 protected:
@@ -222,6 +289,28 @@ namespace uc
                 {
                     return m_command_list.m_list.Get();
                 }
+
+                static cmd::index_buffer_view to_index_buffer_view(const D3D12_INDEX_BUFFER_VIEW& v)
+                {
+                    return { v.BufferLocation, v.SizeInBytes, static_cast<cmd::index_format>(v.Format) };
+                }
+
+                bool filter_vertex_buffers(uint32_t slot, uint32_t count, const D3D12_VERTEX_BUFFER_VIEW views[])
+                {
+                    cmd::vertex_buffer_view v[cmd::state_filter::max_vertex_buffers];
+
+                    if (count > cmd::state_filter::max_vertex_buffers)
+                    {
+                        return true;
+                    }
+
+                    for (auto i = 0U; i < count; ++i)
+                    {
+                        v[i] = { views[i].BufferLocation, views[i].SizeInBytes, views[i].StrideInBytes };
+                    }
+
+                    return m_state_filter.set_vertex_buffers(slot, count, v);
+                }
             };
         }
     }
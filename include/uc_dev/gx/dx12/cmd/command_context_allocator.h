@@ -1,9 +1,12 @@
 #pragma once
 
-#include <queue>
+#include <memory>
+#include <vector>
 
 #include <uc_dev/util/noncopyable.h>
 #include <uc_dev/gx/dx12/cmd/base_command_context.h>
+#include <uc_dev/gx/dx12/cmd/per_thread.h>
+#include <uc_dev/gx/dx12/gpu/frames_in_flight.h>
 
 namespace uc
 {
@@ -11,6 +14,8 @@ namespace uc
     {
         namespace dx12
         {
+            //pools the contexts per recording thread, a freed context is reused max_frames_in_flight frames later, when the gpu is done with it
+            //sync must not run concurrently with the recording threads
             class gpu_command_context_allocator : public util::noncopyable
             {
 
@@ -19,69 +24,100 @@ namespace uc
                 m_resource_context(rc)
                 ,m_command_manager(m)
                 , m_command_queue(q)
-                
-                
+
+
                 {
 
                 }
 
                 gpu_base_command_context* create_base_command_context()
                 {
-                    std::lock_guard<std::mutex> g(this->m_pool_lock);
-
-                    return new gpu_base_command_context(m_resource_context, m_command_manager, m_command_queue);
-
-                    /*
-                    auto&& free = m_free_contexts[m_context_index];
+                    std::unique_ptr<gpu_base_command_context> r;
 
-                    if (free.empty())
+                    auto take = [&r](contexts& c)
                     {
-                        
-                        auto r = d.get();
-                        m_context_pool.emplace_back(std::move(d));
-                        return r;
-                    }
-                    else
+                        if (c.m_ready.empty())
+                        {
+                            return false;
+                        }
+
+                        r = std::move(c.m_ready.back());
+                        c.m_ready.pop_back();
+                        return true;
+                    };
+
+                    //the submitting thread frees most of the contexts, so the recording threads take from its slot
+                    if (m_contexts.local(take) || m_contexts.steal(take))
                     {
-                        auto r = free.front();
-                        free.pop();
                         r->reset();
-                        return r;
+                        return r.release();
                     }
-                    */
+
+                    return new gpu_base_command_context(m_resource_context, m_command_manager, m_command_queue);
                 }
 
                 void free_base_command_context( gpu_base_command_context* ctx )
                 {
-                    std::lock_guard<std::mutex> g(m_pool_lock);
-                    auto&& free = m_free_contexts[m_context_index];
-                    free.push( std::unique_ptr<gpu_base_command_context>(ctx) );
+                    auto context_index = m_context_index.load(std::memory_order_relaxed);
+
+                    m_contexts.local([ctx, context_index](contexts& c)
+                    {
+                        c.m_state_statistics += ctx->m_state_filter.statistics();
+                        c.m_retired[context_index].emplace_back(ctx);
+                    });
+                }
+
+                //issued versus dropped state calls of the contexts freed during the last frame
+                cmd::state_filter_statistics state_statistics() const
+                {
+                    return m_frame_state_statistics;
                 }
 
                 void sync()
                 {
                     m_command_manager->sync();
 
-                    m_context_index = (m_context_index + 1 ) % 3;
+                    auto context_index = next_frame_index(m_context_index.load(std::memory_order_relaxed));
+
+                    cmd::state_filter_statistics statistics;
+
+                    m_contexts.for_each([context_index, &statistics](contexts& c)
+                    {
+                        auto&& retired = c.m_retired[context_index];
+
+                        for (auto&& r : retired)
+                        {
+                            c.m_ready.emplace_back(std::move(r));
+                        }
+
+                        retired.clear();
+
+                        statistics              += c.m_state_statistics;
+                        c.m_state_statistics    = cmd::state_filter_statistics();
+                    });
 
-                    //todo: flush these less often
-                    auto&& free = m_free_contexts[m_context_index];
-                    std::queue<std::unique_ptr<gpu_base_command_context> > empty_queue;
-                    free.swap( empty_queue );
+                    m_frame_state_statistics = statistics;
+                    m_context_index.store(context_index, std::memory_order_relaxed);
                 }
 
                 private:
 
+                struct contexts
+                {
+                    std::vector< std::unique_ptr<gpu_base_command_context> >    m_ready;
+                    std::vector< std::unique_ptr<gpu_base_command_context> >    m_retired[max_frames_in_flight];
+                    cmd::state_filter_statistics                                m_state_statistics;
+                };
+
                 gpu_resource_create_context*                                m_resource_context;
                 gpu_command_manager*                                        m_command_manager;  //allocate command lists here
                 gpu_command_queue*                                          m_command_queue;    //submit command lists here
 
-                uint64_t                                                    m_context_index = 2;
-                
+                std::atomic<uint32_t>                                       m_context_index { max_frames_in_flight - 1 };
 
-                std::mutex                                                  m_pool_lock;
-                std::queue< std::unique_ptr<gpu_base_command_context> >     m_free_contexts[3];
+                per_thread<contexts>                                        m_contexts;
+                cmd::state_filter_statistics                                m_frame_state_statistics;
             };
         }
     }
-}
\ No newline at end of file
+}
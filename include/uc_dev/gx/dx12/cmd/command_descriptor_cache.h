@@ -2,6 +2,7 @@
 
 
 #include <uc_dev/gx/dx12/gpu/resource_create_context.h>
+#include <uc_dev/gx/dx12/gpu/allocators/descriptor_ring.h>
 #include <pix3.h>
 
 
@@ -11,6 +12,8 @@ namespace uc
     {
         namespace dx12
         {
+            //blocks of the frame heaps for one context, only a new block touches the shared rings
+            //a context records on one thread at a time, so the blocks need no locks
             struct gpu_command_descriptor_cache
             {
 
@@ -18,106 +21,62 @@ namespace uc
 
                 gpu_command_descriptor_cache ( gpu_resource_create_context* rc ) :
                 m_rc(rc)
-                , m_size_srv(0)
-                , m_size_dsv(0)
-                , m_size_rtv(0)
                 {
                     reset();
                 }
 
                 descriptor_handle allocate_srv()
                 {
-                    if (m_size_srv == 0)
-                    {
-                        request_srv_handles();
-                    }
-
-                    descriptor_handle r = m_handle_srv;
-                    m_handle_srv = m_handle_srv.increment(m_increment_size_srv);
-                    m_size_srv--;
-                    return r;
+                    return allocate(m_rc->frame_cpu_srv_heap(), m_srv, 1);
                 }
 
                 descriptor_handle allocate_dsv()
                 {
-                    if (m_size_dsv == 0)
-                    {
-                        request_dsv_handles();
-                    }
-
-                    descriptor_handle r = m_handle_dsv;
-                    m_handle_dsv = m_handle_dsv.increment(m_increment_size_dsv);
-                    m_size_dsv--;
-                    return r;
+                    return allocate(m_rc->frame_dsv_heap(), m_dsv, 1);
                 }
 
                 descriptor_handle allocate_rtv()
                 {
-                    if (m_size_rtv == 0)
-                    {
-                        request_rtv_handles();
-                    }
-
-                    descriptor_handle r = m_handle_rtv;
-                    m_handle_rtv = m_handle_rtv.increment(m_increment_size_rtv);
-                    m_size_rtv--;
-                    return r;
+                    return allocate(m_rc->frame_rtv_heap(), m_rtv, 1);
                 }
 
+                //shader visible descriptor table of count descriptors
+                incrementable_descriptor_handle allocate_gpu_srv(uint32_t count)
+                {
+                    auto heap = m_rc->frame_gpu_srv_heap();
+                    return heap->incrementable(allocate(heap, m_gpu_srv, count));
+                }
+
+                //the blocks of the last frame are retired with it
                 void reset()
                 {
-                    request_handles();
-                    m_increment_size_srv = m_rc->frame_cpu_srv_heap()->increment_size();
-                    m_increment_size_dsv = m_rc->frame_dsv_heap()->increment_size();
-                    m_increment_size_rtv = m_rc->frame_rtv_heap()->increment_size();
+                    m_srv.reset();
+                    m_dsv.reset();
+                    m_rtv.reset();
+                    m_gpu_srv.reset();
                 }
 
                 private:
 
                 gpu_resource_create_context* m_rc;
 
-                static const uint32_t srv_request_size = 16;
-                static const uint32_t rtv_request_size = 16;
-                static const uint32_t dsv_request_size = 16;
-
-                descriptor_handle            m_handle_srv;
-                descriptor_handle            m_handle_dsv;
-                descriptor_handle            m_handle_rtv;
-
-                uint32_t                     m_size_srv;
-                uint32_t                     m_size_dsv;
-                uint32_t                     m_size_rtv;
-
-                uint64_t                     m_increment_size_srv;
-                uint64_t                     m_increment_size_dsv;
-                uint64_t                     m_increment_size_rtv;
-
-
-                void request_handles()
-                {
-                    request_srv_handles();
-                    request_dsv_handles();
-                    request_rtv_handles();
-                }
-
-                void request_srv_handles()
-                {
-                    m_handle_srv = m_rc->frame_cpu_srv_heap()->allocate(srv_request_size);
-                    m_size_srv = srv_request_size;
-                }
+                static const uint32_t srv_request_size      = 16;
+                static const uint32_t rtv_request_size      = 16;
+                static const uint32_t dsv_request_size      = 16;
+                static const uint32_t gpu_srv_request_size  = 64;
 
-                void request_dsv_handles()
-                {
-                    m_handle_dsv = m_rc->frame_dsv_heap()->allocate(dsv_request_size);
-                    m_size_dsv = dsv_request_size;
-                }
+                descriptor_ring_cache<srv_request_size>      m_srv;
+                descriptor_ring_cache<dsv_request_size>      m_dsv;
+                descriptor_ring_cache<rtv_request_size>      m_rtv;
+                descriptor_ring_cache<gpu_srv_request_size>  m_gpu_srv;
 
-                void request_rtv_handles()
+                template <typename heap, typename cache>
+                static descriptor_handle allocate(heap* h, cache& c, uint32_t count)
                 {
-                    m_handle_rtv = m_rc->frame_rtv_heap()->allocate(rtv_request_size);
-                    m_size_rtv = rtv_request_size;
+                    auto index = c.allocate(h, count);
+                    assert(index != descriptor_ring::invalid);
+                    return h->handle(index);
                 }
-
             };
         }
     }
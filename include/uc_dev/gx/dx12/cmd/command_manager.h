@@ -43,6 +43,7 @@ namespace uc
                 gpu_command_manager( ID3D12Device* d, gpu_command_queue* q ) :
                     m_device(d )
                     , m_allocator(d, q)
+                    , m_draw_indexed_signature(create_draw_indexed_signature(d))
                 {
 
                 }
@@ -54,18 +55,48 @@ namespace uc
 
                 command_list create_command_list( list_type type )
                 {
-
                     auto a = m_allocator.allocate();
-                    auto l = create_graphics_command_list(m_device.Get(), 0, static_cast<D3D12_COMMAND_LIST_TYPE>(type), a, nullptr);
-                    l->Close();
+                    auto t = static_cast<uint32_t>(type);
+
+                    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> l;
+
+                    auto take = [&l, t](lists& s)
+                    {
+                        if (s.m_free[t].empty())
+                        {
+                            return false;
+                        }
+
+                        l = std::move(s.m_free[t].back());
+                        s.m_free[t].pop_back();
+                        return true;
+                    };
+
+                    //the lists can be reset as soon as they are submitted, so they are reused without waiting for the gpu
+                    //the submitting thread frees most of them, so the recording threads take from its slot
+                    if (!m_lists.local(take) && !m_lists.steal(take))
+                    {
+                        l = create_graphics_command_list(m_device.Get(), 0, static_cast<D3D12_COMMAND_LIST_TYPE>(type), a, nullptr);
+                        l->Close();
+                    }
+
                     l->Reset(a, nullptr);
 
                     return{ l, a };
                 }
 
+                //the list must be closed
                 void free_command_list( gpu_fence_value v, command_list & list)
                 {
                     m_allocator.free( v, list.m_allocator.Get() );
+
+                    auto t = static_cast<uint32_t>(list.m_list->GetType());
+                    auto l = list.m_list;
+
+                    m_lists.local([&l, t](lists& s)
+                    {
+                        s.m_free[t].push_back(std::move(l));
+                    });
                 }
 
                 ID3D12Device* device() const
@@ -73,6 +104,30 @@ namespace uc
                     return m_device.Get();
                 }
 
+                //indirect draws with D3D12_DRAW_INDEXED_ARGUMENTS only, it works with any root signature
+                ID3D12CommandSignature* draw_indexed_signature() const
+                {
+                    return m_draw_indexed_signature.Get();
+                }
+
+                //indirect draws with a 32 bit root constant, the draw id, before D3D12_DRAW_INDEXED_ARGUMENTS, it works with the root signature it is made for only
+                static Microsoft::WRL::ComPtr<ID3D12CommandSignature> create_draw_indexed_instance_signature(ID3D12Device* d, ID3D12RootSignature* root_signature, uint32_t root_index)
+                {
+                    D3D12_INDIRECT_ARGUMENT_DESC arguments[2] = {};
+                    arguments[0].Type                               = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+                    arguments[0].Constant.RootParameterIndex        = root_index;
+                    arguments[0].Constant.DestOffsetIn32BitValues   = 0;
+                    arguments[0].Constant.Num32BitValuesToSet       = 1;
+                    arguments[1].Type                               = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+                    D3D12_COMMAND_SIGNATURE_DESC desc = {};
+                    desc.ByteStride         = sizeof(uint32_t) + sizeof(D3D12_DRAW_INDEXED_ARGUMENTS);
+                    desc.NumArgumentDescs   = 2;
+                    desc.pArgumentDescs     = arguments;
+
+                    return create_command_signature(d, &desc, root_signature);
+                }
+
                 void sync()
                 {
                     m_allocator.sync();
@@ -80,8 +135,28 @@ namespace uc
 
             private:
 
-                Microsoft::WRL::ComPtr<ID3D12Device> m_device;
-                gpu_command_allocator                m_allocator;
+                struct lists
+                {
+                    std::vector< Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> > m_free[4];   //by D3D12_COMMAND_LIST_TYPE
+                };
+
+                static Microsoft::WRL::ComPtr<ID3D12CommandSignature> create_draw_indexed_signature(ID3D12Device* d)
+                {
+                    D3D12_INDIRECT_ARGUMENT_DESC argument = {};
+                    argument.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+                    D3D12_COMMAND_SIGNATURE_DESC desc = {};
+                    desc.ByteStride         = sizeof(D3D12_DRAW_INDEXED_ARGUMENTS);
+                    desc.NumArgumentDescs   = 1;
+                    desc.pArgumentDescs     = &argument;
+
+                    return create_command_signature(d, &desc, nullptr);
+                }
+
+                Microsoft::WRL::ComPtr<ID3D12Device>            m_device;
+                gpu_command_allocator                           m_allocator;
+                per_thread<lists>                               m_lists;
+                Microsoft::WRL::ComPtr<ID3D12CommandSignature>  m_draw_indexed_signature;
             };
         }
     }
@@ -89,6 +89,22 @@ namespace uc
                     return r;
                 }
 
+                //one submission, the lists execute in their order
+                gpu_fence execute_command_lists( uint32_t count, ID3D12CommandList* const lists[] )
+                {
+                    std::unique_lock< std::mutex > g(m_queue_mutex);
+
+                    m_queue->ExecuteCommandLists(count, lists);
+
+                    signal_fence(m_fence_value);
+
+                    gpu_fence r;
+                    r.m_fence = m_fence.Get();
+                    r.m_value = m_fence_value++;
+
+                    return r;
+                }
+
                 void wait_for_idle_gpu()
                 {
                     wait_for_fence(increment_fence());
@@ -0,0 +1,625 @@
+#pragma once
+
+#include <assert.h>
+
+#include <uc_dev/gx/cmd/command_stream.h>
+
+#include <uc_dev/gx/dx12/cmd/graphics_command_context.h>
+#include <uc_dev/gx/dx12/cmd/graphics_compute_command_context.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace dx12
+        {
+            //records into a command stream with the interface of the command contexts, so the passes can switch between them
+            //the stream keeps pointers to the resources and the pipeline states, they must live until the stream is executed
+            class gpu_command_stream_recorder
+            {
+                public:
+
+                explicit gpu_command_stream_recorder(cmd::command_stream* s) : m_stream(s)
+                {
+
+                }
+
+                cmd::command_stream* stream() const
+                {
+                    return m_stream;
+                }
+
+                void set_pso(const graphics_pipeline_state* p)
+                {
+                    m_stream->set_graphics_pipeline_state(p);
+                }
+
+                void set_pso(const compute_pipeline_state* p)
+                {
+                    m_stream->set_compute_pipeline_state(p);
+                }
+
+                void set_descriptor_heaps()
+                {
+                    m_stream->set_descriptor_heaps();
+                }
+
+                void clear(gpu_back_buffer* r)
+                {
+                    m_stream->clear_render_target(make_view(r));
+                }
+
+                void clear(gpu_color_buffer* r)
+                {
+                    m_stream->clear_render_target(make_view(r));
+                }
+
+                void clear_depth(gpu_depth_buffer* r, float depth)
+                {
+                    m_stream->clear_depth_stencil(make_view(r), cmd::clear_depth, depth, 0);
+                }
+
+                void clear_depth(gpu_depth_stencil_buffer* r, float depth)
+                {
+                    m_stream->clear_depth_stencil(make_view(r), cmd::clear_depth, depth, 0);
+                }
+
+                void clear_depth_stencil(gpu_depth_stencil_buffer* r, float depth = 1.0f, uint32_t stencil = 0)
+                {
+                    m_stream->clear_depth_stencil(make_view(r), cmd::clear_depth | cmd::clear_stencil, depth, stencil);
+                }
+
+                void set_render_target(gpu_back_buffer* r)
+                {
+                    m_stream->set_render_targets(make_view(r), cmd::view());
+                }
+
+                void set_render_target(gpu_color_buffer* r)
+                {
+                    m_stream->set_render_targets(make_view(r), cmd::view());
+                }
+
+                void set_render_target(gpu_depth_buffer* b)
+                {
+                    m_stream->set_render_targets(cmd::view(), make_view(b));
+                }
+
+                void set_render_target(gpu_depth_stencil_buffer* b)
+                {
+                    m_stream->set_render_targets(cmd::view(), make_view(b));
+                }
+
+                void set_render_target(gpu_back_buffer* r, gpu_depth_buffer* b)
+                {
+                    m_stream->set_render_targets(make_view(r), make_view(b));
+                }
+
+                void set_render_target(gpu_back_buffer* r, gpu_depth_stencil_buffer* b)
+                {
+                    m_stream->set_render_targets(make_view(r), make_view(b));
+                }
+
+                void set_render_target(gpu_color_buffer* r, gpu_depth_buffer* b)
+                {
+                    m_stream->set_render_targets(make_view(r), make_view(b));
+                }
+
+                void set_render_target(gpu_color_buffer* r, gpu_depth_stencil_buffer* b)
+                {
+                    m_stream->set_render_targets(make_view(r), make_view(b));
+                }
+
+                void set_view_port(const D3D12_VIEWPORT& v)
+                {
+                    m_stream->set_view_port({ v.TopLeftX, v.TopLeftY, v.Width, v.Height, v.MinDepth, v.MaxDepth });
+                }
+
+                void set_scissor_rectangle(const D3D12_RECT& r)
+                {
+                    m_stream->set_scissor_rectangle({ static_cast<int32_t>(r.left), static_cast<int32_t>(r.top), static_cast<int32_t>(r.right), static_cast<int32_t>(r.bottom) });
+                }
+
+                void set_primitive_topology(D3D12_PRIMITIVE_TOPOLOGY topology)
+                {
+                    m_stream->set_primitive_topology(static_cast<uint32_t>(topology));
+                }
+
+                void set_vertex_buffer(uint32_t slot, D3D12_VERTEX_BUFFER_VIEW view)
+                {
+                    m_stream->set_vertex_buffer(slot, { view.BufferLocation, view.SizeInBytes, view.StrideInBytes });
+                }
+
+                void set_index_buffer(D3D12_INDEX_BUFFER_VIEW view)
+                {
+                    m_stream->set_index_buffer({ view.BufferLocation, view.SizeInBytes, static_cast<cmd::index_format>(view.Format) });
+                }
+
+                void set_dynamic_vertex_buffer(uint32_t slot, uint32_t stride, gpu_upload_buffer* r)
+                {
+                    m_stream->set_vertex_buffer(slot, { r->virtual_address(), static_cast<uint32_t>(mem::align(r->desc().Width, 256)), stride });
+                }
+
+                void set_graphics_constant_buffer(uint32_t root_index, const void* buffer, size_t byte_count)
+                {
+                    m_stream->set_graphics_constant_buffer(root_index, buffer, byte_count);
+                }
+
+                template<typename t>
+                void set_graphics_constant_buffer(uint32_t root_index, const t& buffer)
+                {
+                    set_graphics_constant_buffer(root_index, &buffer, sizeof(t));
+                }
+
+                void set_graphics_dynamic_constant_buffer(uint32_t root_index, uint32_t offset, const void* buffer, size_t byte_count)
+                {
+                    m_stream->set_graphics_dynamic_constant_buffer(root_index, offset, buffer, byte_count);
+                }
+
+                template <typename t>
+                void set_graphics_dynamic_constant_buffer(uint32_t root_index, uint32_t offset, const t& buffer)
+                {
+                    set_graphics_dynamic_constant_buffer(root_index, offset, &buffer, sizeof(t));
+                }
+
+                void set_graphics_dynamic_descriptor(uint32_t root_index, D3D12_CPU_DESCRIPTOR_HANDLE handle, uint32_t offset = 0)
+                {
+                    m_stream->set_graphics_dynamic_descriptor(root_index, static_cast<uint64_t>(handle.ptr), offset);
+                }
+
+                void set_graphics_dynamic_srv_buffer(uint32_t root_index, const void* buffer, size_t byte_count)
+                {
+                    m_stream->set_graphics_dynamic_srv_buffer(root_index, buffer, byte_count);
+                }
+
+                void set_graphics_root_constant(uint32_t root_index, uint32_t value)
+                {
+                    m_stream->set_graphics_root_constant(root_index, value);
+                }
+
+                void set_graphics_bindless_table(uint32_t root_index)
+                {
+                    m_stream->set_graphics_bindless_table(root_index);
+                }
+
+                void set_compute_constant_buffer(uint32_t root_index, const void* buffer, size_t byte_count)
+                {
+                    m_stream->set_compute_constant_buffer(root_index, buffer, byte_count);
+                }
+
+                template<typename t>
+                void set_compute_constant_buffer(uint32_t root_index, const t& buffer)
+                {
+                    set_compute_constant_buffer(root_index, &buffer, sizeof(t));
+                }
+
+                void set_compute_dynamic_constant_buffer(uint32_t root_index, uint32_t offset, const void* buffer, size_t byte_count)
+                {
+                    m_stream->set_compute_dynamic_constant_buffer(root_index, offset, buffer, byte_count);
+                }
+
+                template <typename t>
+                void set_compute_dynamic_constant_buffer(uint32_t root_index, uint32_t offset, const t& buffer)
+                {
+                    set_compute_dynamic_constant_buffer(root_index, offset, &buffer, sizeof(t));
+                }
+
+                void set_compute_dynamic_descriptor(uint32_t root_index, D3D12_CPU_DESCRIPTOR_HANDLE handle, uint32_t offset = 0)
+                {
+                    m_stream->set_compute_dynamic_descriptor(root_index, static_cast<uint64_t>(handle.ptr), offset);
+                }
+
+                void track_resource(const gpu_virtual_resource* r, D3D12_RESOURCE_STATES state, uint32_t subresource_count = 1)
+                {
+                    m_stream->track_resource(r, static_cast<uint32_t>(state), subresource_count);
+                }
+
+                void transition_resource(const gpu_virtual_resource* r, D3D12_RESOURCE_STATES old_state, D3D12_RESOURCE_STATES new_state)
+                {
+                    m_stream->transition_resource(r, static_cast<uint32_t>(old_state), static_cast<uint32_t>(new_state));
+                }
+
+                void transition_resource(const gpu_virtual_resource* r, D3D12_RESOURCE_STATES new_state)
+                {
+                    m_stream->transition_resource(r, static_cast<uint32_t>(new_state));
+                }
+
+                void transition_subresource(const gpu_virtual_resource* r, uint32_t subresource, D3D12_RESOURCE_STATES new_state)
+                {
+                    m_stream->transition_subresource(r, subresource, static_cast<uint32_t>(new_state));
+                }
+
+                void begin_transition_resource(const gpu_virtual_resource* r, D3D12_RESOURCE_STATES new_state)
+                {
+                    m_stream->begin_transition_resource(r, static_cast<uint32_t>(new_state));
+                }
+
+                void end_transition_resource(const gpu_virtual_resource* r)
+                {
+                    m_stream->end_transition_resource(r);
+                }
+
+                void aliasing_barrier(const gpu_virtual_resource* before, const gpu_virtual_resource* after)
+                {
+                    m_stream->aliasing_barrier(before, after);
+                }
+
+                void draw(uint32_t vertex_count, uint32_t vertex_start_offset = 0)
+                {
+                    draw_instanced(vertex_count, 1, vertex_start_offset);
+                }
+
+                void draw_instanced(uint32_t vertex_count_per_instance, uint32_t instance_count, uint32_t start_vertex_location = 0, uint32_t start_instance_location = 0)
+                {
+                    m_stream->draw_instanced(vertex_count_per_instance, instance_count, start_vertex_location, start_instance_location);
+                }
+
+                void draw_indexed(uint32_t index_count, uint32_t start_index_location = 0, int32_t base_vertex_location = 0)
+                {
+                    draw_indexed_instanced(index_count, 1, start_index_location, base_vertex_location, 0);
+                }
+
+                void draw_indexed_instanced(uint32_t index_count_per_instance, uint32_t instance_count, uint32_t start_index_location, int32_t base_vertex_location, uint32_t start_instance_location)
+                {
+                    m_stream->draw_indexed_instanced(index_count_per_instance, instance_count, start_index_location, base_vertex_location, start_instance_location);
+                }
+
+                //the signature writes the draw ids to the root constant of the default root signature
+                void draw_indexed_indirect(ID3D12CommandSignature* signature, const cmd::draw_indexed_instance_arguments arguments[], uint32_t count)
+                {
+                    m_stream->draw_indexed_indirect(signature, default_root_singature::slots::constants_0, arguments, count);
+                }
+
+                void dispatch(uint32_t thread_group_count_x, uint32_t thread_group_count_y = 1, uint32_t thread_group_count_z = 1)
+                {
+                    m_stream->dispatch(thread_group_count_x, thread_group_count_y, thread_group_count_z);
+                }
+
+                void pix_begin_event(const wchar_t* label)
+                {
+                    m_stream->begin_event(label);
+                }
+
+                void pix_end_event(void)
+                {
+                    m_stream->end_event();
+                }
+
+                private:
+
+                cmd::command_stream* m_stream;
+
+                static cmd::view make_view(const gpu_back_buffer* r)            { return { r, cmd::view_type::back_buffer }; }
+                static cmd::view make_view(const gpu_color_buffer* r)           { return { r, cmd::view_type::color_buffer }; }
+                static cmd::view make_view(const gpu_depth_buffer* r)           { return { r, cmd::view_type::depth_buffer }; }
+                static cmd::view make_view(const gpu_depth_stencil_buffer* r)   { return { r, cmd::view_type::depth_stencil_buffer }; }
+            };
+
+            namespace details
+            {
+                //the compute commands exist only on the graphics compute context
+                inline void set_compute_pso(gpu_graphics_compute_command_context* c, const compute_pipeline_state* p)
+                {
+                    c->set_pso(p);
+                }
+
+                inline void set_compute_pso(gpu_graphics_command_context*, const compute_pipeline_state*)
+                {
+                    assert(false);
+                }
+
+                inline void set_compute_constant_buffer(gpu_graphics_compute_command_context* c, uint32_t root_index, const void* buffer, size_t byte_count)
+                {
+                    c->set_compute_constant_buffer(root_index, buffer, byte_count);
+                }
+
+                inline void set_compute_constant_buffer(gpu_graphics_command_context*, uint32_t, const void*, size_t)
+                {
+                    assert(false);
+                }
+
+                inline void set_compute_dynamic_constant_buffer(gpu_graphics_compute_command_context* c, uint32_t root_index, uint32_t offset, const void* buffer, size_t byte_count)
+                {
+                    c->set_compute_dynamic_constant_buffer(root_index, offset, buffer, byte_count);
+                }
+
+                inline void set_compute_dynamic_constant_buffer(gpu_graphics_command_context*, uint32_t, uint32_t, const void*, size_t)
+                {
+                    assert(false);
+                }
+
+                inline void set_compute_dynamic_descriptor(gpu_graphics_compute_command_context* c, uint32_t root_index, D3D12_CPU_DESCRIPTOR_HANDLE handle, uint32_t offset)
+                {
+                    c->set_compute_dynamic_descriptor(root_index, handle, offset);
+                }
+
+                inline void set_compute_dynamic_descriptor(gpu_graphics_command_context*, uint32_t, D3D12_CPU_DESCRIPTOR_HANDLE, uint32_t)
+                {
+                    assert(false);
+                }
+
+                inline void dispatch(gpu_graphics_compute_command_context* c, uint32_t x, uint32_t y, uint32_t z)
+                {
+                    c->dispatch(x, y, z);
+                }
+
+                inline void dispatch(gpu_graphics_command_context*, uint32_t, uint32_t, uint32_t)
+                {
+                    assert(false);
+                }
+            }
+
+            //replays a command stream on gpu_graphics_command_context or gpu_graphics_compute_command_context
+            template <typename context_t> class gpu_command_stream_backend
+            {
+                public:
+
+                explicit gpu_command_stream_backend(context_t* c) : m_context(c)
+                {
+
+                }
+
+                void on(const cmd::set_graphics_pipeline_state_command& c)
+                {
+                    m_context->set_pso(static_cast<const graphics_pipeline_state*>(c.m_pipeline_state));
+                }
+
+                void on(const cmd::set_compute_pipeline_state_command& c)
+                {
+                    details::set_compute_pso(m_context, static_cast<const compute_pipeline_state*>(c.m_pipeline_state));
+                }
+
+                void on(const cmd::set_descriptor_heaps_command&)
+                {
+                    m_context->set_descriptor_heaps();
+                }
+
+                void on(const cmd::set_render_targets_command& c)
+                {
+                    auto color = c.m_color;
+                    auto depth = c.m_depth;
+
+                    if (color.m_type == cmd::view_type::none)
+                    {
+                        if (depth.m_type == cmd::view_type::depth_stencil_buffer)
+                        {
+                            m_context->set_render_target(depth_stencil_buffer(depth));
+                        }
+                        else
+                        {
+                            m_context->set_render_target(depth_buffer(depth));
+                        }
+                    }
+                    else if (depth.m_type == cmd::view_type::none)
+                    {
+                        if (color.m_type == cmd::view_type::back_buffer)
+                        {
+                            m_context->set_render_target(back_buffer(color));
+                        }
+                        else
+                        {
+                            m_context->set_render_target(color_buffer(color));
+                        }
+                    }
+                    else if (color.m_type == cmd::view_type::back_buffer)
+                    {
+                        if (depth.m_type == cmd::view_type::depth_stencil_buffer)
+                        {
+                            m_context->set_render_target(back_buffer(color), depth_stencil_buffer(depth));
+                        }
+                        else
+                        {
+                            m_context->set_render_target(back_buffer(color), depth_buffer(depth));
+                        }
+                    }
+                    else
+                    {
+                        if (depth.m_type == cmd::view_type::depth_stencil_buffer)
+                        {
+                            m_context->set_render_target(color_buffer(color), depth_stencil_buffer(depth));
+                        }
+                        else
+                        {
+                            m_context->set_render_target(color_buffer(color), depth_buffer(depth));
+                        }
+                    }
+                }
+
+                void on(const cmd::clear_render_target_command& c)
+                {
+                    if (c.m_target.m_type == cmd::view_type::back_buffer)
+                    {
+                        m_context->clear(back_buffer(c.m_target));
+                    }
+                    else
+                    {
+                        m_context->clear(color_buffer(c.m_target));
+                    }
+                }
+
+                void on(const cmd::clear_depth_stencil_command& c)
+                {
+                    if (c.m_target.m_type == cmd::view_type::depth_stencil_buffer)
+                    {
+                        auto b = depth_stencil_buffer(c.m_target);
+
+                        switch (c.m_flags)
+                        {
+                            case cmd::clear_depth:                      m_context->clear_depth(b, c.m_depth); break;
+                            case cmd::clear_stencil:                    m_context->clear_stencil(b, c.m_stencil); break;
+                            default:                                    m_context->clear_depth_stencil(b, c.m_depth, c.m_stencil); break;
+                        }
+                    }
+                    else
+                    {
+                        m_context->clear_depth(depth_buffer(c.m_target), c.m_depth);
+                    }
+                }
+
+                void on(const cmd::set_view_port_command& c)
+                {
+                    auto&& v = c.m_view_port;
+                    m_context->set_view_port({ v.m_top_left_x, v.m_top_left_y, v.m_width, v.m_height, v.m_min_depth, v.m_max_depth });
+                }
+
+                void on(const cmd::set_scissor_rectangle_command& c)
+                {
+                    auto&& r = c.m_rectangle;
+                    m_context->set_scissor_rectangle({ r.m_left, r.m_top, r.m_right, r.m_bottom });
+                }
+
+                void on(const cmd::set_primitive_topology_command& c)
+                {
+                    m_context->set_primitive_topology(static_cast<D3D12_PRIMITIVE_TOPOLOGY>(c.m_topology));
+                }
+
+                void on(const cmd::set_vertex_buffer_command& c)
+                {
+                    m_context->set_vertex_buffer(c.m_slot, { c.m_view.m_address, c.m_view.m_size, c.m_view.m_stride });
+                }
+
+                void on(const cmd::set_index_buffer_command& c)
+                {
+                    m_context->set_index_buffer({ c.m_view.m_address, c.m_view.m_size, static_cast<DXGI_FORMAT>(c.m_view.m_format) });
+                }
+
+                void on(const cmd::set_graphics_constant_buffer_command& c)
+                {
+                    m_context->set_graphics_constant_buffer(c.m_root_index, cmd::payload(&c), c.m_byte_count);
+                }
+
+                void on(const cmd::set_compute_constant_buffer_command& c)
+                {
+                    details::set_compute_constant_buffer(m_context, c.m_root_index, cmd::payload(&c), c.m_byte_count);
+                }
+
+                void on(const cmd::set_graphics_dynamic_constant_buffer_command& c)
+                {
+                    m_context->set_graphics_dynamic_constant_buffer(c.m_root_index, c.m_offset, cmd::payload(&c), c.m_byte_count);
+                }
+
+                void on(const cmd::set_compute_dynamic_constant_buffer_command& c)
+                {
+                    details::set_compute_dynamic_constant_buffer(m_context, c.m_root_index, c.m_offset, cmd::payload(&c), c.m_byte_count);
+                }
+
+                void on(const cmd::set_graphics_dynamic_descriptor_command& c)
+                {
+                    m_context->set_graphics_dynamic_descriptor(c.m_root_index, descriptor(c.m_descriptor), c.m_offset);
+                }
+
+                void on(const cmd::set_compute_dynamic_descriptor_command& c)
+                {
+                    details::set_compute_dynamic_descriptor(m_context, c.m_root_index, descriptor(c.m_descriptor), c.m_offset);
+                }
+
+                void on(const cmd::set_graphics_dynamic_srv_buffer_command& c)
+                {
+                    m_context->set_graphics_dynamic_srv_buffer(c.m_root_index, cmd::payload(&c), c.m_byte_count);
+                }
+
+                void on(const cmd::set_graphics_root_constant_command& c)
+                {
+                    m_context->set_graphics_root_constant(c.m_root_index, c.m_value);
+                }
+
+                void on(const cmd::set_graphics_bindless_table_command& c)
+                {
+                    m_context->set_graphics_bindless_table(c.m_root_index);
+                }
+
+                void on(const cmd::track_resource_command& c)
+                {
+                    m_context->track_resource(static_cast<const gpu_virtual_resource*>(c.m_resource), static_cast<D3D12_RESOURCE_STATES>(c.m_state), c.m_subresource_count);
+                }
+
+                void on(const cmd::transition_resource_command& c)
+                {
+                    auto r      = static_cast<const gpu_virtual_resource*>(c.m_resource);
+                    auto after  = static_cast<D3D12_RESOURCE_STATES>(c.m_after);
+
+                    if (c.m_flags == cmd::barrier_flags_begin_only)
+                    {
+                        m_context->begin_transition_resource(r, after);
+                    }
+                    else if (c.m_flags == cmd::barrier_flags_end_only)
+                    {
+                        m_context->end_transition_resource(r);
+                    }
+                    else if (c.m_before != cmd::resource_state_unknown)
+                    {
+                        m_context->transition_resource(r, static_cast<D3D12_RESOURCE_STATES>(c.m_before), after);
+                    }
+                    else if (c.m_subresource != cmd::all_subresources)
+                    {
+                        m_context->transition_subresource(r, c.m_subresource, after);
+                    }
+                    else
+                    {
+                        m_context->transition_resource(r, after);
+                    }
+                }
+
+                void on(const cmd::aliasing_barrier_command& c)
+                {
+                    m_context->aliasing_barrier(static_cast<const gpu_virtual_resource*>(c.m_before), static_cast<const gpu_virtual_resource*>(c.m_after));
+                }
+
+                void on(const cmd::draw_instanced_command& c)
+                {
+                    m_context->draw_instanced(c.m_vertex_count_per_instance, c.m_instance_count, c.m_start_vertex_location, c.m_start_instance_location);
+                }
+
+                void on(const cmd::draw_indexed_instanced_command& c)
+                {
+                    m_context->draw_indexed_instanced(c.m_index_count_per_instance, c.m_instance_count, c.m_start_index_location, c.m_base_vertex_location, c.m_start_instance_location);
+                }
+
+                void on(const cmd::draw_indexed_indirect_command& c)
+                {
+                    //the contexts forget the root constant of the default root signature after the draws
+                    assert(c.m_root_index == default_root_singature::slots::constants_0);
+                    m_context->draw_indexed_indirect(static_cast<ID3D12CommandSignature*>(const_cast<void*>(c.m_signature)), cmd::arguments(&c), c.m_count);
+                }
+
+                void on(const cmd::dispatch_command& c)
+                {
+                    details::dispatch(m_context, c.m_thread_group_count_x, c.m_thread_group_count_y, c.m_thread_group_count_z);
+                }
+
+                void on(const cmd::begin_event_command& c)
+                {
+                    m_context->pix_begin_event(cmd::label(&c));
+                }
+
+                void on(const cmd::end_event_command&)
+                {
+                    m_context->pix_end_event();
+                }
+
+                private:
+
+                context_t* m_context;
+
+                //the contexts take mutable pointers, the stream keeps const ones
+                static gpu_back_buffer*          back_buffer(const cmd::view& v)            { return const_cast<gpu_back_buffer*>(static_cast<const gpu_back_buffer*>(v.m_resource)); }
+                static gpu_color_buffer*         color_buffer(const cmd::view& v)           { return const_cast<gpu_color_buffer*>(static_cast<const gpu_color_buffer*>(v.m_resource)); }
+                static gpu_depth_buffer*         depth_buffer(const cmd::view& v)           { return const_cast<gpu_depth_buffer*>(static_cast<const gpu_depth_buffer*>(v.m_resource)); }
+                static gpu_depth_stencil_buffer* depth_stencil_buffer(const cmd::view& v)   { return const_cast<gpu_depth_stencil_buffer*>(static_cast<const gpu_depth_stencil_buffer*>(v.m_resource)); }
+
+                static D3D12_CPU_DESCRIPTOR_HANDLE descriptor(uint64_t d)
+                {
+                    D3D12_CPU_DESCRIPTOR_HANDLE h;
+                    h.ptr = static_cast<SIZE_T>(d);
+                    return h;
+                }
+            };
+
+            //replays the stream on the context, the context flushes its barriers on the draws as before
+            template <typename context_t> inline void execute(context_t* c, const cmd::command_stream& s)
+            {
+                gpu_command_stream_backend<context_t> b(c);
+                cmd::execute(s, b);
+            }
+        }
+    }
+}
@@ -24,32 +24,28 @@ namespace uc
 
                 void set_pso(const compute_pipeline_state* p )
                 {
-                    if (m_compute_pipeline_state != p)
+                    //upload and reset cache for the descriptor tables, if the root signature changes
+                    if (m_state_filter.set_root_signature(cmd::bind_point::compute, p->m_root_signature))
                     {
-                        //upload and reset cache for the descriptor tables
-                        if (m_compute_pipeline_state)
-                        {
-                            if (m_compute_pipeline_state->m_root_signature != p->m_root_signature)
-                            {
-                                m_descriptor_handle_cache0.set_root_signature_meta_data(*p->m_root_signature_meta_data);
-                                list()->SetComputeRootSignature(p->m_root_signature);
-                                m_compute_pipeline_state = p;
-                            }
-                        }
-                        else
-                        {
-                            m_descriptor_handle_cache0.set_root_signature_meta_data(*p->m_root_signature_meta_data);
-                            list()->SetComputeRootSignature(p->m_root_signature);
-                            m_compute_pipeline_state = p;
-                        }
+                        m_descriptor_handle_cache0.set_root_signature_meta_data(*p->m_root_signature_meta_data);
+                        list()->SetComputeRootSignature(p->m_root_signature);
+                    }
 
+                    //graphics and compute share the pipeline state of the command list
+                    if (m_state_filter.set_pipeline_state(p->m_state))
+                    {
                         list()->SetPipelineState(p->m_state);
                     }
+
+                    m_compute_pipeline_state = p;
                 }
 
                 void set_descriptor_heaps( uint32_t heap_count, ID3D12DescriptorHeap* heaps[] )
                 {
-                    list()->SetDescriptorHeaps(heap_count, heaps);
+                    if (m_state_filter.set_descriptor_heaps(heaps, heap_count))
+                    {
+                        list()->SetDescriptorHeaps(heap_count, heaps);
+                    }
                 }
 
                 void set_descriptor_heaps()
@@ -80,14 +76,20 @@ namespace uc
 
                 void set_compute_constant_buffer(uint32_t root_index, D3D12_GPU_VIRTUAL_ADDRESS address)
                 {
-                    list()->SetComputeRootConstantBufferView(root_index, address);
+                    if (m_state_filter.set_constant_buffer(cmd::bind_point::compute, root_index, address))
+                    {
+                        list()->SetComputeRootConstantBufferView(root_index, address);
+                    }
                 }
 
                 void set_compute_constant_buffer(uint32_t root_index, const void* buffer, size_t byte_count )
                 {
-                    auto allocation = m_upload_allocator.allocate(byte_count, 256);
-                    mem_copy(allocation.cpu_address(), buffer, byte_count);
-                    list()->SetComputeRootConstantBufferView(root_index, allocation.gpu_address());
+                    if (m_state_filter.set_constants(cmd::bind_point::compute, root_index, buffer, byte_count))
+                    {
+                        auto allocation = m_upload_allocator.allocate(byte_count, 256);
+                        mem_copy(allocation.cpu_address(), buffer, byte_count);
+                        list()->SetComputeRootConstantBufferView(root_index, allocation.gpu_address());
+                    }
                 }
 
                 template <typename t>
@@ -122,6 +124,11 @@ namespace uc
                     list()->SetComputeRootDescriptorTable(root_index, h);
                 }
 
+                void set_compute_bindless_table(uint32_t root_index)
+                {
+                    set_compute_root_descriptor_table(root_index, m_rc->frame_gpu_srv_heap()->bindless_table());
+                }
+
                 void set_compute_dynamic_descriptors( uint32_t root_index, const D3D12_CPU_DESCRIPTOR_HANDLE handles[], uint32_t count , uint32_t offset = 0 )
                 {
                     m_descriptor_handle_cache0.set_descriptor_handles(root_index, offset, handles, count);
@@ -139,7 +146,7 @@ namespace uc
                     if (m_descriptor_handle_cache0.dirty())
                     {
                         auto size    = m_descriptor_handle_cache0.size();
-                        auto handles = this->m_rc->frame_gpu_srv_heap()->allocate_incrementable(size);
+                        auto handles = this->m_descriptor_cache.allocate_gpu_srv(size);
                         m_descriptor_handle_cache0.flush(handles, [this](uint32_t root_index, D3D12_GPU_DESCRIPTOR_HANDLE h )
                         {
                             set_compute_root_descriptor_table(root_index, h);
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <uc_dev/util/noncopyable.h>
+#include <uc_dev/gx/dx12/api/helpers.h>
+#include <uc_dev/gx/dx12/gpu/frames_in_flight.h>
+#include <uc_dev/gx/dx12/gpu/read_back_buffer.h>
+#include <uc_dev/gx/dx12/gpu/resource_create_context.h>
+#include <uc_dev/gx/dx12/cmd/command_queue.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace dx12
+        {
+            //gpu time of the frames, a frame writes a timestamp before its first and after its last command list on the queue
+            //the frames use the slots in turn, a frame reads its slot before it writes it, once the fence of the frame which wrote it has passed
+            //one slot more than the frames in flight, as the next frame reads while the previous one still waits for the gpu
+            class gpu_frame_timer : public util::noncopyable
+            {
+                public:
+
+                static const uint32_t slot_count = max_frames_in_flight + 1;
+
+                gpu_frame_timer(ID3D12Device* d, gpu_resource_create_context* rc, gpu_command_queue* q)
+                {
+                    D3D12_QUERY_HEAP_DESC desc = {};
+                    desc.Type   = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+                    desc.Count  = 2 * slot_count;
+
+                    m_heap = create_query_heap(d, &desc);
+                    m_read_back.reset(rc->create_read_back_buffer(2 * slot_count * sizeof(uint64_t)));
+
+                    uint64_t frequency = 0;
+                    throw_if_failed(q->queue()->GetTimestampFrequency(&frequency));
+                    m_milliseconds_per_tick = frequency > 0 ? 1000.0 / static_cast<double>(frequency) : 0.0;
+                }
+
+                //true while the gpu may still resolve the timestamps of the slot into the read back buffer
+                bool pending(uint32_t slot) const
+                {
+                    return m_fences[slot].m_fence != nullptr && !m_fences[slot].is_fence_completed();
+                }
+
+                //the time of the frame which wrote the slot, 0 if none did yet or the gpu is not done with it
+                double milliseconds(uint32_t slot)
+                {
+                    if (m_fences[slot].m_fence == nullptr || pending(slot))
+                    {
+                        return 0.0;
+                    }
+
+                    uint64_t ticks[2];
+                    m_read_back->read(offset(slot), sizeof(ticks), &ticks[0]);
+
+                    return ticks[1] > ticks[0] ? static_cast<double>(ticks[1] - ticks[0]) * m_milliseconds_per_tick : 0.0;
+                }
+
+                template <typename context_t> void begin(context_t* c, uint32_t slot)
+                {
+                    c->end_timestamp_query(m_heap.Get(), 2 * slot);
+                }
+
+                template <typename context_t> void end(context_t* c, uint32_t slot)
+                {
+                    c->end_timestamp_query(m_heap.Get(), 2 * slot + 1);
+                    c->resolve_timestamp_queries(m_heap.Get(), 2 * slot, 2, m_read_back.get(), offset(slot));
+                }
+
+                //the fence of the submit of the context passed to end, the slot is read after the queue passes it
+                void submitted(uint32_t slot, const gpu_fence& f)
+                {
+                    m_fences[slot] = f;
+                }
+
+                private:
+
+                static uint64_t offset(uint32_t slot)
+                {
+                    return 2 * slot * sizeof(uint64_t);
+                }
+
+                Microsoft::WRL::ComPtr<ID3D12QueryHeap> m_heap;
+                std::unique_ptr<gpu_read_back_buffer>   m_read_back;
+                double                                  m_milliseconds_per_tick = 0.0;
+                gpu_fence                               m_fences[slot_count];
+            };
+        }
+    }
+}
@@ -8,6 +8,7 @@
 #include <uc_dev/gx/dx12/cmd/command_context.h>
 
 #include <uc_dev/gx/dx12/gpu/resource_util.h>
+#include <uc_dev/gx/cmd/indirect_draw_buffer.h>
 
 #include <uc_dev/mem/align.h>
 
@@ -244,9 +245,52 @@ namespace uc
                     list()->DrawIndexedInstanced(index_count_per_instance, instance_count, start_index_location, base_vertex_location, start_instance_location);
                 }
 
+                //count indexed draws from an argument buffer in one call, the buffer must be in the indirect argument state
+                void draw_indexed_indirect(gpu_virtual_resource* arguments, uint64_t offset, uint32_t count)
+                {
+                    flush_resource_barriers();
+                    commit_graphics_root_descriptor_tables();
+                    list()->ExecuteIndirect(m_command_manager->draw_indexed_signature(), count, arguments->resource(), offset, nullptr, 0);
+                }
+
+                //uploads the arguments built on the cpu and draws them in one call
+                void draw_indexed_indirect(const cmd::draw_indexed_arguments arguments[], uint32_t count)
+                {
+                    if (count > 0)
+                    {
+                        auto byte_count = count * sizeof(cmd::draw_indexed_arguments);
+                        auto allocation = m_upload_allocator.allocate(byte_count, 16);
+                        mem_copy(allocation.cpu_address(), arguments, byte_count);
+
+                        //the upload pages are in the generic read state, which contains the indirect argument state
+                        draw_indexed_indirect(allocation.resource(), allocation.offset(), count);
+                    }
+                }
+
+                //uploads the arguments with draw ids and draws them in one call, the signature sets the draw id root constant of the bound root signature
+                void draw_indexed_indirect(ID3D12CommandSignature* signature, const cmd::draw_indexed_instance_arguments arguments[], uint32_t count)
+                {
+                    if (count > 0)
+                    {
+                        auto byte_count = count * sizeof(cmd::draw_indexed_instance_arguments);
+                        auto allocation = m_upload_allocator.allocate(byte_count, 16);
+                        mem_copy(allocation.cpu_address(), arguments, byte_count);
+
+                        flush_resource_barriers();
+                        commit_graphics_root_descriptor_tables();
+                        list()->ExecuteIndirect(signature, count, allocation.resource()->resource(), allocation.offset(), nullptr, 0);
+
+                        //the last draw id stays in the root constant, the filter must not drop the next set of it
+                        m_state_filter.invalidate_root_argument(cmd::bind_point::graphics, default_root_singature::slots::constants_0);
+                    }
+                }
+
                 void set_primitive_topology(D3D12_PRIMITIVE_TOPOLOGY topology)
                 {
-                    list()->IASetPrimitiveTopology(topology);
+                    if (m_state_filter.set_primitive_topology(static_cast<uint32_t>(topology)))
+                    {
+                        list()->IASetPrimitiveTopology(topology);
+                    }
                 }
 
                 void set_view_port(const D3D12_VIEWPORT& vp)
@@ -261,33 +305,29 @@ namespace uc
 
                 void set_pso(const graphics_pipeline_state* p )
                 {
-                    if (m_graphics_pipeline_state != p)
+                    //upload and reset cache for the descriptor tables, if the root signature changes
+                    if (m_state_filter.set_root_signature(cmd::bind_point::graphics, p->m_root_signature))
                     {
-                        //upload and reset cache for the descriptor tables
-                        if (m_graphics_pipeline_state)
-                        {
-                            if (m_graphics_pipeline_state->m_root_signature != p->m_root_signature)
-                            {
-                                m_descriptor_handle_cache0.set_root_signature_meta_data(*p->m_root_signature_meta_data);
-                                list()->SetGraphicsRootSignature(p->m_root_signature);
-                                m_graphics_pipeline_state = p;
-                            }
-                        }
-                        else
-                        {
-                            m_descriptor_handle_cache0.set_root_signature_meta_data(*p->m_root_signature_meta_data);
-                            list()->SetGraphicsRootSignature(p->m_root_signature);
-                            m_graphics_pipeline_state = p;
-                        }
+                        m_descriptor_handle_cache0.set_root_signature_meta_data(*p->m_root_signature_meta_data);
+                        list()->SetGraphicsRootSignature(p->m_root_signature);
+                    }
 
+                    //graphics and compute share the pipeline state of the command list
+                    if (m_state_filter.set_pipeline_state(p->m_state))
+                    {
                         list()->SetPipelineState(p->m_state);
                     }
+
+                    m_graphics_pipeline_state = p;
                 }
 
 
                 void set_descriptor_heaps( uint32_t heap_count, ID3D12DescriptorHeap* heaps[] )
                 {
-                    list()->SetDescriptorHeaps(heap_count, heaps);
+                    if (m_state_filter.set_descriptor_heaps(heaps, heap_count))
+                    {
+                        list()->SetDescriptorHeaps(heap_count, heaps);
+                    }
                 }
 
                 void set_descriptor_heaps()
@@ -298,17 +338,23 @@ namespace uc
 
                 void set_index_buffer( D3D12_INDEX_BUFFER_VIEW view)
                 {
-                    list()->IASetIndexBuffer(&view);
+                    if (m_state_filter.set_index_buffer(to_index_buffer_view(view)))
+                    {
+                        list()->IASetIndexBuffer(&view);
+                    }
                 }
 
                 void set_vertex_buffer(uint32_t slot, D3D12_VERTEX_BUFFER_VIEW view)
                 {
-                    list()->IASetVertexBuffers(slot, 1, &view);
+                    set_vertex_buffers(slot, 1, &view);
                 }
 
                 void set_vertex_buffers( uint32_t slot, uint32_t count, const D3D12_VERTEX_BUFFER_VIEW views[])
                 {
-                    list()->IASetVertexBuffers(slot, count, views);
+                    if (filter_vertex_buffers(slot, count, views))
+                    {
+                        list()->IASetVertexBuffers(slot, count, views);
+                    }
                 }
 
                 void set_graphics_srv_buffer(uint32_t root_index, gpu_virtual_resource* r)
@@ -321,6 +367,14 @@ namespace uc
                     list()->SetGraphicsRootShaderResourceView(root_index, 0);
                 }
 
+                //uploads a structured buffer generated every frame, as the instance data of the indirect draws
+                void set_graphics_dynamic_srv_buffer(uint32_t root_index, const void* buffer, size_t byte_count)
+                {
+                    auto allocation = m_upload_allocator.allocate(byte_count, 16);
+                    mem_copy(allocation.cpu_address(), buffer, byte_count);
+                    list()->SetGraphicsRootShaderResourceView(root_index, allocation.gpu_address());
+                }
+
                 void set_graphics_uav_buffer(uint32_t root_index, gpu_virtual_resource* r)
                 {
                     list()->SetGraphicsRootUnorderedAccessView(root_index, r->virtual_address());
@@ -333,14 +387,29 @@ namespace uc
 
                 void set_graphics_constant_buffer(uint32_t root_index, D3D12_GPU_VIRTUAL_ADDRESS address)
                 {
-                    list()->SetGraphicsRootConstantBufferView(root_index, address);
+                    if (m_state_filter.set_constant_buffer(cmd::bind_point::graphics, root_index, address))
+                    {
+                        list()->SetGraphicsRootConstantBufferView(root_index, address);
+                    }
                 }
 
                 void set_graphics_constant_buffer(uint32_t root_index, const void* buffer, size_t byte_count )
                 {
-                    auto allocation = m_upload_allocator.allocate(byte_count, 256);
-                    mem_copy(allocation.cpu_address(), buffer, byte_count);
-                    list()->SetGraphicsRootConstantBufferView(root_index, allocation.gpu_address());
+                    if (m_state_filter.set_constants(cmd::bind_point::graphics, root_index, buffer, byte_count))
+                    {
+                        auto allocation = m_upload_allocator.allocate(byte_count, 256);
+                        mem_copy(allocation.cpu_address(), buffer, byte_count);
+                        list()->SetGraphicsRootConstantBufferView(root_index, allocation.gpu_address());
+                    }
+                }
+
+                //one 32 bit root constant, as the bindless index of a texture
+                void set_graphics_root_constant(uint32_t root_index, uint32_t value)
+                {
+                    if (m_state_filter.set_constants(cmd::bind_point::graphics, root_index, &value, sizeof(value)))
+                    {
+                        list()->SetGraphicsRoot32BitConstant(root_index, value, 0);
+                    }
                 }
 
                 template< typename t >
@@ -421,6 +490,12 @@ namespace uc
                     list()->SetGraphicsRootDescriptorTable(root_index, h);
                 }
 
+                //unbounded table of the srvs of the long lived textures, the shaders index it with bindless_index()
+                void set_graphics_bindless_table(uint32_t root_index)
+                {
+                    set_graphics_root_descriptor_table(root_index, m_rc->frame_gpu_srv_heap()->bindless_table());
+                }
+
                 void set_graphics_dynamic_descriptors( uint32_t root_index, const D3D12_CPU_DESCRIPTOR_HANDLE handles[], uint32_t count , uint32_t offset = 0 )
                 {
                     m_descriptor_handle_cache0.set_descriptor_handles(root_index, offset, handles, count);
@@ -445,27 +520,20 @@ namespace uc
 
                 void set_pso(const compute_pipeline_state* p)
                 {
-                    if (m_compute_pipeline_state != p)
+                    //upload and reset cache for the descriptor tables, if the root signature changes
+                    if (m_state_filter.set_root_signature(cmd::bind_point::compute, p->m_root_signature))
                     {
-                        //upload and reset cache for the descriptor tables
-                        if (m_compute_pipeline_state)
-                        {
-                            if (m_compute_pipeline_state->m_root_signature != p->m_root_signature)
-                            {
-                                m_descriptor_handle_cache1.set_root_signature_meta_data(*p->m_root_signature_meta_data);
-                                list()->SetComputeRootSignature(p->m_root_signature);
-                                m_compute_pipeline_state = p;
-                            }
-                        }
-                        else
-                        {
-                            m_descriptor_handle_cache1.set_root_signature_meta_data(*p->m_root_signature_meta_data);
-                            list()->SetComputeRootSignature(p->m_root_signature);
-                            m_compute_pipeline_state = p;
-                        }
+                        m_descriptor_handle_cache1.set_root_signature_meta_data(*p->m_root_signature_meta_data);
+                        list()->SetComputeRootSignature(p->m_root_signature);
+                    }
 
+                    //graphics and compute share the pipeline state of the command list
+                    if (m_state_filter.set_pipeline_state(p->m_state))
+                    {
                         list()->SetPipelineState(p->m_state);
                     }
+
+                    m_compute_pipeline_state = p;
                 }
 
                 void set_compute_srv_buffer(uint32_t root_index, gpu_virtual_resource* r)
@@ -490,14 +558,20 @@ namespace uc
 
                 void set_compute_constant_buffer(uint32_t root_index, D3D12_GPU_VIRTUAL_ADDRESS address)
                 {
-                    list()->SetComputeRootConstantBufferView(root_index, address);
+                    if (m_state_filter.set_constant_buffer(cmd::bind_point::compute, root_index, address))
+                    {
+                        list()->SetComputeRootConstantBufferView(root_index, address);
+                    }
                 }
 
                 void set_compute_constant_buffer(uint32_t root_index, const void* buffer, size_t byte_count)
                 {
-                    auto allocation = m_upload_allocator.allocate(byte_count, 256);
-                    mem_copy(allocation.cpu_address(), buffer, byte_count);
-                    list()->SetComputeRootConstantBufferView(root_index, allocation.gpu_address());
+                    if (m_state_filter.set_constants(cmd::bind_point::compute, root_index, buffer, byte_count))
+                    {
+                        auto allocation = m_upload_allocator.allocate(byte_count, 256);
+                        mem_copy(allocation.cpu_address(), buffer, byte_count);
+                        list()->SetComputeRootConstantBufferView(root_index, allocation.gpu_address());
+                    }
                 }
 
                 template <typename t>
@@ -532,6 +606,11 @@ namespace uc
                     list()->SetComputeRootDescriptorTable(root_index, h);
                 }
 
+                void set_compute_bindless_table(uint32_t root_index)
+                {
+                    set_compute_root_descriptor_table(root_index, m_rc->frame_gpu_srv_heap()->bindless_table());
+                }
+
                 void set_compute_dynamic_descriptors(uint32_t root_index, const D3D12_CPU_DESCRIPTOR_HANDLE handles[], uint32_t count, uint32_t offset = 0)
                 {
                     m_descriptor_handle_cache1.set_descriptor_handles(root_index, offset, handles, count);
@@ -549,7 +628,7 @@ namespace uc
                     if (m_descriptor_handle_cache0.dirty())
                     {
                         auto size    = m_descriptor_handle_cache0.size();
-                        auto handles = this->m_rc->frame_gpu_srv_heap()->allocate_incrementable(size);
+                        auto handles = this->m_descriptor_cache.allocate_gpu_srv(size);
                         m_descriptor_handle_cache0.flush(handles, [this](uint32_t root_index, D3D12_GPU_DESCRIPTOR_HANDLE h )
                         {
                             set_graphics_root_descriptor_table(root_index, h);
@@ -563,7 +642,7 @@ namespace uc
                     if (m_descriptor_handle_cache1.dirty())
                     {
                         auto size = m_descriptor_handle_cache1.size();
-                        auto handles = this->m_rc->frame_gpu_srv_heap()->allocate_incrementable(size);
+                        auto handles = this->m_descriptor_cache.allocate_gpu_srv(size);
                         m_descriptor_handle_cache1.flush(handles, [this](uint32_t root_index, D3D12_GPU_DESCRIPTOR_HANDLE h)
                         {
                             set_compute_root_descriptor_table(root_index, h);
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <ppl.h>
+
+#include <uc_dev/util/noncopyable.h>
+#include <uc_dev/gx/dx12/cmd/command_context_utils.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace dx12
+        {
+            //number of jobs for item_count items, at least min_items_per_job items per job and at most one job per core
+            inline uint32_t parallel_job_count(size_t item_count, size_t min_items_per_job)
+            {
+                size_t cores    = std::max(1U, std::thread::hardware_concurrency());
+                size_t per_job  = std::max<size_t>(min_items_per_job, 1);
+                size_t jobs     = (item_count + per_job - 1) / per_job;
+
+                return static_cast<uint32_t>(std::max<size_t>(1, std::min(jobs, cores)));
+            }
+
+            struct parallel_job_range
+            {
+                size_t m_begin;
+                size_t m_end;
+            };
+
+            //the items of a job, the jobs get equal ranges in the order of the items
+            inline parallel_job_range parallel_job_items(size_t item_count, uint32_t job_count, uint32_t job)
+            {
+                return { item_count * job / job_count, item_count * (job + 1) / job_count };
+            }
+
+            //records one pass into several command lists in parallel, one context per job, and submits the lists in the order of the jobs
+            //record into front() before record() the work which must precede the jobs, like transitions and clears, and into back() after it the work which must follow them
+            //the command lists do not share state, so every job sets the render targets, the view port, the heaps and the pipeline state it needs
+            template <typename context_t>
+            class gpu_parallel_command_context : public util::noncopyable
+            {
+                public:
+
+                using managed_context = std::unique_ptr< context_t, details::gpu_command_context_deleter >;
+
+                gpu_parallel_command_context(gpu_command_context_allocator* a, uint32_t job_count)
+                {
+                    job_count = std::max(job_count, 1U);
+                    m_contexts.reserve(job_count);
+
+                    for (auto i = 0U; i < job_count; ++i)
+                    {
+                        m_contexts.emplace_back(static_cast<context_t*>(a->create_base_command_context()), details::gpu_command_context_deleter(a));
+                    }
+                }
+
+                uint32_t size() const
+                {
+                    return static_cast<uint32_t>(m_contexts.size());
+                }
+
+                context_t* operator[](uint32_t job) const
+                {
+                    return m_contexts[job].get();
+                }
+
+                context_t* front() const
+                {
+                    return m_contexts.front().get();
+                }
+
+                context_t* back() const
+                {
+                    return m_contexts.back().get();
+                }
+
+                //calls f(context_t*, uint32_t job) for every job on the task pool, returns when all jobs are recorded
+                template <typename f> void record(f&& fn)
+                {
+                    if (m_contexts.size() == 1)
+                    {
+                        fn(m_contexts[0].get(), 0U);
+                        return;
+                    }
+
+                    concurrency::parallel_for(0U, size(), [this, &fn](uint32_t job)
+                    {
+                        fn(m_contexts[job].get(), job);
+                    });
+                }
+
+                //closes the command lists and executes them in one submission
+                gpu_fence submit()
+                {
+                    std::vector<ID3D12CommandList*> lists;
+                    lists.reserve(m_contexts.size());
+
+                    for (auto&& c : m_contexts)
+                    {
+                        c->close();
+                        lists.push_back(c->command_list());
+                    }
+
+                    auto v = m_contexts.front()->m_command_queue->execute_command_lists(size(), &lists[0]);
+
+                    for (auto&& c : m_contexts)
+                    {
+                        c->retire(v);
+                    }
+
+                    return v;
+                }
+
+                private:
+
+                std::vector<managed_context> m_contexts;
+            };
+        }
+    }
+}
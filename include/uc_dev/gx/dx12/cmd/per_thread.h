@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include <uc_dev/util/noncopyable.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace dx12
+        {
+            //small number of the calling thread, in the order the threads first ask for it
+            inline uint32_t thread_index()
+            {
+                static std::atomic<uint32_t> threads(0);
+                thread_local uint32_t index = threads++;
+                return index;
+            }
+
+            //one value per recording thread, so the threads do not contend on one lock
+            //the slot of a thread is locked only by the thread itself, unless there are more threads than slots,
+            //or another thread steals from it, or for_each visits it at the end of the frame
+            template <typename t, uint32_t slot_count = 64>
+            class per_thread : public util::noncopyable
+            {
+                static_assert(slot_count <= 64, "the used slots are bits of one uint64_t");
+
+                public:
+
+                per_thread()
+                {
+                    for (auto&& s : m_slots)
+                    {
+                        s.m_lock.clear();
+                    }
+                }
+
+                //calls f with the value of the calling thread
+                template <typename f> auto local(f&& fn)
+                {
+                    auto index  = thread_index() % slot_count;
+                    auto bit    = uint64_t(1) << index;
+
+                    //set once per slot, so the threads do not write the shared mask on every call
+                    if ((m_used.load(std::memory_order_relaxed) & bit) == 0)
+                    {
+                        m_used.fetch_or(bit, std::memory_order_relaxed);
+                    }
+
+                    auto&& s = m_slots[index];
+                    guard g(s);
+                    return fn(s.m_value);
+                }
+
+                //calls f with the values of the other threads, until it returns true, to take their spare objects
+                //the spare objects are mostly in the slot of the submitting thread, so the scan starts at the slot of the last steal
+                //and skips the slots no thread has used
+                template <typename f> bool steal(f&& fn)
+                {
+                    auto self   = thread_index() % slot_count;
+                    auto used   = m_used.load(std::memory_order_relaxed) & ~(uint64_t(1) << self);
+                    auto victim = m_victim.load(std::memory_order_relaxed);
+
+                    for (auto i = 0U; i < slot_count && used != 0; ++i)
+                    {
+                        auto index  = (victim + i) % slot_count;
+                        auto bit    = uint64_t(1) << index;
+
+                        if ((used & bit) == 0)
+                        {
+                            continue;
+                        }
+
+                        used &= ~bit;
+
+                        auto&& s = m_slots[index];
+                        guard g(s);
+
+                        if (fn(s.m_value))
+                        {
+                            if (index != victim)
+                            {
+                                m_victim.store(index, std::memory_order_relaxed);
+                            }
+
+                            return true;
+                        }
+                    }
+
+                    return false;
+                }
+
+                //the slots no thread has used have the values they were constructed with
+                template <typename f> void for_each(f&& fn)
+                {
+                    auto used = m_used.load(std::memory_order_relaxed);
+
+                    for (auto i = 0U; i < slot_count; ++i)
+                    {
+                        if (used & (uint64_t(1) << i))
+                        {
+                            auto&& s = m_slots[i];
+                            guard g(s);
+                            fn(s.m_value);
+                        }
+                    }
+                }
+
+                private:
+
+                struct alignas(64) slot
+                {
+                    std::atomic_flag    m_lock;
+                    t                   m_value;
+                };
+
+                struct guard
+                {
+                    slot& m_s;
+
+                    guard(slot& s) : m_s(s)
+                    {
+                        while (m_s.m_lock.test_and_set(std::memory_order_acquire))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+
+                    ~guard()
+                    {
+                        m_s.m_lock.clear(std::memory_order_release);
+                    }
+
+                    guard(const guard&) = delete;
+                    guard& operator=(const guard&) = delete;
+                };
+
+                slot                                m_slots[slot_count];
+                alignas(64) std::atomic<uint64_t>   m_used      { 0 };      //the slots a thread called local on
+                std::atomic<uint32_t>               m_victim    { 0 };      //the slot of the last steal
+            };
+        }
+    }
+}
@@ -23,7 +23,11 @@ namespace uc
 
                     uav_0 = 2,
                     uav_1 = 4,
-                    uav_2 = 8
+                    uav_2 = 8,
+
+                    constants_0 = 7,
+
+                    bindless_0 = 9      //MyRS3 only, the bindless table of the long lived textures
                 };
             };
 
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+#include <uc_dev/util/noncopyable.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace dx12
+        {
+            //ring of descriptor indices [0, capacity), the recording threads allocate from it without locks
+            //the owner retires the allocations with a fence value and reclaims them when the fence is completed
+            //retire and reclaim run on one thread, when no recording is in flight, for example when the frame ends
+            class descriptor_ring : public util::noncopyable
+            {
+                public:
+
+                static const uint32_t invalid = 0xFFFFFFFF;
+
+                explicit descriptor_ring(uint32_t capacity) : m_capacity(capacity)
+                {
+
+                }
+
+                //first index of count contiguous descriptors or invalid if the ring is full, the ranges do not wrap around the end
+                uint32_t allocate(uint32_t count)
+                {
+                    auto head = m_head.load(std::memory_order_relaxed);
+
+                    for (;;)
+                    {
+                        auto begin  = head;
+                        auto offset = begin % m_capacity;
+
+                        //skip the end of the ring, if the range does not fit there
+                        if (offset + count > m_capacity)
+                        {
+                            begin += m_capacity - offset;
+                        }
+
+                        auto end = begin + count;
+
+                        if (count == 0 || count > m_capacity || end - m_tail.load(std::memory_order_acquire) > m_capacity)
+                        {
+                            return invalid;
+                        }
+
+                        if (m_head.compare_exchange_weak(head, end, std::memory_order_relaxed, std::memory_order_relaxed))
+                        {
+                            return static_cast<uint32_t>(begin % m_capacity);
+                        }
+                    }
+                }
+
+                //everything allocated so far is in use until fence is completed
+                void retire(uint64_t fence)
+                {
+                    m_retired.push_back({ fence, m_head.load(std::memory_order_relaxed) });
+                }
+
+                //frees the allocations retired with fences up to completed_fence
+                void reclaim(uint64_t completed_fence)
+                {
+                    while (!m_retired.empty() && m_retired.front().m_fence <= completed_fence)
+                    {
+                        m_tail.store(m_retired.front().m_head, std::memory_order_release);
+                        m_retired.pop_front();
+                    }
+                }
+
+                uint32_t capacity() const
+                {
+                    return m_capacity;
+                }
+
+                //descriptors in use, with the skipped ends of the ring
+                uint32_t size() const
+                {
+                    return static_cast<uint32_t>(m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed));
+                }
+
+                private:
+
+                struct retired
+                {
+                    uint64_t m_fence;
+                    uint64_t m_head;
+                };
+
+                //the head and the tail only grow, their difference is the used part of the ring
+                std::atomic<uint64_t>   m_head { 0 };
+                std::atomic<uint64_t>   m_tail { 0 };
+                uint32_t                m_capacity;
+                std::deque<retired>     m_retired;
+            };
+
+            //cursor of one context into a block of a ring, so only the new blocks go to the shared ring
+            //the heap allocates with uint32_t allocate_index(uint32_t count), which returns descriptor_ring::invalid when it is full
+            template <uint32_t block_size>
+            struct descriptor_ring_cache
+            {
+                uint32_t m_begin = 0;
+                uint32_t m_size  = 0;
+
+                template <typename heap> uint32_t allocate(heap* h, uint32_t count)
+                {
+                    //large tables do not pass through the block
+                    if (count > block_size / 2)
+                    {
+                        return h->allocate_index(count);
+                    }
+
+                    if (m_size < count)
+                    {
+                        m_begin = h->allocate_index(block_size);
+                        m_size  = m_begin != descriptor_ring::invalid ? block_size : 0;
+
+                        if (m_size == 0)
+                        {
+                            return descriptor_ring::invalid;
+                        }
+                    }
+
+                    auto r  = m_begin;
+                    m_begin += count;
+                    m_size  -= count;
+                    return r;
+                }
+
+                void reset()
+                {
+                    m_size = 0;
+                }
+            };
+
+            //stable indices of long lived descriptors, for bindless descriptor tables
+            //allocate and free do not lock, the freed index is reused right away, so free it when the gpu is done with it
+            class descriptor_index_pool : public util::noncopyable
+            {
+                public:
+
+                static const uint32_t invalid = 0xFFFFFFFF;
+
+                explicit descriptor_index_pool(uint32_t capacity) :
+                    m_next(new std::atomic<uint32_t>[capacity > 0 ? capacity : 1])
+                    , m_capacity(capacity)
+                {
+
+                }
+
+                uint32_t allocate()
+                {
+                    auto head = m_free.load(std::memory_order_acquire);
+
+                    while (index(head) != invalid)
+                    {
+                        auto next = m_next[index(head)].load(std::memory_order_relaxed);
+
+                        if (m_free.compare_exchange_weak(head, make_head(tag(head) + 1, next), std::memory_order_acquire, std::memory_order_acquire))
+                        {
+                            return index(head);
+                        }
+                    }
+
+                    //never used indices
+                    auto r = m_unallocated.fetch_add(1, std::memory_order_relaxed);
+
+                    if (r >= m_capacity)
+                    {
+                        m_unallocated.fetch_sub(1, std::memory_order_relaxed);
+                        return invalid;
+                    }
+
+                    return r;
+                }
+
+                void free(uint32_t i)
+                {
+                    auto head = m_free.load(std::memory_order_relaxed);
+
+                    do
+                    {
+                        m_next[i].store(index(head), std::memory_order_relaxed);
+                    } while (!m_free.compare_exchange_weak(head, make_head(tag(head) + 1, i), std::memory_order_release, std::memory_order_relaxed));
+                }
+
+                uint32_t capacity() const
+                {
+                    return m_capacity;
+                }
+
+                private:
+
+                //the free list head is the top index and a tag, which changes on every update, so a stale head does not compare equal
+                static uint64_t make_head(uint32_t tag, uint32_t index)
+                {
+                    return (static_cast<uint64_t>(tag) << 32) | index;
+                }
+
+                static uint32_t index(uint64_t head)
+                {
+                    return static_cast<uint32_t>(head);
+                }
+
+                static uint32_t tag(uint64_t head)
+                {
+                    return static_cast<uint32_t>(head >> 32);
+                }
+
+                std::unique_ptr< std::atomic<uint32_t>[] >  m_next;
+                std::atomic<uint64_t>                       m_free { make_head(0, invalid) };
+                std::atomic<uint32_t>                       m_unallocated { 0 };
+                uint32_t                                    m_capacity;
+            };
+        }
+    }
+}
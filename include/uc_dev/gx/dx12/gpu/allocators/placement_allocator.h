@@ -104,6 +104,37 @@ namespace uc
                     return create_placed_resource(desc, initialState, nullptr);
                 }
 
+                //reserves a block, the resources which share its memory are placed in it at their own offsets
+                uint64_t allocate(uint64_t size, uint64_t alignment)
+                {
+                    std::lock_guard< placement_heap_allocator > guard(*this);
+                    if (align(m_heap_offset, alignment) + size <= m_size)
+                    {
+                        m_heap_offset = align(m_heap_offset, alignment);
+                        auto r = m_heap_offset;
+                        m_heap_offset += size;
+                        return r;
+                    }
+                    else
+                    {
+                        raise_out_of_memory_exception();
+                        return 0;
+                    }
+                }
+
+                //at an offset from the start of the heap, in a block from allocate, the resources at the same offset alias
+                Microsoft::WRL::ComPtr<ID3D12Resource> create_placed_resource(uint64_t offset, const D3D12_RESOURCE_DESC *desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE *optimizedClearValue)
+                {
+                    Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+                    throw_if_failed(m_device->CreatePlacedResource(m_heap.Get(), offset, desc, initialState, optimizedClearValue, IID_PPV_ARGS(&resource)));
+                    return resource;
+                }
+
+                D3D12_RESOURCE_ALLOCATION_INFO allocation_info(const D3D12_RESOURCE_DESC *desc) const
+                {
+                    return m_device->GetResourceAllocationInfo(1, 1, desc);
+                }
+
                 void reset()
                 {
                     std::lock_guard< placement_heap_allocator > guard(*this);
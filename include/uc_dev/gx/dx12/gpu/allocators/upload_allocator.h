@@ -178,8 +178,8 @@ namespace uc
                     }
                     else
                     {
-                        std::unique_ptr<gpu_upload_page> page = std::unique_ptr<gpu_upload_page>(allocate_page());
-                        auto allocation = gpu_upload_allocation(m_page.get(), m_offset);
+                        std::unique_ptr<gpu_upload_page> page = std::unique_ptr<gpu_upload_page>(allocate_page(static_cast<size_t>(aligned_size)));
+                        auto allocation = gpu_upload_allocation(page.get(), 0);
                         m_buffers.emplace_back(std::move(page));
                         return allocation;
                     }
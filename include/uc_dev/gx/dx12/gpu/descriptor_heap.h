@@ -10,6 +10,7 @@
 #include <wrl/client.h>
 
 #include <uc_dev/gx/dx12/api/error.h>
+#include <uc_dev/gx/dx12/gpu/allocators/descriptor_ring.h>
 #include <uc_dev/mem/ref_counter.h>
 #include <uc_dev/util/noncopyable.h>
 
@@ -116,6 +117,7 @@ namespace uc
 
                 uint64_t increment_offset(uint32_t count)
                 {
+                    std::lock_guard < std::mutex> g(m_lock);
                     auto offset = m_offset;
                     m_offset += count;
                     return offset;
@@ -123,7 +125,8 @@ namespace uc
 
                 protected:
 
-                uint64_t  m_offset = 0;
+                uint64_t    m_offset = 0;
+                std::mutex  m_lock;
             };
 
             struct fenced_increment_policy
@@ -179,7 +182,6 @@ namespace uc
                     D3D12_CPU_DESCRIPTOR_HANDLE cpu;
                     D3D12_GPU_DESCRIPTOR_HANDLE gpu;
 
-                    std::lock_guard < std::mutex> g(m_lock);
                     auto offset = increment_offset(count);
 
                     assert(!full(count));
@@ -243,8 +245,137 @@ namespace uc
                 D3D12_GPU_DESCRIPTOR_HANDLE                  m_gpu_begin;
                 uint64_t                                     m_increment_size;
 
-                std::mutex                                   m_lock;
+            };
+
+            //=================================================================================================================================
+            //frame data of the command contexts. the contexts allocate from a ring without locks, the owner retires the ring with fences
+            //the front of the heap holds the bindless descriptors of long lived resources, they keep their index until they are freed
+            template < D3D12_DESCRIPTOR_HEAP_TYPE heap, D3D12_DESCRIPTOR_HEAP_FLAGS flags >
+            class gpu_ring_descriptor_heap : public util::noncopyable
+            {
+                using this_type = gpu_ring_descriptor_heap<heap, flags>;
+
+                public:
+                using is_shader_visible = typename shader_visible_type < (flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE ) != 0 > ;
+
+                using descriptor_handle = heap_handle<this_type>;
+
+                gpu_ring_descriptor_heap(ID3D12Device* device, uint32_t ring_count, uint32_t bindless_count = 0, UINT NodeMask = 0) :
+                    m_ring(ring_count)
+                    , m_bindless(bindless_count)
+                {
+                    D3D12_DESCRIPTOR_HEAP_DESC desc = {};
+
+                    desc.Type = static_cast<D3D12_DESCRIPTOR_HEAP_TYPE> (heap);
+                    desc.Flags = static_cast<D3D12_DESCRIPTOR_HEAP_FLAGS> (flags);
+                    desc.NumDescriptors = ring_count + bindless_count;
+                    desc.NodeMask = NodeMask;
+
+                    throw_if_failed(device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&m_resource)));
+
+                    m_cpu_begin = m_resource->GetCPUDescriptorHandleForHeapStart();
+                    m_gpu_begin = m_resource->GetGPUDescriptorHandleForHeapStart();
+
+                    m_increment_size = device->GetDescriptorHandleIncrementSize(desc.Type);
+                }
+
+                //index in the heap of count contiguous descriptors from the ring
+                uint32_t allocate_index(uint32_t count)
+                {
+                    auto offset = m_ring.allocate(count);
+                    return offset != descriptor_ring::invalid ? offset + m_bindless.capacity() : offset;
+                }
+
+                descriptor_handle allocate(uint32_t count)
+                {
+                    auto index = allocate_index(count);
+                    assert(index != descriptor_ring::invalid);
+                    return handle(index);
+                }
+
+                descriptor_handle allocate()
+                {
+                    return allocate(1);
+                }
+
+                incrementable_descriptor_handle allocate_incrementable(uint32_t count)
+                {
+                    return incrementable(allocate(count));
+                }
+
+                descriptor_handle handle(uint32_t index) const
+                {
+                    D3D12_CPU_DESCRIPTOR_HANDLE cpu;
+                    D3D12_GPU_DESCRIPTOR_HANDLE gpu;
+
+                    cpu.ptr = static_cast<size_t>(m_cpu_begin.ptr + index * m_increment_size);
+                    gpu.ptr = static_cast<uint64_t>(m_gpu_begin.ptr + index * m_increment_size);
+
+                    return descriptor_handle(cpu, gpu);
+                }
+
+                incrementable_descriptor_handle incrementable(descriptor_handle h) const
+                {
+                    return incrementable_descriptor_handle(h, m_increment_size);
+                }
+
+                //the descriptors allocated so far are used by the command lists, which signal fence
+                void retire(uint64_t fence)
+                {
+                    m_ring.retire(fence);
+                }
+
+                void reclaim(uint64_t completed_fence)
+                {
+                    m_ring.reclaim(completed_fence);
+                }
+
+                //stable index in the bindless table, or descriptor_index_pool::invalid if the table is full
+                uint32_t allocate_bindless()
+                {
+                    return m_bindless.allocate();
+                }
+
+                void free_bindless(uint32_t index)
+                {
+                    m_bindless.free(index);
+                }
+
+                //the bindless descriptors start at the heap start, so the table index is the heap index
+                D3D12_GPU_DESCRIPTOR_HANDLE bindless_table() const
+                {
+                    return m_gpu_begin;
+                }
+
+                uint32_t bindless_size() const
+                {
+                    return m_bindless.capacity();
+                }
+
+                ID3D12DescriptorHeap* resource() const
+                {
+                    return m_resource.Get();
+                }
+
+                uint64_t increment_size() const
+                {
+                    return m_increment_size;
+                }
+
+                D3D12_GPU_DESCRIPTOR_HANDLE heap_start() const
+                {
+                    return m_gpu_begin;
+                }
+
+            private:
 
+                Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_resource;
+                D3D12_CPU_DESCRIPTOR_HANDLE                  m_cpu_begin;
+                D3D12_GPU_DESCRIPTOR_HANDLE                  m_gpu_begin;
+                uint64_t                                     m_increment_size;
+
+                descriptor_ring                              m_ring;
+                descriptor_index_pool                        m_bindless;
             };
 
             //=================================================================================================================================
@@ -386,6 +517,23 @@ namespace uc
             using persistent_cpu_rtv_descriptor_heap_handle = descriptor_heap_handle< persistent_cpu_rtv_descriptor_heap >;
             using persistent_cpu_dsv_descriptor_heap_handle = descriptor_heap_handle< persistent_cpu_dsv_descriptor_heap >;
 
+            using gpu_srv_ring_descriptor_heap              = gpu_ring_descriptor_heap< D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE >;
+            using cpu_srv_ring_descriptor_heap              = gpu_ring_descriptor_heap< D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_NONE >;
+            using gpu_rtv_ring_descriptor_heap              = gpu_ring_descriptor_heap< D3D12_DESCRIPTOR_HEAP_TYPE_RTV, D3D12_DESCRIPTOR_HEAP_FLAG_NONE >;
+            using gpu_dsv_ring_descriptor_heap              = gpu_ring_descriptor_heap< D3D12_DESCRIPTOR_HEAP_TYPE_DSV, D3D12_DESCRIPTOR_HEAP_FLAG_NONE >;
+
+            //index of a long lived descriptor in the bindless table of the shader visible heap
+            struct bindless_descriptor_handle
+            {
+                gpu_srv_ring_descriptor_heap*   m_heap  = nullptr;
+                uint32_t                        m_index = descriptor_index_pool::invalid;
+
+                uint32_t index() const
+                {
+                    return m_index;
+                }
+            };
+
             using gpu_srv_descriptor_heap                   = gpu_descriptor_heap< D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE, fenced_increment_policy >;
             using gpu_rtv_descriptor_heap                   = gpu_descriptor_heap< D3D12_DESCRIPTOR_HEAP_TYPE_RTV, D3D12_DESCRIPTOR_HEAP_FLAG_NONE, fenced_increment_policy>;
             using gpu_dsv_descriptor_heap                   = gpu_descriptor_heap< D3D12_DESCRIPTOR_HEAP_TYPE_DSV, D3D12_DESCRIPTOR_HEAP_FLAG_NONE, fenced_increment_policy>;
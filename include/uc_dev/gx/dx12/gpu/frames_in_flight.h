@@ -0,0 +1,52 @@
+#pragma once
+
+#include <assert.h>
+#include <cstdint>
+
+//the resources a frame retires, like command lists, upload pages, descriptors and deleted meshes, are reused max_frames_in_flight frames later
+//the render loop may keep fewer frames in flight, for less latency, but never more
+#if !defined(UC_MAX_FRAMES_IN_FLIGHT)
+#define UC_MAX_FRAMES_IN_FLIGHT 3
+#endif
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace dx12
+        {
+            const uint32_t max_frames_in_flight = UC_MAX_FRAMES_IN_FLIGHT;
+
+            static_assert(max_frames_in_flight >= 2, "the cpu records a frame while the gpu executes the previous one");
+
+            //index of the per frame resources of the frame after frame_index
+            inline uint32_t next_frame_index(uint32_t frame_index)
+            {
+                return (frame_index + 1) % max_frames_in_flight;
+            }
+
+            //the fences which end the last frames, a frame submits many command lists and each one increments the fence of the queue
+            //so the fence of the frame frames in flight back is kept, it can not be computed from the fence of this frame
+            class frame_fences
+            {
+                public:
+
+                //records the fence which ends a frame, returns the fence the next frame waits for, 0 while fewer frames ended
+                uint64_t end_frame(uint64_t fence, uint32_t frames_in_flight)
+                {
+                    assert(frames_in_flight >= 1 && frames_in_flight <= max_frames_in_flight);
+
+                    m_fences[m_frame % max_frames_in_flight] = fence;
+                    m_frame++;
+
+                    return m_frame >= frames_in_flight ? m_fences[(m_frame - frames_in_flight) % max_frames_in_flight] : 0;
+                }
+
+                private:
+
+                uint64_t m_fences[max_frames_in_flight] = {};
+                uint64_t m_frame = 0;
+            };
+        }
+    }
+}
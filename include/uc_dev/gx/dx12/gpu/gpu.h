@@ -15,6 +15,7 @@
 #include <uc_dev/gx/dx12/gpu/root_signature_blob.h>
 
 #include <uc_dev/gx/dx12/gpu/info.h>
+#include <uc_dev/gx/dx12/gpu/frames_in_flight.h>
 
 #include <uc_dev/gx/dx12/gpu/managed_buffer.h>
 #include <uc_dev/gx/dx12/gpu/managed_texture_2d.h>
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+
 #include <uc_dev/gx/dx12/gpu/virtual_resource.h>
 #include <uc_dev/gx/dx12/gpu/descriptor_heap.h>
 #include <uc_dev/gx/dx12/api/error.h>
@@ -23,6 +26,22 @@ namespace uc
 
                 }
 
+                //copies size bytes at offset, the gpu must be done writing them
+                void read(uint64_t offset, uint64_t size, void* destination)
+                {
+                    D3D12_RANGE range = {};
+
+                    range.Begin = static_cast<SIZE_T>(offset);
+                    range.End   = static_cast<SIZE_T>(offset + size);
+
+                    void* r;
+                    throw_if_failed(m_resource->Map(0, &range, &r));
+                    std::memcpy(destination, static_cast<const uint8_t*>(r) + offset, static_cast<size_t>(size));
+
+                    D3D12_RANGE written = {};
+                    m_resource->Unmap(0, &written);
+                }
+
             private:
 
                 void* map( )
@@ -56,6 +56,11 @@ namespace uc
                 //Depth Buffers
                 gpu_frame_depth_buffer*         create_frame_depth_buffer(uint32_t width, uint32_t height, DXGI_FORMAT format, float clear_value = 1.0f, uint8_t stencil = 0 );
                 gpu_frame_msaa_depth_buffer*    create_frame_msaa_depth_buffer(uint32_t width, uint32_t height, DXGI_FORMAT format, float clear_value = 1.0f, uint8_t stencil = 0);
+
+                //Transients of a frame graph, they share a block of the frame render target heap and alias at their offsets in it
+                uint64_t                        allocate_frame_transients(uint64_t size, uint64_t alignment);
+                D3D12_RESOURCE_ALLOCATION_INFO  msaa_depth_buffer_allocation_info(uint32_t width, uint32_t height, DXGI_FORMAT format);
+                gpu_frame_msaa_depth_buffer*    create_frame_msaa_depth_buffer(uint64_t transients, uint64_t offset, uint32_t width, uint32_t height, DXGI_FORMAT format, float clear_value = 1.0f, uint8_t stencil = 0);
                 
                 gpu_view_depth_buffer*          create_view_depth_buffer(uint32_t width, uint32_t height, DXGI_FORMAT format, float clear_value = 1.0f, uint8_t stencil = 0);
                 gpu_view_msaa_depth_buffer*     create_view_msaa_depth_buffer(uint32_t width, uint32_t height, DXGI_FORMAT format, float clear_value = 1.0f, uint8_t stencil = 0);
@@ -70,10 +75,11 @@ namespace uc
 
                 void reset_view_dependent_resources();
 
-                gpu_srv_descriptor_heap* frame_gpu_srv_heap();
-                cpu_srv_descriptor_heap* frame_cpu_srv_heap();
-                gpu_rtv_descriptor_heap* frame_rtv_heap();
-                gpu_dsv_descriptor_heap* frame_dsv_heap();
+                //the frame heaps are rings, they hold the descriptors of a frame until the frame which reuses its resources
+                gpu_srv_ring_descriptor_heap* frame_gpu_srv_heap();
+                cpu_srv_ring_descriptor_heap* frame_cpu_srv_heap();
+                gpu_rtv_ring_descriptor_heap* frame_rtv_heap();
+                gpu_dsv_ring_descriptor_heap* frame_dsv_heap();
                 gpu_sampler_descriptor_heap* frame_gpu_sampler_heap();
                 cpu_sampler_descriptor_heap* frame_cpu_sampler_heap();
                 
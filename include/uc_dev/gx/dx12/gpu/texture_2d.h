@@ -22,9 +22,10 @@ namespace uc
 
                     }
 
-                    gpu_texture_2d(ID3D12Resource* resource, persistent_cpu_srv_descriptor_heap_handle srv ) : 
+                    gpu_texture_2d(ID3D12Resource* resource, persistent_cpu_srv_descriptor_heap_handle srv, bindless_descriptor_handle bindless = bindless_descriptor_handle() ) : 
                         base(resource)
                         , m_srv(srv)
+                        , m_bindless(bindless)
                     {
 
                     }
@@ -35,6 +36,11 @@ namespace uc
                         {
                             m_srv.m_heap->free(m_srv.m_handle);
                         }
+
+                        if (m_bindless.m_heap)
+                        {
+                            m_bindless.m_heap->free_bindless(m_bindless.m_index);
+                        }
                     }
 
                     descriptor_handle srv() const
@@ -42,8 +48,15 @@ namespace uc
                         return m_srv.m_handle;
                     }
 
+                    //index of the srv in the bindless table of the frame heap
+                    uint32_t bindless_index() const
+                    {
+                        return m_bindless.index();
+                    }
+
                 private:
                     persistent_cpu_srv_descriptor_heap_handle    m_srv;
+                    bindless_descriptor_handle                   m_bindless;
 
             };
 
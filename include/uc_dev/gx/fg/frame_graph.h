@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <uc_dev/gx/cmd/commands.h>
+
+namespace uc {
+    namespace gx {
+        namespace fg {
+
+            using pass_handle       = uint32_t;
+            using resource_handle   = uint32_t;
+
+            const uint32_t invalid_handle = 0xFFFFFFFF;
+
+            enum class pass_queue : uint32_t
+            {
+                graphics,
+                compute         //may run on the async compute queue
+            };
+
+            //size and alignment of the placed resource, from GetResourceAllocationInfo
+            struct transient_desc
+            {
+                uint64_t m_size         = 0;
+                uint64_t m_alignment    = 64 * 1024;
+            };
+
+            enum class barrier_type : uint32_t
+            {
+                transition,
+                aliasing,       //m_before_resource gives the memory to m_resource
+                uav             //between two passes which access the resource as unordered access
+            };
+
+            struct barrier
+            {
+                barrier_type    m_type;
+                resource_handle m_resource;
+                resource_handle m_before_resource;
+                uint32_t        m_before;       //D3D12_RESOURCE_STATES
+                uint32_t        m_after;
+            };
+
+            struct compiled_pass
+            {
+                pass_handle                 m_pass;
+                bool                        m_async = false;    //on the compute queue
+                std::vector<barrier>        m_barriers;         //before the pass
+                std::vector<pass_handle>    m_waits;            //passes on the other queue, which must finish before this one
+            };
+
+            struct compiled_resource
+            {
+                uint32_t    m_first         = invalid_handle;   //index in compiled_frame_graph::m_passes
+                uint32_t    m_last          = invalid_handle;
+                uint32_t    m_initial_state = cmd::resource_state_unknown;  //transients are created in the state of the first use
+                uint64_t    m_offset        = 0;                //in the transient heap
+                bool        m_aliased       = false;            //shares the memory with a resource used before it
+            };
+
+            struct frame_graph_statistics
+            {
+                uint32_t m_culled_passes        = 0;
+                uint32_t m_async_passes         = 0;
+                uint32_t m_barriers             = 0;
+                uint32_t m_aliased_resources    = 0;
+                uint64_t m_heap_size            = 0;    //transient memory with aliasing
+                uint64_t m_heap_alignment       = 0;    //largest alignment of the transients, of the block they are placed in
+                uint64_t m_unaliased_size       = 0;    //without
+            };
+
+            struct compiled_frame_graph
+            {
+                std::vector<compiled_pass>      m_passes;           //in submission order, without the culled ones
+                std::vector<compiled_resource>  m_resources;        //by resource_handle
+                std::vector<barrier>            m_final_barriers;   //to the final states of the imported resources, on the graphics queue after the last pass
+                std::vector<pass_handle>        m_final_waits;      //async passes, which must finish before the final barriers
+                frame_graph_statistics          m_statistics;
+            };
+
+            //the passes of a frame declare what they read and write, the compiler derives the rest
+            //passes nobody reads from are culled, transients with disjoint lifetimes share memory,
+            //the barriers come from the declared states and compute passes which can overlap with graphics go to the async queue
+            //the passes must be added in an order which is valid for submission, each read sees the writes before it
+            //cpu only, the compiled graph refers to the resources by handle, the render world maps them to gpu resources
+            //and places the transients at their offsets in a block of m_heap_size bytes, so the aliased ones share the memory
+            //cheap enough to declare and compile every frame, compile(r) reuses the memory of r
+            class frame_graph
+            {
+                public:
+
+                resource_handle create_transient(const char* name, const transient_desc& d);
+
+                //resources which live outside the frame, the back buffer or the shadow map read by the next passes
+                resource_handle import_resource(const char* name, uint32_t initial_state, uint32_t final_state);
+
+                pass_handle     add_pass(const char* name, pass_queue queue = pass_queue::graphics);
+
+                void            read(pass_handle p, resource_handle r, uint32_t state);
+                void            write(pass_handle p, resource_handle r, uint32_t state);
+
+                //the pass has side effects, it is not culled
+                void            keep(pass_handle p);
+
+                void            compile(compiled_frame_graph& r) const;
+
+                compiled_frame_graph compile() const
+                {
+                    compiled_frame_graph r;
+                    compile(r);
+                    return r;
+                }
+
+                const std::string& pass_name(pass_handle p) const
+                {
+                    return m_passes[p].m_name;
+                }
+
+                const std::string& resource_name(resource_handle r) const
+                {
+                    return m_resources[r].m_name;
+                }
+
+                uint32_t pass_count() const
+                {
+                    return static_cast<uint32_t>(m_passes.size());
+                }
+
+                uint32_t resource_count() const
+                {
+                    return static_cast<uint32_t>(m_resources.size());
+                }
+
+                void reset();
+
+                private:
+
+                struct access
+                {
+                    resource_handle m_resource;
+                    uint32_t        m_state;
+                    bool            m_write;
+                };
+
+                struct pass
+                {
+                    std::string         m_name;
+                    pass_queue          m_queue;
+                    bool                m_keep = false;
+                    std::vector<access> m_accesses;
+                };
+
+                struct resource
+                {
+                    std::string         m_name;
+                    bool                m_imported;
+                    uint32_t            m_initial_state;
+                    uint32_t            m_final_state;
+                    transient_desc      m_desc;
+                };
+
+                std::vector<pass>       m_passes;
+                std::vector<resource>   m_resources;
+
+                void add_access(pass_handle p, resource_handle r, uint32_t state, bool write);
+            };
+        }
+    }
+}
@@ -23,9 +23,12 @@ namespace uc
             struct geometry_allocator_options
             {
                 uint32_t m_index_count;
+                uint32_t m_index_16_count;
                 uint32_t m_skinned_mesh_vertex_count;
                 uint32_t m_static_mesh_vertex_count;
                 uint32_t m_normal_mesh_vertex_count;
+
+                vertex_layout m_skinned_mesh_layout = vertex_layout::default_layout;
             };
 
             //wraps geometry allocations in one interface
@@ -43,7 +46,7 @@ namespace uc
                 skinned_allocation*  allocate_skinned_geometry(size_t vertex_count);
                 void                 free_skinned_geometry(skinned_allocation* free);
 
-                indexed_allocation*  allocate_indices(size_t index_count);
+                indexed_allocation*  allocate_indices(size_t index_count, index_format format = index_format::r32_uint);
                 void                 free_indices(indexed_allocation* f);
 
                 static_allocation*   allocate_static_geometry(size_t vertex_count);
@@ -59,7 +62,7 @@ namespace uc
                 dx12::gpu_buffer*    skinned_mesh_tangent() const;
                 dx12::gpu_buffer*    skinned_mesh_blend_weight() const;
                 dx12::gpu_buffer*    skinned_mesh_blend_index() const;
-                dx12::gpu_buffer*    indices() const;
+                dx12::gpu_buffer*    indices(index_format format = index_format::r32_uint) const;
 
                 vertex_buffer_view   skinned_mesh_position_view() const;
                 vertex_buffer_view   skinned_mesh_uv_view() const;
@@ -68,8 +71,10 @@ namespace uc
                 vertex_buffer_view   skinned_mesh_blend_weight_view() const;
                 vertex_buffer_view   skinned_mesh_blend_index_view() const;
 
+                vertex_layout        skinned_mesh_layout() const;
+
                 // indices
-                index_buffer_view    indices_view() const;
+                index_buffer_view    indices_view(index_format format = index_format::r32_uint) const;
 
                 // static meshes
                 dx12::gpu_buffer*    parametrized_mesh_position() const;
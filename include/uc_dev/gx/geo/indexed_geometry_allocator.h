@@ -22,19 +22,22 @@ namespace uc
 
                 using indexed_allocation = index_buffer_allocator::allocation;
 
-                indexed_geometry_allocator(dx12::gpu_resource_create_context* c, uint32_t index_count);
+                //index_16_count sizes a second pool for meshes, which fit in 16 bit indices, 0 disables it
+                indexed_geometry_allocator(dx12::gpu_resource_create_context* c, uint32_t index_count, uint32_t index_16_count = 0);
 
-                indexed_allocation*  allocate(size_t index_count);
+                indexed_allocation*  allocate(size_t index_count, index_format format = index_format::r32_uint);
                 void                 free(indexed_allocation* f);
-                dx12::gpu_buffer*    indices() const;
-                index_buffer_view    indices_view() const;
+                dx12::gpu_buffer*    indices(index_format format = index_format::r32_uint) const;
+                index_buffer_view    indices_view(index_format format = index_format::r32_uint) const;
 
                 void                 sync();
 
                 private:
                 dx12::gpu_resource_create_context* m_ctx;
                 dx12::managed_gpu_buffer           m_index_memory;
+                dx12::managed_gpu_buffer           m_index_memory_16;
                 index_buffer_allocator             m_indices;
+                index_buffer_allocator             m_indices_16;
             };
 
             namespace details
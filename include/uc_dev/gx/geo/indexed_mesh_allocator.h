@@ -18,6 +18,17 @@ namespace uc
             using index_buffer_view     = D3D12_INDEX_BUFFER_VIEW;
             using gpu_virtual_address   = D3D12_GPU_VIRTUAL_ADDRESS;
 
+            enum class index_format : uint32_t
+            {
+                r32_uint = 0,
+                r16_uint = 1
+            };
+
+            inline uint32_t index_stride(index_format f)
+            {
+                return f == index_format::r16_uint ? compact_geometry_index::stride::value : default_geometry_index::stride::value;
+            }
+
             class index_buffer_allocator final : public util::noncopyable
             {
                 class index_buffer_allocator_impl;
@@ -28,24 +39,27 @@ namespace uc
                 {
                     private:
 
-                    uint32_t m_index_count;
-                    uint32_t m_index_offset;
-                    void*    m_opaque_handle;
+                    uint32_t     m_index_count;
+                    uint32_t     m_index_offset;
+                    void*        m_opaque_handle;
+                    index_format m_format;
 
                     public:
 
-                    allocation(uint32_t index_count, uint32_t index_offset, void* opaque_handle);
+                    allocation(uint32_t index_count, uint32_t index_offset, void* opaque_handle, index_format format = index_format::r32_uint);
                     
-                    void*    handle() const;
-                    uint32_t index_count() const;
-                    uint32_t index_offset() const;
+                    void*        handle() const;
+                    uint32_t     index_count() const;
+                    uint32_t     index_offset() const;
+                    index_format format() const;
 
                     uint32_t byte_size() const;
                     uint32_t byte_offset() const;
                 };
 
-                index_buffer_allocator( const gpu_virtual_address address, uint64_t size);
+                index_buffer_allocator( const gpu_virtual_address address, uint64_t size, index_format format = index_format::r32_uint);
 
+                index_format        format() const;
                 uint32_t            stride() const;
                 uint32_t            size() const;
 
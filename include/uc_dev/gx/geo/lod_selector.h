@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace uc
+{
+    namespace lip
+    {
+        struct lod_chain;
+    }
+
+    namespace gx
+    {
+        namespace geo
+        {
+            //bounding sphere diameter over the viewport height, fov_y is the vertical field of view in radians
+            //the eye inside the sphere gives the largest size
+            float lod_screen_size(float radius, float distance, float fov_y);
+
+            //0 is the model itself, i > 0 is m_levels[i - 1]
+            //bias > 1 switches to coarser levels earlier, bias < 1 later
+            uint32_t select_lod(const lip::lod_chain& lods, float screen_size, float bias = 1.0f);
+        }
+    }
+}
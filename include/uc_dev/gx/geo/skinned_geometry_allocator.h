@@ -22,7 +22,7 @@ namespace uc
 
                 using skinned_allocation = skinned_meshes_allocator::allocation;
 
-                skinned_geometry_allocator(dx12::gpu_resource_create_context* c, uint32_t vertex_count);
+                skinned_geometry_allocator(dx12::gpu_resource_create_context* c, uint32_t vertex_count, vertex_layout layout = vertex_layout::default_layout);
 
                 skinned_allocation*  allocate(size_t vertex_count);
                 void                 free(skinned_allocation* free);
@@ -42,6 +42,8 @@ namespace uc
                 vertex_buffer_view   skinned_mesh_blend_weight_view() const;
                 vertex_buffer_view   skinned_mesh_blend_index_view() const;
 
+                vertex_layout        layout() const;
+
                 void                 sync();
 
                 private:
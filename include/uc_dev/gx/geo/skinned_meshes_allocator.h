@@ -73,11 +73,14 @@ namespace uc
                     uint32_t            m_tangent_size;
                     uint32_t            m_blend_weights_size;
                     uint32_t            m_blend_indices_size;
+
+                    vertex_layout       m_layout = vertex_layout::default_layout;
                 };
 
                 skinned_meshes_allocator( const allocator_addresses& options );
 
                 uint32_t            stride(component) const;
+                vertex_layout       layout() const;
                 uint32_t            size(component) const;
 
                 gpu_virtual_address address(component) const;
@@ -48,6 +48,15 @@ namespace uc
                 };
             };
 
+            //meshes with less than 65536 vertices
+            struct compact_geometry_index
+            {
+                enum stride
+                {
+                    value = static_cast<uint32_t>(2)
+                };
+            };
+
             struct default_geometry_blend_weight
             {
                 enum stride
@@ -63,6 +72,66 @@ namespace uc
                     value = static_cast<uint32_t>(1 * sizeof(uint32_t))
                 };
             };
+
+            //quantized streams, see lip::packed_skinned_model
+            enum class vertex_layout : uint32_t
+            {
+                default_layout = 0,
+                packed
+            };
+
+            //unorm16 x 4, relative to the mesh bounds, w is padding
+            struct packed_geometry_position
+            {
+                enum stride
+                {
+                    value = static_cast<uint32_t>(4 * sizeof(uint16_t))
+                };
+            };
+
+            //half x 2
+            struct packed_geometry_uv
+            {
+                enum stride
+                {
+                    value = static_cast<uint32_t>(2 * sizeof(uint16_t))
+                };
+            };
+
+            //octahedral snorm16 x 2
+            struct packed_geometry_normal
+            {
+                enum stride
+                {
+                    value = static_cast<uint32_t>(2 * sizeof(uint16_t))
+                };
+            };
+
+            //octahedral snorm16 x 2
+            struct packed_geometry_tangent
+            {
+                enum stride
+                {
+                    value = static_cast<uint32_t>(2 * sizeof(uint16_t))
+                };
+            };
+
+            //unorm8 x 4
+            struct packed_geometry_blend_weight
+            {
+                enum stride
+                {
+                    value = static_cast<uint32_t>(4 * sizeof(uint8_t))
+                };
+            };
+
+            struct packed_geometry_blend_index
+            {
+                enum stride
+                {
+                    value = static_cast<uint32_t>(1 * sizeof(uint32_t))
+                };
+            };
         }
     }
 }
@@ -76,8 +76,12 @@ namespace uc
         {
             point3 m_center;
             float  m_radius;
+
+            LIP_DECLARE_RTTI()
         };
 
+        LIP_DECLARE_TYPE_ID(uc::lip::joint_bounding_volume)
+
         struct skeleton
         {
             reloc_array < joint_transform >    m_joint_inverse_bind_pose;   //bind pose is when the pose of the skeleton when you bind the vertices
@@ -112,6 +116,7 @@ namespace uc
                 ,   m_joint_linkage_indices(c)
                 ,   m_joint_local_transforms2(c)
                 ,   m_joint_linkage2(c)
+                ,   m_joint_bounding_volumes(c)
             {
 
             }
@@ -155,6 +160,7 @@ namespace uc
         LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < joint_linkage >)
         LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < joint_name >)
         LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < matrix4x4 >)
+        LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < joint_bounding_volume >)
 
         struct joint_animation
         {
@@ -27,20 +27,49 @@ namespace uc
         LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < ubyte4 >)
         LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < uint4 >)
 
+        LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < ushort4 >)
+        LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < short2 >)
+        LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < half2 >)
+
         LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < float4a >)
         LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < float8a >)
 
         LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < float8 >)
 
+        //matches dxgi_format
+        enum class index_format : uint16_t
+        {
+            r32_uint = 42,
+            r16_uint = 57
+        };
+
         struct indices
         {
-            lip::reloc_array < index > m_data;
+            lip::reloc_array < index >    m_data;       //32 bit indices
+            lip::reloc_array < uint16_t > m_data_16;    //16 bit indices, used when all indices fit
+            uint16_t                      m_format;
+
+            index_format format() const
+            {
+                return static_cast<index_format>(m_format);
+            }
+
+            bool is_16_bit() const
+            {
+                return format() == index_format::r16_uint;
+            }
+
+            uint32_t stride() const
+            {
+                return static_cast<uint32_t>(is_16_bit() ? sizeof(uint16_t) : sizeof(index));
+            }
 
             size_t size() const
             {
-                return m_data.size();
+                return is_16_bit() ? m_data_16.size() : m_data.size();
             }
 
+            //32 bit stream only, use operator[] or bytes() for both widths
             index* data()
             {
                 return m_data.data();
@@ -51,53 +80,67 @@ namespace uc
                 return m_data.data();
             }
 
-            explicit indices(const lip::load_context& c) : m_data(c)
+            const void* bytes() const
+            {
+                return is_16_bit() ? static_cast<const void*>(m_data_16.data()) : static_cast<const void*>(m_data.data());
+            }
+
+            index operator[](size_t i) const
+            {
+                return is_16_bit() ? static_cast<index>(m_data_16[i]) : m_data[i];
+            }
+
+            explicit indices(const lip::load_context& c) : m_data(c), m_data_16(c)
             {
 
             }
 
 #if defined(UC_TOOLS)
-            indices()
+            indices() : m_format(static_cast<uint16_t>(index_format::r32_uint))
             {
 
             }
 
-            indices(const lip::reloc_array<index>& data) : m_data(data)
+            indices(const lip::reloc_array<index>& data) : m_data(data), m_format(static_cast<uint16_t>(index_format::r32_uint))
             {
 
             }
 
-            indices(lip::reloc_array<index>&& data) : m_data( std::move(data) )
+            indices(lip::reloc_array<index>&& data) : m_data( std::move(data) ), m_format(static_cast<uint16_t>(index_format::r32_uint))
             {
 
             }
 
-            indices(const indices& o) : m_data(o.m_data)
+            indices(const indices& o) : m_data(o.m_data), m_data_16(o.m_data_16), m_format(o.m_format)
             {}
 
-            indices(indices&& o) : m_data(std::move(o.m_data))
+            indices(indices&& o) : m_data(std::move(o.m_data)), m_data_16(std::move(o.m_data_16)), m_format(o.m_format)
             {}
 
             indices& operator=(const indices& o)
             {
-                m_data = o.m_data;
+                m_data      = o.m_data;
+                m_data_16   = o.m_data_16;
+                m_format    = o.m_format;
                 return *this;
             }
 
             indices& operator=(indices&& o)
             {
-                m_data = std::move(o.m_data);
+                m_data      = std::move(o.m_data);
+                m_data_16   = std::move(o.m_data_16);
+                m_format    = o.m_format;
                 return *this;
             }
 
             bool operator==(const indices & o) const
             {
-                return m_data == o.m_data;
+                return m_format == o.m_format && m_data == o.m_data && m_data_16 == o.m_data_16;
             }
 
             bool operator!=(const indices& o) const 
             {
-                return m_data != o.m_data;
+                return !(*this == o);
             }
 #endif
             LIP_DECLARE_RTTI()
@@ -107,7 +150,7 @@ namespace uc
 
         inline size_t size(const indices& p)
         {
-            return p.size() * sizeof(index);
+            return p.size() * p.stride();
         }
 
         struct positions
@@ -792,16 +835,124 @@ namespace uc
 
         LIP_DECLARE_TYPE_ID(uc::lip::primitive_range)
 
+        //small cluster of triangles of a primitive range, for cluster culling and mesh shaders
+        //m_vertex_offset points into meshlets::m_vertices, m_triangle_offset into meshlets::m_triangles
+        struct meshlet
+        {
+            uint32_t m_vertex_offset;
+            uint32_t m_triangle_offset;
+            uint32_t m_vertex_count;
+            uint32_t m_triangle_count;
+
+            LIP_DECLARE_RTTI()
+        };
+
+        LIP_DECLARE_TYPE_ID(uc::lip::meshlet)
+
+        //bounding sphere and normal cone of a meshlet in model space, the bind pose for the skinned models
+        //the meshlet faces away when dot(center - eye, axis) >= cutoff * length(center - eye) + radius
+        struct meshlet_bounds
+        {
+            float3 m_center;
+            float  m_radius;
+            float3 m_cone_axis;
+            float  m_cone_cutoff;   //1.0, when the normals spread too much for a cone
+
+            LIP_DECLARE_RTTI()
+        };
+
+        LIP_DECLARE_TYPE_ID(uc::lip::meshlet_bounds)
+        LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < meshlet >)
+        LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < meshlet_bounds >)
+
+        struct meshlets
+        {
+            lip::reloc_array < meshlet >            m_meshlets;
+            lip::reloc_array < meshlet_bounds >     m_bounds;
+            lip::reloc_array < primitive_range >    m_ranges;       //[m_begin, m_end) meshlets of every primitive range
+            lip::reloc_array < uint32_t >           m_vertices;     //model vertices of the meshlets
+            lip::reloc_array < uint8_t >            m_triangles;    //3 meshlet local vertices per triangle
+
+            size_t size() const
+            {
+                return m_meshlets.size();
+            }
+
+            explicit meshlets(const lip::load_context& c) : m_meshlets(c)
+                , m_bounds(c)
+                , m_ranges(c)
+                , m_vertices(c)
+                , m_triangles(c)
+            {
+
+            }
+
+#if defined(UC_TOOLS)
+            meshlets() {}
+#endif
+            LIP_DECLARE_RTTI()
+        };
+
+        LIP_DECLARE_TYPE_ID(uc::lip::meshlets)
+
+        //simplified copy of the model, it draws with the vertices of the model
+        struct lod_level
+        {
+            uint32_t m_range_offset;        //first primitive range of the level in lod_chain::m_ranges, there is one per model primitive range
+            uint32_t m_triangle_count;
+            float    m_error;               //largest geometric error against the model, in model units
+            float    m_screen_size;         //the level is used, when the bounding sphere diameter over the viewport height is below this
+
+            LIP_DECLARE_RTTI()
+        };
+
+        LIP_DECLARE_TYPE_ID(uc::lip::lod_level)
+        LIP_DECLARE_TYPE_ID(uc::lip::reloc_array < lod_level >)
+
+        //coarser levels of detail, the model itself is level 0 and m_levels[i] is level i + 1
+        //the levels have their own index buffer, so the draws of the full model do not change
+        struct lod_chain
+        {
+            indices                                 m_indices;
+            lip::reloc_array < lod_level >          m_levels;
+            lip::reloc_array < primitive_range >    m_ranges;       //[m_begin, m_end) indices in m_indices
+            float3                                  m_center;       //bounding sphere, which the screen sizes are measured with
+            float                                   m_radius;
+
+            size_t size() const
+            {
+                return m_levels.size();
+            }
+
+            explicit lod_chain(const lip::load_context& c) : m_indices(c)
+                , m_levels(c)
+                , m_ranges(c)
+            {
+
+            }
+
+#if defined(UC_TOOLS)
+            lod_chain() : m_center{ 0.0f, 0.0f, 0.0f }, m_radius(0.0f) {}
+#endif
+            LIP_DECLARE_RTTI()
+        };
+
+        LIP_DECLARE_TYPE_ID(uc::lip::lod_chain)
+
         struct multi_textured_model : public parametrized_model
         {
             using base = parametrized_model;
 
             lip::reloc_array < texture2d_mip_chain >        m_textures;
             lip::reloc_array < primitive_range >            m_primitive_ranges;
+            meshlets                                        m_meshlets;
+            lod_chain                                       m_lods;
             
             explicit multi_textured_model(const lip::load_context& c) : base( c)
                 , m_textures(c)
                 ,  m_primitive_ranges(c)
+                , m_meshlets(c)
+                , m_lods(c)
             {
 
             }
@@ -823,10 +974,14 @@ namespace uc
 
             lip::reloc_array < texture2d_mip_chain >    m_textures;
             lip::reloc_array < primitive_range >        m_primitive_ranges;
+            meshlets                                    m_meshlets;
+            lod_chain                                   m_lods;
 
             explicit normal_multi_textured_model(const lip::load_context& c) : base(c)
                 , m_textures(c)
                 , m_primitive_ranges(c)
+                , m_meshlets(c)
+                , m_lods(c)
             {
 
             }
@@ -846,10 +1001,14 @@ namespace uc
 
             lip::reloc_array < texture2d_mip_chain > m_textures;
             lip::reloc_array < primitive_range >     m_primitive_ranges;
+            meshlets                                 m_meshlets;
+            lod_chain                                m_lods;
 
             explicit derivatives_multi_textured_model(const lip::load_context& c) : base(c)
                 , m_textures(c)
                 , m_primitive_ranges(c)
+                , m_meshlets(c)
+                , m_lods(c)
             {
 
             }
@@ -931,5 +1090,49 @@ namespace uc
 
         LIP_DECLARE_TYPE_ID(uc::lip::derivatives_skinned_model)
 
+        //quantized derivatives_skinned_model, 28 bytes per vertex instead of 64
+        //position = m_position_min + unorm16(m_positions) * m_position_extent
+        //normals and tangents are octahedral snorm16, uv are half floats, blend weights are unorm8 and sum to 255
+        struct packed_skinned_model
+        {
+            indices                                  m_indices;
+            lip::reloc_array < ushort4 >             m_positions;
+            lip::reloc_array < half2 >               m_uv;
+            lip::reloc_array < short2 >              m_normals;
+            lip::reloc_array < short2 >              m_tangents;
+            lip::reloc_array < ubyte4 >              m_blend_weights;
+            lip::reloc_array < ubyte4 >              m_blend_indices;
+
+            lip::reloc_array < texture2d_mip_chain > m_textures;
+            lip::reloc_array < primitive_range >     m_primitive_ranges;
+            meshlets                                 m_meshlets;
+            lod_chain                                m_lods;
+
+            float3                                   m_position_min;
+            float3                                   m_position_extent;
+
+            explicit packed_skinned_model(const lip::load_context& c) : m_indices(c)
+                , m_positions(c)
+                , m_uv(c)
+                , m_normals(c)
+                , m_tangents(c)
+                , m_blend_weights(c)
+                , m_blend_indices(c)
+                , m_textures(c)
+                , m_primitive_ranges(c)
+                , m_meshlets(c)
+                , m_lods(c)
+            {
+
+            }
+
+#if defined(UC_TOOLS)            
+            packed_skinned_model() : m_position_min{ 0.0f, 0.0f, 0.0f }, m_position_extent{ 0.0f, 0.0f, 0.0f } {}
+#endif
+            LIP_DECLARE_RTTI()
+        };
+
+        LIP_DECLARE_TYPE_ID(uc::lip::packed_skinned_model)
+
     }
 }
@@ -73,6 +73,38 @@ namespace uc
 
         LIP_DECLARE_TYPE_ID(uc::lip::uint4)
 
+        //unorm16 positions, relative to the mesh bounds
+        struct ushort4
+        {
+            uint16_t m_x;
+            uint16_t m_y;
+            uint16_t m_z;
+            uint16_t m_w;
+            LIP_DECLARE_RTTI()
+        };
+
+        LIP_DECLARE_TYPE_ID(uc::lip::ushort4)
+
+        //snorm16, octahedral normals and tangents
+        struct short2
+        {
+            int16_t m_x;
+            int16_t m_y;
+            LIP_DECLARE_RTTI()
+        };
+
+        LIP_DECLARE_TYPE_ID(uc::lip::short2)
+
+        //half floats, stored as bits
+        struct half2
+        {
+            uint16_t m_x;
+            uint16_t m_y;
+            LIP_DECLARE_RTTI()
+        };
+
+        LIP_DECLARE_TYPE_ID(uc::lip::half2)
+
         struct alignas(32) float8a
         {
             float m_x;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <uc_dev/math/math.h>
+#include <uc_dev/math/geometry_convex_clipping.h>
+#include <uc_dev/gx/pinhole_camera.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace shadows
+        {
+            enum class split_scheme : uint8_t
+            {
+                uniform     = 0,
+                logarithmic = 1,
+                practical   = 2     //blend of the two, see m_split_lambda
+            };
+
+            struct cascade_settings
+            {
+                uint32_t        m_cascade_count = 4;
+                split_scheme    m_split_scheme  = split_scheme::practical;
+                float           m_split_lambda  = 0.75f;    //0 uniform, 1 logarithmic
+                uint32_t        m_resolution    = 2048;     //shadow map texels per cascade side
+                bool            m_stabilize     = true;     //keeps the cascade size constant when the camera moves, see build_cascades
+                float           m_hull_tolerance = 0.0f;    //the caster volume of a slice is reused while the slice moves less, 0 reuses it for a still camera only
+            };
+
+            struct shadow_cascade
+            {
+                orthographic_camera m_camera;
+                math::float4x4      m_view;
+                math::float4x4      m_projection;
+
+                float               m_split_near;
+                float               m_split_far;
+                float               m_texel_size;           //world units per shadow map texel
+                bool                m_empty;                //the cascade does not see the scene
+            };
+
+            struct shadow_cascades
+            {
+                static const uint32_t max_cascades = 8;
+
+                std::array<shadow_cascade, max_cascades>    m_cascades;
+                uint32_t                                    m_count = 0;
+
+                //the receivers and caster volumes of the last build, per cascade
+                std::array<math::convex_clipping::convex_hull_cache, max_cascades> m_hulls;
+            };
+
+            //count + 1 distances along the camera forward, the first is the near plane, the last the far plane
+            void make_split_distances(float near_plane, float far_plane, const cascade_settings& s, float* splits);
+
+            //the part of the camera frustum between two distances
+            math::frustum_points make_frustum_points(const pinhole_camera* camera, float near_plane, float far_plane);
+
+            //light_direction points towards the light. every cascade is fit to its camera frustum slice clipped by the scene,
+            //extruded towards the light up to the scene bounds to catch the casters, and snapped to the shadow map texels
+            //stabilized cascades cover the tighter of the sphere around the slice and the scene box in light space, neither moves with the camera
+            void build_cascades(const pinhole_camera* camera, const math::aabb& scene, math::afloat4 light_direction, const cascade_settings& s, shadow_cascades& r);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <uc_dev/math/math.h>
+
+namespace uc
+{
+    namespace math
+    {
+        //array versions of the single value functions, they pick sse, avx2 or avx512 kernels at run time
+        //the output may not alias the inputs
+
+        //r[i] = a[i] * b[i]
+        void mul(const float4x4* a, const float4x4* b, float4x4* r, size_t count);
+
+        //r[i] = a[i] * b, concatenates a set of transforms with a common one
+        void mul(const float4x4* a, afloat4x4 b, float4x4* r, size_t count);
+
+        //expects normalized quaternions
+        void quaternion_2_matrix(const float4* q, float4x4* r, size_t count);
+
+        //points, assumes w = 1.0f
+        void transform3(const float4* v, afloat4x4 m, float4* r, size_t count);
+
+        //directions, the translation is ignored. pass the inverse transpose for normals under non uniform scale
+        void transform3_vector(const float4* v, afloat4x4 m, float4* r, size_t count);
+
+        //r[i] = slerp(a[i], b[i], t[i])
+        void slerp(const float4* a, const float4* b, const float* t, float4* r, size_t count);
+
+        namespace details
+        {
+            void mul_sse(const float4x4* a, const float4x4* b, float4x4* r, size_t count);
+            void mul_avx2(const float4x4* a, const float4x4* b, float4x4* r, size_t count);
+            void mul_avx512(const float4x4* a, const float4x4* b, float4x4* r, size_t count);
+
+            //b is one matrix for all elements
+            void mul_broadcast_sse(const float4x4* a, const float4x4* b, float4x4* r, size_t count);
+            void mul_broadcast_avx2(const float4x4* a, const float4x4* b, float4x4* r, size_t count);
+            void mul_broadcast_avx512(const float4x4* a, const float4x4* b, float4x4* r, size_t count);
+
+            void quaternion_2_matrix_sse(const float4* q, float4x4* r, size_t count);
+            void quaternion_2_matrix_avx2(const float4* q, float4x4* r, size_t count);
+            void quaternion_2_matrix_avx512(const float4* q, float4x4* r, size_t count);
+
+            void transform3_sse(const float4* v, const float4x4* m, float4* r, size_t count, bool vector);
+            void transform3_avx2(const float4* v, const float4x4* m, float4* r, size_t count, bool vector);
+            void transform3_avx512(const float4* v, const float4x4* m, float4* r, size_t count, bool vector);
+
+            void slerp_sse(const float4* a, const float4* b, const float* t, float4* r, size_t count);
+            void slerp_avx2(const float4* a, const float4* b, const float* t, float4* r, size_t count);
+            void slerp_avx512(const float4* a, const float4* b, const float* t, float4* r, size_t count);
+        }
+    }
+}
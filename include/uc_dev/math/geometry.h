@@ -287,7 +287,7 @@ namespace uc
             float4 v    = sub(c, a);
             float4 n    = normalize3(cross3(u, v));    //normal points inside
             auto     d  = dot3(n, a);                  //note: if the plane equation is ax+by+cz+d, then this is negative, else positive
-            return { select(n, negate(d), math::set(0,0,0,1)) };
+            return { select(n, negate(d), mask_w()) };
         }
 
         inline std::array< plane, 6 > make_face_planes(const frustum_points& f)
@@ -526,6 +526,7 @@ namespace uc
             }
         }
 
+        //the planes point outside of the frustum here, the opposite of make_frustum_planes, see frustum_cull_inward for those
         inline void frustum_cull(const frustum_planes* __restrict f, const aabb4* __restrict b, uint32_t box_count, __m128i* __restrict results)
         {
             __m128i exclude;
@@ -750,6 +751,19 @@ namespace uc
                 results++;
             }
         }
+
+        //frustum_planes pointing inside, as make_frustum_planes builds them and frustum_cull(frustum_planes, aabb) tests them
+        inline void frustum_cull_inward(const frustum_planes* __restrict f, const aabb4* __restrict b, uint32_t box_count, __m128i* __restrict results)
+        {
+            frustum_planes outward;
+
+            for (uint32_t i = 0; i < frustum_planes::plane_count::value; ++i)
+            {
+                outward.m_planes[i].m_value = negate(f->m_planes[i].m_value);
+            }
+
+            frustum_cull(&outward, b, box_count, results);
+        }
     }
 }
 
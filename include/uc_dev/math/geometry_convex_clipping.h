@@ -3,6 +3,7 @@
 #include <limits>
 #include <tuple>
 #include <optional>
+#include <array>
 #include <vector>
 
 #include <uc_dev/math/geometry.h>
@@ -32,6 +33,70 @@ namespace uc
             convex_polyhedron convex_hull_with_direction(const convex_polyhedron& body, float4 vector);
             convex_polyhedron convex_hull_with_point(const convex_polyhedron& body, float4 point);
             convex_polyhedron convex_hull_with_direction(const convex_polyhedron& body, float4 vector, const aabb& clip_body);
+
+            //fixed capacity polyhedron for the per frame shadow volume fitting, does not touch the heap
+            //face i is m_indices[m_faces[i], m_faces[i + 1])
+            struct fixed_convex_polyhedron
+            {
+                static const uint32_t max_points    = 64;
+                static const uint32_t max_faces     = 64;
+                static const uint32_t max_indices   = 512;
+
+                std::array<float4, max_points>          m_points;
+                std::array<uint16_t, max_faces + 1>     m_faces;
+                std::array<uint8_t, max_indices>        m_indices;
+
+                uint32_t                                m_point_count = 0;
+                uint32_t                                m_face_count  = 0;
+            };
+
+            //return false if the result is empty or does not fit
+            bool clip(const frustum_points& f, const aabb& b, fixed_convex_polyhedron& r);
+            bool clip(const fixed_convex_polyhedron& f, const aabb& b, fixed_convex_polyhedron& r);
+
+            bool convex_hull_with_direction(const fixed_convex_polyhedron& body, float4 vector, fixed_convex_polyhedron& r);
+            bool convex_hull_with_direction(const fixed_convex_polyhedron& body, float4 vector, const aabb& clip_body, fixed_convex_polyhedron& r);
+
+            convex_polyhedron make_convex_polyhedron(const fixed_convex_polyhedron& p);
+
+            //keeps the last shadow caster volume and reuses it while the camera frustum, the scene bounds and the light move less than the tolerance
+            //the reused volume is the one of the previous inputs, pad the tolerance into the consumer if it has to be conservative
+            class convex_hull_cache
+            {
+                public:
+
+                explicit convex_hull_cache(float tolerance = 0.01f) : m_tolerance(tolerance) {}
+
+                //frustum clipped by the scene bounds and extruded along the vector up to the scene bounds, nullptr if the frustum misses the scene
+                const fixed_convex_polyhedron* convex_hull_with_direction(const frustum_points& f, const aabb& scene, float4 vector);
+
+                //the frustum clipped by the scene bounds, valid while the last call returned a volume
+                const fixed_convex_polyhedron& clipped() const
+                {
+                    return m_clipped;
+                }
+
+                void set_tolerance(float tolerance)
+                {
+                    m_tolerance = tolerance;
+                }
+
+                void invalidate()
+                {
+                    m_valid = false;
+                }
+
+                private:
+
+                frustum_points              m_frustum;
+                aabb                        m_scene;
+                float4                      m_vector;
+                fixed_convex_polyhedron     m_clipped;
+                fixed_convex_polyhedron     m_hull;
+                float                       m_tolerance;
+                bool                        m_valid = false;
+                bool                        m_empty = false;
+            };
         }
     }
 }
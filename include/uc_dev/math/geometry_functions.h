@@ -63,6 +63,46 @@ namespace uc
             r.m_extents = mul(sub(max_point, min_point), 0.5f);
             return r;
         }
+
+        //extracts the frustum planes from a view projection matrix (row vectors, d3d clip space 0 <= z <= w), normals point inside
+        inline frustum_planes make_frustum_planes(afloat4x4 view_projection)
+        {
+            float4x4 m = transpose(view_projection);
+
+            frustum_planes r;
+
+            r.m_planes[frustum_planes::left_p].m_value  = normalize_plane(add(m.r[3], m.r[0]));
+            r.m_planes[frustum_planes::right_p].m_value = normalize_plane(sub(m.r[3], m.r[0]));
+            r.m_planes[frustum_planes::up_p].m_value    = normalize_plane(sub(m.r[3], m.r[1]));
+            r.m_planes[frustum_planes::down_p].m_value  = normalize_plane(add(m.r[3], m.r[1]));
+
+            //with reversed depth these two swap, which does not matter for culling
+            r.m_planes[frustum_planes::near_p].m_value  = normalize_plane(m.r[2]);
+            r.m_planes[frustum_planes::far_p].m_value   = normalize_plane(sub(m.r[3], m.r[2]));
+
+            return r;
+        }
+
+        inline aabb make_aabb(afloat4 min_point, afloat4 max_point)
+        {
+            aabb r;
+            r.m_center   = select(mul(add(min_point, max_point), 0.5f), one(), mask_w());
+            r.m_diagonal = select(mul(sub(max_point, min_point), 0.5f), zero(), mask_w());
+            return r;
+        }
+
+        //transforms the box with an affine matrix, the result encloses the transformed box
+        inline aabb transform(const aabb& b, afloat4x4 m)
+        {
+            float4 e = mul(splat_x(b.m_diagonal), abs(m.r[0]));
+            e = mad(splat_y(b.m_diagonal), abs(m.r[1]), e);
+            e = mad(splat_z(b.m_diagonal), abs(m.r[2]), e);
+
+            aabb r;
+            r.m_center   = transform3(b.m_center, m);
+            r.m_diagonal = select(e, zero(), mask_w());
+            return r;
+        }
     }
 }
 
@@ -609,7 +609,8 @@ namespace uc
                 auto d      = math::dot4(a, b);
                 auto b1     = math::negate(b);
                 auto mask   = math::compare_lt( d, math::zero() );
-                return std::make_tuple(math::select(b, b1, mask), math::get_x(d));
+                //the cosine of the flipped quaternion is |d|
+                return std::make_tuple(math::select(b, b1, mask), std::abs(math::get_x(d)));
             }
             
         }
@@ -581,7 +581,7 @@ namespace uc
         inline float4 UC_MATH_CALL lerp(afloat4 v1, afloat4 v2, afloat4 l)
         {
             float4 a = sub(v2, v1);
-            return mad(l, a, v2);
+            return mad(l, a, v1);
         }
 
         inline float4 UC_MATH_CALL lerp(afloat4 v1, afloat4 v2, float l)
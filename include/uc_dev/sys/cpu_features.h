@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <intrin.h>
+
+namespace uc
+{
+    namespace sys
+    {
+        namespace details
+        {
+            struct cpu_features
+            {
+                bool m_avx2     = false;
+                bool m_avx512   = false;
+
+                cpu_features()
+                {
+                    int32_t r[4] = {};
+
+                    __cpuid(r, 0);
+                    const int32_t max_leaf = r[0];
+
+                    if (max_leaf < 7)
+                    {
+                        return;
+                    }
+
+                    __cpuid(r, 1);
+
+                    const bool os_xsave = (r[2] & (1 << 27)) != 0;
+                    const bool avx      = (r[2] & (1 << 28)) != 0;
+                    const bool fma      = (r[2] & (1 << 12)) != 0;
+
+                    if (!os_xsave || !avx)
+                    {
+                        return;
+                    }
+
+                    //the os must save the ymm state (bits 1,2) on context switches
+                    const uint64_t xcr0 = _xgetbv(0);
+                    const bool     ymm  = (xcr0 & 0x6) == 0x6;
+
+                    __cpuidex(r, 7, 0);
+
+                    m_avx2      = ymm && fma && (r[1] & (1 << 5)) != 0;
+
+                    //avx512f, the os must also save the opmask and zmm state (bits 5,6,7)
+                    const bool     zmm  = (xcr0 & 0xE6) == 0xE6;
+
+                    m_avx512    = m_avx2 && zmm && (r[1] & (1 << 16)) != 0;
+                }
+            };
+
+            inline const cpu_features& features()
+            {
+                static const cpu_features f;
+                return f;
+            }
+        }
+
+        //avx2 + fma, checked once per process
+        inline bool is_avx2_supported()
+        {
+            return details::features().m_avx2;
+        }
+
+        //avx512f on top of avx2, checked once per process
+        inline bool is_avx512_supported()
+        {
+            return details::features().m_avx512;
+        }
+    }
+}
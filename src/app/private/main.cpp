@@ -120,6 +120,7 @@ public:
             //split the event processing and the rendering
             m_renderer_thread = std::make_unique<std::thread>([this]()
             {
+                //present returns at once, the next update runs while the frame presents and waits for the gpu
                 while (!m_windowClosed)
                 {
                     m_renderer->pre_render();
@@ -136,6 +136,14 @@ namespace uc
                 m_swap_chains[i]->move_to_next_frame();
         }
 
+        void device_resources::set_frames_in_flight(uint32_t frames)
+        {
+            for (auto i = 0U; i < m_swap_chain_count; ++i)
+            {
+                m_swap_chains[i]->set_frames_in_flight(frames);
+            }
+        }
+
         void device_resources::present()
         {
             // The first argument instructs DXGI to block until VSync, putting the application
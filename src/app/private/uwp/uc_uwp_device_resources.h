@@ -47,6 +47,9 @@ namespace uc
             void sync();
             void present();
 
+            //frames the cpu may submit ahead of the gpu on every swap chain
+            void set_frames_in_flight(uint32_t frames);
+
             swap_chain::resources* swap_chain(swap_chains s) const
             {
                 return m_swap_chains[static_cast<uint32_t>(s)].get();
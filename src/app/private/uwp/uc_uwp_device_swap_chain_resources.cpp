@@ -330,10 +330,16 @@ namespace uc
                 m_direct_queue->wait_for_idle_gpu();
             }
 
+            void resources::set_frames_in_flight(uint32_t frames)
+            {
+                m_frames_in_flight = std::min(std::max(frames, 1U), gx::dx12::max_frames_in_flight);
+            }
+
             void resources::move_to_next_frame()
             {
                 auto fence = m_direct_queue->increment_fence();
-                m_direct_queue->wait_for_fence( fence - 2 );
+                //the next frame may start, when the gpu is done with the frame frames in flight back
+                m_direct_queue->wait_for_fence( m_frame_fences.end_frame( fence, m_frames_in_flight ) );
                 // Advance the frame index.
                 m_current_frame = (m_current_frame + 1) % 3;
             }
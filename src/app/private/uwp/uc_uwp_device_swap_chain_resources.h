@@ -154,6 +154,15 @@ namespace uc
                     throw_if_failed(m_swap_chain->SetSourceSize(width, height));
                 }
 
+                //frames the cpu may submit ahead of the gpu, from 1 to gx::dx12::max_frames_in_flight
+                //less frames in flight shorten the latency from the input to the screen, more keep the gpu busy
+                void set_frames_in_flight(uint32_t frames);
+
+                uint32_t frames_in_flight() const
+                {
+                    return m_frames_in_flight;
+                }
+
                 void wait_for_gpu();
                 void move_to_next_frame();
                 void present();
@@ -181,6 +190,8 @@ namespace uc
                 Microsoft::WRL::ComPtr<IDXGISwapChain3>                         m_swap_chain;
 
                 uint64_t                                                        m_current_frame = 0;
+                uint32_t                                                        m_frames_in_flight = gx::dx12::max_frames_in_flight;
+                gx::dx12::frame_fences                                          m_frame_fences;
 
                 //submission control
                 std::unique_ptr<gx::dx12::gpu_command_queue>                    m_direct_queue;
@@ -15,6 +15,17 @@ namespace uc
     {
         namespace gxu
         {
+            namespace
+            {
+                //uploads 16 bit indices into the 16 bit pool, 32 bit ones into the default one
+                gx::geo::managed_indexed_geometry upload_indices(gx::geo::geometry_allocator* allocator, gx::dx12::gpu_upload_queue* upload_queue, const lip::indices& indices)
+                {
+                    auto span_indices = gsl::make_span(reinterpret_cast<const gsl::byte*>(indices.bytes()), static_cast<std::ptrdiff_t>(lip::size(indices)));
+                    auto format       = indices.is_16_bit() ? gx::geo::index_format::r16_uint : gx::geo::index_format::r32_uint;
+                    return gx::geo::create_indexed_geometry(allocator, upload_queue, span_indices, format);
+                }
+            }
+
             /*
             std::unique_ptr<skinned_multi_material_render_object> render_object_factory< skinned_multi_material_render_object >::make_render_object(const wchar_t* file_name, device_resources* resources)
             {
@@ -62,13 +73,12 @@ namespace uc
                 auto span_uv            = gsl::make_span(mesh->m_uv.data(), mesh->m_uv.size());
                 auto span_normals       = gsl::make_span(mesh->m_normals.data(), mesh->m_normals.size());
                 auto span_tangents      = gsl::make_span(mesh->m_tangents.data(), mesh->m_tangents.size());
-                auto span_indices       = gsl::make_span(mesh->m_indices.data(), mesh->m_indices.size());
                 auto span_positions     = gsl::make_span(mesh->m_positions.data(), mesh->m_positions.size());
                 auto span_blend_weights = gsl::make_span(mesh->m_blend_weights.data(), mesh->m_blend_weights.size());
                 auto span_blend_indices = gsl::make_span(mesh->m_blend_indices.data(), mesh->m_blend_indices.size());
 
                 r->m_geometry           = gx::geo::create_skinned_mesh(allocator, resources->upload_queue(), gsl::as_bytes(span_positions), gsl::as_bytes(span_uv), gsl::as_bytes(span_normals), gsl::as_bytes(span_tangents), gsl::as_bytes(span_blend_weights), gsl::as_bytes(span_blend_indices));
-                r->m_indices            = gx::geo::create_indexed_geometry(allocator, resources->upload_queue(), gsl::as_bytes(span_indices) );
+                r->m_indices            = upload_indices(allocator, resources->upload_queue(), mesh->m_indices);
 
                 r->m_opaque_textures.resize(mesh->m_textures.size());
 
@@ -105,11 +115,10 @@ namespace uc
                 auto mesh = lip::create_from_compressed_lip_file<lip::parametrized_model>(file_name);
 
                 auto span_uv = gsl::make_span(mesh->m_uv.data(), mesh->m_uv.size());
-                auto span_indices = gsl::make_span(mesh->m_indices.data(), mesh->m_indices.size());
                 auto span_positions = gsl::make_span(mesh->m_positions.data(), mesh->m_positions.size());
 
                 r->m_geometry = gx::geo::create_static_mesh(allocator, resources->upload_queue(), gsl::as_bytes(span_positions), gsl::as_bytes(span_uv));
-                r->m_indices = gx::geo::create_indexed_geometry(allocator, resources->upload_queue(), gsl::as_bytes(span_indices));
+                r->m_indices = upload_indices(allocator, resources->upload_queue(), mesh->m_indices);
 
                 //todo: to processing on the compute queue
                 resources->compute_queue()->insert_wait_on(resources->upload_queue()->flush());
@@ -124,11 +133,10 @@ namespace uc
                 auto mesh = lip::create_from_compressed_lip_file<lip::multi_textured_model>(file_name);
 
                 auto span_uv = gsl::make_span(mesh->m_uv.data(), mesh->m_uv.size());
-                auto span_indices = gsl::make_span(mesh->m_indices.data(), mesh->m_indices.size());
                 auto span_positions = gsl::make_span(mesh->m_positions.data(), mesh->m_positions.size());
 
                 r->m_geometry = gx::geo::create_static_mesh(allocator, resources->upload_queue(), gsl::as_bytes(span_positions), gsl::as_bytes(span_uv));
-                r->m_indices = gx::geo::create_indexed_geometry(allocator, resources->upload_queue(), gsl::as_bytes(span_indices));
+                r->m_indices = upload_indices(allocator, resources->upload_queue(), mesh->m_indices);
 
                 r->m_opaque_textures.resize(mesh->m_textures.size());
 
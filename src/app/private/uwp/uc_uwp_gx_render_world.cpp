@@ -63,7 +63,7 @@ namespace uc
                 return do_render_shadows(ctx);
             }
 
-            void render_world::begin_render( render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics )
+            void render_world::begin_render( render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands )
             {
                 auto resources = ctx->m_resources;
 
@@ -76,88 +76,87 @@ namespace uc
                 //may be not here
                 resources->swap_chain(device_resources::swap_chains::background)->set_source_size(width, height);
 
-                graphics->transition_resource(back_buffer, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
-                //graphics->transition_resource(ctx->m_view_depth_buffer, D3D12_RESOURCE_STATE_DEPTH_READ, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+                //the back buffer is presented after the pass
+                m_main_frame_graph.reset();
+                auto b      = m_main_frame_graph.import_resource("back buffer", D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_PRESENT);
+                m_main_pass = m_main_frame_graph.add_pass("main");
+                m_main_frame_graph.write(m_main_pass, b, D3D12_RESOURCE_STATE_RENDER_TARGET);
+                m_main_frame_graph.compile(m_main_graph);
 
-                graphics->set_render_target(back_buffer, ctx->m_view_depth_buffer);
-                graphics->clear(back_buffer);
+                //by the handles of the frame graph
+                const gx::dx12::gpu_virtual_resource* main_resources[] = { back_buffer };
+
+                if (auto pass = details::find_pass(m_main_graph, m_main_pass))
+                {
+                    details::transition_resources(commands, pass->m_barriers, main_resources);
+                }
+
+                commands->set_render_target(back_buffer, ctx->m_view_depth_buffer);
+                commands->clear(back_buffer);
             }
 
-            void render_world::end_render(render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics)
+            void render_world::end_render(render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands)
             {
                 auto resources      = ctx->m_resources;
                 auto back_buffer    = resources->back_buffer(device_resources::swap_chains::background);
 
-                //Per pass
-                //graphics->transition_resource(ctx->m_view_depth_buffer, D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_STATE_DEPTH_READ);
-                graphics->transition_resource(back_buffer, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
+                const gx::dx12::gpu_virtual_resource* main_resources[] = { back_buffer };
+                details::transition_resources(commands, m_main_graph.m_final_barriers, main_resources);
             }
 
-            void render_world::begin_render_depth(render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics)
+            void render_world::begin_render_depth(render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands)
             {
                 if (ctx->m_view_depth_buffer)
                 {
-                    graphics->set_render_target(ctx->m_view_depth_buffer);
-                    graphics->clear_depth(ctx->m_view_depth_buffer, 1.0f);
+                    commands->set_render_target(ctx->m_view_depth_buffer);
+                    commands->clear_depth(ctx->m_view_depth_buffer, 1.0f);
                 }
             }
 
-            void render_world::end_render_depth( render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics )
+            void render_world::end_render_depth( render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands )
             {
                 ctx;
-                graphics;
+                commands;
             }
 
-            void render_world::begin_render_shadows(shadow_render_context* ctx, gx::dx12::gpu_graphics_compute_command_context* graphics)
+            void render_world::begin_render_shadows(shadow_render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands)
             {
-                ctx;
-                graphics;
+                //the shadow buffers are created every frame, the depth in depth write and the map in the state of the descriptor
+                if (ctx->m_shadow_depth_buffer)
+                {
+                    commands->track_resource(ctx->m_shadow_depth_buffer, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+                }
+
+                if (ctx->m_shadow_map)
+                {
+                    commands->track_resource(ctx->m_shadow_map, shadow_map_descriptor().m_shadow_map.m_initial_state);
+                }
             }
 
-            void render_world::end_render_shadows(shadow_render_context* ctx, gx::dx12::gpu_graphics_compute_command_context* graphics)
+            void render_world::end_render_shadows(shadow_render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands)
             {
                 ctx;
-                graphics;
+                commands;
             }
 
-            void render_world::set_view_port( const render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics)
+            void render_world::set_view_port( const render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands)
             {
                 auto width = ctx->m_back_buffer_scaled_size.m_width;
                 auto height = ctx->m_back_buffer_scaled_size.m_height;
 
                 //Per pass  -> frequency 0
-                graphics->set_view_port(viewport(width, height));
-                graphics->set_scissor_rectangle(scissor(width, height));
+                commands->set_view_port(viewport(width, height));
+                commands->set_scissor_rectangle(scissor(width, height));
             }
 
-            void render_world::set_view_port(const shadow_render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics)
+            void render_world::set_view_port(const shadow_render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands)
             {
                 auto width  = ctx->m_shadow_buffer_size.m_width;
                 auto height = ctx->m_shadow_buffer_size.m_height;
 
                 //Per pass  -> frequency 0
-                graphics->set_view_port(viewport(width, height));
-                graphics->set_scissor_rectangle(scissor(width, height));
-            }
-
-            void render_world::set_view_port(const render_context* ctx, gx::dx12::gpu_graphics_compute_command_context* graphics)
-            {
-                auto width = ctx->m_back_buffer_scaled_size.m_width;
-                auto height = ctx->m_back_buffer_scaled_size.m_height;
-
-                //Per pass  -> frequency 0
-                graphics->set_view_port(viewport(width, height));
-                graphics->set_scissor_rectangle(scissor(width, height));
-            }
-
-            void render_world::set_view_port(const shadow_render_context* ctx, gx::dx12::gpu_graphics_compute_command_context* graphics)
-            {
-                auto width = ctx->m_shadow_buffer_size.m_width;
-                auto height = ctx->m_shadow_buffer_size.m_height;
-
-                //Per pass  -> frequency 0
-                graphics->set_view_port(viewport(width, height));
-                graphics->set_scissor_rectangle(scissor(width, height));
+                commands->set_view_port(viewport(width, height));
+                commands->set_scissor_rectangle(scissor(width, height));
             }
 
 
@@ -166,9 +165,14 @@ namespace uc
                 auto resources = ctx->m_resources;
                 //now start new ones
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
-                begin_render_depth(ctx, graphics.get());
-                end_render_depth(ctx, graphics.get());
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+
+                //record the pass, then replay it on the context
+                m_depth_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_depth_commands);
+                begin_render_depth(ctx, &recorder);
+                end_render_depth(ctx, &recorder);
+
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_depth_commands);
             }
 
             std::unique_ptr< submitable >render_world::do_render_shadows(shadow_render_context* ctx)
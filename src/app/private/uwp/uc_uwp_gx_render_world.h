@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
 #include <uc_dev/mem/align.h>
 
 #include <uc_dev/gx/dx12/dx12.h>
+#include <uc_dev/gx/dx12/cmd/command_stream_backend.h>
+#include <uc_dev/gx/fg/frame_graph.h>
 #include <uc_dev/util/noncopyable.h>
 #include <uc_dev/gx/pinhole_camera.h>
 
@@ -62,6 +65,32 @@ namespace uc
             D3D12_VIEWPORT viewport(const gx::dx12::gpu_pixel_buffer* b);
             D3D12_RECT scissor(const gx::dx12::gpu_pixel_buffer* b);
 
+            namespace details
+            {
+                //the compiled pass, nullptr if the pass was culled
+                inline const gx::fg::compiled_pass* find_pass(const gx::fg::compiled_frame_graph& g, gx::fg::pass_handle p)
+                {
+                    auto it = std::find_if(g.m_passes.begin(), g.m_passes.end(), [p](const gx::fg::compiled_pass& c) { return c.m_pass == p; });
+                    return it != g.m_passes.end() ? &(*it) : nullptr;
+                }
+
+                //resources are indexed by the handles of the frame graph
+                inline void transition_resources(gx::dx12::gpu_command_stream_recorder* c, const std::vector<gx::fg::barrier>& barriers, const gx::dx12::gpu_virtual_resource* const resources[])
+                {
+                    for (auto&& b : barriers)
+                    {
+                        if (b.m_type == gx::fg::barrier_type::transition)
+                        {
+                            c->transition_resource(resources[b.m_resource], static_cast<D3D12_RESOURCE_STATES>(b.m_before), static_cast<D3D12_RESOURCE_STATES>(b.m_after));
+                        }
+                        else if (b.m_type == gx::fg::barrier_type::aliasing)
+                        {
+                            c->aliasing_barrier(b.m_before_resource != gx::fg::invalid_handle ? resources[b.m_before_resource] : nullptr, resources[b.m_resource]);
+                        }
+                    }
+                }
+            }
+
             struct shadow_buffers_descriptor
             {
                 enum shadow_flags
@@ -136,19 +165,31 @@ namespace uc
 
                 mem::aligned_unique_ptr<gx::pinhole_camera>	m_camera = mem::make_aligned_unique_ptr<gx::pinhole_camera>();
 
-                static void begin_render( render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics );
-                static void end_render(render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics);
+                //the passes record into the streams, which are replayed on their command lists when the passes are submitted, one stream per pass, the passes are recorded in parallel
+                gx::cmd::command_stream m_main_commands;
+                gx::cmd::command_stream m_depth_commands;
+                gx::cmd::command_stream m_shadows_commands;
+
+                //the back buffer goes to render target and back to present by the barriers of the main frame graph
+                void begin_render(render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands);
+                void end_render(render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands);
 
-                static void begin_render_depth(render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics);
-                static void end_render_depth(render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics);
+                static void begin_render_depth(render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands);
+                static void end_render_depth(render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands);
 
-                static void begin_render_shadows(shadow_render_context* ctx, gx::dx12::gpu_graphics_compute_command_context* graphics);
-                static void end_render_shadows(shadow_render_context* ctx, gx::dx12::gpu_graphics_compute_command_context* graphics);
+                //tracks the shadow buffers of the frame in the states of shadow_map_descriptor()
+                void begin_render_shadows(shadow_render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands);
+                static void end_render_shadows(shadow_render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands);
+
+                static void set_view_port(const render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands);
+                static void set_view_port(const shadow_render_context* ctx, gx::dx12::gpu_command_stream_recorder* commands);
+
+                private:
 
-                static void set_view_port(const render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics);
-                static void set_view_port(const shadow_render_context* ctx, gx::dx12::gpu_graphics_command_context* graphics);
-                static void set_view_port(const render_context* ctx, gx::dx12::gpu_graphics_compute_command_context* graphics);
-                static void set_view_port(const shadow_render_context* ctx, gx::dx12::gpu_graphics_compute_command_context* graphics);
+                //the main pass, declared and compiled every frame in begin_render
+                gx::fg::frame_graph             m_main_frame_graph;
+                gx::fg::compiled_frame_graph    m_main_graph;
+                gx::fg::pass_handle             m_main_pass = gx::fg::invalid_handle;
             };
         }
     }
@@ -4,6 +4,7 @@
 
 #include <gsl/gsl>
 #include <ppl.h>
+#include <algorithm>
 #include <array>
 
 #include <uc_dev/gx/dx12/gpu/texture_2d.h>
@@ -77,6 +78,49 @@ namespace uc
 
                     return t1;// math::mul(t1, t0);
                 }
+
+                //the robots stand in a row along x
+                inline float robot_offset(size_t i)
+                {
+                    return 1.5f * static_cast<float>(i);
+                }
+
+                //the sort keys of the main pass
+                const uint32_t main_pass        = 0;
+                const uint32_t skinned_pso      = 0;
+                const uint32_t robot_material   = 0;
+
+                //the msaa depth buffer of the shadow pass, which the resolve pass reads
+                const uint32_t      shadow_buffer_size      = 2048;
+                const DXGI_FORMAT   shadow_buffer_format    = DXGI_FORMAT_D32_FLOAT;
+
+                struct shadows_frame_graph
+                {
+                    gx::fg::resource_handle m_depth;
+                    gx::fg::resource_handle m_map;
+                    gx::fg::pass_handle     m_shadows;
+                    gx::fg::pass_handle     m_resolve;
+                };
+
+                //the shadow passes of a frame, the depth buffer lives only between them, the shadow map is read by the main pass
+                inline shadows_frame_graph declare_shadows_frame_graph(gx::fg::frame_graph& g, const gx::fg::transient_desc& depth)
+                {
+                    shadows_frame_graph r;
+
+                    g.reset();
+
+                    r.m_depth       = g.create_transient("shadow depth", depth);
+                    r.m_map         = g.import_resource("shadow map", D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+                    r.m_shadows     = g.add_pass("shadows");
+                    g.write(r.m_shadows, r.m_depth, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+
+                    r.m_resolve     = g.add_pass("shadows resolve", gx::fg::pass_queue::compute);
+                    g.read(r.m_resolve, r.m_depth, D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+                    g.write(r.m_resolve, r.m_map, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+                    return r;
+                }
             }
 
             render_world_1::render_world_1(initialize_context* c) : base(c)
@@ -215,6 +259,11 @@ namespace uc
                 }
 
                 m_draw_constants.resize(m_animations.size());
+
+                auto depth = c->m_resources->resource_create_context()->msaa_depth_buffer_allocation_info(details::shadow_buffer_size, details::shadow_buffer_size, details::shadow_buffer_format);
+
+                m_shadow_depth_desc.m_size      = depth.SizeInBytes;
+                m_shadow_depth_desc.m_alignment = depth.Alignment;
             }
 
             render_world_1::~render_world_1()
@@ -243,7 +292,7 @@ namespace uc
 
                     draw.m_world = math::identity_matrix(); // uc::math::transpose(m_robot_transform);
                     {
-                        math::float4x4 t = math::translation_x(1.5f * i);
+                        math::float4x4 t = math::translation_x(details::robot_offset(i));
 
                         auto joints = gx::anm::local_to_world_joints2(skeleton, m_skeleton_instance[i]->local_transforms(), t);
 
@@ -294,113 +343,168 @@ namespace uc
             std::unique_ptr< submitable > render_world_1::do_render(render_context* ctx)
             {
                 //now start new ones
-                auto resources = ctx->m_resources;
-                auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
-
-                auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"do_render");
+                auto resources  = ctx->m_resources;
 
-                begin_render(ctx, graphics.get());
+                //the robots are recorded in parallel, the lists are submitted in the order of the jobs
+                const size_t robots_per_job = 16;
+                auto jobs       = gx::dx12::parallel_job_count(m_animations.size(), robots_per_job);
+                auto parallel   = std::make_unique< gx::dx12::gpu_parallel_command_context<gx::dx12::gpu_graphics_command_context> >(resources->direct_command_context_allocator(device_resources::swap_chains::background), jobs);
 
+                //the robots are drawn in the order of their keys, front to back, so the depth test rejects the hidden pixels early
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    auto view       = uc::gx::view_matrix(camera());
+                    auto z_near     = camera()->get_near();
+                    auto z_far      = camera()->get_far();
+
+                    m_render_queue.begin(jobs);
+
+                    concurrency::parallel_for(0U, jobs, [this, jobs, &view, z_near, z_far](uint32_t job)
+                    {
+                        auto&& bucket   = m_render_queue[job];
+                        auto range      = gx::dx12::parallel_job_items(m_animations.size(), jobs, job);
+
+                        for (auto i = range.m_begin; i < range.m_end; ++i)
+                        {
+                            auto position   = math::mul(math::point3(details::robot_offset(i), 0.0f, 0.0f), view);
+                            auto depth      = (math::get_z(position) - z_near) / (z_far - z_near);
+
+                            bucket.add(gx::cmd::sort_key::opaque(details::main_pass, details::skinned_pso, details::robot_material, depth), static_cast<uint32_t>(i));
+                        }
+                    });
+
+                    m_render_queue.sort();
                 }
 
-                //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                graphics->set_pso(m_skinned);
-                graphics->set_descriptor_heaps();
+                //every job records into its own stream, the streams are replayed on the contexts of the jobs when the pass is submitted, the first one starts the pass
+                m_main_job_commands.resize(parallel->size());
 
+                for (auto&& s : m_main_job_commands)
                 {
-                    graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame);
+                    s.reset();
                 }
 
-                //shadows and light
                 {
-                    struct render_object_frame_constants
-                    {
+                    gx::dx12::gpu_command_stream_recorder recorder(&m_main_job_commands.front());
+                    begin_render(ctx, &recorder);
+                }
 
-                        math::float4x4 m_shadow_view;
-                        math::float4x4 m_shadow_perspective;
-                        math::float4   m_directional_light;
-                    };
+                concurrency::parallel_for(0U, parallel->size(), [this, ctx, jobs](uint32_t job)
+                {
+                    gx::dx12::gpu_command_stream_recorder recorder(&m_main_job_commands[job]);
+                    auto commands = &recorder;
 
-                    render_object_frame_constants r;
+                    auto profile_event = uc::gx::dx12::make_profile_event(commands, L"do_render");
 
-                    r.m_shadow_view = m_constants_frame_shadows.m_view;
-                    r.m_shadow_perspective = m_constants_frame_shadows.m_perspective;
-                    r.m_directional_light = m_light_direction;
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 1, r);
-                }
+                    //every list sets the state of the pass
+                    if (job > 0)
+                    {
+                        auto&& back_buffer = ctx->m_resources->back_buffer(device_resources::swap_chains::background);
+                        commands->set_render_target(back_buffer, ctx->m_view_depth_buffer);
+                    }
 
-                graphics->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, ctx->m_shadow_map->srv(), 0);
-                graphics->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, m_blue_noise->srv(), 1);
+                    {
+                        set_view_port(ctx, commands);
+                        commands->set_descriptor_heaps();
+                    }
 
+                    //Per many draw calls  -> frequency 1
+                    commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                    commands->set_pso(m_skinned);
 
-                //robot
-                {
-                    //todo: move this into a big buffer for the whole scene
-                    graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                    {
+                        commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame);
+                    }
 
-                    //geometry
-                    graphics->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
-                    graphics->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_uv_view());
-                    graphics->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_normal_view());
-                    graphics->set_vertex_buffer(3, ctx->m_geometry->skinned_mesh_tangent_view());
-                    graphics->set_vertex_buffer(4, ctx->m_geometry->skinned_mesh_blend_weight_view());
-                    graphics->set_vertex_buffer(5, ctx->m_geometry->skinned_mesh_blend_index_view());
-                    graphics->set_index_buffer(ctx->m_geometry->indices_view());
+                    //shadows and light
+                    {
+                        struct render_object_frame_constants
+                        {
 
+                            math::float4x4 m_shadow_view;
+                            math::float4x4 m_shadow_perspective;
+                            math::float4   m_directional_light;
+                        };
 
-                    for ( auto i = 0U; i < m_animations.size(); ++i)
-                    {
-                        //draw
-                        auto&& draw = m_draw_constants[i];
+                        render_object_frame_constants r;
 
-                        graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
+                        r.m_shadow_view = m_constants_frame_shadows.m_view;
+                        r.m_shadow_perspective = m_constants_frame_shadows.m_perspective;
+                        r.m_directional_light = m_light_direction;
+                        commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 1, r);
+                    }
 
-                        size_t start = 0;
-                        size_t size = m_robot->m_primitive_ranges.size();
+                    commands->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, ctx->m_shadow_map->srv(), 0);
+                    commands->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, m_blue_noise->srv(), 1);
 
-                        for (auto j = start; j < start + size; ++j)
+                    //robot
+                    {
+                        //geometry
+                        commands->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
+                        commands->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_uv_view());
+                        commands->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_normal_view());
+                        commands->set_vertex_buffer(3, ctx->m_geometry->skinned_mesh_tangent_view());
+                        commands->set_vertex_buffer(4, ctx->m_geometry->skinned_mesh_blend_weight_view());
+                        commands->set_vertex_buffer(5, ctx->m_geometry->skinned_mesh_blend_index_view());
+                        commands->set_index_buffer(ctx->m_geometry->indices_view(m_robot->m_indices->format()));
+
+                        //the jobs replay consecutive parts of the queue, so the submitted lists keep its order
+                        auto&& items    = m_render_queue.items();
+                        auto range      = gx::dx12::parallel_job_items(items.size(), jobs, job);
+
+                        for ( auto i = range.m_begin; i < range.m_end; ++i)
                         {
-                            {
-                                auto& t = m_robot->m_opaque_textures[j];
-                                //material
-                                graphics->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, t->srv(), 2);
-                            }
+                            //draw
+                            auto&& draw = m_draw_constants[items[i].m_draw];
 
-                            {
-                                auto& r = m_robot->m_primitive_ranges[j];
-                                auto  base_index_offset = m_robot->m_indices->index_offset();
-                                auto  base_vertex_offset = m_robot->m_geometry->draw_offset();
+                            commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
 
-                                //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                                graphics->draw_indexed(r.size(), r.m_begin + base_index_offset, base_vertex_offset);
+                            size_t start = 0;
+                            size_t size = m_robot->m_primitive_ranges.size();
+
+                            for (auto j = start; j < start + size; ++j)
+                            {
+                                {
+                                    auto& t = m_robot->m_opaque_textures[j];
+                                    //material
+                                    commands->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, t->srv(), 2);
+                                }
+
+                                {
+                                    auto& r = m_robot->m_primitive_ranges[j];
+                                    auto  base_index_offset = m_robot->m_indices->index_offset();
+                                    auto  base_vertex_offset = m_robot->m_geometry->draw_offset();
+
+                                    //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
+                                    commands->draw_indexed(r.size(), r.m_begin + base_index_offset, base_vertex_offset);
+                                }
                             }
                         }
                     }
-                }
 
-                //plane
-                {
-                    auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Plane");
+                    //the last job finishes the pass
+                    if (job + 1 == m_main_job_commands.size())
+                    {
+                        //plane
+                        {
+                            auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Plane");
 
-                    math::float4x4 m = math::identity_matrix();
+                            math::float4x4 m = math::identity_matrix();
 
-                    graphics->set_pso(m_plane);
+                            commands->set_pso(m_plane);
 
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
+                            commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
 
-                    gx::dx12::graphics_reset_vertex_buffer(graphics, 0);
-                    gx::dx12::graphics_reset_index_buffer(graphics);
+                            commands->set_vertex_buffer(0, {});
+                            commands->set_index_buffer({});
 
-                    graphics->draw(6);
-                }
+                            commands->draw(6);
+                        }
 
+                        end_render(ctx, commands);
+                    }
+                });
 
-                end_render(ctx, graphics.get());
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                return std::make_unique<parallel_graphics_stream_submitable>(std::move(parallel), &m_main_job_commands);
             }
 
             std::unique_ptr< submitable >   render_world_1::do_render_depth(render_context* ctx)
@@ -409,65 +513,75 @@ namespace uc
                 auto resources = ctx->m_resources;
                 //now start new ones
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
-                graphics->pix_begin_event(L"do_render_depth");
-                begin_render_depth(ctx, graphics.get());
 
-                
+                //record the pass, then replay it on the context
+                m_depth_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_depth_commands);
+                auto commands = &recorder;
+
+                commands->pix_begin_event(L"do_render_depth");
+
+                begin_render_depth(ctx, commands);
+
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    auto width  = ctx->m_back_buffer_scaled_size.m_width;
+                    auto height = ctx->m_back_buffer_scaled_size.m_height;
+
+                    commands->set_view_port(viewport(width, height));
+                    commands->set_scissor_rectangle(scissor(width, height));
+                    commands->set_descriptor_heaps();
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
                 //robots
                 {
-                    auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"Robots");
+                    auto profile_event = uc::gx::dx12::make_profile_event(commands, L"Robots");
 
-                    graphics->set_pso(m_skinned_depth);
+                    commands->set_pso(m_skinned_depth);
                     {
-                        graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame);
+                        commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame);
                     }
 
-                    graphics->set_pso(m_skinned_depth);
+                    commands->set_pso(m_skinned_depth);
 
                     //geometry
-                    graphics->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
-                    graphics->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
-                    graphics->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
-                    graphics->set_index_buffer(ctx->m_geometry->indices_view());
+                    commands->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
+                    commands->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
+                    commands->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
+                    commands->set_index_buffer(ctx->m_geometry->indices_view(m_robot->m_indices->format()));
 
                     for (auto i = 0U; i < m_animations.size(); ++i)
                     {
-                        auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Robot");
+                        auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Robot");
                         //draw
                         auto&& draw = m_draw_constants[i];
 
-                        graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
+                        commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
                         //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                        graphics->draw_indexed(m_robot->m_indices->index_count(), m_robot->m_indices->index_offset(), m_robot->m_geometry->draw_offset());
+                        commands->draw_indexed(m_robot->m_indices->index_count(), m_robot->m_indices->index_offset(), m_robot->m_geometry->draw_offset());
                     }
                 }
 
                 //plane
                 {
-                    auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Plane");
+                    auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Plane");
 
                     math::float4x4 m = math::identity_matrix();
 
-                    graphics->set_pso(m_plane_depth);
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
+                    commands->set_pso(m_plane_depth);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
 
-                    gx::dx12::graphics_reset_vertex_buffer(graphics, 0);
-                    gx::dx12::graphics_reset_index_buffer(graphics);
-                    graphics->draw(6);
+                    commands->set_vertex_buffer(0, {});
+                    commands->set_index_buffer({});
+                    commands->draw(6);
                 }
 
-                end_render_depth(ctx, graphics.get());
+                end_render_depth(ctx, commands);
 
-                graphics->pix_end_event();
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                commands->pix_end_event();
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_depth_commands);
             }
 
             std::unique_ptr< submitable > render_world_1::do_render_shadows(shadow_render_context* ctx)
@@ -476,95 +590,119 @@ namespace uc
                 auto resources = ctx->m_resources;
                 auto graphics = create_graphics_compute_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
 
-                {
-                    auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"Shadows Pass");
+                //the passes are declared and compiled every frame, the transients get their memory from the frame heap at the compiled offsets
+                auto handles = details::declare_shadows_frame_graph(m_shadows_frame_graph, m_shadow_depth_desc);
+                m_shadows_frame_graph.compile(m_shadows_graph);
 
-                    graphics->clear_depth(ctx->m_shadow_depth_buffer, 0.0f);
-                    graphics->set_render_target(ctx->m_shadow_depth_buffer);
-                    set_view_port(ctx, graphics.get());
-                    
+                auto rc         = resources->resource_create_context();
+                auto transients = rc->allocate_frame_transients(m_shadows_graph.m_statistics.m_heap_size, m_shadows_graph.m_statistics.m_heap_alignment);
 
-                    //Per many draw calls  -> frequency 1
-                    graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                    graphics->set_pso(m_skinned_shadows);
-                    graphics->set_descriptor_heaps();
+                //the frames in flight still use the depth buffers of the previous frames
+                auto&& shadow_depth_buffer = m_shadow_depth_buffers[m_shadow_frame_index];
+                m_shadow_frame_index = gx::dx12::next_frame_index(m_shadow_frame_index);
+
+                shadow_depth_buffer.reset(rc->create_frame_msaa_depth_buffer(transients, m_shadows_graph.m_resources[handles.m_depth].m_offset, details::shadow_buffer_size, details::shadow_buffer_size, details::shadow_buffer_format, 0.0f));
 
-                    graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame_shadows);
+                //by the handles of the frame graph
+                const gx::dx12::gpu_virtual_resource* shadow_resources[] = { shadow_depth_buffer.get(), ctx->m_shadow_map };
 
-                    //robots
+                //both passes record into one stream, it is replayed on the context when the passes are submitted
+                m_shadows_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_shadows_commands);
+                auto commands = &recorder;
+
+                if (auto pass = details::find_pass(m_shadows_graph, handles.m_shadows))
+                {
                     {
-                        auto profile_event1 = uc::gx::dx12::make_profile_event(graphics.get(), L"Robots");
+                        auto profile_event = uc::gx::dx12::make_profile_event(commands, L"Shadows Pass");
 
-                        //geometry
-                        graphics->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
-                        graphics->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
-                        graphics->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
-                        graphics->set_index_buffer(ctx->m_geometry->indices_view());
+                        auto width  = details::shadow_buffer_size;
+                        auto height = details::shadow_buffer_size;
 
-                        for (auto i = 0U; i < m_animations.size(); ++i)
+                        details::transition_resources(commands, pass->m_barriers, shadow_resources);
+
+                        commands->clear_depth(shadow_depth_buffer.get(), 0.0f);
+                        commands->set_render_target(shadow_depth_buffer.get());
+                        commands->set_view_port(viewport(width, height));
+                        commands->set_scissor_rectangle(scissor(width, height));
+
+                        //Per many draw calls  -> frequency 1
+                        commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                        commands->set_pso(m_skinned_shadows);
+                        commands->set_descriptor_heaps();
+
+                        commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame_shadows);
+
+                        //robots
                         {
-                            auto profile_event2 = uc::gx::dx12::make_profile_event(graphics.get(), L"Robot");
-                            //draw
-                            auto&& draw = m_draw_constants[i];
+                            auto profile_event1 = uc::gx::dx12::make_profile_event(commands, L"Robots");
+
+                            //geometry
+                            commands->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
+                            commands->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
+                            commands->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
+                            commands->set_index_buffer(ctx->m_geometry->indices_view(m_robot->m_indices->format()));
 
-                            graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
-                            //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                            graphics->draw_indexed(m_robot->m_indices->index_count(), m_robot->m_indices->index_offset(), m_robot->m_geometry->draw_offset());
+                            for (auto i = 0U; i < m_animations.size(); ++i)
+                            {
+                                auto profile_event2 = uc::gx::dx12::make_profile_event(commands, L"Robot");
+                                //draw
+                                auto&& draw = m_draw_constants[i];
+
+                                commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
+                                //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
+                                commands->draw_indexed(m_robot->m_indices->index_count(), m_robot->m_indices->index_offset(), m_robot->m_geometry->draw_offset());
+                            }
                         }
-                    }
 
-                    //plane
-                    {
-                        auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Plane");
+                        //plane
+                        {
+                            auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Plane");
 
-                        math::float4x4 m = math::identity_matrix();
+                            math::float4x4 m = math::identity_matrix();
 
-                        graphics->set_pso(m_plane_shadows);
+                            commands->set_pso(m_plane_shadows);
 
-                        graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
+                            commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
 
-                        gx::dx12::graphics_reset_vertex_buffer(graphics, 0);
-                        gx::dx12::graphics_reset_index_buffer(graphics);
-                        graphics->draw(6);
-                    }
+                            commands->set_vertex_buffer(0, {});
+                            commands->set_index_buffer({});
+                            commands->draw(6);
+                        }
 
-                    end_render_shadows(ctx, graphics.get());
+                        end_render_shadows(ctx, commands);
+                    }
                 }
                 
                 //Resolve
+                if (auto pass = details::find_pass(m_shadows_graph, handles.m_resolve))
                 {
-
-                    graphics->transition_resource(ctx->m_shadow_depth_buffer, D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+                    details::transition_resources(commands, pass->m_barriers, shadow_resources);
 
                     {
-                        auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"Shadows Resolve Pass");
+                        auto profile_event = uc::gx::dx12::make_profile_event(commands, L"Shadows Resolve Pass");
 
-                        graphics->set_pso(m_shadows_resolve);
+                        commands->set_pso(m_shadows_resolve);
 
-                        graphics->set_compute_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, ctx->m_shadow_depth_buffer->srv_depth());
-                        graphics->set_compute_dynamic_descriptor(gx::dx12::default_root_singature::slots::uav_1, ctx->m_shadow_map->uav());
+                        commands->set_compute_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, shadow_depth_buffer->srv_depth());
+                        commands->set_compute_dynamic_descriptor(gx::dx12::default_root_singature::slots::uav_1, ctx->m_shadow_map->uav());
 
-                        graphics->dispatch(2048 / 32, 2048 / 8, 1);
+                        commands->dispatch((ctx->m_shadow_map->width() + 31) / 32, (ctx->m_shadow_map->height() + 7) / 8, 1);
 
                     }
 
-                    graphics->transition_resource(ctx->m_shadow_map, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+                    details::transition_resources(commands, m_shadows_graph.m_final_barriers, shadow_resources);
                 }
 
-                return std::make_unique<graphics_compute_submitable>(std::move(graphics));
+                return std::make_unique<graphics_compute_stream_submitable>(std::move(graphics), &m_shadows_commands);
             }
 
             shadow_buffers_descriptor render_world_1::on_shadow_map_descriptor()
             {
                 shadow_buffers_descriptor r = {};
 
-                r.m_shadow_flags = shadow_buffers_descriptor::shadow_flags::shadow_buffer_used | shadow_buffers_descriptor::shadow_flags::shadow_map_used;
-                r.m_shadow_buffer.m_width = 2048;
-                r.m_shadow_buffer.m_height = 2048;
-                r.m_shadow_buffer.m_initial_value = 0.0f;
-                r.m_shadow_buffer.m_msaa = 4;
-                r.m_shadow_buffer.m_format = DXGI_FORMAT_D32_FLOAT;
-
+                //the shadow depth buffer is a transient of the frame graph of the shadow passes
+                r.m_shadow_flags = shadow_buffers_descriptor::shadow_flags::shadow_map_used;
 
                 r.m_shadow_map.m_width = 2048;
                 r.m_shadow_map.m_height = 2048;
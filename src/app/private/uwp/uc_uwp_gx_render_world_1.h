@@ -4,6 +4,9 @@
 #include <vector>
 
 #include <uc_dev/gx/dx12/dx12.h>
+#include <uc_dev/gx/dx12/cmd/command_stream_backend.h>
+#include <uc_dev/gx/cmd/render_queue.h>
+#include <uc_dev/gx/fg/frame_graph.h>
 #include <uc_dev/gx/geo/indexed_geometry.h>
 #include <uc_dev/gx/anm/animation_instance.h>
 #include <uc_dev/gx/structs.h>
@@ -92,6 +95,21 @@ namespace uc
 
                 math::float4           m_light_direction;
 
+                //the main pass, one stream per job
+                std::vector<gx::cmd::command_stream> m_main_job_commands;
+
+                //draws of the main pass, sorted by key
+                gx::cmd::render_queue   m_render_queue;
+
+                //the shadow passes, declared and compiled every frame
+                gx::fg::frame_graph             m_shadows_frame_graph;
+                gx::fg::compiled_frame_graph    m_shadows_graph;
+                gx::fg::transient_desc          m_shadow_depth_desc;
+
+                //placed in the frame heap, kept while the frames in flight use them
+                std::unique_ptr<gx::dx12::gpu_frame_msaa_depth_buffer>         m_shadow_depth_buffers[gx::dx12::max_frames_in_flight];
+                uint32_t                                                        m_shadow_frame_index = 0;
+
             };
         }
     }
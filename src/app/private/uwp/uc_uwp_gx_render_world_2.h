@@ -31,7 +31,6 @@ namespace uc
 
                 void do_update(update_context* ctx) override;
                 std::unique_ptr< submitable > do_render(render_context* ctx) override;
-                std::unique_ptr< submitable > do_render_shadows(shadow_render_context* ctx) override;
 
                 gx::dx12::graphics_pipeline_state*                              m_skeleton_pso;
                 std::vector<gx::position_3d>                                    m_skeleton_positions;
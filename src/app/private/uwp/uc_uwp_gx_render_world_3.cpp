@@ -108,22 +108,27 @@ namespace uc
                 auto resources = ctx->m_resources;
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
 
-                begin_render(ctx, graphics.get());
+                //record the pass, then replay it on the context
+                m_main_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_main_commands);
+                auto commands = &recorder;
+
+                begin_render(ctx, commands);
 
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    set_view_port(ctx, commands);
+                    commands->set_descriptor_heaps();
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                graphics->set_pso(m_textured);
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                commands->set_pso(m_textured);
 
                 {
                     frame_constants frame;
                     frame.m_view = uc::math::transpose(uc::gx::view_matrix(camera()));
                     frame.m_perspective = uc::math::transpose(uc::gx::perspective_matrix(camera()));
-                    graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
+                    commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
                 }
 
                 //robot
@@ -132,21 +137,21 @@ namespace uc
                     draw_constants draw;
                     draw.m_world = uc::math::transpose(*m_bear_transform);
 
-                    graphics->set_pso(m_textured);
-                    graphics->set_descriptor_heaps();
+                    commands->set_pso(m_textured);
+                    commands->set_descriptor_heaps();
 
                     //todo: move this into a big buffer for the whole scene
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
-                    graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
+                    commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
                     //geometry
 
-                    graphics->set_vertex_buffer(0, ctx->m_geometry->parametrized_mesh_position_view());
-                    graphics->set_vertex_buffer(1, ctx->m_geometry->parametrized_mesh_uv_view());
-                    graphics->set_index_buffer(ctx->m_geometry->indices_view());
+                    commands->set_vertex_buffer(0, ctx->m_geometry->parametrized_mesh_position_view());
+                    commands->set_vertex_buffer(1, ctx->m_geometry->parametrized_mesh_uv_view());
+                    commands->set_index_buffer(ctx->m_geometry->indices_view(m_bear->m_indices->format()));
 
                     //material
-                    graphics->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, m_texture_bear->srv());
+                    commands->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, m_texture_bear->srv());
 
                     //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
 
@@ -155,12 +160,12 @@ namespace uc
                     auto  index_count = m_bear->m_indices->index_count();
 
                     //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                    graphics->draw_indexed(index_count, base_index_offset, base_vertex_offset);
+                    commands->draw_indexed(index_count, base_index_offset, base_vertex_offset);
                 }
 
-                end_render(ctx, graphics.get());
+                end_render(ctx, commands);
 
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_main_commands);
             }
 
             std::unique_ptr< submitable >render_world_3::do_render_depth(render_context* ctx)
@@ -168,22 +173,28 @@ namespace uc
                 auto resources = ctx->m_resources;
                 //now start new ones
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
-                begin_render_depth(ctx, graphics.get());
+
+                //record the pass, then replay it on the context
+                m_depth_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_depth_commands);
+                auto commands = &recorder;
+
+                begin_render_depth(ctx, commands);
 
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    set_view_port(ctx, commands);
+                    commands->set_descriptor_heaps();
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                graphics->set_pso(m_textured_depth);
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                commands->set_pso(m_textured_depth);
 
                 {
                     frame_constants frame;
                     frame.m_view = uc::math::transpose(uc::gx::view_matrix(camera()));
                     frame.m_perspective = uc::math::transpose(uc::gx::perspective_matrix(camera()));
-                    graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
+                    commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
                 }
 
                 //bear
@@ -193,13 +204,13 @@ namespace uc
                     draw.m_world = uc::math::transpose(*m_bear_transform);
 
                     //todo: move this into a big buffer for the whole scene
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
-                    graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
+                    commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 
                     //geometry
-                    graphics->set_vertex_buffer(0, ctx->m_geometry->parametrized_mesh_position_view());
-                    graphics->set_index_buffer(ctx->m_geometry->indices_view());
+                    commands->set_vertex_buffer(0, ctx->m_geometry->parametrized_mesh_position_view());
+                    commands->set_index_buffer(ctx->m_geometry->indices_view(m_bear->m_indices->format()));
 
                     //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
                     auto  base_index_offset = m_bear->m_indices->index_offset();
@@ -207,11 +218,12 @@ namespace uc
                     auto  index_count = m_bear->m_indices->index_count();
 
                     //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                    graphics->draw_indexed(index_count, base_index_offset, base_vertex_offset);
+                    commands->draw_indexed(index_count, base_index_offset, base_vertex_offset);
                 }
 
-                end_render_depth(ctx, graphics.get());
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                end_render_depth(ctx, commands);
+
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_depth_commands);
             }
         }
     }
@@ -11,6 +11,7 @@
 #include <uc_dev/gx/img_utils.h>
 
 #include <autogen/shaders/textured_solid_graphics.h>
+#include <autogen/shaders/textured_bindless_graphics.h>
 #include <autogen/shaders/textured_depth_only_graphics.h>
 
 #include "uc_uwp_gx_render_object_factory.h"
@@ -56,6 +57,12 @@ namespace uc
                     m_textured = gx::dx12::create_pso(resources->device_d2d12(), resources->resource_create_context(), gx::dx12::textured_solid_graphics::create_pso);
                 });
 
+                g.run([this, c]
+                {
+                    auto resources = c->m_resources;
+                    m_textured_bindless = gx::dx12::create_pso(resources->device_d2d12(), resources->resource_create_context(), gx::dx12::textured_bindless_graphics::create_pso);
+                });
+
                 g.run([this, c]
                 {
                     auto resources = c->m_resources;
@@ -84,22 +91,40 @@ namespace uc
                 auto resources = ctx->m_resources;
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
 
-                begin_render(ctx, graphics.get());
+                //record the pass, then replay it on the context
+                m_main_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_main_commands);
+                auto commands = &recorder;
+
+                begin_render(ctx, commands);
 
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    set_view_port(ctx, commands);
+                    commands->set_descriptor_heaps();
+                }
+
+                //the textures of the deer are in the bindless table, unless it was full when they were loaded
+                bool bindless = true;
+
+                for (auto&& t : m_deer->m_opaque_textures)
+                {
+                    bindless = bindless && t->bindless_index() != gx::dx12::descriptor_index_pool::invalid;
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                graphics->set_pso(m_textured);
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                commands->set_pso(bindless ? m_textured_bindless : m_textured);
+
+                if (bindless)
+                {
+                    commands->set_graphics_bindless_table(gx::dx12::default_root_singature::slots::bindless_0);
+                }
 
                 {
                     frame_constants frame;
                     frame.m_view = uc::math::transpose(uc::gx::view_matrix(camera()));
                     frame.m_perspective = uc::math::transpose(uc::gx::perspective_matrix(camera()));
-                    graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
+                    commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
                 }
 
                 //robot
@@ -109,23 +134,30 @@ namespace uc
                     draw.m_world = uc::math::transpose(*m_deer_transform);
 
                     //todo: move this into a big buffer for the whole scene
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
 
                     //primitives
-                    graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                    commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
                     //geometry
-                    graphics->set_vertex_buffer(0, ctx->m_geometry->parametrized_mesh_position_view());
-                    graphics->set_vertex_buffer(1, ctx->m_geometry->parametrized_mesh_uv_view());
-                    graphics->set_index_buffer(ctx->m_geometry->indices_view());
+                    commands->set_vertex_buffer(0, ctx->m_geometry->parametrized_mesh_position_view());
+                    commands->set_vertex_buffer(1, ctx->m_geometry->parametrized_mesh_uv_view());
+                    commands->set_index_buffer(ctx->m_geometry->indices_view(m_deer->m_indices->format()));
 
                     for (auto i = 0; i < m_deer->m_opaque_textures.size(); ++i)
                     {
 
                         {
                             auto& t = m_deer->m_opaque_textures[i];
-                            //material
-                            graphics->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, t->srv());
+                            //material, an index in the table instead of a copy of the descriptor per draw
+                            if (bindless)
+                            {
+                                commands->set_graphics_root_constant(gx::dx12::default_root_singature::slots::constants_0, t->bindless_index());
+                            }
+                            else
+                            {
+                                commands->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, t->srv());
+                            }
                         }
 
                         {
@@ -134,14 +166,14 @@ namespace uc
                             auto  base_vertex_offset = m_deer->m_geometry->draw_offset();
 
                             //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                            graphics->draw_indexed(r.size(), r.m_begin + base_index_offset, base_vertex_offset);
+                            commands->draw_indexed(r.size(), r.m_begin + base_index_offset, base_vertex_offset);
                         }
                     }
                 }
 
-                end_render(ctx, graphics.get());
+                end_render(ctx, commands);
 
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_main_commands);
             }
         }
     }
@@ -157,23 +157,28 @@ namespace uc
                 auto resources = ctx->m_resources;
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
 
-                begin_render(ctx, graphics.get());
+                //record the pass, then replay it on the context
+                m_main_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_main_commands);
+                auto commands = &recorder;
+
+                begin_render(ctx, commands);
 
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    set_view_port(ctx, commands);
+                    commands->set_descriptor_heaps();
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
-                graphics->set_pso(m_skeleton_pso);
-                graphics->set_descriptor_heaps();
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+                commands->set_pso(m_skeleton_pso);
+                commands->set_descriptor_heaps();
 
                 {
                     frame_constants frame;
                     frame.m_view = uc::math::transpose(uc::gx::view_matrix(camera()));
                     frame.m_perspective = uc::math::transpose(uc::gx::perspective_matrix(camera()));
-                    graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
+                    commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
                 }
 
                 for ( auto i = 0U; i < m_animations.size(); ++i )
@@ -184,20 +189,20 @@ namespace uc
                     draw.m_world = uc::math::translation_x( 0 );
 
                     //todo: move this into a big buffer for the whole scene
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, draw);
 
                     auto&& positions = m_skeleton_positions[i];
 
                     //gx::anm::skeleton_instance instance(m_skeleton.get());
                     //auto&& positions =gx::anm::skeleton_positions(m_skeleton.get(), instance.local_transforms());
 
-                    graphics->set_dynamic_vertex_buffer(0, sizeof(gx::position_3d), resources->upload_queue()->upload_buffer(&positions[0], positions.size() * sizeof(gx::position_3d)));
-                    graphics->draw(static_cast<uint32_t>(positions.size()));
+                    commands->set_dynamic_vertex_buffer(0, sizeof(gx::position_3d), resources->upload_queue()->upload_buffer(&positions[0], positions.size() * sizeof(gx::position_3d)));
+                    commands->draw(static_cast<uint32_t>(positions.size()));
                 }
 
-                end_render(ctx, graphics.get());
+                end_render(ctx, commands);
 
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_main_commands);
             }
         }
     }
@@ -46,22 +46,27 @@ namespace uc
                 auto resources      = ctx->m_resources;
                 auto graphics       = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
 
-                begin_render(ctx, graphics.get() );
+                //record the pass, then replay it on the context
+                m_main_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_main_commands);
+                auto commands = &recorder;
+
+                begin_render(ctx, commands );
 
                 {
-                    set_view_port(ctx, graphics.get()) ;
-                    graphics->set_descriptor_heaps();
+                    set_view_port(ctx, commands) ;
+                    commands->set_descriptor_heaps();
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                graphics->set_pso(m_full_screen_color);
-                graphics->draw(3);
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                commands->set_pso(m_full_screen_color);
+                commands->draw(3);
 
 
-                end_render(ctx, graphics.get());
+                end_render(ctx, commands);
 
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_main_commands);
             }
       
         }
@@ -170,42 +170,47 @@ namespace uc
                 auto resources = ctx->m_resources;
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
 
-                begin_render(ctx, graphics.get());
+                //record the pass, then replay it on the context
+                m_main_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_main_commands);
+                auto commands = &recorder;
+
+                begin_render(ctx, commands);
 
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    set_view_port(ctx, commands);
+                    commands->set_descriptor_heaps();
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                graphics->set_pso(m_textured_skinned);
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                commands->set_pso(m_textured_skinned);
 
                 {
                     frame_constants frame;
 
                     frame.m_view        = uc::math::transpose(uc::gx::view_matrix( camera() ));
                     frame.m_perspective = uc::math::transpose(uc::gx::perspective_matrix( camera() ));
-                    graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
+                    commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
                 }
 
                 //robot
                 {
-                    graphics->set_pso(m_textured_skinned);
-                    graphics->set_descriptor_heaps();
+                    commands->set_pso(m_textured_skinned);
+                    commands->set_descriptor_heaps();
 
                     //todo: move this into a big buffer for the whole scene
-                    graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                    commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 
                     //geometry
-                    graphics->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
-                    graphics->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_uv_view());
-                    graphics->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_normal_view());
-                    graphics->set_vertex_buffer(3, ctx->m_geometry->skinned_mesh_tangent_view());
-                    graphics->set_vertex_buffer(4, ctx->m_geometry->skinned_mesh_blend_weight_view());
-                    graphics->set_vertex_buffer(5, ctx->m_geometry->skinned_mesh_blend_index_view());
-                    graphics->set_index_buffer(ctx->m_geometry->indices_view());
+                    commands->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
+                    commands->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_uv_view());
+                    commands->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_normal_view());
+                    commands->set_vertex_buffer(3, ctx->m_geometry->skinned_mesh_tangent_view());
+                    commands->set_vertex_buffer(4, ctx->m_geometry->skinned_mesh_blend_weight_view());
+                    commands->set_vertex_buffer(5, ctx->m_geometry->skinned_mesh_blend_index_view());
+                    commands->set_index_buffer(ctx->m_geometry->indices_view(m_robot->m_indices->format()));
 
                     size_t start = 0;
                     size_t size = m_robot->m_primitive_ranges.size();
@@ -215,7 +220,7 @@ namespace uc
                         {
                             auto& t = m_robot->m_opaque_textures[j];
                             //material
-                            graphics->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, t->srv());
+                            commands->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, t->srv());
                         }
 
                         {
@@ -224,14 +229,14 @@ namespace uc
                             auto  base_vertex_offset    = m_robot->m_geometry->draw_offset();
 
                             //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                            graphics->draw_indexed(r.size(), r.m_begin + base_index_offset, base_vertex_offset);
+                            commands->draw_indexed(r.size(), r.m_begin + base_index_offset, base_vertex_offset);
                         }
                     }
                 }
 
-                end_render(ctx, graphics.get());
+                end_render(ctx, commands);
 
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_main_commands);
             }
 
             std::unique_ptr< submitable >render_world_8::do_render_depth(render_context* ctx)
@@ -240,39 +245,46 @@ namespace uc
                 auto resources = ctx->m_resources;
                 //now start new ones
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
-                begin_render_depth(ctx, graphics.get());
+
+                //record the pass, then replay it on the context
+                m_depth_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_depth_commands);
+                auto commands = &recorder;
+
+                begin_render_depth(ctx, commands);
 
                 
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    set_view_port(ctx, commands);
+                    commands->set_descriptor_heaps();
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                graphics->set_pso(m_textured_skinned_depth);
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                commands->set_pso(m_textured_skinned_depth);
 
                 {
                     frame_constants frame;
                     frame.m_view = uc::math::transpose(uc::gx::view_matrix(camera()));
                     frame.m_perspective = uc::math::transpose(uc::gx::perspective_matrix(camera()));
-                    graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
+                    commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, frame);
                 }
 
                 //geometry
-                graphics->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
-                graphics->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
-                graphics->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
-                graphics->set_index_buffer(ctx->m_geometry->indices_view());
+                commands->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
+                commands->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
+                commands->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
+                commands->set_index_buffer(ctx->m_geometry->indices_view(m_robot->m_indices->format()));
 
                 auto  base_index_offset = m_robot->m_indices->index_offset();
                 auto  base_vertex_offset = m_robot->m_geometry->draw_offset();
                 auto  index_count = m_robot->m_indices->index_count();
 
-                graphics->draw_indexed(index_count, base_index_offset, base_vertex_offset);
+                commands->draw_indexed(index_count, base_index_offset, base_vertex_offset);
+
+                end_render_depth(ctx, commands);
 
-                end_render_depth(ctx, graphics.get());
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_depth_commands);
 
             }
         }
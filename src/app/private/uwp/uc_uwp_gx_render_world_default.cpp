@@ -32,9 +32,15 @@ namespace uc
                 auto resources = ctx->m_resources;
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
 
-                begin_render(ctx, graphics.get());
-                end_render(ctx, graphics.get());
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                //record the pass, then replay it on the context
+                m_main_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_main_commands);
+                auto commands = &recorder;
+
+                begin_render(ctx, commands);
+                end_render(ctx, commands);
+
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_main_commands);
             }
 
             std::unique_ptr< submitable >render_world_default::do_render_depth( render_context* ctx )
@@ -42,9 +48,16 @@ namespace uc
                 auto resources = ctx->m_resources;
                 //now start new ones
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
-                begin_render_depth(ctx, graphics.get());
-                end_render_depth(ctx, graphics.get());
-                return std::make_unique<graphics_submitable> (std::move(graphics));
+
+                //record the pass, then replay it on the context
+                m_depth_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_depth_commands);
+                auto commands = &recorder;
+
+                begin_render_depth(ctx, commands);
+                end_render_depth(ctx, commands);
+
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_depth_commands);
             }
         }
     }
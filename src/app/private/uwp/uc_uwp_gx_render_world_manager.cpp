@@ -13,6 +13,42 @@ namespace uc
     {
         namespace gxu
         {
+            namespace details
+            {
+                //the passes replay the streams of the world when they are submitted, so the world lives until then, even if another one is shown
+                class world_submitable : public submitable
+                {
+                    public:
+
+                    world_submitable(const std::shared_ptr< render_world >& world, std::unique_ptr< submitable >&& passes) : m_world(world), m_passes(std::move(passes))
+                    {
+
+                    }
+
+                    private:
+
+                    std::shared_ptr< render_world > m_world;
+                    std::unique_ptr< submitable >   m_passes;
+
+                    void on_submit()
+                    {
+                        m_passes->submit();
+                    }
+                };
+
+                inline std::unique_ptr< submitable > make_world_submitable(const std::shared_ptr< render_world >& world, std::unique_ptr< submitable >&& passes)
+                {
+                    if (passes)
+                    {
+                        return std::make_unique<world_submitable>(world, std::move(passes));
+                    }
+                    else
+                    {
+                        return nullptr;
+                    }
+                }
+            }
+
             render_world_manager::render_world_manager( initialize_context* c ) : m_initialize_context(*c)
             {
 
@@ -58,7 +94,7 @@ namespace uc
                 std::shared_ptr< render_world > world = m_world;
                 if ( world )
                 {
-                    return world->render(ctx);
+                    return details::make_world_submitable(world, world->render(ctx));
                 }
                 else
                 {
@@ -102,7 +138,7 @@ namespace uc
                 std::shared_ptr< render_world > world = m_world;
                 if (world)
                 {
-                    return world->render_depth(ctx);
+                    return details::make_world_submitable(world, world->render_depth(ctx));
                 }
                 else
                 {
@@ -116,7 +152,7 @@ namespace uc
                 std::shared_ptr< render_world > world = m_world;
                 if (world)
                 {
-                    return world->render_shadows(ctx);
+                    return details::make_world_submitable(world, world->render_shadows(ctx));
                 }
                 else
                 {
@@ -13,7 +13,7 @@
 #include <uc_dev/gx/img_utils.h>
 #include <uc_dev/gx/anm/anm.h>
 
-#include <autogen/shaders/textured_skinned_lit_solid_graphics.h>
+#include <autogen/shaders/textured_skinned_lit_solid_indirect_graphics.h>
 #include <autogen/shaders/textured_skinned_lit_depth_only_graphics.h>
 #include <autogen/shaders/textured_skinned_lit_shadows_graphics.h>
 #include <autogen/shaders/shadows_resolve_compute.h>
@@ -63,7 +63,10 @@ namespace uc
                 g.run([this, c]
                 {
                     auto resources = c->m_resources;
-                    m_skinned = gx::dx12::create_pso(resources->device_d2d12(), resources->resource_create_context(), gx::dx12::textured_skinned_lit_solid_graphics::create_pso);
+                    m_skinned = gx::dx12::create_pso(resources->device_d2d12(), resources->resource_create_context(), gx::dx12::textured_skinned_lit_solid_indirect_graphics::create_pso);
+
+                    //the indirect draws set the draw id of the shaders, so they need the root signature of the pso
+                    m_draw_signature = gx::dx12::gpu_command_manager::create_draw_indexed_instance_signature(resources->device_d2d12(), m_skinned->m_root_signature, gx::dx12::default_root_singature::slots::constants_0);
                 });
 
                 g.run([this, c]
@@ -94,108 +97,32 @@ namespace uc
 
             }
 
-            std::unique_ptr< submitable >render_world_moment_shadow_maps::do_render_shadows(shadow_render_context* ctx)
-            {
-                //now start new ones
-                auto resources = ctx->m_resources;
-                auto graphics = create_graphics_compute_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
-
-
-                {
-                    auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"Shadows Pass");
-
-                    graphics->clear_depth(ctx->m_shadow_depth_buffer, 0.0f);
-                    graphics->set_render_target(ctx->m_shadow_depth_buffer);
-
-                    {
-                        set_view_port(ctx, graphics.get());
-                    }
-
-                    //Per many draw calls  -> frequency 1
-                    graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                    graphics->set_pso(m_skinned_shadows);
-                    graphics->set_descriptor_heaps();
-
-                    graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame_shadows);
-
-                    //mechanic
-                    {
-                        auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Mechanic");
-
-                        //todo: move this into a big buffer for the whole scene
-                        graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m_constants_pass);
-
-                        //geometry
-                        graphics->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
-                        graphics->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
-                        graphics->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
-                        graphics->set_index_buffer(ctx->m_geometry->indices_view());
-
-                        //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                        graphics->draw_indexed(m_military_mechanic->m_indices->index_count(), m_military_mechanic->m_indices->index_offset(), m_military_mechanic->m_geometry->draw_offset());
-                    }
-
-                    //plane
-                    {
-                        auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Plane");
-
-                        math::float4x4 m = math::identity_matrix();
-
-                        graphics->set_pso(m_plane_shadows);
-
-                        graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
-
-                        gx::dx12::graphics_reset_vertex_buffer(graphics, 0);
-                        gx::dx12::graphics_reset_index_buffer(graphics);
-                        graphics->draw(6);
-                    }
-
-                    end_render_shadows(ctx, graphics.get());
-                }
-
-                {
-
-                    graphics->transition_resource(ctx->m_shadow_depth_buffer, D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
-
-                    {
-                        auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"Shadows Resolve Pass");
-
-                        graphics->set_pso(m_shadows_resolve);
-
-                        graphics->set_compute_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, ctx->m_shadow_depth_buffer->srv_depth());
-                        graphics->set_compute_dynamic_descriptor(gx::dx12::default_root_singature::slots::uav_1, ctx->m_shadow_map->uav());
-
-                        graphics->dispatch(2048 / 32, 2048 / 8, 1);
-
-                    }
-
-                    graphics->transition_resource(ctx->m_shadow_map, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
-                }
-
-                return std::make_unique<graphics_compute_submitable>(std::move(graphics));
-            }
-
             std::unique_ptr< submitable >render_world_moment_shadow_maps::do_render(render_context* ctx)
             {
                 //now start new ones
                 auto resources = ctx->m_resources;
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
 
-                auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"Main Pass");
+                //record the pass, then replay it on the context
+                m_main_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_main_commands);
+                auto commands = &recorder;
 
-                begin_render(ctx, graphics.get());
+                auto profile_event = uc::gx::dx12::make_profile_event(commands, L"Main Pass");
+
+                begin_render(ctx, commands);
 
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    set_view_port(ctx, commands);
+                    commands->set_descriptor_heaps();
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                graphics->set_pso(m_skinned);
-                graphics->set_descriptor_heaps();
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                commands->set_pso(m_skinned);
+                commands->set_descriptor_heaps();
 
-                graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame);
+                commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame);
 
                 //shadows and light
                 {
@@ -212,70 +139,64 @@ namespace uc
                     r.m_shadow_view = m_constants_frame_shadows.m_view;
                     r.m_shadow_perspective = m_constants_frame_shadows.m_perspective;
                     r.m_directional_light = m_light_direction;
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 1, r);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 1, r);
                 }
 
-                graphics->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, ctx->m_shadow_map->srv(), 0);
-                graphics->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, m_blue_noise->srv(),1);
+                commands->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, ctx->m_shadow_map->srv(), 0);
+                commands->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, m_blue_noise->srv(),1);
 
 
-                //mechanic
-                {
-                    auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Mechanic"); 
-                    //todo: move this into a big buffer for the whole scene
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m_constants_pass);
-
-                    //geometry
-                    graphics->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
-                    graphics->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_uv_view());
-                    graphics->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_normal_view());
-                    graphics->set_vertex_buffer(3, ctx->m_geometry->skinned_mesh_tangent_view());
-                    graphics->set_vertex_buffer(4, ctx->m_geometry->skinned_mesh_blend_weight_view());
-                    graphics->set_vertex_buffer(5, ctx->m_geometry->skinned_mesh_blend_index_view());
-                    graphics->set_index_buffer(ctx->m_geometry->indices_view());
-
-                    size_t start = 0;
-                    size_t size = m_military_mechanic->m_primitive_ranges.size();
-
-                    for (auto i = start; i < start + size; ++i)
-                    {
-                        {
-                            //auto& t = m_military_mechanic->m_opaque_textures[i];
-                            //material
+                //the draws of the scene
+                m_draws.clear();
 
-                        }
+                if (m_military_mechanic_visible)
+                {
+                    auto  base_index_offset = m_military_mechanic->m_indices->index_offset();
+                    auto  base_vertex_offset = m_military_mechanic->m_geometry->draw_offset();
 
-                        {
-                            auto& r = m_military_mechanic->m_primitive_ranges[i];
-                            auto  base_index_offset = m_military_mechanic->m_indices->index_offset();
-                            auto  base_vertex_offset = m_military_mechanic->m_geometry->draw_offset();
+                    m_draws.add_instance(m_constants_pass);
+                    m_draws.add_draws(m_military_mechanic->m_primitive_ranges, base_index_offset, base_vertex_offset);
+                }
 
-                            //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                            graphics->draw_indexed(r.size(), r.m_begin + base_index_offset, base_vertex_offset);
-                        }
-                    }
+                //mechanic
+                if (m_draws.draw_count() > 0)
+                {
+                    auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Mechanic"); 
+
+                    //geometry, the skinned meshes share the vertex and index buffers
+                    commands->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
+                    commands->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_uv_view());
+                    commands->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_normal_view());
+                    commands->set_vertex_buffer(3, ctx->m_geometry->skinned_mesh_tangent_view());
+                    commands->set_vertex_buffer(4, ctx->m_geometry->skinned_mesh_blend_weight_view());
+                    commands->set_vertex_buffer(5, ctx->m_geometry->skinned_mesh_blend_index_view());
+                    commands->set_index_buffer(ctx->m_geometry->indices_view(m_military_mechanic->m_indices->format()));
+
+                    //the shaders fetch the instances by the draw id, all draws go in one indirect draw
+                    commands->set_graphics_dynamic_srv_buffer(gx::dx12::default_root_singature::slots::srv_0, m_draws.instances().data(), m_draws.instance_count() * sizeof(skinned_draw_constants));
+                    commands->draw_indexed_indirect(m_draw_signature.Get(), m_draws.arguments().data(), m_draws.draw_count());
                 }
 
 
                 //plane
                 {
-                    auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Plane");
+                    auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Plane");
 
                     math::float4x4 m = math::identity_matrix();
 
-                    graphics->set_pso(m_plane);
+                    commands->set_pso(m_plane);
 
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
 
-                    gx::dx12::graphics_reset_vertex_buffer(graphics, 0);
-                    gx::dx12::graphics_reset_index_buffer(graphics);
+                    commands->set_vertex_buffer(0, {});
+                    commands->set_index_buffer({});
 
-                    graphics->draw(6);
+                    commands->draw(6);
                 }
 
-                end_render(ctx, graphics.get());
+                end_render(ctx, commands);
 
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_main_commands);
             }
             
         }
@@ -9,6 +9,7 @@
 #include <uc_dev/gx/geo/indexed_geometry.h>
 #include <uc_dev/gx/anm/animation_instance.h>
 #include <uc_dev/gx/structs.h>
+#include <uc_dev/gx/cmd/indirect_draw_buffer.h>
 
 #include "uc_uwp_gx_render_world_moment_shadows_data.h"
 
@@ -31,9 +32,11 @@ namespace uc
             private:
 
                 std::unique_ptr< submitable > do_render(render_context* ctx) override;
-                std::unique_ptr< submitable > do_render_shadows(shadow_render_context* ctx) override;
 
                 std::unique_ptr<gx::blue_noise::ldr_rg01_64x64> m_blue_noise;
+
+                gx::cmd::indirect_draw_buffer<skinned_draw_constants> m_draws;            //the draws of the main pass, rebuilt every frame
+                Microsoft::WRL::ComPtr<ID3D12CommandSignature>        m_draw_signature;   //draw id and indexed draw, for the root signature of m_skinned
             };
         }
     }
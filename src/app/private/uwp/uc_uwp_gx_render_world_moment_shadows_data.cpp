@@ -3,6 +3,7 @@
 
 #include <gsl/gsl>
 #include <ppl.h>
+#include <algorithm>
 #include <array>
 
 #include <uc_dev/gx/dx12/gpu/texture_2d.h>
@@ -12,6 +13,7 @@
 #include <uc_dev/gx/lip_utils.h>
 #include <uc_dev/gx/img_utils.h>
 #include <uc_dev/gx/anm/anm.h>
+#include <uc_dev/math/batch.h>
 
 #include <autogen/shaders/textured_skinned_lit_solid_graphics.h>
 #include <autogen/shaders/textured_skinned_lit_depth_only_graphics.h>
@@ -120,8 +122,16 @@ namespace uc
                 m_shadow_camera->set_forward(shadows_forward);
                 m_shadow_camera->set_up(shadows_up);
 
+                m_cascade_settings.m_cascade_count  = 1;
+                m_cascade_settings.m_resolution     = 2048;
+
                 g.wait();
                 m_animation_instance = std::make_unique<gx::anm::animation_instance>(m_military_mechanic_animations.get(), m_military_mechanic_skeleton.get());
+
+                //bind pose bounds, until the first update poses the skeleton
+                *m_military_mechanic_transform = math::identity_matrix();
+                auto bind_pose_joints          = m_skeleton_instance->concatenate_transforms(math::identity_matrix());
+                m_military_mechanic_bounds     = m_bounds.add(math::transform(gx::anm::skeleton_bounds(m_military_mechanic_skeleton.get(), bind_pose_joints), *m_military_mechanic_transform));
             }
 
             render_world_moment_shadows_data::~render_world_moment_shadows_data()
@@ -141,29 +151,17 @@ namespace uc
                 m_constants_frame.m_perspective = uc::math::transpose(uc::gx::perspective_matrix(camera()));
 
                 {
-                    //do a scene bounding volume, something that encompasses all meshes, should be as tight as possible. transform it to view space and make the orthogonal projection
-                    math::float4 p0 = math::point3(0.0f, 0.0f, 0.0f);
-                    math::float4 p1 = math::vector3(25.0f, 25.0f, 25.0f);
-                    math::aabb1 scene = { p0, p1 };
-
-                    math::euclidean_transform_3d view = math::make_euclidean_transform_3d(gx::view_matrix(m_shadow_camera.get()));
-                    math::aabb1 scene_bounds_vs = math::transform(scene, view);
-
-                    math::float4 aabb_min = math::bounds_min(scene_bounds_vs);
-                    math::float4 aabb_max = math::bounds_max(scene_bounds_vs);
+                    //scene bounding volume, something that encompasses all meshes. the shadow projection is fit to the part of the view frustum inside it,
+                    //extruded towards the light to catch the casters
+                    const math::aabb scene = math::make_aabb(math::point3(-25.0f, -25.0f, -25.0f), math::point3(25.0f, 25.0f, 25.0f));
 
+                    gx::shadows::build_cascades(camera(), scene, m_light_direction, m_cascade_settings, *m_cascades);
 
-                    m_shadow_camera->set_x_min(math::get_x(aabb_min));
-                    m_shadow_camera->set_x_max(math::get_x(aabb_max));
+                    const gx::shadows::shadow_cascade& cascade = m_cascades->m_cascades[0];
+                    *m_shadow_camera = cascade.m_camera;
 
-                    m_shadow_camera->set_y_min(math::get_y(aabb_min));
-                    m_shadow_camera->set_y_max(math::get_y(aabb_max));
-
-                    m_shadow_camera->set_z_min(math::get_z(aabb_max));
-                    m_shadow_camera->set_z_max(math::get_z(aabb_min));
-
-                    m_constants_frame_shadows.m_view        = uc::math::transpose(uc::gx::view_matrix(m_shadow_camera.get()));
-                    m_constants_frame_shadows.m_perspective = uc::math::transpose(uc::gx::perspective_matrix(m_shadow_camera.get()));
+                    m_constants_frame_shadows.m_view        = uc::math::transpose(cascade.m_view);
+                    m_constants_frame_shadows.m_perspective = uc::math::transpose(cascade.m_projection);
                 }
 
                 {
@@ -174,15 +172,33 @@ namespace uc
                         auto skeleton                   = m_military_mechanic_skeleton.get();
                         auto joints                     = gx::anm::local_to_world_joints2(skeleton, m_skeleton_instance->local_transforms());
 
-                        //todo: avx2
+                        //lip matrices are 16 byte aligned row major, the same layout as float4x4
+                        auto bind_pose                  = reinterpret_cast<const math::float4x4*>(&skeleton->m_joint_inverse_bind_pose2[0].m_a0);
+                        math::mul(bind_pose, joints.data(), draw.m_joints_palette.data(), joints.size());
+
                         for (auto i = 0U; i < joints.size(); ++i)
                         {
-                            math::float4x4 bind_pose    = math::load44(&skeleton->m_joint_inverse_bind_pose2[i].m_a0);
-                            math::float4x4 palette      = math::mul(bind_pose, joints[i]);
-                            draw.m_joints_palette[i]    = math::transpose(palette);
+                            draw.m_joints_palette[i]    = math::transpose(draw.m_joints_palette[i]);
                         }
+
+                        //character bounds from the posed joint spheres
+                        math::aabb bounds               = gx::anm::skeleton_bounds(skeleton, joints);
+                        m_bounds.set(m_military_mechanic_bounds, math::transform(bounds, *m_military_mechanic_transform));
                     }
                 }
+
+                {
+                    const math::frustum_planes views[2] =
+                    {
+                        math::make_frustum_planes(gx::vp_matrix(camera())),
+                        math::make_frustum_planes(math::mul(gx::view_matrix(m_shadow_camera.get()), gx::perspective_matrix(m_shadow_camera.get())))
+                    };
+
+                    gx::cull::frustum_cull(&views[0], 2, m_bounds, m_visible.data());
+
+                    m_military_mechanic_visible         = std::binary_search(m_visible[0].begin(), m_visible[0].end(), m_military_mechanic_bounds);
+                    m_military_mechanic_shadow_visible  = std::binary_search(m_visible[1].begin(), m_visible[1].end(), m_military_mechanic_bounds);
+                }
             }
 
             std::unique_ptr< submitable > render_world_moment_shadows_data::do_render_depth(render_context* ctx)
@@ -191,56 +207,172 @@ namespace uc
                 auto resources = ctx->m_resources;
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
 
-                auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"Depth Pass");
+                //record the pass, then replay it on the context
+                m_depth_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_depth_commands);
+                auto commands = &recorder;
 
-                begin_render_depth(ctx, graphics.get());
+                auto profile_event = uc::gx::dx12::make_profile_event(commands, L"Depth Pass");
+
+                begin_render_depth(ctx, commands);
 
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    set_view_port(ctx, commands);
+                    commands->set_descriptor_heaps();
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                graphics->set_pso(m_skinned_depth);
-                graphics->set_descriptor_heaps();
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                commands->set_pso(m_skinned_depth);
+                commands->set_descriptor_heaps();
 
-                graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame);
+                commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame);
 
                 //mechanic
+                if (m_military_mechanic_visible)
                 {
-                    auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Mechanic");
+                    auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Mechanic");
 
                     //todo: move this into a big buffer for the whole scene
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m_constants_pass);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m_constants_pass);
 
                     //geometry
-                    graphics->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
-                    graphics->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
-                    graphics->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
-                    graphics->set_index_buffer(ctx->m_geometry->indices_view());
+                    commands->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
+                    commands->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
+                    commands->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
+                    commands->set_index_buffer(ctx->m_geometry->indices_view(m_military_mechanic->m_indices->format()));
 
                     //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                    graphics->draw_indexed(m_military_mechanic->m_indices->index_count(), m_military_mechanic->m_indices->index_offset(), m_military_mechanic->m_geometry->draw_offset());
+                    commands->draw_indexed(m_military_mechanic->m_indices->index_count(), m_military_mechanic->m_indices->index_offset(), m_military_mechanic->m_geometry->draw_offset());
                 }
 
                 //plane
                 {
-                    auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Plane");
+                    auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Plane");
 
                     math::float4x4 m = math::identity_matrix();
 
-                    graphics->set_pso(m_plane_depth);
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
+                    commands->set_pso(m_plane_depth);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
+
+                    commands->set_vertex_buffer(0, {});
+                    commands->set_index_buffer({});
+                    commands->draw(6);
+                }
+
+                end_render_depth(ctx, commands);
+
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_depth_commands);
+            }
+
+            std::unique_ptr< submitable > render_world_moment_shadows_data::do_render_shadows(shadow_render_context* ctx)
+            {
+                //now start new ones
+                auto resources = ctx->m_resources;
+                auto graphics = create_graphics_compute_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
+
+                //the depth buffer is drawn, then resolved into the shadow map, which the main pass reads
+                m_shadows_frame_graph.reset();
+
+                auto depth      = m_shadows_frame_graph.import_resource("shadow depth", D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+                auto map        = m_shadows_frame_graph.import_resource("shadow map", shadow_map_descriptor().m_shadow_map.m_initial_state, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+                auto shadows    = m_shadows_frame_graph.add_pass("shadows");
+                m_shadows_frame_graph.write(shadows, depth, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+
+                auto resolve    = m_shadows_frame_graph.add_pass("shadows resolve", gx::fg::pass_queue::compute);
+                m_shadows_frame_graph.read(resolve, depth, D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+                m_shadows_frame_graph.write(resolve, map, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+                m_shadows_frame_graph.compile(m_shadows_graph);
+
+                //by the handles of the frame graph
+                const gx::dx12::gpu_virtual_resource* shadow_resources[] = { ctx->m_shadow_depth_buffer, ctx->m_shadow_map };
+
+                //record the pass, then replay it on the context
+                m_shadows_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_shadows_commands);
+                auto commands = &recorder;
+
+                begin_render_shadows(ctx, commands);
 
-                    gx::dx12::graphics_reset_vertex_buffer(graphics,0);
-                    gx::dx12::graphics_reset_index_buffer(graphics);
-                    graphics->draw(6);
+                if (auto pass = details::find_pass(m_shadows_graph, shadows))
+                {
+                    auto profile_event = uc::gx::dx12::make_profile_event(commands, L"Shadows Pass");
+
+                    details::transition_resources(commands, pass->m_barriers, shadow_resources);
+
+                    commands->clear_depth(ctx->m_shadow_depth_buffer, 0.0f);
+                    commands->set_render_target(ctx->m_shadow_depth_buffer);
+
+                    {
+                        set_view_port(ctx, commands);
+                    }
+
+                    //Per many draw calls  -> frequency 1
+                    commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                    commands->set_pso(m_skinned_shadows);
+                    commands->set_descriptor_heaps();
+
+                    commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame_shadows);
+
+                    //mechanic
+                    if (m_military_mechanic_shadow_visible)
+                    {
+                        auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Mechanic");
+
+                        //todo: move this into a big buffer for the whole scene
+                        commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m_constants_pass);
+
+                        //geometry
+                        commands->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
+                        commands->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
+                        commands->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
+                        commands->set_index_buffer(ctx->m_geometry->indices_view(m_military_mechanic->m_indices->format()));
+
+                        //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
+                        commands->draw_indexed(m_military_mechanic->m_indices->index_count(), m_military_mechanic->m_indices->index_offset(), m_military_mechanic->m_geometry->draw_offset());
+                    }
+
+                    //plane
+                    {
+                        auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Plane");
+
+                        math::float4x4 m = math::identity_matrix();
+
+                        commands->set_pso(m_plane_shadows);
+
+                        commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
+
+                        commands->set_vertex_buffer(0, {});
+                        commands->set_index_buffer({});
+                        commands->draw(6);
+                    }
+
+                    end_render_shadows(ctx, commands);
+                }
+
+                //Resolve
+                if (auto pass = details::find_pass(m_shadows_graph, resolve))
+                {
+                    details::transition_resources(commands, pass->m_barriers, shadow_resources);
+
+                    {
+                        auto profile_event = uc::gx::dx12::make_profile_event(commands, L"Shadows Resolve Pass");
+
+                        commands->set_pso(m_shadows_resolve);
+
+                        commands->set_compute_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, ctx->m_shadow_depth_buffer->srv_depth());
+                        commands->set_compute_dynamic_descriptor(gx::dx12::default_root_singature::slots::uav_1, ctx->m_shadow_map->uav());
+
+                        auto group_width = m_shadows_resolve_group_width;
+                        commands->dispatch((ctx->m_shadow_map->width() + group_width - 1) / group_width, (ctx->m_shadow_map->height() + 7) / 8, 1);
+                    }
                 }
 
-                end_render_depth(ctx, graphics.get());
+                details::transition_resources(commands, m_shadows_graph.m_final_barriers, shadow_resources);
 
-                return std::make_unique<graphics_submitable>(std::move(graphics));
+                return std::make_unique<graphics_compute_stream_submitable>(std::move(graphics), &m_shadows_commands);
             }
 
             shadow_buffers_descriptor render_world_moment_shadows_data::on_shadow_map_descriptor()
@@ -248,15 +380,15 @@ namespace uc
                 shadow_buffers_descriptor r = {};
 
                 r.m_shadow_flags                    = shadow_buffers_descriptor::shadow_flags::shadow_buffer_used | shadow_buffers_descriptor::shadow_flags::shadow_map_used;
-                r.m_shadow_buffer.m_width           = 2048;
-                r.m_shadow_buffer.m_height          = 2048;
+                r.m_shadow_buffer.m_width           = m_cascade_settings.m_resolution;
+                r.m_shadow_buffer.m_height          = m_cascade_settings.m_resolution;
                 r.m_shadow_buffer.m_initial_value   = 0.0f;
                 r.m_shadow_buffer.m_msaa            = 4;
                 r.m_shadow_buffer.m_format          = DXGI_FORMAT_D32_FLOAT;
 
 
-                r.m_shadow_map.m_width              = 2048;
-                r.m_shadow_map.m_height             = 2048;
+                r.m_shadow_map.m_width              = m_cascade_settings.m_resolution;
+                r.m_shadow_map.m_height             = m_cascade_settings.m_resolution;
                 r.m_shadow_map.m_format             = DXGI_FORMAT_R16G16B16A16_UNORM;
                 r.m_shadow_map.m_initial_state      = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
 
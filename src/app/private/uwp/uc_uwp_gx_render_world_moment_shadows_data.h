@@ -7,6 +7,8 @@
 #include <uc_dev/gx/dx12/dx12.h>
 #include <uc_dev/gx/geo/indexed_geometry.h>
 #include <uc_dev/gx/anm/animation_instance.h>
+#include <uc_dev/gx/cull/cull.h>
+#include <uc_dev/gx/shadows/shadow_cascades.h>
 #include <uc_dev/gx/structs.h>
 
 #include "uc_uwp_gx_render_world.h"
@@ -31,6 +33,7 @@ namespace uc
 
                 void do_update(update_context* ctx) override;
                 std::unique_ptr< submitable > do_render_depth(render_context* ctx) override;
+                std::unique_ptr< submitable > do_render_shadows(shadow_render_context* ctx) override;
                 shadow_buffers_descriptor on_shadow_map_descriptor() override;
 
                 std::unique_ptr<gxu::skinned_render_object>                     m_military_mechanic;
@@ -52,9 +55,21 @@ namespace uc
                 //update state
                 math::managed_float4x4                                          m_military_mechanic_transform = math::make_float4x4();
 
+                //culling, object bounds in world space and visible lists for the camera and the shadow view
+                gx::cull::object_bounds                                         m_bounds;
+                std::array< std::vector<uint32_t>, 2 >                          m_visible;
+                uint32_t                                                        m_military_mechanic_bounds;
+                bool                                                            m_military_mechanic_visible         = true;
+                bool                                                            m_military_mechanic_shadow_visible  = true;
+
                 gx::dx12::compute_pipeline_state*                               m_shadows_resolve;
+                uint32_t                                                        m_shadows_resolve_group_width = 32;
                 mem::aligned_unique_ptr<gx::orthographic_camera>                m_shadow_camera = mem::make_aligned_unique_ptr<gx::orthographic_camera>();
 
+                //the shaders sample one shadow map, so the view frustum is covered by a single fitted cascade
+                gx::shadows::cascade_settings                                   m_cascade_settings;
+                mem::aligned_unique_ptr<gx::shadows::shadow_cascades>           m_cascades = mem::make_aligned_unique_ptr<gx::shadows::shadow_cascades>();
+
                 struct skinned_draw_constants
                 {
                     math::float4x4                  m_world;
@@ -79,6 +94,10 @@ namespace uc
 
                 math::float4           m_light_direction;
 
+                //the shadow pass and its resolve, declared and compiled every frame
+                gx::fg::frame_graph             m_shadows_frame_graph;
+                gx::fg::compiled_frame_graph    m_shadows_graph;
+
                 //light
             };
         }
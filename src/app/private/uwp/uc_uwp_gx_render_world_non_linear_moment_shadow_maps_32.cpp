@@ -53,6 +53,9 @@ namespace uc
                     m_shadows_resolve = gx::dx12::create_pso(resources->device_d2d12(), resources->resource_create_context(), gx::dx12::non_linear_moment_shadow_maps_32_resolve_compute::create_pso);
                 });
 
+                //the resolve shader of the 32 bit moments runs 8x8 groups
+                m_shadows_resolve_group_width = 8;
+
 
                 //load blue noise
                 g.run([this, c]
@@ -74,21 +77,26 @@ namespace uc
                 auto resources = ctx->m_resources;
                 auto graphics = create_graphics_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
 
-                auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"Main Pass");
+                //record the pass, then replay it on the context
+                m_main_commands.reset();
+                gx::dx12::gpu_command_stream_recorder recorder(&m_main_commands);
+                auto commands = &recorder;
+
+                auto profile_event = uc::gx::dx12::make_profile_event(commands, L"Main Pass");
 
-                begin_render(ctx, graphics.get());
+                begin_render(ctx, commands);
 
                 {
-                    set_view_port(ctx, graphics.get());
-                    graphics->set_descriptor_heaps();
+                    set_view_port(ctx, commands);
+                    commands->set_descriptor_heaps();
                 }
 
                 //Per many draw calls  -> frequency 1
-                graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                graphics->set_pso(m_skinned);
-                graphics->set_descriptor_heaps();
+                commands->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+                commands->set_pso(m_skinned);
+                commands->set_descriptor_heaps();
 
-                graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame);
+                commands->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame);
 
                 //shadows and light
                 {
@@ -130,27 +138,28 @@ namespace uc
                     r.m_randomness_y            = m_blue_noise->random_y();
                     r.m_randomness_z            = m_blue_noise->random_index();
 
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 1, r);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 1, r);
                 }
 
-                graphics->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, ctx->m_shadow_map->srv(), 0);
-                graphics->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, m_blue_noise->srv(),1);
+                commands->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, ctx->m_shadow_map->srv(), 0);
+                commands->set_graphics_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, m_blue_noise->srv(),1);
 
 
                 //mechanic
+                if (m_military_mechanic_visible)
                 {
-                    auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Mechanic"); 
+                    auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Mechanic"); 
                     //todo: move this into a big buffer for the whole scene
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m_constants_pass);
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m_constants_pass);
 
                     //geometry
-                    graphics->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
-                    graphics->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_uv_view());
-                    graphics->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_normal_view());
-                    graphics->set_vertex_buffer(3, ctx->m_geometry->skinned_mesh_tangent_view());
-                    graphics->set_vertex_buffer(4, ctx->m_geometry->skinned_mesh_blend_weight_view());
-                    graphics->set_vertex_buffer(5, ctx->m_geometry->skinned_mesh_blend_index_view());
-                    graphics->set_index_buffer(ctx->m_geometry->indices_view());
+                    commands->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
+                    commands->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_uv_view());
+                    commands->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_normal_view());
+                    commands->set_vertex_buffer(3, ctx->m_geometry->skinned_mesh_tangent_view());
+                    commands->set_vertex_buffer(4, ctx->m_geometry->skinned_mesh_blend_weight_view());
+                    commands->set_vertex_buffer(5, ctx->m_geometry->skinned_mesh_blend_index_view());
+                    commands->set_index_buffer(ctx->m_geometry->indices_view(m_military_mechanic->m_indices->format()));
 
                     size_t start = 0;
                     size_t size = m_military_mechanic->m_primitive_ranges.size();
@@ -169,7 +178,7 @@ namespace uc
                             auto  base_vertex_offset = m_military_mechanic->m_geometry->draw_offset();
 
                             //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                            graphics->draw_indexed(r.size(), r.m_begin + base_index_offset, base_vertex_offset);
+                            commands->draw_indexed(r.size(), r.m_begin + base_index_offset, base_vertex_offset);
                         }
                     }
                 }
@@ -177,104 +186,23 @@ namespace uc
 
                 //plane
                 {
-                    auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Plane");
+                    auto profile_event0 = uc::gx::dx12::make_profile_event(commands, L"Plane");
 
                     math::float4x4 m = math::identity_matrix();
 
-                    graphics->set_pso(m_plane);
-
-                    graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
-
-                    gx::dx12::graphics_reset_vertex_buffer(graphics, 0);
-                    gx::dx12::graphics_reset_index_buffer(graphics);
-
-                    graphics->draw(6);
-                }
-
-                end_render(ctx, graphics.get());
-
-                return std::make_unique<graphics_submitable>(std::move(graphics));
-            }
-
-            std::unique_ptr< submitable >render_world_non_linear_moment_shadow_maps_32::do_render_shadows(shadow_render_context* ctx)
-            {
-                //now start new ones
-                auto resources      = ctx->m_resources;
-                auto graphics       = create_graphics_compute_command_context(resources->direct_command_context_allocator(device_resources::swap_chains::background));
-
-                
-                {
-                    auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"Shadows Pass");
-
-                    graphics->set_render_target(ctx->m_shadow_depth_buffer);
-                    graphics->clear_depth(ctx->m_shadow_depth_buffer, 0.0f);
-
-                    {
-                        set_view_port(ctx, graphics.get());
-                    }
-
-                    //Per many draw calls  -> frequency 1
-                    graphics->set_primitive_topology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                    graphics->set_pso(m_skinned_shadows);
-                    graphics->set_descriptor_heaps();
-
-                    graphics->set_graphics_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_0, m_constants_frame_shadows);
+                    commands->set_pso(m_plane);
 
-                    //mechanic
-                    {
-                        auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Mechanic");
-
-                        //todo: move this into a big buffer for the whole scene
-                        graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m_constants_pass);
-
-                        //geometry
-                        graphics->set_vertex_buffer(0, ctx->m_geometry->skinned_mesh_position_view());
-                        graphics->set_vertex_buffer(1, ctx->m_geometry->skinned_mesh_blend_weight_view());
-                        graphics->set_vertex_buffer(2, ctx->m_geometry->skinned_mesh_blend_index_view());
-                        graphics->set_index_buffer(ctx->m_geometry->indices_view());
-
-                        //Draw call -> frequency 2 ( nvidia take care these should be on a sub 1 ms granularity)
-                        graphics->draw_indexed(m_military_mechanic->m_indices->index_count(), m_military_mechanic->m_indices->index_offset(), m_military_mechanic->m_geometry->draw_offset());
-                    }
+                    commands->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
 
-                    //plane
-                    {
-                        auto profile_event0 = uc::gx::dx12::make_profile_event(graphics.get(), L"Plane");
-
-                        math::float4x4 m = math::identity_matrix();
-
-                        graphics->set_pso(m_plane_shadows);
-
-                        graphics->set_graphics_dynamic_constant_buffer(gx::dx12::default_root_singature::slots::constant_buffer_1, 0, m);
-                        
-                        gx::dx12::graphics_reset_vertex_buffer(graphics, 0);
-                        gx::dx12::graphics_reset_index_buffer(graphics);
-                        graphics->draw(6);
-                    }
+                    commands->set_vertex_buffer(0, {});
+                    commands->set_index_buffer({});
 
-                    end_render_shadows(ctx, graphics.get());
+                    commands->draw(6);
                 }
-                
-                {
-
-                    graphics->transition_resource(ctx->m_shadow_depth_buffer, D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
-
-                    {
-                        auto profile_event = uc::gx::dx12::make_profile_event(graphics.get(), L"Shadows Resolve Pass");
-
-                        graphics->set_pso(m_shadows_resolve);
 
-                        graphics->set_compute_dynamic_descriptor(gx::dx12::default_root_singature::slots::srv_1, ctx->m_shadow_depth_buffer->srv_depth());
-                        graphics->set_compute_dynamic_descriptor(gx::dx12::default_root_singature::slots::uav_1, ctx->m_shadow_map->uav());
-
-                        graphics->dispatch( 2048 / 8, 2048 / 8, 1);
-
-                    }
-
-                    graphics->transition_resource(ctx->m_shadow_map, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
-                }
+                end_render(ctx, commands);
 
-                return std::make_unique<graphics_compute_submitable>(std::move(graphics));
+                return std::make_unique<graphics_stream_submitable>(std::move(graphics), &m_main_commands);
             }
 
             shadow_buffers_descriptor render_world_non_linear_moment_shadow_maps_32::on_shadow_map_descriptor()
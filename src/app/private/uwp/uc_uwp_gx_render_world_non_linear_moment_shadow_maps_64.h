@@ -31,7 +31,6 @@ namespace uc
             private:
 
                 std::unique_ptr< submitable >do_render(render_context* ctx) override;
-                std::unique_ptr< submitable >do_render_shadows(shadow_render_context* ctx) override;
 
                 std::unique_ptr<gx::blue_noise::ldr_rg01_64x64> m_blue_noise;
             };
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include <uc_dev/gx/dx12/dx12.h>
+#include <uc_dev/gx/dx12/cmd/command_stream_backend.h>
 #include <uc_dev/util/noncopyable.h>
 
 namespace uc
@@ -51,9 +52,88 @@ namespace uc
         };
 
 
+        //the command lists of a pass recorded in parallel, submitted together
+        template <typename context_t > class parallel_context_submitable : public submitable
+        {
+
+            public:
+            parallel_context_submitable(std::unique_ptr< gx::dx12::gpu_parallel_command_context<context_t> >&& ctx) : m_ctx(std::move(ctx))
+            {
+
+            }
+
+            private:
+            parallel_context_submitable(const parallel_context_submitable&) = delete;
+            parallel_context_submitable& operator=(const parallel_context_submitable&) = delete;
+            std::unique_ptr< gx::dx12::gpu_parallel_command_context<context_t> > m_ctx;
+
+            void on_submit()
+            {
+                m_ctx->submit();
+            }
+        };
+
+        //a pass recorded into a command stream, the command list is built from the stream when the pass is submitted
+        //so the frame builds and submits its command lists while the next frame updates, the stream must live until then
+        template <typename sub > class stream_submitable : public submitable
+        {
+
+            public:
+            stream_submitable(sub&& ctx, const gx::cmd::command_stream* s) : m_ctx(std::move(ctx)), m_stream(s)
+            {
+
+            }
+
+            private:
+            stream_submitable(const stream_submitable&) = delete;
+            stream_submitable& operator=(const stream_submitable&) = delete;
+            sub                                 m_ctx;
+            const gx::cmd::command_stream*      m_stream;
+
+            void on_submit()
+            {
+                gx::dx12::execute(m_ctx.get(), *m_stream);
+                m_ctx->submit();
+            }
+        };
+
+        //a pass recorded into one stream per job, the command lists are built from the streams in parallel when the pass is submitted
+        template <typename context_t > class parallel_stream_submitable : public submitable
+        {
+
+            public:
+            parallel_stream_submitable(std::unique_ptr< gx::dx12::gpu_parallel_command_context<context_t> >&& ctx, const std::vector<gx::cmd::command_stream>* s) : m_ctx(std::move(ctx)), m_streams(s)
+            {
+
+            }
+
+            private:
+            parallel_stream_submitable(const parallel_stream_submitable&) = delete;
+            parallel_stream_submitable& operator=(const parallel_stream_submitable&) = delete;
+            std::unique_ptr< gx::dx12::gpu_parallel_command_context<context_t> >   m_ctx;
+            const std::vector<gx::cmd::command_stream>*                            m_streams;
+
+            void on_submit()
+            {
+                auto streams = m_streams;
+
+                m_ctx->record([streams](context_t* c, uint32_t job)
+                {
+                    gx::dx12::execute(c, (*streams)[job]);
+                });
+
+                m_ctx->submit();
+            }
+        };
+
         using graphics_submitable           = context_submitable<gx::dx12::managed_graphics_command_context>;
         using compute_submitable            = context_submitable<gx::dx12::managed_compute_command_context>;
         using graphics_compute_submitable   = context_submitable<gx::dx12::managed_graphics_compute_command_context>;
+        using parallel_graphics_submitable  = parallel_context_submitable<gx::dx12::gpu_graphics_command_context>;
+
+        using graphics_stream_submitable            = stream_submitable<gx::dx12::managed_graphics_command_context>;
+        using graphics_compute_stream_submitable    = stream_submitable<gx::dx12::managed_graphics_compute_command_context>;
+        using parallel_graphics_stream_submitable   = parallel_stream_submitable<gx::dx12::gpu_graphics_command_context>;
 
     }
 }
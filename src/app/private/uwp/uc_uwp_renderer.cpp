@@ -62,6 +62,16 @@ namespace uc
             m_impl->refresh_display_layout();
         }
 
+        void renderer::set_frames_in_flight(uint32_t frames)
+        {
+            m_impl->set_frames_in_flight(frames);
+        }
+
+        frame_stage_timings renderer::stage_timings() const
+        {
+            return m_impl->stage_timings();
+        }
+
         concurrency::task<void> renderer::initialize_async()
         {
             return concurrency::create_task([this]
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ppltasks.h>
+#include <cstdint>
 #include <memory>
 
 
@@ -15,6 +16,19 @@ namespace uc
 {
     namespace uwp
     {
+        //milliseconds of the stages of the last completed frame
+        //the command lists of a frame are built, submitted and presented, and the wait for a free frame in flight runs, while the next frame updates
+        struct frame_stage_timings
+        {
+            double      m_update_ms         = 0.0;  //input, simulation and the render scale
+            double      m_record_ms         = 0.0;  //recording of the passes into command streams
+            double      m_submit_ms         = 0.0;  //building of the command lists from the streams and their submission, overlapped with the next update
+            double      m_present_ms        = 0.0;  //present and the wait for the gpu, overlapped with the next update
+            double      m_stall_ms          = 0.0;  //the part of the present, which the next update did not hide
+            double      m_gpu_ms            = 0.0;  //of the last frame the gpu finished, a few frames before the others
+            uint32_t    m_frames_in_flight  = 0;
+        };
+
         class renderer
         {
             public:
@@ -38,6 +52,10 @@ namespace uc
 
             void refresh_display_layout();
 
+            //frames the cpu may submit ahead of the gpu, applied from the next frame on
+            void set_frames_in_flight(uint32_t frames);
+            frame_stage_timings stage_timings() const;
+
             private:
 
             class renderer_impl* m_impl;
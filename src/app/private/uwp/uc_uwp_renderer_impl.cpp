@@ -44,11 +44,13 @@ namespace uc
 
             gx::geo::geometry_allocator_options o = {};
             o.m_index_count = 1000000;
+            o.m_index_16_count = 1000000;
             o.m_skinned_mesh_vertex_count = 1000000;
             o.m_static_mesh_vertex_count = 1000000;
             o.m_normal_mesh_vertex_count = 1000000;
 
             m_geometry_allocator            = std::make_unique<gx::geo::geometry_allocator>(m_resources.resource_create_context(), o);
+            m_gpu_frame_timer               = std::make_unique<gx::dx12::gpu_frame_timer>(m_resources.device_d2d12(), m_resources.resource_create_context(), m_resources.direct_queue(device_resources::swap_chains::background));
         }
 
         void renderer_impl::initialize_resources()
@@ -82,11 +84,6 @@ namespace uc
             m_resources.direct_queue(device_resources::swap_chains::background )->insert_wait_on(m_resources.compute_queue()->signal_fence());
         }
 
-        static inline uint64_t next_frame(uint64_t frame)
-        {
-            uint64_t r = frame + 1;
-            return r % 3;
-        }
 
         void renderer_impl::set_display_info(const winrt::Windows::Graphics::Display::DisplayInformation& display_information)
         {
@@ -121,9 +118,21 @@ namespace uc
                 m_keyboard.release();
             });
 
+            finish_present();
             m_resources.wait_for_gpu();
         }
 
+        void renderer_impl::set_frames_in_flight(uint32_t frames)
+        {
+            m_frames_in_flight = std::min(std::max(frames, 1U), gx::dx12::max_frames_in_flight);
+        }
+
+        frame_stage_timings renderer_impl::stage_timings() const
+        {
+            std::lock_guard<std::mutex> lock(m_stage_timings_mutex);
+            return m_stage_timings;
+        }
+
         void renderer_impl::process_user_input()
         {
             m_pad_state         = m_pad.update(m_pad_state);
@@ -204,18 +213,34 @@ namespace uc
                         procesor.process(&command);
                     }
 
+                    //automatic, then 1.0, 0.75, 0.5, 0.25 and back to automatic
                     if (io::button_was_pressed(pad, io::pad_state::button_a))
                     {
-                        if (m_scale_render > 0.20f)
+                        if (m_dynamic_resolution_enabled)
+                        {
+                            m_dynamic_resolution_enabled = false;
+                            m_scale_render = 1.0f;
+                        }
+                        else if (m_scale_render > 0.30f)
                         {
                             m_scale_render -= 0.25f;
                         }
                         else
                         {
+                            m_dynamic_resolution_enabled = true;
                             m_scale_render = 1.0f;
+                            m_dynamic_resolution.reset(m_scale_render);
                         }
                     }
 
+                    //frames in flight, from the most down to one and back, less latency against more throughput
+                    //x, as the options page maps a, b and y to the mouse buttons
+                    if (io::button_was_pressed(pad, io::pad_state::button_x))
+                    {
+                        auto frames = m_frames_in_flight.load();
+                        set_frames_in_flight(frames > 1 ? frames - 1 : gx::dx12::max_frames_in_flight);
+                    }
+
                     //clamp the camera
                     {
                         auto camera_position = camera->position();
@@ -228,24 +253,48 @@ namespace uc
             }
         }
 
+        void renderer_impl::update_render_scale()
+        {
+            //the slot of the next frame, written slot_count frames back
+            auto slot = static_cast<uint32_t>(m_frame % gx::dx12::gpu_frame_timer::slot_count);
+
+            //the gpu may still resolve the timestamps of that frame, skip this update rather than read them half written
+            if (m_gpu_frame_timer->pending(slot))
+            {
+                return;
+            }
+
+            gx::drs::frame_timing t;
+            t.m_cpu_ms = static_cast<float>(m_cpu_frame_time);
+            t.m_gpu_ms = static_cast<float>(m_gpu_frame_timer->milliseconds(slot));
+
+            m_frame_stages.m_gpu_ms = t.m_gpu_ms;
+
+            if (m_dynamic_resolution_enabled)
+            {
+                m_scale_render = m_dynamic_resolution.update(t);
+            }
+        }
+
         void renderer_impl::update()
         {
             m_frame_time = m_frame_timer.seconds();
             m_frame_timer.reset();
+            m_stage_timer.reset();
 
             process_user_input();
+            update_render_scale();
 
             concurrency::task_group g;
 
             g.run([this]
             {
                 gxu::update_context ctx;
-                auto&& back_buffer = m_resources.back_buffer(device_resources::swap_chains::background);
-                ctx.m_back_buffer_size.m_width = static_cast<uint16_t>(static_cast<float>(back_buffer->width()) * m_scale_render);
-                ctx.m_back_buffer_size.m_height = static_cast<uint16_t>(static_cast<float>(back_buffer->height()) * m_scale_render);
+                ctx.m_back_buffer_size.m_width = static_cast<uint16_t>(static_cast<float>(m_background_width) * m_scale_render);
+                ctx.m_back_buffer_size.m_height = static_cast<uint16_t>(static_cast<float>(m_background_height) * m_scale_render);
 
-                ctx.m_front_buffer_size.m_width = static_cast<uint16_t>(m_resources.back_buffer(device_resources::swap_chains::overlay)->width());
-                ctx.m_front_buffer_size.m_height = static_cast<uint16_t>(m_resources.back_buffer(device_resources::swap_chains::overlay)->height());
+                ctx.m_front_buffer_size.m_width = static_cast<uint16_t>(m_overlay_width);
+                ctx.m_front_buffer_size.m_height = static_cast<uint16_t>(m_overlay_height);
 
                 ctx.m_resources = &m_resources;
                 ctx.m_pad_state = m_pad_state;
@@ -260,12 +309,11 @@ namespace uc
             if ( m_overlay_page_manager->get_active_page_id() != overlay::pageid::none )
             {
                 overlay::update_context ctx;
-                auto&& back_buffer = m_resources.back_buffer(device_resources::swap_chains::background);
-                ctx.m_back_buffer_size.m_width = static_cast<uint16_t>(static_cast<float>(back_buffer->width()) * m_scale_render);
-                ctx.m_back_buffer_size.m_height = static_cast<uint16_t>(static_cast<float>(back_buffer->height()) * m_scale_render);
+                ctx.m_back_buffer_size.m_width = static_cast<uint16_t>(static_cast<float>(m_background_width) * m_scale_render);
+                ctx.m_back_buffer_size.m_height = static_cast<uint16_t>(static_cast<float>(m_background_height) * m_scale_render);
 
-                ctx.m_front_buffer_size.m_width = static_cast<uint16_t>(m_resources.back_buffer(device_resources::swap_chains::overlay)->width());
-                ctx.m_front_buffer_size.m_height = static_cast<uint16_t>(m_resources.back_buffer(device_resources::swap_chains::overlay)->height());
+                ctx.m_front_buffer_size.m_width = static_cast<uint16_t>(m_overlay_width);
+                ctx.m_front_buffer_size.m_height = static_cast<uint16_t>(m_overlay_height);
                 ctx.m_resources         = &m_resources;
                 ctx.m_pad_state         = m_pad_state;
                 ctx.m_mouse_state       = m_mouse_state;
@@ -278,6 +326,8 @@ namespace uc
             }
 
             g.wait();
+
+            m_frame_stages.m_update_ms = m_stage_timer.milliseconds();
         }
 
         void renderer_impl::flush_prerender_queue()
@@ -291,10 +341,16 @@ namespace uc
 
         void renderer_impl::resize_buffers( const window_environment* environment )
         {
+            finish_present();
             m_resources.wait_for_gpu();
             m_resources.set_window(environment);
             m_window = environment->m_window;
 
+            m_background_width  = m_resources.back_buffer(device_resources::swap_chains::background)->width();
+            m_background_height = m_resources.back_buffer(device_resources::swap_chains::background)->height();
+            m_overlay_width     = m_resources.back_buffer(device_resources::swap_chains::overlay)->width();
+            m_overlay_height    = m_resources.back_buffer(device_resources::swap_chains::overlay)->height();
+
             //Recreate view depth buffer and the msaa shadows depth buffer
             m_render_world_manager->resize_buffers(&m_resources);
         }
@@ -309,6 +365,10 @@ namespace uc
         {
             using namespace gx::dx12;
 
+            //the previous frame presented while this one updated, its resources are free from here on
+            finish_present();
+            m_stage_timer.reset();
+
             concurrency::task_group g;
 
             //flush all uploaded resources previous frame
@@ -322,6 +382,7 @@ namespace uc
             m_resources.direct_queue(device_resources::swap_chains::background)->insert_wait_on(m_resources.compute_queue()->signal_fence());
 
 
+            //the passes record into command streams here, their command lists are built when present() submits them
             std::unique_ptr<submitable> pending_depth;
             std::unique_ptr<submitable> pending_main;
             std::unique_ptr<submitable> pending_overlay;
@@ -330,8 +391,8 @@ namespace uc
 
             //std::unique_ptr<gx::dx12::gpu_frame_depth_buffer> frame_depth_buffer;
 
-            m_frame_index += 1;
-            m_frame_index %= 3;
+            m_frame_index = next_frame_index(m_frame_index);
+            auto timer_slot = static_cast<uint32_t>(m_frame % gpu_frame_timer::slot_count);
             
             //create depth buffer for this frame
             {
@@ -529,35 +590,102 @@ namespace uc
             m_resources.direct_queue(device_resources::swap_chains::overlay)->insert_wait_on(m_resources.upload_queue()->flush());
             m_resources.direct_queue(device_resources::swap_chains::background)->insert_wait_on(m_resources.compute_queue()->signal_fence());
 
-            if (pending_shadows)
-            {
-                pending_shadows->submit();
-            }
+            m_pending_shadows       = std::move(pending_shadows);
+            m_pending_depth         = std::move(pending_depth);
+            m_pending_main          = std::move(pending_main);
+            m_pending_overlay       = std::move(pending_overlay);
+            m_pending_timer_slot    = timer_slot;
 
-            if (pending_depth)
+            m_frame_stages.m_record_ms          = m_stage_timer.milliseconds();
+            m_frame_stages.m_frames_in_flight   = m_frames_in_flight;
+            m_cpu_frame_time                    = m_frame_stages.m_update_ms + m_frame_stages.m_record_ms;
+            m_frame++;
+        }
+
+        void renderer_impl::present()
+        {
+            using namespace gx::dx12;
+
+            m_presented_stages  = m_frame_stages;
+            m_present_pending   = true;
+
+            //returns at once, so the next frame updates while this one builds and submits its command lists, presents and waits for a free frame in flight
+            //the update does not touch the recorded streams, the passes record into them again only after finish_present()
+            m_present_task.run([this]
             {
-                pending_depth->submit();
-            }
+                sys::profile_timer t;
+
+                //the gpu time of the frame, from before the first to after the last pass on the background queue
+                {
+                    auto timer = create_graphics_command_context(m_resources.direct_command_context_allocator(device_resources::swap_chains::background));
+                    m_gpu_frame_timer->begin(timer.get(), m_pending_timer_slot);
+                    timer->submit();
+                }
+
+                if (m_pending_shadows)
+                {
+                    m_pending_shadows->submit();
+                }
 
-            if (pending_main)
+                if (m_pending_depth)
+                {
+                    m_pending_depth->submit();
+                }
+
+                if (m_pending_main)
+                {
+                    m_pending_main->submit();
+                }
+
+                {
+                    auto timer = create_graphics_command_context(m_resources.direct_command_context_allocator(device_resources::swap_chains::background));
+                    m_gpu_frame_timer->end(timer.get(), m_pending_timer_slot);
+                    m_gpu_frame_timer->submitted(m_pending_timer_slot, timer->submit());
+                }
+
+                if (m_pending_overlay)
+                {
+                    m_pending_overlay->submit();
+                }
+
+                m_resources.direct_queue(device_resources::swap_chains::background)->pix_end_event();
+
+                m_pending_shadows.reset();
+                m_pending_depth.reset();
+                m_pending_main.reset();
+                m_pending_overlay.reset();
+
+                m_presented_stages.m_submit_ms = t.milliseconds();
+                t.reset();
+
+                m_resources.present();
+                m_resources.move_to_next_frame();
+                m_presented_stages.m_present_ms = t.milliseconds();
+            });
+        }
+
+        void renderer_impl::finish_present()
+        {
+            if (!m_present_pending)
             {
-                pending_main->submit();
+                return;
             }
 
-            if (pending_overlay)
+            sys::profile_timer t;
+            m_present_task.wait();
+            m_present_pending = false;
+            m_presented_stages.m_stall_ms = t.milliseconds();
+
             {
-                pending_overlay->submit();
+                std::lock_guard<std::mutex> lock(m_stage_timings_mutex);
+                m_stage_timings = m_presented_stages;
             }
 
-            m_resources.direct_queue(device_resources::swap_chains::background)->pix_end_event();
-        }
-
-        void renderer_impl::present()
-        {
-            m_resources.present();
-            m_resources.move_to_next_frame();
             m_resources.sync();
             m_geometry_allocator->sync();
+
+            //a new count applies from the next present on, the rings hold the most frames in flight
+            m_resources.set_frames_in_flight(m_frames_in_flight);
         }
 
         void renderer_impl::resize()
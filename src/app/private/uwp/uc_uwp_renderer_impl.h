@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include <concurrent_queue.h>
+#include <ppl.h>
 
 #include "winrt/base.h"
 #include <winrt/windows.ui.core.h>
@@ -8,6 +12,7 @@
 #include <winrt/windows.ui.xaml.controls.h>
 
 #include <uc_dev/gx/dx12/dx12.h>
+#include <uc_dev/gx/drs/dynamic_resolution.h>
 #include <uc_dev/sys/profile_timer.h>
 
 #include <uc_dev/gx/geo/indexed_geometry.h>
@@ -18,6 +23,7 @@
 #include <uc_dev/io/keyboard.h>
 
 #include "uc_uwp_device_resources.h"
+#include "uc_uwp_renderer.h"
 
 #include "uc_uwp_renderer_overlay_page_manager.h"
 #include "uc_uwp_gx_render_world_manager.h"
@@ -58,14 +64,40 @@ namespace uc
 
             void initialize_resources();
 
+            void set_frames_in_flight(uint32_t frames);
+            frame_stage_timings stage_timings() const;
+
         private:
 
+            void update_render_scale();
+            void finish_present();
+
             device_resources                                                                    m_resources;
 
-            uint32_t                                                                            m_frame_index = 2;
-            std::unique_ptr<gx::dx12::gpu_frame_depth_buffer>                                   m_frame_depth_buffer[3];
-            std::unique_ptr<gx::dx12::gpu_frame_msaa_depth_buffer>                              m_frame_shadow_buffer[3];
-            std::unique_ptr<gx::dx12::gpu_frame_color_buffer>                                   m_frame_shadow_map[3];
+            uint32_t                                                                            m_frame_index = gx::dx12::max_frames_in_flight - 1;
+            std::unique_ptr<gx::dx12::gpu_frame_depth_buffer>                                   m_frame_depth_buffer[gx::dx12::max_frames_in_flight];
+            std::unique_ptr<gx::dx12::gpu_frame_msaa_depth_buffer>                              m_frame_shadow_buffer[gx::dx12::max_frames_in_flight];
+            std::unique_ptr<gx::dx12::gpu_frame_color_buffer>                                   m_frame_shadow_map[gx::dx12::max_frames_in_flight];
+
+            //the building of the command lists from the recorded streams, their submission, the present and the wait for the gpu of a frame run on a task, while the next frame updates
+            //the per frame resources are synced after it, before the next frame records
+            concurrency::task_group                                                             m_present_task;
+            bool                                                                                m_present_pending = false;
+
+            //the passes of the recorded frame, submitted on the present task
+            std::unique_ptr<submitable>                                                         m_pending_shadows;
+            std::unique_ptr<submitable>                                                         m_pending_depth;
+            std::unique_ptr<submitable>                                                         m_pending_main;
+            std::unique_ptr<submitable>                                                         m_pending_overlay;
+            uint32_t                                                                            m_pending_timer_slot = 0;
+            std::atomic<uint32_t>                                                               m_frames_in_flight = gx::dx12::max_frames_in_flight;
+            uint64_t                                                                            m_frame = 0;
+
+            //the back buffer sizes for the update, which does not touch the swap chains, while they present
+            uint32_t                                                                            m_background_width = 0;
+            uint32_t                                                                            m_background_height = 0;
+            uint32_t                                                                            m_overlay_width = 0;
+            uint32_t                                                                            m_overlay_height = 0;
 
             std::unique_ptr<gx::geo::geometry_allocator>                                        m_geometry_allocator;
 
@@ -88,9 +120,22 @@ namespace uc
 
             float                                                                               m_scale_render = 1.0f;
 
+            //the render scale follows the measured frame times, unless the user chose one
+            gx::drs::dynamic_resolution_controller                                              m_dynamic_resolution;
+            bool                                                                                m_dynamic_resolution_enabled = true;
+            std::unique_ptr<gx::dx12::gpu_frame_timer>                                          m_gpu_frame_timer;
+
             sys::profile_timer                                                                  m_frame_timer;
             double                                                                              m_frame_time;
 
+            double                                                                              m_cpu_frame_time = 0.0;    //milliseconds of the update and the recording
+
+            sys::profile_timer                                                                  m_stage_timer;
+            frame_stage_timings                                                                 m_frame_stages;            //of the frame in progress
+            frame_stage_timings                                                                 m_presented_stages;        //of the frame which presents
+            frame_stage_timings                                                                 m_stage_timings;           //of the last completed frame
+            mutable std::mutex                                                                  m_stage_timings_mutex;
+
             bool*                                                                               m_main_window;
             Concurrency::concurrent_queue < resize_window_command >                             m_prerender_queue;
             void                                                                                flush_prerender_queue();
@@ -2,7 +2,7 @@
 
 #include <boost/program_options.hpp>
 
-#include "uc_animation_exception.h"
+#include <uc_dev/build/animation/exception.h>
 
 namespace uc
 {
@@ -20,6 +20,7 @@ namespace uc
                 ("help,?", "produce help message")
                 ("input_animation", po::value< std::string>(), "input animation")
                 ("output_animation", po::value< std::string>(), "output animation")
+                ("cache", po::value< std::string>(), "build cache directory, the build is skipped when the inputs, the options and the tool did not change")
                 ("make_left_handed", po::value< bool >(), "negates the z coordinate.  suitable for some tools like maya");
 
             return desc;
@@ -117,6 +118,17 @@ namespace uc
         {
             return get_bool_option(map, "make_left_handed");
         }
+
+        //empty, when the build cache is off
+        inline auto get_cache_directory(const boost::program_options::variables_map & map)
+        {
+            auto r = std::string();
+            if (get_value_present(map, "cache"))
+            {
+                r = get_input_value<std::string>(map, "cache", [] {});
+            }
+            return r;
+        }
     }
 }
 
@@ -0,0 +1,579 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if defined(__has_include)
+    #if __has_include(<filesystem>) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+        #define UC_BUILD_CACHE_STD_FILESYSTEM
+    #endif
+#endif
+
+#if defined(UC_BUILD_CACHE_STD_FILESYSTEM)
+#include <filesystem>
+#else
+#include <experimental/filesystem>
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace uc
+{
+    namespace build
+    {
+        //the platform of the tools, printed by the tools and part of the cache keys
+        inline std::string get_environment()
+        {
+#if defined(_X86)
+            return "x86";
+#elif defined(_X64)
+            return "x64";
+#else
+            return "unknown";
+#endif
+        }
+
+        namespace cache
+        {
+#if defined(UC_BUILD_CACHE_STD_FILESYSTEM)
+            namespace filesystem = std::filesystem;
+#else
+            namespace filesystem = std::experimental::filesystem;
+#endif
+            namespace details
+            {
+                const uint64_t prime_1 = 11400714785074694791ULL;
+                const uint64_t prime_2 = 14029467366897019727ULL;
+                const uint64_t prime_3 = 1609587929392839161ULL;
+                const uint64_t prime_4 = 9650029242287828579ULL;
+                const uint64_t prime_5 = 2870177450012600261ULL;
+
+                inline uint64_t rotate_left(uint64_t v, uint32_t s)
+                {
+                    return (v << s) | (v >> (64 - s));
+                }
+
+                //little endian on every platform, so the keys match across the build machines
+                inline uint64_t read_64(const uint8_t* p)
+                {
+                    uint64_t r = 0;
+                    for (auto i = 0U; i < 8; ++i)
+                    {
+                        r |= static_cast<uint64_t>(p[i]) << (8 * i);
+                    }
+                    return r;
+                }
+
+                inline uint64_t read_32(const uint8_t* p)
+                {
+                    uint64_t r = 0;
+                    for (auto i = 0U; i < 4; ++i)
+                    {
+                        r |= static_cast<uint64_t>(p[i]) << (8 * i);
+                    }
+                    return r;
+                }
+
+                inline uint64_t round(uint64_t acc, uint64_t input)
+                {
+                    acc += input * prime_2;
+                    acc  = rotate_left(acc, 31);
+                    return acc * prime_1;
+                }
+
+                inline uint64_t merge_round(uint64_t acc, uint64_t v)
+                {
+                    acc ^= round(0, v);
+                    return acc * prime_1 + prime_4;
+                }
+
+                //xxhash64
+                inline uint64_t hash_64(const void* data, size_t size, uint64_t seed)
+                {
+                    const uint8_t* p    = reinterpret_cast<const uint8_t*>(data);
+                    const uint8_t* end  = p + size;
+
+                    uint64_t h;
+
+                    if (size >= 32)
+                    {
+                        uint64_t v1 = seed + prime_1 + prime_2;
+                        uint64_t v2 = seed + prime_2;
+                        uint64_t v3 = seed;
+                        uint64_t v4 = seed - prime_1;
+
+                        for (; p + 32 <= end; p += 32)
+                        {
+                            v1 = round(v1, read_64(p));
+                            v2 = round(v2, read_64(p + 8));
+                            v3 = round(v3, read_64(p + 16));
+                            v4 = round(v4, read_64(p + 24));
+                        }
+
+                        h = rotate_left(v1, 1) + rotate_left(v2, 7) + rotate_left(v3, 12) + rotate_left(v4, 18);
+                        h = merge_round(h, v1);
+                        h = merge_round(h, v2);
+                        h = merge_round(h, v3);
+                        h = merge_round(h, v4);
+                    }
+                    else
+                    {
+                        h = seed + prime_5;
+                    }
+
+                    h += static_cast<uint64_t>(size);
+
+                    for (; p + 8 <= end; p += 8)
+                    {
+                        h ^= round(0, read_64(p));
+                        h  = rotate_left(h, 27) * prime_1 + prime_4;
+                    }
+
+                    if (p + 4 <= end)
+                    {
+                        h ^= read_32(p) * prime_1;
+                        h  = rotate_left(h, 23) * prime_2 + prime_3;
+                        p += 4;
+                    }
+
+                    for (; p < end; ++p)
+                    {
+                        h ^= (*p) * prime_5;
+                        h  = rotate_left(h, 11) * prime_1;
+                    }
+
+                    h ^= h >> 33;
+                    h *= prime_2;
+                    h ^= h >> 29;
+                    h *= prime_3;
+                    h ^= h >> 32;
+
+                    return h;
+                }
+
+                inline void append(std::vector<uint8_t>& b, uint64_t v)
+                {
+                    for (auto i = 0U; i < 8; ++i)
+                    {
+                        b.push_back(static_cast<uint8_t>(v >> (8 * i)));
+                    }
+                }
+
+                inline void append(std::vector<uint8_t>& b, const std::string& s)
+                {
+                    append(b, static_cast<uint64_t>(s.size()));
+                    b.insert(b.end(), s.begin(), s.end());
+                }
+            }
+
+            //128 bit content hash, two xxhash64 lanes with different seeds
+            struct hash
+            {
+                std::array<uint64_t, 2> m_value = {};
+
+                std::string str() const
+                {
+                    const char* digits = "0123456789abcdef";
+                    std::string r;
+                    r.reserve(32);
+
+                    for (auto&& v : m_value)
+                    {
+                        for (int32_t i = 15; i >= 0; --i)
+                        {
+                            r.push_back(digits[(v >> (4 * i)) & 0xF]);
+                        }
+                    }
+
+                    return r;
+                }
+            };
+
+            inline bool operator==(const hash& a, const hash& b)
+            {
+                return a.m_value == b.m_value;
+            }
+
+            inline bool operator!=(const hash& a, const hash& b)
+            {
+                return !(a == b);
+            }
+
+            inline hash hash_bytes(const void* data, size_t size)
+            {
+                hash r;
+                r.m_value[0] = details::hash_64(data, size, 0);
+                r.m_value[1] = details::hash_64(data, size, details::prime_5);
+                return r;
+            }
+
+            //hashes the file in 1mb chunks, then the chunk hashes, so large scans do not need to fit in memory
+            inline hash hash_file(const std::string& file_name)
+            {
+                std::ifstream f(file_name, std::ios::binary);
+
+                if (!f.good())
+                {
+                    throw std::runtime_error("cannot open file for the cache key: " + file_name);
+                }
+
+                std::vector<char>       chunk(1024 * 1024);
+                std::vector<uint8_t>    chunks;
+                uint64_t                size = 0;
+
+                while (f)
+                {
+                    f.read(chunk.data(), chunk.size());
+
+                    auto read = static_cast<size_t>(f.gcount());
+
+                    if (read > 0)
+                    {
+                        auto h = hash_bytes(chunk.data(), read);
+                        details::append(chunks, h.m_value[0]);
+                        details::append(chunks, h.m_value[1]);
+                        size += read;
+                    }
+                }
+
+                details::append(chunks, size);
+                return hash_bytes(chunks.data(), chunks.size());
+            }
+
+            namespace details
+            {
+                //the running executable, argv[0] may be a bare name found on the path
+                inline std::string current_binary()
+                {
+#if defined(_WIN32)
+                    std::vector<wchar_t> b(MAX_PATH);
+
+                    for (;;)
+                    {
+                        const DWORD size = GetModuleFileNameW(nullptr, b.data(), static_cast<DWORD>(b.size()));
+
+                        if (size == 0)
+                        {
+                            return std::string();
+                        }
+
+                        if (size < b.size())
+                        {
+                            return filesystem::path(std::wstring(b.data(), size)).string();
+                        }
+
+                        b.resize(b.size() * 2);
+                    }
+#else
+                    std::error_code e;
+                    auto p = filesystem::read_symlink("/proc/self/exe", e);
+                    return e ? std::string() : p.string();
+#endif
+                }
+
+                struct binary_hash
+                {
+                    hash m_value;
+                    bool m_valid = false;
+                };
+
+                //hashed once per process, the batch tools make many keys
+                inline const binary_hash& current_binary_hash()
+                {
+                    static const binary_hash h = []
+                    {
+                        binary_hash r;
+
+                        try
+                        {
+                            const auto file_name = current_binary();
+
+                            if (!file_name.empty())
+                            {
+                                r.m_value = hash_file(file_name);
+                                r.m_valid = true;
+                            }
+                        }
+
+                        catch (const std::exception&)
+                        {
+
+                        }
+
+                        return r;
+                    }();
+
+                    return h;
+                }
+            }
+
+            //the key of a build step: the tool, the hash of the running binary, the flags and the contents of the inputs
+            //the binary stands for the version, it changes with the converter code and with the layout of the lip types it writes
+            //the input file names are not part of the key, so moved or copied sources hit the cache
+            class key_builder
+            {
+                public:
+
+                explicit key_builder(const std::string& tool)
+                {
+                    const auto& b = details::current_binary_hash();
+
+                    add("tool", tool);
+                    add("binary", b.m_value.str());
+
+                    m_cacheable = b.m_valid;
+                }
+
+                //false, when the running binary could not be hashed, a key without the version must not hit old outputs
+                bool cacheable() const
+                {
+                    return m_cacheable;
+                }
+
+                void add(const std::string& name, const std::string& value)
+                {
+                    details::append(m_data, name);
+                    details::append(m_data, value);
+                }
+
+                void add(const std::string& name, uint64_t value)
+                {
+                    add(name, std::to_string(value));
+                }
+
+                void add_file(const std::string& name, const std::string& file_name)
+                {
+                    add(name, hash_file(file_name).str());
+                }
+
+                void add_files(const std::string& name, const std::vector<std::string>& file_names)
+                {
+                    add(name, static_cast<uint64_t>(file_names.size()));
+
+                    for (auto&& f : file_names)
+                    {
+                        add_file(name, f);
+                    }
+                }
+
+                hash key() const
+                {
+                    return hash_bytes(m_data.data(), m_data.size());
+                }
+
+                private:
+
+                std::vector<uint8_t> m_data;
+                bool                 m_cacheable = false;
+            };
+
+            //outputs of the build steps by key, in <directory>/<2 key digits>/<30 key digits>/<output index>
+            //entries are written to a temporary directory and renamed, so concurrent builds and crashes never leave partial entries
+            class object_store
+            {
+                public:
+
+                explicit object_store(const std::string& directory) : m_directory(directory)
+                {
+
+                }
+
+                //copies the outputs of the key, false on a miss
+                bool fetch(const hash& key, const std::vector<std::string>& outputs) const
+                {
+                    std::error_code e;
+
+                    const auto entry = entry_path(key);
+
+                    if (!filesystem::exists(entry / "manifest", e))
+                    {
+                        return false;
+                    }
+
+                    std::ifstream manifest(entry / "manifest");
+                    uint64_t count = 0;
+                    manifest >> count;
+
+                    if (!manifest.good() || count != outputs.size())
+                    {
+                        return false;
+                    }
+
+                    for (auto i = 0U; i < outputs.size(); ++i)
+                    {
+                        const filesystem::path output(outputs[i]);
+                        const filesystem::path temporary(outputs[i] + ".cache" + unique_suffix());
+
+                        if (output.has_parent_path())
+                        {
+                            filesystem::create_directories(output.parent_path(), e);
+                        }
+
+                        filesystem::copy_file(entry / std::to_string(i), temporary, filesystem::copy_options::overwrite_existing, e);
+
+                        if (e)
+                        {
+                            filesystem::remove(temporary, e);
+                            return false;
+                        }
+
+                        filesystem::rename(temporary, output, e);
+
+                        if (e)
+                        {
+                            filesystem::remove(temporary, e);
+                            return false;
+                        }
+                    }
+
+                    return true;
+                }
+
+                //best effort, a failed store only costs a rebuild later
+                bool store(const hash& key, const std::vector<std::string>& outputs) const
+                {
+                    std::error_code e;
+
+                    const auto entry        = entry_path(key);
+                    const auto temporary    = filesystem::path(m_directory) / "tmp" / (key.str() + unique_suffix());
+
+                    filesystem::create_directories(temporary, e);
+                    filesystem::create_directories(entry.parent_path(), e);
+
+                    for (auto i = 0U; i < outputs.size() && !e; ++i)
+                    {
+                        filesystem::copy_file(filesystem::path(outputs[i]), temporary / std::to_string(i), filesystem::copy_options::overwrite_existing, e);
+                    }
+
+                    if (!e)
+                    {
+                        std::ofstream manifest(temporary / "manifest");
+                        manifest << outputs.size() << std::endl;
+
+                        if (!manifest.good())
+                        {
+                            e = std::make_error_code(std::errc::io_error);
+                        }
+                    }
+
+                    if (!e)
+                    {
+                        //another build may have stored the key first, the entries are equal
+                        filesystem::rename(temporary, entry, e);
+                    }
+
+                    std::error_code ignored;
+                    filesystem::remove_all(temporary, ignored);
+
+                    return !e;
+                }
+
+                private:
+
+                std::string m_directory;
+
+                filesystem::path entry_path(const hash& key) const
+                {
+                    const auto s = key.str();
+                    return filesystem::path(m_directory) / s.substr(0, 2) / s.substr(2);
+                }
+
+                static std::string unique_suffix()
+                {
+                    std::random_device r;
+                    return "." + std::to_string(r()) + std::to_string(r());
+                }
+            };
+
+            //runs build, unless the cache has the outputs of the key, an empty directory or a key without the binary disables the cache
+            //returns true on a hit
+            template <typename build_t>
+            inline bool build_cached(const std::string& directory, const key_builder& key, const std::vector<std::string>& outputs, build_t&& build)
+            {
+                if (directory.empty())
+                {
+                    build();
+                    return false;
+                }
+
+                if (!key.cacheable())
+                {
+                    std::cout << "cache disabled: the tool binary cannot be hashed" << std::endl;
+                    build();
+                    return false;
+                }
+
+                object_store    store(directory);
+                const auto      k = key.key();
+
+                if (store.fetch(k, outputs))
+                {
+                    std::cout << "cache hit:" << k.str() << std::endl;
+                    return true;
+                }
+
+                build();
+
+                std::cout << "cache miss:" << k.str() << (store.store(k, outputs) ? "" : " (not stored)") << std::endl;
+                return false;
+            }
+
+            //the keys of the asset tools, the single file tools and the batch tool build the same steps with them
+            inline key_builder skeleton_key(uint64_t assimp_options, const std::string& input_skeleton)
+            {
+                key_builder r("uc_skeleton");
+                r.add("environment", get_environment());
+                r.add("assimp_options", assimp_options);
+                r.add_file("input_skeleton", input_skeleton);
+                return r;
+            }
+
+            inline key_builder animation_key(uint64_t assimp_options, const std::string& input_animation)
+            {
+                key_builder r("uc_animation");
+                r.add("environment", get_environment());
+                r.add("assimp_options", assimp_options);
+                r.add_file("input_animation", input_animation);
+                return r;
+            }
+
+            //the importer is picked by the extension, which is not in the content hash
+            inline key_builder model_key(const std::string& model_type, uint64_t assimp_options, bool fbx, const std::string& input_model, const std::vector<std::string>& textures, const std::vector<std::string>& texture_formats)
+            {
+                key_builder r("uc_model");
+                r.add("environment", get_environment());
+                r.add("model_type", model_type);
+                r.add("assimp_options", assimp_options);
+                r.add("importer", fbx ? "fbx" : "assimp");
+                r.add_file("input_model", input_model);
+                r.add_files("textures", textures);
+
+                for (auto&& f : texture_formats)
+                {
+                    r.add("textures_formats", f);
+                }
+
+                return r;
+            }
+
+            inline key_builder texture_key(const std::string& texture_format, const std::string& input_texture)
+            {
+                key_builder r("uc_texture");
+                r.add("environment", get_environment());
+                r.add("texture_format", texture_format);
+                r.add_file("input_texture", input_texture);
+                return r;
+            }
+        }
+    }
+}
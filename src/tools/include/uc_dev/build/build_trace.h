@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace uc
+{
+    namespace build
+    {
+        struct trace_event
+        {
+            std::string m_category;     //scan, hash, compile, load, skeleton, animation, model, texture
+            std::string m_name;         //usually the file name
+            uint64_t    m_begin = 0;    //microseconds since the start of the trace
+            uint64_t    m_end   = 0;
+            uint32_t    m_lane  = 0;    //worker thread or process slot
+        };
+
+        //timings of the build steps, saved in the chrome://tracing format, shared by the build tasks and the batch tool
+        class build_trace
+        {
+            public:
+
+            uint64_t now() const
+            {
+                auto d = std::chrono::steady_clock::now() - m_start;
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+            }
+
+            void add(const std::string& category, const std::string& name, uint64_t begin, uint64_t end, uint32_t lane)
+            {
+                trace_event e;
+
+                e.m_category    = category;
+                e.m_name        = name;
+                e.m_begin       = begin;
+                e.m_end         = std::max(begin, end);
+                e.m_lane        = lane;
+
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_events.push_back(std::move(e));
+            }
+
+            //the lane is the calling thread, small lane numbers, so the threads of a pool are the rows of the viewer
+            void add(const std::string& category, const std::string& name, uint64_t begin, uint64_t end)
+            {
+                trace_event e;
+
+                e.m_category    = category;
+                e.m_name        = name;
+                e.m_begin       = begin;
+                e.m_end         = std::max(begin, end);
+
+                std::lock_guard<std::mutex> lock(m_lock);
+
+                auto lane = m_lanes.emplace(std::this_thread::get_id(), static_cast<uint32_t>(m_lanes.size()));
+                e.m_lane  = lane.first->second;
+
+                m_events.push_back(std::move(e));
+            }
+
+            std::vector<trace_event> events() const
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                return m_events;
+            }
+
+            //total time of the events of a category, in microseconds
+            uint64_t duration(const std::string& category) const
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+
+                uint64_t r = 0;
+                for (auto&& e : m_events)
+                {
+                    if (e.m_category == category)
+                    {
+                        r += e.m_end - e.m_begin;
+                    }
+                }
+
+                return r;
+            }
+
+            void save(const std::string& file_name) const
+            {
+                auto events = this->events();
+
+                std::sort(events.begin(), events.end(), [](const trace_event& a, const trace_event& b)
+                {
+                    return a.m_begin < b.m_begin;
+                });
+
+                std::ofstream f(file_name, std::ios_base::binary);
+
+                if (!f.good())
+                {
+                    throw std::runtime_error("cannot open the build trace file " + file_name);
+                }
+
+                f << "{\"traceEvents\":[\n";
+
+                for (auto i = 0U; i < events.size(); ++i)
+                {
+                    auto&& e = events[i];
+
+                    f << "{\"name\":\"" << json_escape(e.m_name) << "\",\"cat\":\"" << json_escape(e.m_category) << "\",\"ph\":\"X\",\"ts\":" << e.m_begin
+                      << ",\"dur\":" << (e.m_end - e.m_begin) << ",\"pid\":1,\"tid\":" << e.m_lane << "}" << (i + 1 < events.size() ? ",\n" : "\n");
+                }
+
+                f << "]}\n";
+            }
+
+            private:
+
+            static std::string json_escape(const std::string& s)
+            {
+                std::string r;
+                r.reserve(s.size());
+
+                for (auto&& c : s)
+                {
+                    switch (c)
+                    {
+                        case '\\': r += "\\\\"; break;
+                        case '"':  r += "\\\""; break;
+                        case '\n': r += "\\n";  break;
+                        case '\r': r += "\\r";  break;
+                        case '\t': r += "\\t";  break;
+                        default:   r += c;      break;
+                    }
+                }
+
+                return r;
+            }
+
+            std::chrono::steady_clock::time_point               m_start = std::chrono::steady_clock::now();
+            mutable std::mutex                                  m_lock;
+            std::vector<trace_event>                            m_events;
+            std::unordered_map<std::thread::id, uint32_t>       m_lanes;
+        };
+    }
+}
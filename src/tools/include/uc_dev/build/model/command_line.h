@@ -2,7 +2,7 @@
 
 #include <boost/program_options.hpp>
 
-#include "uc_model_exception.h"
+#include <uc_dev/build/model/exception.h>
 
 namespace uc
 {
@@ -21,7 +21,8 @@ namespace uc
 
                 ("input_model,i", po::value< std::string>(), "input 3d model")
                 ("output_model,o", po::value< std::string>(), "output 3d model")
-                ("type,t", po::value< std::string>(), "model type ( default, parametrized, textured, multi_textured, skinned )")
+                ("type,t", po::value< std::string>(), "model type ( default, parametrized, textured, multi_textured, skinned, packed_skinned )")
+                ("cache", po::value< std::string>(), "build cache directory, the build is skipped when the inputs, the options and the tool did not change")
 
                 ("textures", po::value< std::vector<std::string>>(), "textures for 3d model")
 
@@ -201,6 +202,16 @@ namespace uc
         }
         
 
+        //empty, when the build cache is off
+        inline auto get_cache_directory(const boost::program_options::variables_map & map)
+        {
+            auto r = std::string();
+            if (get_value_present(map, "cache"))
+            {
+                r = get_input_value<std::string>(map, "cache", [] {});
+            }
+            return r;
+        }
     }
 }
 
@@ -7,8 +7,8 @@
 #include <uc_dev/gx/img/img.h>
 
 #include <Compressonator.h>
-#include "uc_model_swizzle.h"
-#include "uc_model_exception.h"
+#include <uc_dev/build/model/swizzle.h>
+#include <uc_dev/build/model/exception.h>
 
 namespace uc
 {
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace import
+        {
+            namespace fbx
+            {
+                struct fbx_context;
+            }
+        }
+    }
+}
+
+//the converters of the model types, used by the model tool and by the batch tool
+namespace uc
+{
+    namespace model
+    {
+        using assimp_flags_t  = uint32_t;
+        using file_name_t     = std::string;
+
+        //the scene of an fbx file, loaded on the first call, the outputs of one file can share it
+        using fbx_scene       = std::function<gx::import::fbx::fbx_context*()>;
+
+        using convert_function      = std::function<void(const file_name_t&, const file_name_t&, assimp_flags_t, const std::vector<file_name_t>&, const std::vector<file_name_t>& texture_format )>;
+        using convert_function_fbx  = std::function<void(const fbx_scene&, const file_name_t&, assimp_flags_t, const std::vector<file_name_t>&, const std::vector<file_name_t>& texture_format )>;
+
+        struct convertor
+        {
+            std::string             m_model_type;
+            bool                    m_needs_textures;
+            convert_function_fbx    m_convert_function_fbx;
+            convert_function        m_convert_function_assimp;
+        };
+
+        std::vector< convertor > make_convertors();
+        const convertor get_convertor(const std::string& v);
+
+        //the short names of the command line
+        std::string get_model_type_name(const std::string& model_type);
+
+        std::tuple< std::vector<std::string>, std::vector<std::string> > clean_duplicate_textures(const std::vector<std::string>& texture_names, const std::vector<std::string>& texture_formats);
+    }
+}
@@ -0,0 +1,576 @@
+// ucdev_include_parser.cpp : Defines the entry point for the console application.
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include <gsl/gsl>
+
+#include <uc_dev/gx/lip/geo.h>
+#include <uc_dev/math/half.h>
+
+#include <uc_dev/gx/import/geo/indexed_mesh.h>
+#include <uc_dev/gx/import/geo/mesh_simplifier.h>
+#include <uc_dev/gx/import/geo/meshlet_builder.h>
+#include <uc_dev/gx/import/geo/skinned_mesh.h>
+#include <uc_dev/gx/import/geo/vertex_cache_optimizer.h>
+
+namespace uc
+{
+    namespace model
+    {
+        //scans come as triangle soups, weld the bitwise equal vertices with equal attributes
+        inline void weld_mesh(gx::import::geo::indexed_mesh* mesh)
+        {
+            auto vertices   = mesh->m_positions.size();
+            auto faces      = mesh->m_faces.size();
+
+            mesh->weld();
+
+            std::cout << "weld vertices:" << vertices << " -> " << mesh->m_positions.size() << std::endl;
+            std::cout << "weld faces:" << faces << " -> " << mesh->m_faces.size() << std::endl;
+        }
+
+        //the multi material meshes keep the vertices of the importers
+        template <typename mesh_t>
+        void weld_mesh(mesh_t*)
+        {
+
+        }
+
+        //vertex cache, overdraw and vertex fetch order, per material, whichever importer made the mesh
+        template <typename mesh_t>
+        void optimize_mesh(mesh_t* mesh)
+        {
+            weld_mesh(mesh);
+
+            auto r = gx::import::geo::optimize_vertex_order(mesh);
+
+            std::cout << std::fixed << std::setprecision(3);
+            std::cout << "vertex cache acmr:" << r.m_before.acmr() << " -> " << r.m_after.acmr() << std::endl;
+            std::cout << "vertex cache atvr:" << r.m_before.atvr() << " -> " << r.m_after.atvr() << std::endl;
+            std::cout << std::defaultfloat;
+        }
+
+        template <typename t>
+        void copy_indices(const std::vector< gx::import::geo::indexed_mesh::face >& faces, t& out)
+        {
+            size_t index = 0;
+
+            for (auto&& i : faces)
+            {
+                out[index++] = i.v0;
+                out[index++] = i.v1;
+                out[index++] = i.v2;
+            }
+        }
+
+        //16 bit indices when the mesh has less than 65536 vertices, meshes are drawn with their own base vertex, so the indices are mesh relative
+        inline void copy_indices(const std::vector< gx::import::geo::indexed_mesh::face >& faces, lip::indices& out)
+        {
+            uint32_t max_index = 0;
+
+            for (auto&& i : faces)
+            {
+                max_index = std::max(max_index, std::max(static_cast<uint32_t>(i.v0), std::max(static_cast<uint32_t>(i.v1), static_cast<uint32_t>(i.v2))));
+            }
+
+            if (max_index <= std::numeric_limits<uint16_t>::max())
+            {
+                size_t index = 0;
+
+                out.m_data.resize(0);
+                out.m_data_16.resize(faces.size() * 3);
+                out.m_format = static_cast<uint16_t>(lip::index_format::r16_uint);
+
+                for (auto&& i : faces)
+                {
+                    out.m_data_16[index++] = static_cast<uint16_t>(i.v0);
+                    out.m_data_16[index++] = static_cast<uint16_t>(i.v1);
+                    out.m_data_16[index++] = static_cast<uint16_t>(i.v2);
+                }
+            }
+            else
+            {
+                out.m_data_16.resize(0);
+                out.m_data.resize(faces.size() * 3);
+                out.m_format = static_cast<uint16_t>(lip::index_format::r32_uint);
+                copy_indices(faces, out.m_data);
+            }
+        }
+
+        //ranges are in faces
+        template <typename position_t>
+        inline void copy_meshlets(const std::vector< gx::import::geo::indexed_mesh::face >& faces, const std::vector<position_t>& positions, const std::vector<lip::primitive_range>& ranges, lip::meshlets& out)
+        {
+            auto s = gx::import::geo::build_meshlets(faces, positions, ranges);
+
+            out.m_meshlets.resize(s.m_meshlets.size());
+            out.m_bounds.resize(s.m_bounds.size());
+            out.m_ranges.resize(s.m_ranges.size());
+            out.m_vertices.resize(s.m_vertices.size());
+            out.m_triangles.resize(s.m_triangles.size());
+
+            for (auto i = 0U; i < s.m_meshlets.size(); ++i)
+            {
+                auto&& m = s.m_meshlets[i];
+                auto&& b = s.m_bounds[i];
+
+                out.m_meshlets[i].m_vertex_offset   = m.m_vertex_offset;
+                out.m_meshlets[i].m_triangle_offset = m.m_triangle_offset;
+                out.m_meshlets[i].m_vertex_count    = m.m_vertex_count;
+                out.m_meshlets[i].m_triangle_count  = m.m_triangle_count;
+
+                out.m_bounds[i].m_center            = { b.m_center[0], b.m_center[1], b.m_center[2] };
+                out.m_bounds[i].m_radius            = b.m_radius;
+                out.m_bounds[i].m_cone_axis         = { b.m_cone_axis[0], b.m_cone_axis[1], b.m_cone_axis[2] };
+                out.m_bounds[i].m_cone_cutoff       = b.m_cone_cutoff;
+            }
+
+            for (auto i = 0U; i < s.m_ranges.size(); ++i)
+            {
+                out.m_ranges[i].m_begin = s.m_ranges[i].m_begin;
+                out.m_ranges[i].m_end   = s.m_ranges[i].m_end;
+            }
+
+            for (auto i = 0U; i < s.m_vertices.size(); ++i)
+            {
+                out.m_vertices[i] = s.m_vertices[i];
+            }
+
+            for (auto i = 0U; i < s.m_triangles.size(); ++i)
+            {
+                out.m_triangles[i] = s.m_triangles[i];
+            }
+
+            std::cout << "meshlets:" << s.m_meshlets.size() << std::endl;
+        }
+
+        //ranges are in faces, the level ranges are written in indices, as the model ranges
+        //a level is used, while its error projects below lod_tolerance_pixels on a lod_reference_height pixels high viewport
+        template <typename position_t>
+        inline void copy_lods(const std::vector< gx::import::geo::indexed_mesh::face >& faces, const std::vector<position_t>& positions, const std::vector<lip::primitive_range>& ranges, lip::lod_chain& out)
+        {
+            const double lod_tolerance_pixels   = 1.0;
+            const double lod_reference_height   = 1080.0;
+
+            std::array<double, 3> min_p = {  std::numeric_limits<double>::max(),  std::numeric_limits<double>::max(),  std::numeric_limits<double>::max() };
+            std::array<double, 3> max_p = { -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max() };
+
+            for (auto&& f : faces)
+            {
+                for (auto v : { f.v0, f.v1, f.v2 })
+                {
+                    const double p[3] = { positions[v].x, positions[v].y, positions[v].z };
+
+                    for (auto k = 0U; k < 3; ++k)
+                    {
+                        min_p[k] = std::min(min_p[k], p[k]);
+                        max_p[k] = std::max(max_p[k], p[k]);
+                    }
+                }
+            }
+
+            std::array<double, 3> center = { (min_p[0] + max_p[0]) * 0.5, (min_p[1] + max_p[1]) * 0.5, (min_p[2] + max_p[2]) * 0.5 };
+            double radius = 0.0;
+
+            for (auto&& f : faces)
+            {
+                for (auto v : { f.v0, f.v1, f.v2 })
+                {
+                    const double d[3] = { positions[v].x - center[0], positions[v].y - center[1], positions[v].z - center[2] };
+                    radius = std::max(radius, std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]));
+                }
+            }
+
+            auto chain = gx::import::geo::build_lod_chain(faces, positions, ranges);
+
+            std::vector< gx::import::geo::indexed_mesh::face > lod_faces;
+
+            out.m_levels.resize(chain.m_levels.size());
+            out.m_ranges.resize(chain.m_levels.size() * ranges.size());
+
+            std::cout << "lod 0 triangles:" << faces.size() << std::endl;
+
+            float previous_screen_size = std::numeric_limits<float>::max();
+
+            for (auto i = 0U; i < chain.m_levels.size(); ++i)
+            {
+                auto&& l = chain.m_levels[i];
+
+                const uint32_t base = static_cast<uint32_t>(lod_faces.size());
+
+                for (auto j = 0U; j < l.m_ranges.size(); ++j)
+                {
+                    out.m_ranges[i * ranges.size() + j].m_begin = (base + l.m_ranges[j].m_begin) * 3;
+                    out.m_ranges[i * ranges.size() + j].m_end   = (base + l.m_ranges[j].m_end) * 3;
+                }
+
+                lod_faces.insert(lod_faces.end(), l.m_faces.begin(), l.m_faces.end());
+
+                //the error spans lod_tolerance_pixels when the diameter spans 2 * radius / error times as much
+                float screen_size = l.m_error > 0.0 ? static_cast<float>(2.0 * radius * lod_tolerance_pixels / (l.m_error * lod_reference_height)) : std::numeric_limits<float>::max();
+
+                //coarser levels must switch on at smaller sizes
+                screen_size          = std::min(screen_size, previous_screen_size);
+                previous_screen_size = screen_size;
+
+                out.m_levels[i].m_range_offset      = static_cast<uint32_t>(i * ranges.size());
+                out.m_levels[i].m_triangle_count    = static_cast<uint32_t>(l.m_faces.size());
+                out.m_levels[i].m_error             = static_cast<float>(l.m_error);
+                out.m_levels[i].m_screen_size       = screen_size;
+
+                std::cout << "lod " << i + 1 << " triangles:" << l.m_faces.size() << " error:" << l.m_error << " screen size:" << screen_size << std::endl;
+            }
+
+            copy_indices(lod_faces, out.m_indices);
+
+            out.m_center = { static_cast<float>(center[0]), static_cast<float>(center[1]), static_cast<float>(center[2]) };
+            out.m_radius = static_cast<float>(radius);
+        }
+
+        template <typename t>
+        void copy_positions( const std::vector< gx::import::geo::indexed_mesh::position >& positions, t& out )
+        {
+            size_t vertex = 0;
+
+            for (auto&& i : positions)
+            {
+                out[vertex].m_x = i.x;
+                out[vertex].m_y = i.y;
+                out[vertex].m_z = i.z;
+                vertex++;
+            }
+        }
+
+        template <typename t>
+        void copy_normals(const std::vector< gx::import::geo::indexed_mesh::normal >& normals, t& out)
+        {
+            size_t vertex = 0;
+
+            for (auto&& i : normals)
+            {
+                out[vertex].m_x = i.x;
+                out[vertex].m_y = i.y;
+                out[vertex].m_z = i.z;
+                vertex++;
+            }
+        }
+
+        template <typename t>
+        void copy_tangents(const std::vector< gx::import::geo::indexed_mesh::tangent >& tangents, t& out)
+        {
+            size_t vertex = 0;
+
+            for (auto&& i : tangents)
+            {
+                out[vertex].m_x = i.x;
+                out[vertex].m_y = i.y;
+                out[vertex].m_z = i.z;
+                vertex++;
+            }
+        }
+
+        template <typename t>
+        void copy_uv(const std::vector< gx::import::geo::indexed_mesh::uv >& uv, t& out)
+        {
+            size_t vertex = 0;
+
+            for (auto&& i : uv)
+            {
+                out[vertex].m_x = i.x;
+                out[vertex].m_y = i.y;
+                vertex++;
+            }
+        }
+
+        template <typename t>
+        void copy_blend_weights(const std::vector< gx::import::geo::skinned_mesh::blend_weight_t >& weight, t& out)
+        {
+            size_t vertex = 0;
+
+            for (auto&& i : weight)
+            {
+                out[vertex].m_x = i.x;
+                out[vertex].m_y = i.y;
+                out[vertex].m_z = i.z;
+                out[vertex].m_w = i.w;
+                vertex++;
+            }
+        }
+
+        template <typename t>
+        void copy_blend_indices(const std::vector< gx::import::geo::skinned_mesh::blend_index_t >& index, t& out)
+        {
+            size_t vertex = 0;
+
+            for (auto&& i : index)
+            {
+                out[vertex].m_x = static_cast<uint8_t> (i.x);
+                out[vertex].m_y = static_cast<uint8_t> (i.y);
+                out[vertex].m_z = static_cast<uint8_t> (i.z);
+                out[vertex].m_w = static_cast<uint8_t> (i.w);
+                vertex++;
+            }
+        }
+
+        //quantization for lip::packed_skinned_model
+        namespace details
+        {
+            inline int16_t quantize_snorm16(float v)
+            {
+                return static_cast<int16_t>(std::round(std::max(-1.0f, std::min(1.0f, v)) * 32767.0f));
+            }
+
+            inline double dequantize_snorm16(int16_t v)
+            {
+                return std::max(-1.0, static_cast<double>(v) / 32767.0);
+            }
+
+            inline uint16_t quantize_unorm16(float v)
+            {
+                return static_cast<uint16_t>(std::round(std::max(0.0f, std::min(1.0f, v)) * 65535.0f));
+            }
+
+            inline float sign_not_zero(float v)
+            {
+                return v >= 0.0f ? 1.0f : -1.0f;
+            }
+
+            //unit vector -> square [-1;1]^2, the lower hemisphere is folded over the diagonals
+            inline void octahedral_encode(float x, float y, float z, float& u, float& v)
+            {
+                const float l1 = std::abs(x) + std::abs(y) + std::abs(z);
+
+                if (l1 == 0.0f)
+                {
+                    u = 0.0f;
+                    v = 0.0f;
+                    return;
+                }
+
+                u = x / l1;
+                v = y / l1;
+
+                if (z < 0.0f)
+                {
+                    const float u0 = u;
+                    u = (1.0f - std::abs(v)) * sign_not_zero(u0);
+                    v = (1.0f - std::abs(u0)) * sign_not_zero(v);
+                }
+            }
+
+            //double, the candidates differ by less than the float epsilon
+            inline void octahedral_decode(double u, double v, double& x, double& y, double& z)
+            {
+                x = u;
+                y = v;
+                z = 1.0 - std::abs(u) - std::abs(v);
+
+                if (z < 0.0)
+                {
+                    const double x0 = x;
+                    x = (1.0 - std::abs(y)) * (x0 >= 0.0 ? 1.0 : -1.0);
+                    y = (1.0 - std::abs(x0)) * (y >= 0.0 ? 1.0 : -1.0);
+                }
+
+                const double l = std::sqrt(x * x + y * y + z * z);
+                x /= l;
+                y /= l;
+                z /= l;
+            }
+
+            //rounding each component alone is not the closest direction, try the four neighbours of the projected point
+            inline std::array<int16_t, 2> quantize_octahedral(float x, float y, float z)
+            {
+                float u;
+                float v;
+
+                octahedral_encode(x, y, z, u, v);
+
+                const float fu = std::floor(std::max(-1.0f, std::min(1.0f, u)) * 32767.0f);
+                const float fv = std::floor(std::max(-1.0f, std::min(1.0f, v)) * 32767.0f);
+
+                std::array<int16_t, 2> r = { quantize_snorm16(u), quantize_snorm16(v) };
+                double best = -std::numeric_limits<double>::max();
+
+                for (auto i = 0U; i < 4; ++i)
+                {
+                    const float cu = std::min(32767.0f, fu + static_cast<float>(i & 1));
+                    const float cv = std::min(32767.0f, fv + static_cast<float>(i >> 1));
+
+                    const int16_t qu = static_cast<int16_t>(cu);
+                    const int16_t qv = static_cast<int16_t>(cv);
+
+                    double dx;
+                    double dy;
+                    double dz;
+
+                    octahedral_decode(dequantize_snorm16(qu), dequantize_snorm16(qv), dx, dy, dz);
+
+                    const double d = dx * x + dy * y + dz * z;
+
+                    if (d > best)
+                    {
+                        best = d;
+                        r = { qu, qv };
+                    }
+                }
+
+                return r;
+            }
+
+            //renormalize, so the four bytes sum to 255 and the shader does not divide
+            inline std::array<uint8_t, 4> quantize_blend_weights(float x, float y, float z, float w)
+            {
+                const std::array<float, 4> f = { std::max(0.0f, x), std::max(0.0f, y), std::max(0.0f, z), std::max(0.0f, w) };
+                const float sum = f[0] + f[1] + f[2] + f[3];
+
+                if (sum == 0.0f)
+                {
+                    return { 255, 0, 0, 0 };
+                }
+
+                std::array<uint32_t, 4> r;
+                std::array<float, 4>    remainder;
+                uint32_t                total = 0;
+
+                for (auto i = 0U; i < 4; ++i)
+                {
+                    const float s   = f[i] / sum * 255.0f;
+                    r[i]            = static_cast<uint32_t>(s);
+                    remainder[i]    = s - static_cast<float>(r[i]);
+                    total          += r[i];
+                }
+
+                //largest remainder first
+                while (total < 255)
+                {
+                    auto m = std::max_element(remainder.begin(), remainder.end());
+                    auto k = static_cast<size_t>(m - remainder.begin());
+                    r[k]++;
+                    *m = -1.0f;
+                    total++;
+                }
+
+                return { static_cast<uint8_t>(r[0]), static_cast<uint8_t>(r[1]), static_cast<uint8_t>(r[2]), static_cast<uint8_t>(r[3]) };
+            }
+        }
+
+        struct position_bounds
+        {
+            std::array<float, 3> m_min;
+            std::array<float, 3> m_extent;
+        };
+
+        template <typename positions_t>
+        position_bounds make_position_bounds(const positions_t& positions)
+        {
+            const float v = std::numeric_limits<float>::max();
+            std::array<float, 3> mn = { v, v, v };
+            std::array<float, 3> mx = { -v, -v, -v };
+
+            for (auto&& i : positions)
+            {
+                mn[0] = std::min(mn[0], i.x);
+                mn[1] = std::min(mn[1], i.y);
+                mn[2] = std::min(mn[2], i.z);
+
+                mx[0] = std::max(mx[0], i.x);
+                mx[1] = std::max(mx[1], i.y);
+                mx[2] = std::max(mx[2], i.z);
+            }
+
+            if (positions.empty())
+            {
+                return { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+            }
+
+            return { mn, { mx[0] - mn[0], mx[1] - mn[1], mx[2] - mn[2] } };
+        }
+
+        template <typename t>
+        void copy_positions_packed(const std::vector< gx::import::geo::indexed_mesh::position >& positions, const position_bounds& b, t& out)
+        {
+            size_t vertex = 0;
+
+            auto quantize = [&b](float v, uint32_t axis)
+            {
+                return b.m_extent[axis] > 0.0f ? details::quantize_unorm16((v - b.m_min[axis]) / b.m_extent[axis]) : static_cast<uint16_t>(0);
+            };
+
+            for (auto&& i : positions)
+            {
+                out[vertex].m_x = quantize(i.x, 0);
+                out[vertex].m_y = quantize(i.y, 1);
+                out[vertex].m_z = quantize(i.z, 2);
+                out[vertex].m_w = 0;
+                vertex++;
+            }
+        }
+
+        template <typename t>
+        void copy_normals_packed(const std::vector< gx::import::geo::indexed_mesh::normal >& normals, t& out)
+        {
+            size_t vertex = 0;
+
+            for (auto&& i : normals)
+            {
+                auto q = details::quantize_octahedral(i.x, i.y, i.z);
+                out[vertex].m_x = q[0];
+                out[vertex].m_y = q[1];
+                vertex++;
+            }
+        }
+
+        template <typename t>
+        void copy_tangents_packed(const std::vector< gx::import::geo::indexed_mesh::tangent >& tangents, t& out)
+        {
+            size_t vertex = 0;
+
+            for (auto&& i : tangents)
+            {
+                auto q = details::quantize_octahedral(i.x, i.y, i.z);
+                out[vertex].m_x = q[0];
+                out[vertex].m_y = q[1];
+                vertex++;
+            }
+        }
+
+        template <typename t>
+        void copy_uv_packed(const std::vector< gx::import::geo::indexed_mesh::uv >& uv, t& out)
+        {
+            size_t vertex = 0;
+
+            for (auto&& i : uv)
+            {
+                out[vertex].m_x = math::convert_f32_f16(i.x);
+                out[vertex].m_y = math::convert_f32_f16(i.y);
+                vertex++;
+            }
+        }
+
+        template <typename t>
+        void copy_blend_weights_packed(const std::vector< gx::import::geo::skinned_mesh::blend_weight_t >& weight, t& out)
+        {
+            size_t vertex = 0;
+
+            for (auto&& i : weight)
+            {
+                auto q = details::quantize_blend_weights(i.x, i.y, i.z, i.w);
+                out[vertex].m_x = q[0];
+                out[vertex].m_y = q[1];
+                out[vertex].m_z = q[2];
+                out[vertex].m_w = q[3];
+                vertex++;
+            }
+        }
+
+    }
+}
+
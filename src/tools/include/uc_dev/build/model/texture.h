@@ -8,8 +8,8 @@
 #include <uc_dev/gx/lip/geo.h>
 
 
-#include "uc_model_exception.h"
-#include "uc_model_compressonator.h"
+#include <uc_dev/build/model/exception.h>
+#include <uc_dev/build/model/compressonator.h>
 
 namespace uc
 {
@@ -2,7 +2,7 @@
 
 #include <boost/program_options.hpp>
 
-#include "uc_skeleton_exception.h"
+#include <uc_dev/build/skeleton/exception.h>
 
 namespace uc
 {
@@ -19,6 +19,7 @@ namespace uc
                 ("help,?", "produce help message")
                 ("input_skeleton", po::value< std::string>(), "input skeleton")
                 ("output_skeleton", po::value< std::string>(), "output skeleton")
+                ("cache", po::value< std::string>(), "build cache directory, the build is skipped when the inputs, the options and the tool did not change")
                 ("swap_y_z", po::value< bool >(), "swaps y and z coordinates, suitable for some tools like 3ds max")
                 ("make_left_handed", po::value< bool >(), "swaps y and z coordinates, suitable for some tools like 3ds max");
                 
@@ -118,6 +119,17 @@ namespace uc
         {
             return get_bool_option(map, "make_left_handed");
         }
+
+        //empty, when the build cache is off
+        inline auto get_cache_directory(const boost::program_options::variables_map & map)
+        {
+            auto r = std::string();
+            if (get_value_present(map, "cache"))
+            {
+                r = get_input_value<std::string>(map, "cache", [] {});
+            }
+            return r;
+        }
     }
 }
 
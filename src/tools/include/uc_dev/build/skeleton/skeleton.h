@@ -278,6 +278,81 @@ namespace uc
             return std::make_tuple(linkages, linkage_map);
         }
 
+        //sphere around the vertices influenced by every joint in bind pose space. joints without vertices get a negative radius
+        inline lip::reloc_array < lip::joint_bounding_volume > joint_bounding_volumes(const gx::import::geo::skinned_mesh* mesh)
+        {
+            const auto joint_count = mesh->m_skeleton_pose.m_skeleton.m_joints.size();
+
+            std::vector< math::float4 > bounds_min;
+            std::vector< math::float4 > bounds_max;
+
+            bounds_min.resize(joint_count, math::splat(std::numeric_limits<float>::max()));
+            bounds_max.resize(joint_count, math::splat(-std::numeric_limits<float>::max()));
+
+            //visits every (vertex, joint) pair that has influence
+            auto for_each_influence = [mesh](auto&& f)
+            {
+                for (auto m = 0U; m < mesh->m_positions.size(); ++m)
+                {
+                    auto&& positions    = mesh->m_positions[m];
+                    auto&& weights      = mesh->m_blend_weights[m];
+                    auto&& indices      = mesh->m_blend_indices[m];
+
+                    for (auto i = 0U; i < positions.size(); ++i)
+                    {
+                        const float     w[4] = { weights[i].x, weights[i].y, weights[i].z, weights[i].w };
+                        const uint16_t  j[4] = { indices[i].x, indices[i].y, indices[i].z, indices[i].w };
+
+                        math::float4 p = math::point3(positions[i].x, positions[i].y, positions[i].z);
+
+                        for (auto k = 0U; k < 4; ++k)
+                        {
+                            if (w[k] > 0.0f)
+                            {
+                                f(j[k], p);
+                            }
+                        }
+                    }
+                }
+            };
+
+            for_each_influence([&bounds_min, &bounds_max](uint16_t joint, math::float4 p)
+            {
+                bounds_min[joint] = math::min(bounds_min[joint], p);
+                bounds_max[joint] = math::max(bounds_max[joint], p);
+            });
+
+            std::vector< math::float4 > centers;
+            std::vector< float >        radius;
+
+            centers.resize(joint_count);
+            radius.resize(joint_count, -1.0f);
+
+            for (auto i = 0U; i < joint_count; ++i)
+            {
+                centers[i] = math::mul(math::add(bounds_min[i], bounds_max[i]), 0.5f);
+            }
+
+            for_each_influence([&centers, &radius](uint16_t joint, math::float4 p)
+            {
+                radius[joint] = std::max(radius[joint], math::get_x(math::length3(math::sub(p, centers[joint]))));
+            });
+
+            lip::reloc_array < lip::joint_bounding_volume > r;
+
+            r.resize(joint_count);
+
+            for (auto i = 0U; i < joint_count; ++i)
+            {
+                r[i].m_center.m_x = math::get_x(centers[i]);
+                r[i].m_center.m_y = math::get_y(centers[i]);
+                r[i].m_center.m_z = math::get_z(centers[i]);
+                r[i].m_radius     = radius[i];
+            }
+
+            return r;
+        }
+
         inline std::unique_ptr< uc::lip::skeleton > skeleton(const gx::import::geo::skeleton_pose& pose, uint16_t locomotion_index = 0)
         {
             std::unique_ptr< uc::lip::skeleton > m = std::make_unique<uc::lip::skeleton>();
@@ -305,6 +380,13 @@ namespace uc
             return m;
         }
 
+        inline std::unique_ptr< uc::lip::skeleton > skeleton(const gx::import::geo::skinned_mesh* mesh, uint16_t locomotion_index = 0)
+        {
+            auto m = skeleton(mesh->m_skeleton_pose, locomotion_index);
+            m->m_joint_bounding_volumes = joint_bounding_volumes(mesh);
+            return m;
+        }
+
 
 
     }
@@ -2,11 +2,11 @@
 
 #include <boost/program_options.hpp>
 
-#include "uc_model_exception.h"
+#include <uc_dev/build/model/exception.h>
 
 namespace uc
 {
-    namespace model
+    namespace texture
     {
         inline auto build_option_description()
         {
@@ -22,6 +22,7 @@ namespace uc
                 ("input_texture,i", po::value< std::string>(), "input texture")
                 ("output_texture,o", po::value< std::string>(), "output texture")
                 ("texture_format", po::value< std::string>(), "texture format ( unknown, bc1_unorm, bc1_unorm_srgb, bc2_unorm, bc2_unorm_srgb, bc3_unorm, bc3_unorm_srgb, bc4_unorm, bc4_snorm, bc5_unorm, bc5_snorm )")
+                ("cache", po::value< std::string>(), "build cache directory, the build is skipped when the inputs, the options and the tool did not change")
                 ;
                 
             return desc;
@@ -75,7 +76,7 @@ namespace uc
         {
             return std::string( get_input_value< std::string > (map, "input_texture", [ ]
             {
-                raise_error<missing_input_exception>(missing_input_exception::missing_part::input_file_name);
+                model::raise_error<model::missing_input_exception>(model::missing_input_exception::missing_part::input_file_name);
             }));
         }
 
@@ -83,7 +84,7 @@ namespace uc
         {
             return std::string(get_input_value< std::string >(map, "output_texture", []
             {
-                raise_error<missing_input_exception>(missing_input_exception::missing_part::output_file_name);
+                model::raise_error<model::missing_input_exception>(model::missing_input_exception::missing_part::output_file_name);
             }));
         }
 
@@ -91,7 +92,7 @@ namespace uc
         {
             return std::string(get_input_value< std::string >(map, "texture_format", []
             {
-                raise_error<missing_input_exception>(missing_input_exception::missing_part::textures_formats);
+                model::raise_error<model::missing_input_exception>(model::missing_input_exception::missing_part::textures_formats);
             }));
         }
 
@@ -106,6 +107,16 @@ namespace uc
             return r;
         }
 
+        //empty, when the build cache is off
+        inline auto get_cache_directory(const boost::program_options::variables_map & map)
+        {
+            auto r = std::string();
+            if (get_value_present(map, "cache"))
+            {
+                r = get_input_value<std::string>(map, "cache", [] {});
+            }
+            return r;
+        }
     }
 }
 
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+//the texture converter, used by the texture tool and by the batch tool
+namespace uc
+{
+    namespace texture
+    {
+        void convert_texture( const std::string& input_file_name, const std::string& output_file_name, const std::string& texture_format );
+    }
+}
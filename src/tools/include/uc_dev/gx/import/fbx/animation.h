@@ -165,9 +165,9 @@ namespace uc
                     return mesh->GetDeformerCount(fbxsdk::FbxDeformer::eSkin) > 0;
                 }
 
-                inline std::vector<anm::joint_animations> create_animations(const std::string& file_name)
+                //the context can be reused by the other imports of the same file, one at a time
+                inline std::vector<anm::joint_animations> create_animations(const fbx_context* context)
                 {
-                    auto context    = load_fbx_file(file_name);
                     auto scene      = context->m_scene.get();
                     auto importer   = context->m_importer.get();
 
@@ -310,7 +310,7 @@ namespace uc
 
                             auto t                          = to_float4x4(transform);
                             
-                            auto t0                         = transform_from_dcc(t, context.get());
+                            auto t0                         = transform_from_dcc(t, context);
                             auto rot0                       = math::rotation(t0);
                             auto trans0                     = math::translation(t0);
                             
@@ -338,6 +338,12 @@ namespace uc
                     r.push_back(std::move(m));
                     return r;
                 }
+
+                inline std::vector<anm::joint_animations> create_animations(const std::string& file_name)
+                {
+                    auto context = load_fbx_file(file_name);
+                    return create_animations(context.get());
+                }
             }
         }
     }
@@ -28,9 +28,9 @@ namespace uc
                     return positions;
                 }
 
-                inline std::shared_ptr<geo::indexed_mesh> create_mesh(const std::string& file_name)
+                //adds the missing normals and tangents to the scene, so the context can be reused by the other imports of the same file, one at a time
+                inline std::shared_ptr<geo::indexed_mesh> create_mesh(fbx_context* context)
                 {
-                    auto context = load_fbx_file(file_name);
                     auto scene = context->m_scene.get();
 
                     fbxsdk::FbxMesh* mesh;
@@ -61,9 +61,15 @@ namespace uc
 
                     assert(mesh->GetPolygonSize(0));
 
-                    auto p = triangle_permutaion(context.get());
+                    auto p = triangle_permutaion(context);
+
+                    return std::make_shared<geo::indexed_mesh>(transform_dcc_positions(get_positions(mesh), context), get_uvs(mesh), get_faces(mesh, p));
+                }
 
-                    return std::make_shared<geo::indexed_mesh>(transform_dcc_positions(get_positions(mesh), context.get()), get_uvs(mesh), get_faces(mesh, p));
+                inline std::shared_ptr<geo::indexed_mesh> create_mesh(const std::string& file_name)
+                {
+                    auto context = load_fbx_file(file_name);
+                    return create_mesh(context.get());
                 }
             }
          }
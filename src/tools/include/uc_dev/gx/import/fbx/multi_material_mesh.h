@@ -118,9 +118,9 @@ namespace uc
                 }
 
                 //////////////////////
-                inline std::shared_ptr<geo::multi_material_mesh> create_multi_material_mesh(const std::string& file_name)
+                //adds the missing normals and tangents to the scene, so the context can be reused by the other imports of the same file, one at a time
+                inline std::shared_ptr<geo::multi_material_mesh> create_multi_material_mesh(fbx_context* context)
                 {
-                    auto context = load_fbx_file(file_name);
                     auto scene   = context->m_scene.get();
 
                     std::vector<fbxsdk::FbxMesh*> meshes;
@@ -146,7 +146,7 @@ namespace uc
                     std::vector<  std::shared_ptr<geo::multi_material_mesh> > multimeshes;
                     for (auto& m : meshes)
                     {
-                        multimeshes.push_back(create_multi_material_mesh_internal(m, context.get()));
+                        multimeshes.push_back(create_multi_material_mesh_internal(m, context));
                     }
 
                     //merge all multimaterial meshes into one
@@ -170,6 +170,12 @@ namespace uc
 
                     return std::make_shared<geo::multi_material_mesh>(std::move(pos), std::move(normals), std::move(tangents), std::move(uv), std::move(faces), std::move(mat));
                 }
+
+                inline std::shared_ptr<geo::multi_material_mesh> create_multi_material_mesh(const std::string& file_name)
+                {
+                    auto context = load_fbx_file(file_name);
+                    return create_multi_material_mesh(context.get());
+                }
             }
         }
     }
@@ -832,9 +832,9 @@ namespace uc
 
 
                 //////////////////////
-                inline std::shared_ptr<geo::skinned_mesh> create_skinned_mesh(const std::string& file_name)
+                //adds the missing normals and tangents to the scene, so the context can be reused by the other imports of the same file, one at a time
+                inline std::shared_ptr<geo::skinned_mesh> create_skinned_mesh(fbx_context* context)
                 {
-                    auto context    = load_fbx_file(file_name);
                     auto scene      = context->m_scene.get();
 
                     std::vector<fbxsdk::FbxMesh*> meshes;
@@ -863,7 +863,7 @@ namespace uc
                         //skip meshes without skin and import only the first one
                         if (is_skinned_mesh(m) && multimeshes.empty())
                         {
-                            multimeshes.push_back(create_skinned_mesh_internal(m, context.get()));
+                            multimeshes.push_back(create_skinned_mesh_internal(m, context));
                             break;
                         }
                     }
@@ -955,6 +955,12 @@ namespace uc
                         std::move(blend_indices),
                         std::move(pose));
                 }
+
+                inline std::shared_ptr<geo::skinned_mesh> create_skinned_mesh(const std::string& file_name)
+                {
+                    auto context = load_fbx_file(file_name);
+                    return create_skinned_mesh(context.get());
+                }
             }
         }
     }
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include <uc_dev/math/math.h>
+#include <uc_dev/gx/import/geo/mesh_weld.h>
 
 namespace uc
 {
@@ -360,61 +361,36 @@ namespace uc
 
                     void clean_degenerate_faces()
                     {
-                        std::vector< face > faces(m_faces.size());
-
-                        auto last = std::copy_if(m_faces.begin(), m_faces.end(), faces.begin(), [=](const face& f)
-                        {
-                            return (f.v0 != f.v1 && f.v0 != f.v2 && f.v1 != f.v2);
-                        });
-
-                        faces.resize(std::distance(faces.begin(), last));
-                        m_faces = std::move(faces);
+                        remove_degenerate_faces(m_faces);
                     }
 
                     void build_normals()
                     {
-                        std::vector< normal > normals(m_positions.size());
-
-                        auto face_size = m_faces.size();
+                        m_normals = build_vertex_normals<normal>(m_positions, m_faces);
+                    }
 
-                        for (uint32_t i = 0; i < face_size; ++i)
+                    //merges vertices closer than epsilon with the same uv and tangents, then drops the faces, which collapsed or repeat
+                    //the normals are rebuilt, they depend on the faces
+                    void weld(float epsilon = 0.0f)
+                    {
+                        auto w = weld_vertices(m_positions, epsilon, [this](uint32_t a, uint32_t b)
                         {
-                            auto i0 = m_faces[i].v0;
-                            auto i1 = m_faces[i].v1;
-                            auto i2 = m_faces[i].v2;
-
-                            math::float4 v0 = math::load3u_point(&m_positions[i0]);
-                            math::float4 v1 = math::load3u_point(&m_positions[i1]);
-                            math::float4 v2 = math::load3u_point(&m_positions[i2]);
-
-                            math::float4 n = math::cross3(math::sub(v0, v1), math::sub(v1, v2));
-
-                            math::float4 n0 = math::load3u_vector(&normals[i0]);
-                            math::float4 n1 = math::load3u_vector(&normals[i1]);
-                            math::float4 n2 = math::load3u_vector(&normals[i2]);
-
-                            n0 = math::add(n0, n);
-                            n1 = math::add(n1, n);
-                            n2 = math::add(n2, n);
-
-                            math::store3u_point(&normals[i0], n0);
-                            math::store3u_point(&normals[i1], n1);
-                            math::store3u_point(&normals[i2], n2);
-
-                        }
+                            return (m_uv.empty() || m_uv[a] == m_uv[b]) && (m_tangents.empty() || m_tangents[a] == m_tangents[b]);
+                        });
 
-                        std::transform(normals.begin(), normals.end(), normals.begin(), [=](normal& n0)
-                        {
-                            math::float4 n  = math::load3u_vector(&n0);
-                            math::float4 n1 = math::normalize3(n);
+                        apply_weld(m_positions, w);
+                        apply_weld(m_uv, w);
+                        apply_weld(m_tangents, w);
+                        apply_weld_faces(m_faces, w);
 
-                            normal result;
+                        clean_degenerate_faces();
+                        clean_duplicate_faces();
 
-                            math::store3u_vector(&result, n1);
-                            return result;
-                        });
+                        //the half edges point to the old faces
+                        m_edges_storage.clear();
+                        m_edges.clear();
 
-                        m_normals = std::move(normals);
+                        build_normals();
                     }
 
                     void clear_positions_not_referenced_by_faces()
@@ -424,53 +400,7 @@ namespace uc
 
                     void clean_duplicate_faces()
                     {
-                        struct equal_faces
-                        {
-                            struct hash_function
-                            {
-                                uint64_t operator() (const face f) const
-                                {
-                                    return (((uint64_t)f.v0) << 42UL) | (((uint64_t)f.v1) << 21UL) | f.v2;
-                                }
-                            };
-
-                            static inline face permutation(face f)
-                            {
-                                face r;
-                                r.v0 = f.v2;
-                                r.v1 = f.v0;
-                                r.v2 = f.v1;
-                                return r;
-                            }
-
-                            bool operator()(face f0, face f1) const
-                            {
-                                face p0 = f1;
-                                face p1 = permutation(f1);
-                                face p2 = permutation(p1);
-
-                                return (f0 == p0 || f0 == p1 || f0 == p2);
-                            }
-                        };
-
-                        std::unordered_set< face, equal_faces::hash_function, equal_faces > unique_faces;
-
-                        for ( auto&& f : m_faces )
-                        {
-                            face f0 = f;
-
-                            if (unique_faces.find(f0) == unique_faces.end())
-                            {
-                                unique_faces.insert(f0);
-                            }
-                        }
-
-                        std::vector< indexed_mesh::face> faces;
-                        faces.resize(unique_faces.size());
-
-                        std::copy(unique_faces.begin(), unique_faces.end(), faces.begin());
-
-                        m_faces = std::move(faces);
+                        remove_duplicate_faces(m_faces);
                     }
                 };
 
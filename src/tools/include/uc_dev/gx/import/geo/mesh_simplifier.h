@@ -0,0 +1,548 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <uc_dev/gx/import/geo/indexed_mesh.h>
+#include <uc_dev/gx/import/geo/multi_material_mesh.h>
+#include <uc_dev/gx/import/geo/skinned_mesh.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace import
+        {
+            namespace geo
+            {
+                struct lod_range
+                {
+                    uint32_t m_begin = 0;
+                    uint32_t m_end   = 0;
+                };
+
+                struct lod_level
+                {
+                    std::vector<face>       m_faces;
+                    std::vector<lod_range>  m_ranges;           //in faces, one per range of the source mesh
+                    double                  m_error = 0.0;      //largest collapse error, in model units
+                };
+
+                struct lod_options
+                {
+                    uint32_t m_level_count  = 3;                //levels besides the source mesh
+                    double   m_reduction    = 0.5;              //triangles of a level over the triangles of the previous one
+                    double   m_min_reduction= 0.9;              //stop the chain, when a level cannot get below this
+                };
+
+                struct lod_chain
+                {
+                    std::vector<lod_level>  m_levels;           //coarser levels, the source mesh is level 0
+                };
+
+                namespace details
+                {
+                    //plane quadric, the error of a point is the area weighted sum of squared distances to the planes of the collapsed triangles
+                    struct quadric
+                    {
+                        double m_a00 = 0.0, m_a01 = 0.0, m_a02 = 0.0, m_a11 = 0.0, m_a12 = 0.0, m_a22 = 0.0;
+                        double m_b0  = 0.0, m_b1  = 0.0, m_b2  = 0.0;
+                        double m_c   = 0.0;
+                        double m_w   = 0.0;
+
+                        void add_plane(double nx, double ny, double nz, double d, double w)
+                        {
+                            m_a00 += w * nx * nx; m_a01 += w * nx * ny; m_a02 += w * nx * nz;
+                            m_a11 += w * ny * ny; m_a12 += w * ny * nz; m_a22 += w * nz * nz;
+                            m_b0  += w * nx * d;  m_b1  += w * ny * d;  m_b2  += w * nz * d;
+                            m_c   += w * d * d;
+                            m_w   += w;
+                        }
+
+                        void add(const quadric& q)
+                        {
+                            m_a00 += q.m_a00; m_a01 += q.m_a01; m_a02 += q.m_a02;
+                            m_a11 += q.m_a11; m_a12 += q.m_a12; m_a22 += q.m_a22;
+                            m_b0  += q.m_b0;  m_b1  += q.m_b1;  m_b2  += q.m_b2;
+                            m_c   += q.m_c;
+                            m_w   += q.m_w;
+                        }
+
+                        //mean squared distance
+                        double error(double x, double y, double z) const
+                        {
+                            double r = m_a00 * x * x + m_a11 * y * y + m_a22 * z * z
+                                + 2.0 * (m_a01 * x * y + m_a02 * x * z + m_a12 * y * z)
+                                + 2.0 * (m_b0 * x + m_b1 * y + m_b2 * z)
+                                + m_c;
+
+                            return m_w > 0.0 ? std::max(0.0, r) / m_w : 0.0;
+                        }
+                    };
+
+                    inline quadric operator+(const quadric& a, const quadric& b)
+                    {
+                        quadric r = a;
+                        r.add(b);
+                        return r;
+                    }
+
+                    using simplify_vector3 = std::array<double, 3>;
+
+                    template <typename position_t>
+                    inline simplify_vector3 simplify_position(const position_t& p)
+                    {
+                        return { static_cast<double>(p.x), static_cast<double>(p.y), static_cast<double>(p.z) };
+                    }
+
+                    inline simplify_vector3 triangle_normal(const simplify_vector3& p0, const simplify_vector3& p1, const simplify_vector3& p2)
+                    {
+                        simplify_vector3 u = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+                        simplify_vector3 v = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+                        return { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+                    }
+
+                    inline double dot(const simplify_vector3& a, const simplify_vector3& b)
+                    {
+                        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+                    }
+
+                    inline uint64_t edge_key(uint32_t a, uint32_t b)
+                    {
+                        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+                    }
+
+                    struct position_key_hash
+                    {
+                        size_t operator()(const std::array<uint32_t, 3>& k) const
+                        {
+                            return (k[0] * 73856093U) ^ (k[1] * 19349663U) ^ (k[2] * 83492791U);
+                        }
+                    };
+
+                    //vertices, which can not move without tearing the mesh: borders, non manifold edges and seams
+                    //uv, normal and skin weight seams are vertices with the same position, their edges are borders in the index space
+                    template <typename position_t>
+                    inline std::vector<uint8_t> locked_vertices(const std::vector<face>& faces, const std::vector<position_t>& positions)
+                    {
+                        std::vector<uint8_t> r(positions.size(), 0);
+
+                        std::unordered_map<uint64_t, uint32_t> edges;
+                        edges.reserve(faces.size() * 3);
+
+                        for (auto&& f : faces)
+                        {
+                            edges[edge_key(f.v0, f.v1)]++;
+                            edges[edge_key(f.v1, f.v2)]++;
+                            edges[edge_key(f.v2, f.v0)]++;
+                        }
+
+                        for (auto&& e : edges)
+                        {
+                            if (e.second != 2)
+                            {
+                                r[static_cast<uint32_t>(e.first >> 32)] = 1;
+                                r[static_cast<uint32_t>(e.first & 0xFFFFFFFF)] = 1;
+                            }
+                        }
+
+                        std::unordered_map<std::array<uint32_t, 3>, uint32_t, position_key_hash> unique;
+                        unique.reserve(positions.size());
+
+                        for (auto&& f : faces)
+                        {
+                            for (auto v : { f.v0, f.v1, f.v2 })
+                            {
+                                std::array<uint32_t, 3> k;
+                                std::memcpy(&k[0], &positions[v].x, sizeof(float));
+                                std::memcpy(&k[1], &positions[v].y, sizeof(float));
+                                std::memcpy(&k[2], &positions[v].z, sizeof(float));
+
+                                auto it = unique.insert(std::make_pair(k, v));
+
+                                if (!it.second && it.first->second != v)
+                                {
+                                    r[v] = 1;
+                                    r[it.first->second] = 1;
+                                }
+                            }
+                        }
+
+                        return r;
+                    }
+
+                    struct collapse
+                    {
+                        double   m_error;
+                        uint32_t m_from;
+                        uint32_t m_to;
+                    };
+
+                    //vertex to face adjacency of the live faces, in compressed rows
+                    struct face_adjacency
+                    {
+                        std::vector<uint32_t> m_offsets;
+                        std::vector<uint32_t> m_faces;
+
+                        void build(const std::vector<face>& faces, size_t vertex_count)
+                        {
+                            m_offsets.assign(vertex_count + 1, 0);
+
+                            for (auto&& f : faces)
+                            {
+                                m_offsets[f.v0 + 1]++;
+                                m_offsets[f.v1 + 1]++;
+                                m_offsets[f.v2 + 1]++;
+                            }
+
+                            for (auto i = 0U; i < vertex_count; ++i)
+                            {
+                                m_offsets[i + 1] += m_offsets[i];
+                            }
+
+                            m_faces.resize(m_offsets[vertex_count]);
+
+                            std::vector<uint32_t> fill(m_offsets.begin(), m_offsets.end() - 1);
+
+                            for (auto i = 0U; i < faces.size(); ++i)
+                            {
+                                m_faces[fill[faces[i].v0]++] = i;
+                                m_faces[fill[faces[i].v1]++] = i;
+                                m_faces[fill[faces[i].v2]++] = i;
+                            }
+                        }
+                    };
+
+                    inline bool has_vertex(const face& f, uint32_t v)
+                    {
+                        return f.v0 == v || f.v1 == v || f.v2 == v;
+                    }
+
+                    //the link condition keeps the mesh manifold, the common neighbours of the edge vertices must be the opposite vertices of the edge faces
+                    inline bool can_collapse_topology(const std::vector<face>& faces, const face_adjacency& adjacency, uint32_t a, uint32_t b, std::vector<uint32_t>& scratch)
+                    {
+                        scratch.clear();
+
+                        uint32_t shared_faces = 0;
+
+                        for (auto i = adjacency.m_offsets[a]; i < adjacency.m_offsets[a + 1]; ++i)
+                        {
+                            const face& f = faces[adjacency.m_faces[i]];
+
+                            if (has_vertex(f, b))
+                            {
+                                shared_faces++;
+                            }
+
+                            for (auto v : { f.v0, f.v1, f.v2 })
+                            {
+                                if (v != a && v != b)
+                                {
+                                    scratch.push_back(v);
+                                }
+                            }
+                        }
+
+                        std::sort(scratch.begin(), scratch.end());
+                        scratch.erase(std::unique(scratch.begin(), scratch.end()), scratch.end());
+
+                        uint32_t common = 0;
+                        const auto  size = scratch.size();
+
+                        for (auto i = adjacency.m_offsets[b]; i < adjacency.m_offsets[b + 1]; ++i)
+                        {
+                            const face& f = faces[adjacency.m_faces[i]];
+
+                            for (auto v : { f.v0, f.v1, f.v2 })
+                            {
+                                if (v != a && v != b && std::binary_search(scratch.begin(), scratch.begin() + size, v))
+                                {
+                                    scratch.push_back(v);
+                                }
+                            }
+                        }
+
+                        std::sort(scratch.begin() + size, scratch.end());
+                        common = static_cast<uint32_t>(std::unique(scratch.begin() + size, scratch.end()) - (scratch.begin() + size));
+
+                        return shared_faces > 0 && common == shared_faces;
+                    }
+
+                    //moving a onto b must not flip or squash the faces, which stay
+                    template <typename position_t>
+                    inline bool can_collapse_geometry(const std::vector<face>& faces, const face_adjacency& adjacency, const std::vector<position_t>& positions, uint32_t a, uint32_t b)
+                    {
+                        const simplify_vector3 pb = simplify_position(positions[b]);
+
+                        for (auto i = adjacency.m_offsets[a]; i < adjacency.m_offsets[a + 1]; ++i)
+                        {
+                            const face& f = faces[adjacency.m_faces[i]];
+
+                            if (has_vertex(f, b))
+                            {
+                                continue;
+                            }
+
+                            simplify_vector3 p[3]   = { simplify_position(positions[f.v0]), simplify_position(positions[f.v1]), simplify_position(positions[f.v2]) };
+                            simplify_vector3 n0     = triangle_normal(p[0], p[1], p[2]);
+
+                            p[0] = f.v0 == a ? pb : p[0];
+                            p[1] = f.v1 == a ? pb : p[1];
+                            p[2] = f.v2 == a ? pb : p[2];
+
+                            simplify_vector3 n1     = triangle_normal(p[0], p[1], p[2]);
+
+                            //reject flips and turns of more than ~75 degrees
+                            double l = std::sqrt(dot(n0, n0) * dot(n1, n1));
+                            if (l <= 0.0 || dot(n0, n1) < 0.25 * l)
+                            {
+                                return false;
+                            }
+                        }
+
+                        return true;
+                    }
+                }
+
+                //edge collapse simplification, vertices only move onto their neighbours, so every attribute stays exact
+                //locked vertices (borders, seams) never move, which keeps uv and skin weight seams intact
+                //faces is a range of a mesh, returns the simplified faces and the largest collapse error
+                template <typename position_t>
+                inline std::vector<face> simplify(const std::vector<face>& faces, const std::vector<position_t>& positions, size_t target_face_count, double* out_error = nullptr)
+                {
+                    using namespace details;
+
+                    std::vector<face>    r = faces;
+                    std::vector<uint8_t> locked = locked_vertices(faces, positions);
+                    std::vector<quadric> quadrics(positions.size());
+
+                    for (auto&& f : faces)
+                    {
+                        auto p0 = simplify_position(positions[f.v0]);
+                        auto p1 = simplify_position(positions[f.v1]);
+                        auto p2 = simplify_position(positions[f.v2]);
+                        auto n  = triangle_normal(p0, p1, p2);
+                        auto l  = std::sqrt(dot(n, n));
+
+                        if (l > 0.0)
+                        {
+                            double area = l * 0.5;
+                            n = { n[0] / l, n[1] / l, n[2] / l };
+
+                            double d = -dot(n, p0);
+
+                            quadrics[f.v0].add_plane(n[0], n[1], n[2], d, area);
+                            quadrics[f.v1].add_plane(n[0], n[1], n[2], d, area);
+                            quadrics[f.v2].add_plane(n[0], n[1], n[2], d, area);
+                        }
+                    }
+
+                    double                      max_error = 0.0;
+                    face_adjacency              adjacency;
+                    std::vector<collapse>       collapses;
+                    std::vector<uint8_t>        dirty(positions.size());
+                    std::vector<uint32_t>       scratch;
+                    std::vector<uint8_t>        dead;
+
+                    while (r.size() > target_face_count)
+                    {
+                        adjacency.build(r, positions.size());
+
+                        collapses.clear();
+
+                        for (auto&& f : r)
+                        {
+                            const uint32_t v[3] = { f.v0, f.v1, f.v2 };
+
+                            for (auto k = 0U; k < 3; ++k)
+                            {
+                                uint32_t a = v[k];
+                                uint32_t b = v[(k + 1) % 3];
+
+                                for (auto e = 0U; e < 2; ++e, std::swap(a, b))
+                                {
+                                    if (!locked[a] && a != b)
+                                    {
+                                        auto p = simplify_position(positions[b]);
+                                        collapses.push_back({ (quadrics[a] + quadrics[b]).error(p[0], p[1], p[2]), a, b });
+                                    }
+                                }
+                            }
+                        }
+
+                        if (collapses.empty())
+                        {
+                            break;
+                        }
+
+                        std::sort(collapses.begin(), collapses.end(), [](const collapse& x, const collapse& y)
+                        {
+                            return x.m_error < y.m_error;
+                        });
+
+                        std::fill(dirty.begin(), dirty.end(), static_cast<uint8_t>(0));
+                        dead.assign(r.size(), 0);
+
+                        size_t      live        = r.size();
+                        uint32_t    performed   = 0;
+
+                        //collapse the cheapest third of the candidates per pass, touching every neighbourhood once, so the costs stay valid
+                        const size_t pass_limit = std::max<size_t>(1, collapses.size() / 3);
+
+                        for (auto i = 0U; i < pass_limit && live > target_face_count; ++i)
+                        {
+                            const collapse& c = collapses[i];
+
+                            if (dirty[c.m_from] || dirty[c.m_to])
+                            {
+                                continue;
+                            }
+
+                            if (!can_collapse_topology(r, adjacency, c.m_from, c.m_to, scratch) || !can_collapse_geometry(r, adjacency, positions, c.m_from, c.m_to))
+                            {
+                                continue;
+                            }
+
+                            for (auto j = adjacency.m_offsets[c.m_from]; j < adjacency.m_offsets[c.m_from + 1]; ++j)
+                            {
+                                const uint32_t fi   = adjacency.m_faces[j];
+                                face&          f    = r[fi];
+
+                                dirty[f.v0] = 1;
+                                dirty[f.v1] = 1;
+                                dirty[f.v2] = 1;
+
+                                if (has_vertex(f, c.m_to))
+                                {
+                                    dead[fi] = 1;
+                                    live--;
+                                }
+                                else
+                                {
+                                    f.v0 = f.v0 == c.m_from ? c.m_to : f.v0;
+                                    f.v1 = f.v1 == c.m_from ? c.m_to : f.v1;
+                                    f.v2 = f.v2 == c.m_from ? c.m_to : f.v2;
+                                }
+                            }
+
+                            quadrics[c.m_to].add(quadrics[c.m_from]);
+                            max_error = std::max(max_error, c.m_error);
+                            performed++;
+                        }
+
+                        if (performed == 0)
+                        {
+                            break;
+                        }
+
+                        size_t n = 0;
+                        for (auto i = 0U; i < r.size(); ++i)
+                        {
+                            if (!dead[i])
+                            {
+                                r[n++] = r[i];
+                            }
+                        }
+
+                        r.resize(n);
+                    }
+
+                    if (out_error)
+                    {
+                        *out_error = std::sqrt(max_error);
+                    }
+
+                    return r;
+                }
+
+                //every level simplifies the previous one, every range separately, so the materials stay apart
+                template <typename position_t, typename range_t>
+                inline lod_chain build_lod_chain(const std::vector<face>& faces, const std::vector<position_t>& positions, const std::vector<range_t>& ranges, const lod_options& options = lod_options())
+                {
+                    lod_chain r;
+
+                    lod_level previous;
+                    previous.m_faces = faces;
+
+                    for (auto&& range : ranges)
+                    {
+                        lod_range lr;
+                        lr.m_begin = range.m_begin;
+                        lr.m_end   = range.m_end;
+                        previous.m_ranges.push_back(lr);
+                    }
+
+                    for (auto level = 0U; level < options.m_level_count; ++level)
+                    {
+                        lod_level l;
+                        l.m_error = previous.m_error;
+
+                        for (auto&& range : previous.m_ranges)
+                        {
+                            std::vector<face> source(previous.m_faces.begin() + range.m_begin, previous.m_faces.begin() + range.m_end);
+
+                            const size_t target = static_cast<size_t>(static_cast<double>(source.size()) * options.m_reduction);
+
+                            double error = 0.0;
+                            auto simplified = simplify(source, positions, target, &error);
+
+                            lod_range lr;
+                            lr.m_begin = static_cast<uint32_t>(l.m_faces.size());
+                            l.m_faces.insert(l.m_faces.end(), simplified.begin(), simplified.end());
+                            lr.m_end   = static_cast<uint32_t>(l.m_faces.size());
+
+                            l.m_ranges.push_back(lr);
+
+                            //errors of the levels accumulate
+                            l.m_error = std::max(l.m_error, previous.m_error + error);
+                        }
+
+                        if (static_cast<double>(l.m_faces.size()) > static_cast<double>(previous.m_faces.size()) * options.m_min_reduction)
+                        {
+                            break;
+                        }
+
+                        r.m_levels.push_back(l);
+                        previous = std::move(l);
+                    }
+
+                    return r;
+                }
+
+                inline lod_chain build_lod_chain(const indexed_mesh* m, const lod_options& options = lod_options())
+                {
+                    std::vector<lod_range> ranges(1);
+                    ranges[0].m_end = static_cast<uint32_t>(m->m_faces.size());
+                    return build_lod_chain(m->m_faces, m->m_positions, ranges, options);
+                }
+
+                //one chain per material, every material has its own vertices
+                inline std::vector<lod_chain> build_lod_chain(const multi_material_mesh* m, const lod_options& options = lod_options())
+                {
+                    std::vector<lod_chain> r;
+                    r.reserve(m->m_faces.size());
+
+                    for (auto i = 0U; i < m->m_faces.size(); ++i)
+                    {
+                        std::vector<lod_range> ranges(1);
+                        ranges[0].m_end = static_cast<uint32_t>(m->m_faces[i].size());
+                        r.push_back(build_lod_chain(m->m_faces[i], m->m_positions[i], ranges, options));
+                    }
+
+                    return r;
+                }
+
+                inline std::vector<lod_chain> build_lod_chain(const skinned_mesh* m, const lod_options& options = lod_options())
+                {
+                    return build_lod_chain(static_cast<const multi_material_mesh*>(m), options);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,674 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <ppl.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace import
+        {
+            namespace geo
+            {
+                namespace parallel
+                {
+                    const size_t default_block_size = 16384;
+
+                    //splits [0, count) into blocks, f(block, begin, end) runs once per block on the concurrency runtime
+                    template <typename function_t>
+                    inline void for_each_block(size_t count, size_t block_size, function_t&& f)
+                    {
+                        const size_t block_count = (count + block_size - 1) / block_size;
+
+                        if (block_count <= 1)
+                        {
+                            if (count > 0)
+                            {
+                                f(size_t(0), size_t(0), count);
+                            }
+                            return;
+                        }
+
+                        concurrency::parallel_for(size_t(0), block_count, [&f, block_size, count](size_t b)
+                        {
+                            f(b, b * block_size, std::min(count, (b + 1) * block_size));
+                        });
+                    }
+
+                    //at most 64 blocks, so the per block histograms stay small
+                    inline size_t block_size(size_t count)
+                    {
+                        return std::max(default_block_size, count / 64 + 1);
+                    }
+
+                    //stable lsd radix sort of 64 bit keys with 32 bit payloads, 8 bits per pass
+                    //passes, where all keys have the same digit, are skipped, so small keys sort in few passes
+                    inline void radix_sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values)
+                    {
+                        const size_t count          = keys.size();
+                        const size_t size           = block_size(count);
+                        const size_t block_count    = (count + size - 1) / size;
+
+                        std::vector<uint64_t>                   keys_scratch(count);
+                        std::vector<uint32_t>                   values_scratch(count);
+                        std::vector<std::array<size_t, 256>>    histograms(std::max<size_t>(block_count, 1));
+
+                        for (uint32_t shift = 0; shift < 64; shift += 8)
+                        {
+                            for_each_block(count, size, [&keys, &histograms, shift](size_t b, size_t begin, size_t end)
+                            {
+                                auto&& h = histograms[b];
+                                h.fill(0);
+
+                                for (auto i = begin; i < end; ++i)
+                                {
+                                    h[(keys[i] >> shift) & 0xFF]++;
+                                }
+                            });
+
+                            std::array<size_t, 256> totals = {};
+
+                            for (auto b = 0U; b < block_count; ++b)
+                            {
+                                for (auto d = 0U; d < 256; ++d)
+                                {
+                                    totals[d] += histograms[b][d];
+                                }
+                            }
+
+                            if (std::any_of(totals.begin(), totals.end(), [count](size_t t) { return t == count; }))
+                            {
+                                continue;
+                            }
+
+                            //digit major, block minor offsets keep the sort stable
+                            size_t offset = 0;
+                            for (auto d = 0U; d < 256; ++d)
+                            {
+                                for (auto b = 0U; b < block_count; ++b)
+                                {
+                                    size_t c            = histograms[b][d];
+                                    histograms[b][d]    = offset;
+                                    offset             += c;
+                                }
+                            }
+
+                            for_each_block(count, size, [&keys, &values, &keys_scratch, &values_scratch, &histograms, shift](size_t b, size_t begin, size_t end)
+                            {
+                                auto&& h = histograms[b];
+
+                                for (auto i = begin; i < end; ++i)
+                                {
+                                    size_t o            = h[(keys[i] >> shift) & 0xFF]++;
+                                    keys_scratch[o]     = keys[i];
+                                    values_scratch[o]   = values[i];
+                                }
+                            });
+
+                            std::swap(keys, keys_scratch);
+                            std::swap(values, values_scratch);
+                        }
+                    }
+
+                    //keeps the elements, for which keep(index) is true, in their order
+                    template <typename t, typename predicate_t>
+                    inline void keep_if(std::vector<t>& v, predicate_t&& keep)
+                    {
+                        const size_t count          = v.size();
+                        const size_t size           = block_size(count);
+                        const size_t block_count    = (count + size - 1) / size;
+
+                        std::vector<size_t> offsets(block_count + 1, 0);
+
+                        for_each_block(count, size, [&offsets, &keep](size_t b, size_t begin, size_t end)
+                        {
+                            size_t c = 0;
+                            for (auto i = begin; i < end; ++i)
+                            {
+                                c += keep(i) ? 1 : 0;
+                            }
+                            offsets[b + 1] = c;
+                        });
+
+                        for (auto b = 0U; b < block_count; ++b)
+                        {
+                            offsets[b + 1] += offsets[b];
+                        }
+
+                        std::vector<t> r(offsets[block_count]);
+
+                        for_each_block(count, size, [&offsets, &keep, &v, &r](size_t b, size_t begin, size_t end)
+                        {
+                            size_t o = offsets[b];
+                            for (auto i = begin; i < end; ++i)
+                            {
+                                if (keep(i))
+                                {
+                                    r[o++] = v[i];
+                                }
+                            }
+                        });
+
+                        v = std::move(r);
+                    }
+
+                    inline uint64_t mix(uint64_t k)
+                    {
+                        k ^= k >> 33;
+                        k *= 0xff51afd7ed558ccdULL;
+                        k ^= k >> 33;
+                        k *= 0xc4ceb9fe1a85ec53ULL;
+                        k ^= k >> 33;
+                        return k;
+                    }
+
+                    static const uint32_t null_value = 0xFFFFFFFF;
+
+                    //open addressing with linear probing, filled once, then read from many threads
+                    class flat_hash_table
+                    {
+                        public:
+
+                        explicit flat_hash_table(size_t count)
+                        {
+                            size_t capacity = 16;
+                            while (capacity < count * 2)
+                            {
+                                capacity *= 2;
+                            }
+
+                            m_mask = capacity - 1;
+                            m_keys.resize(capacity);
+                            m_values.resize(capacity, null_value);
+                        }
+
+                        void insert(uint64_t key, uint32_t value)
+                        {
+                            for (size_t i = mix(key) & m_mask;; i = (i + 1) & m_mask)
+                            {
+                                if (m_values[i] == null_value)
+                                {
+                                    m_keys[i]   = key;
+                                    m_values[i] = value;
+                                    return;
+                                }
+
+                                if (m_keys[i] == key)
+                                {
+                                    return;
+                                }
+                            }
+                        }
+
+                        uint32_t find(uint64_t key) const
+                        {
+                            for (size_t i = mix(key) & m_mask;; i = (i + 1) & m_mask)
+                            {
+                                if (m_values[i] == null_value || m_keys[i] == key)
+                                {
+                                    return m_values[i];
+                                }
+                            }
+                        }
+
+                        private:
+
+                        size_t                  m_mask;
+                        std::vector<uint64_t>   m_keys;
+                        std::vector<uint32_t>   m_values;
+                    };
+
+                    //vertex to face adjacency in compressed rows, the faces of a vertex are in ascending order
+                    struct vertex_faces
+                    {
+                        std::vector<uint32_t> m_offsets;
+                        std::vector<uint32_t> m_faces;
+                    };
+
+                    template <typename face_t>
+                    inline vertex_faces build_vertex_faces(const std::vector<face_t>& faces, size_t vertex_count)
+                    {
+                        const size_t corner_count = faces.size() * 3;
+
+                        std::vector<uint64_t> keys(corner_count);
+                        vertex_faces          r;
+
+                        r.m_faces.resize(corner_count);
+                        r.m_offsets.resize(vertex_count + 1);
+
+                        for_each_block(faces.size(), block_size(faces.size()), [&faces, &keys, &r](size_t, size_t begin, size_t end)
+                        {
+                            for (auto i = begin; i < end; ++i)
+                            {
+                                keys[i * 3 + 0] = faces[i].v0;
+                                keys[i * 3 + 1] = faces[i].v1;
+                                keys[i * 3 + 2] = faces[i].v2;
+
+                                r.m_faces[i * 3 + 0] = static_cast<uint32_t>(i);
+                                r.m_faces[i * 3 + 1] = static_cast<uint32_t>(i);
+                                r.m_faces[i * 3 + 2] = static_cast<uint32_t>(i);
+                            }
+                        });
+
+                        radix_sort(keys, r.m_faces);
+
+                        //every offset is written once, by the corner where its vertex starts
+                        for_each_block(corner_count, block_size(corner_count), [&keys, &r](size_t, size_t begin, size_t end)
+                        {
+                            for (auto i = begin; i < end; ++i)
+                            {
+                                if (i == 0 || keys[i] != keys[i - 1])
+                                {
+                                    //vertices without faces start, where the next used vertex starts
+                                    for (auto v = i == 0 ? 0 : keys[i - 1] + 1; v <= keys[i]; ++v)
+                                    {
+                                        r.m_offsets[v] = static_cast<uint32_t>(i);
+                                    }
+                                }
+                            }
+                        });
+
+                        const uint64_t last = corner_count == 0 ? 0 : keys[corner_count - 1] + 1;
+                        for (auto v = last; v <= vertex_count; ++v)
+                        {
+                            r.m_offsets[v] = static_cast<uint32_t>(corner_count);
+                        }
+
+                        return r;
+                    }
+                }
+
+                //old to new vertex indices of a weld, m_source is the old vertex, which every new vertex copies
+                struct vertex_weld
+                {
+                    std::vector<uint32_t> m_remap;
+                    std::vector<uint32_t> m_source;
+                };
+
+                namespace details
+                {
+                    //grid cell of a position, with epsilon 0 the cell is the exact bit pattern
+                    template <typename position_t>
+                    inline std::array<int32_t, 3> weld_cell(const position_t& p, float inverse_epsilon)
+                    {
+                        std::array<int32_t, 3> r;
+
+                        if (inverse_epsilon > 0.0f)
+                        {
+                            r[0] = static_cast<int32_t>(std::floor(p.x * inverse_epsilon));
+                            r[1] = static_cast<int32_t>(std::floor(p.y * inverse_epsilon));
+                            r[2] = static_cast<int32_t>(std::floor(p.z * inverse_epsilon));
+                        }
+                        else
+                        {
+                            //-0.0 and 0.0 weld
+                            const float v[3] = { p.x + 0.0f, p.y + 0.0f, p.z + 0.0f };
+                            std::memcpy(&r[0], &v[0], sizeof(v));
+                        }
+
+                        return r;
+                    }
+
+                    //-1 or 1 per axis, the side of the cell center the position is on, points closer than half a cell are in this cell or the next one on that side
+                    template <typename position_t>
+                    inline std::array<int32_t, 3> weld_side(const position_t& p, float inverse_epsilon)
+                    {
+                        const float v[3] = { p.x * inverse_epsilon, p.y * inverse_epsilon, p.z * inverse_epsilon };
+
+                        std::array<int32_t, 3> r;
+
+                        for (auto i = 0U; i < 3; ++i)
+                        {
+                            r[i] = v[i] - std::floor(v[i]) < 0.5f ? -1 : 1;
+                        }
+
+                        return r;
+                    }
+
+                    //32 bit keys sort in 4 radix passes, the rare collisions are told apart by the position compare
+                    inline uint64_t weld_key(const std::array<int32_t, 3>& c)
+                    {
+                        uint64_t h = parallel::mix(static_cast<uint32_t>(c[0]));
+                        h = parallel::mix(h ^ static_cast<uint32_t>(c[1]));
+                        h = parallel::mix(h ^ static_cast<uint32_t>(c[2]));
+                        return h >> 32;
+                    }
+                }
+
+                //welds vertices closer than epsilon, with epsilon 0 the bitwise equal positions
+                //equal_attributes(a, b) compares the other attributes of two vertices, which must match for a weld
+                //every vertex welds to the first vertex in its neighbourhood, the new vertices keep the old order
+                template <typename position_t, typename equal_t>
+                inline vertex_weld weld_vertices(const std::vector<position_t>& positions, float epsilon, equal_t&& equal_attributes)
+                {
+                    const size_t count              = positions.size();
+                    const size_t size               = parallel::block_size(count);
+                    //cells are two epsilon wide, so the neighbours of a vertex are in the 2x2x2 cells on its side of the cell centers
+                    const float  inverse_epsilon    = epsilon > 0.0f ? 0.5f / epsilon : 0.0f;
+                    const float  epsilon_squared    = epsilon * epsilon;
+
+                    std::vector<uint64_t> keys(count);
+                    std::vector<uint32_t> order(count);
+
+                    parallel::for_each_block(count, size, [&](size_t, size_t begin, size_t end)
+                    {
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            keys[i]  = details::weld_key(details::weld_cell(positions[i], inverse_epsilon));
+                            order[i] = static_cast<uint32_t>(i);
+                        }
+                    });
+
+                    parallel::radix_sort(keys, order);
+
+                    std::vector<uint32_t> parent(count);
+
+                    if (epsilon > 0.0f)
+                    {
+                        //first sorted vertex of every cell
+                        parallel::flat_hash_table cells(count);
+
+                        for (auto i = 0U; i < count; ++i)
+                        {
+                            if (i == 0 || keys[i] != keys[i - 1])
+                            {
+                                cells.insert(keys[i], i);
+                            }
+                        }
+
+                        parallel::for_each_block(count, size, [&](size_t, size_t begin, size_t end)
+                        {
+                            for (auto v = begin; v < end; ++v)
+                            {
+                                const auto& p = positions[v];
+                                const auto  c = details::weld_cell(p, inverse_epsilon);
+                                const auto  s = details::weld_side(p, inverse_epsilon);
+
+                                uint32_t r = static_cast<uint32_t>(v);
+
+                                for (int32_t x = 0; x <= 1; ++x)
+                                for (int32_t y = 0; y <= 1; ++y)
+                                for (int32_t z = 0; z <= 1; ++z)
+                                {
+                                    const std::array<int32_t, 3> n = { c[0] + x * s[0], c[1] + y * s[1], c[2] + z * s[2] };
+                                    const uint64_t               k = details::weld_key(n);
+
+                                    //the vertices of a cell are sorted by index, only the earlier ones can be the parent
+                                    for (auto i = cells.find(k); i < count && keys[i] == k && order[i] < r; ++i)
+                                    {
+                                        const auto& q = positions[order[i]];
+
+                                        const float dx = q.x - p.x;
+                                        const float dy = q.y - p.y;
+                                        const float dz = q.z - p.z;
+
+                                        if (dx * dx + dy * dy + dz * dz <= epsilon_squared && equal_attributes(order[i], static_cast<uint32_t>(v)))
+                                        {
+                                            r = order[i];
+                                        }
+                                    }
+                                }
+
+                                parent[v] = r;
+                            }
+                        });
+                    }
+                    else
+                    {
+                        //equal positions are neighbours in the sorted order, the first equal one of the run is the parent
+                        parallel::for_each_block(count, size, [&](size_t, size_t begin, size_t end)
+                        {
+                            for (auto i = begin; i < end; ++i)
+                            {
+                                const uint32_t v = order[i];
+                                const auto&    p = positions[v];
+
+                                auto first = i;
+                                while (first > 0 && keys[first - 1] == keys[i])
+                                {
+                                    --first;
+                                }
+
+                                uint32_t r = v;
+
+                                for (auto j = first; j < i; ++j)
+                                {
+                                    const auto& q = positions[order[j]];
+
+                                    if (q.x == p.x && q.y == p.y && q.z == p.z && equal_attributes(order[j], v))
+                                    {
+                                        r = order[j];
+                                        break;
+                                    }
+                                }
+
+                                parent[v] = r;
+                            }
+                        });
+                    }
+
+                    //parents have smaller indices, so following them ends at the first vertex of a weld group
+                    std::vector<size_t> offsets((count + size - 1) / size + 1, 0);
+
+                    parallel::for_each_block(count, size, [&](size_t b, size_t begin, size_t end)
+                    {
+                        size_t c = 0;
+                        for (auto v = begin; v < end; ++v)
+                        {
+                            c += parent[v] == v ? 1 : 0;
+                        }
+                        offsets[b + 1] = c;
+                    });
+
+                    for (auto b = 1U; b < offsets.size(); ++b)
+                    {
+                        offsets[b] += offsets[b - 1];
+                    }
+
+                    vertex_weld r;
+                    r.m_remap.resize(count);
+                    r.m_source.resize(offsets.back());
+
+                    parallel::for_each_block(count, size, [&](size_t b, size_t begin, size_t end)
+                    {
+                        size_t o = offsets[b];
+                        for (auto v = begin; v < end; ++v)
+                        {
+                            if (parent[v] == v)
+                            {
+                                r.m_remap[v]    = static_cast<uint32_t>(o);
+                                r.m_source[o++] = static_cast<uint32_t>(v);
+                            }
+                        }
+                    });
+
+                    parallel::for_each_block(count, size, [&](size_t, size_t begin, size_t end)
+                    {
+                        for (auto v = begin; v < end; ++v)
+                        {
+                            uint32_t root = parent[v];
+                            while (parent[root] != root)
+                            {
+                                root = parent[root];
+                            }
+
+                            r.m_remap[v] = r.m_remap[root];
+                        }
+                    });
+
+                    return r;
+                }
+
+                template <typename t>
+                inline void apply_weld(std::vector<t>& v, const vertex_weld& w)
+                {
+                    if (v.empty())
+                    {
+                        return;
+                    }
+
+                    std::vector<t> r(w.m_source.size());
+
+                    parallel::for_each_block(r.size(), parallel::block_size(r.size()), [&v, &w, &r](size_t, size_t begin, size_t end)
+                    {
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            r[i] = v[w.m_source[i]];
+                        }
+                    });
+
+                    v = std::move(r);
+                }
+
+                template <typename face_t>
+                inline void apply_weld_faces(std::vector<face_t>& faces, const vertex_weld& w)
+                {
+                    parallel::for_each_block(faces.size(), parallel::block_size(faces.size()), [&faces, &w](size_t, size_t begin, size_t end)
+                    {
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            faces[i].v0 = w.m_remap[faces[i].v0];
+                            faces[i].v1 = w.m_remap[faces[i].v1];
+                            faces[i].v2 = w.m_remap[faces[i].v2];
+                        }
+                    });
+                }
+
+                template <typename face_t>
+                inline void remove_degenerate_faces(std::vector<face_t>& faces)
+                {
+                    parallel::keep_if(faces, [&faces](size_t i)
+                    {
+                        const face_t& f = faces[i];
+                        return f.v0 != f.v1 && f.v0 != f.v2 && f.v1 != f.v2;
+                    });
+                }
+
+                //faces with the same vertices in the same winding are duplicates, the first one stays, the face order is kept
+                template <typename face_t>
+                inline void remove_duplicate_faces(std::vector<face_t>& faces)
+                {
+                    const size_t count  = faces.size();
+                    const size_t size   = parallel::block_size(count);
+
+                    auto canonical = [](const face_t& f)
+                    {
+                        //rotate the smallest vertex first, which keeps the winding
+                        std::array<uint32_t, 3> r = { f.v0, f.v1, f.v2 };
+
+                        if (r[1] < r[0] && r[1] < r[2])
+                        {
+                            r = { r[1], r[2], r[0] };
+                        }
+                        else if (r[2] < r[0] && r[2] < r[1])
+                        {
+                            r = { r[2], r[0], r[1] };
+                        }
+
+                        return r;
+                    };
+
+                    std::vector<uint64_t> keys(count);
+                    std::vector<uint32_t> order(count);
+
+                    parallel::for_each_block(count, size, [&](size_t, size_t begin, size_t end)
+                    {
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            auto c      = canonical(faces[i]);
+                            keys[i]     = parallel::mix((static_cast<uint64_t>(c[0]) << 32) ^ parallel::mix((static_cast<uint64_t>(c[1]) << 32) | c[2])) >> 32;
+                            order[i]    = static_cast<uint32_t>(i);
+                        }
+                    });
+
+                    parallel::radix_sort(keys, order);
+
+                    std::vector<uint8_t> duplicate(count, 0);
+
+                    parallel::for_each_block(count, size, [&](size_t, size_t begin, size_t end)
+                    {
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            const auto c = canonical(faces[order[i]]);
+
+                            //equal keys are sorted by face index, compare with the earlier faces of the run
+                            for (auto j = i; j > 0 && keys[j - 1] == keys[i]; --j)
+                            {
+                                if (canonical(faces[order[j - 1]]) == c)
+                                {
+                                    duplicate[order[i]] = 1;
+                                    break;
+                                }
+                            }
+                        }
+                    });
+
+                    parallel::keep_if(faces, [&duplicate](size_t i)
+                    {
+                        return duplicate[i] == 0;
+                    });
+                }
+
+                //area weighted face normals, summed per vertex, the normal of a face is (v0 - v1) x (v1 - v2)
+                template <typename normal_t, typename position_t, typename face_t>
+                inline std::vector<normal_t> build_vertex_normals(const std::vector<position_t>& positions, const std::vector<face_t>& faces)
+                {
+                    std::vector<std::array<float, 3>> face_normals(faces.size());
+
+                    parallel::for_each_block(faces.size(), parallel::block_size(faces.size()), [&](size_t, size_t begin, size_t end)
+                    {
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            const auto& p0 = positions[faces[i].v0];
+                            const auto& p1 = positions[faces[i].v1];
+                            const auto& p2 = positions[faces[i].v2];
+
+                            const float a[3] = { p0.x - p1.x, p0.y - p1.y, p0.z - p1.z };
+                            const float b[3] = { p1.x - p2.x, p1.y - p2.y, p1.z - p2.z };
+
+                            face_normals[i] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+                        }
+                    });
+
+                    auto adjacency = parallel::build_vertex_faces(faces, positions.size());
+
+                    std::vector<normal_t> r(positions.size());
+
+                    //the faces of a vertex are summed in face order, so the result does not depend on the threads
+                    parallel::for_each_block(positions.size(), parallel::block_size(positions.size()), [&](size_t, size_t begin, size_t end)
+                    {
+                        for (auto v = begin; v < end; ++v)
+                        {
+                            float n[3] = { 0.0f, 0.0f, 0.0f };
+
+                            for (auto i = adjacency.m_offsets[v]; i < adjacency.m_offsets[v + 1]; ++i)
+                            {
+                                const auto& f = face_normals[adjacency.m_faces[i]];
+                                n[0] += f[0];
+                                n[1] += f[1];
+                                n[2] += f[2];
+                            }
+
+                            const float l = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                            const float s = l > 0.0f ? 1.0f / l : 0.0f;
+
+                            r[v].x = n[0] * s;
+                            r[v].y = n[1] * s;
+                            r[v].z = n[2] * s;
+                        }
+                    });
+
+                    return r;
+                }
+            }
+        }
+    }
+}
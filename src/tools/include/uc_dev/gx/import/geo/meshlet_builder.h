@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <uc_dev/gx/import/geo/indexed_mesh.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace import
+        {
+            namespace geo
+            {
+                struct meshlet
+                {
+                    uint32_t m_vertex_offset    = 0;
+                    uint32_t m_triangle_offset  = 0;
+                    uint32_t m_vertex_count     = 0;
+                    uint32_t m_triangle_count   = 0;
+                };
+
+                //the meshlet faces away, when dot(center - eye, axis) >= cutoff * length(center - eye) + radius
+                struct meshlet_bounds
+                {
+                    float m_center[3]       = { 0.0f, 0.0f, 0.0f };
+                    float m_radius          = 0.0f;
+                    float m_cone_axis[3]    = { 0.0f, 0.0f, 0.0f };
+                    float m_cone_cutoff     = 1.0f;
+                };
+
+                struct meshlet_range
+                {
+                    uint32_t m_begin = 0;
+                    uint32_t m_end   = 0;
+                };
+
+                struct meshlet_set
+                {
+                    std::vector<meshlet>        m_meshlets;
+                    std::vector<meshlet_bounds> m_bounds;
+                    std::vector<meshlet_range>  m_ranges;       //meshlets of every primitive range
+                    std::vector<uint32_t>       m_vertices;     //mesh vertices of the meshlets
+                    std::vector<uint8_t>        m_triangles;    //3 meshlet local vertices per triangle
+                };
+
+                //64 vertices and 124 triangles fit the mesh shader output limits with room for the primitive attributes
+                struct meshlet_limits
+                {
+                    uint32_t m_max_vertices  = 64;
+                    uint32_t m_max_triangles = 124;
+                };
+
+                namespace details
+                {
+                    using vector3 = std::array<double, 3>;
+
+                    inline vector3 sub(const vector3& a, const vector3& b)
+                    {
+                        return { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+                    }
+
+                    inline vector3 cross(const vector3& a, const vector3& b)
+                    {
+                        return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+                    }
+
+                    inline double dot(const vector3& a, const vector3& b)
+                    {
+                        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+                    }
+
+                    inline double length(const vector3& a)
+                    {
+                        return std::sqrt(dot(a, a));
+                    }
+
+                    template <typename position_t>
+                    inline vector3 to_vector3(const position_t& p)
+                    {
+                        return { static_cast<double>(p.x), static_cast<double>(p.y), static_cast<double>(p.z) };
+                    }
+
+                    //front faces are counter clockwise in the left handed view space, as in the rasterizer states, so the outward normal is (p2 - p0) x (p1 - p0)
+                    template <typename position_t>
+                    inline meshlet_bounds make_meshlet_bounds(const meshlet_set& s, const meshlet& m, const std::vector<position_t>& positions)
+                    {
+                        meshlet_bounds r;
+
+                        vector3 min_p = {  std::numeric_limits<double>::max(),  std::numeric_limits<double>::max(),  std::numeric_limits<double>::max() };
+                        vector3 max_p = { -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max() };
+
+                        for (auto i = 0U; i < m.m_vertex_count; ++i)
+                        {
+                            auto p = to_vector3(positions[s.m_vertices[m.m_vertex_offset + i]]);
+
+                            for (auto k = 0U; k < 3; ++k)
+                            {
+                                min_p[k] = std::min(min_p[k], p[k]);
+                                max_p[k] = std::max(max_p[k], p[k]);
+                            }
+                        }
+
+                        vector3 center  = { (min_p[0] + max_p[0]) * 0.5, (min_p[1] + max_p[1]) * 0.5, (min_p[2] + max_p[2]) * 0.5 };
+                        double  radius  = 0.0;
+
+                        for (auto i = 0U; i < m.m_vertex_count; ++i)
+                        {
+                            radius = std::max(radius, length(sub(to_vector3(positions[s.m_vertices[m.m_vertex_offset + i]]), center)));
+                        }
+
+                        std::vector<vector3> normals;
+                        normals.reserve(m.m_triangle_count);
+
+                        vector3 axis = { 0.0, 0.0, 0.0 };
+
+                        for (auto i = 0U; i < m.m_triangle_count; ++i)
+                        {
+                            const uint8_t* t = &s.m_triangles[m.m_triangle_offset + i * 3];
+
+                            auto p0 = to_vector3(positions[s.m_vertices[m.m_vertex_offset + t[0]]]);
+                            auto p1 = to_vector3(positions[s.m_vertices[m.m_vertex_offset + t[1]]]);
+                            auto p2 = to_vector3(positions[s.m_vertices[m.m_vertex_offset + t[2]]]);
+
+                            auto n = cross(sub(p2, p0), sub(p1, p0));
+                            auto l = length(n);
+
+                            //degenerate triangles do not face anywhere
+                            if (l > 0.0)
+                            {
+                                n = { n[0] / l, n[1] / l, n[2] / l };
+                                normals.push_back(n);
+                                axis = { axis[0] + n[0], axis[1] + n[1], axis[2] + n[2] };
+                            }
+                        }
+
+                        double cutoff       = 1.0;
+                        double axis_length  = length(axis);
+
+                        if (axis_length > 0.0)
+                        {
+                            axis = { axis[0] / axis_length, axis[1] / axis_length, axis[2] / axis_length };
+
+                            double min_dot = 1.0;
+                            for (auto&& n : normals)
+                            {
+                                min_dot = std::min(min_dot, dot(n, axis));
+                            }
+
+                            //wide cones almost never cull and cost a test, keep them disabled
+                            if (min_dot > 0.1)
+                            {
+                                cutoff = std::sqrt(1.0 - min_dot * min_dot);
+                            }
+                        }
+
+                        for (auto k = 0U; k < 3; ++k)
+                        {
+                            r.m_center[k]       = static_cast<float>(center[k]);
+                            r.m_cone_axis[k]    = cutoff < 1.0 ? static_cast<float>(axis[k]) : 0.0f;
+                        }
+
+                        //widen a little, so the float rounding of the stored values stays conservative
+                        r.m_radius      = static_cast<float>(radius * (1.0 + 1e-5));
+                        r.m_cone_cutoff = cutoff < 1.0 ? static_cast<float>(std::min(1.0, cutoff + 1e-5)) : 1.0f;
+
+                        return r;
+                    }
+                }
+
+                //partitions every range of faces into meshlets, greedily in the face order
+                //the faces are expected to be vertex cache optimized, which keeps the meshlets compact
+                template <typename position_t, typename range_t>
+                inline meshlet_set build_meshlets(const std::vector<face>& faces, const std::vector<position_t>& positions, const std::vector<range_t>& ranges, const meshlet_limits& limits = meshlet_limits())
+                {
+                    const uint8_t not_in_meshlet = std::numeric_limits<uint8_t>::max();
+
+                    //local vertices are stored in a byte
+                    assert(limits.m_max_vertices < not_in_meshlet && limits.m_max_vertices >= 3 && limits.m_max_triangles >= 1);
+
+                    meshlet_set r;
+                    r.m_ranges.reserve(ranges.size());
+
+                    //meshlet local index of every mesh vertex
+                    std::vector<uint8_t> local(positions.size(), not_in_meshlet);
+
+                    meshlet current;
+
+                    auto flush = [&r, &current, &local, &positions]()
+                    {
+                        if (current.m_triangle_count > 0)
+                        {
+                            for (auto i = 0U; i < current.m_vertex_count; ++i)
+                            {
+                                local[r.m_vertices[current.m_vertex_offset + i]] = not_in_meshlet;
+                            }
+
+                            r.m_meshlets.push_back(current);
+                            r.m_bounds.push_back(details::make_meshlet_bounds(r, current, positions));
+                        }
+
+                        current                     = meshlet();
+                        current.m_vertex_offset     = static_cast<uint32_t>(r.m_vertices.size());
+                        current.m_triangle_offset   = static_cast<uint32_t>(r.m_triangles.size());
+                    };
+
+                    for (auto&& range : ranges)
+                    {
+                        meshlet_range mr;
+                        mr.m_begin = static_cast<uint32_t>(r.m_meshlets.size());
+
+                        for (auto f = range.m_begin; f < range.m_end; ++f)
+                        {
+                            const uint32_t v[3] = { faces[f].v0, faces[f].v1, faces[f].v2 };
+
+                            uint32_t new_vertices = 0;
+                            for (auto k = 0U; k < 3; ++k)
+                            {
+                                //count a vertex used twice by the triangle once
+                                bool repeated = (k > 0 && v[k] == v[0]) || (k > 1 && v[k] == v[1]);
+                                new_vertices += (local[v[k]] == not_in_meshlet && !repeated) ? 1 : 0;
+                            }
+
+                            if (current.m_vertex_count + new_vertices > limits.m_max_vertices || current.m_triangle_count + 1 > limits.m_max_triangles)
+                            {
+                                flush();
+                            }
+
+                            for (auto k = 0U; k < 3; ++k)
+                            {
+                                if (local[v[k]] == not_in_meshlet)
+                                {
+                                    local[v[k]] = static_cast<uint8_t>(current.m_vertex_count++);
+                                    r.m_vertices.push_back(v[k]);
+                                }
+
+                                r.m_triangles.push_back(local[v[k]]);
+                            }
+
+                            current.m_triangle_count++;
+                        }
+
+                        //meshlets do not cross primitive ranges, they have different materials
+                        flush();
+
+                        mr.m_end = static_cast<uint32_t>(r.m_meshlets.size());
+                        r.m_ranges.push_back(mr);
+                    }
+
+                    return r;
+                }
+            }
+        }
+    }
+}
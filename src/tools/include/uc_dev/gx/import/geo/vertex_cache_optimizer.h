@@ -0,0 +1,686 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <uc_dev/gx/import/geo/indexed_mesh.h>
+#include <uc_dev/gx/import/geo/multi_material_mesh.h>
+#include <uc_dev/gx/import/geo/skinned_mesh.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace import
+        {
+            namespace geo
+            {
+                //acmr: vertices transformed per triangle, 0.5 is the best for a regular grid, 3.0 is the worst
+                //atvr: vertices transformed per unique vertex, 1.0 is the best
+                struct vertex_cache_statistics
+                {
+                    uint32_t m_vertices_transformed = 0;
+                    uint32_t m_vertices             = 0;
+                    uint32_t m_faces                = 0;
+
+                    float acmr() const
+                    {
+                        return m_faces > 0 ? static_cast<float>(m_vertices_transformed) / m_faces : 0.0f;
+                    }
+
+                    float atvr() const
+                    {
+                        return m_vertices > 0 ? static_cast<float>(m_vertices_transformed) / m_vertices : 0.0f;
+                    }
+                };
+
+                inline vertex_cache_statistics operator+(const vertex_cache_statistics& a, const vertex_cache_statistics& b)
+                {
+                    vertex_cache_statistics r;
+                    r.m_vertices_transformed    = a.m_vertices_transformed + b.m_vertices_transformed;
+                    r.m_vertices                = a.m_vertices + b.m_vertices;
+                    r.m_faces                   = a.m_faces + b.m_faces;
+                    return r;
+                }
+
+                struct vertex_cache_report
+                {
+                    vertex_cache_statistics m_before;
+                    vertex_cache_statistics m_after;
+                };
+
+                namespace details
+                {
+                    //the post transform cache is modelled as a fifo, which is close to the hardware
+                    class fifo_cache
+                    {
+                        public:
+
+                        fifo_cache(size_t vertex_count, uint32_t size) : m_time_stamps(vertex_count, 0), m_size(size), m_time(size + 1)
+                        {
+
+                        }
+
+                        //true on a miss
+                        bool access(uint32_t v)
+                        {
+                            if (m_time - m_time_stamps[v] > m_size)
+                            {
+                                m_time_stamps[v] = m_time++;
+                                return true;
+                            }
+
+                            return false;
+                        }
+
+                        void reset()
+                        {
+                            m_time += m_size + 1;
+                        }
+
+                        private:
+
+                        std::vector<uint32_t>   m_time_stamps;
+                        uint32_t                m_size;
+                        uint32_t                m_time;
+                    };
+
+                    //tom forsyth, linear-speed vertex cache optimisation
+                    const uint32_t forsyth_cache_size   = 32;
+                    const uint32_t forsyth_max_valence  = 32;
+
+                    struct forsyth_tables
+                    {
+                        std::array<float, forsyth_cache_size + 3>    m_cache;
+                        std::array<float, forsyth_max_valence + 1>   m_valence;
+
+                        forsyth_tables()
+                        {
+                            for (auto i = 0U; i < m_cache.size(); ++i)
+                            {
+                                if (i < 3)
+                                {
+                                    //the last triangle is scored low on purpose, so a strip does not run back
+                                    m_cache[i] = 0.75f;
+                                }
+                                else if (i < forsyth_cache_size)
+                                {
+                                    m_cache[i] = std::pow(1.0f - static_cast<float>(i - 3) / (forsyth_cache_size - 3), 1.5f);
+                                }
+                                else
+                                {
+                                    m_cache[i] = 0.0f;
+                                }
+                            }
+
+                            m_valence[0] = 0.0f;
+
+                            for (auto i = 1U; i < m_valence.size(); ++i)
+                            {
+                                //boost the vertices with few triangles left, so they are finished and do not stay lonely
+                                m_valence[i] = 2.0f / std::sqrt(static_cast<float>(i));
+                            }
+                        }
+
+                        float score(int32_t cache_position, uint32_t live_faces) const
+                        {
+                            if (live_faces == 0)
+                            {
+                                return -1.0f;
+                            }
+
+                            const float c = cache_position >= 0 ? m_cache[cache_position] : 0.0f;
+                            return c + m_valence[std::min(live_faces, forsyth_max_valence)];
+                        }
+                    };
+
+                    inline uint32_t vertex(const face& f, uint32_t i)
+                    {
+                        return i == 0 ? f.v0 : i == 1 ? f.v1 : f.v2;
+                    }
+
+                    struct float3
+                    {
+                        float x;
+                        float y;
+                        float z;
+                    };
+
+                    inline float3 make_float3(const storage_position& p)
+                    {
+                        return { p.x, p.y, p.z };
+                    }
+
+                    inline float3 sub(const float3& a, const float3& b)
+                    {
+                        return { a.x - b.x, a.y - b.y, a.z - b.z };
+                    }
+
+                    inline float3 cross(const float3& a, const float3& b)
+                    {
+                        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+                    }
+
+                    inline float dot(const float3& a, const float3& b)
+                    {
+                        return a.x * b.x + a.y * b.y + a.z * b.z;
+                    }
+                }
+
+                inline vertex_cache_statistics analyze_vertex_cache(const face* faces, size_t face_count, size_t vertex_count, uint32_t cache_size = 16)
+                {
+                    vertex_cache_statistics r;
+                    details::fifo_cache     cache(vertex_count, cache_size);
+                    std::vector<uint8_t>    referenced(vertex_count, 0);
+
+                    for (auto i = 0U; i < face_count; ++i)
+                    {
+                        for (auto j = 0U; j < 3; ++j)
+                        {
+                            const uint32_t v = details::vertex(faces[i], j);
+
+                            r.m_vertices_transformed += cache.access(v) ? 1 : 0;
+                            r.m_vertices             += referenced[v] ? 0 : 1;
+                            referenced[v]             = 1;
+                        }
+                    }
+
+                    r.m_faces = static_cast<uint32_t>(face_count);
+                    return r;
+                }
+
+                //reorders the faces in place for the post transform cache
+                inline void optimize_vertex_cache(face* faces, size_t face_count, size_t vertex_count)
+                {
+                    using namespace details;
+
+                    if (face_count == 0)
+                    {
+                        return;
+                    }
+
+                    static const forsyth_tables tables;
+
+                    //face adjacency of every vertex, the live faces are kept at the front of every list
+                    std::vector<uint32_t> offsets(vertex_count + 1, 0);
+                    std::vector<uint32_t> live(vertex_count, 0);
+
+                    for (auto i = 0U; i < face_count; ++i)
+                    {
+                        live[faces[i].v0]++;
+                        live[faces[i].v1]++;
+                        live[faces[i].v2]++;
+                    }
+
+                    for (auto i = 0U; i < vertex_count; ++i)
+                    {
+                        offsets[i + 1] = offsets[i] + live[i];
+                    }
+
+                    std::vector<uint32_t> adjacency(offsets[vertex_count]);
+
+                    {
+                        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+
+                        for (auto i = 0U; i < face_count; ++i)
+                        {
+                            for (auto j = 0U; j < 3; ++j)
+                            {
+                                const uint32_t v = vertex(faces[i], j);
+                                adjacency[fill[v]++] = i;
+                            }
+                        }
+                    }
+
+                    std::vector<int32_t>    cache_position(vertex_count, -1);
+                    std::vector<float>      vertex_score(vertex_count);
+                    std::vector<float>      face_score(face_count, 0.0f);
+                    std::vector<uint8_t>    emitted(face_count, 0);
+                    std::vector<face>       r;
+
+                    r.reserve(face_count);
+
+                    for (auto i = 0U; i < vertex_count; ++i)
+                    {
+                        vertex_score[i] = tables.score(-1, live[i]);
+                    }
+
+                    uint32_t best       = 0;
+                    float    best_score = -1.0f;
+
+                    for (auto i = 0U; i < face_count; ++i)
+                    {
+                        face_score[i] = vertex_score[faces[i].v0] + vertex_score[faces[i].v1] + vertex_score[faces[i].v2];
+
+                        if (face_score[i] > best_score)
+                        {
+                            best_score  = face_score[i];
+                            best        = i;
+                        }
+                    }
+
+                    std::array<uint32_t, forsyth_cache_size + 3>    cache;
+                    std::array<uint32_t, forsyth_cache_size + 3>    new_cache;
+                    uint32_t                                        cache_count = 0;
+                    uint32_t                                        cursor      = 0;
+
+                    const uint32_t none = 0xFFFFFFFF;
+
+                    while (r.size() < face_count)
+                    {
+                        if (best == none)
+                        {
+                            //dead end, continue with the next face in the input order
+                            while (emitted[cursor])
+                            {
+                                cursor++;
+                            }
+
+                            best = cursor;
+                        }
+
+                        const face f = faces[best];
+                        r.push_back(f);
+                        emitted[best] = 1;
+
+                        uint32_t new_count = 0;
+
+                        for (auto j = 0U; j < 3; ++j)
+                        {
+                            const uint32_t v = vertex(f, j);
+
+                            //remove the face from the live part of the adjacency
+                            uint32_t* a     = &adjacency[offsets[v]];
+                            uint32_t  count = live[v];
+
+                            for (auto k = 0U; k < count; ++k)
+                            {
+                                if (a[k] == best)
+                                {
+                                    std::swap(a[k], a[count - 1]);
+                                    break;
+                                }
+                            }
+
+                            live[v]--;
+                            new_cache[new_count++] = v;
+                        }
+
+                        for (auto i = 0U; i < cache_count; ++i)
+                        {
+                            const uint32_t v = cache[i];
+
+                            if (v != f.v0 && v != f.v1 && v != f.v2)
+                            {
+                                new_cache[new_count++] = v;
+                            }
+                        }
+
+                        cache_count = std::min(new_count, forsyth_cache_size);
+                        std::copy(new_cache.begin(), new_cache.begin() + cache_count, cache.begin());
+
+                        best        = none;
+                        best_score  = -1.0f;
+
+                        //the vertices pushed out of the cache are updated too, they lose their cache score
+                        for (auto i = 0U; i < new_count; ++i)
+                        {
+                            const uint32_t v        = new_cache[i];
+                            const int32_t  position = i < forsyth_cache_size ? static_cast<int32_t>(i) : -1;
+
+                            cache_position[v] = position;
+
+                            const float score = tables.score(position, live[v]);
+                            const float delta = score - vertex_score[v];
+                            vertex_score[v]   = score;
+
+                            const uint32_t* a = &adjacency[offsets[v]];
+
+                            for (auto k = 0U; k < live[v]; ++k)
+                            {
+                                const uint32_t t = a[k];
+                                face_score[t] += delta;
+
+                                if (face_score[t] > best_score)
+                                {
+                                    best_score  = face_score[t];
+                                    best        = t;
+                                }
+                            }
+                        }
+                    }
+
+                    std::copy(r.begin(), r.end(), faces);
+                }
+
+                //sander, nehab, barczak: fast triangle reordering for vertex locality and reduced overdraw
+                //expects faces optimized for the vertex cache, splits them into clusters and draws the outward facing clusters first
+                inline void optimize_overdraw(face* faces, size_t face_count, const storage_position* positions, size_t vertex_count, float threshold = 1.05f)
+                {
+                    using namespace details;
+
+                    if (face_count < 2)
+                    {
+                        return;
+                    }
+
+                    const uint32_t cache_size = 16;
+
+                    //hard boundaries, where the vertex cache optimizer restarted
+                    std::vector<uint32_t> hard;
+
+                    {
+                        fifo_cache cache(vertex_count, cache_size);
+
+                        for (auto i = 0U; i < face_count; ++i)
+                        {
+                            uint32_t misses = 0;
+
+                            for (auto j = 0U; j < 3; ++j)
+                            {
+                                misses += cache.access(vertex(faces[i], j)) ? 1 : 0;
+                            }
+
+                            if (misses == 3 || i == 0)
+                            {
+                                hard.push_back(i);
+                            }
+                        }
+
+                        hard.push_back(static_cast<uint32_t>(face_count));
+                    }
+
+                    //soft boundaries, splitting where the running acmr is already good does not cost much
+                    std::vector<uint32_t> clusters;
+
+                    for (auto c = 0U; c + 1 < hard.size(); ++c)
+                    {
+                        const uint32_t begin    = hard[c];
+                        const uint32_t end      = hard[c + 1];
+
+                        const float cluster_acmr = analyze_vertex_cache(faces + begin, end - begin, vertex_count, cache_size).acmr();
+
+                        fifo_cache cache(vertex_count, cache_size);
+                        uint32_t   start  = begin;
+                        uint32_t   misses = 0;
+
+                        clusters.push_back(begin);
+
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            for (auto j = 0U; j < 3; ++j)
+                            {
+                                misses += cache.access(vertex(faces[i], j)) ? 1 : 0;
+                            }
+
+                            const float running_acmr = static_cast<float>(misses) / (i + 1 - start);
+
+                            if (i + 1 < end && running_acmr <= cluster_acmr * threshold)
+                            {
+                                clusters.push_back(i + 1);
+                                start  = i + 1;
+                                misses = 0;
+                                cache.reset();
+                            }
+                        }
+                    }
+
+                    clusters.push_back(static_cast<uint32_t>(face_count));
+
+                    //mesh centroid, area weighted
+                    float3 mesh_centroid  = { 0.0f, 0.0f, 0.0f };
+                    float  mesh_area      = 0.0f;
+
+                    for (auto i = 0U; i < face_count; ++i)
+                    {
+                        const float3 p0 = make_float3(positions[faces[i].v0]);
+                        const float3 p1 = make_float3(positions[faces[i].v1]);
+                        const float3 p2 = make_float3(positions[faces[i].v2]);
+
+                        const float3 n  = cross(sub(p1, p0), sub(p2, p0));
+                        const float  a  = std::sqrt(dot(n, n));
+
+                        mesh_centroid.x += (p0.x + p1.x + p2.x) * a;
+                        mesh_centroid.y += (p0.y + p1.y + p2.y) * a;
+                        mesh_centroid.z += (p0.z + p1.z + p2.z) * a;
+                        mesh_area       += a;
+                    }
+
+                    if (mesh_area > 0.0f)
+                    {
+                        const float s = 1.0f / (3.0f * mesh_area);
+                        mesh_centroid = { mesh_centroid.x * s, mesh_centroid.y * s, mesh_centroid.z * s };
+                    }
+
+                    //occlusion potential of a cluster: how much it faces away from the center
+                    const size_t cluster_count = clusters.size() - 1;
+                    std::vector<float>    sort_key(cluster_count);
+                    std::vector<uint32_t> order(cluster_count);
+
+                    for (auto c = 0U; c < cluster_count; ++c)
+                    {
+                        float3 centroid = { 0.0f, 0.0f, 0.0f };
+                        float3 normal   = { 0.0f, 0.0f, 0.0f };
+                        float  area     = 0.0f;
+
+                        for (auto i = clusters[c]; i < clusters[c + 1]; ++i)
+                        {
+                            const float3 p0 = make_float3(positions[faces[i].v0]);
+                            const float3 p1 = make_float3(positions[faces[i].v1]);
+                            const float3 p2 = make_float3(positions[faces[i].v2]);
+
+                            const float3 n  = cross(sub(p1, p0), sub(p2, p0));
+                            const float  a  = std::sqrt(dot(n, n));
+
+                            centroid.x += (p0.x + p1.x + p2.x) * a;
+                            centroid.y += (p0.y + p1.y + p2.y) * a;
+                            centroid.z += (p0.z + p1.z + p2.z) * a;
+
+                            normal.x   += n.x;
+                            normal.y   += n.y;
+                            normal.z   += n.z;
+                            area       += a;
+                        }
+
+                        if (area > 0.0f)
+                        {
+                            const float s = 1.0f / (3.0f * area);
+                            centroid = { centroid.x * s, centroid.y * s, centroid.z * s };
+                        }
+
+                        const float l = std::sqrt(dot(normal, normal));
+
+                        if (l > 0.0f)
+                        {
+                            normal = { normal.x / l, normal.y / l, normal.z / l };
+                        }
+
+                        sort_key[c] = dot(sub(centroid, mesh_centroid), normal);
+                        order[c]    = c;
+                    }
+
+                    std::stable_sort(order.begin(), order.end(), [&sort_key](uint32_t a, uint32_t b)
+                    {
+                        return sort_key[a] > sort_key[b];
+                    });
+
+                    std::vector<face> r;
+                    r.reserve(face_count);
+
+                    for (auto c : order)
+                    {
+                        r.insert(r.end(), faces + clusters[c], faces + clusters[c + 1]);
+                    }
+
+                    std::copy(r.begin(), r.end(), faces);
+                }
+
+                //renumbers the vertices in the order of the first use, returns old -> new
+                //vertices not referenced by the faces are moved to the end
+                inline std::vector<uint32_t> optimize_vertex_fetch(face* faces, size_t face_count, size_t vertex_count)
+                {
+                    const uint32_t none = 0xFFFFFFFF;
+
+                    std::vector<uint32_t> remap(vertex_count, none);
+                    uint32_t next = 0;
+
+                    for (auto i = 0U; i < face_count; ++i)
+                    {
+                        for (auto j = 0U; j < 3; ++j)
+                        {
+                            const uint32_t v = details::vertex(faces[i], j);
+
+                            if (remap[v] == none)
+                            {
+                                remap[v] = next++;
+                            }
+                        }
+
+                        faces[i].v0 = remap[faces[i].v0];
+                        faces[i].v1 = remap[faces[i].v1];
+                        faces[i].v2 = remap[faces[i].v2];
+                    }
+
+                    for (auto&& v : remap)
+                    {
+                        if (v == none)
+                        {
+                            v = next++;
+                        }
+                    }
+
+                    return remap;
+                }
+
+                template <typename t>
+                inline void remap_vertices(std::vector<t>& v, const std::vector<uint32_t>& remap)
+                {
+                    //empty or missing attribute streams are left as they are
+                    if (v.size() != remap.size())
+                    {
+                        return;
+                    }
+
+                    std::vector<t> r(v.size());
+
+                    for (auto i = 0U; i < v.size(); ++i)
+                    {
+                        r[remap[i]] = v[i];
+                    }
+
+                    v = std::move(r);
+                }
+
+                namespace details
+                {
+                    inline std::vector<uint32_t> optimize_vertex_order(std::vector<face>& faces, const std::vector<storage_position>& positions, vertex_cache_report& report)
+                    {
+                        const size_t vertex_count = positions.size();
+
+                        report.m_before = report.m_before + analyze_vertex_cache(faces.data(), faces.size(), vertex_count);
+
+                        optimize_vertex_cache(faces.data(), faces.size(), vertex_count);
+                        optimize_overdraw(faces.data(), faces.size(), positions.data(), vertex_count);
+
+                        auto remap = optimize_vertex_fetch(faces.data(), faces.size(), vertex_count);
+
+                        report.m_after = report.m_after + analyze_vertex_cache(faces.data(), faces.size(), vertex_count);
+
+                        return remap;
+                    }
+                }
+
+                inline vertex_cache_report optimize_vertex_order(indexed_mesh* m)
+                {
+                    vertex_cache_report r;
+
+                    auto remap = details::optimize_vertex_order(m->m_faces, m->m_positions, r);
+
+                    remap_vertices(m->m_positions, remap);
+                    remap_vertices(m->m_normals, remap);
+                    remap_vertices(m->m_tangents, remap);
+                    remap_vertices(m->m_uv, remap);
+
+                    //the half edges point to the old faces
+                    m->m_edges_storage.clear();
+                    m->m_edges.clear();
+
+                    return r;
+                }
+
+                //every material is a separate vertex range and a separate primitive range
+                inline vertex_cache_report optimize_vertex_order(multi_material_mesh* m)
+                {
+                    vertex_cache_report r;
+
+                    for (auto i = 0U; i < m->m_faces.size(); ++i)
+                    {
+                        auto remap = details::optimize_vertex_order(m->m_faces[i], m->m_positions[i], r);
+
+                        remap_vertices(m->m_positions[i], remap);
+
+                        if (i < m->m_normals.size())
+                        {
+                            remap_vertices(m->m_normals[i], remap);
+                        }
+
+                        if (i < m->m_tangents.size())
+                        {
+                            remap_vertices(m->m_tangents[i], remap);
+                        }
+
+                        if (i < m->m_uv.size())
+                        {
+                            remap_vertices(m->m_uv[i], remap);
+                        }
+                    }
+
+                    return r;
+                }
+
+                inline vertex_cache_report optimize_vertex_order(skinned_mesh* m)
+                {
+                    vertex_cache_report r;
+
+                    for (auto i = 0U; i < m->m_faces.size(); ++i)
+                    {
+                        auto remap = details::optimize_vertex_order(m->m_faces[i], m->m_positions[i], r);
+
+                        remap_vertices(m->m_positions[i], remap);
+
+                        if (i < m->m_normals.size())
+                        {
+                            remap_vertices(m->m_normals[i], remap);
+                        }
+
+                        if (i < m->m_tangents.size())
+                        {
+                            remap_vertices(m->m_tangents[i], remap);
+                        }
+
+                        if (i < m->m_uv.size())
+                        {
+                            remap_vertices(m->m_uv[i], remap);
+                        }
+
+                        if (i < m->m_blend_weights.size())
+                        {
+                            remap_vertices(m->m_blend_weights[i], remap);
+                        }
+
+                        if (i < m->m_blend_indices.size())
+                        {
+                            remap_vertices(m->m_blend_indices[i], remap);
+                        }
+                    }
+
+                    return r;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#include "pch.h"
+
+#include <uc_dev/build/texture/convert.h>
+
+#include <uc_dev/lip/lip.h>
+#include <uc_dev/gx/lip/model.h>
+
+#include <uc_dev/build/model/compressonator.h>
+#include <uc_dev/build/model/texture.h>
+
+namespace uc
+{
+    namespace texture
+    {
+        void convert_texture( const std::string& input_file_name, const std::string& output_file_name, const std::string& texture_format )
+        {
+            auto storage = model::string_to_storage_format(texture_format);
+            auto view = model::string_to_view_format(texture_format);
+
+            if (storage == lip::storage_format::unknown)
+            {
+                uc::lip::texture2d m = model::create_texture_2d(input_file_name);
+                uc::lip::serialize_object(&m, output_file_name);
+            }
+            else
+            {
+                uc::lip::texture2d m = model::create_texture_2d(input_file_name, storage, view);
+                uc::lip::serialize_object(&m, output_file_name);
+            }
+        }
+    }
+}
@@ -9,11 +9,13 @@
 #include <uc_dev/gx/import/assimp/animation.h>
 #include <uc_dev/gx/import/assimp/assimp_options.h>
 #include <uc_dev/gx/import/assimp/skinned_mesh.h>
+#include <uc_dev/build/build_cache.h>
+
+#include <uc_dev/build/animation/command_line.h>
+#include <uc_dev/build/animation/animation.h>
 
-#include "uc_animation_command_line.h"
 #include "uc_animation_options.h"
 #include "uc_animation_lip.h"
-#include "uc_animation_animation.h"
 
 #include <uc_dev/gx/import/fbx/animation.h>
 
@@ -32,17 +34,6 @@ inline std::ostream& operator<<(std::ostream& s, const std::string& str)
     return s;
 }
 
-inline std::string get_environment()
-{
-    #if defined(_X86)
-        return "x86";
-    #endif
-
-    #if defined(_X64)
-        return "x64";
-    #endif
-}
-
 
 int32_t main(int32_t argc, const char* argv[])
 {
@@ -70,34 +61,40 @@ int32_t main(int32_t argc, const char* argv[])
         auto input_animation    = get_input_animation(vm);
         auto output_animation   = get_output_animation(vm);
 
-        std::cout << "building animation (" << get_environment() << ") " << input_animation << std::endl;
+        std::cout << "building animation (" << uc::build::get_environment() << ") " << input_animation << std::endl;
     
         auto make_left_handed = get_make_left_handed(vm);
+        auto cache            = get_cache_directory(vm);
 
         uint32_t ai_o = 0;
         ai_o |= make_left_handed ? aiProcess_MakeLeftHanded : 0;
         ai_o |= aiProcess_CalcTangentSpace; //
         std::cout << "assimp options:" << uc::gx::import::assimp::assimp_postprocess_option_to_string(ai_o) << std::endl;
 
-        std::experimental::filesystem::path path(input_animation);
-        auto e = path.extension().wstring();
-
-        std::vector<uc::gx::import::anm::joint_animations> animations;
+        auto key = uc::build::cache::animation_key(ai_o, input_animation);
 
-        if (e == L".fbx")
+        uc::build::cache::build_cached(cache, key, { output_animation }, [&]
         {
-            animations = uc::gx::import::fbx::create_animations(input_animation);
-        }
-        else
-        {
-            animations = uc::gx::import::assimp::create_animations_from_assimp(input_animation, ai_o);
-        }
-
-        {
-            auto&& a = animations.front();
-            //take the 1st one only
-            uc::lip::serialize_object( uc::animation::animation(a), output_animation);
-        }
+            std::experimental::filesystem::path path(input_animation);
+            auto e = path.extension().wstring();
+
+            std::vector<uc::gx::import::anm::joint_animations> animations;
+
+            if (e == L".fbx")
+            {
+                animations = uc::gx::import::fbx::create_animations(input_animation);
+            }
+            else
+            {
+                animations = uc::gx::import::assimp::create_animations_from_assimp(input_animation, ai_o);
+            }
+
+            {
+                auto&& a = animations.front();
+                //take the 1st one only
+                uc::lip::serialize_object( uc::animation::animation(a), output_animation);
+            }
+        });
     }
     
     catch (const std::exception& e)
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <boost/program_options.hpp>
+
+#include "uc_asset_batch_exception.h"
+
+namespace uc
+{
+    namespace asset_batch
+    {
+        inline auto build_option_description()
+        {
+            namespace po = boost::program_options;
+
+            // Declare the supported options.
+            po::options_description desc("uc asset batch compiler. converts the models, textures, skeletons and animations of a manifest on a shared thread pool");
+
+            desc.add_options()
+                ("help,?", "produce help message")
+                ("manifest", po::value< std::string>(), "text file with one job per line: skeleton|animation|model|texture followed by the command line of the tool")
+                ("cache", po::value< std::string>(), "build cache directory for the jobs, which do not have their own")
+                ("jobs", po::value< uint32_t>(), "number of threads, 0 is the number of hardware threads")
+                ("trace", po::value< std::string>(), "timings of the jobs in the chrome://tracing format");
+
+            return desc;
+        }
+
+        inline auto build_option_map(const boost::program_options::options_description& desc, int32_t argc, const char* argv[])
+        {
+            namespace po = boost::program_options;
+
+            po::variables_map vm;
+
+            po::store(po::command_line_parser(argc, argv)
+                .options(desc)
+                .style(po::command_line_style::default_style
+                    | po::command_line_style::case_insensitive
+                    | po::command_line_style::allow_slash_for_short
+                    | po::command_line_style::allow_long_disguise)
+                .run(), vm);
+
+            po::notify(vm);
+            return make_tuple(vm, desc);
+        }
+
+        inline auto build_option_map(int32_t argc, const char* argv[])
+        {
+            return build_option_map(build_option_description(), argc, argv);
+        }
+
+        template <typename t, typename e >
+        inline auto get_input_value(const boost::program_options::variables_map & map, const std::string& s, e e)
+        {
+            using namespace std;
+            if (!map.count(s))
+            {
+                e();
+                return t();
+            }
+            else
+            {
+                return map[s].as< t >();
+            }
+        }
+
+        inline auto get_value_present(const boost::program_options::variables_map & map, const std::string& s)
+        {
+            using namespace std;
+            return map.count(s);
+        }
+
+        inline auto get_manifest(const boost::program_options::variables_map & map)
+        {
+            return std::string(get_input_value< std::string >(map, "manifest", []
+            {
+                raise_error<exception>("missing manifest");
+            }));
+        }
+
+        //empty, when the build cache is off
+        inline auto get_cache_directory(const boost::program_options::variables_map & map)
+        {
+            auto r = std::string();
+            if (get_value_present(map, "cache"))
+            {
+                r = get_input_value<std::string>(map, "cache", [] {});
+            }
+            return r;
+        }
+
+        inline auto get_jobs(const boost::program_options::variables_map & map)
+        {
+            auto r = 0U;
+            if (get_value_present(map, "jobs"))
+            {
+                r = get_input_value<uint32_t>(map, "jobs", [] {});
+            }
+            return r;
+        }
+
+        //empty, when the timings are not saved
+        inline auto get_trace(const boost::program_options::variables_map & map)
+        {
+            auto r = std::string();
+            if (get_value_present(map, "trace"))
+            {
+                r = get_input_value<std::string>(map, "trace", [] {});
+            }
+            return r;
+        }
+    }
+}
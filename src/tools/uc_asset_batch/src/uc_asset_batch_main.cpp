@@ -0,0 +1,460 @@
+// uc_asset_batch_main.cpp : Defines the entry point for the console application.
+//
+#include "pch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cwctype>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ppl.h>
+#include <concrt.h>
+
+#include <uc_dev/lip/tools_time_utils.h>
+#include <uc_dev/os/windows/com_initializer.h>
+#include <uc_dev/gx/import/assimp/animation.h>
+#include <uc_dev/gx/import/assimp/assimp_options.h>
+#include <uc_dev/gx/import/assimp/skinned_mesh.h>
+#include <uc_dev/gx/import/fbx/animation.h>
+#include <uc_dev/gx/import/fbx/skinned_mesh.h>
+#include <uc_dev/build/build_cache.h>
+#include <uc_dev/build/build_trace.h>
+
+//the converters of the tools, their namespaces do not overlap
+#include <uc_dev/build/skeleton/command_line.h>
+#include <uc_dev/build/skeleton/skeleton.h>
+#include <uc_dev/build/animation/command_line.h>
+#include <uc_dev/build/animation/animation.h>
+#include <uc_dev/build/model/command_line.h>
+#include <uc_dev/build/model/compressonator.h>
+#include <uc_dev/build/model/convert.h>
+#include <uc_dev/build/texture/command_line.h>
+#include <uc_dev/build/texture/convert.h>
+
+#include "uc_asset_batch_command_line.h"
+#include "uc_asset_batch_manifest.h"
+
+namespace uc
+{
+    namespace asset_batch
+    {
+        namespace filesystem = std::experimental::filesystem;
+
+        //a job with the parsed command line
+        struct prepared_job
+        {
+            job_tool                    m_tool;
+            uint32_t                    m_line;
+            std::vector<std::string>    m_arguments;
+            std::string                 m_input;
+            std::string                 m_output;
+            std::string                 m_cache;
+            uint32_t                    m_assimp_options = 0;
+            std::string                 m_model_type;       //the full name of the model type
+            std::vector<std::string>    m_textures;         //of the model, without the duplicates
+            std::vector<std::string>    m_texture_formats;
+            std::string                 m_texture_format;   //of the texture
+        };
+
+        struct job_result
+        {
+            bool                        m_failed = false;
+            bool                        m_cached = false;
+            std::string                 m_error;
+        };
+
+        struct batch
+        {
+            std::string                 m_manifest;
+            uc::build::build_trace      m_trace;
+            std::vector<prepared_job>   m_jobs;
+            std::vector<job_result>     m_results;
+            std::atomic<uint32_t>       m_finished      { 0 };
+            std::atomic<uint32_t>       m_fbx_loads     { 0 };
+            std::mutex                  m_output_lock;
+        };
+
+        inline bool is_fbx(const std::string& file_name)
+        {
+            auto e = filesystem::path(file_name).extension().wstring();
+            return _wcsicmp(e.c_str(), L".fbx") == 0;
+        }
+
+        template <typename parse_t>
+        inline auto parse_arguments(const prepared_job& j, parse_t parse)
+        {
+            std::vector<const char*> argv;
+            argv.push_back(tool_name(j.m_tool));
+
+            for (auto&& a : j.m_arguments)
+            {
+                argv.push_back(a.c_str());
+            }
+
+            auto&& om = parse(static_cast<int32_t>(argv.size()), argv.data());
+            return std::get<0>(om);
+        }
+
+        inline prepared_job prepare_job(const job& j, const std::string& cache)
+        {
+            prepared_job r;
+
+            r.m_tool        = j.m_tool;
+            r.m_line        = j.m_line;
+            r.m_arguments   = j.m_arguments;
+
+            if (!cache.empty() && std::find(r.m_arguments.begin(), r.m_arguments.end(), "--cache") == r.m_arguments.end())
+            {
+                r.m_arguments.push_back("--cache");
+                r.m_arguments.push_back(cache);
+            }
+
+            //same options as the tools, so the outputs match the ones of the single file builds
+            switch (j.m_tool)
+            {
+                case job_tool::skeleton:
+                {
+                    auto vm = parse_arguments(r, [](int32_t argc, const char* argv[]) { return skeleton::build_option_map(argc, argv); });
+
+                    r.m_input           = skeleton::get_input_skeleton(vm);
+                    r.m_output          = skeleton::get_output_skeleton(vm);
+                    r.m_cache           = skeleton::get_cache_directory(vm);
+                    r.m_assimp_options  = (skeleton::get_make_left_handed(vm) ? aiProcess_MakeLeftHanded : 0) | aiProcess_CalcTangentSpace;
+                    break;
+                }
+
+                case job_tool::animation:
+                {
+                    auto vm = parse_arguments(r, [](int32_t argc, const char* argv[]) { return animation::build_option_map(argc, argv); });
+
+                    r.m_input           = animation::get_input_animation(vm);
+                    r.m_output          = animation::get_output_animation(vm);
+                    r.m_cache           = animation::get_cache_directory(vm);
+                    r.m_assimp_options  = (animation::get_make_left_handed(vm) ? aiProcess_MakeLeftHanded : 0) | aiProcess_CalcTangentSpace;
+                    break;
+                }
+
+                case job_tool::model:
+                {
+                    auto vm = parse_arguments(r, [](int32_t argc, const char* argv[]) { return model::build_option_map(argc, argv); });
+
+                    r.m_input           = model::get_input_model(vm);
+                    r.m_output          = model::get_output_model(vm);
+                    r.m_cache           = model::get_cache_directory(vm);
+                    r.m_assimp_options  = static_cast<uint32_t>(model::get_assimp_option(vm)) | aiProcess_CalcTangentSpace;
+
+                    auto convertor      = model::get_convertor(model::get_model_type_name(model::get_model_type(vm)));
+                    r.m_model_type      = convertor.m_model_type;
+
+                    if (convertor.m_needs_textures)
+                    {
+                        std::tie(r.m_textures, r.m_texture_formats) = model::clean_duplicate_textures(model::get_textures(vm), model::get_texture_formats(vm));
+                    }
+                    break;
+                }
+
+                case job_tool::texture:
+                {
+                    auto vm = parse_arguments(r, [](int32_t argc, const char* argv[]) { return texture::build_option_map(argc, argv); });
+
+                    r.m_input           = texture::get_input_texture(vm);
+                    r.m_output          = texture::get_output_texture(vm);
+                    r.m_cache           = texture::get_cache_directory(vm);
+                    r.m_texture_format  = texture::get_texture_format(vm);
+                    break;
+                }
+            }
+
+            return r;
+        }
+
+        //the outputs of the same fbx file share one import, the other jobs are alone
+        inline std::vector< std::vector<uint32_t> > group_jobs(const std::vector<prepared_job>& jobs)
+        {
+            std::vector< std::vector<uint32_t> >        r;
+            std::unordered_map<std::wstring, size_t>    scenes;
+
+            for (auto i = 0U; i < jobs.size(); ++i)
+            {
+                auto&& j = jobs[i];
+
+                if (is_fbx(j.m_input))
+                {
+                    auto key = filesystem::absolute(j.m_input).wstring();
+                    std::transform(key.begin(), key.end(), key.begin(), std::towlower);
+
+                    auto it = scenes.emplace(key, r.size());
+
+                    if (it.second)
+                    {
+                        r.emplace_back();
+                    }
+
+                    r[it.first->second].push_back(i);
+                }
+                else
+                {
+                    r.push_back({ i });
+                }
+            }
+
+            return r;
+        }
+
+        inline bool run_skeleton(const prepared_job& j, const model::fbx_scene& scene)
+        {
+            auto key = uc::build::cache::skeleton_key(j.m_assimp_options, j.m_input);
+
+            return uc::build::cache::build_cached(j.m_cache, key, { j.m_output }, [&]
+            {
+                if (is_fbx(j.m_input))
+                {
+                    auto mesh = gx::import::fbx::create_skinned_mesh(scene());
+                    lip::serialize_object(skeleton::skeleton(mesh.get()), j.m_output);
+                }
+                else
+                {
+                    auto mesh = gx::import::assimp::create_skinned_mesh(j.m_input, j.m_assimp_options);
+                    lip::serialize_object(skeleton::skeleton(mesh.get()), j.m_output);
+                }
+            });
+        }
+
+        inline bool run_animation(const prepared_job& j, const model::fbx_scene& scene)
+        {
+            auto key = uc::build::cache::animation_key(j.m_assimp_options, j.m_input);
+
+            return uc::build::cache::build_cached(j.m_cache, key, { j.m_output }, [&]
+            {
+                std::vector<gx::import::anm::joint_animations> animations;
+
+                if (is_fbx(j.m_input))
+                {
+                    animations = gx::import::fbx::create_animations(scene());
+                }
+                else
+                {
+                    animations = gx::import::assimp::create_animations_from_assimp(j.m_input, j.m_assimp_options);
+                }
+
+                //take the 1st one only
+                lip::serialize_object(animation::animation(animations.front()), j.m_output);
+            });
+        }
+
+        inline bool run_model(const prepared_job& j, const model::fbx_scene& scene)
+        {
+            auto fbx = is_fbx(j.m_input);
+            auto key = uc::build::cache::model_key(j.m_model_type, j.m_assimp_options, fbx, j.m_input, j.m_textures, j.m_texture_formats);
+
+            return uc::build::cache::build_cached(j.m_cache, key, { j.m_output }, [&]
+            {
+                auto convertor = model::get_convertor(j.m_model_type);
+
+                if (fbx)
+                {
+                    convertor.m_convert_function_fbx(scene, j.m_output, j.m_assimp_options, j.m_textures, j.m_texture_formats);
+                }
+                else
+                {
+                    convertor.m_convert_function_assimp(j.m_input, j.m_output, j.m_assimp_options, j.m_textures, j.m_texture_formats);
+                }
+            });
+        }
+
+        inline bool run_texture(const prepared_job& j)
+        {
+            auto key = uc::build::cache::texture_key(j.m_texture_format, j.m_input);
+
+            return uc::build::cache::build_cached(j.m_cache, key, { j.m_output }, [&]
+            {
+                texture::convert_texture(j.m_input, j.m_output, j.m_texture_format);
+            });
+        }
+
+        inline void report(batch& b, const prepared_job& j, const job_result& r, uint64_t microseconds)
+        {
+            auto finished = ++b.m_finished;
+
+            std::lock_guard<std::mutex> lock(b.m_output_lock);
+
+            if (r.m_failed)
+            {
+                std::cerr << b.m_manifest << '(' << j.m_line << ',' << 0 << ')' << ":error 12345: " << tool_name(j.m_tool) << ": " << r.m_error << "\r\n";
+            }
+            else
+            {
+                std::cout << '[' << std::setw(4) << finished << '/' << b.m_jobs.size() << "] " << (r.m_cached ? "cached " : "built  ")
+                          << std::fixed << std::setprecision(1) << std::setw(10) << microseconds / 1000.0 << " ms " << tool_name(j.m_tool) << ' ' << j.m_output << std::endl;
+            }
+        }
+
+        //the jobs of a group run one after the other on one thread, the scene is imported by the first job, which misses the cache
+        inline void run_group(batch& b, const std::vector<uint32_t>& group)
+        {
+            std::unique_ptr<gx::import::fbx::fbx_context> context;
+
+            for (auto&& i : group)
+            {
+                auto&& j = b.m_jobs[i];
+                auto&& r = b.m_results[i];
+
+                auto scene = [&b, &j, &context]()
+                {
+                    if (!context)
+                    {
+                        auto begin  = b.m_trace.now();
+                        context     = gx::import::fbx::load_fbx_file(j.m_input);
+                        b.m_fbx_loads++;
+                        b.m_trace.add("load", j.m_input, begin, b.m_trace.now());
+                    }
+
+                    return context.get();
+                };
+
+                auto begin = b.m_trace.now();
+
+                try
+                {
+                    switch (j.m_tool)
+                    {
+                        case job_tool::skeleton:    r.m_cached = run_skeleton(j, scene);  break;
+                        case job_tool::animation:   r.m_cached = run_animation(j, scene); break;
+                        case job_tool::model:       r.m_cached = run_model(j, scene);     break;
+                        case job_tool::texture:     r.m_cached = run_texture(j);          break;
+                    }
+                }
+
+                catch (const std::exception& e)
+                {
+                    r.m_failed  = true;
+                    r.m_error   = e.what();
+                }
+
+                auto end = b.m_trace.now();
+                b.m_trace.add(tool_name(j.m_tool), j.m_output, begin, end);
+                report(b, j, r, end - begin);
+            }
+        }
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    using namespace uc::asset_batch;
+
+    try
+    {
+        uc::os::windows::com_initializer        com;
+        uc::model::compressonator::initializer  compressonator;
+
+        auto&& om = build_option_map(argc, argv);
+        auto&& vm = std::get<0>(om);
+        auto&& desc = std::get<1>(om);
+
+        if (vm.count("help"))
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+
+        batch b;
+
+        b.m_manifest    = get_manifest(vm);
+
+        auto cache      = get_cache_directory(vm);
+        auto threads    = get_jobs(vm);
+        auto trace      = get_trace(vm);
+
+        //all command lines are checked, before the first job starts
+        for (auto&& j : read_manifest(b.m_manifest))
+        {
+            try
+            {
+                b.m_jobs.push_back(prepare_job(j, cache));
+            }
+
+            catch (const std::exception& e)
+            {
+                raise_error<exception>(b.m_manifest + '(' + std::to_string(j.m_line) + "): " + e.what());
+            }
+        }
+
+        b.m_results.resize(b.m_jobs.size());
+
+        auto groups = group_jobs(b.m_jobs);
+
+        std::cout << "building assets (" << uc::build::get_environment() << ") " << b.m_manifest << " jobs:" << b.m_jobs.size() << " groups:" << groups.size() << std::endl;
+
+        auto begin = b.m_trace.now();
+
+        {
+            //bounds the threads of the pool, the fbx sdk and the texture compressor use memory per thread
+            if (threads != 0)
+            {
+                concurrency::CurrentScheduler::Create(concurrency::SchedulerPolicy(2, concurrency::MinConcurrency, 1, concurrency::MaxConcurrency, threads));
+            }
+
+            concurrency::task_group g;
+
+            for (auto&& group : groups)
+            {
+                g.run([&b, &group]
+                {
+                    run_group(b, group);
+                });
+            }
+
+            g.wait();
+
+            if (threads != 0)
+            {
+                concurrency::CurrentScheduler::Detach();
+            }
+        }
+
+        auto wall = b.m_trace.now() - begin;
+
+        uint32_t built  = 0;
+        uint32_t cached = 0;
+        uint32_t failed = 0;
+        uint32_t fbx    = 0;
+
+        for (auto i = 0U; i < b.m_jobs.size(); ++i)
+        {
+            auto&& r = b.m_results[i];
+
+            failed += r.m_failed ? 1 : 0;
+            cached += !r.m_failed && r.m_cached ? 1 : 0;
+            built  += !r.m_failed && !r.m_cached ? 1 : 0;
+            fbx    += is_fbx(b.m_jobs[i].m_input) ? 1 : 0;
+        }
+
+        std::cout << "jobs:" << b.m_jobs.size() << " built:" << built << " cached:" << cached << " failed:" << failed
+                  << " fbx outputs:" << fbx << " fbx loads:" << b.m_fbx_loads
+                  << " load ms:" << b.m_trace.duration("load") / 1000 << " wall ms:" << wall / 1000 << std::endl;
+
+        if (!trace.empty())
+        {
+            b.m_trace.save(trace);
+        }
+
+        return failed == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::string  input_model = "ucdev_asset_batch_r.exe";
+        std::cerr << input_model << '(' << 0 << ',' << 0 << ')' << ":error 12345: " << e.what() << "\r\n";
+        return -1;
+    }
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "uc_asset_batch_exception.h"
+
+namespace uc
+{
+    namespace asset_batch
+    {
+        enum class job_tool : uint32_t
+        {
+            skeleton    = 0,    //in process
+            animation   = 1,    //in process
+            model       = 2,    //in process
+            texture     = 3     //in process
+        };
+
+        struct job
+        {
+            job_tool                    m_tool;
+            std::vector<std::string>    m_arguments;    //the command line of the tool, without the tool
+            uint32_t                    m_line;         //in the manifest, for the errors
+        };
+
+        inline const char* tool_name(job_tool t)
+        {
+            switch (t)
+            {
+                case job_tool::skeleton:    return "ucdev_skeleton";
+                case job_tool::animation:   return "ucdev_animation";
+                case job_tool::model:       return "ucdev_model";
+                case job_tool::texture:     return "ucdev_texture";
+                default:                    return "";
+            }
+        }
+
+        //splits on white space, double quotes group, as on the command line of the tools
+        inline std::vector<std::string> split_arguments(const std::string& line)
+        {
+            std::vector<std::string> r;
+            std::string              a;
+
+            bool quoted  = false;
+            bool pending = false;
+
+            for (auto&& c : line)
+            {
+                if (c == '"')
+                {
+                    quoted  = !quoted;
+                    pending = true;
+                }
+                else if (!quoted && (c == ' ' || c == '\t' || c == '\r'))
+                {
+                    if (pending)
+                    {
+                        r.push_back(std::move(a));
+                        a.clear();
+                        pending = false;
+                    }
+                }
+                else
+                {
+                    a += c;
+                    pending = true;
+                }
+            }
+
+            if (quoted)
+            {
+                raise_error<exception>("unterminated quote");
+            }
+
+            if (pending)
+            {
+                r.push_back(std::move(a));
+            }
+
+            return r;
+        }
+
+        inline job_tool parse_tool(const std::string& s)
+        {
+            if (s == "skeleton")    return job_tool::skeleton;
+            if (s == "animation")   return job_tool::animation;
+            if (s == "model")       return job_tool::model;
+            if (s == "texture")     return job_tool::texture;
+
+            raise_error<exception>("unknown tool " + s);
+            return job_tool::skeleton;
+        }
+
+        //one job per line, empty lines and lines starting with # are skipped
+        //skeleton --input_skeleton "hero.fbx" --output_skeleton hero.skeleton
+        //animation --input_animation hero.fbx --output_animation hero.animation
+        inline std::vector<job> read_manifest(const std::string& file_name)
+        {
+            std::ifstream f(file_name);
+
+            if (!f.good())
+            {
+                raise_error<exception>("cannot open the manifest " + file_name);
+            }
+
+            std::vector<job> r;
+            std::string      line;
+            uint32_t         line_number = 0;
+
+            while (std::getline(f, line))
+            {
+                line_number++;
+
+                try
+                {
+                    auto arguments = split_arguments(line);
+
+                    if (arguments.empty() || arguments.front().compare(0, 1, "#") == 0)
+                    {
+                        continue;
+                    }
+
+                    job j;
+                    j.m_tool        = parse_tool(arguments.front());
+                    j.m_arguments   = std::vector<std::string>(arguments.begin() + 1, arguments.end());
+                    j.m_line        = line_number;
+                    r.push_back(std::move(j));
+                }
+
+                catch (const std::exception& e)
+                {
+                    raise_error<exception>(file_name + '(' + std::to_string(line_number) + "): " + e.what());
+                }
+            }
+
+            return r;
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <uc_dev/math/batch.h>
+#include <uc_dev/sys/cpu_features.h>
+
+//runs the batched matrix, quaternion and transform kernels against loops over the single value functions
+//every kernel the cpu supports is timed and compared with the single value results
+//usage: uc_batch_benchmark [count] [repeats]
+
+namespace
+{
+    using namespace uc;
+    using namespace uc::math;
+
+    double measure(const std::function<void()>& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    float max_error(const float4* a, const float4* b, size_t count)
+    {
+        float r = 0.0f;
+
+        for (auto i = 0U; i < count; ++i)
+        {
+            const float4 d = abs(sub(a[i], b[i]));
+            r = std::max(r, std::max(std::max(get_x(d), get_y(d)), std::max(get_z(d), get_w(d))));
+        }
+
+        return r;
+    }
+
+    float max_error(const float4x4* a, const float4x4* b, size_t count)
+    {
+        return max_error(&a[0].r[0], &b[0].r[0], count * 4);
+    }
+
+    struct kernel_set
+    {
+        const char* m_name;
+        bool        m_supported;
+    };
+
+    uint32_t g_failures = 0;
+
+    template <typename t, typename run_t>
+    void run(const char* name, const std::vector<t>& reference, std::vector<t>& result, uint32_t repeats, double reference_ms, float tolerance, run_t&& f)
+    {
+        const kernel_set sets[] = { { "sse", true }, { "avx2", sys::is_avx2_supported() }, { "avx512", sys::is_avx512_supported() } };
+
+        std::printf("%-24s %-8s %10.3f ms\n", name, "single", reference_ms / repeats);
+
+        for (auto k = 0U; k < 3; ++k)
+        {
+            if (!sets[k].m_supported)
+            {
+                continue;
+            }
+
+            std::fill(result.begin(), result.end(), t());
+
+            double ms = 0.0;
+            for (auto r = 0U; r < repeats; ++r)
+            {
+                ms += measure([&]() { f(k); });
+            }
+
+            const float error = max_error(result.data(), reference.data(), result.size());
+            const bool  ok    = error <= tolerance;
+
+            g_failures += ok ? 0 : 1;
+
+            std::printf("%-24s %-8s %10.3f ms %6.2fx  max error %g%s\n", name, sets[k].m_name, ms / repeats, reference_ms / ms, error, ok ? "" : " FAILED");
+        }
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    try
+    {
+        //odd, so every kernel runs its tail
+        const size_t    count   = argc > 1 ? static_cast<size_t>(std::stoul(argv[1])) : 100003;
+        const uint32_t  repeats = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 20;
+
+        std::cout << "count:" << count << " repeats:" << repeats << " avx2:" << (sys::is_avx2_supported() ? "yes" : "no") << " avx512:" << (sys::is_avx512_supported() ? "yes" : "no") << std::endl;
+
+        std::mt19937                            random(1);
+        std::uniform_real_distribution<float>   value(-1.0f, 1.0f);
+        std::uniform_real_distribution<float>   fraction(0.0f, 1.0f);
+
+        auto random_quaternion = [&]()
+        {
+            return normalize4(set(value(random), value(random), value(random), value(random)));
+        };
+
+        std::vector<float4x4>   a(count);
+        std::vector<float4x4>   b(count);
+        std::vector<float4>     qa(count);
+        std::vector<float4>     qb(count);
+        std::vector<float>      t(count);
+        std::vector<float4>     points(count);
+
+        for (auto i = 0U; i < count; ++i)
+        {
+            qa[i]       = random_quaternion();
+            qb[i]       = random_quaternion();
+            t[i]        = fraction(random);
+            points[i]   = point3(value(random) * 10.0f, value(random) * 10.0f, value(random) * 10.0f);
+
+            a[i]        = mul(quaternion_2_matrix(qa[i]), translation(value(random), value(random), value(random)));
+            b[i]        = mul(quaternion_2_matrix(qb[i]), translation(value(random), value(random), value(random)));
+        }
+
+        const float4x4 common = b[0];
+
+        std::vector<float4x4>   matrices_reference(count);
+        std::vector<float4x4>   matrices(count);
+        std::vector<float4>     vectors_reference(count);
+        std::vector<float4>     vectors(count);
+
+        double ms = 0.0;
+
+        //r[i] = a[i] * b[i]
+        ms = 0.0;
+        for (auto r = 0U; r < repeats; ++r) ms += measure([&]() { for (auto i = 0U; i < count; ++i) matrices_reference[i] = mul(a[i], b[i]); });
+        run("mul", matrices_reference, matrices, repeats, ms, 1e-5f, [&](uint32_t k)
+        {
+            auto f = k == 0 ? details::mul_sse : k == 1 ? details::mul_avx2 : details::mul_avx512;
+            f(a.data(), b.data(), matrices.data(), count);
+        });
+
+        //r[i] = a[i] * b
+        ms = 0.0;
+        for (auto r = 0U; r < repeats; ++r) ms += measure([&]() { for (auto i = 0U; i < count; ++i) matrices_reference[i] = mul(a[i], common); });
+        run("mul common", matrices_reference, matrices, repeats, ms, 1e-5f, [&](uint32_t k)
+        {
+            auto f = k == 0 ? details::mul_broadcast_sse : k == 1 ? details::mul_broadcast_avx2 : details::mul_broadcast_avx512;
+            f(a.data(), &common, matrices.data(), count);
+        });
+
+        ms = 0.0;
+        for (auto r = 0U; r < repeats; ++r) ms += measure([&]() { for (auto i = 0U; i < count; ++i) matrices_reference[i] = quaternion_2_matrix(qa[i]); });
+        run("quaternion_2_matrix", matrices_reference, matrices, repeats, ms, 1e-5f, [&](uint32_t k)
+        {
+            auto f = k == 0 ? details::quaternion_2_matrix_sse : k == 1 ? details::quaternion_2_matrix_avx2 : details::quaternion_2_matrix_avx512;
+            f(qa.data(), matrices.data(), count);
+        });
+
+        ms = 0.0;
+        for (auto r = 0U; r < repeats; ++r) ms += measure([&]() { for (auto i = 0U; i < count; ++i) vectors_reference[i] = transform3(points[i], common); });
+        run("transform3", vectors_reference, vectors, repeats, ms, 1e-4f, [&](uint32_t k)
+        {
+            auto f = k == 0 ? details::transform3_sse : k == 1 ? details::transform3_avx2 : details::transform3_avx512;
+            f(points.data(), &common, vectors.data(), count, false);
+        });
+
+        ms = 0.0;
+        for (auto r = 0U; r < repeats; ++r) ms += measure([&]() { for (auto i = 0U; i < count; ++i) vectors_reference[i] = slerp(qa[i], qb[i], t[i]); });
+        run("slerp", vectors_reference, vectors, repeats, ms, 1e-5f, [&](uint32_t k)
+        {
+            auto f = k == 0 ? details::slerp_sse : k == 1 ? details::slerp_avx2 : details::slerp_avx512;
+            f(qa.data(), qb.data(), t.data(), vectors.data(), count);
+        });
+
+        std::cout << "failed kernels:" << g_failures << std::endl;
+        return g_failures == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
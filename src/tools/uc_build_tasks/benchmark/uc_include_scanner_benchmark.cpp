@@ -0,0 +1,157 @@
+#include "pch.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "uc_build_tasks_include_parser.h"
+#include "uc_build_tasks_include_scanner.h"
+
+//compares the dependency scans of the shader trees:
+//the preprocessor as before, the include scanner with an empty cache, and with the cache of the previous build
+//usage: uc_include_scanner_benchmark [-I include_directory]... shader_directory...
+//example: uc_include_scanner_benchmark -I include src/uc_dev/private/gx/dx12/shaders src/uc_engine_gi_room/shaders
+
+namespace
+{
+    namespace filesystem = std::experimental::filesystem;
+
+    using shader_includes = std::vector< std::unordered_set< std::string > >;
+
+    std::vector<std::string> find_shaders(const std::vector<std::string>& directories)
+    {
+        std::vector<std::string> r;
+
+        for (auto&& d : directories)
+        {
+            for (auto&& e : filesystem::recursive_directory_iterator(d))
+            {
+                if (filesystem::is_regular_file(e.path()) && e.path().extension() == ".hlsl")
+                {
+                    r.push_back(filesystem::absolute(e.path()).string());
+                }
+            }
+        }
+
+        return r;
+    }
+
+    double measure(const std::function<void()>& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    shader_includes scan(uc::build::tasks::include_scanner& scanner, const std::vector<std::string>& shaders, const std::vector<std::string>& include_paths)
+    {
+        shader_includes r;
+        r.reserve(shaders.size());
+
+        for (auto&& s : shaders)
+        {
+            r.push_back(scanner.includes(s, std::vector<std::string>(), include_paths));
+        }
+
+        return r;
+    }
+
+    void print(const char* name, double ms, size_t shaders)
+    {
+        std::printf("%-28s %10.2f ms %10.3f ms/shader\n", name, ms, shaders ? ms / shaders : 0.0);
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    using namespace uc::build::tasks;
+
+    try
+    {
+        std::vector<std::string> include_paths;
+        std::vector<std::string> directories;
+
+        for (auto i = 1; i < argc; ++i)
+        {
+            const std::string a = argv[i];
+
+            if (a == "-I" && i + 1 < argc)
+            {
+                include_paths.push_back(filesystem::absolute(argv[++i]).string());
+            }
+            else
+            {
+                directories.push_back(a);
+            }
+        }
+
+        if (directories.empty())
+        {
+            std::cerr << "usage: uc_include_scanner_benchmark [-I include_directory]... shader_directory..." << std::endl;
+            return -1;
+        }
+
+        const auto shaders      = find_shaders(directories);
+        const auto cache_file   = (filesystem::temp_directory_path() / "uc_include_scanner_benchmark.includes").string();
+
+        std::cout << "shaders:" << shaders.size() << std::endl;
+
+        //the preprocessor output is normalized by a scanner, so the names compare
+        include_scanner preprocessor(include_scan_mode::preprocessor);
+        include_scanner cold;
+        include_scanner warm;
+
+        shader_includes expected;
+        shader_includes cold_includes;
+        shader_includes warm_includes;
+
+        print("preprocessor", measure([&]() { expected = scan(preprocessor, shaders, include_paths); }), shaders.size());
+        print("scanner, empty cache", measure([&]() { cold_includes = scan(cold, shaders, include_paths); }), shaders.size());
+
+        cold.save(cache_file);
+
+        print("scanner, previous build", measure([&]() { warm.load(cache_file); warm_includes = scan(warm, shaders, include_paths); }), shaders.size());
+
+        //the scanner finds the includes of every branch, more dependencies are correct, less are missed rebuilds
+        size_t missing = 0;
+        size_t extra   = 0;
+
+        for (auto i = 0U; i < shaders.size(); ++i)
+        {
+            for (auto&& f : expected[i])
+            {
+                if (cold_includes[i].find(f) == cold_includes[i].end() || warm_includes[i].find(f) == warm_includes[i].end())
+                {
+                    std::cout << "missing:" << shaders[i] << " -> " << f << std::endl;
+                    missing++;
+                }
+            }
+
+            for (auto&& f : cold_includes[i])
+            {
+                extra += expected[i].find(f) == expected[i].end() ? 1 : 0;
+            }
+        }
+
+        auto&& statistics = cold.statistics();
+        std::cout << "files scanned:" << statistics.m_scans << " preprocessed:" << statistics.m_preprocessed << " extra dependencies:" << extra << " missing dependencies:" << missing << std::endl;
+
+        std::error_code e;
+        filesystem::remove(filesystem::path(cache_file), e);
+
+        return missing == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -545,6 +545,8 @@ namespace UniqueCreator
 
                 m_preprocessor_definitions  = System::String::Empty;
                 m_additional_include_directories = System::String::Empty;
+                m_trace_file                = System::String::Empty;
+                m_include_scanner           = gcnew System::String("Fast");
             }
 
             std::vector<char> code(const std::string& file_name)
@@ -635,15 +637,36 @@ namespace UniqueCreator
                     auto&& meta_data = build_meta_data(m_sources);
                     std::string   file_cache = m_state_file != nullptr ? marshal(m_state_file->ItemSpec) : "";
 
+                    auto concurrency = uc::build::tasks::default_concurrency(m_max_concurrency > 0 ? static_cast<uint32_t>(m_max_concurrency) : 0U);
+                    uc::build::tasks::build_trace trace;
+
+                    auto scan_mode = System::String::Equals(m_include_scanner, "Preprocessor", System::StringComparison::OrdinalIgnoreCase) ? uc::build::tasks::include_scan_mode::preprocessor : uc::build::tasks::include_scan_mode::fast;
+                    uc::build::tasks::include_scanner scanner(scan_mode);
+                    std::string include_cache = !file_cache.empty() ? file_cache + ".includes" : "";
+
+                    if (!include_cache.empty())
+                    {
+                        scanner.load(include_cache);
+                    }
+
                     //change this if you want to rebuild the shaders when deploying new version
                     std::vector< uc::build::tasks::dependency_cache_item > static_dependencies;
                     static_dependencies.emplace_back(uc::build::tasks::dependency_cache_item ( "uc_build_tasks", "27e5437d42117ba9a9162d0a07754bb4"  )) ;
 
                     //load the cache and check which files need rebuilding
-                    auto&& result = uc::build::tasks::build_caches(meta_data, file_cache, static_dependencies);
+                    auto&& result = uc::build::tasks::build_caches(meta_data, file_cache, static_dependencies, concurrency, &trace, &scanner);
                     auto&& files_to_build = std::get<0>(result);
                     auto&& cache_to_save = std::get<1>(result);
 
+                    //the scans are kept, even if the compile fails
+                    if (!include_cache.empty())
+                    {
+                        scanner.save(include_cache);
+                    }
+
+                    auto&& statistics = scanner.statistics();
+                    Log->LogMessage(Microsoft::Build::Framework::MessageImportance::Normal, "ucdev_shader_compiler : includes, {0} unchanged, {1} touched, {2} scanned, {3} preprocessed", statistics.m_time_hits, statistics.m_hash_hits, statistics.m_scans, statistics.m_preprocessed);
+
                     using namespace System::IO;
                     using namespace System::Reflection;
 
@@ -651,39 +674,11 @@ namespace UniqueCreator
 
                     if (!files_to_build.empty())
                     {
-                        for (auto i = 0U; i < files_to_build.size(); ++i)   //todo: this in parallel
+                        if (!Compile(files_to_build, concurrency, trace))
                         {
-                            auto&& it = files_to_build[i];
-
-                            auto r0 = build_command_line(it.m_file_name, it.m_dxbc, it.m_pdb_file, it.m_dxbc_header, it.m_pipeline_stage, it.m_additional_include_directories, it.m_preprocessor_directives);
-                            auto spawner = gcnew FXCSpawner(m_tool_path);
-                            auto compile_result = spawner->RunCompiler( r0);
-
-                            if (compile_result->Item1 != 0)
-                            {
-                                auto error = compile_result->Item3;
-                                for ( auto i = 0; i < error->Count; ++i)
-                                {
-                                    Log->LogMessageFromText( error[i], Microsoft::Build::Framework::MessageImportance::High );
-                                }
-
-                                ProcessOutputs(meta_data);
-                                return false;
-                            }
-                            else
-                            {
-                                auto message = compile_result->Item2;
-
-                                for (auto i = 0; i < message->Count; ++i)
-                                {
-                                    Log->LogMessage(message[i]);
-                                }
-                            }
-
-                            auto&& generated_files = cpp_generate_get_templates( it.m_pipeline_stage, m_backend );
-                            auto&& files           = cpp_generate_prepare_templates(generated_files, it.m_dxbc_header, it.m_cpp_generated_type_name);
-
-                            cpp_generate_write_files(files, it.m_cpp_generated_file_name, it.m_cpp_generated_file_name_header);
+                            SaveTrace(trace, concurrency);
+                            ProcessOutputs(meta_data);
+                            return false;
                         }
 
                         save_cache(file_cache, cache_to_save);
@@ -691,6 +686,7 @@ namespace UniqueCreator
                         trackRecords->Item2->SaveTlog();
                     }
 
+                    SaveTrace(trace, concurrency);
                     ProcessOutputs(meta_data);
                     //record all files that are supposed to be written for the clean target
                     RecordFilesWritten(meta_data);
@@ -729,6 +725,90 @@ namespace UniqueCreator
                 }
             }
 
+            bool HLSLCompiler::Compile(const std::vector<uc::build::tasks::item_meta_data>& items, uint32_t concurrency, uc::build::tasks::build_trace& trace)
+            {
+                const auto size     = static_cast<uint32_t>(items.size());
+                auto spawners       = gcnew array<FXCSpawner^>(size);
+
+                std::vector<uint64_t> begin(size);
+
+                uint32_t started    = 0;
+                uint32_t finished   = 0;
+                bool     failed     = false;
+
+                while (finished < size)
+                {
+                    //keep up to concurrency compilers running, after an error only the running ones are finished
+                    while (!failed && started < size && started - finished < concurrency)
+                    {
+                        auto&& it = items[started];
+
+                        auto r0 = build_command_line(it.m_file_name, it.m_dxbc, it.m_pdb_file, it.m_dxbc_header, it.m_pipeline_stage, it.m_additional_include_directories, it.m_preprocessor_directives);
+
+                        begin[started]    = trace.now();
+                        spawners[started] = gcnew FXCSpawner(m_tool_path);
+                        spawners[started]->StartCompiler(r0);
+                        started++;
+                    }
+
+                    if (finished == started)
+                    {
+                        break;
+                    }
+
+                    //the compilers are waited for in the order of the sources, so the output is reported in the same order as a serial build
+                    auto&& it               = items[finished];
+                    auto compile_result     = spawners[finished]->WaitCompiler();
+                    spawners[finished]      = nullptr;
+
+                    trace.add("compile", it.m_file_name, begin[finished], trace.now(), finished % concurrency);
+
+                    if (compile_result->Item1 != 0)
+                    {
+                        auto error = compile_result->Item3;
+                        for ( auto i = 0; i < error->Count; ++i)
+                        {
+                            Log->LogMessageFromText( error[i], Microsoft::Build::Framework::MessageImportance::High );
+                        }
+
+                        failed = true;
+                    }
+                    else
+                    {
+                        auto message = compile_result->Item2;
+
+                        for (auto i = 0; i < message->Count; ++i)
+                        {
+                            Log->LogMessage(message[i]);
+                        }
+
+                        auto&& generated_files = cpp_generate_get_templates( it.m_pipeline_stage, m_backend );
+                        auto&& files           = cpp_generate_prepare_templates(generated_files, it.m_dxbc_header, it.m_cpp_generated_type_name);
+
+                        cpp_generate_write_files(files, it.m_cpp_generated_file_name, it.m_cpp_generated_file_name_header);
+                    }
+
+                    finished++;
+                }
+
+                return !failed;
+            }
+
+            void HLSLCompiler::SaveTrace(const uc::build::tasks::build_trace& trace, uint32_t concurrency)
+            {
+                auto wall       = trace.now() / 1000;
+                auto scan       = trace.duration("scan") / 1000;
+                auto hash       = trace.duration("hash") / 1000;
+                auto compile    = trace.duration("compile") / 1000;
+
+                Log->LogMessage(Microsoft::Build::Framework::MessageImportance::Normal, "ucdev_shader_compiler : {0} ms on {1} threads, scan {2} ms, hash {3} ms, compile {4} ms", wall, concurrency, scan, hash, compile);
+
+                if (m_trace_file != nullptr && m_trace_file->Length > 0)
+                {
+                    trace.save(marshal(m_trace_file));
+                }
+            }
+
             void HLSLCompiler::ProcessOutputs(const std::vector<uc::build::tasks::item_meta_data>& items)
             {
                 auto s = items.size();
@@ -772,6 +852,7 @@ namespace UniqueCreator
                 if (m_state_file != nullptr && m_state_file->ItemSpec->Length > 0)
                 {
                     m_files_written->Add(m_state_file);
+                    m_files_written->Add(gcnew TaskItem(m_state_file->ItemSpec + ".includes"));
                 }
 
                 auto s = items.size();
@@ -174,6 +174,48 @@ namespace UniqueCreator
                     }
                 }
 
+                //number of shaders compiled at once, 0 -> the number of hardware threads
+                property System::Int32 MaxConcurrency
+                {
+                    System::Int32 get()
+                    {
+                        return m_max_concurrency;
+                    }
+
+                    void set(System::Int32 value)
+                    {
+                        m_max_concurrency = value;
+                    }
+                }
+
+                //optional chrome://tracing file with the timings of the scans, hashes and compiles
+                property System::String^ TraceFile
+                {
+                    System::String^ get()
+                    {
+                        return m_trace_file;
+                    }
+
+                    void set(System::String^ value)
+                    {
+                        m_trace_file = value;
+                    }
+                }
+
+                //Fast scans the #include lines, Preprocessor runs the preprocessor for every shader
+                property System::String^ IncludeScanner
+                {
+                    System::String^ get()
+                    {
+                        return m_include_scanner;
+                    }
+
+                    void set(System::String^ value)
+                    {
+                        m_include_scanner = value;
+                    }
+                }
+
                 bool Execute() override;
 
                 private:
@@ -191,12 +233,17 @@ namespace UniqueCreator
                     System::String^    m_tracker_log_directory;
                     System::String^    m_additional_include_directories;
                     System::String^    m_preprocessor_definitions;
+                    System::String^    m_trace_file;
+                    System::String^    m_include_scanner;
+                    System::Int32      m_max_concurrency = 0;
                     Backend            m_backend        = Backend::UniqueCreatorPublic;
                     System::String^    m_backend_string = gcnew System::String("UniqueCreatorPublic");
 
 
                     void RecordFilesWritten(const std::vector<uc::build::tasks::item_meta_data>&);  //build lists with all side effects from the build system, used for clean
                     void ProcessOutputs(const std::vector<uc::build::tasks::item_meta_data>& ); //build lists with side effects from the build process for msbuild usage
+                    bool Compile(const std::vector<uc::build::tasks::item_meta_data>&, uint32_t concurrency, uc::build::tasks::build_trace& trace);   //runs up to concurrency compilers at once, false on an error
+                    void SaveTrace(const uc::build::tasks::build_trace& trace, uint32_t concurrency);
             };
         }
     }
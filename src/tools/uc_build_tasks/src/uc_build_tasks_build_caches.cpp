@@ -2,9 +2,10 @@
 
 #include "uc_build_tasks_build_caches.h"
 #include "uc_build_tasks_dependencies.h"
-#include "uc_build_tasks_include_parser.h"
+#include "uc_build_tasks_include_scanner.h"
 #include "uc_build_tasks_dependencies_boost.h"
 #include "uc_build_tasks_error.h"
+#include "uc_build_tasks_scheduler.h"
 
 #include "uc_build_md5.h"
 
@@ -12,6 +13,7 @@
 #include <fstream>
 #include <string>
 #include <iterator>
+#include <unordered_map>
 
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
@@ -24,37 +26,74 @@ namespace uc
     {
         namespace tasks
         {
-            std::string     create_hash( const std::string& file_name )
+            //scans the includes of every shader and hashes every distinct file once, the shaders share most of their headers
+            //the includes are known only after the scans, so the hashes run as a second graph, mostly from the scans of the scanner
+            std::vector< dependencies > build_file_cache_items(const std::vector< item_meta_data>& files_to_parse, uint32_t concurrency, build_trace* trace, include_scanner& scanner)
             {
-                std::ifstream instream(file_name);
-                if (instream.good())
+                std::vector< std::unordered_set< std::string > > includes(files_to_parse.size());
+
+                job_scheduler scheduler(concurrency, trace);
+
+                for (auto i = 0U; i < files_to_parse.size(); ++i)
+                {
+                    scheduler.add("scan", files_to_parse[i].m_file_name, [&files_to_parse, &includes, &scanner, i]()
+                    {
+                        auto&& f = files_to_parse[i];
+                        includes[i] = scanner.includes(f.m_file_name, f.m_preprocessor_directives, f.m_additional_include_directories);
+                    });
+                }
+
+                scheduler.run();
+
+                std::unordered_map< std::string, uint32_t > hash_index;
+                std::vector< std::string >                  hash_files;
+
+                auto add_file = [&hash_index, &hash_files](const std::string& file_name)
                 {
-                    //blocking call, reads the file
-                    std::string input(std::istreambuf_iterator<char>(instream.rdbuf()), std::istreambuf_iterator<char>());
-                    return md5(input);
+                    if (hash_index.emplace(file_name, static_cast<uint32_t>(hash_files.size())).second)
+                    {
+                        hash_files.push_back(file_name);
+                    }
+                };
+
+                for (auto i = 0U; i < files_to_parse.size(); ++i)
+                {
+                    add_file(files_to_parse[i].m_file_name);
+
+                    for (auto&& f : includes[i])
+                    {
+                        add_file(f);
+                    }
                 }
-                else
+
+                std::vector< std::string > hashes(hash_files.size());
+
+                for (auto i = 0U; i < hash_files.size(); ++i)
                 {
-                    raise_error("cannot open file for hash creation");
-                    return std::string();
+                    scheduler.add("hash", hash_files[i], [&hash_files, &hashes, &scanner, i]()
+                    {
+                        hashes[i] = scanner.hash(hash_files[i]);
+                    });
                 }
-            }
 
-            dependency_cache_item create_dependency_file(const std::string& file_name)
-            {
-                return  dependency_cache_item(  file_name, create_hash(file_name), dependency_type::file );
-            }
+                scheduler.run();
 
-            dependencies build_file_cache_item(const std::string& file_name, const std::vector< std::string> include_dirs, const std::vector<std::string> macros)
-            {
-                auto&& includes = get_includes(file_name, macros, include_dirs);
+                //copies, the items take the strings and the headers are shared
+                auto make_item = [&hash_index, &hashes](const std::string& file_name)
+                {
+                    return dependency_cache_item(std::string(file_name), std::string(hashes[hash_index[file_name]]), dependency_type::file);
+                };
 
-                dependencies r; 
-                r.m_files.insert(create_dependency_file(file_name));
+                std::vector< dependencies > r(files_to_parse.size());
 
-                for (auto&& i : includes)
+                for (auto i = 0U; i < files_to_parse.size(); ++i)
                 {
-                    r.m_files.insert(create_dependency_file(i));
+                    r[i].m_files.insert(make_item(files_to_parse[i].m_file_name));
+
+                    for (auto&& f : includes[i])
+                    {
+                        r[i].m_files.insert(make_item(f));
+                    }
                 }
 
                 return r;
@@ -130,10 +169,12 @@ namespace uc
                 }
             }
 
-            std::tuple< std::vector< item_meta_data>, file_cache >   build_caches(const std::vector< item_meta_data>& files_to_parse, const std::string& cache_file, const std::vector< dependency_cache_item >& static_dependencies )
+            std::tuple< std::vector< item_meta_data>, file_cache >   build_caches(const std::vector< item_meta_data>& files_to_parse, const std::string& cache_file, const std::vector< dependency_cache_item >& static_dependencies, uint32_t concurrency, build_trace* trace, include_scanner* scanner )
             {
-                std::vector< std::unordered_set < std::string > > includes;
+                include_scanner local_scanner;
+
                 auto&& cache = load_cache( cache_file );
+                auto&& file_cache_items = build_file_cache_items(files_to_parse, concurrency, trace, scanner != nullptr ? *scanner : local_scanner);
 
                 std::vector< uint32_t     >   files_indices;
                 std::vector< item_meta_data>  files_to_build;
@@ -144,7 +185,7 @@ namespace uc
                 for ( auto&& i : files_to_parse )
                 {
                     auto&& cache_item = prepare_cache_build_item(
-                                                                    prepare_cache_build_item(build_file_cache_item(i.m_file_name, i.m_additional_include_directories, i.m_preprocessor_directives), static_dependencies),
+                                                                    prepare_cache_build_item(std::move(file_cache_items[index]), static_dependencies),
                                                                     create_item_data_dependency(i));
                     auto&& found_cache_item = cache.m_cache_data.find(i.m_file_name);
                     bool  add_item = false;
@@ -6,6 +6,8 @@
 
 #include "uc_build_tasks_dependencies.h"
 #include "uc_build_tasks_shaders.h"
+#include "uc_build_tasks_scheduler.h"
+#include "uc_build_tasks_include_scanner.h"
 
 namespace uc
 {
@@ -33,7 +35,9 @@ namespace uc
             };
 
 
-            std::tuple< std::vector< item_meta_data>, file_cache >   build_caches( const std::vector< item_meta_data>& files_to_parse, const std::string& cache_file, const std::vector< dependency_cache_item >& static_dependencies  );
+            //scans and hashes the files on concurrency threads, 0 -> the number of hardware threads
+            //without a scanner, the includes and the hashes are not kept for the next build
+            std::tuple< std::vector< item_meta_data>, file_cache >   build_caches( const std::vector< item_meta_data>& files_to_parse, const std::string& cache_file, const std::vector< dependency_cache_item >& static_dependencies, uint32_t concurrency = 0, build_trace* trace = nullptr, include_scanner* scanner = nullptr );
                 
 
             file_cache load_cache(const std::string& cache_file);
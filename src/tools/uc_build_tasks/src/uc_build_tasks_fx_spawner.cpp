@@ -58,6 +58,12 @@ namespace UniqueCreator
                 }
 
                 System::Tuple < Int32, FXCSpawner::CompilerOutput, FXCSpawner::CompilerOutput >^  FXCSpawner::RunCompiler(System::String^ arguments )
+                {
+                    StartCompiler(arguments);
+                    return WaitCompiler();
+                }
+
+                void FXCSpawner::StartCompiler(System::String^ arguments)
                 {
                     Process^ process = gcnew Process();
 
@@ -78,9 +84,18 @@ namespace UniqueCreator
                     process->BeginOutputReadLine();
                     process->BeginErrorReadLine();
 
-                    process->WaitForExit();
-                   
-                    return gcnew System::Tuple<Int32, FXCSpawner::CompilerOutput, FXCSpawner::CompilerOutput >(process->ExitCode, m_std_output, m_std_error);
+                    m_process = process;
+                }
+
+                System::Tuple < Int32, FXCSpawner::CompilerOutput, FXCSpawner::CompilerOutput >^  FXCSpawner::WaitCompiler()
+                {
+                    //waits for the redirected output too
+                    m_process->WaitForExit();
+
+                    auto exit_code = m_process->ExitCode;
+                    m_process->Close();
+
+                    return gcnew System::Tuple<Int32, FXCSpawner::CompilerOutput, FXCSpawner::CompilerOutput >(exit_code, m_std_output, m_std_error);
                 }
 
                 void FXCSpawner::OnErrorDataHandler(System::Object^ /*sendingProcess*/, DataReceivedEventArgs^ outLine)
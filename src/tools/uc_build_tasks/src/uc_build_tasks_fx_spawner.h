@@ -19,6 +19,10 @@ namespace UniqueCreator
 
                 System::Tuple < System::Int32, CompilerOutput, CompilerOutput >^  RunCompiler(System::String^ arguments);
 
+                //starts the compiler without waiting, so several compilers can run at once
+                void StartCompiler(System::String^ arguments);
+                System::Tuple < System::Int32, CompilerOutput, CompilerOutput >^  WaitCompiler();
+
             private:
 
                 void OnErrorDataHandler(System::Object^ /*sendingProcess*/, System::Diagnostics::DataReceivedEventArgs^ outLine);
@@ -27,6 +31,7 @@ namespace UniqueCreator
                 CompilerOutput      m_std_output;
                 CompilerOutput      m_std_error;
                 System::String^     m_tool_executable;
+                System::Diagnostics::Process^ m_process;
             };
         }
     }
@@ -7,6 +7,9 @@
 #include <boost/wave.hpp>
 #include <boost/wave/cpplexer/cpp_lex_iterator.hpp>
 
+//the includes of the shaders are scanned concurrently, every scan has its own context, but the spirit grammars of wave share their definitions
+static_assert(BOOST_WAVE_SUPPORT_THREADING != 0, "boost wave must be built with the threading support");
+
 namespace uc
 {
     namespace build
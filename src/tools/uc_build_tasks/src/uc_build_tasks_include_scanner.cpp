@@ -0,0 +1,527 @@
+#include "pch.h"
+
+#include "uc_build_tasks_include_scanner.h"
+#include "uc_build_tasks_include_parser.h"
+#include "uc_build_tasks_error.h"
+
+#include "uc_build_md5.h"
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/unordered_map.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace uc
+{
+    namespace build
+    {
+        namespace tasks
+        {
+            namespace
+            {
+                namespace filesystem = std::experimental::filesystem;
+
+                //change this when the scan changes, the old caches are dropped
+                const uint32_t include_cache_version = 1;
+
+                struct include_directive
+                {
+                    std::string m_name;
+                    bool        m_system = false;   //#include <name>
+                };
+
+                struct file_scan
+                {
+                    uint64_t                        m_write_time        = 0;
+                    uint64_t                        m_size              = 0;
+                    std::string                     m_hash;
+                    std::vector<include_directive>  m_includes;
+                    bool                            m_computed_include  = false;    //#include MACRO, needs the preprocessor
+                };
+
+                inline bool is_space(char c)
+                {
+                    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+                }
+
+                inline bool is_identifier(char c)
+                {
+                    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+                }
+
+                //skips spaces and line continuations inside of a directive
+                size_t skip_directive_spaces(const std::string& s, size_t i)
+                {
+                    while (i < s.size())
+                    {
+                        if (is_space(s[i]))
+                        {
+                            i++;
+                        }
+                        else if (s[i] == '\\' && i + 1 < s.size() && s[i + 1] == '\n')
+                        {
+                            i += 2;
+                        }
+                        else if (s[i] == '\\' && i + 2 < s.size() && s[i + 1] == '\r' && s[i + 2] == '\n')
+                        {
+                            i += 3;
+                        }
+                        else
+                        {
+                            break;
+                        }
+                    }
+
+                    return i;
+                }
+
+                //i is after the #, returns the position after the directive name or the include operand
+                size_t scan_directive(const std::string& s, size_t i, file_scan& r)
+                {
+                    i = skip_directive_spaces(s, i);
+
+                    auto begin = i;
+                    while (i < s.size() && is_identifier(s[i]))
+                    {
+                        i++;
+                    }
+
+                    if (s.compare(begin, i - begin, "include") != 0)
+                    {
+                        return i;
+                    }
+
+                    i = skip_directive_spaces(s, i);
+
+                    if (i < s.size() && (s[i] == '"' || s[i] == '<'))
+                    {
+                        const char close = s[i] == '"' ? '"' : '>';
+
+                        include_directive d;
+                        d.m_system = s[i] == '<';
+
+                        auto name = ++i;
+                        while (i < s.size() && s[i] != close && s[i] != '\n')
+                        {
+                            i++;
+                        }
+
+                        if (i < s.size() && s[i] == close)
+                        {
+                            d.m_name = s.substr(name, i - name);
+                            r.m_includes.push_back(std::move(d));
+                            i++;
+                        }
+                    }
+                    else if (i < s.size() && s[i] != '\n')
+                    {
+                        r.m_computed_include = true;
+                    }
+
+                    return i;
+                }
+
+                //finds the #include directives, skips the comments and the literals
+                //the conditionals are not evaluated, so the includes of every branch are found
+                void scan_directives(const std::string& s, file_scan& r)
+                {
+                    const size_t n      = s.size();
+                    size_t i            = 0;
+                    bool   line_start   = true;
+
+                    while (i < n)
+                    {
+                        const char c = s[i];
+
+                        if (c == '\n')
+                        {
+                            line_start = true;
+                            i++;
+                        }
+                        else if (is_space(c))
+                        {
+                            i++;
+                        }
+                        else if (c == '/' && i + 1 < n && s[i + 1] == '/')
+                        {
+                            //to the end of the line, a line continuation continues the comment
+                            while (i < n && !(s[i] == '\n' && s[i - 1] != '\\' && !(s[i - 1] == '\r' && s[i - 2] == '\\')))
+                            {
+                                i++;
+                            }
+                        }
+                        else if (c == '/' && i + 1 < n && s[i + 1] == '*')
+                        {
+                            //a comment is a space, so a directive can follow it
+                            auto end = s.find("*/", i + 2);
+                            i = end == std::string::npos ? n : end + 2;
+                        }
+                        else if (c == '#' && line_start)
+                        {
+                            i = scan_directive(s, i + 1, r);
+                            line_start = false;
+                        }
+                        else if (c == '"' || c == '\'')
+                        {
+                            i++;
+                            while (i < n && s[i] != c && s[i] != '\n')
+                            {
+                                i += s[i] == '\\' ? 2 : 1;
+                            }
+
+                            //an unterminated literal, as the apostrophe in #error don't, ends at the line
+                            if (i < n && s[i] == c)
+                            {
+                                i++;
+                            }
+
+                            line_start = false;
+                        }
+                        else
+                        {
+                            line_start = false;
+                            i++;
+                        }
+                    }
+                }
+
+                //absolute, without . and .., the preprocessor reports the includes in the same way, so the names match across the scans
+                std::string normalize(const filesystem::path& p)
+                {
+                    filesystem::path r;
+
+                    for (auto&& e : filesystem::absolute(p))
+                    {
+                        if (e == ".")
+                        {
+                            continue;
+                        }
+
+                        if (e == "..")
+                        {
+                            if (r.has_relative_path())
+                            {
+                                r = r.parent_path();
+                            }
+
+                            continue;
+                        }
+
+                        r /= e;
+                    }
+
+                    return r.make_preferred().string();
+                }
+
+                std::string read_file(const std::string& file_name)
+                {
+                    std::ifstream f(file_name, std::ios_base::binary | std::ios_base::ate);
+
+                    if (!f.good())
+                    {
+                        std::string message = "cannot open " + file_name;
+                        raise_error(message.c_str());
+                    }
+
+                    std::string r(static_cast<size_t>(f.tellg()), '\0');
+                    f.seekg(0, std::ios_base::beg);
+                    f.read(&r[0], r.size());
+                    r.resize(static_cast<size_t>(f.gcount()));
+                    return r;
+                }
+            }
+        }
+    }
+}
+
+namespace boost
+{
+    namespace serialization
+    {
+        template<class Archive>
+        void serialize(Archive & ar, uc::build::tasks::include_directive & g, const unsigned int version)
+        {
+            ar & g.m_name;
+            ar & g.m_system;
+        }
+
+        template<class Archive>
+        void serialize(Archive & ar, uc::build::tasks::file_scan & g, const unsigned int version)
+        {
+            ar & g.m_write_time;
+            ar & g.m_size;
+            ar & g.m_hash;
+            ar & g.m_includes;
+            ar & g.m_computed_include;
+        }
+    }
+}
+
+namespace uc
+{
+    namespace build
+    {
+        namespace tasks
+        {
+            struct include_scanner::impl
+            {
+                include_scan_mode                               m_mode;
+
+                mutable std::mutex                              m_lock;
+                std::unordered_map< std::string, file_scan >    m_files;
+                std::unordered_set< std::string >               m_checked;      //files validated in this build, they are not checked again
+                std::unordered_map< std::string, bool >         m_exists;       //include candidates, valid for this build
+                include_scanner_statistics                      m_statistics;
+
+                explicit impl(include_scan_mode mode) : m_mode(mode)
+                {
+
+                }
+
+                //the cached scan, while the file does not change
+                file_scan scan(const std::string& file_name)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+
+                        if (m_checked.find(file_name) != m_checked.end())
+                        {
+                            return m_files[file_name];
+                        }
+                    }
+
+                    std::error_code e0;
+                    std::error_code e1;
+
+                    const filesystem::path p(file_name);
+                    const auto write_time   = static_cast<uint64_t>(filesystem::last_write_time(p, e0).time_since_epoch().count());
+                    const auto size         = static_cast<uint64_t>(filesystem::file_size(p, e1));
+
+                    if (e0 || e1)
+                    {
+                        std::string message = "cannot open " + file_name;
+                        raise_error(message.c_str());
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+
+                        auto&& it = m_files.find(file_name);
+                        if (it != m_files.end() && it->second.m_write_time == write_time && it->second.m_size == size)
+                        {
+                            m_checked.insert(file_name);
+                            m_statistics.m_time_hits++;
+                            return it->second;
+                        }
+                    }
+
+                    //the time is taken before the read, a change during the read is found in the next build
+                    const auto contents = read_file(file_name);
+                    const auto hash     = md5(contents);
+
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+
+                        //touched, but not changed
+                        auto&& it = m_files.find(file_name);
+                        if (it != m_files.end() && it->second.m_hash == hash)
+                        {
+                            it->second.m_write_time = write_time;
+                            it->second.m_size       = size;
+
+                            m_checked.insert(file_name);
+                            m_statistics.m_hash_hits++;
+                            return it->second;
+                        }
+                    }
+
+                    file_scan r;
+                    r.m_write_time  = write_time;
+                    r.m_size        = size;
+                    r.m_hash        = hash;
+
+                    scan_directives(contents, r);
+
+                    std::lock_guard<std::mutex> lock(m_lock);
+
+                    m_files[file_name] = r;
+                    m_checked.insert(file_name);
+                    m_statistics.m_scans++;
+                    return r;
+                }
+
+                bool exists(const std::string& file_name)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+
+                        auto&& it = m_exists.find(file_name);
+                        if (it != m_exists.end())
+                        {
+                            return it->second;
+                        }
+                    }
+
+                    std::error_code e;
+                    const bool r = filesystem::is_regular_file(filesystem::path(file_name), e);
+
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    m_exists[file_name] = r;
+                    return r;
+                }
+
+                //the quoted includes are searched next to the including file first, as the preprocessor does
+                std::string resolve(const filesystem::path& directory, const include_directive& d, const std::vector<std::string>& include_paths)
+                {
+                    if (!d.m_system)
+                    {
+                        auto r = normalize(directory / d.m_name);
+
+                        if (exists(r))
+                        {
+                            return r;
+                        }
+                    }
+
+                    for (auto&& i : include_paths)
+                    {
+                        if (!i.empty())
+                        {
+                            auto r = normalize(filesystem::path(i) / d.m_name);
+
+                            if (exists(r))
+                            {
+                                return r;
+                            }
+                        }
+                    }
+
+                    return std::string();
+                }
+
+                std::unordered_set< std::string > preprocess(const std::string& file_name, const std::vector<std::string>& defines, const std::vector<std::string>& include_paths)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_lock);
+                        m_statistics.m_preprocessed++;
+                    }
+
+                    std::unordered_set< std::string > r;
+
+                    for (auto&& i : get_includes(file_name, defines, include_paths))
+                    {
+                        r.insert(normalize(i));
+                    }
+
+                    return r;
+                }
+            };
+
+            include_scanner::include_scanner(include_scan_mode mode) : m_impl(std::make_unique<impl>(mode))
+            {
+
+            }
+
+            include_scanner::~include_scanner() = default;
+
+            void include_scanner::load(const std::string& file_name)
+            {
+                m_impl->m_files.clear();
+
+                std::ifstream ifs(file_name);
+
+                if (ifs.good())
+                {
+                    try
+                    {
+                        boost::archive::text_iarchive ia(ifs);
+
+                        uint32_t version = 0;
+                        ia >> version;
+
+                        if (version == include_cache_version)
+                        {
+                            ia >> m_impl->m_files;
+                        }
+                    }
+                    catch (const boost::archive::archive_exception&)
+                    {
+                        //a broken cache only costs the scans
+                        m_impl->m_files.clear();
+                    }
+                }
+            }
+
+            void include_scanner::save(const std::string& file_name) const
+            {
+                std::ofstream ofs(file_name);
+
+                if (ofs.good())
+                {
+                    boost::archive::text_oarchive oa(ofs);
+                    oa << include_cache_version;
+                    oa << m_impl->m_files;
+                }
+            }
+
+            std::unordered_set< std::string > include_scanner::includes(const std::string& file_name, const std::vector<std::string>& defines, const std::vector<std::string>& include_paths)
+            {
+                if (m_impl->m_mode == include_scan_mode::preprocessor)
+                {
+                    return m_impl->preprocess(file_name, defines, include_paths);
+                }
+
+                const auto root = normalize(file_name);
+
+                std::unordered_set< std::string >   r;
+                std::vector< std::string >          files = { root };
+
+                while (!files.empty())
+                {
+                    const auto f = std::move(files.back());
+                    files.pop_back();
+
+                    auto&& s = m_impl->scan(f);
+
+                    //the include depends on the defines, only the preprocessor knows it
+                    if (s.m_computed_include)
+                    {
+                        return m_impl->preprocess(file_name, defines, include_paths);
+                    }
+
+                    const auto directory = filesystem::path(f).parent_path();
+
+                    for (auto&& d : s.m_includes)
+                    {
+                        //not found includes are in the inactive branches, or the compiler reports them
+                        auto include = m_impl->resolve(directory, d, include_paths);
+
+                        if (!include.empty() && include != root && r.insert(include).second)
+                        {
+                            files.push_back(std::move(include));
+                        }
+                    }
+                }
+
+                return r;
+            }
+
+            std::string include_scanner::hash(const std::string& file_name)
+            {
+                return m_impl->scan(normalize(file_name)).m_hash;
+            }
+
+            include_scanner_statistics include_scanner::statistics() const
+            {
+                std::lock_guard<std::mutex> lock(m_impl->m_lock);
+                return m_impl->m_statistics;
+            }
+        }
+    }
+}
@@ -0,0 +1,64 @@
+// UniqueCreator.Build.Tasks.h
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace uc
+{
+    namespace build
+    {
+        namespace tasks
+        {
+            enum class include_scan_mode : uint32_t
+            {
+                fast            = 0,    //scans the #include lines of every branch, the preprocessor runs only for includes through macros
+                preprocessor    = 1     //runs the preprocessor for every shader, exact with the defines, but slow
+            };
+
+            struct include_scanner_statistics
+            {
+                uint64_t m_time_hits        = 0;    //files with the cached write time and size
+                uint64_t m_hash_hits        = 0;    //files read, but with the cached contents
+                uint64_t m_scans            = 0;    //files read and scanned
+                uint64_t m_preprocessed     = 0;    //shaders which needed the preprocessor
+            };
+
+            //finds the includes of the shaders and the hashes of their contents
+            //the #include lines and the hashes of the files are cached across the builds, keyed by the write time and the size, and then by the contents
+            //the scan does not evaluate the conditionals, so the files of every branch are dependencies, which costs rebuilds, but never misses a change
+            //thread safe, except load and save
+            class include_scanner
+            {
+                public:
+
+                explicit include_scanner(include_scan_mode mode = include_scan_mode::fast);
+                ~include_scanner();
+
+                include_scanner(const include_scanner&) = delete;
+                include_scanner& operator=(const include_scanner&) = delete;
+
+                //a missing or an old cache file starts an empty cache
+                void load(const std::string& file_name);
+                void save(const std::string& file_name) const;
+
+                //the files included by file_name, without file_name, as normalized absolute paths
+                std::unordered_set< std::string > includes(const std::string& file_name, const std::vector<std::string>& defines, const std::vector<std::string>& include_paths);
+
+                //md5 of the contents
+                std::string hash(const std::string& file_name);
+
+                include_scanner_statistics statistics() const;
+
+                private:
+
+                struct impl;
+                std::unique_ptr<impl> m_impl;
+            };
+        }
+    }
+}
@@ -0,0 +1,240 @@
+#include "pch.h"
+
+#include "uc_build_tasks_scheduler.h"
+#include "uc_build_tasks_error.h"
+
+#include <uc_dev/build/build_trace.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace uc
+{
+    namespace build
+    {
+        namespace tasks
+        {
+            struct build_trace::impl
+            {
+                ::uc::build::build_trace m_trace;
+            };
+
+            build_trace::build_trace() : m_impl(std::make_unique<impl>())
+            {
+
+            }
+
+            build_trace::~build_trace() = default;
+
+            uint64_t build_trace::now() const
+            {
+                return m_impl->m_trace.now();
+            }
+
+            void build_trace::add(const std::string& category, const std::string& name, uint64_t begin, uint64_t end, uint32_t lane)
+            {
+                m_impl->m_trace.add(category, name, begin, end, lane);
+            }
+
+            uint64_t build_trace::duration(const std::string& category) const
+            {
+                return m_impl->m_trace.duration(category);
+            }
+
+            void build_trace::save(const std::string& file_name) const
+            {
+                m_impl->m_trace.save(file_name);
+            }
+
+            uint32_t default_concurrency(uint32_t concurrency)
+            {
+                if (concurrency == 0)
+                {
+                    concurrency = std::thread::hardware_concurrency();
+                }
+
+                return std::max(concurrency, 1U);
+            }
+
+            struct job_scheduler::impl
+            {
+                struct job
+                {
+                    std::string             m_category;
+                    std::string             m_name;
+                    std::function<void()>   m_function;
+                    std::vector<job_id>     m_dependents;
+                    uint32_t                m_pending   = 0;    //unfinished dependencies
+                    bool                    m_skipped   = false;
+                    std::exception_ptr      m_error;
+                };
+
+                uint32_t                    m_concurrency;
+                build_trace*                m_trace;
+                std::vector<job>            m_jobs;
+
+                std::mutex                  m_lock;
+                std::condition_variable     m_ready_changed;
+                std::deque<job_id>          m_ready;
+                size_t                      m_remaining = 0;
+
+                impl(uint32_t concurrency, build_trace* trace) : m_concurrency(default_concurrency(concurrency)), m_trace(trace)
+                {
+
+                }
+
+                void work(uint32_t lane)
+                {
+                    std::unique_lock<std::mutex> lock(m_lock);
+
+                    while (true)
+                    {
+                        m_ready_changed.wait(lock, [this]() { return !m_ready.empty() || m_remaining == 0; });
+
+                        if (m_ready.empty())
+                        {
+                            return;
+                        }
+
+                        auto  id = m_ready.front();
+                        auto& j  = m_jobs[id];
+                        m_ready.pop_front();
+
+                        lock.unlock();
+
+                        if (!j.m_skipped)
+                        {
+                            auto begin = m_trace ? m_trace->now() : 0;
+
+                            try
+                            {
+                                j.m_function();
+                            }
+                            catch (...)
+                            {
+                                j.m_error = std::current_exception();
+                            }
+
+                            if (m_trace)
+                            {
+                                m_trace->add(j.m_category, j.m_name, begin, m_trace->now(), lane);
+                            }
+                        }
+
+                        lock.lock();
+
+                        const bool failed = j.m_skipped || j.m_error;
+
+                        for (auto&& d : j.m_dependents)
+                        {
+                            auto& dependent = m_jobs[d];
+
+                            dependent.m_skipped = dependent.m_skipped || failed;
+
+                            if (--dependent.m_pending == 0)
+                            {
+                                m_ready.push_back(d);
+                            }
+                        }
+
+                        m_remaining--;
+                        m_ready_changed.notify_all();
+                    }
+                }
+            };
+
+            job_scheduler::job_scheduler(uint32_t concurrency, build_trace* trace) : m_impl(std::make_unique<impl>(concurrency, trace))
+            {
+
+            }
+
+            job_scheduler::~job_scheduler() = default;
+
+            job_scheduler::job_id job_scheduler::add(const std::string& category, const std::string& name, std::function<void()> job, const std::vector<job_id>& dependencies)
+            {
+                auto&& jobs = m_impl->m_jobs;
+                auto   id   = static_cast<job_id>(jobs.size());
+
+                impl::job j;
+                j.m_category    = category;
+                j.m_name        = name;
+                j.m_function    = std::move(job);
+
+                for (auto&& d : dependencies)
+                {
+                    //dependencies are added first, so the graph has no cycles
+                    if (d >= id)
+                    {
+                        raise_error("job dependency is not added yet");
+                    }
+
+                    jobs[d].m_dependents.push_back(id);
+                    j.m_pending++;
+                }
+
+                jobs.push_back(std::move(j));
+                return id;
+            }
+
+            void job_scheduler::run()
+            {
+                auto&& jobs = m_impl->m_jobs;
+
+                m_impl->m_ready.clear();
+                m_impl->m_remaining = jobs.size();
+
+                for (auto i = 0U; i < jobs.size(); ++i)
+                {
+                    if (jobs[i].m_pending == 0)
+                    {
+                        m_impl->m_ready.push_back(i);
+                    }
+                }
+
+                //the calling thread is one of the workers
+                auto workers = static_cast<uint32_t>(std::min<size_t>(m_impl->m_concurrency, jobs.size()));
+
+                std::vector<std::thread> threads;
+                threads.reserve(workers);
+
+                for (auto i = 1U; i < workers; ++i)
+                {
+                    threads.emplace_back([this, i]()
+                    {
+                        m_impl->work(i);
+                    });
+                }
+
+                m_impl->work(0);
+
+                for (auto&& t : threads)
+                {
+                    t.join();
+                }
+
+                std::exception_ptr error;
+
+                for (auto&& j : jobs)
+                {
+                    if (j.m_error)
+                    {
+                        error = j.m_error;
+                        break;
+                    }
+                }
+
+                jobs.clear();
+
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+    }
+}
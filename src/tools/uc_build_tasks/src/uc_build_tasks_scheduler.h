@@ -0,0 +1,76 @@
+// UniqueCreator.Build.Tasks.h
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+//the header is included by the managed code, which cannot include <thread> and <mutex>, the threads live in the native translation unit
+
+namespace uc
+{
+    namespace build
+    {
+        namespace tasks
+        {
+            //timings of the build steps, saved in the chrome://tracing format
+            //forwards to uc::build::build_trace, which is shared with the batch tool and cannot be included by the managed code
+            class build_trace
+            {
+                public:
+
+                build_trace();
+                ~build_trace();
+
+                build_trace(const build_trace&) = delete;
+                build_trace& operator=(const build_trace&) = delete;
+
+                uint64_t now() const;
+
+                void add(const std::string& category, const std::string& name, uint64_t begin, uint64_t end, uint32_t lane);
+
+                //total time of the events of a category, in microseconds
+                uint64_t duration(const std::string& category) const;
+
+                void save(const std::string& file_name) const;
+
+                private:
+
+                struct impl;
+                std::unique_ptr<impl> m_impl;
+            };
+
+            //0 -> the number of hardware threads
+            uint32_t default_concurrency(uint32_t concurrency);
+
+            //runs a graph of jobs on a bounded number of threads
+            //jobs start when their dependencies finish, jobs depending on failed jobs are skipped
+            class job_scheduler
+            {
+                public:
+
+                using job_id = uint32_t;
+
+                explicit job_scheduler(uint32_t concurrency = 0, build_trace* trace = nullptr);
+                ~job_scheduler();
+
+                job_scheduler(const job_scheduler&) = delete;
+                job_scheduler& operator=(const job_scheduler&) = delete;
+
+                job_id add(const std::string& category, const std::string& name, std::function<void()> job, const std::vector<job_id>& dependencies = std::vector<job_id>());
+
+                //runs the added jobs and clears them
+                //rethrows the exception of the first failed job in the order of adding, so the reported error does not depend on the timing
+                void run();
+
+                private:
+
+                struct impl;
+                std::unique_ptr<impl> m_impl;
+            };
+        }
+    }
+}
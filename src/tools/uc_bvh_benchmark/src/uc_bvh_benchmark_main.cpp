@@ -0,0 +1,142 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <uc_dev/gx/cull/bvh.h>
+#include <uc_dev/gx/cull/frustum_cull.h>
+#include <uc_dev/gx/cull/object_bounds.h>
+
+//builds the 4 wide bvh over a scene of boxes and runs frustum, sphere and ray queries against it and against the linear frustum cull and brute force loops
+//usage: uc_bvh_benchmark [objects] [queries]
+
+namespace
+{
+    using namespace uc;
+
+    double measure(const std::function<void()>& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    void print(const char* name, double ms, uint32_t queries)
+    {
+        std::printf("%-28s %10.2f ms %10.4f ms/query\n", name, ms, queries ? ms / queries : 0.0);
+    }
+
+    std::vector<uint32_t>& sorted(std::vector<uint32_t>& v)
+    {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    try
+    {
+        const uint32_t objects  = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 100000;
+        const uint32_t queries  = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 100;
+
+        std::cout << "objects:" << objects << " queries:" << queries << std::endl;
+
+        //a city like scene, wide on x and z, flat on y
+        std::mt19937                            random(1);
+        std::uniform_real_distribution<float>   position(-1000.0f, 1000.0f);
+        std::uniform_real_distribution<float>   size(0.5f, 8.0f);
+
+        std::vector<math::aabb>     boxes;
+        gx::cull::object_bounds     bounds;
+
+        for (auto i = 0U; i < objects; ++i)
+        {
+            auto c = math::point3(position(random), position(random) * 0.05f, position(random));
+            auto e = math::splat(size(random));
+            auto b = math::make_aabb(math::sub(c, e), math::add(c, e));
+
+            boxes.push_back(b);
+            bounds.add(b);
+        }
+
+        gx::cull::bvh tree;
+        double build_time = measure([&]() { tree.build(boxes.data(), objects); });
+        double refit_time = measure([&]() { tree.refit(boxes.data()); });
+
+        std::cout << "nodes:" << tree.node_count() << " depth:" << tree.depth() << std::endl;
+
+        double bvh_frustum_time     = 0.0;
+        double linear_frustum_time  = 0.0;
+        double bvh_sphere_time      = 0.0;
+        double brute_sphere_time    = 0.0;
+        double bvh_ray_time         = 0.0;
+        uint32_t mismatches         = 0;
+
+        std::vector<uint32_t> a;
+        std::vector<uint32_t> b;
+
+        for (auto q = 0U; q < queries; ++q)
+        {
+            auto eye    = math::point3(position(random), 20.0f, position(random));
+            auto target = math::point3(position(random), 0.0f, position(random));
+
+            auto v = math::look_at_lh(eye, target, math::vector3(0.0f, 1.0f, 0.0f));
+            auto p = math::perspective_fov_lh(3.141592654f / 3.0f, 16.0f / 9.0f, 0.1f, 500.0f);
+            auto f = math::make_frustum_planes(math::mul(v, p));
+
+            a.clear();
+            bvh_frustum_time    += measure([&]() { tree.query(f, a); });
+            linear_frustum_time += measure([&]() { gx::cull::frustum_cull(f, bounds, b); });
+
+            mismatches += sorted(a) == b ? 0 : 1;
+
+            const float radius = 50.0f;
+
+            a.clear();
+            b.clear();
+            bvh_sphere_time += measure([&]() { tree.query(target, radius, a); });
+            brute_sphere_time += measure([&]()
+            {
+                for (auto i = 0U; i < objects; ++i)
+                {
+                    auto d = math::max(math::max(math::sub(math::bounds_min(boxes[i]), target), math::sub(target, math::bounds_max(boxes[i]))), math::zero());
+                    if (math::get_x(math::dot3(d, d)) <= radius * radius)
+                    {
+                        b.push_back(i);
+                    }
+                }
+            });
+
+            mismatches += sorted(a) == b ? 0 : 1;
+
+            a.clear();
+            bvh_ray_time += measure([&]() { tree.query(eye, math::normalize3(math::sub(target, eye)), 2000.0f, a); });
+        }
+
+        std::printf("%-28s %10.2f ms\n", "bvh build", build_time);
+        std::printf("%-28s %10.2f ms\n", "bvh refit", refit_time);
+        print("bvh frustum", bvh_frustum_time, queries);
+        print("linear frustum cull", linear_frustum_time, queries);
+        print("bvh sphere", bvh_sphere_time, queries);
+        print("brute force sphere", brute_sphere_time, queries);
+        print("bvh ray", bvh_ray_time, queries);
+        std::cout << "mismatched queries:" << mismatches << std::endl;
+
+        return mismatches == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,325 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <uc_dev/gx/cull/cluster_cull.h>
+#include <uc_dev/gx/lip/model.h>
+#include <uc_dev/gx/import/geo/meshlet_builder.h>
+
+//splits a scene of tessellated spheres into meshlets and culls them from a camera that circles the scene: a scalar loop and the sse kernel over the scene and per range
+//checks the kernel agrees with the scalar loop, and that every culled meshlet is behind a plane or has only back faces
+//usage: uc_cluster_cull_benchmark [spheres] [frames]
+
+namespace
+{
+    using namespace uc;
+
+    namespace geo = gx::import::geo;
+
+    struct face_range
+    {
+        uint32_t m_begin;
+        uint32_t m_end;
+    };
+
+    struct scene
+    {
+        std::vector<geo::storage_position>  m_positions;
+        std::vector<geo::face>              m_faces;
+        std::vector<face_range>             m_ranges;       //the faces of every sphere
+    };
+
+    double measure(const std::function<void()>& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    math::frustum_planes make_view(math::afloat4 eye, math::afloat4 look_at, float fov, float z_far)
+    {
+        auto v = math::look_at_lh(eye, look_at, math::vector3(0.0f, 1.0f, 0.0f));
+        auto p = math::perspective_fov_lh(fov, 16.0f / 9.0f, 0.1f, z_far);
+        return math::make_frustum_planes(math::mul(v, p));
+    }
+
+    void print(const char* name, double ms, uint32_t frames)
+    {
+        std::printf("%-28s %10.2f ms %10.3f ms/frame\n", name, ms, frames ? ms / frames : 0.0);
+    }
+
+    //latitude and longitude grid, the front faces point out of the sphere
+    void add_sphere(scene& s, float x, float y, float z, float radius, uint32_t rings, uint32_t segments)
+    {
+        const uint32_t  first   = static_cast<uint32_t>(s.m_positions.size());
+        const float     pi      = 3.141592654f;
+
+        for (auto r = 0U; r <= rings; ++r)
+        {
+            const float theta = pi * r / rings;
+
+            for (auto k = 0U; k <= segments; ++k)
+            {
+                const float phi = 2.0f * pi * k / segments;
+
+                geo::storage_position p;
+                p.x = x + radius * std::sin(theta) * std::cos(phi);
+                p.y = y + radius * std::cos(theta);
+                p.z = z + radius * std::sin(theta) * std::sin(phi);
+                s.m_positions.push_back(p);
+            }
+        }
+
+        face_range range = { static_cast<uint32_t>(s.m_faces.size()), 0 };
+
+        auto add_face = [&](uint32_t a, uint32_t b, uint32_t c)
+        {
+            const auto& p0 = s.m_positions[a];
+            const auto& p1 = s.m_positions[b];
+            const auto& p2 = s.m_positions[c];
+
+            //skip the triangles collapsed at the poles
+            const double e0[3] = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+            const double e1[3] = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+            const double n[3]  = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+            const double o[3]  = { p0.x - x, p0.y - y, p0.z - z };
+            const double d     = n[0] * o[0] + n[1] * o[1] + n[2] * o[2];
+
+            if (d != 0.0)
+            {
+                geo::face f;
+                f.v0 = a;
+                f.v1 = d > 0.0 ? b : c;
+                f.v2 = d > 0.0 ? c : b;
+                s.m_faces.push_back(f);
+            }
+        };
+
+        for (auto r = 0U; r < rings; ++r)
+        {
+            for (auto k = 0U; k < segments; ++k)
+            {
+                const uint32_t v0 = first + r * (segments + 1) + k;
+                const uint32_t v1 = v0 + 1;
+                const uint32_t v2 = v0 + segments + 1;
+                const uint32_t v3 = v2 + 1;
+
+                add_face(v0, v1, v2);
+                add_face(v1, v3, v2);
+            }
+        }
+
+        range.m_end = static_cast<uint32_t>(s.m_faces.size());
+        s.m_ranges.push_back(range);
+    }
+
+    //the same operations in the same order as the sse kernel, so the results match exactly
+    bool visible(const math::frustum_planes& f, const float* eye, const lip::meshlet_bounds& b)
+    {
+        for (auto i = 0U; i < math::frustum_planes::plane_count::value; ++i)
+        {
+            alignas(16) float p[4];
+            math::store4(&p[0], f.m_planes[i].m_value);
+
+            const float d = (p[0] * b.m_center.m_x + p[1] * b.m_center.m_y) + (p[2] * b.m_center.m_z + p[3]);
+
+            if (!(d >= -b.m_radius))
+            {
+                return false;
+            }
+        }
+
+        const float dx  = b.m_center.m_x - eye[0];
+        const float dy  = b.m_center.m_y - eye[1];
+        const float dz  = b.m_center.m_z - eye[2];
+
+        const float d   = (dx * b.m_cone_axis.m_x + dy * b.m_cone_axis.m_y) + dz * b.m_cone_axis.m_z;
+        const float l   = std::sqrt((dx * dx + dy * dy) + dz * dz);
+
+        return !(d >= b.m_cone_cutoff * l + b.m_radius);
+    }
+
+    //a culled meshlet must have all vertices behind one plane, or only faces that point away from the eye
+    bool culled_correctly(const math::frustum_planes& f, const float* eye, const scene& s, const geo::meshlet_set& m, uint32_t index)
+    {
+        const auto& c = m.m_meshlets[index];
+
+        auto position = [&](uint32_t local)
+        {
+            return s.m_positions[m.m_vertices[c.m_vertex_offset + local]];
+        };
+
+        for (auto i = 0U; i < math::frustum_planes::plane_count::value; ++i)
+        {
+            alignas(16) float p[4];
+            math::store4(&p[0], f.m_planes[i].m_value);
+
+            bool behind = true;
+
+            for (auto v = 0U; v < c.m_vertex_count && behind; ++v)
+            {
+                const auto& q = position(v);
+                behind = static_cast<double>(p[0]) * q.x + static_cast<double>(p[1]) * q.y + static_cast<double>(p[2]) * q.z + p[3] < 1e-4;
+            }
+
+            if (behind)
+            {
+                return true;
+            }
+        }
+
+        for (auto t = 0U; t < c.m_triangle_count; ++t)
+        {
+            const uint8_t* v = &m.m_triangles[c.m_triangle_offset + t * 3];
+
+            const auto& p0 = position(v[0]);
+            const auto& p1 = position(v[1]);
+            const auto& p2 = position(v[2]);
+
+            const double e0[3] = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+            const double e1[3] = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+            const double n[3]  = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+            const double l     = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            const double d     = n[0] * (p0.x - eye[0]) + n[1] * (p0.y - eye[1]) + n[2] * (p0.z - eye[2]);
+
+            //front facing, the eye is in front of the triangle plane
+            if (l > 0.0 && d < -1e-4 * l)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    try
+    {
+        const uint32_t spheres  = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 400;
+        const uint32_t frames   = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 100;
+
+        std::mt19937                            random(1);
+        std::uniform_real_distribution<float>   position(-200.0f, 200.0f);
+        std::uniform_real_distribution<float>   size(1.0f, 6.0f);
+
+        scene s;
+
+        for (auto i = 0U; i < spheres; ++i)
+        {
+            add_sphere(s, position(random), position(random) * 0.05f, position(random), size(random), 24, 48);
+        }
+
+        const geo::meshlet_set m = geo::build_meshlets(s.m_faces, s.m_positions, s.m_ranges);
+
+        std::vector<lip::meshlet_bounds> bounds(m.m_bounds.size());
+
+        for (auto i = 0U; i < m.m_bounds.size(); ++i)
+        {
+            auto&& b = m.m_bounds[i];
+
+            bounds[i].m_center      = { b.m_center[0], b.m_center[1], b.m_center[2] };
+            bounds[i].m_radius      = b.m_radius;
+            bounds[i].m_cone_axis   = { b.m_cone_axis[0], b.m_cone_axis[1], b.m_cone_axis[2] };
+            bounds[i].m_cone_cutoff = b.m_cone_cutoff;
+        }
+
+        const uint32_t count = static_cast<uint32_t>(bounds.size());
+
+        std::cout << "spheres:" << spheres << " triangles:" << s.m_faces.size() << " meshlets:" << count << " frames:" << frames << std::endl;
+
+        std::vector<uint32_t> scalar;
+        std::vector<uint32_t> sse(count);
+        std::vector<uint32_t> ranges(count);
+
+        double      scalar_time     = 0.0;
+        double      sse_time        = 0.0;
+        double      ranges_time     = 0.0;
+        uint32_t    mismatches      = 0;
+        uint32_t    wrong_culls     = 0;
+        uint64_t    visible_total   = 0;
+        uint64_t    triangles_total = 0;
+
+        for (auto f = 0U; f < frames; ++f)
+        {
+            //circle the scene from inside, looking across it
+            const float angle   = 2.0f * 3.141592654f * f / std::max(frames, 1U);
+            const float e[4]    = { 60.0f * std::cos(angle), 8.0f, 60.0f * std::sin(angle), 1.0f };
+
+            const auto eye      = math::point3(e[0], e[1], e[2]);
+            const auto view     = make_view(eye, math::point3(-e[2], 0.0f, e[0]), 3.141592654f / 3.0f, 600.0f);
+
+            uint32_t sse_count      = 0;
+            uint32_t ranges_count   = 0;
+
+            scalar_time += measure([&]()
+            {
+                scalar.clear();
+                for (auto i = 0U; i < count; ++i)
+                {
+                    if (visible(view, &e[0], bounds[i]))
+                    {
+                        scalar.push_back(i);
+                    }
+                }
+            });
+
+            sse_time += measure([&]() { sse_count = gx::cull::cluster_cull(view, eye, bounds.data(), count, 0, sse.data()); });
+
+            ranges_time += measure([&]()
+            {
+                ranges_count = 0;
+                for (auto&& r : m.m_ranges)
+                {
+                    ranges_count += gx::cull::cluster_cull(view, eye, &bounds[r.m_begin], r.m_end - r.m_begin, r.m_begin, &ranges[ranges_count]);
+                }
+            });
+
+            bool agree = std::vector<uint32_t>(sse.begin(), sse.begin() + sse_count) == scalar;
+            agree = agree && std::vector<uint32_t>(ranges.begin(), ranges.begin() + ranges_count) == scalar;
+            mismatches += agree ? 0 : 1;
+
+            //walk the culled meshlets between the visible ones
+            uint32_t next = 0;
+            for (auto i = 0U; i < count; ++i)
+            {
+                if (next < scalar.size() && scalar[next] == i)
+                {
+                    triangles_total += m.m_meshlets[i].m_triangle_count;
+                    ++next;
+                }
+                else
+                {
+                    wrong_culls += culled_correctly(view, &e[0], s, m, i) ? 0 : 1;
+                }
+            }
+
+            visible_total += scalar.size();
+        }
+
+        std::cout << "visible meshlets per frame:" << visible_total / std::max(frames, 1U) << " visible triangles per frame:" << triangles_total / std::max(frames, 1U) << std::endl;
+        print("scalar sphere and cone", scalar_time, frames);
+        print("sse kernel", sse_time, frames);
+        print("sse kernel per range", ranges_time, frames);
+        std::cout << "mismatched frames:" << mismatches << " wrongly culled meshlets:" << wrong_culls << std::endl;
+
+        return mismatches == 0 && wrong_culls == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
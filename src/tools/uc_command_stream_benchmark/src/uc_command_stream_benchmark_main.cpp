@@ -0,0 +1,309 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <uc_dev/gx/cmd/command_stream.h>
+#include <uc_dev/gx/cmd/null_backend.h>
+
+//records the passes of a frame into command streams, as the render worlds do, and replays them on the null backend
+//measures the cpu cost of the recording and of the replay, checks the streams are valid, count the expected work and stop allocating after the first frame
+//usage: uc_command_stream_benchmark [objects] [frames]
+
+namespace
+{
+    using namespace uc::gx::cmd;
+
+    struct draw_constants
+    {
+        float m_world[16];
+    };
+
+    struct frame_constants
+    {
+        float m_view_projection[16];
+        float m_light[4];
+    };
+
+    //the objects of a scene, few pipeline states and meshes
+    struct object
+    {
+        uint32_t        m_pso;
+        uint32_t        m_mesh;
+        draw_constants  m_constants;
+    };
+
+    struct scene
+    {
+        std::vector<object>     m_objects;
+        uint32_t                m_psos[8];          //the handles are only compared
+        uint32_t                m_depth_buffer;
+        uint32_t                m_shadow_buffer;
+        uint32_t                m_color_buffer;
+    };
+
+    const uint32_t cascades         = 4;
+    const uint32_t index_count      = 3 * 1024;
+
+    double measure(const std::function<void()>& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    void print(const char* name, double ms, uint32_t frames)
+    {
+        std::printf("%-28s %10.2f ms %10.3f ms/frame\n", name, ms, frames ? ms / frames : 0.0);
+    }
+
+    scene make_scene(uint32_t objects)
+    {
+        scene s = {};
+
+        std::mt19937                            random(1);
+        std::uniform_int_distribution<uint32_t> pso(0, 7);
+        std::uniform_int_distribution<uint32_t> mesh(0, 31);
+        std::uniform_real_distribution<float>   position(-100.0f, 100.0f);
+
+        for (auto i = 0U; i < objects; ++i)
+        {
+            object o = {};
+
+            o.m_pso     = pso(random);
+            o.m_mesh    = mesh(random);
+
+            o.m_constants.m_world[0]  = 1.0f;
+            o.m_constants.m_world[5]  = 1.0f;
+            o.m_constants.m_world[10] = 1.0f;
+            o.m_constants.m_world[12] = position(random);
+            o.m_constants.m_world[13] = position(random);
+            o.m_constants.m_world[14] = position(random);
+            o.m_constants.m_world[15] = 1.0f;
+
+            s.m_objects.push_back(o);
+        }
+
+        //sorted by state, as the render queue sorts them
+        std::sort(s.m_objects.begin(), s.m_objects.end(), [](const object& a, const object& b)
+        {
+            return a.m_pso < b.m_pso || (a.m_pso == b.m_pso && a.m_mesh < b.m_mesh);
+        });
+
+        return s;
+    }
+
+    view_port make_view_port(float width, float height)
+    {
+        return { 0.0f, 0.0f, width, height, 0.0f, 1.0f };
+    }
+
+    rectangle make_rectangle(int32_t width, int32_t height)
+    {
+        return { 0, 0, width, height };
+    }
+
+    void draw_objects(command_stream& c, const scene& s)
+    {
+        uint32_t pso  = ~0U;
+        uint32_t mesh = ~0U;
+
+        for (auto&& o : s.m_objects)
+        {
+            if (o.m_pso != pso)
+            {
+                pso = o.m_pso;
+                c.set_graphics_pipeline_state(&s.m_psos[pso]);
+            }
+
+            if (o.m_mesh != mesh)
+            {
+                mesh = o.m_mesh;
+                c.set_vertex_buffer(0, { 0x100000ULL * (mesh + 1), 65536, 32 });
+                c.set_index_buffer({ 0x100000ULL * (mesh + 1) + 65536, index_count * 2, index_format_r16_uint });
+            }
+
+            c.set_graphics_dynamic_constant_buffer(1, 0, &o.m_constants, sizeof(o.m_constants));
+            c.draw_indexed_instanced(index_count, 1, 0, 0, 0);
+        }
+    }
+
+    void record_depth(command_stream& c, const scene& s, const frame_constants& f)
+    {
+        c.begin_event(L"depth");
+        c.track_resource(&s.m_depth_buffer, resource_state_depth_read);
+        c.transition_resource(&s.m_depth_buffer, resource_state_depth_write);
+        c.clear_depth_stencil({ &s.m_depth_buffer, view_type::depth_buffer }, clear_depth, 0.0f, 0);
+        c.set_render_targets({}, { &s.m_depth_buffer, view_type::depth_buffer });
+        c.set_view_port(make_view_port(1920.0f, 1080.0f));
+        c.set_scissor_rectangle(make_rectangle(1920, 1080));
+        c.set_descriptor_heaps();
+        c.set_primitive_topology(primitive_topology_triangle_list);
+        c.set_graphics_constant_buffer(0, &f, sizeof(f));
+        draw_objects(c, s);
+        c.end_event();
+    }
+
+    void record_shadows(command_stream& c, const scene& s, const frame_constants& f)
+    {
+        c.begin_event(L"shadows");
+        c.track_resource(&s.m_shadow_buffer, resource_state_pixel_shader_resource, cascades);
+
+        for (auto i = 0U; i < cascades; ++i)
+        {
+            frame_constants cascade = f;
+            cascade.m_light[3] = static_cast<float>(i);
+
+            c.transition_subresource(&s.m_shadow_buffer, i, resource_state_depth_write);
+            c.clear_depth_stencil({ &s.m_shadow_buffer, view_type::depth_buffer }, clear_depth, 0.0f, 0);
+            c.set_render_targets({}, { &s.m_shadow_buffer, view_type::depth_buffer });
+            c.set_view_port(make_view_port(2048.0f, 2048.0f));
+            c.set_scissor_rectangle(make_rectangle(2048, 2048));
+            c.set_descriptor_heaps();
+            c.set_primitive_topology(primitive_topology_triangle_list);
+            c.set_graphics_constant_buffer(0, &cascade, sizeof(cascade));
+            draw_objects(c, s);
+        }
+
+        c.transition_resource(&s.m_shadow_buffer, resource_state_pixel_shader_resource);
+        c.end_event();
+    }
+
+    void record_main(command_stream& c, const scene& s, const frame_constants& f)
+    {
+        c.begin_event(L"main");
+        c.track_resource(&s.m_color_buffer, resource_state_common);
+        c.transition_resource(&s.m_color_buffer, resource_state_render_target);
+        c.transition_resource(&s.m_depth_buffer, resource_state_depth_write, resource_state_depth_read);
+        c.clear_render_target({ &s.m_color_buffer, view_type::color_buffer });
+        c.set_render_targets({ &s.m_color_buffer, view_type::color_buffer }, { &s.m_depth_buffer, view_type::depth_buffer });
+        c.set_view_port(make_view_port(1920.0f, 1080.0f));
+        c.set_scissor_rectangle(make_rectangle(1920, 1080));
+        c.set_descriptor_heaps();
+        c.set_primitive_topology(primitive_topology_triangle_list);
+        c.set_graphics_constant_buffer(0, &f, sizeof(f));
+        c.set_graphics_dynamic_descriptor(2, 0x1000);
+        draw_objects(c, s);
+        c.transition_resource(&s.m_color_buffer, resource_state_pixel_shader_resource);
+        c.end_event();
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    try
+    {
+        const uint32_t objects  = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 5000;
+        const uint32_t frames   = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 100;
+
+        const scene s = make_scene(objects);
+
+        //one stream per pass, as the passes record on their own threads
+        command_stream depth;
+        command_stream shadows;
+        command_stream main_pass;
+
+        frame_constants f = {};
+
+        auto record = [&]()
+        {
+            depth.reset();
+            shadows.reset();
+            main_pass.reset();
+
+            record_depth(depth, s, f);
+            record_shadows(shadows, s, f);
+            record_main(main_pass, s, f);
+        };
+
+        //the first frame allocates the blocks
+        record();
+
+        const size_t capacity = depth.capacity() + shadows.capacity() + main_pass.capacity();
+
+        double      record_time = 0.0;
+        double      replay_time = 0.0;
+        uint32_t    errors      = 0;
+        uint32_t    growths     = 0;
+
+        null_backend_statistics totals;
+
+        for (auto i = 0U; i < frames; ++i)
+        {
+            f.m_light[0] = static_cast<float>(i);
+
+            record_time += measure(record);
+
+            growths += depth.capacity() + shadows.capacity() + main_pass.capacity() != capacity ? 1 : 0;
+
+            replay_time += measure([&]()
+            {
+                //one backend per stream, as every stream is replayed on its own command list
+                for (auto&& stream : { &depth, &shadows, &main_pass })
+                {
+                    null_backend b;
+                    execute(*stream, b);
+                    b.finish();
+
+                    errors += b.error_count();
+
+                    auto&& st = b.statistics();
+                    totals.m_draws              += st.m_draws;
+                    totals.m_vertices           += st.m_vertices;
+                    totals.m_constant_bytes     += st.m_constant_bytes;
+                    totals.m_barriers           += st.m_barriers;
+                    totals.m_pipeline_changes   += st.m_pipeline_changes;
+
+                    for (auto&& e : b.errors())
+                    {
+                        std::cout << "frame " << i << ' ' << e << std::endl;
+                    }
+                }
+            });
+        }
+
+        const uint32_t frame_commands = depth.command_count() + shadows.command_count() + main_pass.command_count();
+        const size_t   frame_bytes    = depth.size() + shadows.size() + main_pass.size();
+        const uint64_t draws          = static_cast<uint64_t>(objects) * (cascades + 2);
+
+        std::cout << "objects:" << objects << " frames:" << frames << " commands per frame:" << frame_commands << " bytes per frame:" << frame_bytes << " capacity:" << capacity << std::endl;
+        print("record", record_time, frames);
+        print("null backend replay", replay_time, frames);
+
+        std::cout << "draws per frame:" << totals.m_draws / std::max(frames, 1U) << " barriers per frame:" << totals.m_barriers / std::max(frames, 1U)
+                  << " pipeline changes per frame:" << totals.m_pipeline_changes / std::max(frames, 1U) << " constant bytes per frame:" << totals.m_constant_bytes / std::max(frames, 1U) << std::endl;
+
+        uint32_t failures = 0;
+
+        auto check = [&failures](const char* name, bool ok)
+        {
+            if (!ok)
+            {
+                std::cout << "failed: " << name << std::endl;
+                ++failures;
+            }
+        };
+
+        check("valid streams", errors == 0);
+        check("draw count", totals.m_draws == draws * frames);
+        check("index count", totals.m_vertices == draws * index_count * frames);
+        check("no allocation after the first frame", growths == 0);
+
+        std::cout << "failed checks:" << failures << std::endl;
+        return failures == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,319 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <uc_dev/math/math.h>
+#include <uc_dev/math/geometry_convex_clipping.h>
+
+//fits the shadow caster volume of random camera frusta: clip by the scene bounds, then extrude towards the light
+//the vector based clipper against the fixed capacity one and the hull cache, the fixed volumes are checked against the vector ones
+//usage: uc_convex_clipping_benchmark [frusta] [repeats]
+
+namespace
+{
+    using namespace uc::math;
+    using namespace uc::math::convex_clipping;
+
+    double measure(const std::function<void()>& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    void print(const char* name, double ms, uint32_t count)
+    {
+        std::printf("%-28s %10.2f ms %10.4f ms/volume\n", name, ms, count ? ms / count : 0.0);
+    }
+
+    frustum_points make_frustum(float4 position, float4 forward, float fov, float aspect, float near_plane, float far_plane)
+    {
+        const float4 f          = normalize3(forward);
+        const float4 right      = normalize3(cross3(orthogonal3_vector(f), f));
+        const float4 up         = cross3(f, right);
+        const float  tan_half   = std::tan(fov * 0.5f);
+
+        frustum_points r;
+
+        auto slice = [&](float d, uint32_t down_left, uint32_t down_right, uint32_t up_right, uint32_t up_left)
+        {
+            const float4 center = mad(f, splat(d), position);
+            const float4 h      = mul(up, d * tan_half);
+            const float4 w      = mul(right, d * tan_half * aspect);
+
+            r.m_points[down_left]   = sub(sub(center, w), h);
+            r.m_points[down_right]  = sub(add(center, w), h);
+            r.m_points[up_right]    = add(add(center, w), h);
+            r.m_points[up_left]     = add(sub(center, w), h);
+        };
+
+        slice(near_plane, frustum_points::near_down_left, frustum_points::near_down_right, frustum_points::near_up_right, frustum_points::near_up_left);
+        slice(far_plane, frustum_points::far_down_left, frustum_points::far_down_right, frustum_points::far_up_right, frustum_points::far_up_left);
+
+        return r;
+    }
+
+    struct face_plane
+    {
+        float4 m_normal;
+        float  m_d;
+    };
+
+    //outward planes of a convex polyhedron, from the first three points of every face that are not on a line
+    std::vector<face_plane> make_planes(const convex_polyhedron& p)
+    {
+        float4 centroid = zero();
+        for (auto&& v : p.m_points)
+        {
+            centroid = add(centroid, v);
+        }
+        centroid = div(centroid, splat(static_cast<float>(p.m_points.size())));
+
+        std::vector<face_plane> r;
+
+        for (auto&& f : p.m_faces)
+        {
+            const float4 a = p.m_points[f.m_indices[0]];
+
+            for (auto i = 1U; i + 1 < f.m_indices.size(); ++i)
+            {
+                float4 n = cross3(sub(p.m_points[f.m_indices[i]], a), sub(p.m_points[f.m_indices[i + 1]], a));
+                const float l = get_x(length3(n));
+
+                if (l > 1e-6f)
+                {
+                    n = div(n, splat(l));
+                    float d = -get_x(dot3(n, a));
+
+                    if (get_x(dot3(n, centroid)) + d > 0.0f)
+                    {
+                        n = negate(n);
+                        d = -d;
+                    }
+
+                    r.push_back({ n, d });
+                    break;
+                }
+            }
+        }
+
+        return r;
+    }
+
+    //every face is planar
+    bool planar(const convex_polyhedron& p, float tolerance)
+    {
+        for (auto&& f : p.m_faces)
+        {
+            convex_polyhedron one;
+            one.m_points = p.m_points;
+            one.m_faces.push_back(f);
+
+            auto planes = make_planes(one);
+            if (planes.empty())
+            {
+                return false;
+            }
+
+            for (auto i : f.m_indices)
+            {
+                if (std::fabs(get_x(dot3(planes[0].m_normal, p.m_points[i])) + planes[0].m_d) > tolerance)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    //every point of b is inside a
+    bool contains(const convex_polyhedron& a, const convex_polyhedron& b, float tolerance)
+    {
+        auto planes = make_planes(a);
+
+        for (auto&& v : b.m_points)
+        {
+            for (auto&& p : planes)
+            {
+                if (get_x(dot3(p.m_normal, v)) + p.m_d > tolerance)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    struct bounds
+    {
+        float4 m_min;
+        float4 m_max;
+    };
+
+    bounds make_bounds(const convex_polyhedron& p)
+    {
+        bounds r = { splat(std::numeric_limits<float>::max()), splat(-std::numeric_limits<float>::max()) };
+
+        for (auto&& v : p.m_points)
+        {
+            r.m_min = min(r.m_min, v);
+            r.m_max = max(r.m_max, v);
+        }
+
+        return r;
+    }
+
+    bool equal(const bounds& a, const bounds& b, float tolerance)
+    {
+        const float4 d = max(abs(sub(a.m_min, b.m_min)), abs(sub(a.m_max, b.m_max)));
+        return get_x(d) <= tolerance && get_y(d) <= tolerance && get_z(d) <= tolerance;
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    try
+    {
+        const uint32_t frusta   = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 3000;
+        const uint32_t repeats  = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 10;
+
+        std::cout << "frusta:" << frusta << " repeats:" << repeats << std::endl;
+
+        std::mt19937                            random(1);
+        std::uniform_real_distribution<float>   position(-300.0f, 300.0f);
+        std::uniform_real_distribution<float>   direction(-1.0f, 1.0f);
+        std::uniform_real_distribution<float>   depth(50.0f, 1200.0f);
+
+        const aabb scene = make_aabb(point3(-400.0f, -20.0f, -400.0f), point3(400.0f, 80.0f, 400.0f));
+
+        std::vector<frustum_points> inputs;
+        std::vector<float4>         lights;
+
+        for (auto i = 0U; i < frusta; ++i)
+        {
+            auto forward = vector3(direction(random), direction(random) * 0.3f, direction(random));
+            if (get_x(length3(forward)) < 0.1f)
+            {
+                forward = vector3(0.0f, 0.0f, 1.0f);
+            }
+
+            inputs.push_back(make_frustum(point3(position(random), 10.0f, position(random)), forward, 1.0f, 16.0f / 9.0f, 0.1f, depth(random)));
+            lights.push_back(normalize3(vector3(direction(random), 1.0f, direction(random))));
+        }
+
+        std::vector<convex_polyhedron>          vector_volumes(frusta);
+        std::vector<fixed_convex_polyhedron>    fixed_volumes(frusta);
+        std::vector<bool>                       vector_hit(frusta, false);
+        std::vector<bool>                       fixed_hit(frusta, false);
+
+        double vector_time  = 0.0;
+        double fixed_time   = 0.0;
+        double cache_time   = 0.0;
+
+        for (auto r = 0U; r < repeats; ++r)
+        {
+            vector_time += measure([&]()
+            {
+                for (auto i = 0U; i < frusta; ++i)
+                {
+                    auto clipped = clip(inputs[i], scene);
+                    vector_hit[i] = clipped.has_value();
+
+                    if (clipped)
+                    {
+                        vector_volumes[i] = convex_hull_with_direction(*clipped, lights[i], scene);
+                    }
+                }
+            });
+
+            fixed_time += measure([&]()
+            {
+                for (auto i = 0U; i < frusta; ++i)
+                {
+                    fixed_convex_polyhedron clipped;
+                    fixed_hit[i] = clip(inputs[i], scene, clipped) && convex_hull_with_direction(clipped, lights[i], scene, fixed_volumes[i]);
+                }
+            });
+
+            //a still camera, every frame after the first is a cache hit
+            convex_hull_cache cache;
+            cache_time += measure([&]()
+            {
+                for (auto i = 0U; i < frusta; ++i)
+                {
+                    cache.convex_hull_with_direction(inputs[0], scene, lights[0]);
+                }
+            });
+        }
+
+        //the caster volume is the hull of the receivers and the receivers moved along the light, so it must be closed, convex,
+        //contain both and have their bounds. the vector path must give the same bounds
+        uint32_t failures = 0;
+
+        const float4 extrude = splat(get_x(length4(scene.m_diagonal)));
+
+        for (auto i = 0U; i < frusta; ++i)
+        {
+            if (vector_hit[i] != fixed_hit[i])
+            {
+                ++failures;
+                continue;
+            }
+
+            if (!fixed_hit[i])
+            {
+                continue;
+            }
+
+            fixed_convex_polyhedron receivers;
+            clip(inputs[i], scene, receivers);
+
+            convex_polyhedron moved = make_convex_polyhedron(receivers);
+            for (auto&& v : moved.m_points)
+            {
+                v = mad(lights[i], extrude, v);
+            }
+
+            const convex_polyhedron fixed       = make_convex_polyhedron(fixed_volumes[i]);
+            const bounds            r           = make_bounds(make_convex_polyhedron(receivers));
+            const bounds            m           = make_bounds(moved);
+            const bounds            expected    = { min(r.m_min, m.m_min), max(r.m_max, m.m_max) };
+            const float             tolerance   = 1e-3f * 800.0f;
+
+            bool ok = planar(fixed, tolerance) && contains(fixed, fixed, tolerance);
+            ok = ok && contains(fixed, make_convex_polyhedron(receivers), tolerance) && contains(fixed, moved, tolerance);
+            ok = ok && equal(make_bounds(fixed), expected, tolerance);
+
+            ok = ok && equal(make_bounds(fixed), make_bounds(vector_volumes[i]), tolerance);
+
+            failures += ok ? 0 : 1;
+        }
+
+        const uint32_t volumes = frusta * repeats;
+        print("vector clip + hull", vector_time, volumes);
+        print("fixed clip + hull", fixed_time, volumes);
+        print("hull cache, still camera", cache_time, volumes);
+        std::cout << "volumes:" << std::count(fixed_hit.begin(), fixed_hit.end(), true) << " failed checks:" << failures << std::endl;
+
+        return failures == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
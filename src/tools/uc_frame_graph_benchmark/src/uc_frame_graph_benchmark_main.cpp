@@ -0,0 +1,250 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <uc_dev/gx/fg/frame_graph.h>
+
+//declares and compiles a frame graph every frame, as the render worlds do: chains of graphics and compute passes over transient targets
+//measures the cpu cost of the declaration and of the compile, checks the compile is the same every frame,
+//that transients which live at the same time do not share memory and that every aliased transient has its aliasing barrier
+//usage: uc_frame_graph_benchmark [passes] [frames]
+
+namespace
+{
+    using namespace uc::gx;
+    using namespace uc::gx::fg;
+
+    const uint64_t mb = 1024 * 1024;
+
+    //one access of a pass, chosen once, so every frame declares the same graph
+    struct access
+    {
+        uint32_t    m_resource;
+        uint32_t    m_state;
+        bool        m_write;
+    };
+
+    struct pass_desc
+    {
+        std::string         m_name;
+        pass_queue          m_queue;
+        std::vector<access> m_accesses;
+    };
+
+    struct frame_desc
+    {
+        std::vector<uint64_t>   m_sizes;            //of the transients, the back buffer is the last resource
+        std::vector<pass_desc>  m_passes;
+    };
+
+    double measure(const std::function<void()>& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    void print(const char* name, double ms, uint32_t frames)
+    {
+        std::printf("%-28s %10.2f ms %10.3f ms/frame\n", name, ms, frames ? ms / frames : 0.0);
+    }
+
+    //every pass reads a few of the recent targets and writes a new one, a few write targets nobody reads
+    frame_desc make_frame(uint32_t passes)
+    {
+        frame_desc f;
+
+        std::mt19937                            random(1);
+        std::uniform_int_distribution<uint32_t> size(1, 32);
+        std::uniform_int_distribution<uint32_t> reads(1, 3);
+        std::uniform_int_distribution<uint32_t> recent(1, 8);
+        std::uniform_int_distribution<uint32_t> kind(0, 15);
+
+        for (auto i = 0U; i < passes; ++i)
+        {
+            pass_desc p;
+
+            const auto k        = kind(random);
+            const bool compute  = k < 4;
+
+            p.m_name    = (compute ? "compute " : "graphics ") + std::to_string(i);
+            p.m_queue   = compute ? pass_queue::compute : pass_queue::graphics;
+
+            const auto written = static_cast<uint32_t>(f.m_sizes.size());
+
+            for (auto r = reads(random); r > 0 && written > 0; --r)
+            {
+                const auto back     = std::min(recent(random), written);
+                const auto resource = written - back;
+
+                p.m_accesses.push_back({ resource, compute ? cmd::resource_state_non_pixel_shader_resource : cmd::resource_state_pixel_shader_resource, false });
+            }
+
+            f.m_sizes.push_back(size(random) * mb);
+            p.m_accesses.push_back({ written, compute ? cmd::resource_state_unordered_access : cmd::resource_state_render_target, true });
+
+            f.m_passes.push_back(std::move(p));
+        }
+
+        //the final passes read the last targets and write the back buffer
+        pass_desc present;
+        present.m_name  = "present";
+        present.m_queue = pass_queue::graphics;
+
+        for (auto i = 1U; i <= std::min(passes, 4U); ++i)
+        {
+            present.m_accesses.push_back({ passes - i, cmd::resource_state_pixel_shader_resource, false });
+        }
+
+        present.m_accesses.push_back({ passes, cmd::resource_state_render_target, true });
+        f.m_passes.push_back(std::move(present));
+
+        return f;
+    }
+
+    void declare(frame_graph& g, const frame_desc& f)
+    {
+        g.reset();
+
+        std::vector<resource_handle> handles;
+
+        for (auto i = 0U; i < f.m_sizes.size(); ++i)
+        {
+            transient_desc d;
+            d.m_size        = f.m_sizes[i];
+            d.m_alignment   = 64 * 1024;
+
+            handles.push_back(g.create_transient("target", d));
+        }
+
+        handles.push_back(g.import_resource("back buffer", cmd::resource_state_common, cmd::resource_state_common));
+
+        for (auto&& p : f.m_passes)
+        {
+            auto h = g.add_pass(p.m_name.c_str(), p.m_queue);
+
+            for (auto&& a : p.m_accesses)
+            {
+                if (a.m_write)
+                {
+                    g.write(h, handles[a.m_resource], a.m_state);
+                }
+                else
+                {
+                    g.read(h, handles[a.m_resource], a.m_state);
+                }
+            }
+        }
+    }
+
+    //transients which live at the same time, in submission order, must not share memory
+    uint32_t count_memory_overlaps(const frame_desc& f, const compiled_frame_graph& c)
+    {
+        uint32_t overlaps = 0;
+
+        for (auto i = 0U; i < f.m_sizes.size(); ++i)
+        {
+            auto&& a = c.m_resources[i];
+
+            for (auto k = i + 1; k < f.m_sizes.size() && a.m_first != invalid_handle; ++k)
+            {
+                auto&& b = c.m_resources[k];
+
+                const bool live     = b.m_first != invalid_handle && a.m_first <= b.m_last && b.m_first <= a.m_last;
+                const bool memory   = a.m_offset < b.m_offset + f.m_sizes[k] && b.m_offset < a.m_offset + f.m_sizes[i];
+
+                overlaps += live && memory ? 1 : 0;
+            }
+        }
+
+        return overlaps;
+    }
+
+    uint32_t count_aliasing_barriers(const compiled_frame_graph& c)
+    {
+        uint32_t r = 0;
+
+        for (auto&& p : c.m_passes)
+        {
+            r += static_cast<uint32_t>(std::count_if(p.m_barriers.begin(), p.m_barriers.end(), [](const barrier& b) { return b.m_type == barrier_type::aliasing; }));
+        }
+
+        return r;
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    try
+    {
+        const uint32_t passes   = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 200;
+        const uint32_t frames   = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 1000;
+
+        const frame_desc f = make_frame(passes);
+
+        frame_graph             g;
+        compiled_frame_graph    c;
+
+        declare(g, f);
+        g.compile(c);
+
+        const frame_graph_statistics first = c.m_statistics;
+
+        double      declare_time    = 0.0;
+        double      compile_time    = 0.0;
+        uint32_t    changed         = 0;
+
+        for (auto i = 0U; i < frames; ++i)
+        {
+            declare_time += measure([&]() { declare(g, f); });
+            compile_time += measure([&]() { g.compile(c); });
+
+            auto&& s = c.m_statistics;
+            changed += s.m_barriers != first.m_barriers || s.m_culled_passes != first.m_culled_passes || s.m_async_passes != first.m_async_passes || s.m_heap_size != first.m_heap_size ? 1 : 0;
+        }
+
+        auto&& s = c.m_statistics;
+
+        std::cout << "passes:" << g.pass_count() << " resources:" << g.resource_count() << " frames:" << frames << std::endl;
+        print("declare", declare_time, frames);
+        print("compile", compile_time, frames);
+
+        std::cout << "culled passes:" << s.m_culled_passes << " async passes:" << s.m_async_passes << " barriers:" << s.m_barriers << " aliased transients:" << s.m_aliased_resources
+                  << " heap:" << s.m_heap_size / mb << " mb unaliased:" << s.m_unaliased_size / mb << " mb" << std::endl;
+
+        uint32_t failures = 0;
+
+        auto check = [&failures](const char* name, bool ok)
+        {
+            if (!ok)
+            {
+                std::cout << "failed: " << name << std::endl;
+                ++failures;
+            }
+        };
+
+        check("the same compile every frame", changed == 0);
+        check("no memory shared by live transients", count_memory_overlaps(f, c) == 0);
+        check("an aliasing barrier per aliased transient", count_aliasing_barriers(c) == s.m_aliased_resources);
+        check("aliasing saves memory", s.m_heap_size <= s.m_unaliased_size);
+        check("the back buffer pass is kept", !c.m_passes.empty() && c.m_passes.back().m_pass == g.pass_count() - 1);
+
+        std::cout << "failed checks:" << failures << std::endl;
+        return failures == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
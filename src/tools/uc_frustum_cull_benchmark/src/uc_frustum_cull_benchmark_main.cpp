@@ -0,0 +1,158 @@
+#include "pch.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <uc_dev/gx/cull/frustum_cull.h>
+#include <uc_dev/gx/cull/object_bounds.h>
+#include <uc_dev/sys/cpu_features.h>
+
+//culls a scene of boxes against the camera and three shadow cascades: the scalar aabb test, the sse and avx2 kernels, and the one pass multi view cull
+//usage: uc_frustum_cull_benchmark [objects] [frames]
+
+namespace
+{
+    using namespace uc;
+
+    double measure(const std::function<void()>& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    math::frustum_planes make_view(math::afloat4 eye, math::afloat4 look_at, float fov, float z_far)
+    {
+        auto v = math::look_at_lh(eye, look_at, math::vector3(0.0f, 1.0f, 0.0f));
+        auto p = math::perspective_fov_lh(fov, 16.0f / 9.0f, 0.1f, z_far);
+        return math::make_frustum_planes(math::mul(v, p));
+    }
+
+    void print(const char* name, double ms, uint32_t frames)
+    {
+        std::printf("%-28s %10.2f ms %10.3f ms/frame\n", name, ms, frames ? ms / frames : 0.0);
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    try
+    {
+        const uint32_t objects  = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 100000;
+        const uint32_t frames   = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 100;
+
+        std::cout << "objects:" << objects << " frames:" << frames << " avx2:" << (sys::is_avx2_supported() ? "yes" : "no") << std::endl;
+
+        std::mt19937                            random(1);
+        std::uniform_real_distribution<float>   position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float>   size(0.5f, 4.0f);
+
+        std::vector<math::aabb>     boxes;
+        gx::cull::object_bounds     bounds;
+
+        for (auto i = 0U; i < objects; ++i)
+        {
+            auto c = math::point3(position(random), position(random) * 0.1f, position(random));
+            auto e = math::splat(size(random));
+            auto b = math::make_aabb(math::sub(c, e), math::add(c, e));
+
+            boxes.push_back(b);
+            bounds.add(b);
+        }
+
+        //the camera and three cascades around it
+        math::frustum_planes views[4] =
+        {
+            make_view(math::point3(0.0f, 2.0f, 0.0f), math::point3(0.0f, 2.0f, 1.0f), 3.141592654f / 3.0f, 1000.0f),
+            make_view(math::point3(0.0f, 100.0f, -20.0f), math::point3(0.0f, 0.0f, 0.0f), 0.4f, 200.0f),
+            make_view(math::point3(0.0f, 200.0f, -40.0f), math::point3(0.0f, 0.0f, 50.0f), 0.6f, 400.0f),
+            make_view(math::point3(0.0f, 400.0f, -80.0f), math::point3(0.0f, 0.0f, 150.0f), 0.8f, 800.0f)
+        };
+
+        std::vector<uint32_t> scalar;
+        std::vector<uint32_t> sse(bounds.block_count() * 4 + 8);
+        std::vector<uint32_t> avx2(bounds.block_count() * 4 + 8);
+        std::vector<uint32_t> single[4];
+        std::vector<uint32_t> multi[4];
+
+        double scalar_time  = 0.0;
+        double sse_time     = 0.0;
+        double avx2_time    = 0.0;
+        double single_time  = 0.0;
+        double multi_time   = 0.0;
+        uint32_t mismatches = 0;
+
+        for (auto f = 0U; f < frames; ++f)
+        {
+            uint32_t sse_count  = 0;
+            uint32_t avx2_count = 0;
+
+            scalar_time += measure([&]()
+            {
+                scalar.clear();
+                for (auto i = 0U; i < objects; ++i)
+                {
+                    if (math::frustum_cull(&views[0], &boxes[i]) != math::frustum_cull_result::outside)
+                    {
+                        scalar.push_back(i);
+                    }
+                }
+            });
+
+            sse_time += measure([&]() { sse_count = gx::cull::details::frustum_cull_sse(&views[0], bounds.blocks(), bounds.block_count(), 0, sse.data()); });
+
+            if (sys::is_avx2_supported())
+            {
+                avx2_time += measure([&]() { avx2_count = gx::cull::details::frustum_cull_avx2(&views[0], bounds.blocks(), bounds.block_count(), 0, avx2.data()); });
+            }
+
+            single_time += measure([&]()
+            {
+                for (auto v = 0U; v < 4; ++v)
+                {
+                    gx::cull::frustum_cull(views[v], bounds, single[v]);
+                }
+            });
+
+            multi_time += measure([&]() { gx::cull::frustum_cull(&views[0], 4, bounds, &multi[0]); });
+
+            //drop the padding lanes, as frustum_cull does
+            while (sse_count > 0 && sse[sse_count - 1] >= objects) --sse_count;
+            while (avx2_count > 0 && avx2[avx2_count - 1] >= objects) --avx2_count;
+
+            bool agree = std::vector<uint32_t>(sse.begin(), sse.begin() + sse_count) == scalar;
+            agree = agree && (!sys::is_avx2_supported() || std::vector<uint32_t>(avx2.begin(), avx2.begin() + avx2_count) == scalar);
+            agree = agree && single[0] == scalar;
+
+            for (auto v = 0U; v < 4; ++v)
+            {
+                agree = agree && single[v] == multi[v];
+            }
+
+            mismatches += agree ? 0 : 1;
+        }
+
+        std::cout << "visible in the camera:" << scalar.size() << std::endl;
+        print("scalar aabb", scalar_time, frames);
+        print("sse kernel", sse_time, frames);
+        print("avx2 kernel", avx2_time, frames);
+        print("4 views one at a time", single_time, frames);
+        print("4 views one pass", multi_time, frames);
+        std::cout << "mismatched frames:" << mismatches << std::endl;
+
+        return mismatches == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
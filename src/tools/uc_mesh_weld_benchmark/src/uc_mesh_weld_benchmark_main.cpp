@@ -0,0 +1,273 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <uc_dev/gx/import/geo/mesh_weld.h>
+
+//welds a triangle soup grid with repeated and collapsing faces, removes the degenerate and duplicate faces and builds the normals
+//the exact weld and the face dedup are compared with unordered_map and unordered_set versions, and the counts with the known grid
+//usage: uc_mesh_weld_benchmark [quads per side]
+
+namespace
+{
+    using namespace uc::gx::import::geo;
+
+    struct position
+    {
+        float x;
+        float y;
+        float z;
+    };
+
+    struct normal
+    {
+        float x;
+        float y;
+        float z;
+    };
+
+    struct face
+    {
+        uint32_t v0;
+        uint32_t v1;
+        uint32_t v2;
+    };
+
+    struct soup
+    {
+        std::vector<position>   m_positions;
+        std::vector<face>       m_faces;
+    };
+
+    double measure(const std::function<void()>& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    void print(const char* name, double ms)
+    {
+        std::printf("%-28s %10.2f ms\n", name, ms);
+    }
+
+    //every triangle has its own vertices, every 16th triangle is repeated with rotated vertices, every 64th has two equal corners
+    soup make_soup(uint32_t n, float jitter)
+    {
+        soup r;
+
+        std::mt19937                            random(1);
+        std::uniform_real_distribution<float>   offset(-jitter, jitter);
+
+        auto add_face = [&](const float* a, const float* b, const float* c)
+        {
+            const uint32_t v = static_cast<uint32_t>(r.m_positions.size());
+
+            for (auto&& p : { a, b, c })
+            {
+                r.m_positions.push_back({ p[0] + offset(random), p[1], p[2] + offset(random) });
+            }
+
+            r.m_faces.push_back({ v, v + 1, v + 2 });
+        };
+
+        uint32_t triangle = 0;
+
+        for (auto i = 0U; i < n; ++i)
+        {
+            for (auto k = 0U; k < n; ++k)
+            {
+                const float p00[3] = { static_cast<float>(i),     0.0f, static_cast<float>(k) };
+                const float p10[3] = { static_cast<float>(i + 1), 0.0f, static_cast<float>(k) };
+                const float p01[3] = { static_cast<float>(i),     0.0f, static_cast<float>(k + 1) };
+                const float p11[3] = { static_cast<float>(i + 1), 0.0f, static_cast<float>(k + 1) };
+
+                const float* triangles[2][3] = { { p00, p01, p10 }, { p10, p01, p11 } };
+
+                for (auto&& t : triangles)
+                {
+                    add_face(t[0], t[1], t[2]);
+
+                    if (triangle % 16 == 0)
+                    {
+                        add_face(t[1], t[2], t[0]);
+                    }
+
+                    if (triangle % 64 == 0)
+                    {
+                        add_face(t[0], t[0], t[1]);
+                    }
+
+                    ++triangle;
+                }
+            }
+        }
+
+        return r;
+    }
+
+    //first equal position gets the next index, as the welds keep the vertex order
+    std::vector<uint32_t> weld_unordered_map(const std::vector<position>& positions)
+    {
+        auto hash = [](const std::tuple<uint32_t, uint32_t, uint32_t>& k)
+        {
+            return std::hash<uint64_t>()((static_cast<uint64_t>(std::get<0>(k)) * 0x9E3779B97F4A7C15ULL) ^ (static_cast<uint64_t>(std::get<1>(k)) << 21) ^ std::get<2>(k));
+        };
+
+        std::unordered_map<std::tuple<uint32_t, uint32_t, uint32_t>, uint32_t, decltype(hash)> vertices(positions.size(), hash);
+        std::vector<uint32_t> remap(positions.size());
+
+        for (auto i = 0U; i < positions.size(); ++i)
+        {
+            uint32_t b[3];
+            std::memcpy(&b[0], &positions[i], sizeof(b));
+
+            //-0.0 and 0.0 are the same position
+            for (auto&& v : b)
+            {
+                v = v == 0x80000000U ? 0 : v;
+            }
+
+            remap[i] = vertices.emplace(std::make_tuple(b[0], b[1], b[2]), static_cast<uint32_t>(vertices.size())).first->second;
+        }
+
+        return remap;
+    }
+
+    //keeps the first of the faces, which are equal up to a rotation
+    std::vector<face> dedup_unordered_set(const std::vector<face>& faces)
+    {
+        auto hash = [](const std::tuple<uint32_t, uint32_t, uint32_t>& k)
+        {
+            return std::hash<uint64_t>()((static_cast<uint64_t>(std::get<0>(k)) << 32 | std::get<1>(k)) ^ (static_cast<uint64_t>(std::get<2>(k)) * 0x9E3779B97F4A7C15ULL));
+        };
+
+        std::unordered_set<std::tuple<uint32_t, uint32_t, uint32_t>, decltype(hash)> seen(faces.size(), hash);
+        std::vector<face> r;
+
+        for (auto&& f : faces)
+        {
+            const uint32_t m = std::min(f.v0, std::min(f.v1, f.v2));
+            auto k = m == f.v0 ? std::make_tuple(f.v0, f.v1, f.v2) : m == f.v1 ? std::make_tuple(f.v1, f.v2, f.v0) : std::make_tuple(f.v2, f.v0, f.v1);
+
+            if (seen.insert(k).second)
+            {
+                r.push_back(f);
+            }
+        }
+
+        return r;
+    }
+
+    bool equal(const std::vector<face>& a, const std::vector<face>& b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const face& x, const face& y)
+        {
+            return x.v0 == y.v0 && x.v1 == y.v1 && x.v2 == y.v2;
+        });
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    try
+    {
+        //1600 quads per side are 5.1m triangles
+        const uint32_t n                = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 1600;
+        const size_t   grid_vertices    = static_cast<size_t>(n + 1) * (n + 1);
+        const size_t   grid_faces       = static_cast<size_t>(n) * n * 2;
+        uint32_t       failures         = 0;
+
+        auto check = [&failures](const char* name, bool ok)
+        {
+            if (!ok)
+            {
+                std::cout << "failed: " << name << std::endl;
+                ++failures;
+            }
+        };
+
+        soup s = make_soup(n, 0.0f);
+
+        std::cout << "triangles:" << s.m_faces.size() << " vertices:" << s.m_positions.size() << std::endl;
+
+        vertex_weld             w;
+        std::vector<uint32_t>   remap;
+
+        print("weld", measure([&]() { w = weld_vertices(s.m_positions, 0.0f, [](uint32_t, uint32_t) { return true; }); }));
+        print("weld unordered_map", measure([&]() { remap = weld_unordered_map(s.m_positions); }));
+
+        check("weld vertex count", w.m_source.size() == grid_vertices);
+        check("weld agrees with unordered_map", w.m_remap == remap);
+
+        std::vector<face>   faces = s.m_faces;
+        std::vector<face>   reference;
+
+        apply_weld(s.m_positions, w);
+        apply_weld_faces(faces, w);
+
+        print("face clean", measure([&]()
+        {
+            remove_degenerate_faces(faces);
+            remove_duplicate_faces(faces);
+        }));
+
+        print("face dedup unordered_set", measure([&]()
+        {
+            std::vector<face> valid;
+            std::copy_if(s.m_faces.begin(), s.m_faces.end(), std::back_inserter(valid), [&w](const face& f)
+            {
+                const uint32_t a = w.m_remap[f.v0];
+                const uint32_t b = w.m_remap[f.v1];
+                const uint32_t c = w.m_remap[f.v2];
+                return a != b && a != c && b != c;
+            });
+
+            for (auto&& f : valid)
+            {
+                f = { w.m_remap[f.v0], w.m_remap[f.v1], w.m_remap[f.v2] };
+            }
+
+            reference = dedup_unordered_set(valid);
+        }));
+
+        check("face count", faces.size() == grid_faces);
+        check("face clean agrees with unordered_set", equal(faces, reference));
+
+        std::vector<normal> normals;
+        print("normals", measure([&]() { normals = build_vertex_normals<normal>(s.m_positions, faces); }));
+
+        //the grid is flat, every normal is up or down
+        check("normals", normals.size() == grid_vertices && std::all_of(normals.begin(), normals.end(), [](const normal& v) { return std::abs(std::abs(v.y) - 1.0f) < 1e-5f; }));
+
+        //positions moved by less than a tenth of the epsilon weld back to the grid
+        soup j = make_soup(n, 0.001f);
+
+        vertex_weld je;
+        print("weld epsilon", measure([&]() { je = weld_vertices(j.m_positions, 0.01f, [](uint32_t, uint32_t) { return true; }); }));
+        check("epsilon weld vertex count", je.m_source.size() == grid_vertices);
+
+        std::cout << "failed checks:" << failures << std::endl;
+        return failures == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
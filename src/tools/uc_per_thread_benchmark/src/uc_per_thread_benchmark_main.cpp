@@ -0,0 +1,318 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <uc_dev/gx/dx12/cmd/per_thread.h>
+
+//allocates command objects on many recording threads, as the parallel command contexts do, and frees them all on the submitting thread
+//compares the per thread pools, where the recording threads steal from the slot of the submitting thread, with one pool behind a mutex
+//checks every object is handed to one thread only and that the pools stop creating objects after the first frame
+//usage: uc_per_thread_benchmark [objects per thread and frame] [frames] [threads]
+
+namespace
+{
+    using namespace uc::gx::dx12;
+
+    //stands for a command allocator, a command list or a context
+    struct object
+    {
+        uint32_t m_owner = ~0U;
+    };
+
+    struct objects
+    {
+        std::vector<object*>    m_ready;
+        std::vector<object*>    m_retired;
+    };
+
+    //the pools of command_allocator.h, command_manager.h and command_context_allocator.h
+    class per_thread_pool
+    {
+        public:
+
+        object* allocate()
+        {
+            object* r = nullptr;
+
+            auto take = [&r](objects& o)
+            {
+                if (o.m_ready.empty())
+                {
+                    return false;
+                }
+
+                r = o.m_ready.back();
+                o.m_ready.pop_back();
+                return true;
+            };
+
+            if (m_objects.local(take) || m_objects.steal(take))
+            {
+                return r;
+            }
+
+            m_created++;
+            return new object();
+        }
+
+        void free(object* o)
+        {
+            m_objects.local([o](objects& s)
+            {
+                s.m_retired.push_back(o);
+            });
+        }
+
+        void sync()
+        {
+            m_objects.for_each([](objects& s)
+            {
+                s.m_ready.insert(s.m_ready.end(), s.m_retired.begin(), s.m_retired.end());
+                s.m_retired.clear();
+            });
+        }
+
+        uint32_t created() const
+        {
+            return m_created;
+        }
+
+        ~per_thread_pool()
+        {
+            m_objects.for_each([](objects& s)
+            {
+                for (auto&& o : s.m_ready) delete o;
+                for (auto&& o : s.m_retired) delete o;
+            });
+        }
+
+        private:
+
+        per_thread<objects>     m_objects;
+        std::atomic<uint32_t>   m_created { 0 };
+    };
+
+    //one lock for all threads, as the pools were before the per thread slots
+    class mutex_pool
+    {
+        public:
+
+        object* allocate()
+        {
+            {
+                std::lock_guard<std::mutex> g(m_lock);
+
+                if (!m_objects.m_ready.empty())
+                {
+                    auto r = m_objects.m_ready.back();
+                    m_objects.m_ready.pop_back();
+                    return r;
+                }
+            }
+
+            m_created++;
+            return new object();
+        }
+
+        void free(object* o)
+        {
+            std::lock_guard<std::mutex> g(m_lock);
+            m_objects.m_retired.push_back(o);
+        }
+
+        void sync()
+        {
+            std::lock_guard<std::mutex> g(m_lock);
+            m_objects.m_ready.insert(m_objects.m_ready.end(), m_objects.m_retired.begin(), m_objects.m_retired.end());
+            m_objects.m_retired.clear();
+        }
+
+        uint32_t created() const
+        {
+            return m_created;
+        }
+
+        ~mutex_pool()
+        {
+            for (auto&& o : m_objects.m_ready) delete o;
+            for (auto&& o : m_objects.m_retired) delete o;
+        }
+
+        private:
+
+        std::mutex              m_lock;
+        objects                 m_objects;
+        std::atomic<uint32_t>   m_created { 0 };
+    };
+
+    //the recording threads wait here for the frame to start and to end, the main thread submits in between
+    class barrier
+    {
+        public:
+
+        explicit barrier(uint32_t count) : m_count(count)
+        {
+
+        }
+
+        void wait()
+        {
+            auto generation = m_generation.load(std::memory_order_acquire);
+
+            if (m_arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == m_count)
+            {
+                m_arrived.store(0, std::memory_order_relaxed);
+                m_generation.fetch_add(1, std::memory_order_release);
+            }
+            else
+            {
+                while (m_generation.load(std::memory_order_acquire) == generation)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        private:
+
+        const uint32_t          m_count;
+        std::atomic<uint32_t>   m_arrived       { 0 };
+        std::atomic<uint32_t>   m_generation    { 0 };
+    };
+
+    struct result
+    {
+        double      m_ms            = 0.0;
+        uint32_t    m_created       = 0;      //after the first frame
+        uint32_t    m_shared        = 0;      //objects handed to two threads in one frame
+    };
+
+    template <typename pool> result run(uint32_t threads, uint32_t count, uint32_t frames)
+    {
+        pool                                p;
+        barrier                             start(threads + 1);
+        barrier                             end(threads + 1);
+        std::vector<std::vector<object*>>   allocated(threads);
+        std::vector<std::thread>            workers;
+
+        for (auto w = 0U; w < threads; ++w)
+        {
+            workers.emplace_back([&, w]()
+            {
+                for (auto f = 0U; f < frames; ++f)
+                {
+                    start.wait();
+
+                    auto&& a = allocated[w];
+
+                    for (auto i = 0U; i < count; ++i)
+                    {
+                        a.push_back(p.allocate());
+                    }
+
+                    end.wait();
+                }
+            });
+        }
+
+        result   r;
+        uint32_t first_frame = 0;
+
+        for (auto f = 0U; f < frames; ++f)
+        {
+            auto begin = std::chrono::steady_clock::now();
+
+            start.wait();
+            end.wait();
+
+            r.m_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+            if (f == 0)
+            {
+                first_frame = p.created();
+            }
+
+            //the submitting thread frees the objects of all recording threads
+            for (auto w = 0U; w < threads; ++w)
+            {
+                for (auto&& o : allocated[w])
+                {
+                    r.m_shared += o->m_owner == f ? 1 : 0;
+                    o->m_owner = f;
+                    p.free(o);
+                }
+
+                allocated[w].clear();
+            }
+
+            p.sync();
+        }
+
+        for (auto&& w : workers)
+        {
+            w.join();
+        }
+
+        r.m_created = p.created() - first_frame;
+        return r;
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    try
+    {
+        const uint32_t count    = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 256;
+        const uint32_t frames   = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 1000;
+        const uint32_t cores    = std::max(std::thread::hardware_concurrency(), 1U);
+        const uint32_t max      = argc > 3 ? static_cast<uint32_t>(std::stoul(argv[3])) : std::min(cores, 32U);
+
+        std::cout << "objects per thread and frame:" << count << " frames:" << frames << " cores:" << cores << std::endl;
+
+        uint32_t failures = 0;
+
+        auto check = [&failures](const std::string& name, bool ok)
+        {
+            if (!ok)
+            {
+                std::cout << "failed: " << name << std::endl;
+                ++failures;
+            }
+        };
+
+        for (auto threads = 1U; threads <= max; threads *= 2)
+        {
+            auto a = run<per_thread_pool>(threads, count, frames);
+            auto b = run<mutex_pool>(threads, count, frames);
+
+            std::printf("%2u threads\n", threads);
+            std::printf("%-28s %10.2f ms %10.3f ms/frame\n", "  per thread", a.m_ms, a.m_ms / frames);
+            std::printf("%-28s %10.2f ms %10.3f ms/frame\n", "  mutex", b.m_ms, b.m_ms / frames);
+
+            const auto suffix = " at " + std::to_string(threads) + " threads";
+
+            check("one thread per object" + suffix, a.m_shared == 0 && b.m_shared == 0);
+            check("no objects created after the first frame" + suffix, a.m_created == 0 && b.m_created == 0);
+        }
+
+        std::cout << "failed checks:" << failures << std::endl;
+        return failures == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
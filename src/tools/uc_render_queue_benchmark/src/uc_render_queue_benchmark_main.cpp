@@ -0,0 +1,123 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <uc_dev/gx/cmd/render_queue.h>
+
+//sorts the draws of a frame: the render queue radix sort against std::stable_sort, over keys with few psos and materials, like a scene
+//usage: uc_render_queue_benchmark [draws_per_frame] [frames]
+
+namespace
+{
+    using namespace uc::gx::cmd;
+
+    double measure(const std::function<void()>& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    //a frame of draws, the jobs fill the buckets as the render worlds do
+    //joined gets the same items in the order sort joins the buckets, for the reference sort
+    void fill(render_queue& queue, std::vector<render_item>& joined, std::mt19937& random, uint32_t draws, uint32_t jobs)
+    {
+        std::uniform_int_distribution<uint32_t> pass(0, 3);
+        std::uniform_int_distribution<uint32_t> pso(0, 63);
+        std::uniform_int_distribution<uint32_t> material(0, 1023);
+        std::uniform_real_distribution<float>   depth(0.0f, 1.0f);
+        std::uniform_int_distribution<uint32_t> translucent(0, 9);
+
+        queue.begin(jobs);
+        joined.clear();
+
+        for (auto j = 0U; j < jobs; ++j)
+        {
+            auto&& bucket   = queue[j];
+            auto begin      = static_cast<uint64_t>(draws) * j / jobs;
+            auto end        = static_cast<uint64_t>(draws) * (j + 1) / jobs;
+
+            for (auto i = begin; i < end; ++i)
+            {
+                auto key    = translucent(random) == 0 ? sort_key::translucent(pass(random), pso(random), material(random), depth(random)) : sort_key::opaque(pass(random), pso(random), material(random), depth(random));
+                auto draw   = static_cast<uint32_t>(i);
+
+                bucket.add(key, draw);
+                joined.push_back({ key, draw });
+            }
+        }
+    }
+
+    //both sorts are stable, so they must give the same order
+    bool equal(const std::vector<render_item>& a, const std::vector<render_item>& b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const render_item& x, const render_item& y)
+        {
+            return x.m_key == y.m_key && x.m_draw == y.m_draw;
+        });
+    }
+
+    void print(const char* name, double ms, uint32_t frames)
+    {
+        std::printf("%-28s %10.2f ms %10.3f ms/frame\n", name, ms, frames ? ms / frames : 0.0);
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    try
+    {
+        const uint32_t draws    = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 100000;
+        const uint32_t frames   = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 100;
+        const uint32_t jobs     = 8;
+
+        std::cout << "draws per frame:" << draws << " frames:" << frames << std::endl;
+
+        std::mt19937 random(1);
+
+        render_queue                queue;
+        std::vector<render_item>    reference;
+
+        double radix_time   = 0.0;
+        double std_time     = 0.0;
+        uint32_t mismatches = 0;
+
+        for (auto f = 0U; f < frames; ++f)
+        {
+            fill(queue, reference, random, draws, jobs);
+
+            radix_time += measure([&]() { queue.sort(); });
+
+            std_time += measure([&]()
+            {
+                std::stable_sort(reference.begin(), reference.end(), [](const render_item& a, const render_item& b)
+                {
+                    return a.m_key < b.m_key;
+                });
+            });
+
+            mismatches += equal(queue.items(), reference) ? 0 : 1;
+        }
+
+        print("render_queue::sort", radix_time, frames);
+        print("std::stable_sort", std_time, frames);
+        std::cout << "mismatched frames:" << mismatches << std::endl;
+
+        return mismatches == 0 ? 0 : -1;
+    }
+
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -8,12 +8,13 @@
 #include <uc_dev/gx/import/assimp/skinned_mesh.h>
 #include <uc_dev/gx/import/fbx/skinned_mesh.h>
 #include <uc_dev/gx/import/assimp/assimp_options.h>
+#include <uc_dev/build/build_cache.h>
+
+#include <uc_dev/build/skeleton/command_line.h>
+#include <uc_dev/build/skeleton/skeleton.h>
 
-#include "uc_skeleton_command_line.h"
-#include "uc_skeleton_skeleton.h"
 #include "uc_skeleton_options.h"
 #include "uc_skeleton_lip.h"
-#include "uc_skeleton_skeleton.h"
 
 
 inline std::ostream& operator<<(std::ostream& s, const std::string& str)
@@ -22,17 +23,6 @@ inline std::ostream& operator<<(std::ostream& s, const std::string& str)
     return s;
 }
 
-inline std::string get_environment()
-{
-#if defined(_X86)
-    return "x86";
-#endif
-
-#if defined(_X64)
-    return "x64";
-#endif
-}
-
 int32_t main(int32_t argc, const char* argv[])
 {
     using namespace uc::skeleton;
@@ -60,27 +50,33 @@ int32_t main(int32_t argc, const char* argv[])
         auto input_skeleton                     = get_input_skeleton(vm);
         auto output_skeleton                    = get_output_skeleton(vm);
         auto make_left_handed                   = get_make_left_handed(vm);
+        auto cache                              = get_cache_directory(vm);
 
         uint32_t ai_o = 0;
         ai_o |= make_left_handed ? aiProcess_MakeLeftHanded : 0;
         ai_o |= aiProcess_CalcTangentSpace; //
 
-        std::cout << "building skeleton (" << get_environment() << ") " << input_skeleton << std::endl;
+        std::cout << "building skeleton (" << uc::build::get_environment() << ") " << input_skeleton << std::endl;
         std::cout << "assimp options:" << uc::gx::import::assimp::assimp_postprocess_option_to_string(ai_o) << std::endl;
 
-        std::experimental::filesystem::path path(input_skeleton);
-        auto e = path.extension().wstring();
+        auto key = uc::build::cache::skeleton_key(ai_o, input_skeleton);
 
-        if (e == L".fbx")//  && false)
-        {
-            auto mesh = uc::gx::import::fbx::create_skinned_mesh(input_skeleton);
-            uc::lip::serialize_object(uc::skeleton::skeleton(mesh->m_skeleton_pose), output_skeleton);
-        }
-        else
+        uc::build::cache::build_cached(cache, key, { output_skeleton }, [&]
         {
-            auto mesh = uc::gx::import::assimp::create_skinned_mesh(input_skeleton, ai_o);
-            uc::lip::serialize_object(uc::skeleton::skeleton(mesh->m_skeleton_pose), output_skeleton);
-        }
+            std::experimental::filesystem::path path(input_skeleton);
+            auto e = path.extension().wstring();
+
+            if (e == L".fbx")//  && false)
+            {
+                auto mesh = uc::gx::import::fbx::create_skinned_mesh(input_skeleton);
+                uc::lip::serialize_object(uc::skeleton::skeleton(mesh.get()), output_skeleton);
+            }
+            else
+            {
+                auto mesh = uc::gx::import::assimp::create_skinned_mesh(input_skeleton, ai_o);
+                uc::lip::serialize_object(uc::skeleton::skeleton(mesh.get()), output_skeleton);
+            }
+        });
     }
     
     catch (const std::exception& e)
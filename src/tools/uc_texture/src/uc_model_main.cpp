@@ -17,63 +17,28 @@
 #include <uc_dev/gx/img/img.h>
 #include <uc_dev/os/windows/com_initializer.h>
 #include <uc_dev/lzham/lzham.h>
+#include <uc_dev/build/build_cache.h>
 
 
-#include "uc_model_command_line.h"
+#include <uc_dev/build/texture/command_line.h>
+#include <uc_dev/build/model/compressonator.h>
+#include <uc_dev/build/texture/convert.h>
 
-#include "uc_model_compressonator.h"
-#include "uc_model_swizzle.h"
-#include "uc_model_texture.h"
 #include <uc_dev/mem/alloc.h>
 
 #include "simple_ispc.h"
 
 
-namespace uc
-{
-    namespace model
-    {
-        void convert_texture( const std::string& input_file_name, const std::string& output_file_name, const std::string& texture_format )
-        {
-            auto storage = string_to_storage_format(texture_format);
-            auto view = string_to_view_format(texture_format);
-
-            if (storage == lip::storage_format::unknown)
-            {
-                uc::lip::texture2d m = create_texture_2d(input_file_name);
-                uc::lip::serialize_object(&m, output_file_name);
-            }
-            else
-            {
-                uc::lip::texture2d m = create_texture_2d(input_file_name, storage, view);
-                uc::lip::serialize_object(&m, output_file_name);
-            }
-        }
-    }
-}
-
-inline std::string get_environment()
-{
-#if defined(_X86)
-    return "x86";
-#endif
-
-#if defined(_X64)
-    return "x64";
-#endif
-}
-
-
 int32_t main(int32_t argc, const char* argv[])
 {
-    using namespace uc::model;
+    using namespace uc::texture;
 
     std::string input_model_error = "uc_dev_texture_r.exe";
 
     try
     {
         uc::os::windows::com_initializer com;
-        compressonator::initializer       compressonator;
+        uc::model::compressonator::initializer compressonator;
 
         //
         // ShutdownBCLibrary - Shutdown the BC6H or BC7 library
@@ -92,11 +57,18 @@ int32_t main(int32_t argc, const char* argv[])
         auto input_model            = get_input_texture(vm);
         auto output_model           = get_output_texture(vm);
         auto texture_format         = get_texture_format(vm);
+        auto cache                  = get_cache_directory(vm);
 
-        std::cout << "building texture (" << get_environment() << ") " << std::endl;
+        std::cout << "building texture (" << uc::build::get_environment() << ") " << std::endl;
 
         std::cout << "Building texture:" << input_model << std::endl;
-        convert_texture(input_model, output_model, texture_format);
+
+        auto key = uc::build::cache::texture_key(texture_format, input_model);
+
+        uc::build::cache::build_cached(cache, key, { output_model }, [&]
+        {
+            convert_texture(input_model, output_model, texture_format);
+        });
     }
 
     catch (const std::exception& e)
@@ -2,7 +2,7 @@
 //
 #pragma once
 
-#include "uc_model_exception.h"
+#include <uc_dev/build/model/exception.h>
 
 #include <uc_dev/gx/img/img.h>
 
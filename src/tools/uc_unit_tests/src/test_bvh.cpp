@@ -0,0 +1,298 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <uc_dev/gx/cull/bvh.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc;
+
+    math::aabb make_box(float x, float y, float z, float half_size)
+    {
+        return math::make_aabb(math::point3(x - half_size, y - half_size, z - half_size), math::point3(x + half_size, y + half_size, z + half_size));
+    }
+
+    std::vector<math::aabb> random_boxes(uint32_t count, uint32_t seed)
+    {
+        std::mt19937                            random(seed);
+        std::uniform_real_distribution<float>   position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float>   size(0.1f, 3.0f);
+
+        std::vector<math::aabb> r;
+        for (auto i = 0U; i < count; ++i)
+        {
+            r.push_back(make_box(position(random), position(random), position(random), size(random)));
+        }
+        return r;
+    }
+
+    std::vector<uint32_t> sorted(std::vector<uint32_t> v)
+    {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+    //brute force, the same tests the bvh does on its leaves
+    std::vector<uint32_t> sphere_reference(const std::vector<math::aabb>& boxes, math::afloat4 center, float radius)
+    {
+        std::vector<uint32_t> r;
+
+        for (auto i = 0U; i < boxes.size(); ++i)
+        {
+            auto d = math::max(math::max(math::sub(math::bounds_min(boxes[i]), center), math::sub(center, math::bounds_max(boxes[i]))), math::zero());
+            if (math::get_x(math::dot3(d, d)) <= radius * radius)
+            {
+                r.push_back(i);
+            }
+        }
+
+        return r;
+    }
+
+    std::vector<uint32_t> frustum_reference(const std::vector<math::aabb>& boxes, const math::frustum_planes& f)
+    {
+        std::vector<uint32_t> r;
+
+        for (auto i = 0U; i < boxes.size(); ++i)
+        {
+            if (math::frustum_cull(&f, &boxes[i]) != math::frustum_cull_result::outside)
+            {
+                r.push_back(i);
+            }
+        }
+
+        return r;
+    }
+
+    //every item once, every node reachable from the root, parents before children
+    bool well_formed(const gx::cull::bvh& b)
+    {
+        std::vector<uint32_t> items(b.size(), 0);
+        std::vector<uint32_t> visits(b.node_count(), 0);
+
+        for (auto n = 0U; n < b.node_count(); ++n)
+        {
+            for (auto c : b.nodes()[n].m_child)
+            {
+                if (c == gx::cull::bvh::invalid)
+                {
+                    continue;
+                }
+
+                if (c & gx::cull::bvh::leaf)
+                {
+                    if ((c & ~gx::cull::bvh::leaf) >= b.size()) return false;
+                    items[c & ~gx::cull::bvh::leaf]++;
+                }
+                else
+                {
+                    if (c <= n || c >= b.node_count()) return false;
+                    visits[c]++;
+                }
+            }
+        }
+
+        return std::all_of(items.begin(), items.end(), [](uint32_t v) { return v == 1; }) && std::all_of(visits.begin() + 1, visits.end(), [](uint32_t v) { return v == 1; });
+    }
+}
+
+UC_TEST(bvh_empty_and_single)
+{
+    gx::cull::bvh b;
+    std::vector<uint32_t> items;
+
+    b.build(nullptr, 0);
+    b.query(math::point3(0.0f, 0.0f, 0.0f), 1000.0f, items);
+    UC_CHECK(items.empty() && b.node_count() == 0 && b.depth() == 0);
+
+    auto box = make_box(1.0f, 2.0f, 3.0f, 1.0f);
+    b.build(&box, 1);
+    b.query(math::point3(1.0f, 2.0f, 3.0f), 0.5f, items);
+    UC_CHECK(items.size() == 1 && items[0] == 0);
+    UC_CHECK(b.depth() == 1);
+}
+
+UC_TEST(bvh_queries_match_brute_force)
+{
+    auto boxes = random_boxes(5000, 3);
+
+    gx::cull::bvh b;
+    b.build(boxes.data(), static_cast<uint32_t>(boxes.size()));
+
+    UC_CHECK(well_formed(b));
+
+    std::mt19937                            random(5);
+    std::uniform_real_distribution<float>   position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float>   radius(1.0f, 40.0f);
+
+    for (auto i = 0U; i < 32; ++i)
+    {
+        auto c = math::point3(position(random), position(random), position(random));
+        auto r = radius(random);
+
+        std::vector<uint32_t> items;
+        b.query(c, r, items);
+        UC_CHECK(sorted(items) == sphere_reference(boxes, c, r));
+    }
+
+    //wide enough that whole subtrees are inside and taken without tests
+    auto v = math::look_at_lh(math::point3(0.0f, 0.0f, -150.0f), math::point3(0.0f, 0.0f, 0.0f), math::vector3(0.0f, 1.0f, 0.0f));
+    auto p = math::perspective_fov_lh(1.2f, 1.0f, 1.0f, 300.0f);
+    auto f = math::make_frustum_planes(math::mul(v, p));
+
+    std::vector<uint32_t> items;
+    b.query(f, items);
+    UC_CHECK(sorted(items) == frustum_reference(boxes, f));
+}
+
+UC_TEST(bvh_ray_hits_boxes_on_the_ray)
+{
+    std::vector<math::aabb> boxes;
+    for (auto i = 0U; i < 100; ++i)
+    {
+        boxes.push_back(make_box(static_cast<float>(i) * 4.0f, 0.0f, 0.0f, 1.0f));      //on the ray
+        boxes.push_back(make_box(static_cast<float>(i) * 4.0f, 10.0f, 0.0f, 1.0f));     //above it
+    }
+
+    gx::cull::bvh b;
+    b.build(boxes.data(), static_cast<uint32_t>(boxes.size()));
+
+    std::vector<uint32_t> items;
+    b.query(math::point3(-10.0f, 0.5f, 0.5f), math::vector3(1.0f, 0.0f, 0.0f), 100.0f, items);
+
+    //boxes up to x = 89 start before t = 100
+    std::vector<uint32_t> expected;
+    for (auto i = 0U; i < 23; ++i)
+    {
+        expected.push_back(i * 2);
+    }
+
+    UC_CHECK(sorted(items) == expected);
+}
+
+UC_TEST(bvh_axis_aligned_ray_on_the_slab_planes)
+{
+    std::vector<math::aabb> boxes;
+    for (auto i = 0U; i < 100; ++i)
+    {
+        boxes.push_back(make_box(static_cast<float>(i) * 4.0f, 0.0f, 0.0f, 1.0f));      //on the ray
+        boxes.push_back(make_box(static_cast<float>(i) * 4.0f, 10.0f, 0.0f, 1.0f));     //above it
+    }
+
+    gx::cull::bvh b;
+    b.build(boxes.data(), static_cast<uint32_t>(boxes.size()));
+
+    //zero y and z directions with the origin on the y max and z min planes, 0 * inf must not reject the boxes
+    std::vector<uint32_t> items;
+    b.query(math::point3(-10.0f, 1.0f, -1.0f), math::vector3(1.0f, 0.0f, 0.0f), 100.0f, items);
+
+    std::vector<uint32_t> expected;
+    for (auto i = 0U; i < 23; ++i)
+    {
+        expected.push_back(i * 2);
+    }
+
+    UC_CHECK(sorted(items) == expected);
+
+    //along y on the x max plane of the first column
+    items.clear();
+    b.query(math::point3(1.0f, -20.0f, 0.0f), math::vector3(0.0f, 1.0f, 0.0f), 100.0f, items);
+    UC_CHECK(sorted(items) == std::vector<uint32_t>({ 0, 1 }));
+
+    //parallel to the slabs, between two columns
+    items.clear();
+    b.query(math::point3(1.5f, -20.0f, 0.0f), math::vector3(0.0f, 1.0f, 0.0f), 100.0f, items);
+    UC_CHECK(items.empty());
+}
+
+UC_TEST(bvh_refit_follows_moved_items)
+{
+    auto boxes = random_boxes(1000, 11);
+
+    gx::cull::bvh b;
+    b.build(boxes.data(), static_cast<uint32_t>(boxes.size()));
+
+    for (auto&& box : boxes)
+    {
+        box.m_center = math::add(box.m_center, math::vector3(500.0f, 0.0f, 0.0f));
+    }
+
+    b.refit(boxes.data());
+
+    std::vector<uint32_t> items;
+    b.query(math::point3(500.0f, 0.0f, 0.0f), 50.0f, items);
+    UC_CHECK(sorted(items) == sphere_reference(boxes, math::point3(500.0f, 0.0f, 0.0f), 50.0f));
+}
+
+UC_TEST(bvh_depth_sizes_the_traversal)
+{
+    //clustered, exponentially spread and slab inputs give unbalanced trees of different depths
+    std::vector< std::vector<math::aabb> > inputs;
+
+    inputs.push_back(random_boxes(20000, 17));
+
+    inputs.push_back({});
+    float x = 1.0f;
+    for (auto i = 0U; i < 200; ++i)
+    {
+        inputs.back().push_back(make_box(x, 0.0f, 0.0f, 0.5f));
+        x *= 1.2f;
+    }
+
+    inputs.push_back({});
+    for (auto i = 0U; i < 20000; ++i)
+    {
+        const float v = static_cast<float>(i);
+        inputs.back().push_back(math::make_aabb(math::point3(v, -1000.0f, -1000.0f), math::point3(v + 0.5f, 1000.0f, 1000.0f)));
+    }
+
+    for (auto&& boxes : inputs)
+    {
+        gx::cull::bvh b;
+        b.build(boxes.data(), static_cast<uint32_t>(boxes.size()));
+
+        UC_CHECK(well_formed(b));
+
+        //walk the whole tree as the queries do and measure the depth and the stack
+        struct entry
+        {
+            uint32_t m_node;
+            uint32_t m_depth;
+        };
+
+        std::vector<entry>  stack = { { 0, 1 } };
+        size_t              stack_max = 1;
+        uint32_t            depth = 0;
+
+        while (!stack.empty())
+        {
+            const entry e = stack.back();
+            stack.pop_back();
+
+            depth = std::max(depth, e.m_depth);
+
+            for (auto c : b.nodes()[e.m_node].m_child)
+            {
+                if (c != gx::cull::bvh::invalid && (c & gx::cull::bvh::leaf) == 0)
+                {
+                    stack.push_back({ c, e.m_depth + 1 });
+                }
+            }
+
+            stack_max = std::max(stack_max, stack.size());
+        }
+
+        UC_CHECK(b.depth() == depth);
+        UC_CHECK(stack_max <= 3 * b.depth() + 1);
+
+        //the sphere covers everything, so the query walks every node
+        std::vector<uint32_t> items;
+        b.query(math::point3(0.0f, 0.0f, 0.0f), 1e18f, items);
+        UC_CHECK(items.size() == boxes.size());
+    }
+}
@@ -0,0 +1,402 @@
+#include "pch.h"
+
+#include <cstring>
+#include <cwchar>
+#include <vector>
+
+#include <uc_dev/gx/cmd/command_stream.h>
+#include <uc_dev/gx/cmd/null_backend.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc::gx::cmd;
+
+    struct constants
+    {
+        float m_values[16];
+    };
+
+    view_port make_view_port(float width, float height)
+    {
+        return { 0.0f, 0.0f, width, height, 0.0f, 1.0f };
+    }
+
+    std::vector<command_type> types(const command_stream& s)
+    {
+        std::vector<command_type> r;
+        s.for_each([&r](const command* c) { r.push_back(c->m_type); });
+        return r;
+    }
+
+    //a depth pass: clear, targets, state, and one indexed draw per object with its own constants
+    void record_pass(command_stream& s, const void* pso, const void* depth, uint32_t objects)
+    {
+        s.track_resource(depth, resource_state_depth_read);
+        s.transition_resource(depth, resource_state_depth_write);
+        s.begin_event(L"depth");
+        s.clear_depth_stencil({ depth, view_type::depth_buffer }, clear_depth, 0.0f, 0);
+        s.set_render_targets({}, { depth, view_type::depth_buffer });
+        s.set_view_port(make_view_port(1920.0f, 1080.0f));
+        s.set_scissor_rectangle({ 0, 0, 1920, 1080 });
+        s.set_descriptor_heaps();
+        s.set_graphics_pipeline_state(pso);
+        s.set_primitive_topology(primitive_topology_triangle_list);
+        s.set_vertex_buffer(0, { 0x10000, 4096, 16 });
+        s.set_index_buffer({ 0x20000, 4096, index_format_r16_uint });
+
+        for (auto i = 0U; i < objects; ++i)
+        {
+            constants c = {};
+            c.m_values[0] = static_cast<float>(i);
+            s.set_graphics_dynamic_constant_buffer(1, 0, &c, sizeof(c));
+            s.draw_indexed_instanced(36, 1, 0, 0, 0);
+        }
+
+        s.end_event();
+    }
+}
+
+UC_TEST(command_stream_records_in_order)
+{
+    command_stream s;
+
+    int pso = 0;
+    s.set_graphics_pipeline_state(&pso);
+    s.set_primitive_topology(primitive_topology_triangle_list);
+    s.draw_instanced(3, 2);
+    s.dispatch(4, 5, 6);
+
+    UC_CHECK(s.command_count() == 4);
+    UC_CHECK(s.size() % 8 == 0);
+    UC_CHECK((types(s) == std::vector<command_type>{ command_type::set_graphics_pipeline_state, command_type::set_primitive_topology, command_type::draw_instanced, command_type::dispatch }));
+
+    s.for_each([&pso](const command* c)
+    {
+        UC_CHECK(reinterpret_cast<uintptr_t>(c) % 8 == 0);
+
+        if (c->m_type == command_type::set_graphics_pipeline_state)
+        {
+            UC_CHECK(static_cast<const set_graphics_pipeline_state_command*>(c)->m_pipeline_state == &pso);
+        }
+
+        if (c->m_type == command_type::draw_instanced)
+        {
+            auto d = static_cast<const draw_instanced_command*>(c);
+            UC_CHECK(d->m_vertex_count_per_instance == 3 && d->m_instance_count == 2 && d->m_start_vertex_location == 0);
+        }
+
+        if (c->m_type == command_type::dispatch)
+        {
+            auto d = static_cast<const dispatch_command*>(c);
+            UC_CHECK(d->m_thread_group_count_x == 4 && d->m_thread_group_count_y == 5 && d->m_thread_group_count_z == 6);
+        }
+    });
+}
+
+UC_TEST(command_stream_copies_payloads)
+{
+    command_stream s;
+
+    constants c = {};
+    for (auto i = 0U; i < 16; ++i)
+    {
+        c.m_values[i] = static_cast<float>(i);
+    }
+
+    s.set_graphics_constant_buffer(2, &c, sizeof(c));
+    s.begin_event(L"shadows pass");
+
+    //the stream owns copies, the sources can change after the recording
+    constants expected = c;
+    c.m_values[0] = 100.0f;
+
+    uint32_t visited = 0;
+
+    s.for_each([&](const command* h)
+    {
+        if (h->m_type == command_type::set_graphics_constant_buffer)
+        {
+            auto b = static_cast<const set_graphics_constant_buffer_command*>(h);
+            UC_CHECK(b->m_root_index == 2 && b->m_byte_count == sizeof(constants));
+            UC_CHECK(std::memcmp(payload(b), &expected, sizeof(constants)) == 0);
+            UC_CHECK(b->m_size >= sizeof(set_graphics_constant_buffer_command) + sizeof(constants));
+            visited++;
+        }
+
+        if (h->m_type == command_type::begin_event)
+        {
+            auto e = static_cast<const begin_event_command*>(h);
+            UC_CHECK(e->m_length == std::wcslen(L"shadows pass") + 1);
+            UC_CHECK(std::wcscmp(label(e), L"shadows pass") == 0);
+            visited++;
+        }
+    });
+
+    UC_CHECK(visited == 2);
+}
+
+UC_TEST(command_stream_spans_blocks_and_keeps_memory_on_reset)
+{
+    //small blocks, so the frame spans many of them
+    command_stream s(256);
+
+    int pso   = 0;
+    int depth = 0;
+
+    record_pass(s, &pso, &depth, 100);
+
+    auto commands = s.command_count();
+    auto size     = s.size();
+    auto capacity = s.capacity();
+    auto recorded = types(s);
+
+    UC_CHECK(capacity > 256);
+    UC_CHECK(recorded.size() == commands);
+    UC_CHECK(recorded.front() == command_type::track_resource && recorded.back() == command_type::end_event);
+
+    //the next frames reuse the blocks
+    for (auto frame = 0U; frame < 3; ++frame)
+    {
+        s.reset();
+        UC_CHECK(s.command_count() == 0 && s.size() == 0);
+
+        record_pass(s, &pso, &depth, 100);
+
+        UC_CHECK(s.command_count() == commands);
+        UC_CHECK(s.size() == size);
+        UC_CHECK(s.capacity() == capacity);
+        UC_CHECK(types(s) == recorded);
+    }
+}
+
+UC_TEST(command_stream_fits_commands_larger_than_a_block)
+{
+    command_stream s(256);
+
+    std::vector<uint8_t> large(1000, 0xAB);
+
+    s.draw_instanced(3, 1);
+    s.set_compute_constant_buffer(0, large.data(), large.size());
+    s.draw_instanced(6, 1);
+
+    UC_CHECK(s.command_count() == 3);
+    UC_CHECK((types(s) == std::vector<command_type>{ command_type::draw_instanced, command_type::set_compute_constant_buffer, command_type::draw_instanced }));
+
+    s.for_each([&large](const command* c)
+    {
+        if (c->m_type == command_type::set_compute_constant_buffer)
+        {
+            auto b = static_cast<const set_compute_constant_buffer_command*>(c);
+            UC_CHECK(b->m_byte_count == large.size() && std::memcmp(payload(b), large.data(), large.size()) == 0);
+        }
+    });
+}
+
+UC_TEST(null_backend_counts_a_valid_pass)
+{
+    command_stream s;
+
+    int pso   = 0;
+    int depth = 0;
+
+    record_pass(s, &pso, &depth, 10);
+
+    auto b = validate(s);
+    auto&& st = b.statistics();
+
+    UC_CHECK(b.error_count() == 0);
+    UC_CHECK(st.m_draws == 10);
+    UC_CHECK(st.m_vertices == 360);
+    UC_CHECK(st.m_pipeline_changes == 1);
+    UC_CHECK(st.m_constant_bytes == 10 * sizeof(constants));
+    UC_CHECK(st.m_transitions == 1);
+    UC_CHECK(st.m_barriers == 1 && st.m_barrier_batches == 1);
+    UC_CHECK(st.m_commands[static_cast<uint32_t>(command_type::draw_indexed_instanced)] == 10);
+    UC_CHECK(b.resource_states().state(&depth) == resource_state_depth_write);
+}
+
+UC_TEST(null_backend_drops_repeated_root_constants)
+{
+    command_stream s;
+
+    int pso = 0;
+    constants c = {};
+
+    s.set_graphics_pipeline_state(&pso);
+    s.set_primitive_topology(primitive_topology_triangle_list);
+    s.set_view_port(make_view_port(64.0f, 64.0f));
+
+    for (auto i = 0U; i < 4; ++i)
+    {
+        s.set_graphics_constant_buffer(0, &c, sizeof(c));
+        s.draw_instanced(3, 1);
+    }
+
+    c.m_values[0] = 1.0f;
+    s.set_graphics_constant_buffer(0, &c, sizeof(c));
+    s.draw_instanced(3, 1);
+
+    auto b = validate(s);
+
+    UC_CHECK(b.error_count() == 0);
+    UC_CHECK(b.statistics().m_constant_bytes == 2 * sizeof(constants));
+    UC_CHECK(b.state_statistics().m_filtered[static_cast<uint32_t>(state_call::constant_buffer)] == 3);
+}
+
+UC_TEST(null_backend_reports_missing_state)
+{
+    command_stream s;
+
+    s.draw_instanced(3, 1);
+    auto a = validate(s);
+    UC_CHECK(a.error_count() == 3);     //pipeline state, topology, view port
+
+    int pso = 0;
+    s.reset();
+    s.set_graphics_pipeline_state(&pso);
+    s.set_primitive_topology(primitive_topology_triangle_list);
+    s.set_view_port(make_view_port(64.0f, 64.0f));
+    s.draw_indexed_instanced(3, 1, 0, 0, 0);
+    auto b = validate(s);
+    UC_CHECK(b.error_count() == 1);
+    UC_CHECK(!b.errors().empty() && b.errors().front().find("index buffer") != std::string::npos);
+
+    s.reset();
+    s.dispatch(1);
+    UC_CHECK(validate(s).error_count() == 1);
+}
+
+UC_TEST(null_backend_checks_events_and_transitions)
+{
+    command_stream s;
+
+    s.begin_event(L"open");
+    UC_CHECK(validate(s).error_count() == 1);
+
+    s.reset();
+    s.end_event();
+    UC_CHECK(validate(s).error_count() == 1);
+
+    //a transition from the tracked state of a resource, which was never tracked
+    int resource = 0;
+    s.reset();
+    s.transition_resource(&resource, resource_state_pixel_shader_resource);
+    UC_CHECK(validate(s).error_count() == 1);
+
+    //the caller knows the before state
+    s.reset();
+    s.transition_resource(&resource, resource_state_render_target, resource_state_pixel_shader_resource);
+    auto b = validate(s);
+    UC_CHECK(b.error_count() == 0 && b.statistics().m_barriers == 1);
+}
+
+UC_TEST(null_backend_checks_aliasing_barriers)
+{
+    command_stream s;
+
+    int before  = 0;
+    int after   = 0;
+
+    //the first resource placed in the memory has nothing before it
+    s.aliasing_barrier(nullptr, &before);
+    s.aliasing_barrier(&before, &after);
+
+    auto a = validate(s);
+    UC_CHECK(a.error_count() == 0);
+    UC_CHECK(a.statistics().m_aliasing_barriers == 2);
+    UC_CHECK(a.statistics().m_commands[static_cast<uint32_t>(command_type::aliasing_barrier)] == 2);
+
+    s.reset();
+    s.aliasing_barrier(&before, nullptr);
+    UC_CHECK(validate(s).error_count() == 1);
+}
+
+UC_TEST(null_backend_counts_the_draws_of_an_indirect_draw)
+{
+    command_stream s;
+
+    int pso         = 0;
+    int signature   = 0;
+
+    struct instance
+    {
+        float m_world[16];
+    };
+
+    const instance instances[2] = {};
+
+    std::vector<draw_indexed_instance_arguments> draws;
+    draws.push_back({ 0, { 36, 1, 0, 0, 0 } });
+    draws.push_back({ 0, { 12, 2, 36, 0, 0 } });
+    draws.push_back({ 1, { 36, 1, 0, 24, 0 } });
+
+    s.set_graphics_pipeline_state(&pso);
+    s.set_primitive_topology(primitive_topology_triangle_list);
+    s.set_view_port(make_view_port(64.0f, 64.0f));
+    s.set_index_buffer({ 0x20000, 4096, index_format_r16_uint });
+    s.set_graphics_dynamic_srv_buffer(1, instances, sizeof(instances));
+    s.draw_indexed_indirect(&signature, 7, draws.data(), static_cast<uint32_t>(draws.size()));
+
+    //the stream owns a copy of the arguments
+    draws[0].m_draw.m_index_count_per_instance = 0;
+
+    s.for_each([](const command* c)
+    {
+        if (c->m_type == command_type::draw_indexed_indirect)
+        {
+            auto d = static_cast<const draw_indexed_indirect_command*>(c);
+            UC_CHECK(d->m_count == 3 && d->m_root_index == 7);
+            UC_CHECK(arguments(d)[0].m_draw.m_index_count_per_instance == 36 && arguments(d)[2].m_instance == 1);
+        }
+    });
+
+    auto b = validate(s);
+    auto&& st = b.statistics();
+
+    UC_CHECK(b.error_count() == 0);
+    UC_CHECK(st.m_draws == 3);
+    UC_CHECK(st.m_vertices == 36 + 24 + 36);
+    UC_CHECK(st.m_constant_bytes == sizeof(instances));
+    UC_CHECK(st.m_commands[static_cast<uint32_t>(command_type::draw_indexed_indirect)] == 1);
+
+    //no signature, and no index buffer
+    s.reset();
+    s.set_graphics_pipeline_state(&pso);
+    s.set_primitive_topology(primitive_topology_triangle_list);
+    s.set_view_port(make_view_port(64.0f, 64.0f));
+    s.draw_indexed_indirect(nullptr, 7, draws.data(), 1);
+    UC_CHECK(validate(s).error_count() == 2);
+}
+
+UC_TEST(null_backend_sets_the_root_constant_again_after_an_indirect_draw)
+{
+    command_stream s;
+
+    int pso         = 0;
+    int signature   = 0;
+
+    const draw_indexed_instance_arguments draw = { 0, { 3, 1, 0, 0, 0 } };
+
+    s.set_graphics_pipeline_state(&pso);
+    s.set_primitive_topology(primitive_topology_triangle_list);
+    s.set_view_port(make_view_port(64.0f, 64.0f));
+    s.set_index_buffer({ 0x20000, 4096, index_format_r16_uint });
+    s.set_graphics_bindless_table(9);
+
+    //the second set is dropped, the one after the indirect draw is not, the signature wrote the draw id in between
+    s.set_graphics_root_constant(7, 5);
+    s.draw_indexed_instanced(3, 1, 0, 0, 0);
+    s.set_graphics_root_constant(7, 5);
+    s.draw_indexed_indirect(&signature, 7, &draw, 1);
+    s.set_graphics_root_constant(7, 5);
+    s.draw_indexed_instanced(3, 1, 0, 0, 0);
+
+    auto b = validate(s);
+
+    UC_CHECK(b.error_count() == 0);
+    UC_CHECK(b.statistics().m_constant_bytes == 2 * sizeof(uint32_t));
+    UC_CHECK(b.state_statistics().m_filtered[static_cast<uint32_t>(state_call::constant_buffer)] == 1);
+    UC_CHECK(b.statistics().m_commands[static_cast<uint32_t>(command_type::set_graphics_bindless_table)] == 1);
+}
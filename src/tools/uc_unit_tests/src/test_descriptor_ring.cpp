@@ -0,0 +1,367 @@
+#include "pch.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <uc_dev/gx/dx12/gpu/allocators/descriptor_ring.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc::gx::dx12;
+
+    struct range
+    {
+        uint32_t m_begin;
+        uint32_t m_count;
+    };
+
+    //gpu_ring_descriptor_heap without the device, the bindless table in front of the ring, one flag per descriptor to see the ranges in use
+    struct fake_heap
+    {
+        descriptor_ring                             m_ring;
+        descriptor_index_pool                       m_bindless;
+        std::unique_ptr<std::atomic<uint32_t>[]>    m_used;
+        std::atomic<uint32_t>                       m_overlaps { 0 };
+        std::mutex                                  m_lock;
+        std::vector<range>                          m_allocated;    //the ranges of the frame, the blocks of the caches are whole ranges
+
+        explicit fake_heap(uint32_t ring_count, uint32_t bindless_count = 0) : m_ring(ring_count), m_bindless(bindless_count), m_used(new std::atomic<uint32_t>[ring_count + bindless_count])
+        {
+            for (auto i = 0U; i < ring_count + bindless_count; ++i)
+            {
+                m_used[i].store(0);
+            }
+        }
+
+        uint32_t allocate_index(uint32_t count)
+        {
+            auto r = m_ring.allocate(count);
+            r = r != descriptor_ring::invalid ? r + m_bindless.capacity() : r;
+
+            for (auto i = 0U; r != descriptor_ring::invalid && i < count; ++i)
+            {
+                m_overlaps += m_used[r + i].exchange(1) != 0 ? 1 : 0;
+            }
+
+            if (r != descriptor_ring::invalid)
+            {
+                std::lock_guard<std::mutex> g(m_lock);
+                m_allocated.push_back({ r, count });
+            }
+
+            return r;
+        }
+
+        void free(const range& r)
+        {
+            for (auto i = 0U; i < r.m_count; ++i)
+            {
+                m_used[r.m_begin + i].store(0);
+            }
+        }
+
+        uint32_t allocate_bindless()
+        {
+            auto r = m_bindless.allocate();
+
+            if (r != descriptor_index_pool::invalid)
+            {
+                m_overlaps += m_used[r].exchange(1) != 0 ? 1 : 0;
+            }
+
+            return r;
+        }
+
+        void free_bindless(uint32_t index)
+        {
+            m_used[index].store(0);
+            m_bindless.free(index);
+        }
+    };
+}
+
+UC_TEST(descriptor_ring_allocates_until_full)
+{
+    descriptor_ring r(16);
+
+    UC_CHECK(r.allocate(4) == 0);
+    UC_CHECK(r.allocate(8) == 4);
+    UC_CHECK(r.size() == 12);
+
+    UC_CHECK(r.allocate(8) == descriptor_ring::invalid);
+    UC_CHECK(r.allocate(4) == 12);
+    UC_CHECK(r.allocate(1) == descriptor_ring::invalid);
+
+    UC_CHECK(r.allocate(0) == descriptor_ring::invalid);
+    UC_CHECK(r.allocate(17) == descriptor_ring::invalid);
+    UC_CHECK(r.size() == 16);
+}
+
+UC_TEST(descriptor_ring_keeps_retired_ranges_until_their_fence)
+{
+    descriptor_ring r(16);
+
+    r.allocate(8);
+    r.retire(1);
+    r.allocate(8);
+    r.retire(2);
+
+    UC_CHECK(r.allocate(1) == descriptor_ring::invalid);
+
+    //the fence of the first frame is not done yet
+    r.reclaim(0);
+    UC_CHECK(r.size() == 16);
+
+    r.reclaim(1);
+    UC_CHECK(r.size() == 8);
+    UC_CHECK(r.allocate(8) == 0);
+    UC_CHECK(r.allocate(1) == descriptor_ring::invalid);
+
+    //two fences at once
+    r.retire(3);
+    r.reclaim(3);
+    UC_CHECK(r.size() == 0);
+}
+
+UC_TEST(descriptor_ring_wraps_around_without_splitting_ranges)
+{
+    descriptor_ring r(10);
+
+    UC_CHECK(r.allocate(4) == 0);
+    UC_CHECK(r.allocate(4) == 4);
+    r.retire(1);
+    r.reclaim(1);
+
+    //6 descriptors are free, but only 2 at the end, the range starts over at 0
+    UC_CHECK(r.allocate(4) == 0);
+    UC_CHECK(r.size() == 6);          //the skipped end counts as used
+
+    r.retire(2);
+    UC_CHECK(r.allocate(6) == descriptor_ring::invalid);
+    UC_CHECK(r.allocate(4) == 4);
+
+    r.retire(3);
+    r.reclaim(2);
+    UC_CHECK(r.size() == 4);
+    UC_CHECK(r.allocate(2) == 8);
+    UC_CHECK(r.allocate(1) == 0);
+}
+
+UC_TEST(descriptor_ring_cache_takes_small_tables_from_one_block)
+{
+    fake_heap h(64);
+    descriptor_ring_cache<16> c;
+
+    UC_CHECK(c.allocate(&h, 4) == 0);
+    UC_CHECK(c.allocate(&h, 8) == 4);
+    UC_CHECK(h.m_ring.size() == 16);
+
+    //the rest of the block is too small, a new block
+    UC_CHECK(c.allocate(&h, 6) == 16);
+    UC_CHECK(h.m_ring.size() == 32);
+
+    //a large table goes to the ring
+    UC_CHECK(c.allocate(&h, 9) == 32);
+    UC_CHECK(c.allocate(&h, 2) == 22);
+
+    //a new frame starts a new block
+    c.reset();
+    UC_CHECK(c.allocate(&h, 1) == 41);
+
+    UC_CHECK(c.allocate(&h, 16) == descriptor_ring::invalid);
+    UC_CHECK(h.m_overlaps == 0);
+}
+
+UC_TEST(descriptor_ring_allocates_on_many_threads_while_frames_retire)
+{
+    const uint32_t threads          = 4;
+    const uint32_t frames           = 200;
+    const uint32_t frames_in_flight = 3;
+
+    //room for the tables of the frames in flight, with the ends of the blocks
+    fake_heap h(8192);
+
+    std::vector<std::vector<range>> in_flight(frames_in_flight);
+    std::atomic<uint32_t>           failures { 0 };
+    uint32_t                        reclaimed = 0;
+
+    for (auto frame = 0U; frame < frames; ++frame)
+    {
+        std::vector<std::thread> workers;
+
+        for (auto t = 0U; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]()
+            {
+                std::mt19937                            random(frame * threads + t);
+                std::uniform_int_distribution<uint32_t> count(1, 16);
+                descriptor_ring_cache<32>               cache;
+
+                for (auto i = 0U; i < 32; ++i)
+                {
+                    if (cache.allocate(&h, count(random)) == descriptor_ring::invalid)
+                    {
+                        failures++;
+                    }
+                }
+            });
+        }
+
+        for (auto&& w : workers)
+        {
+            w.join();
+        }
+
+        //the frame ends, the descriptors of the frame in flight before last are done
+        in_flight[frame % frames_in_flight].swap(h.m_allocated);
+        h.m_ring.retire(frame);
+
+        if (frame + 1 >= frames_in_flight)
+        {
+            auto done = frame + 1 - frames_in_flight;
+            auto&& s  = in_flight[done % frames_in_flight];
+
+            for (auto&& r : s)
+            {
+                h.free(r);
+            }
+
+            reclaimed += static_cast<uint32_t>(s.size());
+            s.clear();
+
+            h.m_ring.reclaim(done);
+        }
+    }
+
+    UC_CHECK(h.m_overlaps == 0);
+    UC_CHECK(failures == 0);
+    UC_CHECK(reclaimed > 0);
+    UC_CHECK(h.m_ring.size() <= h.m_ring.capacity());
+}
+
+UC_TEST(descriptor_index_pool_keeps_the_indices_until_they_are_freed)
+{
+    descriptor_index_pool p(4);
+
+    UC_CHECK(p.allocate() == 0);
+    UC_CHECK(p.allocate() == 1);
+    UC_CHECK(p.allocate() == 2);
+    UC_CHECK(p.allocate() == 3);
+    UC_CHECK(p.allocate() == descriptor_index_pool::invalid);
+
+    //the freed indices come back last in first out, the others stay with their textures
+    p.free(1);
+    p.free(3);
+    UC_CHECK(p.allocate() == 3);
+    UC_CHECK(p.allocate() == 1);
+    UC_CHECK(p.allocate() == descriptor_index_pool::invalid);
+
+    descriptor_index_pool empty(0);
+    UC_CHECK(empty.allocate() == descriptor_index_pool::invalid);
+}
+
+UC_TEST(descriptor_ring_heap_keeps_the_bindless_table_in_front_of_the_ring)
+{
+    fake_heap h(16, 8);
+
+    //the table indices are the heap indices, the ring starts after the table
+    UC_CHECK(h.allocate_bindless() == 0);
+    UC_CHECK(h.allocate_bindless() == 1);
+    UC_CHECK(h.allocate_index(4) == 8);
+
+    //the ring wraps around within its part of the heap, the table keeps its indices over the frames
+    for (auto frame = 0U; frame < 8; ++frame)
+    {
+        auto r = h.allocate_index(6);
+        UC_CHECK(r != descriptor_ring::invalid && r >= 8 && r + 6 <= 24);
+
+        h.m_ring.retire(frame);
+
+        for (auto&& a : h.m_allocated)
+        {
+            h.free(a);
+        }
+
+        h.m_allocated.clear();
+        h.m_ring.reclaim(frame);
+    }
+
+    //a texture released, its index goes to the next one
+    h.free_bindless(0);
+    UC_CHECK(h.allocate_bindless() == 0);
+
+    for (auto i = 2U; i < 8; ++i)
+    {
+        UC_CHECK(h.allocate_bindless() == i);
+    }
+
+    UC_CHECK(h.allocate_bindless() == descriptor_index_pool::invalid);
+    UC_CHECK(h.m_overlaps == 0);
+}
+
+UC_TEST(descriptor_index_pool_allocates_and_frees_on_many_threads)
+{
+    const uint32_t threads  = 4;
+    const uint32_t capacity = 64;
+
+    fake_heap               h(16, capacity);
+    std::atomic<uint32_t>   allocated { 0 };
+    std::vector<std::thread> workers;
+
+    for (auto t = 0U; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]()
+        {
+            std::mt19937    random(t);
+            std::vector<uint32_t> held;
+
+            //load and release textures, each thread holds at most a quarter of the table, so the table never runs out
+            for (auto i = 0U; i < 20000; ++i)
+            {
+                if (held.size() < capacity / threads && (held.empty() || (random() & 1)))
+                {
+                    auto index = h.allocate_bindless();
+
+                    if (index != descriptor_index_pool::invalid)
+                    {
+                        held.push_back(index);
+                        allocated++;
+                    }
+                }
+                else
+                {
+                    h.free_bindless(held.back());
+                    held.pop_back();
+                }
+            }
+
+            for (auto index : held)
+            {
+                h.free_bindless(index);
+            }
+        });
+    }
+
+    for (auto&& w : workers)
+    {
+        w.join();
+    }
+
+    UC_CHECK(h.m_overlaps == 0);
+    UC_CHECK(allocated > 0);
+
+    //all indices came back, the table is full again after capacity allocations
+    for (auto i = 0U; i < capacity; ++i)
+    {
+        UC_CHECK(h.allocate_bindless() != descriptor_index_pool::invalid);
+    }
+
+    UC_CHECK(h.allocate_bindless() == descriptor_index_pool::invalid);
+    UC_CHECK(h.m_overlaps == 0);
+}
@@ -0,0 +1,142 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <uc_dev/gx/drs/dynamic_resolution.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc::gx::drs;
+
+    //frames recorded at full resolution, the gpu time is the load, the cpu time is below it
+    void record(std::vector<trace_frame>& trace, uint32_t frames, float gpu_ms, float cpu_ms = 5.0f)
+    {
+        for (auto i = 0U; i < frames; ++i)
+        {
+            trace_frame f;
+            f.m_timing.m_gpu_ms = gpu_ms;
+            f.m_timing.m_cpu_ms = cpu_ms;
+            f.m_scale           = 1.0f;
+            trace.push_back(f);
+        }
+    }
+
+    //the scales of the last frames are all the same
+    bool settled(const std::vector<float>& scales, uint32_t end, uint32_t frames)
+    {
+        return std::all_of(scales.begin() + (end - frames), scales.begin() + end, [&](float s) { return s == scales[end - 1]; });
+    }
+
+    bool near(float a, float b)
+    {
+        return std::abs(a - b) < 0.001f;
+    }
+}
+
+UC_TEST(dynamic_resolution_settles_under_load_and_recovers)
+{
+    dynamic_resolution_controller c;
+
+    std::vector<trace_frame> trace;
+    record(trace, 300, 25.0f);
+    record(trace, 300, 10.0f);
+
+    auto scales = replay(c, trace);
+
+    //25 ms at full resolution, 0.775 brings it to 15.0 ms, inside the hysteresis band below the 15.5 ms target
+    UC_CHECK(settled(scales, 300, 100));
+    UC_CHECK(near(scales[299], 0.775f));
+    UC_CHECK(25.0f * scales[299] * scales[299] <= c.settings().m_target_ms);
+
+    //the load drops, back to full resolution
+    UC_CHECK(settled(scales, 600, 100));
+    UC_CHECK(near(scales[599], 1.0f));
+}
+
+UC_TEST(dynamic_resolution_holds_inside_the_hysteresis_band)
+{
+    dynamic_resolution_controller c;
+
+    //between 0.85 and 1.0 of the target, no reason to move
+    std::vector<trace_frame> trace;
+    record(trace, 200, 14.0f);
+
+    auto scales = replay(c, trace);
+
+    UC_CHECK(std::all_of(scales.begin(), scales.end(), [](float s) { return s == 1.0f; }));
+}
+
+UC_TEST(dynamic_resolution_does_not_lower_the_scale_of_cpu_bound_frames)
+{
+    dynamic_resolution_controller c;
+
+    //the gpu time is above the target, but the cpu time is longer still, less pixels do not make the frame faster
+    std::vector<trace_frame> trace;
+    record(trace, 200, 20.0f, 30.0f);
+
+    auto scales = replay(c, trace);
+
+    UC_CHECK(std::all_of(scales.begin(), scales.end(), [](float s) { return s == 1.0f; }));
+}
+
+UC_TEST(dynamic_resolution_stays_on_the_steps_and_limits)
+{
+    dynamic_resolution_controller c;
+
+    //far too heavy for any scale, then light
+    std::vector<trace_frame> trace;
+    record(trace, 200, 200.0f);
+    record(trace, 200, 4.0f);
+
+    auto scales = replay(c, trace);
+
+    auto&& s = c.settings();
+
+    auto on_step = [&s](float v)
+    {
+        auto steps = v / s.m_scale_step;
+        return std::abs(steps - std::round(steps)) < 0.001f && v >= s.m_min_scale && v <= s.m_max_scale;
+    };
+
+    UC_CHECK(std::all_of(scales.begin(), scales.end(), on_step));
+    UC_CHECK(near(scales[199], s.m_min_scale));
+
+    //the scale leaves the lower limit once the light frames reach the controller, after the latency and the settle frames
+    auto raised     = std::find_if(scales.begin() + 200, scales.end(), [&s](float v) { return v > s.m_min_scale; });
+    auto recovered  = std::find_if(scales.begin() + 200, scales.end(), [](float v) { return v == 1.0f; });
+    UC_CHECK(raised != scales.end() && raised - (scales.begin() + 200) <= 12);
+    UC_CHECK(recovered != scales.end() && recovered - (scales.begin() + 200) < 60);
+    UC_CHECK(settled(scales, 400, 50));
+}
+
+UC_TEST(dynamic_resolution_uses_the_cpu_time_without_timestamps)
+{
+    dynamic_resolution_controller c;
+
+    //no frame time at all, nothing to react to
+    frame_timing none;
+    for (auto i = 0U; i < 50; ++i)
+    {
+        UC_CHECK(c.update(none) == 1.0f);
+    }
+
+    //no gpu time yet, the cpu time stands for the frame
+    frame_timing cpu_only;
+    cpu_only.m_cpu_ms = 30.0f;
+
+    for (auto i = 0U; i < 50; ++i)
+    {
+        c.update(cpu_only);
+    }
+
+    UC_CHECK(c.scale() < 1.0f);
+    UC_CHECK(near(c.filtered_ms(), 30.0f));
+
+    //a reset starts over at the given scale
+    c.reset(0.6f);
+    UC_CHECK(near(c.scale(), 0.6f));
+}
@@ -0,0 +1,274 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <uc_dev/gx/fg/frame_graph.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc::gx;
+    using namespace uc::gx::fg;
+
+    const uint64_t mb = 1024 * 1024;
+
+    transient_desc make_desc(uint64_t size, uint64_t alignment = 64 * 1024)
+    {
+        transient_desc d;
+        d.m_size        = size;
+        d.m_alignment   = alignment;
+        return d;
+    }
+
+    const compiled_pass* find_pass(const compiled_frame_graph& g, pass_handle p)
+    {
+        auto it = std::find_if(g.m_passes.begin(), g.m_passes.end(), [p](const compiled_pass& c) { return c.m_pass == p; });
+        return it != g.m_passes.end() ? &(*it) : nullptr;
+    }
+
+    bool has_wait(const std::vector<pass_handle>& waits, pass_handle p)
+    {
+        return std::find(waits.begin(), waits.end(), p) != waits.end();
+    }
+
+    bool equal(const barrier& b, barrier_type type, resource_handle r, uint32_t before, uint32_t after)
+    {
+        return b.m_type == type && b.m_resource == r && b.m_before == before && b.m_after == after;
+    }
+}
+
+UC_TEST(frame_graph_culls_passes_nobody_reads)
+{
+    frame_graph g;
+
+    auto back_buffer    = g.import_resource("back buffer", cmd::resource_state_render_target, cmd::resource_state_unknown);
+    auto scratch        = g.create_transient("scratch", make_desc(mb));
+    auto unused         = g.create_transient("unused", make_desc(mb));
+
+    //the producer lives only for the consumer, which writes nothing
+    auto producer       = g.add_pass("producer");
+    g.write(producer, scratch, cmd::resource_state_render_target);
+
+    auto consumer       = g.add_pass("consumer");
+    g.read(consumer, scratch, cmd::resource_state_pixel_shader_resource);
+
+    auto main_pass      = g.add_pass("main");
+    g.write(main_pass, back_buffer, cmd::resource_state_render_target);
+
+    //nobody reads what it writes
+    auto debug          = g.add_pass("debug");
+    g.write(debug, unused, cmd::resource_state_unordered_access);
+
+    auto profiler       = g.add_pass("profiler");
+    g.keep(profiler);
+
+    auto c = g.compile();
+
+    UC_CHECK(c.m_passes.size() == 2);
+    UC_CHECK(find_pass(c, main_pass) != nullptr && find_pass(c, profiler) != nullptr);
+    UC_CHECK(find_pass(c, producer) == nullptr && find_pass(c, consumer) == nullptr && find_pass(c, debug) == nullptr);
+    UC_CHECK(c.m_statistics.m_culled_passes == 3);
+
+    //a culled transient has no memory
+    UC_CHECK(c.m_resources[scratch].m_first == invalid_handle);
+    UC_CHECK(c.m_statistics.m_heap_size == 0);
+}
+
+UC_TEST(frame_graph_builds_the_barriers)
+{
+    frame_graph g;
+
+    auto texture    = g.import_resource("texture", cmd::resource_state_copy_dest, cmd::resource_state_copy_dest);
+    auto target     = g.create_transient("target", make_desc(mb));
+    auto buffer     = g.import_resource("buffer", cmd::resource_state_unordered_access, cmd::resource_state_unknown);
+
+    //two reads in a row go to one combined read state
+    auto a          = g.add_pass("a");
+    g.read(a, texture, cmd::resource_state_pixel_shader_resource);
+    g.write(a, target, cmd::resource_state_render_target);
+
+    auto b          = g.add_pass("b");
+    g.read(b, texture, cmd::resource_state_non_pixel_shader_resource);
+    g.read(b, target, cmd::resource_state_pixel_shader_resource);
+    g.write(b, buffer, cmd::resource_state_unordered_access);
+
+    //unordered access after unordered access
+    auto c          = g.add_pass("c");
+    g.write(c, buffer, cmd::resource_state_unordered_access);
+
+    auto r = g.compile();
+
+    const uint32_t read = cmd::resource_state_pixel_shader_resource | cmd::resource_state_non_pixel_shader_resource;
+
+    auto pa = find_pass(r, a);
+    auto pb = find_pass(r, b);
+    auto pc = find_pass(r, c);
+
+    UC_CHECK(pa != nullptr && pb != nullptr && pc != nullptr);
+
+    //the transient is created in the state of its first use
+    UC_CHECK(pa->m_barriers.size() == 1 && equal(pa->m_barriers[0], barrier_type::transition, texture, cmd::resource_state_copy_dest, read));
+    UC_CHECK(r.m_resources[target].m_initial_state == cmd::resource_state_render_target);
+
+    UC_CHECK(pb->m_barriers.size() == 1 && equal(pb->m_barriers[0], barrier_type::transition, target, cmd::resource_state_render_target, cmd::resource_state_pixel_shader_resource));
+    UC_CHECK(pc->m_barriers.size() == 1 && equal(pc->m_barriers[0], barrier_type::uav, buffer, cmd::resource_state_unordered_access, cmd::resource_state_unordered_access));
+
+    //back to the final state of the texture, the buffer has none
+    UC_CHECK(r.m_final_barriers.size() == 1 && equal(r.m_final_barriers[0], barrier_type::transition, texture, read, cmd::resource_state_copy_dest));
+    UC_CHECK(r.m_statistics.m_barriers == 4);
+}
+
+UC_TEST(frame_graph_aliases_transients_with_disjoint_lifetimes)
+{
+    frame_graph g;
+
+    auto back_buffer    = g.import_resource("back buffer", cmd::resource_state_render_target, cmd::resource_state_unknown);
+    auto first          = g.create_transient("first", make_desc(2 * mb));
+    auto second         = g.create_transient("second", make_desc(mb));
+    auto third          = g.create_transient("third", make_desc(mb, 4 * mb));
+
+    auto p0 = g.add_pass("p0");
+    g.write(p0, first, cmd::resource_state_render_target);
+
+    auto p1 = g.add_pass("p1");
+    g.read(p1, first, cmd::resource_state_pixel_shader_resource);
+    g.write(p1, second, cmd::resource_state_render_target);
+
+    auto p2 = g.add_pass("p2");
+    g.read(p2, second, cmd::resource_state_pixel_shader_resource);
+    g.write(p2, third, cmd::resource_state_render_target);
+
+    auto p3 = g.add_pass("p3");
+    g.read(p3, third, cmd::resource_state_pixel_shader_resource);
+    g.write(p3, back_buffer, cmd::resource_state_render_target);
+
+    auto r = g.compile();
+
+    auto&& f = r.m_resources[first];
+    auto&& s = r.m_resources[second];
+    auto&& t = r.m_resources[third];
+
+    //first and second live together in p1, third takes over the memory of first
+    UC_CHECK(f.m_offset == 0 && !f.m_aliased);
+    UC_CHECK(s.m_offset == 2 * mb && !s.m_aliased);
+    UC_CHECK(t.m_offset == 0 && t.m_aliased);
+
+    UC_CHECK(r.m_statistics.m_aliased_resources == 1);
+    UC_CHECK(r.m_statistics.m_heap_size == 3 * mb);
+    UC_CHECK(r.m_statistics.m_unaliased_size == 5 * mb);
+    UC_CHECK(r.m_statistics.m_heap_alignment == 4 * mb);
+
+    //the aliasing barrier goes before the first use
+    auto pass = find_pass(r, p2);
+    UC_CHECK(pass != nullptr && !pass->m_barriers.empty());
+    UC_CHECK(pass->m_barriers[0].m_type == barrier_type::aliasing && pass->m_barriers[0].m_resource == third && pass->m_barriers[0].m_before_resource == first);
+}
+
+UC_TEST(frame_graph_moves_independent_compute_to_the_async_queue)
+{
+    frame_graph g;
+
+    auto back_buffer    = g.import_resource("back buffer", cmd::resource_state_render_target, cmd::resource_state_unknown);
+    auto history        = g.import_resource("history", cmd::resource_state_unordered_access, cmd::resource_state_pixel_shader_resource);
+    auto particles      = g.create_transient("particles", make_desc(mb));
+    auto shadow         = g.create_transient("shadow", make_desc(mb));
+
+    auto simulate       = g.add_pass("simulate", pass_queue::compute);
+    g.write(simulate, particles, cmd::resource_state_unordered_access);
+    g.write(simulate, history, cmd::resource_state_unordered_access);
+
+    auto shadows        = g.add_pass("shadows");
+    g.write(shadows, shadow, cmd::resource_state_depth_write);
+
+    auto compose        = g.add_pass("compose");
+    g.read(compose, shadow, cmd::resource_state_pixel_shader_resource);
+    g.read(compose, particles, cmd::resource_state_pixel_shader_resource);
+    g.write(compose, back_buffer, cmd::resource_state_render_target);
+
+    //a compute pass, which the next pass needs right away, stays on the graphics queue
+    auto resolve        = g.add_pass("resolve", pass_queue::compute);
+    g.read(resolve, back_buffer, cmd::resource_state_non_pixel_shader_resource);
+    g.write(resolve, shadow, cmd::resource_state_unordered_access);
+    g.keep(resolve);
+
+    auto r = g.compile();
+
+    auto ps = find_pass(r, simulate);
+    auto pc = find_pass(r, compose);
+    auto pr = find_pass(r, resolve);
+
+    UC_CHECK(ps != nullptr && pc != nullptr && pr != nullptr);
+    UC_CHECK(ps->m_async && !pr->m_async);
+    UC_CHECK(r.m_statistics.m_async_passes == 1);
+
+    //the graphics pass which reads the result waits for the compute queue
+    UC_CHECK(has_wait(pc->m_waits, simulate));
+    UC_CHECK(ps->m_waits.empty());
+
+    //the history goes to its final state on the graphics queue, after the async write
+    UC_CHECK(r.m_final_barriers.size() == 1 && r.m_final_barriers[0].m_resource == history);
+    UC_CHECK(r.m_final_waits.size() == 1 && r.m_final_waits[0] == simulate);
+
+    //the transients of the async pass keep their memory
+    UC_CHECK(!r.m_resources[particles].m_aliased);
+}
+
+UC_TEST(frame_graph_has_no_final_waits_on_one_queue)
+{
+    frame_graph g;
+
+    auto depth      = g.create_transient("depth", make_desc(mb));
+    auto map        = g.import_resource("map", cmd::resource_state_unordered_access, cmd::resource_state_pixel_shader_resource | cmd::resource_state_non_pixel_shader_resource);
+
+    auto shadows    = g.add_pass("shadows");
+    g.write(shadows, depth, cmd::resource_state_depth_write);
+
+    //nothing runs after it, so the compute pass stays on the graphics queue
+    auto resolve    = g.add_pass("resolve", pass_queue::compute);
+    g.read(resolve, depth, cmd::resource_state_depth_read | cmd::resource_state_non_pixel_shader_resource);
+    g.write(resolve, map, cmd::resource_state_unordered_access);
+
+    auto r = g.compile();
+
+    UC_CHECK(r.m_passes.size() == 2);
+    UC_CHECK(r.m_statistics.m_async_passes == 0);
+    UC_CHECK(r.m_final_barriers.size() == 1);
+    UC_CHECK(r.m_final_waits.empty());
+    UC_CHECK(find_pass(r, shadows)->m_barriers.empty());
+    UC_CHECK(r.m_resources[depth].m_initial_state == cmd::resource_state_depth_write);
+}
+
+UC_TEST(frame_graph_compiles_the_same_every_frame)
+{
+    frame_graph         g;
+    compiled_frame_graph r;
+
+    std::vector<uint32_t> barriers;
+
+    for (auto frame = 0U; frame < 3; ++frame)
+    {
+        g.reset();
+
+        auto back_buffer    = g.import_resource("back buffer", cmd::resource_state_common, cmd::resource_state_common);
+        auto target         = g.create_transient("target", make_desc(mb));
+
+        auto a = g.add_pass("a");
+        g.write(a, target, cmd::resource_state_render_target);
+
+        auto b = g.add_pass("b");
+        g.read(b, target, cmd::resource_state_pixel_shader_resource);
+        g.write(b, back_buffer, cmd::resource_state_render_target);
+
+        g.compile(r);
+
+        UC_CHECK(g.pass_count() == 2 && g.resource_count() == 2);
+        UC_CHECK(r.m_passes.size() == 2 && r.m_resources.size() == 2);
+        UC_CHECK(r.m_final_barriers.size() == 1 && r.m_final_waits.empty());
+
+        barriers.push_back(r.m_statistics.m_barriers);
+    }
+
+    UC_CHECK(barriers[0] == 3 && barriers[1] == barriers[0] && barriers[2] == barriers[0]);
+}
@@ -0,0 +1,87 @@
+#include "pch.h"
+
+#include <vector>
+
+#include <uc_dev/gx/dx12/gpu/frames_in_flight.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc::gx::dx12;
+
+    //the fence of a queue, every submit signals the next value, as gpu_command_queue does
+    struct queue
+    {
+        uint64_t m_fence = 1;
+
+        uint64_t submit()
+        {
+            return m_fence++;
+        }
+    };
+}
+
+UC_TEST(frame_fences_wait_for_the_end_of_the_frame_frames_in_flight_back)
+{
+    queue          q;
+    frame_fences   f;
+
+    std::vector<uint64_t> ends;
+
+    for (auto frame = 0U; frame < 10; ++frame)
+    {
+        //a few command lists, then the fence which ends the frame
+        for (auto i = 0U; i < frame % 4 + 2; ++i)
+        {
+            q.submit();
+        }
+
+        ends.push_back(q.submit());
+
+        auto wait = f.end_frame(ends.back(), 3);
+
+        //the first frames do not wait, then the end of the frame two frames back
+        UC_CHECK(wait == (frame >= 2 ? ends[frame - 2] : 0));
+    }
+}
+
+UC_TEST(frame_fences_with_one_frame_in_flight_wait_for_the_frame_itself)
+{
+    queue          q;
+    frame_fences   f;
+
+    for (auto frame = 0U; frame < 4; ++frame)
+    {
+        q.submit();
+        auto end = q.submit();
+
+        UC_CHECK(f.end_frame(end, 1) == end);
+    }
+}
+
+UC_TEST(frame_fences_follow_a_change_of_the_frames_in_flight)
+{
+    queue          q;
+    frame_fences   f;
+
+    std::vector<uint64_t> ends;
+
+    auto end_frame = [&](uint32_t frames_in_flight)
+    {
+        q.submit();
+        ends.push_back(q.submit());
+        return f.end_frame(ends.back(), frames_in_flight);
+    };
+
+    end_frame(max_frames_in_flight);
+    end_frame(max_frames_in_flight);
+    UC_CHECK(end_frame(max_frames_in_flight) == ends[ends.size() - max_frames_in_flight]);
+
+    //fewer frames in flight wait for a later frame
+    UC_CHECK(end_frame(2) == ends[ends.size() - 2]);
+    UC_CHECK(end_frame(1) == ends.back());
+
+    //more again, the ring still has the older frames
+    UC_CHECK(end_frame(max_frames_in_flight) == ends[ends.size() - max_frames_in_flight]);
+}
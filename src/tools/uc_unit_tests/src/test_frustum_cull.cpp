@@ -0,0 +1,200 @@
+#include "pch.h"
+
+#include <random>
+#include <vector>
+
+#include <uc_dev/gx/cull/frustum_cull.h>
+#include <uc_dev/gx/cull/object_bounds.h>
+#include <uc_dev/sys/cpu_features.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc;
+
+    //camera at the origin looking down +z, 90 degrees, 1..100
+    math::frustum_planes camera_planes()
+    {
+        auto v = math::look_at_lh(math::point3(0.0f, 0.0f, 0.0f), math::point3(0.0f, 0.0f, 1.0f), math::vector3(0.0f, 1.0f, 0.0f));
+        auto p = math::perspective_fov_lh(3.141592654f / 2.0f, 1.0f, 1.0f, 100.0f);
+        return math::make_frustum_planes(math::mul(v, p));
+    }
+
+    math::aabb make_box(float x, float y, float z, float half_size)
+    {
+        return math::make_aabb(math::point3(x - half_size, y - half_size, z - half_size), math::point3(x + half_size, y + half_size, z + half_size));
+    }
+
+    //the scalar test the kernels must agree with
+    std::vector<uint32_t> reference(const math::frustum_planes& f, const std::vector<math::aabb>& boxes)
+    {
+        std::vector<uint32_t> r;
+
+        for (auto i = 0U; i < boxes.size(); ++i)
+        {
+            if (math::frustum_cull(&f, &boxes[i]) != math::frustum_cull_result::outside)
+            {
+                r.push_back(i);
+            }
+        }
+
+        return r;
+    }
+
+    std::vector<math::aabb> random_boxes(uint32_t count)
+    {
+        std::mt19937                            random(7);
+        std::uniform_real_distribution<float>   position(-150.0f, 150.0f);
+        std::uniform_real_distribution<float>   size(0.1f, 5.0f);
+
+        std::vector<math::aabb> r;
+        for (auto i = 0U; i < count; ++i)
+        {
+            r.push_back(make_box(position(random), position(random), position(random), size(random)));
+        }
+        return r;
+    }
+
+    std::vector<uint32_t> run_kernel(decltype(&gx::cull::details::frustum_cull_sse) kernel, const math::frustum_planes& f, const gx::cull::object_bounds& b)
+    {
+        std::vector<uint32_t> r(b.block_count() * 4 + 8);
+        r.resize(kernel(&f, b.blocks(), b.block_count(), 0, r.data()));
+
+        //padding lanes are zero boxes at the origin, which is outside the near plane
+        while (!r.empty() && r.back() >= b.size())
+        {
+            r.pop_back();
+        }
+        return r;
+    }
+}
+
+UC_TEST(object_bounds_pads_to_blocks)
+{
+    gx::cull::object_bounds b;
+
+    UC_CHECK(b.block_count() == 0);
+
+    for (auto i = 0U; i < 5; ++i)
+    {
+        UC_CHECK(b.add(make_box(0.0f, 0.0f, 10.0f, 1.0f)) == i);
+    }
+
+    UC_CHECK(b.size() == 5);
+    UC_CHECK(b.block_count() == 2);
+
+    b.clear();
+    UC_CHECK(b.size() == 0 && b.block_count() == 0);
+}
+
+UC_TEST(frustum_cull_inside_outside_straddling)
+{
+    gx::cull::object_bounds b;
+    b.add(make_box(0.0f, 0.0f, 10.0f, 1.0f));       //inside
+    b.add(make_box(0.0f, 0.0f, -10.0f, 1.0f));      //behind
+    b.add(make_box(0.0f, 0.0f, 100.0f, 2.0f));      //straddles the far plane
+    b.add(make_box(50.0f, 0.0f, 10.0f, 1.0f));      //right of the view
+    b.add(make_box(10.0f, 0.0f, 10.0f, 0.5f));      //touches the right plane
+
+    std::vector<uint32_t> visible;
+    gx::cull::frustum_cull(camera_planes(), b, visible);
+
+    UC_CHECK(visible.size() == 3);
+    UC_CHECK(visible.size() == 3 && visible[0] == 0 && visible[1] == 2 && visible[2] == 4);
+}
+
+UC_TEST(frustum_cull_kernels_match_reference)
+{
+    auto f      = camera_planes();
+    //not a multiple of 4 or of the kernel chunks, so the padding is exercised
+    auto boxes  = random_boxes(10001);
+
+    gx::cull::object_bounds b;
+    for (auto&& box : boxes)
+    {
+        b.add(box);
+    }
+
+    auto expected = reference(f, boxes);
+    UC_CHECK(!expected.empty());
+
+    UC_CHECK(run_kernel(gx::cull::details::frustum_cull_sse, f, b) == expected);
+
+    if (sys::is_avx2_supported())
+    {
+        UC_CHECK(run_kernel(gx::cull::details::frustum_cull_avx2, f, b) == expected);
+    }
+
+    std::vector<uint32_t> visible;
+    gx::cull::frustum_cull(f, b, visible);
+    UC_CHECK(visible == expected);
+}
+
+UC_TEST(frustum_cull_views_match_single_view)
+{
+    auto boxes = random_boxes(1003);
+
+    gx::cull::object_bounds b;
+    for (auto&& box : boxes)
+    {
+        b.add(box);
+    }
+
+    math::frustum_planes views[2];
+    views[0] = camera_planes();
+
+    auto v = math::look_at_lh(math::point3(0.0f, 0.0f, 0.0f), math::point3(0.0f, 0.0f, -1.0f), math::vector3(0.0f, 1.0f, 0.0f));
+    auto p = math::perspective_fov_lh(3.141592654f / 3.0f, 1.5f, 0.5f, 60.0f);
+    views[1] = math::make_frustum_planes(math::mul(v, p));
+
+    std::vector<uint32_t> visible[2];
+    gx::cull::frustum_cull(&views[0], 2, b, &visible[0]);
+
+    UC_CHECK(visible[0] == reference(views[0], boxes));
+    UC_CHECK(visible[1] == reference(views[1], boxes));
+}
+
+UC_TEST(frustum_cull_empty_bounds)
+{
+    gx::cull::object_bounds b;
+    std::vector<uint32_t>   visible(3, 1);
+
+    gx::cull::frustum_cull(camera_planes(), b, visible);
+    UC_CHECK(visible.empty());
+}
+
+UC_TEST(frustum_cull_plane_orientation)
+{
+    const math::aabb in_front   = make_box(0.0f, 0.0f, 10.0f, 1.0f);
+    const math::aabb behind     = make_box(0.0f, 0.0f, -10.0f, 1.0f);
+
+    math::aabb4 boxes[1];
+    math::aabb  four[4] = { in_front, behind, in_front, behind };
+    math::convert_aabb_2_aabb4(&four[0], &boxes[0], 4);
+
+    //make_frustum_planes points inside, as the single box test expects
+    auto inward = camera_planes();
+    UC_CHECK(math::frustum_cull(&inward, &in_front) == math::frustum_cull_result::inside);
+    UC_CHECK(math::frustum_cull(&inward, &behind) == math::frustum_cull_result::outside);
+
+    alignas(16) uint32_t r[4];
+
+    math::frustum_cull_inward(&inward, &boxes[0], 1, reinterpret_cast<__m128i*>(&r[0]));
+    UC_CHECK((r[0] & 2) == 0 && (r[1] & 2) != 0 && (r[2] & 2) == 0 && (r[3] & 2) != 0);
+
+    //the four box kernel takes planes pointing outside, the same planes negated give the same answer
+    math::frustum_planes outward;
+    for (auto i = 0U; i < math::frustum_planes::plane_count::value; ++i)
+    {
+        outward.m_planes[i].m_value = math::negate(inward.m_planes[i].m_value);
+    }
+
+    alignas(16) uint32_t o[4];
+    math::frustum_cull(&outward, &boxes[0], 1, reinterpret_cast<__m128i*>(&o[0]));
+    UC_CHECK(o[0] == r[0] && o[1] == r[1] && o[2] == r[2] && o[3] == r[3]);
+
+    //and the inward planes as they are reject the box in front
+    math::frustum_cull(&inward, &boxes[0], 1, reinterpret_cast<__m128i*>(&o[0]));
+    UC_CHECK((o[0] & 2) != 0);
+}
@@ -0,0 +1,110 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <uc_dev/math/geometry_convex_clipping.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc;
+
+    bool near_equal(float a, float b)
+    {
+        return std::fabs(a - b) < 0.0001f;
+    }
+
+    math::frustum_points make_cube(float size)
+    {
+        math::frustum_points r;
+
+        r.m_points[math::frustum_points::near_down_left]    = math::point3(0.0f, 0.0f, 0.0f);
+        r.m_points[math::frustum_points::near_down_right]   = math::point3(size, 0.0f, 0.0f);
+        r.m_points[math::frustum_points::near_up_right]     = math::point3(size, size, 0.0f);
+        r.m_points[math::frustum_points::near_up_left]      = math::point3(0.0f, size, 0.0f);
+
+        r.m_points[math::frustum_points::far_down_left]     = math::point3(0.0f, 0.0f, size);
+        r.m_points[math::frustum_points::far_down_right]    = math::point3(size, 0.0f, size);
+        r.m_points[math::frustum_points::far_up_right]      = math::point3(size, size, size);
+        r.m_points[math::frustum_points::far_up_left]       = math::point3(0.0f, size, size);
+
+        return r;
+    }
+
+    struct point_bounds
+    {
+        float m_min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        float m_max[3] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+    };
+
+    point_bounds make_point_bounds(const math::convex_clipping::convex_polyhedron& p)
+    {
+        point_bounds r;
+
+        for (auto&& v : p.m_points)
+        {
+            const float c[3] = { math::get_x(v), math::get_y(v), math::get_z(v) };
+
+            for (auto i = 0U; i < 3; ++i)
+            {
+                r.m_min[i] = std::min(r.m_min[i], c[i]);
+                r.m_max[i] = std::max(r.m_max[i], c[i]);
+            }
+        }
+
+        return r;
+    }
+}
+
+UC_TEST(lerp_goes_from_the_first_to_the_second)
+{
+    const math::float4 a = math::set(0.0f, 2.0f, -4.0f, 1.0f);
+    const math::float4 b = math::set(10.0f, 2.0f, 4.0f, 1.0f);
+
+    UC_CHECK(math::get_x(math::lerp(a, b, 0.0f)) == 0.0f);
+    UC_CHECK(math::get_x(math::lerp(a, b, 1.0f)) == 10.0f);
+
+    const math::float4 q = math::lerp(a, b, 0.25f);
+    UC_CHECK(near_equal(math::get_x(q), 2.5f) && near_equal(math::get_y(q), 2.0f) && near_equal(math::get_z(q), -2.0f) && near_equal(math::get_w(q), 1.0f));
+}
+
+UC_TEST(make_plane_stores_the_distance_in_w)
+{
+    //normal along +z through z = 1
+    const math::plane p = math::make_plane(math::point3(0.0f, 0.0f, 1.0f), math::point3(1.0f, 0.0f, 1.0f), math::point3(0.0f, 1.0f, 1.0f));
+
+    UC_CHECK(near_equal(math::get_x(p.m_value), 0.0f) && near_equal(math::get_y(p.m_value), 0.0f) && near_equal(math::get_z(p.m_value), 1.0f));
+    UC_CHECK(near_equal(math::get_w(p.m_value), -1.0f));
+
+    UC_CHECK(near_equal(math::get_x(math::dot4(p.m_value, math::point3(5.0f, -3.0f, 1.0f))), 0.0f));
+    UC_CHECK(near_equal(math::get_x(math::dot4(p.m_value, math::point3(0.0f, 0.0f, 3.0f))), 2.0f));
+}
+
+UC_TEST(convex_hull_with_direction_sweeps_along_the_vector)
+{
+    const math::aabb scene = math::make_aabb(math::point3(-10.0f, -10.0f, -10.0f), math::point3(10.0f, 10.0f, 10.0f));
+
+    auto cube = math::convex_clipping::clip(make_cube(1.0f), scene);
+    UC_CHECK(cube.has_value());
+
+    //the faces towards the vector move, the ones away from it stay
+    const auto up = make_point_bounds(math::convex_clipping::convex_hull_with_direction(*cube, math::vector3(0.0f, 5.0f, 0.0f)));
+    UC_CHECK(near_equal(up.m_min[0], 0.0f) && near_equal(up.m_min[1], 0.0f) && near_equal(up.m_min[2], 0.0f));
+    UC_CHECK(near_equal(up.m_max[0], 1.0f) && near_equal(up.m_max[1], 6.0f) && near_equal(up.m_max[2], 1.0f));
+
+    const auto down = make_point_bounds(math::convex_clipping::convex_hull_with_direction(*cube, math::vector3(-3.0f, 0.0f, 0.0f)));
+    UC_CHECK(near_equal(down.m_min[0], -3.0f) && near_equal(down.m_max[0], 1.0f));
+    UC_CHECK(near_equal(down.m_min[1], 0.0f) && near_equal(down.m_max[1], 1.0f));
+
+    //the fixed capacity path agrees
+    math::convex_clipping::fixed_convex_polyhedron fixed_cube;
+    math::convex_clipping::fixed_convex_polyhedron fixed_hull;
+    UC_CHECK(math::convex_clipping::clip(make_cube(1.0f), scene, fixed_cube));
+    UC_CHECK(math::convex_clipping::convex_hull_with_direction(fixed_cube, math::vector3(0.0f, 5.0f, 0.0f), fixed_hull));
+
+    const auto fixed_up = make_point_bounds(math::convex_clipping::make_convex_polyhedron(fixed_hull));
+    UC_CHECK(near_equal(fixed_up.m_min[1], 0.0f) && near_equal(fixed_up.m_max[1], 6.0f));
+}
@@ -0,0 +1,136 @@
+#include "pch.h"
+
+#include <vector>
+
+#include <uc_dev/gx/cmd/indirect_draw_buffer.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc::gx::cmd;
+
+    struct instance
+    {
+        uint32_t m_id;
+    };
+
+    //a primitive range of a mesh, as the lip files have them
+    struct primitive_range
+    {
+        uint32_t m_begin;
+        uint32_t m_end;
+
+        uint32_t size() const
+        {
+            return m_end - m_begin;
+        }
+    };
+
+    bool equal(const draw_indexed_instance_arguments& a, uint32_t instance, uint32_t index_count, uint32_t start_index, int32_t base_vertex)
+    {
+        return a.m_instance == instance && a.m_draw.m_index_count_per_instance == index_count && a.m_draw.m_instance_count == 1
+            && a.m_draw.m_start_index_location == start_index && a.m_draw.m_base_vertex_location == base_vertex && a.m_draw.m_start_instance_location == 0;
+    }
+}
+
+UC_TEST(indirect_draw_buffer_merges_contiguous_ranges)
+{
+    indirect_draw_buffer<instance> b;
+
+    b.add_instance({ 7 });
+
+    const std::vector<primitive_range> ranges = { { 0, 30 }, { 30, 60 }, { 60, 66 }, { 90, 120 } };
+    b.add_draws(ranges, 100, 4);
+
+    //the first three ranges follow each other, the last one starts after a gap
+    UC_CHECK(b.draw_count() == 2);
+    UC_CHECK(equal(b.arguments()[0], 0, 66, 100, 4));
+    UC_CHECK(equal(b.arguments()[1], 0, 30, 190, 4));
+
+    //another base vertex is another draw, even if the indices follow
+    b.add_draw(10, 220, 8);
+    UC_CHECK(b.draw_count() == 3);
+    UC_CHECK(equal(b.arguments()[2], 0, 10, 220, 8));
+}
+
+UC_TEST(indirect_draw_buffer_keeps_the_draw_id_of_every_instance)
+{
+    indirect_draw_buffer<instance> b;
+
+    UC_CHECK(b.add_instance({ 10 }) == 0);
+    b.add_draw(6, 0, 0);
+    b.add_draw(6, 6, 0);
+
+    //the same mesh again, its ranges continue the ones of the last instance, but they read other instance data
+    UC_CHECK(b.add_instance({ 11 }) == 1);
+    b.add_draw(6, 12, 0);
+
+    UC_CHECK(b.add_instance({ 12 }) == 2);
+    UC_CHECK(b.add_instance({ 13 }) == 3);
+    b.add_draw(3, 0, 0);
+
+    UC_CHECK(b.instance_count() == 4);
+    UC_CHECK(b.instances()[3].m_id == 13);
+
+    //an instance without draws has no arguments, the draw ids still index the instances
+    UC_CHECK(b.draw_count() == 3);
+    UC_CHECK(equal(b.arguments()[0], 0, 12, 0, 0));
+    UC_CHECK(equal(b.arguments()[1], 1, 6, 12, 0));
+    UC_CHECK(equal(b.arguments()[2], 3, 3, 0, 0));
+}
+
+UC_TEST(indirect_draw_buffer_skips_empty_draws)
+{
+    indirect_draw_buffer<instance> b;
+
+    b.add_instance({ 0 });
+    b.add_draw(0, 0, 0);
+    UC_CHECK(b.draw_count() == 0);
+
+    b.add_draw(9, 0, 0);
+    b.add_draw(0, 9, 0);
+    b.add_draw(3, 9, 0);
+
+    UC_CHECK(b.draw_count() == 1);
+    UC_CHECK(equal(b.arguments()[0], 0, 12, 0, 0));
+}
+
+UC_TEST(indirect_draw_buffer_clear_keeps_the_memory)
+{
+    indirect_draw_buffer<instance> b;
+
+    for (auto i = 0U; i < 64; ++i)
+    {
+        b.add_instance({ i });
+        b.add_draw(3, i * 6, 0);
+    }
+
+    auto arguments = b.arguments().capacity();
+    auto instances = b.instances().capacity();
+    auto data      = b.arguments().data();
+
+    b.clear();
+
+    UC_CHECK(b.draw_count() == 0 && b.instance_count() == 0);
+    UC_CHECK(b.arguments().capacity() == arguments && b.instances().capacity() == instances);
+
+    //the next frame starts the draw ids from 0 again
+    UC_CHECK(b.add_instance({ 1 }) == 0);
+    b.add_draw(3, 0, 0);
+    UC_CHECK(b.arguments().data() == data);
+    UC_CHECK(equal(b.arguments()[0], 0, 3, 0, 0));
+}
+
+UC_TEST(indirect_draw_buffer_arguments_match_the_command_signature)
+{
+    //the draw id root constant first, then D3D12_DRAW_INDEXED_ARGUMENTS, tightly packed
+    draw_indexed_instance_arguments a[2] = {};
+
+    auto base = reinterpret_cast<const uint8_t*>(&a[0]);
+
+    UC_CHECK(reinterpret_cast<const uint8_t*>(&a[0].m_instance) - base == 0);
+    UC_CHECK(reinterpret_cast<const uint8_t*>(&a[0].m_draw.m_index_count_per_instance) - base == 4);
+    UC_CHECK(reinterpret_cast<const uint8_t*>(&a[0].m_draw.m_start_instance_location) - base == 20);
+    UC_CHECK(reinterpret_cast<const uint8_t*>(&a[1]) - base == 24);
+}
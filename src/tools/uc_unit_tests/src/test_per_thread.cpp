@@ -0,0 +1,63 @@
+#include "pch.h"
+
+#include <thread>
+#include <vector>
+
+#include <uc_dev/gx/dx12/cmd/per_thread.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc::gx::dx12;
+
+    bool take(std::vector<int>& v, int& r)
+    {
+        if (v.empty())
+        {
+            return false;
+        }
+
+        r = v.back();
+        v.pop_back();
+        return true;
+    }
+}
+
+UC_TEST(per_thread_steals_from_the_other_threads)
+{
+    per_thread<std::vector<int>> p;
+
+    //another thread frees, as the submitting thread does
+    std::thread([&p]() { p.local([](std::vector<int>& v) { v.push_back(1); v.push_back(2); }); }).join();
+
+    int r = 0;
+
+    UC_CHECK(!p.local([&r](std::vector<int>& v) { return take(v, r); }));
+    UC_CHECK(p.steal([&r](std::vector<int>& v) { return take(v, r); }) && r == 2);
+    UC_CHECK(p.steal([&r](std::vector<int>& v) { return take(v, r); }) && r == 1);
+    UC_CHECK(!p.steal([&r](std::vector<int>& v) { return take(v, r); }));
+}
+
+UC_TEST(per_thread_visits_the_used_slots)
+{
+    per_thread<std::vector<int>, 8> p;
+
+    uint32_t visited = 0;
+    p.for_each([&visited](std::vector<int>&) { visited++; });
+    UC_CHECK(visited == 0);
+
+    //a thread which never called local has nothing to steal from
+    int r = 0;
+    UC_CHECK(!p.steal([&r](std::vector<int>& v) { return take(v, r); }));
+
+    p.local([](std::vector<int>& v) { v.push_back(3); });
+    std::thread([&p]() { p.local([](std::vector<int>& v) { v.push_back(4); }); }).join();
+
+    uint32_t values = 0;
+    p.for_each([&visited, &values](std::vector<int>& v) { visited++; values += static_cast<uint32_t>(v.size()); });
+
+    //the slots of the two threads, or one slot if their indices wrap to the same one
+    UC_CHECK(visited >= 1 && visited <= 2);
+    UC_CHECK(values == 2);
+}
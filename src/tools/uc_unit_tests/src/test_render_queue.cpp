@@ -0,0 +1,195 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <uc_dev/gx/cmd/render_queue.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc::gx::cmd;
+
+    bool ordered_by_key(const std::vector<render_item>& items)
+    {
+        return std::is_sorted(items.begin(), items.end(), [](const render_item& a, const render_item& b)
+        {
+            return a.m_key < b.m_key;
+        });
+    }
+
+    //the draws of equal keys must come in the order they were added in
+    bool stable(const std::vector<render_item>& items)
+    {
+        for (auto i = 1U; i < items.size(); ++i)
+        {
+            if (items[i - 1].m_key == items[i].m_key && items[i - 1].m_draw > items[i].m_draw)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::vector<render_item> stable_sorted(std::vector<render_item> items)
+    {
+        std::stable_sort(items.begin(), items.end(), [](const render_item& a, const render_item& b)
+        {
+            return a.m_key < b.m_key;
+        });
+
+        return items;
+    }
+
+    bool equal(const std::vector<render_item>& a, const std::vector<render_item>& b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const render_item& x, const render_item& y)
+        {
+            return x.m_key == y.m_key && x.m_draw == y.m_draw;
+        });
+    }
+}
+
+UC_TEST(radix_sort_keeps_the_order_of_equal_keys)
+{
+    std::vector<render_item> items;
+    std::vector<render_item> scratch;
+
+    //few distinct keys spread over all bytes, the draws count up
+    const uint64_t keys[] = { 0xF000000000000001ULL, 0x0000000000000100ULL, 0x00FF00FF00FF00FFULL, 0x0000000000000001ULL, 0x8000000000000000ULL };
+
+    for (auto i = 0U; i < 100; ++i)
+    {
+        items.push_back({ keys[(i * 7) % 5], i });
+    }
+
+    auto expected = stable_sorted(items);
+    radix_sort(items, scratch);
+
+    UC_CHECK(ordered_by_key(items));
+    UC_CHECK(stable(items));
+    UC_CHECK(equal(items, expected));
+}
+
+UC_TEST(radix_sort_skips_the_digits_all_keys_share)
+{
+    std::vector<render_item> scratch;
+
+    //one digit differs, one pass, the result is in the scratch buffer before the swap
+    {
+        std::vector<render_item> items = { { 0x1234567800000003ULL, 0 }, { 0x1234567800000001ULL, 1 }, { 0x1234567800000002ULL, 2 }, { 0x1234567800000001ULL, 3 } };
+        auto expected = stable_sorted(items);
+        radix_sort(items, scratch);
+        UC_CHECK(equal(items, expected));
+    }
+
+    //two digits differ, the first and the last one
+    {
+        std::vector<render_item> items = { { 0x0200000000000001ULL, 0 }, { 0x0100000000000002ULL, 1 }, { 0x0200000000000000ULL, 2 }, { 0x0100000000000002ULL, 3 } };
+        auto expected = stable_sorted(items);
+        radix_sort(items, scratch);
+        UC_CHECK(equal(items, expected));
+    }
+
+    //all keys equal, no pass moves anything
+    {
+        std::vector<render_item> items = { { 42, 0 }, { 42, 1 }, { 42, 2 } };
+        radix_sort(items, scratch);
+        UC_CHECK(items[0].m_draw == 0 && items[1].m_draw == 1 && items[2].m_draw == 2);
+    }
+
+    //nothing to sort
+    {
+        std::vector<render_item> items;
+        radix_sort(items, scratch);
+        UC_CHECK(items.empty());
+
+        items.push_back({ 7, 0 });
+        radix_sort(items, scratch);
+        UC_CHECK(items.size() == 1 && items[0].m_key == 7);
+    }
+}
+
+UC_TEST(render_queue_orders_translucent_draws_back_to_front)
+{
+    render_queue q;
+    q.begin(1);
+
+    //the pso and material are the same, the depth decides
+    q[0].add(sort_key::translucent(1, 3, 5, 0.25f), 0);
+    q[0].add(sort_key::translucent(1, 3, 5, 0.75f), 1);
+    q[0].add(sort_key::translucent(1, 3, 5, 0.50f), 2);
+
+    //the far draw of a cheaper state still comes before the near one
+    q[0].add(sort_key::translucent(1, 0, 0, 0.10f), 3);
+    q[0].add(sort_key::translucent(1, 4095, 9, 1.00f), 4);
+
+    //opaque draws of the pass come first, front to back, and the next pass after all of them
+    q[0].add(sort_key::opaque(1, 2, 0, 0.9f), 5);
+    q[0].add(sort_key::opaque(1, 2, 0, 0.1f), 6);
+    q[0].add(sort_key::opaque(2, 0, 0, 0.0f), 7);
+
+    q.sort();
+
+    auto&& items = q.items();
+    UC_CHECK(items.size() == 8);
+
+    const uint32_t expected[] = { 6, 5, 4, 1, 2, 0, 3, 7 };
+
+    for (auto i = 0U; i < 8; ++i)
+    {
+        UC_CHECK(items[i].m_draw == expected[i]);
+    }
+
+    UC_CHECK(sort_key::is_translucent(items[2].m_key) && !sort_key::is_translucent(items[1].m_key));
+    UC_CHECK(sort_key::pso(items[2].m_key) == 4095 && sort_key::material(items[2].m_key) == 9);
+    UC_CHECK(sort_key::pass(items[7].m_key) == 2);
+}
+
+UC_TEST(render_queue_joins_the_buckets_in_the_order_of_the_jobs)
+{
+    const uint32_t job_count        = 4;
+    const uint32_t draws_per_job    = 1000;
+
+    render_queue q;
+
+    //two frames, the second one reuses the memory of the first
+    for (auto frame = 0U; frame < 2; ++frame)
+    {
+        q.begin(job_count);
+        UC_CHECK(q.bucket_count() == job_count);
+
+        std::vector<std::thread> jobs;
+
+        for (auto j = 0U; j < job_count; ++j)
+        {
+            jobs.emplace_back([&q, j, draws_per_job]()
+            {
+                for (auto i = 0U; i < draws_per_job; ++i)
+                {
+                    auto draw = j * draws_per_job + i;
+                    q[j].add(sort_key::opaque(0, draw % 3, 0, 0.0f), draw);
+                }
+            });
+        }
+
+        for (auto&& j : jobs)
+        {
+            j.join();
+        }
+
+        q.sort();
+
+        auto&& items = q.items();
+        UC_CHECK(q.size() == job_count * draws_per_job);
+        UC_CHECK(ordered_by_key(items));
+
+        //the draws count up over the jobs, so equal keys keep the order of the jobs and of the adds
+        UC_CHECK(stable(items));
+        UC_CHECK(items.front().m_draw == 0);
+        UC_CHECK(sort_key::pso(items.back().m_key) == 2);
+    }
+}
@@ -0,0 +1,214 @@
+#include "pch.h"
+
+#include <vector>
+
+#include <uc_dev/gx/cmd/command_stream.h>
+#include <uc_dev/gx/cmd/null_backend.h>
+#include <uc_dev/gx/cmd/resource_state_tracker.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc::gx::cmd;
+
+    std::vector<barrier> flush(resource_state_tracker& t)
+    {
+        std::vector<barrier> r;
+        t.flush([&r](const barrier* b, uint32_t count) { r.insert(r.end(), b, b + count); });
+        return r;
+    }
+
+    bool equal(const barrier& b, const void* resource, uint32_t subresource, uint32_t before, uint32_t after)
+    {
+        return b.m_resource == resource && b.m_subresource == subresource && b.m_before == before && b.m_after == after && b.m_flags == barrier_flags_none;
+    }
+
+    //the state a draw needs, so the backend flushes the barriers as a command list would
+    void record_draw(command_stream& s, const void* pso, const void* target)
+    {
+        s.clear_depth_stencil({ target, view_type::depth_buffer }, clear_depth, 0.0f, 0);
+        s.set_render_targets({}, { target, view_type::depth_buffer });
+        s.set_view_port({ 0.0f, 0.0f, 256.0f, 256.0f, 0.0f, 1.0f });
+        s.set_graphics_pipeline_state(pso);
+        s.set_primitive_topology(primitive_topology_triangle_list);
+        s.draw_instanced(3, 1);
+    }
+}
+
+UC_TEST(resource_state_tracker_drops_and_merges_transitions)
+{
+    resource_state_tracker t;
+    int r = 0;
+
+    t.track(&r, resource_state_common);
+
+    UC_CHECK(t.transition(&r, resource_state_common));
+    UC_CHECK(t.pending_count() == 0);
+
+    //common -> render target -> pixel shader resource without a use in between is one barrier
+    t.transition(&r, resource_state_render_target);
+    t.transition(&r, resource_state_pixel_shader_resource);
+
+    auto b = flush(t);
+    UC_CHECK(b.size() == 1 && equal(b[0], &r, all_subresources, resource_state_common, resource_state_pixel_shader_resource));
+
+    //there and back again is no barrier
+    t.transition(&r, resource_state_copy_dest);
+    t.transition(&r, resource_state_pixel_shader_resource);
+    UC_CHECK(flush(t).empty());
+
+    //a read state the resource is already in
+    t.track(&r, resource_state_pixel_shader_resource | resource_state_non_pixel_shader_resource);
+    t.transition(&r, resource_state_pixel_shader_resource);
+    UC_CHECK(flush(t).empty());
+
+    auto&& st = t.statistics();
+    UC_CHECK(st.m_transitions == 6);
+    UC_CHECK(st.m_eliminated == 2);
+    UC_CHECK(st.m_merged == 2);
+    UC_CHECK(st.m_barriers == 1 && st.m_flushes == 1);
+}
+
+UC_TEST(resource_state_tracker_needs_a_known_state)
+{
+    resource_state_tracker t;
+    int r = 0;
+
+    UC_CHECK(!t.transition(&r, resource_state_render_target));
+    UC_CHECK(t.pending_count() == 0);
+    UC_CHECK(t.statistics().m_unknown == 1);
+
+    //the caller knows the before state
+    int s = 0;
+    UC_CHECK(t.transition(&s, resource_state_render_target, all_subresources, resource_state_common));
+
+    auto b = flush(t);
+    UC_CHECK(b.size() == 1 && equal(b[0], &s, all_subresources, resource_state_common, resource_state_render_target));
+
+    //the tracked state wins over the before state of the caller
+    UC_CHECK(t.transition(&s, resource_state_pixel_shader_resource, all_subresources, resource_state_common));
+
+    b = flush(t);
+    UC_CHECK(b.size() == 1 && equal(b[0], &s, all_subresources, resource_state_render_target, resource_state_pixel_shader_resource));
+
+    //a subresource past the tracked count
+    int m = 0;
+    t.track(&m, resource_state_common, 2);
+    UC_CHECK(!t.transition(&m, resource_state_copy_dest, 2));
+    UC_CHECK(t.pending_count() == 0);
+}
+
+UC_TEST(resource_state_tracker_collapses_subresource_barriers)
+{
+    resource_state_tracker t;
+    int r = 0;
+
+    t.track(&r, resource_state_pixel_shader_resource, 4);
+
+    for (auto i = 0U; i < 4; ++i)
+    {
+        t.transition(&r, resource_state_depth_write, i);
+    }
+
+    //every subresource moves between the same states, one barrier of the whole resource
+    auto b = flush(t);
+    UC_CHECK(b.size() == 1 && equal(b[0], &r, all_subresources, resource_state_pixel_shader_resource, resource_state_depth_write));
+    UC_CHECK(t.statistics().m_collapsed == 3);
+    UC_CHECK(t.state(&r) == resource_state_depth_write);
+
+    //some subresources only, one barrier each
+    t.transition(&r, resource_state_pixel_shader_resource, 1);
+    t.transition(&r, resource_state_pixel_shader_resource, 2);
+
+    b = flush(t);
+    UC_CHECK(b.size() == 2 && equal(b[0], &r, 1, resource_state_depth_write, resource_state_pixel_shader_resource) && equal(b[1], &r, 2, resource_state_depth_write, resource_state_pixel_shader_resource));
+    UC_CHECK(t.state(&r) == resource_state_unknown);
+    UC_CHECK(t.state(&r, 1) == resource_state_pixel_shader_resource);
+
+    //the whole resource from different states, the subresources already there have no barrier
+    t.transition(&r, resource_state_pixel_shader_resource);
+
+    b = flush(t);
+    UC_CHECK(b.size() == 2 && equal(b[0], &r, 0, resource_state_depth_write, resource_state_pixel_shader_resource) && equal(b[1], &r, 3, resource_state_depth_write, resource_state_pixel_shader_resource));
+    UC_CHECK(t.state(&r) == resource_state_pixel_shader_resource);
+}
+
+UC_TEST(resource_state_tracker_keeps_subresource_barriers_from_different_states)
+{
+    resource_state_tracker t;
+    int r = 0;
+
+    t.track(&r, resource_state_common, 2);
+    t.transition(&r, resource_state_copy_dest, 0);
+    flush(t);
+
+    //the subresources end in the same state, but start from different states
+    t.transition(&r, resource_state_pixel_shader_resource);
+
+    auto b = flush(t);
+    UC_CHECK(b.size() == 2);
+    UC_CHECK(equal(b[0], &r, 0, resource_state_copy_dest, resource_state_pixel_shader_resource));
+    UC_CHECK(equal(b[1], &r, 1, resource_state_common, resource_state_pixel_shader_resource));
+    UC_CHECK(t.statistics().m_collapsed == 0);
+}
+
+UC_TEST(resource_state_tracker_replays_a_recorded_shadow_pass)
+{
+    command_stream s;
+
+    int pso     = 0;
+    int shadows = 0;
+
+    //all cascades go to depth write before the first draw, as the pass clears them together
+    s.track_resource(&shadows, resource_state_pixel_shader_resource, 4);
+
+    for (auto i = 0U; i < 4; ++i)
+    {
+        s.transition_subresource(&shadows, i, resource_state_depth_write);
+    }
+
+    record_draw(s, &pso, &shadows);
+
+    //back to shader reads one cascade at a time, with a draw in between
+    for (auto i = 0U; i < 4; ++i)
+    {
+        s.transition_subresource(&shadows, i, resource_state_pixel_shader_resource);
+        record_draw(s, &pso, &shadows);
+    }
+
+    auto b = validate(s);
+    auto&& st = b.resource_states().statistics();
+
+    UC_CHECK(b.error_count() == 0);
+    UC_CHECK(b.statistics().m_transitions == 8);
+    UC_CHECK(b.statistics().m_barriers == 5);
+    UC_CHECK(b.statistics().m_barrier_batches == 5);
+    UC_CHECK(st.m_collapsed == 3);
+    UC_CHECK(b.resource_states().state(&shadows) == resource_state_pixel_shader_resource);
+}
+
+UC_TEST(resource_state_tracker_reports_untracked_resources_in_a_recorded_stream)
+{
+    command_stream s;
+
+    int pso     = 0;
+    int target  = 0;
+
+    s.transition_resource(&target, resource_state_depth_write);
+    record_draw(s, &pso, &target);
+
+    auto a = validate(s);
+    UC_CHECK(a.error_count() == 1);
+    UC_CHECK(a.statistics().m_barriers == 0);
+
+    //the same pass with the before state
+    s.reset();
+    s.transition_resource(&target, resource_state_depth_read, resource_state_depth_write);
+    record_draw(s, &pso, &target);
+
+    auto b = validate(s);
+    UC_CHECK(b.error_count() == 0);
+    UC_CHECK(b.statistics().m_barriers == 1);
+    UC_CHECK(b.resource_states().state(&target) == resource_state_depth_write);
+}
@@ -0,0 +1,213 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include <uc_dev/gx/shadows/shadow_cascades.h>
+#include <uc_dev/math/geometry_convex_clipping.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc;
+
+    //the camera, scene and light of the moment shadows world
+    gx::pinhole_camera make_camera()
+    {
+        gx::pinhole_camera c;
+        c.set_view_position(math::point3(0.0f, 1.0f, 5.5f));
+        c.set_forward(math::vector3(0.0f, 0.0f, -1.0f));
+        c.set_up(math::vector3(0.0f, 1.0f, 0.0f));
+        c.set_far(1200.0f);
+        return c;
+    }
+
+    math::aabb make_scene()
+    {
+        return math::make_aabb(math::point3(-25.0f, -25.0f, -25.0f), math::point3(25.0f, 25.0f, 25.0f));
+    }
+
+    math::float4 make_light()
+    {
+        return math::normalize3(math::vector3(1.0f, 1.0f, 0.0f));
+    }
+
+    //texel size of the fit before the cascades: the scene box in light space, not snapped
+    float scene_fit_texel(const math::aabb& scene, math::afloat4 light, uint32_t resolution)
+    {
+        const math::float4x4 v = math::view(math::point3(6.0f, 6.0f, 0.0f), math::negate(light), math::orthogonal3_vector(light));
+
+        float mn[2] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        float mx[2] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+
+        for (auto&& p : math::make_points(scene))
+        {
+            const math::float4 q = math::transform3(p, v);
+            mn[0] = std::min(mn[0], math::get_x(q)); mx[0] = std::max(mx[0], math::get_x(q));
+            mn[1] = std::min(mn[1], math::get_y(q)); mx[1] = std::max(mx[1], math::get_y(q));
+        }
+
+        return std::max(mx[0] - mn[0], mx[1] - mn[1]) / resolution;
+    }
+
+    //the slice clipped by the scene must be inside the cascade window
+    bool covers(const gx::shadows::shadow_cascade& c, const gx::pinhole_camera& camera, const math::aabb& scene)
+    {
+        math::convex_clipping::fixed_convex_polyhedron receivers;
+
+        if (!math::convex_clipping::clip(gx::shadows::make_frustum_points(&camera, c.m_split_near, c.m_split_far), scene, receivers))
+        {
+            return true;
+        }
+
+        const math::float4x4 vp = math::mul(c.m_view, c.m_projection);
+
+        for (auto i = 0U; i < receivers.m_point_count; ++i)
+        {
+            const math::float4 p = math::transform3(receivers.m_points[i], vp);
+
+            if (std::fabs(math::get_x(p)) > 1.001f || std::fabs(math::get_y(p)) > 1.001f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+UC_TEST(shadow_cascades_single_cascade_not_worse_than_scene_fit)
+{
+    gx::shadows::cascade_settings s;
+    s.m_cascade_count   = 1;
+    s.m_resolution      = 2048;
+
+    const auto camera   = make_camera();
+    const auto scene    = make_scene();
+    const auto light    = make_light();
+
+    gx::shadows::shadow_cascades r;
+    gx::shadows::build_cascades(&camera, scene, light, s, r);
+
+    const float reference = scene_fit_texel(scene, light, s.m_resolution);
+
+    UC_CHECK(!r.m_cascades[0].m_empty);
+    UC_CHECK(r.m_cascades[0].m_texel_size <= reference * 1.001f);
+    UC_CHECK(covers(r.m_cascades[0], camera, scene));
+}
+
+UC_TEST(shadow_cascades_stable_under_camera_motion)
+{
+    gx::shadows::cascade_settings s;
+    s.m_cascade_count   = 4;
+    s.m_resolution      = 2048;
+
+    const auto scene    = make_scene();
+    const auto light    = make_light();
+
+    auto camera = make_camera();
+    camera.set_far(200.0f);
+
+    gx::shadows::shadow_cascades first;
+    gx::shadows::build_cascades(&camera, scene, light, s, first);
+
+    for (auto i = 0U; i < 16; ++i)
+    {
+        const float a = 0.4f * i;
+        camera.set_forward(math::vector3(std::sin(a), 0.1f * std::cos(3.0f * a), -std::cos(a)));
+        camera.set_view_position(math::point3(0.3f * i, 1.0f, 5.5f - 0.2f * i));
+
+        gx::shadows::shadow_cascades r;
+        gx::shadows::build_cascades(&camera, scene, light, s, r);
+
+        for (auto c = 0U; c < r.m_count; ++c)
+        {
+            if (r.m_cascades[c].m_empty)
+            {
+                continue;
+            }
+
+            //the size does not change, the window moves in whole texels, the receivers stay covered
+            const float texel = r.m_cascades[c].m_texel_size;
+            UC_CHECK(texel == first.m_cascades[c].m_texel_size);
+
+            const float x = r.m_cascades[c].m_camera.x_min() / texel;
+            UC_CHECK(std::fabs(x - std::round(x)) < 1e-2f || r.m_cascades[c].m_camera.x_min() == first.m_cascades[c].m_camera.x_min());
+            UC_CHECK(covers(r.m_cascades[c], camera, scene));
+        }
+    }
+}
+
+UC_TEST(shadow_cascades_near_cascades_are_denser)
+{
+    gx::shadows::cascade_settings s;
+    s.m_cascade_count   = 4;
+    s.m_resolution      = 2048;
+
+    auto camera = make_camera();
+    camera.set_far(200.0f);
+
+    gx::shadows::shadow_cascades r;
+    gx::shadows::build_cascades(&camera, make_scene(), make_light(), s, r);
+
+    const float reference = scene_fit_texel(make_scene(), make_light(), s.m_resolution);
+
+    UC_CHECK(r.m_cascades[0].m_texel_size < reference);
+
+    for (auto c = 0U; c < r.m_count; ++c)
+    {
+        UC_CHECK(r.m_cascades[c].m_empty || r.m_cascades[c].m_texel_size <= reference * 1.001f);
+    }
+}
+
+UC_TEST(shadow_cascades_reused_hulls_match_a_fresh_build)
+{
+    gx::shadows::cascade_settings s;
+    s.m_cascade_count   = 4;
+    s.m_resolution      = 2048;
+
+    const auto scene    = make_scene();
+    const auto light    = make_light();
+
+    auto camera = make_camera();
+    camera.set_far(200.0f);
+
+    //built every frame into the same cascades, every other frame with a still camera
+    gx::shadows::shadow_cascades reused;
+
+    for (auto i = 0U; i < 16; ++i)
+    {
+        const float a = 0.4f * (i / 2);
+        camera.set_forward(math::vector3(std::sin(a), 0.0f, -std::cos(a)));
+        camera.set_view_position(math::point3(0.3f * (i / 2), 1.0f, 5.5f));
+
+        gx::shadows::build_cascades(&camera, scene, light, s, reused);
+
+        gx::shadows::shadow_cascades fresh;
+        gx::shadows::build_cascades(&camera, scene, light, s, fresh);
+
+        for (auto c = 0U; c < fresh.m_count; ++c)
+        {
+            UC_CHECK(reused.m_cascades[c].m_empty == fresh.m_cascades[c].m_empty);
+            UC_CHECK(reused.m_cascades[c].m_camera.x_min() == fresh.m_cascades[c].m_camera.x_min());
+            UC_CHECK(reused.m_cascades[c].m_camera.y_max() == fresh.m_cascades[c].m_camera.y_max());
+            UC_CHECK(reused.m_cascades[c].m_camera.get_near() == fresh.m_cascades[c].m_camera.get_near());
+            UC_CHECK(reused.m_cascades[c].m_camera.get_far() == fresh.m_cascades[c].m_camera.get_far());
+        }
+    }
+
+    //with a tolerance, a small move keeps the receivers of the previous build, without one they follow the camera
+    const float x = math::get_x(reused.m_hulls[0].clipped().m_points[0]);
+
+    s.m_hull_tolerance = 1.0f;
+    camera.set_view_position(math::point3(0.3f * 7 + 0.01f, 1.0f, 5.5f));
+    gx::shadows::build_cascades(&camera, scene, light, s, reused);
+    UC_CHECK(math::get_x(reused.m_hulls[0].clipped().m_points[0]) == x);
+
+    s.m_hull_tolerance = 0.0f;
+    gx::shadows::build_cascades(&camera, scene, light, s, reused);
+    UC_CHECK(math::get_x(reused.m_hulls[0].clipped().m_points[0]) != x);
+}
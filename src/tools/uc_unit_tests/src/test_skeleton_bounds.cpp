@@ -0,0 +1,113 @@
+#include "pch.h"
+
+#include <cmath>
+#include <vector>
+
+#include <uc_dev/gx/anm/transforms.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc;
+
+    //joints in bind pose, one bounding sphere per joint
+    void make_skeleton(lip::skeleton& s, const std::vector<math::float4>& centers, const std::vector<float>& radii)
+    {
+        s.m_joint_inverse_bind_pose2.resize(centers.size());
+        s.m_joint_bounding_volumes.resize(centers.size());
+
+        for (auto i = 0U; i < centers.size(); ++i)
+        {
+            math::store44(&s.m_joint_inverse_bind_pose2[i].m_a0, math::identity_matrix());
+
+            auto&& v = s.m_joint_bounding_volumes[i];
+            v.m_center.m_x  = math::get_x(centers[i]);
+            v.m_center.m_y  = math::get_y(centers[i]);
+            v.m_center.m_z  = math::get_z(centers[i]);
+            v.m_radius      = radii[i];
+        }
+    }
+
+    bool near(math::afloat4 v, float x, float y, float z)
+    {
+        const float e = 1e-4f;
+        return std::fabs(math::get_x(v) - x) < e && std::fabs(math::get_y(v) - y) < e && std::fabs(math::get_z(v) - z) < e;
+    }
+
+    bool ordered(const math::aabb& b)
+    {
+        auto mn = math::bounds_min(b);
+        auto mx = math::bounds_max(b);
+        return math::get_x(mn) <= math::get_x(mx) && math::get_y(mn) <= math::get_y(mx) && math::get_z(mn) <= math::get_z(mx);
+    }
+}
+
+UC_TEST(skeleton_bounds_encloses_spheres)
+{
+    lip::skeleton s;
+    make_skeleton(s, { math::point3(0.0f, 0.0f, 0.0f), math::point3(2.0f, 0.0f, 0.0f) }, { 1.0f, 0.5f });
+
+    std::vector<math::float4x4> joints = { math::identity_matrix(), math::translation(0.0f, 3.0f, 0.0f) };
+
+    auto b = gx::anm::skeleton_bounds(&s, joints);
+    UC_CHECK(near(math::bounds_min(b), -1.0f, -1.0f, -1.0f));
+    UC_CHECK(near(math::bounds_max(b), 2.5f, 3.5f, 1.0f));
+}
+
+UC_TEST(skeleton_bounds_scales_radius)
+{
+    lip::skeleton s;
+    make_skeleton(s, { math::point3(0.0f, 0.0f, 0.0f) }, { 1.0f });
+
+    std::vector<math::float4x4> joints = { math::scaling(2.0f, 1.0f, 1.0f) };
+
+    auto b = gx::anm::skeleton_bounds(&s, joints);
+    UC_CHECK(near(math::bounds_min(b), -2.0f, -2.0f, -2.0f));
+    UC_CHECK(near(math::bounds_max(b), 2.0f, 2.0f, 2.0f));
+}
+
+UC_TEST(skeleton_bounds_skips_unskinned_joints)
+{
+    lip::skeleton s;
+    make_skeleton(s, { math::point3(0.0f, 0.0f, 0.0f), math::point3(10.0f, 0.0f, 0.0f) }, { 1.0f, -1.0f });
+
+    std::vector<math::float4x4> joints = { math::identity_matrix(), math::identity_matrix() };
+
+    auto b = gx::anm::skeleton_bounds(&s, joints);
+    UC_CHECK(near(math::bounds_max(b), 1.0f, 1.0f, 1.0f));
+}
+
+UC_TEST(skeleton_bounds_no_skinned_joints_uses_joint_positions)
+{
+    lip::skeleton s;
+    make_skeleton(s, { math::point3(0.0f, 0.0f, 0.0f), math::point3(0.0f, 0.0f, 0.0f) }, { -1.0f, -1.0f });
+
+    std::vector<math::float4x4> joints = { math::translation(1.0f, 2.0f, 3.0f), math::translation(-1.0f, 0.0f, 5.0f) };
+
+    auto b = gx::anm::skeleton_bounds(&s, joints);
+    UC_CHECK(ordered(b));
+    UC_CHECK(near(math::bounds_min(b), -1.0f, 0.0f, 3.0f));
+    UC_CHECK(near(math::bounds_max(b), 1.0f, 2.0f, 5.0f));
+}
+
+UC_TEST(skeleton_bounds_without_volumes_uses_joint_positions)
+{
+    lip::skeleton s;
+
+    std::vector<math::float4x4> joints = { math::translation(1.0f, 2.0f, 3.0f) };
+
+    auto b = gx::anm::skeleton_bounds(&s, joints);
+    UC_CHECK(near(math::bounds_min(b), 1.0f, 2.0f, 3.0f));
+    UC_CHECK(near(math::bounds_max(b), 1.0f, 2.0f, 3.0f));
+}
+
+UC_TEST(skeleton_bounds_empty_is_a_point)
+{
+    lip::skeleton s;
+
+    auto b = gx::anm::skeleton_bounds(&s, {});
+    UC_CHECK(ordered(b));
+    UC_CHECK(near(math::bounds_min(b), 0.0f, 0.0f, 0.0f));
+    UC_CHECK(near(math::bounds_max(b), 0.0f, 0.0f, 0.0f));
+}
@@ -0,0 +1,212 @@
+#include "pch.h"
+
+#include <uc_dev/gx/cmd/state_filter.h>
+
+#include "uc_unit_tests.h"
+
+namespace
+{
+    using namespace uc::gx::cmd;
+
+    struct constants
+    {
+        float m_values[4];
+    };
+
+    uint32_t filtered(const state_filter& f, state_call c)
+    {
+        return f.statistics().m_filtered[static_cast<uint32_t>(c)];
+    }
+
+    uint32_t issued(const state_filter& f, state_call c)
+    {
+        return f.statistics().m_issued[static_cast<uint32_t>(c)];
+    }
+}
+
+UC_TEST(state_filter_drops_repeated_state)
+{
+    state_filter f;
+
+    int pso0 = 0;
+    int pso1 = 0;
+
+    UC_CHECK(f.set_pipeline_state(&pso0));
+    UC_CHECK(!f.set_pipeline_state(&pso0));
+    UC_CHECK(f.set_pipeline_state(&pso1));
+
+    UC_CHECK(f.set_primitive_topology(primitive_topology_triangle_list));
+    UC_CHECK(!f.set_primitive_topology(primitive_topology_triangle_list));
+
+    UC_CHECK(f.set_index_buffer({ 0x1000, 256, index_format_r16_uint }));
+    UC_CHECK(!f.set_index_buffer({ 0x1000, 256, index_format_r16_uint }));
+    UC_CHECK(f.set_index_buffer({ 0x1000, 256, index_format_r32_uint }));
+
+    UC_CHECK(filtered(f, state_call::pipeline_state) == 1 && issued(f, state_call::pipeline_state) == 2);
+    UC_CHECK(filtered(f, state_call::primitive_topology) == 1);
+    UC_CHECK(filtered(f, state_call::index_buffer) == 1 && issued(f, state_call::index_buffer) == 2);
+    UC_CHECK(f.statistics().issued() == 5 && f.statistics().filtered() == 3);
+}
+
+UC_TEST(state_filter_starts_a_new_command_list_unknown)
+{
+    state_filter f;
+
+    int pso  = 0;
+    int heap = 0;
+    int* heaps[] = { &heap };
+
+    f.set_pipeline_state(&pso);
+    f.set_primitive_topology(primitive_topology_triangle_list);
+    f.set_descriptor_heaps(heaps, 1);
+    f.set_constants(bind_point::graphics, 0, &pso, sizeof(pso));
+
+    f.invalidate();
+
+    //the same state again, the reset command list has none of it
+    UC_CHECK(f.set_pipeline_state(&pso));
+    UC_CHECK(f.set_primitive_topology(primitive_topology_triangle_list));
+    UC_CHECK(f.set_descriptor_heaps(heaps, 1));
+    UC_CHECK(f.set_constants(bind_point::graphics, 0, &pso, sizeof(pso)));
+    UC_CHECK(f.statistics().filtered() == 0);
+
+    //the statistics stay until they are reset
+    UC_CHECK(f.statistics().issued() == 8);
+    f.reset_statistics();
+    UC_CHECK(f.statistics().issued() == 0);
+}
+
+UC_TEST(state_filter_resets_root_arguments_with_the_root_signature)
+{
+    state_filter f;
+
+    int root0 = 0;
+    int root1 = 0;
+
+    UC_CHECK(f.set_root_signature(bind_point::graphics, &root0));
+    UC_CHECK(f.set_constant_buffer(bind_point::graphics, 1, 0x10000));
+    UC_CHECK(!f.set_constant_buffer(bind_point::graphics, 1, 0x10000));
+
+    //the same root signature keeps the arguments
+    UC_CHECK(!f.set_root_signature(bind_point::graphics, &root0));
+    UC_CHECK(!f.set_constant_buffer(bind_point::graphics, 1, 0x10000));
+
+    //a new one drops them
+    UC_CHECK(f.set_root_signature(bind_point::graphics, &root1));
+    UC_CHECK(f.set_constant_buffer(bind_point::graphics, 1, 0x10000));
+
+    //the bind points have their own root signatures and arguments
+    UC_CHECK(f.set_root_signature(bind_point::compute, &root1));
+    UC_CHECK(f.set_constant_buffer(bind_point::compute, 1, 0x10000));
+    UC_CHECK(!f.set_constant_buffer(bind_point::graphics, 1, 0x10000));
+
+    UC_CHECK(filtered(f, state_call::root_signature) == 1);
+    UC_CHECK(filtered(f, state_call::constant_buffer) == 3);
+}
+
+UC_TEST(state_filter_compares_the_bytes_of_uploaded_constants)
+{
+    state_filter f;
+
+    constants c = {};
+
+    UC_CHECK(f.set_constants(bind_point::graphics, 0, &c, sizeof(c)));
+    UC_CHECK(!f.set_constants(bind_point::graphics, 0, &c, sizeof(c)));
+
+    //other bytes, other size
+    c.m_values[3] = 1.0f;
+    UC_CHECK(f.set_constants(bind_point::graphics, 0, &c, sizeof(c)));
+    UC_CHECK(f.set_constants(bind_point::graphics, 0, &c, sizeof(float)));
+
+    //a constant buffer at an address replaces the uploaded constants, and the other way round
+    UC_CHECK(f.set_constant_buffer(bind_point::graphics, 0, 0x20000));
+    UC_CHECK(f.set_constants(bind_point::graphics, 0, &c, sizeof(float)));
+
+    //the address 0 is never dropped, nor a root index past the root signature limit
+    UC_CHECK(f.set_constant_buffer(bind_point::graphics, 2, 0));
+    UC_CHECK(f.set_constant_buffer(bind_point::graphics, 2, 0));
+    UC_CHECK(f.set_constants(bind_point::graphics, state_filter::max_root_parameters, &c, sizeof(c)));
+    UC_CHECK(f.set_constants(bind_point::graphics, state_filter::max_root_parameters, &c, sizeof(c)));
+
+    UC_CHECK(filtered(f, state_call::constant_buffer) == 1);
+    UC_CHECK(issued(f, state_call::constant_buffer) == 9);
+}
+
+UC_TEST(state_filter_drops_vertex_buffers_only_if_all_slots_match)
+{
+    state_filter f;
+
+    const vertex_buffer_view a[] = { { 0x1000, 256, 16 }, { 0x2000, 256, 8 } };
+    const vertex_buffer_view b[] = { { 0x1000, 256, 16 }, { 0x3000, 256, 8 } };
+
+    UC_CHECK(f.set_vertex_buffers(0, 2, a));
+    UC_CHECK(!f.set_vertex_buffers(0, 2, a));
+    UC_CHECK(!f.set_vertex_buffers(1, 1, &a[1]));
+
+    //one slot of the range differs
+    UC_CHECK(f.set_vertex_buffers(0, 2, b));
+
+    //a slot never set
+    UC_CHECK(f.set_vertex_buffers(2, 1, a));
+
+    //past the input assembler slots
+    UC_CHECK(f.set_vertex_buffers(state_filter::max_vertex_buffers - 1, 2, a));
+    UC_CHECK(f.set_vertex_buffers(state_filter::max_vertex_buffers - 1, 2, a));
+
+    UC_CHECK(filtered(f, state_call::vertex_buffers) == 2);
+}
+
+UC_TEST(state_filter_checks_the_descriptor_heaps)
+{
+    state_filter f;
+
+    int cbv_srv_uav = 0;
+    int sampler     = 0;
+    int* both[]     = { &cbv_srv_uav, &sampler };
+    int* three[]    = { &cbv_srv_uav, &sampler, &sampler };
+
+    UC_CHECK(f.set_descriptor_heaps(both, 2));
+    UC_CHECK(!f.set_descriptor_heaps(both, 2));
+
+    //fewer heaps is another binding
+    UC_CHECK(f.set_descriptor_heaps(both, 1));
+    UC_CHECK(!f.set_descriptor_heaps(both, 1));
+
+    //more heaps than the filter keeps, it forgets what is bound
+    UC_CHECK(f.set_descriptor_heaps(three, 3));
+    UC_CHECK(f.set_descriptor_heaps(both, 1));
+
+    state_filter_statistics total;
+    total += f.statistics();
+    total += f.statistics();
+
+    UC_CHECK(filtered(f, state_call::descriptor_heaps) == 2);
+    UC_CHECK(total.issued() == 8 && total.filtered() == 4);
+}
+
+UC_TEST(state_filter_sets_a_root_argument_again_after_an_indirect_draw)
+{
+    state_filter f;
+
+    const uint32_t draw_id      = 7;
+    const uint32_t other_slot   = 1;
+    constants c = {};
+
+    UC_CHECK(f.set_constants(bind_point::graphics, draw_id, &c, sizeof(c)));
+    UC_CHECK(f.set_constants(bind_point::graphics, other_slot, &c, sizeof(c)));
+    UC_CHECK(!f.set_constants(bind_point::graphics, draw_id, &c, sizeof(c)));
+
+    //the command signature of the indirect draw writes the root argument
+    f.invalidate_root_argument(bind_point::graphics, draw_id);
+
+    UC_CHECK(f.set_constants(bind_point::graphics, draw_id, &c, sizeof(c)));
+    UC_CHECK(!f.set_constants(bind_point::graphics, draw_id, &c, sizeof(c)));
+
+    //the other root arguments and bind points are kept, a root index past the limit is ignored
+    f.invalidate_root_argument(bind_point::compute, other_slot);
+    f.invalidate_root_argument(bind_point::graphics, state_filter::max_root_parameters);
+    UC_CHECK(!f.set_constants(bind_point::graphics, other_slot, &c, sizeof(c)));
+
+    UC_CHECK(issued(f, state_call::constant_buffer) == 3);
+    UC_CHECK(filtered(f, state_call::constant_buffer) == 3);
+}
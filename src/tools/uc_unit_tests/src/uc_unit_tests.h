@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//minimal test registry, every test file registers its tests with UC_TEST and checks with UC_CHECK
+//usage: uc_unit_tests [name filter]
+
+namespace uc
+{
+    namespace tests
+    {
+        struct test
+        {
+            const char* m_name;
+            void      (*m_run)();
+        };
+
+        std::vector<test>& registry();
+
+        //records a failed check against the running test
+        void failed(const char* file, uint32_t line, const char* expression);
+
+        struct registrar
+        {
+            registrar(const char* name, void (*run)())
+            {
+                registry().push_back({ name, run });
+            }
+        };
+    }
+}
+
+#define UC_TEST(name) \
+    static void uc_test_##name(); \
+    static uc::tests::registrar uc_test_registrar_##name(#name, &uc_test_##name); \
+    static void uc_test_##name()
+
+#define UC_CHECK(e) \
+    do { if (!(e)) { uc::tests::failed(__FILE__, __LINE__, #e); } } while (false)
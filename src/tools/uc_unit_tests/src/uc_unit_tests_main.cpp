@@ -0,0 +1,70 @@
+#include "pch.h"
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+#include "uc_unit_tests.h"
+
+namespace uc
+{
+    namespace tests
+    {
+        namespace
+        {
+            uint32_t g_failures = 0;
+        }
+
+        std::vector<test>& registry()
+        {
+            static std::vector<test> r;
+            return r;
+        }
+
+        void failed(const char* file, uint32_t line, const char* expression)
+        {
+            std::cerr << file << "(" << line << "): check failed: " << expression << std::endl;
+            ++g_failures;
+        }
+    }
+}
+
+int32_t main(int32_t argc, const char* argv[])
+{
+    using namespace uc::tests;
+
+    const char* filter  = argc > 1 ? argv[1] : nullptr;
+    uint32_t    run     = 0;
+    uint32_t    failed  = 0;
+
+    for (auto&& t : registry())
+    {
+        if (filter && std::strstr(t.m_name, filter) == nullptr)
+        {
+            continue;
+        }
+
+        auto before = g_failures;
+
+        try
+        {
+            t.m_run();
+        }
+
+        catch (const std::exception& e)
+        {
+            std::cerr << t.m_name << ": " << e.what() << std::endl;
+            ++g_failures;
+        }
+
+        auto ok = before == g_failures;
+        std::cout << (ok ? "passed " : "FAILED ") << t.m_name << std::endl;
+
+        ++run;
+        failed += ok ? 0 : 1;
+    }
+
+    std::cout << "tests:" << run << " failed:" << failed << std::endl;
+    return failed == 0 ? 0 : -1;
+}
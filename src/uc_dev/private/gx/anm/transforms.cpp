@@ -190,6 +190,62 @@ namespace uc {
 
                 return v;
             }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            math::aabb skeleton_bounds(const lip::skeleton* s, const std::vector<math::float4x4>& joints)
+            {
+                math::float4 bounds_min = math::splat(std::numeric_limits<float>::max());
+                math::float4 bounds_max = math::splat(-std::numeric_limits<float>::max());
+
+                auto&& volumes  = s->m_joint_bounding_volumes;
+                bool   empty    = true;
+
+                if (volumes.size() == joints.size())
+                {
+                    for (auto i = 0U; i < joints.size(); ++i)
+                    {
+                        auto&& v = volumes[i];
+
+                        //joint does not influence any vertices
+                        if (v.m_radius < 0.0f)
+                        {
+                            continue;
+                        }
+
+                        //the skinning palette moves bind pose points into the pose
+                        math::float4x4 bind_pose    = math::load44(&s->m_joint_inverse_bind_pose2[i].m_a0);
+                        math::float4x4 palette      = math::mul(bind_pose, joints[i]);
+
+                        math::float4   center       = math::transform3(math::point3(v.m_center.m_x, v.m_center.m_y, v.m_center.m_z), palette);
+
+                        //account for scale in the joints
+                        math::float4   scale        = math::max(math::max(math::length3(palette.r[0]), math::length3(palette.r[1])), math::length3(palette.r[2]));
+                        math::float4   radius       = math::mul(scale, math::splat(v.m_radius));
+
+                        bounds_min = math::min(bounds_min, math::sub(center, radius));
+                        bounds_max = math::max(bounds_max, math::add(center, radius));
+                        empty      = false;
+                    }
+                }
+
+                //old skeletons without volumes or no joint with skinned vertices, fall back to the joint positions
+                if (empty)
+                {
+                    for (auto&& j : joints)
+                    {
+                        bounds_min = math::min(bounds_min, j.r[3]);
+                        bounds_max = math::max(bounds_max, j.r[3]);
+                        empty      = false;
+                    }
+                }
+
+                //no joints at all, a point at the origin instead of an inverted box
+                if (empty)
+                {
+                    return math::make_aabb(math::point3(0.0f, 0.0f, 0.0f), math::point3(0.0f, 0.0f, 0.0f));
+                }
+
+                return math::make_aabb(bounds_min, bounds_max);
+            }
         }
     }
 }
\ No newline at end of file
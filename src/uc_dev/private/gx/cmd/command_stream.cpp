@@ -0,0 +1,94 @@
+#include "pch.h"
+
+#include <uc_dev/gx/cmd/command_stream.h>
+
+#include <algorithm>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            command_stream::command_stream(size_t block_size) : m_block_size(std::max<size_t>(block_size, 256))
+            {
+
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void command_stream::reset()
+            {
+                for (auto&& b : m_blocks)
+                {
+                    b.m_size = 0;
+                }
+
+                m_block         = 0;
+                m_command_count = 0;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            size_t command_stream::size() const
+            {
+                size_t r = 0;
+
+                for (auto&& b : m_blocks)
+                {
+                    r += b.m_size;
+                }
+
+                return r;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            size_t command_stream::capacity() const
+            {
+                size_t r = 0;
+
+                for (auto&& b : m_blocks)
+                {
+                    r += b.m_capacity;
+                }
+
+                return r;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void* command_stream::allocate(size_t size)
+            {
+                //commands do not straddle blocks, move to the next block that fits
+                while (m_block < m_blocks.size())
+                {
+                    auto&& b = m_blocks[m_block];
+
+                    if (b.m_size + size <= b.m_capacity)
+                    {
+                        auto r = b.m_data + b.m_size;
+                        b.m_size += size;
+                        return r;
+                    }
+
+                    if (m_block + 1 == m_blocks.size())
+                    {
+                        break;
+                    }
+
+                    //the next block was used in a previous frame, it has no commands after reset
+                    m_block++;
+                }
+
+                block b;
+
+                b.m_capacity = std::max(m_block_size, size);
+                b.m_storage  = std::make_unique<uint64_t[]>((b.m_capacity + 7) / 8);
+                b.m_data     = reinterpret_cast<uint8_t*>(b.m_storage.get());
+                b.m_size     = size;
+
+                m_blocks.push_back(std::move(b));
+                m_block = static_cast<uint32_t>(m_blocks.size() - 1);
+
+                return m_blocks.back().m_data;
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
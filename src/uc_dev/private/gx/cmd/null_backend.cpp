@@ -0,0 +1,466 @@
+#include "pch.h"
+
+#include <uc_dev/gx/cmd/null_backend.h>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::count(command_type t)
+            {
+                m_statistics.m_commands[static_cast<uint32_t>(t)]++;
+                m_command++;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::error(const char* message)
+            {
+                const uint32_t max_errors = 64;
+
+                if (m_errors.size() < max_errors)
+                {
+                    m_errors.push_back("command " + std::to_string(m_command - 1) + ": " + message);
+                }
+
+                m_error_count++;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::check_root_index(uint32_t root_index)
+            {
+                //the root signatures are at most 64 dwords
+                if (root_index >= 64)
+                {
+                    error("root index out of range");
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::pipeline_change(const void* pso)
+            {
+                if (pso == nullptr)
+                {
+                    error("null pipeline state");
+                }
+
+                if (pso != m_last_pso)
+                {
+                    m_statistics.m_pipeline_changes++;
+                    m_last_pso = pso;
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_graphics_pipeline_state_command& c)
+            {
+                count(c.m_type);
+                pipeline_change(c.m_pipeline_state);
+                m_state_filter.set_pipeline_state(c.m_pipeline_state);
+                m_graphics_pso = c.m_pipeline_state;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_compute_pipeline_state_command& c)
+            {
+                count(c.m_type);
+                pipeline_change(c.m_pipeline_state);
+                m_state_filter.set_pipeline_state(c.m_pipeline_state);
+                m_compute_pso = c.m_pipeline_state;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_descriptor_heaps_command& c)
+            {
+                count(c.m_type);
+
+                //the streams set only the heaps of the frame
+                const void* heaps[] = { this };
+                m_state_filter.set_descriptor_heaps(heaps, 1);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_render_targets_command& c)
+            {
+                count(c.m_type);
+
+                if (c.m_color.m_resource == nullptr && c.m_depth.m_resource == nullptr)
+                {
+                    error("no render targets");
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const clear_render_target_command& c)
+            {
+                count(c.m_type);
+                flush_barriers();
+
+                if (c.m_target.m_resource == nullptr)
+                {
+                    error("clear of a null render target");
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const clear_depth_stencil_command& c)
+            {
+                count(c.m_type);
+                flush_barriers();
+
+                if (c.m_target.m_resource == nullptr)
+                {
+                    error("clear of a null depth buffer");
+                }
+
+                if ((c.m_flags & (clear_depth | clear_stencil)) == 0)
+                {
+                    error("clear without flags");
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_view_port_command& c)
+            {
+                count(c.m_type);
+
+                if (c.m_view_port.m_width <= 0.0f || c.m_view_port.m_height <= 0.0f)
+                {
+                    error("empty view port");
+                }
+
+                m_view_port = true;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_scissor_rectangle_command& c)
+            {
+                count(c.m_type);
+
+                if (c.m_rectangle.m_right < c.m_rectangle.m_left || c.m_rectangle.m_bottom < c.m_rectangle.m_top)
+                {
+                    error("inverted scissor rectangle");
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_primitive_topology_command& c)
+            {
+                count(c.m_type);
+                m_state_filter.set_primitive_topology(c.m_topology);
+                m_topology = c.m_topology;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_vertex_buffer_command& c)
+            {
+                count(c.m_type);
+
+                //D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT
+                if (c.m_slot >= 32)
+                {
+                    error("vertex buffer slot out of range");
+                }
+
+                m_state_filter.set_vertex_buffers(c.m_slot, 1, &c.m_view);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_index_buffer_command& c)
+            {
+                count(c.m_type);
+
+                //a null view resets the index buffer
+                if (c.m_view.m_address != 0 && c.m_view.m_format != index_format_r16_uint && c.m_view.m_format != index_format_r32_uint)
+                {
+                    error("invalid index format");
+                }
+
+                m_state_filter.set_index_buffer(c.m_view);
+                m_index_buffer = c.m_view.m_address != 0;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_graphics_constant_buffer_command& c)
+            {
+                count(c.m_type);
+                check_root_index(c.m_root_index);
+
+                if (m_state_filter.set_constants(bind_point::graphics, c.m_root_index, payload(&c), c.m_byte_count))
+                {
+                    m_statistics.m_constant_bytes += c.m_byte_count;
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_compute_constant_buffer_command& c)
+            {
+                count(c.m_type);
+                check_root_index(c.m_root_index);
+
+                if (m_state_filter.set_constants(bind_point::compute, c.m_root_index, payload(&c), c.m_byte_count))
+                {
+                    m_statistics.m_constant_bytes += c.m_byte_count;
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_graphics_dynamic_constant_buffer_command& c)
+            {
+                count(c.m_type);
+                check_root_index(c.m_root_index);
+                m_statistics.m_constant_bytes += c.m_byte_count;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_compute_dynamic_constant_buffer_command& c)
+            {
+                count(c.m_type);
+                check_root_index(c.m_root_index);
+                m_statistics.m_constant_bytes += c.m_byte_count;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_graphics_dynamic_descriptor_command& c)
+            {
+                count(c.m_type);
+                check_root_index(c.m_root_index);
+
+                if (c.m_descriptor == 0)
+                {
+                    error("null descriptor");
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_compute_dynamic_descriptor_command& c)
+            {
+                count(c.m_type);
+                check_root_index(c.m_root_index);
+
+                if (c.m_descriptor == 0)
+                {
+                    error("null descriptor");
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_graphics_root_constant_command& c)
+            {
+                count(c.m_type);
+                check_root_index(c.m_root_index);
+
+                if (m_state_filter.set_constants(bind_point::graphics, c.m_root_index, &c.m_value, sizeof(c.m_value)))
+                {
+                    m_statistics.m_constant_bytes += sizeof(c.m_value);
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_graphics_bindless_table_command& c)
+            {
+                count(c.m_type);
+                check_root_index(c.m_root_index);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const set_graphics_dynamic_srv_buffer_command& c)
+            {
+                count(c.m_type);
+                check_root_index(c.m_root_index);
+
+                if (c.m_byte_count == 0)
+                {
+                    error("empty shader resource buffer");
+                }
+
+                m_statistics.m_constant_bytes += c.m_byte_count;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const track_resource_command& c)
+            {
+                count(c.m_type);
+
+                if (c.m_resource == nullptr)
+                {
+                    error("track of a null resource");
+                    return;
+                }
+
+                m_resource_states.track(c.m_resource, c.m_state, c.m_subresource_count);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const transition_resource_command& c)
+            {
+                count(c.m_type);
+                m_statistics.m_transitions++;
+
+                if (c.m_resource == nullptr)
+                {
+                    error("transition of a null resource");
+                    return;
+                }
+
+                bool known = true;
+
+                switch (c.m_flags)
+                {
+                    case barrier_flags_begin_only:  known = m_resource_states.begin_transition(c.m_resource, c.m_after); break;
+                    case barrier_flags_end_only:    m_resource_states.end_transition(c.m_resource); break;
+                    default:                        known = m_resource_states.transition(c.m_resource, c.m_after, c.m_subresource, c.m_before); break;
+                }
+
+                if (!known)
+                {
+                    error("transition of a resource without a known state");
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const aliasing_barrier_command& c)
+            {
+                count(c.m_type);
+
+                if (c.m_after == nullptr)
+                {
+                    error("aliasing barrier without a resource");
+                    return;
+                }
+
+                //the transitions before it go first
+                flush_barriers();
+                m_statistics.m_aliasing_barriers++;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::flush_barriers()
+            {
+                m_resource_states.flush([this](const barrier*, uint32_t count)
+                {
+                    m_statistics.m_barriers += count;
+                    m_statistics.m_barrier_batches++;
+                });
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const draw_instanced_command& c)
+            {
+                count(c.m_type);
+
+                if (m_graphics_pso == nullptr)   error("draw without a pipeline state");
+                if (m_topology == primitive_topology_undefined) error("draw without a primitive topology");
+                if (!m_view_port)                error("draw without a view port");
+
+                flush_barriers();
+                m_statistics.m_draws++;
+                m_statistics.m_vertices += static_cast<uint64_t>(c.m_vertex_count_per_instance) * c.m_instance_count;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const draw_indexed_instanced_command& c)
+            {
+                count(c.m_type);
+
+                if (m_graphics_pso == nullptr)   error("draw without a pipeline state");
+                if (m_topology == primitive_topology_undefined) error("draw without a primitive topology");
+                if (!m_view_port)                error("draw without a view port");
+                if (!m_index_buffer)             error("indexed draw without an index buffer");
+
+                flush_barriers();
+                m_statistics.m_draws++;
+                m_statistics.m_vertices += static_cast<uint64_t>(c.m_index_count_per_instance) * c.m_instance_count;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const draw_indexed_indirect_command& c)
+            {
+                count(c.m_type);
+                check_root_index(c.m_root_index);
+
+                if (c.m_signature == nullptr)    error("indirect draw without a command signature");
+                if (m_graphics_pso == nullptr)   error("draw without a pipeline state");
+                if (m_topology == primitive_topology_undefined) error("draw without a primitive topology");
+                if (!m_view_port)                error("draw without a view port");
+                if (!m_index_buffer)             error("indexed draw without an index buffer");
+
+                if (c.m_count == 0)
+                {
+                    return;
+                }
+
+                flush_barriers();
+
+                auto draws = arguments(&c);
+
+                for (auto i = 0U; i < c.m_count; ++i)
+                {
+                    m_statistics.m_draws++;
+                    m_statistics.m_vertices += static_cast<uint64_t>(draws[i].m_draw.m_index_count_per_instance) * draws[i].m_draw.m_instance_count;
+                }
+
+                //the signature wrote the draw ids, as the contexts do
+                m_state_filter.invalidate_root_argument(bind_point::graphics, c.m_root_index);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const dispatch_command& c)
+            {
+                count(c.m_type);
+
+                if (m_compute_pso == nullptr)
+                {
+                    error("dispatch without a pipeline state");
+                }
+
+                flush_barriers();
+                m_statistics.m_dispatches++;
+                m_statistics.m_thread_groups += static_cast<uint64_t>(c.m_thread_group_count_x) * c.m_thread_group_count_y * c.m_thread_group_count_z;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const begin_event_command& c)
+            {
+                count(c.m_type);
+                m_event_depth++;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::on(const end_event_command& c)
+            {
+                count(c.m_type);
+
+                if (m_event_depth == 0)
+                {
+                    error("end event without a begin event");
+                    return;
+                }
+
+                m_event_depth--;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::finish()
+            {
+                //as the command list is closed
+                m_resource_states.end_transitions();
+                flush_barriers();
+
+                if (m_event_depth != 0)
+                {
+                    m_command++;
+                    error("unbalanced events at the end of the stream");
+                    m_command--;
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void null_backend::reset()
+            {
+                *this = null_backend();
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
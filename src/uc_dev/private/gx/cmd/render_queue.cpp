@@ -0,0 +1,106 @@
+#include "pch.h"
+
+#include <uc_dev/gx/cmd/render_queue.h>
+
+#include <array>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+            namespace
+            {
+                const uint32_t digit_bits   = 8;
+                const uint32_t digit_count  = 64 / digit_bits;
+                const uint32_t radix        = 1U << digit_bits;
+
+                inline uint32_t digit(uint64_t key, uint32_t pass)
+                {
+                    return static_cast<uint32_t>(key >> (pass * digit_bits)) & (radix - 1);
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void radix_sort(std::vector<render_item>& items, std::vector<render_item>& scratch)
+            {
+                auto size = items.size();
+
+                if (size < 2)
+                {
+                    return;
+                }
+
+                //the histograms of all digits in one read of the keys
+                std::array< std::array<uint32_t, radix>, digit_count > histograms = {};
+
+                for (auto&& i : items)
+                {
+                    for (auto d = 0U; d < digit_count; ++d)
+                    {
+                        histograms[d][digit(i.m_key, d)]++;
+                    }
+                }
+
+                scratch.resize(size);
+
+                auto source         = items.data();
+                auto destination    = scratch.data();
+
+                for (auto d = 0U; d < digit_count; ++d)
+                {
+                    auto&& h = histograms[d];
+
+                    //all keys have the same digit, the pass would not move anything
+                    if (h[digit(source[0].m_key, d)] == size)
+                    {
+                        continue;
+                    }
+
+                    std::array<uint32_t, radix> offsets;
+                    uint32_t sum = 0;
+
+                    for (auto b = 0U; b < radix; ++b)
+                    {
+                        offsets[b]  = sum;
+                        sum         += h[b];
+                    }
+
+                    for (auto i = 0U; i < size; ++i)
+                    {
+                        auto&& item = source[i];
+                        destination[offsets[digit(item.m_key, d)]++] = item;
+                    }
+
+                    std::swap(source, destination);
+                }
+
+                //an odd number of passes leaves the result in the scratch buffer
+                if (source != items.data())
+                {
+                    items.swap(scratch);
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void render_queue::sort()
+            {
+                size_t size = 0;
+
+                for (auto&& b : m_buckets)
+                {
+                    size += b.m_items.size();
+                }
+
+                m_items.clear();
+                m_items.reserve(size);
+
+                for (auto&& b : m_buckets)
+                {
+                    m_items.insert(m_items.end(), b.m_items.begin(), b.m_items.end());
+                }
+
+                radix_sort(m_items, m_scratch);
+            }
+        }
+    }
+}
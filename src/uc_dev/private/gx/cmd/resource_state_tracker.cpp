@@ -0,0 +1,306 @@
+#include "pch.h"
+
+#include <uc_dev/gx/cmd/resource_state_tracker.h>
+
+#include <algorithm>
+
+namespace uc {
+    namespace gx {
+        namespace cmd {
+
+            namespace
+            {
+                //the read states can be combined, a resource in depth_read | non_pixel_shader_resource can be read as either
+                inline bool is_read_state(uint32_t state, uint32_t wider)
+                {
+                    return wider != resource_state_common && state != resource_state_common && (wider & resource_state_read_only) == wider && (state & ~wider) == 0;
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void resource_state_tracker::track(const void* resource, uint32_t state, uint32_t subresource_count)
+            {
+                auto&& r = m_resources[resource];
+
+                r.m_state               = state;
+                r.m_subresource_count   = std::max(subresource_count, 1U);
+                r.m_split_before        = resource_state_unknown;
+                r.m_split_after         = resource_state_unknown;
+                r.m_subresources.clear();
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            bool resource_state_tracker::transition(const void* resource, uint32_t after, uint32_t subresource, uint32_t expected_before)
+            {
+                m_statistics.m_transitions++;
+
+                auto it = m_resources.find(resource);
+
+                if (it == m_resources.end())
+                {
+                    if (expected_before == resource_state_unknown)
+                    {
+                        //no barrier can be built, take the state, so the next transitions are right
+                        m_statistics.m_unknown++;
+                        track(resource, after);
+                        return false;
+                    }
+
+                    track(resource, expected_before);
+                    it = m_resources.find(resource);
+                }
+
+                auto&& r = it->second;
+
+                if (r.m_split_after != resource_state_unknown)
+                {
+                    end_transition(resource, r);
+                }
+
+                if (subresource == all_subresources || r.m_subresource_count == 1)
+                {
+                    if (r.m_subresources.empty())
+                    {
+                        add_barrier(resource, all_subresources, r.m_state, after);
+                    }
+                    else
+                    {
+                        for (auto i = 0U; i < r.m_subresource_count; ++i)
+                        {
+                            add_barrier(resource, i, r.m_subresources[i], after);
+                        }
+
+                        r.m_subresources.clear();
+                        r.m_state = after;
+                        collapse_barriers(resource, r.m_subresource_count);
+                    }
+
+                    return true;
+                }
+
+                if (subresource >= r.m_subresource_count)
+                {
+                    m_statistics.m_unknown++;
+                    return false;
+                }
+
+                if (r.m_subresources.empty())
+                {
+                    r.m_subresources.assign(r.m_subresource_count, r.m_state);
+                }
+
+                add_barrier(resource, subresource, r.m_subresources[subresource], after);
+
+                //back to one state for the whole resource
+                auto&& s = r.m_subresources;
+                if (std::all_of(s.begin(), s.end(), [&s](uint32_t v) { return v == s.front(); }))
+                {
+                    r.m_state = s.front();
+                    s.clear();
+                    collapse_barriers(resource, r.m_subresource_count);
+                }
+
+                return true;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void resource_state_tracker::add_barrier(const void* resource, uint32_t subresource, uint32_t& state, uint32_t after)
+            {
+                if (state == after || is_read_state(after, state))
+                {
+                    m_statistics.m_eliminated++;
+                    return;
+                }
+
+                //nothing used the resource since the pending barrier, so it can go straight to the new state
+                for (auto i = m_pending.size(); i-- > 0; )
+                {
+                    auto&& p = m_pending[i];
+
+                    if (p.m_resource == resource && p.m_subresource == subresource)
+                    {
+                        if (p.m_flags == barrier_flags_none)
+                        {
+                            m_statistics.m_merged++;
+                            state = after;
+
+                            if (p.m_before == after)
+                            {
+                                m_pending.erase(m_pending.begin() + i);
+                            }
+                            else
+                            {
+                                p.m_after = after;
+                            }
+
+                            return;
+                        }
+
+                        break;
+                    }
+                }
+
+                m_pending.push_back({ resource, subresource, state, after, barrier_flags_none });
+                state = after;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void resource_state_tracker::collapse_barriers(const void* resource, uint32_t subresource_count)
+            {
+                //one pending barrier for every subresource, all from the same state to the same state
+                auto of_resource = [resource](const barrier& b) { return b.m_resource == resource; };
+                auto first = std::find_if(m_pending.begin(), m_pending.end(), of_resource);
+
+                if (first == m_pending.end())
+                {
+                    return;
+                }
+
+                uint32_t count = 0;
+
+                for (auto it = first; it != m_pending.end(); ++it)
+                {
+                    if (it->m_resource != resource)
+                    {
+                        continue;
+                    }
+
+                    if (it->m_subresource == all_subresources || it->m_flags != barrier_flags_none || it->m_before != first->m_before || it->m_after != first->m_after)
+                    {
+                        return;
+                    }
+
+                    count++;
+                }
+
+                if (count < 2 || count != subresource_count)
+                {
+                    return;
+                }
+
+                first->m_subresource = all_subresources;
+                m_pending.erase(std::remove_if(first + 1, m_pending.end(), of_resource), m_pending.end());
+
+                m_statistics.m_collapsed += count - 1;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            bool resource_state_tracker::begin_transition(const void* resource, uint32_t after)
+            {
+                auto it = m_resources.find(resource);
+
+                if (it == m_resources.end())
+                {
+                    m_statistics.m_transitions++;
+                    m_statistics.m_unknown++;
+                    return false;
+                }
+
+                auto&& r = it->second;
+
+                //the subresources differ, no split
+                if (!r.m_subresources.empty())
+                {
+                    return transition(resource, after);
+                }
+
+                m_statistics.m_transitions++;
+
+                if (r.m_split_after != resource_state_unknown)
+                {
+                    end_transition(resource, r);
+                }
+
+                if (r.m_state == after || is_read_state(after, r.m_state))
+                {
+                    m_statistics.m_eliminated++;
+                    return true;
+                }
+
+                m_pending.push_back({ resource, all_subresources, r.m_state, after, barrier_flags_begin_only });
+
+                r.m_split_before    = r.m_state;
+                r.m_split_after     = after;
+                r.m_state           = after;
+                return true;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void resource_state_tracker::end_transition(const void* resource)
+            {
+                auto it = m_resources.find(resource);
+
+                if (it != m_resources.end() && it->second.m_split_after != resource_state_unknown)
+                {
+                    end_transition(resource, it->second);
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void resource_state_tracker::end_transition(const void* resource, tracked_resource& r)
+            {
+                bool pending = false;
+
+                //the begin was not flushed yet, nothing to overlap with, make it a full barrier
+                for (auto&& p : m_pending)
+                {
+                    if (p.m_resource == resource && p.m_flags == barrier_flags_begin_only)
+                    {
+                        p.m_flags = barrier_flags_none;
+                        pending   = true;
+                        break;
+                    }
+                }
+
+                if (!pending)
+                {
+                    m_pending.push_back({ resource, all_subresources, r.m_split_before, r.m_split_after, barrier_flags_end_only });
+                }
+
+                r.m_split_before = resource_state_unknown;
+                r.m_split_after  = resource_state_unknown;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void resource_state_tracker::end_transitions()
+            {
+                for (auto&& r : m_resources)
+                {
+                    if (r.second.m_split_after != resource_state_unknown)
+                    {
+                        end_transition(r.first, r.second);
+                    }
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            uint32_t resource_state_tracker::state(const void* resource, uint32_t subresource) const
+            {
+                auto it = m_resources.find(resource);
+
+                if (it == m_resources.end())
+                {
+                    return resource_state_unknown;
+                }
+
+                auto&& r = it->second;
+
+                if (r.m_subresources.empty())
+                {
+                    return r.m_state;
+                }
+
+                return subresource < r.m_subresources.size() ? r.m_subresources[subresource] : resource_state_unknown;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void resource_state_tracker::reset()
+            {
+                m_resources.clear();
+                m_pending.clear();
+                m_statistics = resource_state_statistics();
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
@@ -0,0 +1,792 @@
+#include "pch.h"
+
+#include <uc_dev/gx/cull/bvh.h>
+#include <uc_dev/gx/lip/model.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace uc {
+    namespace gx {
+        namespace cull {
+
+            namespace
+            {
+                struct box
+                {
+                    float m_min[3];
+                    float m_max[3];
+                };
+
+                inline box make_empty_box()
+                {
+                    const float v = std::numeric_limits<float>::max();
+                    return { { v, v, v }, { -v, -v, -v } };
+                }
+
+                inline box make_box(const math::aabb& b)
+                {
+                    alignas(16) float bounds_min[4];
+                    alignas(16) float bounds_max[4];
+
+                    math::store4(&bounds_min[0], math::bounds_min(b));
+                    math::store4(&bounds_max[0], math::bounds_max(b));
+
+                    return { { bounds_min[0], bounds_min[1], bounds_min[2] }, { bounds_max[0], bounds_max[1], bounds_max[2] } };
+                }
+
+                inline void grow(box& b, const box& o)
+                {
+                    for (auto i = 0U; i < 3; ++i)
+                    {
+                        b.m_min[i] = std::min(b.m_min[i], o.m_min[i]);
+                        b.m_max[i] = std::max(b.m_max[i], o.m_max[i]);
+                    }
+                }
+
+                inline void grow(box& b, const float* p)
+                {
+                    for (auto i = 0U; i < 3; ++i)
+                    {
+                        b.m_min[i] = std::min(b.m_min[i], p[i]);
+                        b.m_max[i] = std::max(b.m_max[i], p[i]);
+                    }
+                }
+
+                inline float half_area(const box& b)
+                {
+                    const float x = std::max(0.0f, b.m_max[0] - b.m_min[0]);
+                    const float y = std::max(0.0f, b.m_max[1] - b.m_min[1]);
+                    const float z = std::max(0.0f, b.m_max[2] - b.m_min[2]);
+                    return x * y + y * z + z * x;
+                }
+
+                //m_x12 = xmin1, xmax1, xmin2, xmax2, m_x34 = xmin3, xmax3, xmin4, xmax4
+                inline float* lane(math::float4& v12, math::float4& v34, uint32_t l)
+                {
+                    return reinterpret_cast<float*>(l < 2 ? &v12 : &v34) + (l & 1) * 2;
+                }
+
+                inline const float* lane(const math::float4& v12, const math::float4& v34, uint32_t l)
+                {
+                    return reinterpret_cast<const float*>(l < 2 ? &v12 : &v34) + (l & 1) * 2;
+                }
+
+                inline void set_lane(math::aabb4& b, uint32_t l, const box& v)
+                {
+                    float* x = lane(b.m_x12, b.m_x34, l);
+                    float* y = lane(b.m_y12, b.m_y34, l);
+                    float* z = lane(b.m_z12, b.m_z34, l);
+
+                    x[0] = v.m_min[0]; x[1] = v.m_max[0];
+                    y[0] = v.m_min[1]; y[1] = v.m_max[1];
+                    z[0] = v.m_min[2]; z[1] = v.m_max[2];
+                }
+
+                inline box get_lane(const math::aabb4& b, uint32_t l)
+                {
+                    const float* x = lane(b.m_x12, b.m_x34, l);
+                    const float* y = lane(b.m_y12, b.m_y34, l);
+                    const float* z = lane(b.m_z12, b.m_z34, l);
+
+                    return { { x[0], y[0], z[0] }, { x[1], y[1], z[1] } };
+                }
+
+                inline box node_bounds(const bvh::node& n)
+                {
+                    box r = make_empty_box();
+
+                    for (auto i = 0U; i < 4; ++i)
+                    {
+                        grow(r, get_lane(n.m_bounds, i));
+                    }
+
+                    return r;
+                }
+
+                //min and max of the 4 children per axis
+                inline math::float4 UC_MATH_CALL lanes_min(math::afloat4 v12, math::afloat4 v34)
+                {
+                    return math::shuffle<math::x, math::z, math::x, math::z>(v12, v34);
+                }
+
+                inline math::float4 UC_MATH_CALL lanes_max(math::afloat4 v12, math::afloat4 v34)
+                {
+                    return math::shuffle<math::y, math::w, math::y, math::w>(v12, v34);
+                }
+
+                //entry and exit distances of the ray through the slabs of the 4 children along one axis. a ray parallel to the axis
+                //gives 0 * inf = nan for an origin on a slab plane, it is inside the slab along the whole ray or misses it
+                inline void UC_MATH_CALL slab(math::afloat4 lo, math::afloat4 hi, math::afloat4 o, math::afloat4 inv_d, bool parallel, math::float4& enter, math::float4& exit)
+                {
+                    if (parallel)
+                    {
+                        const math::float4 inside   = _mm_and_ps(_mm_cmple_ps(lo, o), _mm_cmple_ps(o, hi));
+                        const math::float4 infinity = math::splat(std::numeric_limits<float>::infinity());
+
+                        enter = math::select(infinity, math::negate(infinity), inside);
+                        exit  = math::select(math::negate(infinity), infinity, inside);
+                    }
+                    else
+                    {
+                        const math::float4 t0 = math::mul(math::sub(lo, o), inv_d);
+                        const math::float4 t1 = math::mul(math::sub(hi, o), inv_d);
+
+                        enter = math::min(t0, t1);
+                        exit  = math::max(t0, t1);
+                    }
+                }
+
+                //binary sah tree, collapsed to the 4 wide one afterwards
+                struct build_node
+                {
+                    box         m_bounds;
+                    uint32_t    m_left;
+                    uint32_t    m_right;
+                    uint32_t    m_item;     //for leaves
+                };
+
+                struct builder
+                {
+                    static const uint32_t bin_count = 16;
+
+                    std::vector< box >          m_boxes;
+                    std::vector< float >        m_centroids;
+                    std::vector< uint32_t >     m_items;
+                    std::vector< build_node >   m_nodes;
+
+                    uint32_t make_node()
+                    {
+                        m_nodes.push_back({ make_empty_box(), bvh::invalid, bvh::invalid, bvh::invalid });
+                        return static_cast<uint32_t>(m_nodes.size() - 1);
+                    }
+
+                    const float* centroid(uint32_t item) const
+                    {
+                        return &m_centroids[item * 3];
+                    }
+
+                    //splits the items of node n, returns the split point or first + count for a leaf
+                    uint32_t split(uint32_t n, uint32_t first, uint32_t count)
+                    {
+                        box b   = make_empty_box();
+                        box cb  = make_empty_box();
+
+                        for (auto i = first; i < first + count; ++i)
+                        {
+                            grow(b, m_boxes[m_items[i]]);
+                            grow(cb, centroid(m_items[i]));
+                        }
+
+                        m_nodes[n].m_bounds = b;
+
+                        if (count == 1)
+                        {
+                            m_nodes[n].m_item = m_items[first];
+                            return first + count;
+                        }
+
+                        uint32_t axis = 0;
+                        for (auto i = 1U; i < 3; ++i)
+                        {
+                            if (cb.m_max[i] - cb.m_min[i] > cb.m_max[axis] - cb.m_min[axis])
+                            {
+                                axis = i;
+                            }
+                        }
+
+                        const float extent  = cb.m_max[axis] - cb.m_min[axis];
+                        uint32_t    middle  = first + count / 2;
+
+                        if (extent > 0.0f)
+                        {
+                            const float scale = bin_count / extent;
+
+                            auto bin_of = [this, axis, scale, &cb](uint32_t item)
+                            {
+                                const uint32_t bin = static_cast<uint32_t>((centroid(item)[axis] - cb.m_min[axis]) * scale);
+                                return std::min(bin, bin_count - 1);
+                            };
+
+                            std::array<box, bin_count>      bins;
+                            std::array<uint32_t, bin_count> counts = {};
+
+                            bins.fill(make_empty_box());
+
+                            for (auto i = first; i < first + count; ++i)
+                            {
+                                const uint32_t bin = bin_of(m_items[i]);
+                                grow(bins[bin], m_boxes[m_items[i]]);
+                                counts[bin]++;
+                            }
+
+                            //sweep from the right, then from the left and evaluate the split after every bin
+                            std::array<float, bin_count> right_cost;
+                            box         right       = make_empty_box();
+                            uint32_t    right_count = 0;
+
+                            for (auto i = bin_count - 1; i > 0; --i)
+                            {
+                                grow(right, bins[i]);
+                                right_count += counts[i];
+                                right_cost[i - 1] = half_area(right) * right_count;
+                            }
+
+                            box         left        = make_empty_box();
+                            uint32_t    left_count  = 0;
+                            uint32_t    best        = bin_count;
+                            float       best_cost   = std::numeric_limits<float>::max();
+
+                            for (auto i = 0U; i < bin_count - 1; ++i)
+                            {
+                                grow(left, bins[i]);
+                                left_count += counts[i];
+
+                                const float cost = half_area(left) * left_count + right_cost[i];
+
+                                if (left_count > 0 && left_count < count && cost < best_cost)
+                                {
+                                    best_cost = cost;
+                                    best = i;
+                                }
+                            }
+
+                            if (best != bin_count)
+                            {
+                                auto it = std::partition(m_items.begin() + first, m_items.begin() + first + count, [best, &bin_of](uint32_t item)
+                                {
+                                    return bin_of(item) <= best;
+                                });
+
+                                middle = static_cast<uint32_t>(it - m_items.begin());
+                            }
+                        }
+
+                        //all centroids in one spot, split by count
+                        if (middle == first || middle == first + count)
+                        {
+                            middle = first + count / 2;
+                        }
+
+                        return middle;
+                    }
+
+                    //iterative, unbalanced splits (items spread out exponentially) make the tree as deep as the item count
+                    uint32_t build(uint32_t count)
+                    {
+                        struct task
+                        {
+                            uint32_t m_node;
+                            uint32_t m_first;
+                            uint32_t m_count;
+                        };
+
+                        std::vector<task> tasks;
+
+                        const uint32_t root = make_node();
+                        tasks.push_back({ root, 0, count });
+
+                        while (!tasks.empty())
+                        {
+                            const task t = tasks.back();
+                            tasks.pop_back();
+
+                            const uint32_t middle = split(t.m_node, t.m_first, t.m_count);
+
+                            if (middle == t.m_first + t.m_count)
+                            {
+                                continue;
+                            }
+
+                            const uint32_t l = make_node();
+                            const uint32_t r = make_node();
+
+                            m_nodes[t.m_node].m_left    = l;
+                            m_nodes[t.m_node].m_right   = r;
+
+                            tasks.push_back({ r, middle, t.m_first + t.m_count - middle });
+                            tasks.push_back({ l, t.m_first, middle - t.m_first });
+                        }
+
+                        return root;
+                    }
+
+                    bool is_leaf(uint32_t n) const
+                    {
+                        return m_nodes[n].m_left == bvh::invalid;
+                    }
+
+                    //pulls up grandchildren until there are 4 children, the largest ones are opened first
+                    //iterative and depth first, children after the parent. returns the depth of the 4 wide tree
+                    uint32_t collapse(uint32_t root, std::vector<bvh::node>& nodes) const
+                    {
+                        struct task
+                        {
+                            uint32_t m_node;        //binary node
+                            uint32_t m_parent;      //4 wide node and slot to patch, invalid for the root
+                            uint32_t m_slot;
+                            uint32_t m_depth;
+                        };
+
+                        std::vector<task> tasks;
+                        uint32_t depth = 0;
+
+                        tasks.push_back({ root, bvh::invalid, 0, 1 });
+
+                        while (!tasks.empty())
+                        {
+                            const task t = tasks.back();
+                            tasks.pop_back();
+
+                            uint32_t children[4] = { m_nodes[t.m_node].m_left, m_nodes[t.m_node].m_right, bvh::invalid, bvh::invalid };
+                            uint32_t size = 2;
+
+                            while (size < 4)
+                            {
+                                uint32_t open       = bvh::invalid;
+                                float    open_area  = -1.0f;
+
+                                for (auto i = 0U; i < size; ++i)
+                                {
+                                    if (!is_leaf(children[i]) && half_area(m_nodes[children[i]].m_bounds) > open_area)
+                                    {
+                                        open        = i;
+                                        open_area   = half_area(m_nodes[children[i]].m_bounds);
+                                    }
+                                }
+
+                                if (open == bvh::invalid)
+                                {
+                                    break;
+                                }
+
+                                const build_node& o = m_nodes[children[open]];
+                                children[open]      = o.m_left;
+                                children[size++]    = o.m_right;
+                            }
+
+                            const uint32_t r = static_cast<uint32_t>(nodes.size());
+                            nodes.push_back(bvh::node());
+
+                            if (t.m_parent != bvh::invalid)
+                            {
+                                nodes[t.m_parent].m_child[t.m_slot] = r;
+                            }
+
+                            depth = std::max(depth, t.m_depth);
+
+                            for (auto i = 0U; i < 4; ++i)
+                            {
+                                if (i < size)
+                                {
+                                    const build_node& c = m_nodes[children[i]];
+                                    set_lane(nodes[r].m_bounds, i, c.m_bounds);
+                                    nodes[r].m_child[i] = is_leaf(children[i]) ? bvh::leaf | c.m_item : bvh::invalid;
+                                }
+                                else
+                                {
+                                    set_lane(nodes[r].m_bounds, i, make_empty_box());
+                                    nodes[r].m_child[i] = bvh::invalid;
+                                }
+                            }
+
+                            //reversed, so the first child is collapsed next
+                            for (auto i = size; i > 0; --i)
+                            {
+                                if (!is_leaf(children[i - 1]))
+                                {
+                                    tasks.push_back({ children[i - 1], r, i - 1, t.m_depth + 1 });
+                                }
+                            }
+                        }
+
+                        return depth;
+                    }
+                };
+
+                //adds every item below a node which is fully inside, uses the free part of the traversal stack
+                void add_items(const bvh::node* nodes, uint32_t n, std::vector<uint32_t>& items, uint32_t* stack)
+                {
+                    uint32_t top = 0;
+
+                    stack[top++] = n;
+
+                    while (top > 0)
+                    {
+                        const bvh::node& o = nodes[stack[--top]];
+
+                        for (auto i = 0U; i < 4; ++i)
+                        {
+                            const uint32_t c = o.m_child[i];
+
+                            if (c == bvh::invalid)
+                            {
+                                continue;
+                            }
+
+                            if (c & bvh::leaf)
+                            {
+                                items.push_back(c & ~bvh::leaf);
+                            }
+                            else
+                            {
+                                stack[top++] = c;
+                            }
+                        }
+                    }
+                }
+
+                //a depth first walk keeps at most 3 siblings per level on the stack
+                inline uint32_t stack_size(uint32_t depth)
+                {
+                    return 3 * depth + 1;
+                }
+
+                //traversal stack on the program stack for the usual trees, on the heap for deep ones
+                class traversal_stack
+                {
+                    public:
+
+                    explicit traversal_stack(uint32_t depth)
+                    {
+                        const uint32_t size = stack_size(depth);
+
+                        if (size > local_size)
+                        {
+                            m_heap.resize(size);
+                            m_data = m_heap.data();
+                        }
+                    }
+
+                    uint32_t* data()
+                    {
+                        return m_data;
+                    }
+
+                    private:
+
+                    static const uint32_t   local_size = 256;
+
+                    uint32_t                m_local[local_size];
+                    std::vector<uint32_t>   m_heap;
+                    uint32_t*               m_data = &m_local[0];
+                };
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void bvh::build(const math::aabb* bounds, uint32_t count)
+            {
+                m_nodes.clear();
+                m_size  = count;
+                m_depth = 0;
+
+                if (count == 0)
+                {
+                    return;
+                }
+
+                builder b;
+
+                b.m_boxes.resize(count);
+                b.m_centroids.resize(count * 3);
+                b.m_items.resize(count);
+                b.m_nodes.reserve(count * 2);
+
+                for (auto i = 0U; i < count; ++i)
+                {
+                    const box v = make_box(bounds[i]);
+
+                    b.m_boxes[i] = v;
+                    b.m_items[i] = i;
+
+                    for (auto j = 0U; j < 3; ++j)
+                    {
+                        b.m_centroids[i * 3 + j] = (v.m_min[j] + v.m_max[j]) * 0.5f;
+                    }
+                }
+
+                const uint32_t root = b.build(count);
+
+                m_nodes.reserve(count / 2 + 1);
+
+                if (b.is_leaf(root))
+                {
+                    node n;
+
+                    set_lane(n.m_bounds, 0, b.m_nodes[root].m_bounds);
+                    n.m_child[0] = leaf | b.m_nodes[root].m_item;
+
+                    for (auto i = 1U; i < 4; ++i)
+                    {
+                        set_lane(n.m_bounds, i, make_empty_box());
+                        n.m_child[i] = invalid;
+                    }
+
+                    m_nodes.push_back(n);
+                    m_depth = 1;
+                }
+                else
+                {
+                    m_depth = b.collapse(root, m_nodes);
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void bvh::refit(const math::aabb* bounds)
+            {
+                //children have larger indices than their parents, so walk backwards
+                for (auto n = m_nodes.rbegin(); n != m_nodes.rend(); ++n)
+                {
+                    for (auto i = 0U; i < 4; ++i)
+                    {
+                        const uint32_t c = n->m_child[i];
+
+                        if (c == invalid)
+                        {
+                            continue;
+                        }
+
+                        set_lane(n->m_bounds, i, (c & leaf) ? make_box(bounds[c & ~leaf]) : node_bounds(m_nodes[c]));
+                    }
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void bvh::query(const math::frustum_planes& f, std::vector<uint32_t>& items) const
+            {
+                if (m_nodes.empty())
+                {
+                    return;
+                }
+
+                const uint32_t plane_count = math::frustum_planes::plane_count::value;
+
+                //broadcast the planes once, normals point inside
+                math::float4 nx[plane_count];
+                math::float4 ny[plane_count];
+                math::float4 nz[plane_count];
+                math::float4 nw[plane_count];
+
+                for (auto i = 0U; i < plane_count; ++i)
+                {
+                    nx[i] = math::splat_x(f.m_planes[i].m_value);
+                    ny[i] = math::splat_y(f.m_planes[i].m_value);
+                    nz[i] = math::splat_z(f.m_planes[i].m_value);
+                    nw[i] = math::splat_w(f.m_planes[i].m_value);
+                }
+
+                const math::float4 zero = math::zero();
+
+                traversal_stack s(m_depth);
+                uint32_t*       stack = s.data();
+                uint32_t        top   = 0;
+
+                stack[top++] = 0;
+
+                while (top > 0)
+                {
+                    const node& n = m_nodes[stack[--top]];
+
+                    const math::float4 min_x = lanes_min(n.m_bounds.m_x12, n.m_bounds.m_x34);
+                    const math::float4 min_y = lanes_min(n.m_bounds.m_y12, n.m_bounds.m_y34);
+                    const math::float4 min_z = lanes_min(n.m_bounds.m_z12, n.m_bounds.m_z34);
+                    const math::float4 max_x = lanes_max(n.m_bounds.m_x12, n.m_bounds.m_x34);
+                    const math::float4 max_y = lanes_max(n.m_bounds.m_y12, n.m_bounds.m_y34);
+                    const math::float4 max_z = lanes_max(n.m_bounds.m_z12, n.m_bounds.m_z34);
+
+                    math::float4 outside    = zero;
+                    math::float4 intersect  = zero;
+
+                    for (auto i = 0U; i < plane_count; ++i)
+                    {
+                        const math::float4 x0 = math::mul(nx[i], min_x);
+                        const math::float4 x1 = math::mul(nx[i], max_x);
+                        const math::float4 y0 = math::mul(ny[i], min_y);
+                        const math::float4 y1 = math::mul(ny[i], max_y);
+                        const math::float4 z0 = math::mul(nz[i], min_z);
+                        const math::float4 z1 = math::mul(nz[i], max_z);
+
+                        //p vertex is the furthest along the normal, n vertex the closest
+                        const math::float4 p = math::add(math::add(math::max(x0, x1), math::max(y0, y1)), math::add(math::max(z0, z1), nw[i]));
+                        const math::float4 q = math::add(math::add(math::min(x0, x1), math::min(y0, y1)), math::add(math::min(z0, z1), nw[i]));
+
+                        outside     = _mm_or_ps(outside, _mm_cmplt_ps(p, zero));
+                        intersect   = _mm_or_ps(intersect, _mm_cmplt_ps(q, zero));
+                    }
+
+                    const uint32_t visible  = ~_mm_movemask_ps(outside) & 0xF;
+                    const uint32_t inside   = visible & ~_mm_movemask_ps(intersect);
+
+                    for (auto i = 0U; i < 4; ++i)
+                    {
+                        const uint32_t c = n.m_child[i];
+
+                        if (c == invalid || (visible & (1 << i)) == 0)
+                        {
+                            continue;
+                        }
+
+                        if (c & leaf)
+                        {
+                            items.push_back(c & ~leaf);
+                        }
+                        else if (inside & (1 << i))
+                        {
+                            add_items(m_nodes.data(), c, items, stack + top);
+                        }
+                        else
+                        {
+                            assert(top < stack_size(m_depth));
+                            stack[top++] = c;
+                        }
+                    }
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void bvh::query(math::afloat4 origin, math::afloat4 direction, float t_max, std::vector<uint32_t>& items) const
+            {
+                if (m_nodes.empty())
+                {
+                    return;
+                }
+
+                const math::float4 inv_direction = math::div(math::one(), direction);
+
+                const math::float4 ox = math::splat_x(origin);
+                const math::float4 oy = math::splat_y(origin);
+                const math::float4 oz = math::splat_z(origin);
+
+                const math::float4 dx = math::splat_x(inv_direction);
+                const math::float4 dy = math::splat_y(inv_direction);
+                const math::float4 dz = math::splat_z(inv_direction);
+
+                const uint32_t     parallel = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpeq_ps(direction, math::zero())));
+
+                const math::float4 t0 = math::zero();
+                const math::float4 t1 = math::splat(t_max);
+
+                traversal_stack s(m_depth);
+                uint32_t*       stack = s.data();
+                uint32_t        top   = 0;
+
+                stack[top++] = 0;
+
+                while (top > 0)
+                {
+                    const node& n = m_nodes[stack[--top]];
+
+                    //slabs
+                    math::float4 x0, x1, y0, y1, z0, z1;
+                    slab(lanes_min(n.m_bounds.m_x12, n.m_bounds.m_x34), lanes_max(n.m_bounds.m_x12, n.m_bounds.m_x34), ox, dx, (parallel & 1) != 0, x0, x1);
+                    slab(lanes_min(n.m_bounds.m_y12, n.m_bounds.m_y34), lanes_max(n.m_bounds.m_y12, n.m_bounds.m_y34), oy, dy, (parallel & 2) != 0, y0, y1);
+                    slab(lanes_min(n.m_bounds.m_z12, n.m_bounds.m_z34), lanes_max(n.m_bounds.m_z12, n.m_bounds.m_z34), oz, dz, (parallel & 4) != 0, z0, z1);
+
+                    const math::float4 enter = math::max(math::max(x0, y0), math::max(z0, t0));
+                    const math::float4 exit  = math::min(math::min(x1, y1), math::min(z1, t1));
+
+                    const uint32_t hit = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(enter, exit)));
+
+                    for (auto i = 0U; i < 4; ++i)
+                    {
+                        const uint32_t c = n.m_child[i];
+
+                        if (c == invalid || (hit & (1 << i)) == 0)
+                        {
+                            continue;
+                        }
+
+                        if (c & leaf)
+                        {
+                            items.push_back(c & ~leaf);
+                        }
+                        else
+                        {
+                            assert(top < stack_size(m_depth));
+                            stack[top++] = c;
+                        }
+                    }
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void bvh::query(math::afloat4 center, float radius, std::vector<uint32_t>& items) const
+            {
+                if (m_nodes.empty())
+                {
+                    return;
+                }
+
+                const math::float4 cx = math::splat_x(center);
+                const math::float4 cy = math::splat_y(center);
+                const math::float4 cz = math::splat_z(center);
+                const math::float4 r2 = math::splat(radius * radius);
+
+                const math::float4 zero = math::zero();
+
+                traversal_stack s(m_depth);
+                uint32_t*       stack = s.data();
+                uint32_t        top   = 0;
+
+                stack[top++] = 0;
+
+                while (top > 0)
+                {
+                    const node& n = m_nodes[stack[--top]];
+
+                    //distance from the center to the closest point of the box
+                    const math::float4 x = math::add(math::max(math::sub(lanes_min(n.m_bounds.m_x12, n.m_bounds.m_x34), cx), zero), math::max(math::sub(cx, lanes_max(n.m_bounds.m_x12, n.m_bounds.m_x34)), zero));
+                    const math::float4 y = math::add(math::max(math::sub(lanes_min(n.m_bounds.m_y12, n.m_bounds.m_y34), cy), zero), math::max(math::sub(cy, lanes_max(n.m_bounds.m_y12, n.m_bounds.m_y34)), zero));
+                    const math::float4 z = math::add(math::max(math::sub(lanes_min(n.m_bounds.m_z12, n.m_bounds.m_z34), cz), zero), math::max(math::sub(cz, lanes_max(n.m_bounds.m_z12, n.m_bounds.m_z34)), zero));
+
+                    const math::float4 d = math::mad(x, x, math::mad(y, y, math::mul(z, z)));
+
+                    const uint32_t hit = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(d, r2)));
+
+                    for (auto i = 0U; i < 4; ++i)
+                    {
+                        const uint32_t c = n.m_child[i];
+
+                        if (c == invalid || (hit & (1 << i)) == 0)
+                        {
+                            continue;
+                        }
+
+                        if (c & leaf)
+                        {
+                            items.push_back(c & ~leaf);
+                        }
+                        else
+                        {
+                            assert(top < stack_size(m_depth));
+                            stack[top++] = c;
+                        }
+                    }
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            std::vector< math::aabb > primitive_range_bounds(const lip::model* m, const lip::primitive_range* ranges, uint32_t range_count)
+            {
+                std::vector< math::aabb > r;
+                r.reserve(range_count);
+
+                const lip::indices& indices  = m->m_indices;
+                const lip::point3* positions = m->m_positions.m_data.data();
+
+                for (auto i = 0U; i < range_count; ++i)
+                {
+                    box b = make_empty_box();
+
+                    for (auto j = ranges[i].m_begin; j < ranges[i].m_end; ++j)
+                    {
+                        const lip::point3& p = positions[indices[j]];
+                        const float v[3] = { p.m_x, p.m_y, p.m_z };
+                        grow(b, v);
+                    }
+
+                    r.push_back(math::make_aabb(math::point3(b.m_min[0], b.m_min[1], b.m_min[2]), math::point3(b.m_max[0], b.m_max[1], b.m_max[2])));
+                }
+
+                return r;
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
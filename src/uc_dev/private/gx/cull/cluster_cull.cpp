@@ -0,0 +1,155 @@
+#include "pch.h"
+
+#include <uc_dev/gx/cull/cluster_cull.h>
+#include <uc_dev/gx/lip/model.h>
+
+namespace uc {
+    namespace gx {
+        namespace cull {
+
+            namespace
+            {
+                //4 meshlet bounds in soa form
+                struct cluster_bounds4
+                {
+                    __m128 m_x;
+                    __m128 m_y;
+                    __m128 m_z;
+                    __m128 m_radius;
+                    __m128 m_axis_x;
+                    __m128 m_axis_y;
+                    __m128 m_axis_z;
+                    __m128 m_cutoff;
+                };
+
+                static_assert(sizeof(lip::meshlet_bounds) == 8 * sizeof(float), "meshlet bounds are loaded as two float4");
+
+                inline cluster_bounds4 load_bounds4(const lip::meshlet_bounds* b)
+                {
+                    const float* p = reinterpret_cast<const float*>(b);
+
+                    cluster_bounds4 r;
+
+                    r.m_x       = _mm_loadu_ps(p + 0);
+                    r.m_y       = _mm_loadu_ps(p + 8);
+                    r.m_z       = _mm_loadu_ps(p + 16);
+                    r.m_radius  = _mm_loadu_ps(p + 24);
+                    _MM_TRANSPOSE4_PS(r.m_x, r.m_y, r.m_z, r.m_radius);
+
+                    r.m_axis_x  = _mm_loadu_ps(p + 4);
+                    r.m_axis_y  = _mm_loadu_ps(p + 12);
+                    r.m_axis_z  = _mm_loadu_ps(p + 20);
+                    r.m_cutoff  = _mm_loadu_ps(p + 28);
+                    _MM_TRANSPOSE4_PS(r.m_axis_x, r.m_axis_y, r.m_axis_z, r.m_cutoff);
+
+                    return r;
+                }
+
+                //mask of the visible lanes
+                inline uint32_t cull4(const __m128* planes, const __m128* eye, const cluster_bounds4& b)
+                {
+                    const __m128 negative_radius = _mm_sub_ps(_mm_setzero_ps(), b.m_radius);
+
+                    __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+                    //outside, when the sphere is fully behind a plane
+                    for (auto i = 0U; i < math::frustum_planes::plane_count::value; ++i)
+                    {
+                        const __m128* p = &planes[i * 4];
+                        __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p[0], b.m_x), _mm_mul_ps(p[1], b.m_y)), _mm_add_ps(_mm_mul_ps(p[2], b.m_z), p[3]));
+                        visible = _mm_and_ps(visible, _mm_cmpge_ps(d, negative_radius));
+                    }
+
+                    //backfacing, when the view direction to the sphere is inside the normal cone widened by the sphere
+                    const __m128 dx     = _mm_sub_ps(b.m_x, eye[0]);
+                    const __m128 dy     = _mm_sub_ps(b.m_y, eye[1]);
+                    const __m128 dz     = _mm_sub_ps(b.m_z, eye[2]);
+
+                    const __m128 d      = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, b.m_axis_x), _mm_mul_ps(dy, b.m_axis_y)), _mm_mul_ps(dz, b.m_axis_z));
+                    const __m128 l      = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+                    const __m128 c      = _mm_add_ps(_mm_mul_ps(b.m_cutoff, l), b.m_radius);
+
+                    visible = _mm_andnot_ps(_mm_cmpge_ps(d, c), visible);
+
+                    return static_cast<uint32_t>(_mm_movemask_ps(visible));
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            uint32_t cluster_cull(const math::frustum_planes& f, math::afloat4 eye, const lip::meshlet_bounds* b, uint32_t count, uint32_t first_cluster, uint32_t* visible)
+            {
+                //splat the planes and the eye once
+                alignas(16) __m128 planes[math::frustum_planes::plane_count::value * 4];
+                alignas(16) float  e[4];
+                alignas(16) __m128 eye4[3];
+
+                for (auto i = 0U; i < math::frustum_planes::plane_count::value; ++i)
+                {
+                    alignas(16) float p[4];
+                    math::store4(&p[0], f.m_planes[i].m_value);
+
+                    for (auto k = 0U; k < 4; ++k)
+                    {
+                        planes[i * 4 + k] = _mm_set1_ps(p[k]);
+                    }
+                }
+
+                math::store4(&e[0], eye);
+                for (auto k = 0U; k < 3; ++k)
+                {
+                    eye4[k] = _mm_set1_ps(e[k]);
+                }
+
+                uint32_t n      = 0;
+                uint32_t i      = 0;
+
+                for (; i + 4 <= count; i += 4)
+                {
+                    const uint32_t mask     = cull4(&planes[0], &eye4[0], load_bounds4(b + i));
+                    const uint32_t cluster  = first_cluster + i;
+
+                    //branchless compaction, write every lane, advance only on the visible ones
+                    visible[n] = cluster + 0; n += mask & 1;
+                    visible[n] = cluster + 1; n += (mask >> 1) & 1;
+                    visible[n] = cluster + 2; n += (mask >> 2) & 1;
+                    visible[n] = cluster + 3; n += (mask >> 3) & 1;
+                }
+
+                //pad the tail with copies of the last cluster, the copies are not reported
+                if (i < count)
+                {
+                    lip::meshlet_bounds tail[4];
+
+                    for (auto k = 0U; k < 4; ++k)
+                    {
+                        tail[k] = b[std::min(i + k, count - 1)];
+                    }
+
+                    const uint32_t mask = cull4(&planes[0], &eye4[0], load_bounds4(&tail[0]));
+
+                    for (auto k = 0U; i + k < count; ++k)
+                    {
+                        visible[n] = first_cluster + i + k;
+                        n += (mask >> k) & 1;
+                    }
+                }
+
+                return n;
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void cluster_cull(const math::frustum_planes& f, math::afloat4 eye, const lip::meshlets& m, uint32_t range, std::vector<uint32_t>& visible)
+            {
+                const auto& r       = m.m_ranges[range];
+                const uint32_t size = r.m_end - r.m_begin;
+
+                visible.resize(size);
+
+                if (size > 0)
+                {
+                    visible.resize(cluster_cull(f, eye, &m.m_bounds[r.m_begin], size, r.m_begin, visible.data()));
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#include "pch.h"
+
+#include <uc_dev/gx/cull/frustum_cull.h>
+#include <uc_dev/gx/cull/object_bounds.h>
+#include <uc_dev/sys/cpu_features.h>
+
+#include <algorithm>
+
+namespace uc {
+    namespace gx {
+        namespace cull {
+
+            namespace details
+            {
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+                uint32_t frustum_cull_sse(const math::frustum_planes* f, const math::aabb4* b, uint32_t block_count, uint32_t first_object, uint32_t* visible)
+                {
+                    const uint32_t chunk = 64;
+                    alignas(16) __m128i results[chunk];
+
+                    const __m128i outside   = _mm_set1_epi32(2);
+                    const __m128i zero      = _mm_setzero_si128();
+
+                    uint32_t n = 0;
+
+                    for (auto i = 0U; i < block_count; i += chunk)
+                    {
+                        const uint32_t size = std::min(chunk, block_count - i);
+
+                        math::frustum_cull_inward(f, b + i, size, &results[0]);
+
+                        for (auto j = 0U; j < size; ++j)
+                        {
+                            const __m128i  v        = _mm_cmpeq_epi32(_mm_and_si128(results[j], outside), zero);
+                            const uint32_t mask     = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(v)));
+                            const uint32_t object   = first_object + (i + j) * 4;
+
+                            //branchless compaction, write every lane, advance only on the visible ones
+                            visible[n] = object + 0; n += mask & 1;
+                            visible[n] = object + 1; n += (mask >> 1) & 1;
+                            visible[n] = object + 2; n += (mask >> 2) & 1;
+                            visible[n] = object + 3; n += (mask >> 3) & 1;
+                        }
+                    }
+
+                    return n;
+                }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void frustum_cull(const math::frustum_planes* f, uint32_t view_count, const object_bounds& b, std::vector<uint32_t>* visible)
+            {
+                auto kernel = sys::is_avx2_supported() ? details::frustum_cull_avx2 : details::frustum_cull_sse;
+
+                const uint32_t block_count  = b.block_count();
+                const uint32_t padded       = block_count * 4 + 8;
+
+                for (auto v = 0U; v < view_count; ++v)
+                {
+                    visible[v].resize(padded);
+                }
+
+                std::vector<uint32_t> counts(view_count, 0);
+
+                //walk the bounds once, so all views hit the same blocks while they are in the cache
+                const uint32_t chunk = 256;
+                for (auto i = 0U; i < block_count; i += chunk)
+                {
+                    const uint32_t size = std::min(chunk, block_count - i);
+
+                    for (auto v = 0U; v < view_count; ++v)
+                    {
+                        counts[v] += kernel(&f[v], b.blocks() + i, size, i * 4, visible[v].data() + counts[v]);
+                    }
+                }
+
+                //drop the padding lanes of the last block
+                for (auto v = 0U; v < view_count; ++v)
+                {
+                    auto n = counts[v];
+
+                    while (n > 0 && visible[v][n - 1] >= b.size())
+                    {
+                        --n;
+                    }
+
+                    visible[v].resize(n);
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void frustum_cull(const math::frustum_planes& f, const object_bounds& b, std::vector<uint32_t>& visible)
+            {
+                frustum_cull(&f, 1, b, &visible);
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#include "pch.h"
+
+#include <uc_dev/gx/cull/frustum_cull.h>
+
+namespace uc {
+    namespace gx {
+        namespace cull {
+            namespace details
+            {
+                namespace
+                {
+                    //xmin1, xmax1, xmin2, xmax2 | xmin3, xmax3, xmin4, xmax4 -> min and max of the 4 boxes
+                    inline __m128 UC_MATH_CALL block_min(math::afloat4 a12, math::afloat4 a34)
+                    {
+                        return math::shuffle<math::x, math::z, math::x, math::z>(a12, a34);
+                    }
+
+                    inline __m128 UC_MATH_CALL block_max(math::afloat4 a12, math::afloat4 a34)
+                    {
+                        return math::shuffle<math::y, math::w, math::y, math::w>(a12, a34);
+                    }
+
+                    struct aabb8
+                    {
+                        __m256 m_min_x;
+                        __m256 m_min_y;
+                        __m256 m_min_z;
+                        __m256 m_max_x;
+                        __m256 m_max_y;
+                        __m256 m_max_z;
+                    };
+
+                    inline aabb8 load_aabb8(const math::aabb4* __restrict b0, const math::aabb4* __restrict b1)
+                    {
+                        aabb8 r;
+
+                        r.m_min_x = _mm256_set_m128(block_min(b1->m_x12, b1->m_x34), block_min(b0->m_x12, b0->m_x34));
+                        r.m_min_y = _mm256_set_m128(block_min(b1->m_y12, b1->m_y34), block_min(b0->m_y12, b0->m_y34));
+                        r.m_min_z = _mm256_set_m128(block_min(b1->m_z12, b1->m_z34), block_min(b0->m_z12, b0->m_z34));
+
+                        r.m_max_x = _mm256_set_m128(block_max(b1->m_x12, b1->m_x34), block_max(b0->m_x12, b0->m_x34));
+                        r.m_max_y = _mm256_set_m128(block_max(b1->m_y12, b1->m_y34), block_max(b0->m_y12, b0->m_y34));
+                        r.m_max_z = _mm256_set_m128(block_max(b1->m_z12, b1->m_z34), block_max(b0->m_z12, b0->m_z34));
+
+                        return r;
+                    }
+                }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+                //8 boxes per iteration, two aabb4 blocks
+                uint32_t frustum_cull_avx2(const math::frustum_planes* f, const math::aabb4* b, uint32_t block_count, uint32_t first_object, uint32_t* visible)
+                {
+                    alignas(16) float planes[math::frustum_planes::plane_count::value][4];
+
+                    for (auto i = 0U; i < math::frustum_planes::plane_count::value; ++i)
+                    {
+                        math::store4(&planes[i][0], f->m_planes[i].m_value);
+                    }
+
+                    const __m256 zero = _mm256_setzero_ps();
+
+                    uint32_t n = 0;
+                    uint32_t i = 0;
+
+                    for (; i + 1 < block_count; i += 2)
+                    {
+                        const aabb8 box = load_aabb8(&b[i], &b[i + 1]);
+
+                        __m256 outside = zero;
+
+                        for (auto j = 0U; j < math::frustum_planes::plane_count::value; ++j)
+                        {
+                            const __m256 nx = _mm256_broadcast_ss(&planes[j][0]);
+                            const __m256 ny = _mm256_broadcast_ss(&planes[j][1]);
+                            const __m256 nz = _mm256_broadcast_ss(&planes[j][2]);
+                            const __m256 d  = _mm256_broadcast_ss(&planes[j][3]);
+
+                            //distance of the vertex furthest along the plane normal (p vertex)
+                            const __m256 px = _mm256_max_ps(_mm256_mul_ps(nx, box.m_min_x), _mm256_mul_ps(nx, box.m_max_x));
+                            const __m256 py = _mm256_max_ps(_mm256_mul_ps(ny, box.m_min_y), _mm256_mul_ps(ny, box.m_max_y));
+                            const __m256 pz = _mm256_max_ps(_mm256_mul_ps(nz, box.m_min_z), _mm256_mul_ps(nz, box.m_max_z));
+
+                            const __m256 p  = _mm256_add_ps(_mm256_add_ps(px, py), _mm256_add_ps(pz, d));
+
+                            outside = _mm256_or_ps(outside, _mm256_cmp_ps(p, zero, _CMP_LT_OQ));
+
+                            if (_mm256_movemask_ps(outside) == 0xFF)
+                            {
+                                break;
+                            }
+                        }
+
+                        const uint32_t mask     = ~static_cast<uint32_t>(_mm256_movemask_ps(outside));
+                        const uint32_t object   = first_object + i * 4;
+
+                        //branchless compaction, write every lane, advance only on the visible ones
+                        for (auto k = 0U; k < 8; ++k)
+                        {
+                            visible[n] = object + k;
+                            n += (mask >> k) & 1;
+                        }
+                    }
+
+                    //odd block count
+                    if (i < block_count)
+                    {
+                        n += frustum_cull_sse(f, &b[i], 1, first_object + i * 4, visible + n);
+                    }
+
+                    return n;
+                }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            }
+        }
+    }
+}
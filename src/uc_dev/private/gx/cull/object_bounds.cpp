@@ -0,0 +1,59 @@
+#include "pch.h"
+
+#include <uc_dev/gx/cull/object_bounds.h>
+
+namespace uc {
+    namespace gx {
+        namespace cull {
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            uint32_t object_bounds::add(const math::aabb& b)
+            {
+                const uint32_t object = m_size++;
+
+                if (object / 4 == m_blocks.size())
+                {
+                    m_blocks.push_back({ math::zero(), math::zero(), math::zero(), math::zero(), math::zero(), math::zero() });
+                }
+
+                set(object, b);
+                return object;
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void object_bounds::set(uint32_t object, const math::aabb& b)
+            {
+                assert(object < m_size);
+
+                alignas(16) float bounds_min[4];
+                alignas(16) float bounds_max[4];
+
+                math::store4(&bounds_min[0], math::bounds_min(b));
+                math::store4(&bounds_max[0], math::bounds_max(b));
+
+                //m_x12 = xmin1, xmax1, xmin2, xmax2, m_x34 = xmin3, xmax3, xmin4, xmax4
+                math::aabb4& block = m_blocks[object / 4];
+                const uint32_t lane = object % 4;
+                const uint32_t pair = (lane & 1) * 2;
+
+                float* x = reinterpret_cast<float*>(lane < 2 ? &block.m_x12 : &block.m_x34) + pair;
+                float* y = reinterpret_cast<float*>(lane < 2 ? &block.m_y12 : &block.m_y34) + pair;
+                float* z = reinterpret_cast<float*>(lane < 2 ? &block.m_z12 : &block.m_z34) + pair;
+
+                x[0] = bounds_min[0];
+                x[1] = bounds_max[0];
+
+                y[0] = bounds_min[1];
+                y[1] = bounds_max[1];
+
+                z[0] = bounds_min[2];
+                z[1] = bounds_max[2];
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void object_bounds::clear()
+            {
+                m_blocks.clear();
+                m_size = 0;
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#include "pch.h"
+
+#include <uc_dev/gx/drs/dynamic_resolution.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace uc {
+    namespace gx {
+        namespace drs {
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            dynamic_resolution_controller::dynamic_resolution_controller(const dynamic_resolution_settings& s) : m_settings(s)
+            {
+                reset(s.m_max_scale);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void dynamic_resolution_controller::set_settings(const dynamic_resolution_settings& s)
+            {
+                m_settings = s;
+                reset(m_scale);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void dynamic_resolution_controller::reset(float scale)
+            {
+                m_scale             = std::min(std::max(scale, m_settings.m_min_scale), m_settings.m_max_scale);
+                m_output            = quantize(m_scale);
+                m_integral          = 0.0f;
+                m_previous_error    = 0.0f;
+                m_settle            = m_settings.m_settle_frames;
+                m_measured          = false;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            float dynamic_resolution_controller::quantize(float scale) const
+            {
+                auto step = m_settings.m_scale_step;
+                auto r    = step > 0.0f ? std::round(scale / step) * step : scale;
+                return std::min(std::max(r, m_settings.m_min_scale), m_settings.m_max_scale);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            float dynamic_resolution_controller::update(const frame_timing& t)
+            {
+                auto&& s = m_settings;
+
+                //without the gpu time, for example before the first timestamps are resolved, the cpu time is the frame time
+                auto ms = t.m_gpu_ms > 0.0f ? t.m_gpu_ms : t.m_cpu_ms;
+
+                if (ms <= 0.0f)
+                {
+                    return m_output;
+                }
+
+                m_filtered_ms   = m_measured ? m_filtered_ms + s.m_smoothing * (ms - m_filtered_ms) : ms;
+                m_measured      = true;
+
+                //the frames in flight were rendered at the previous scale
+                if (m_settle > 0)
+                {
+                    m_settle--;
+                    return m_output;
+                }
+
+                auto ratio = m_filtered_ms / s.m_target_ms;
+
+                //within the hysteresis band, hold and start the next correction fresh
+                if (ratio <= s.m_lower_threshold && ratio >= s.m_raise_threshold)
+                {
+                    m_integral          = 0.0f;
+                    m_previous_error    = 0.0f;
+                    return m_output;
+                }
+
+                //a frame bound by the cpu does not get faster with less pixels
+                auto cpu_bound = t.m_gpu_ms > 0.0f && t.m_cpu_ms > t.m_gpu_ms;
+
+                if (ratio > s.m_lower_threshold && cpu_bound)
+                {
+                    return m_output;
+                }
+
+                auto error      = std::sqrt(1.0f / ratio) - 1.0f;
+                auto derivative = error - m_previous_error;
+
+                //no integration against a limit, so the integral does not wind up
+                auto saturated  = (error > 0.0f && m_scale >= s.m_max_scale) || (error < 0.0f && m_scale <= s.m_min_scale);
+
+                if (!saturated)
+                {
+                    m_integral = std::min(std::max(m_integral + error, -s.m_integral_limit), s.m_integral_limit);
+                }
+
+                auto change = s.m_kp * error + s.m_ki * m_integral + s.m_kd * derivative;
+                change      = std::min(std::max(change, -s.m_max_change), s.m_max_change);
+
+                m_previous_error    = error;
+                m_scale             = std::min(std::max(m_scale * (1.0f + change), s.m_min_scale), s.m_max_scale);
+
+                auto output = quantize(m_scale);
+
+                if (output != m_output)
+                {
+                    m_output = output;
+                    m_settle = s.m_settle_frames;
+                }
+
+                return m_output;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            std::vector<float> replay(dynamic_resolution_controller& c, const std::vector<trace_frame>& trace, uint32_t latency)
+            {
+                std::vector<float> r;
+                r.reserve(trace.size());
+
+                for (auto i = 0U; i < trace.size(); ++i)
+                {
+                    r.push_back(c.scale());
+
+                    //the frame which completes now
+                    if (i >= latency)
+                    {
+                        auto&& recorded = trace[i - latency];
+                        auto   scale    = r[i - latency];
+                        auto   pixels   = (scale * scale) / (recorded.m_scale * recorded.m_scale);
+
+                        frame_timing t  = recorded.m_timing;
+                        t.m_gpu_ms      = t.m_gpu_ms * pixels;
+
+                        c.update(t);
+                    }
+                }
+
+                return r;
+            }
+        }
+    }
+}
@@ -7,12 +7,15 @@
 #include <uc_dev/gx/dx12/api/helpers.h>
 #include <uc_dev/gx/dx12/gpu/descriptions.h>
 #include <uc_dev/gx/dx12/gpu/descriptor_heap.h>
+#include <uc_dev/gx/dx12/gpu/frames_in_flight.h>
 #include <uc_dev/gx/dx12/gpu/allocators/buddy_allocator.h>
 
 #include <uc_dev/gx/dx12/gpu/allocators/placement_allocator.h>
 #include <uc_dev/gx/dx12/gpu/allocators/buddy_allocator.h>
 #include <uc_dev/gx/dx12/gpu/allocators/coalesceable_allocator.h>
 
+#include <array>
+#include <utility>
 #include <concurrent_vector.h>
 
 #include <uc_dev/gx/dx12/gpu/back_buffer.h>
@@ -136,6 +139,12 @@ namespace uc
                     s.ComparisonFunc = D3D12_COMPARISON_FUNC_ALWAYS;
                     return s;
                 }
+
+                //a heap per frame in flight, the heaps are not movable, so they are created in place
+                template <typename heap_t, size_t... frames> std::array<heap_t, sizeof...(frames)> create_frame_heaps(ID3D12Device* device, uint32_t count, std::index_sequence<frames...>)
+                {
+                    return { { heap_t(device, (static_cast<void>(frames), count))... } };
+                }
             }
 
             class gpu_resource_create_context::gpu_resource_create_context_impl
@@ -151,19 +160,19 @@ namespace uc
 
                 Microsoft::WRL::ComPtr<ID3D12Device>              m_device;
 
-                //frame heaps for the command contexts
-                gpu_dsv_descriptor_heap                           m_frame_dsv_heap[3];
-                gpu_rtv_descriptor_heap                           m_frame_rtv_heap[3];
+                //frame heaps for the command contexts, one ring each holds the descriptors of the frames in flight
+                gpu_dsv_ring_descriptor_heap                      m_frame_dsv_heap;
+                gpu_rtv_ring_descriptor_heap                      m_frame_rtv_heap;
 
-                gpu_srv_descriptor_heap                           m_frame_gpu_srv_heap[3];
-                cpu_srv_descriptor_heap                           m_frame_cpu_srv_heap[3];
+                gpu_srv_ring_descriptor_heap                      m_frame_gpu_srv_heap;        //the bindless textures are in front of the ring
+                cpu_srv_ring_descriptor_heap                      m_frame_cpu_srv_heap;
 
-                gpu_sampler_descriptor_heap                       m_frame_gpu_sampler_heap[3];
-                cpu_sampler_descriptor_heap                       m_frame_cpu_sampler_heap[3];
+                std::array<gpu_sampler_descriptor_heap, max_frames_in_flight>   m_frame_gpu_sampler_heap;
+                std::array<cpu_sampler_descriptor_heap, max_frames_in_flight>   m_frame_cpu_sampler_heap;
                 std::unique_ptr< placement_heap_allocator>        m_frame_render_target_allocator;
 
-                std::unique_ptr< placement_heap_allocator >       m_upload_allocator[3];       //holds only buffers
-                std::unique_ptr< placement_heap_allocator>        m_read_back_allocator[3];
+                std::unique_ptr< placement_heap_allocator >       m_upload_allocator[max_frames_in_flight];       //holds only buffers
+                std::unique_ptr< placement_heap_allocator>        m_read_back_allocator[max_frames_in_flight];
 
                 //window dependent resources, frame buffer, view dependent depth buffer, or frame dependent resources
                 //shadow maps, hdr buffers, light buffers, 
@@ -196,21 +205,24 @@ namespace uc
                 descriptor_handle                                 m_linear_wrap_sampler;
 
                 uint32_t                                          m_frame_index;
+                uint64_t                                          m_frame;                     //frames since the start, the fence value of the frame heaps
 
                 //textures
                 //todo: add concurrent queues
                 std::mutex                                                              m_delete_textures_mutex;
-                concurrency::concurrent_vector< gpu_texture_2d* >                       m_frame_delete_texture_2d[3];
-                concurrency::concurrent_vector< gpu_read_write_texture_2d* >            m_frame_delete_read_write_texture_2d[3];
-                concurrency::concurrent_vector< gpu_texture_2d_array* >                 m_frame_delete_texture_2d_array[3];
+                concurrency::concurrent_vector< gpu_texture_2d* >                       m_frame_delete_texture_2d[max_frames_in_flight];
+                concurrency::concurrent_vector< gpu_read_write_texture_2d* >            m_frame_delete_read_write_texture_2d[max_frames_in_flight];
+                concurrency::concurrent_vector< gpu_texture_2d_array* >                 m_frame_delete_texture_2d_array[max_frames_in_flight];
 
                 //buffers
                 //todo: add concurrent queues
                 std::mutex                                          m_delete_buffers_mutex;
-                concurrency::concurrent_vector< gpu_buffer* >       m_frame_delete_buffers[3];
+                concurrency::concurrent_vector< gpu_buffer* >       m_frame_delete_buffers[max_frames_in_flight];
 
                 gpu_resource_create_context_impl(ID3D12Device* d);
 
+                bindless_descriptor_handle make_bindless(descriptor_handle srv);
+
                 void    free_texture_2d_internal(gpu_texture_2d* texture);
                 void    flush_deleted_texture_2d(uint32_t frame_index);
 
@@ -227,12 +239,12 @@ namespace uc
             
             gpu_resource_create_context::gpu_resource_create_context_impl::gpu_resource_create_context_impl(ID3D12Device* device) :
                 m_device(device)
-                , m_frame_dsv_heap{ { device, 1024 },{ device, 1024 },{ device, 1024 } }
-                , m_frame_rtv_heap{ { device, 1024 },{ device, 1024 },{ device, 1024 } }
-                , m_frame_gpu_srv_heap{ { device, 2048 },{ device, 2048 },{ device, 2048 } }
-                , m_frame_cpu_srv_heap{ { device, 2048 },{ device, 2048 },{ device, 2048 } }
-                , m_frame_gpu_sampler_heap{ { device, 1024 },{ device, 1024 },{ device, 1024 } }
-                , m_frame_cpu_sampler_heap{ { device, 1024 },{ device, 1024 },{ device, 1024 } }
+                , m_frame_dsv_heap(device, max_frames_in_flight * 1024)
+                , m_frame_rtv_heap(device, max_frames_in_flight * 1024)
+                , m_frame_gpu_srv_heap(device, max_frames_in_flight * 2048, 256)
+                , m_frame_cpu_srv_heap(device, max_frames_in_flight * 2048)
+                , m_frame_gpu_sampler_heap(details::create_frame_heaps<gpu_sampler_descriptor_heap>(device, 1024, std::make_index_sequence<max_frames_in_flight>()))
+                , m_frame_cpu_sampler_heap(details::create_frame_heaps<cpu_sampler_descriptor_heap>(device, 1024, std::make_index_sequence<max_frames_in_flight>()))
 
                 , m_view_dependent_dsv_heap(device, 256)
                 , m_view_dependent_srv_heap(device, 256)
@@ -243,23 +255,39 @@ namespace uc
                 , m_null_resource_srv_heap(device, 16)
                 , m_null_sampler_heap(device, 16)
                 , m_frame_index(0)
+                , m_frame(0)
             {
 
             }
 
+            //copies the srv of a long lived texture into the bindless table, the texture works without it, if the table is full
+            bindless_descriptor_handle gpu_resource_create_context::gpu_resource_create_context_impl::make_bindless(descriptor_handle srv)
+            {
+                bindless_descriptor_handle r;
+
+                auto index = m_frame_gpu_srv_heap.allocate_bindless();
+
+                if (index != descriptor_index_pool::invalid)
+                {
+                    m_device->CopyDescriptorsSimple(1, m_frame_gpu_srv_heap.handle(index), srv, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                    r.m_heap    = &m_frame_gpu_srv_heap;
+                    r.m_index   = index;
+                }
+
+                return r;
+            }
+
             //template uc::util::details::pimpl<gpu_resource_create_context::gpu_resource_create_context_impl>;
 
             gpu_resource_create_context::gpu_resource_create_context(ID3D12Device* device) : m_impl(device)
             {
                 using placement_heap_allocator = gpu_resource_create_context::gpu_resource_create_context_impl::placement_heap_allocator;
 
-                m_impl->m_upload_allocator[0]       = std::unique_ptr< placement_heap_allocator >(details::create_upload_buffers_allocator(device, mb(32)));         //allocators for uploading resources
-                m_impl->m_upload_allocator[1]       = std::unique_ptr< placement_heap_allocator >(details::create_upload_buffers_allocator(device, mb(32)));         //allocators for uploading resources
-                m_impl->m_upload_allocator[2]       = std::unique_ptr< placement_heap_allocator >(details::create_upload_buffers_allocator(device, mb(32)));         //allocators for uploading resources
-
-                m_impl->m_read_back_allocator[0]    = std::unique_ptr< placement_heap_allocator >(details::create_read_back_textures_allocator(device, mb(8)));        //allocators for downloading resources
-                m_impl->m_read_back_allocator[1]    = std::unique_ptr< placement_heap_allocator >(details::create_read_back_textures_allocator(device, mb(8)));        //allocators for downloading resources
-                m_impl->m_read_back_allocator[2]    = std::unique_ptr< placement_heap_allocator >(details::create_read_back_textures_allocator(device, mb(8)));        //allocators for downloading resources
+                for (auto i = 0U; i < max_frames_in_flight; ++i)
+                {
+                    m_impl->m_upload_allocator[i]       = std::unique_ptr< placement_heap_allocator >(details::create_upload_buffers_allocator(device, mb(32)));         //allocators for uploading resources
+                    m_impl->m_read_back_allocator[i]    = std::unique_ptr< placement_heap_allocator >(details::create_read_back_textures_allocator(device, mb(8)));        //allocators for downloading resources
+                }
 
                 m_impl->m_view_dependent_render_target_allocator   = std::unique_ptr< placement_heap_allocator >(details::create_default_render_target_allocator(device, mb(32)));    //per view render targets and depth buffers, their lifetime depends on the view
                 m_impl->m_frame_render_target_allocator            = std::unique_ptr< placement_heap_allocator >(details::create_default_render_target_allocator(device, mb(192)));   //per frame render targets and depth buffers, their lifetime depends on the frame
@@ -413,7 +441,8 @@ namespace uc
 
                 m_impl->m_device->CreateShaderResourceView(resource.Get(), &descSRV, srv.handle());
 
-                return new gpu_texture_2d(resource.Get(), std::move(srv));
+                auto bindless = m_impl->make_bindless(srv.handle());
+                return new gpu_texture_2d(resource.Get(), std::move(srv), bindless);
             }
 
             gpu_read_write_texture_2d* gpu_resource_create_context::create_read_write_texture_2d(uint32_t width, uint32_t height, DXGI_FORMAT format, uint32_t mip_count)
@@ -494,7 +523,9 @@ namespace uc
                 descSRV.Texture2DArray.PlaneSlice       = 0;
                 
                 m_impl->m_device->CreateShaderResourceView(resource.Get(), &descSRV, srv.handle());
-                return new gpu_texture_2d_array(resource.Get(), std::move(srv));
+
+                auto bindless = m_impl->make_bindless(srv.handle());
+                return new gpu_texture_2d_array(resource.Get(), std::move(srv), bindless);
             }
 
             Microsoft::WRL::ComPtr<ID3D12Resource> gpu_resource_create_context::create_upload_buffer_resource(uint64_t size)
@@ -735,6 +766,18 @@ namespace uc
                     descriptor_handle dsv[] = { dsvReadWrite, dsvReadDepth };
                     return new t(resource.Get(), srv, dsv);
                 }
+
+                //places the resources at a fixed offset of the heap, in a block of the transients of a frame graph
+                template <typename allocator> struct transient_placement
+                {
+                    allocator*  m_allocator;
+                    uint64_t    m_offset;
+
+                    Microsoft::WRL::ComPtr<ID3D12Resource> create_placed_resource(const D3D12_RESOURCE_DESC* desc, D3D12_RESOURCE_STATES initial_state, const D3D12_CLEAR_VALUE* optimized_clear_value)
+                    {
+                        return m_allocator->create_placed_resource(m_offset, desc, initial_state, optimized_clear_value);
+                    }
+                };
             }
             
 
@@ -792,6 +835,28 @@ namespace uc
                     );
             }
 
+            uint64_t gpu_resource_create_context::allocate_frame_transients(uint64_t size, uint64_t alignment)
+            {
+                return m_impl->m_frame_render_target_allocator->allocate(size, alignment);
+            }
+
+            D3D12_RESOURCE_ALLOCATION_INFO gpu_resource_create_context::msaa_depth_buffer_allocation_info(uint32_t width, uint32_t height, DXGI_FORMAT format)
+            {
+                auto desc = describe_msaa_depth_buffer(width, height, format, 4);
+                return m_impl->m_frame_render_target_allocator->allocation_info(&desc);
+            }
+
+            gpu_frame_msaa_depth_buffer*  gpu_resource_create_context::create_frame_msaa_depth_buffer(uint64_t transients, uint64_t offset, uint32_t width, uint32_t height, DXGI_FORMAT format, float clear_value, uint8_t stencil)
+            {
+                details::transient_placement<gpu_resource_create_context_impl::placement_heap_allocator> placement = { m_impl->m_frame_render_target_allocator.get(), transients + offset };
+
+                return details::create_msaa_depth_buffer<gpu_frame_msaa_depth_buffer>(m_impl->m_device.Get(), width, height, format, clear_value, stencil,
+                    &placement,
+                    frame_dsv_heap(),
+                    frame_cpu_srv_heap()
+                    );
+            }
+
             gpu_back_buffer* gpu_resource_create_context::create_back_buffer(ID3D12Resource* resource)
             {
                 D3D12_RENDER_TARGET_VIEW_DESC rtv = {};
@@ -852,17 +917,29 @@ namespace uc
             void gpu_resource_create_context::sync()
             {
                 m_impl->m_frame_index++;
-                m_impl->m_frame_index %= 3;
+                m_impl->m_frame_index %= max_frames_in_flight;
 
                 m_impl->flush_deleted_texture_2d(m_impl->m_frame_index);
                 m_impl->flush_deleted_texture_2d_array(m_impl->m_frame_index);
                 m_impl->flush_deleted_read_write_texture_2d(m_impl->m_frame_index);
                 m_impl->flush_deleted_buffers(m_impl->m_frame_index);
 
-                frame_gpu_srv_heap()->reset();
-                frame_cpu_srv_heap()->reset();
-                frame_dsv_heap()->reset();
-                frame_rtv_heap()->reset();
+                //the frame which ends keeps its descriptors until the frame which reuses its resources begins, as the other frame data
+                auto frame = m_impl->m_frame++;
+
+                m_impl->m_frame_gpu_srv_heap.retire(frame);
+                m_impl->m_frame_cpu_srv_heap.retire(frame);
+                m_impl->m_frame_dsv_heap.retire(frame);
+                m_impl->m_frame_rtv_heap.retire(frame);
+
+                if (frame >= max_frames_in_flight - 1)
+                {
+                    auto reused = frame - (max_frames_in_flight - 1);
+                    m_impl->m_frame_gpu_srv_heap.reclaim(reused);
+                    m_impl->m_frame_cpu_srv_heap.reclaim(reused);
+                    m_impl->m_frame_dsv_heap.reclaim(reused);
+                    m_impl->m_frame_rtv_heap.reclaim(reused);
+                }
 
                 m_impl->m_frame_render_target_allocator->reset();
                 m_impl->upload_allocator()->reset();
@@ -899,24 +976,24 @@ namespace uc
                 return m_geometry_heap.get();
             }
 
-            gpu_srv_descriptor_heap* gpu_resource_create_context::frame_gpu_srv_heap()
+            gpu_srv_ring_descriptor_heap* gpu_resource_create_context::frame_gpu_srv_heap()
             {
-                return &m_impl->m_frame_gpu_srv_heap[m_impl->m_frame_index];
+                return &m_impl->m_frame_gpu_srv_heap;
             }
 
-            cpu_srv_descriptor_heap* gpu_resource_create_context::frame_cpu_srv_heap()
+            cpu_srv_ring_descriptor_heap* gpu_resource_create_context::frame_cpu_srv_heap()
             {
-                return &m_impl->m_frame_cpu_srv_heap[m_impl->m_frame_index];
+                return &m_impl->m_frame_cpu_srv_heap;
             }
 
-            gpu_rtv_descriptor_heap* gpu_resource_create_context::frame_rtv_heap()
+            gpu_rtv_ring_descriptor_heap* gpu_resource_create_context::frame_rtv_heap()
             {
-                return &m_impl->m_frame_rtv_heap[m_impl->m_frame_index];
+                return &m_impl->m_frame_rtv_heap;
             }
 
-            gpu_dsv_descriptor_heap* gpu_resource_create_context::frame_dsv_heap()
+            gpu_dsv_ring_descriptor_heap* gpu_resource_create_context::frame_dsv_heap()
             {
-                return &m_impl->m_frame_dsv_heap[m_impl->m_frame_index];
+                return &m_impl->m_frame_dsv_heap;
             }
 
             gpu_sampler_descriptor_heap* gpu_resource_create_context::frame_gpu_sampler_heap()
@@ -0,0 +1,23 @@
+#include "../default_signature.hlsli"
+#include "../default_samplers.hlsli"
+
+struct interpolants
+{
+    float4 position     : SV_POSITION0;
+    float2 uv           : texcoord0;
+};
+
+//the srvs of the long lived textures, indexed by their bindless_index()
+Texture2D<float4> g_textures[]  : register(t0, space1);
+
+//set before every draw, the same for all pixels of the draw
+cbuffer per_draw_call_material : register(b9)
+{
+    uint m_albedo;
+};
+
+[RootSignature( MyRS3 ) ]
+float4 main( interpolants r ) : SV_Target0
+{
+    return g_textures[m_albedo].Sample(g_linear_clamp, r.uv);
+}
@@ -0,0 +1,64 @@
+#include "../default_signature.hlsli"
+
+#include "vector_space.hlsli"
+#include "frame.hlsli"
+#include "transform_skinned.hlsli"
+
+struct interpolants
+{
+    float4 position       : SV_POSITION0;
+    float2 uv             : texcoord0;
+    float3 position_ws    : position0;
+    float3 normal_ws      : normal0;
+};
+
+struct input
+{
+    float3 position : position;
+    float2 uv       : texcoord0;
+    float3 normal   : normal0;
+    float3 tangent  : tangent0;
+    float4 weights  : blend_weights0;
+    uint4 indices   : blend_indices0;
+};
+
+//the instances of all draws of the indirect draw
+struct per_draw_call
+{
+    euclidean_transform_3d m_world;
+    float4x4 m_joints_palette[127];
+};
+
+StructuredBuffer<per_draw_call> m_draw_calls : register(t0);
+
+//set by the indirect draw before every draw
+cbuffer per_draw_call_index : register(b9)
+{
+    uint m_draw_call;
+};
+
+
+[RootSignature( MyRS1 ) ]
+interpolants main(input i)
+{
+    interpolants r;
+
+    euclidean_transform_3d m_world      = m_draw_calls[m_draw_call].m_world;
+
+    float4     position                 = float4(i.position, 1.0f);
+    float3     normal                   = i.normal;
+    point_os   skinned_position         = make_point_os( skin_position(position, i.weights, i.indices, m_draw_calls[m_draw_call].m_joints_palette).xyz);
+    vector_os  skinned_normal           = make_vector_os( skin_normal(normal, i.weights, i.indices, m_draw_calls[m_draw_call].m_joints_palette).xyz);
+    point_ws   skinned_world            = transform_p_os( skinned_position, m_world );
+    
+    euclidean_transform_3d world_inverse;
+    world_inverse.m_value               = m_world.m_value;
+    vector_ws  skinned_world_normal     = transform_v_os( skinned_normal, world_inverse );
+
+    r.uv                        = i.uv;
+    r.position                  = project_p_os( skinned_position, m_world, m_view, m_perspective ).m_value;
+    r.position_ws               = skinned_world.m_value.xyz;
+    r.normal_ws                 = skinned_world_normal.m_value;
+    return r;
+}
+
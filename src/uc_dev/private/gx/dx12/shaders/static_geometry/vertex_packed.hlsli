@@ -0,0 +1,29 @@
+#ifndef __vertex_packed_hlsli__
+#define __vertex_packed_hlsli__
+
+//decoders for lip::packed_skinned_model streams
+//bind positions as R16G16B16A16_UNORM, uv as R16G16_FLOAT, normals and tangents as R16G16_SNORM, blend weights as R8G8B8A8_UNORM
+
+float3 sign_not_zero(float3 v)
+{
+    return v >= 0.0 ? 1.0 : -1.0;
+}
+
+float3 decode_octahedral(float2 e)
+{
+    float3 v = float3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+
+    if (v.z < 0.0)
+    {
+        v.xy = (1.0 - abs(v.yx)) * sign_not_zero(v.xyz).xy;
+    }
+
+    return normalize(v);
+}
+
+float4 decode_position(float4 unorm_position, float3 position_min, float3 position_extent)
+{
+    return float4(position_min + unorm_position.xyz * position_extent, 1.0);
+}
+
+#endif
@@ -79,7 +79,7 @@ namespace uc
             {
                 std::lock_guard<std::mutex> lock(m_executing_tasks_lock);
 
-                m_buffer_index = ( m_buffer_index + 1 ) % 3;
+                m_buffer_index = ( m_buffer_index + 1 ) % max_frames_in_flight;
 
                 auto& v = m_executing_tasks[m_buffer_index];
 
@@ -105,9 +105,9 @@ namespace uc
                 //submit tasks so far
                 m_executing_tasks[m_buffer_index].push_back(submit());
                 {
-                    for ( auto index = 2; index < 3; ++index )
+                    for ( auto index = max_frames_in_flight - 1; index < max_frames_in_flight; ++index )
                     {
-                        auto iv = (index + m_buffer_index) % 3;
+                        auto iv = (index + m_buffer_index) % max_frames_in_flight;
                         auto& v = m_executing_tasks[ iv ];
 
                         for ( auto& i : v )
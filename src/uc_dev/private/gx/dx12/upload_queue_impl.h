@@ -12,6 +12,7 @@
 #include <boost/variant.hpp>
 
 #include <uc_dev/gx/dx12/cmd/upload_buffer_handle.h>
+#include <uc_dev/gx/dx12/gpu/frames_in_flight.h>
 #include <uc_dev/gx/dx12/gpu/upload_buffer.h>
 #include <uc_dev/gx/dx12/gpu/resource_create_context.h>
 #include <uc_dev/gx/dx12/cmd/command_queue.h>
@@ -166,7 +167,7 @@ namespace uc
                 using task_handle = task; 
                 concurrency::concurrent_vector < task_handle >      m_tasks;
                 std::mutex                                          m_executing_tasks_lock;
-                std::vector<task_result>                            m_executing_tasks[3];
+                std::vector<task_result>                            m_executing_tasks[max_frames_in_flight];
 
                 void copy_buffer(gpu_upload_buffer* b, const void* initial_data, uint64_t size);
                 void copy_buffer(gpu_upload_buffer* b, const void* initial_data, uint64_t size, uint64_t offset);
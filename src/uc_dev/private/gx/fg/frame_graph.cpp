@@ -0,0 +1,565 @@
+#include "pch.h"
+
+#include <uc_dev/gx/fg/frame_graph.h>
+
+#include <algorithm>
+
+namespace uc {
+    namespace gx {
+        namespace fg {
+
+            namespace
+            {
+                inline bool is_read_only(uint32_t state)
+                {
+                    return state != cmd::resource_state_common && (state & cmd::resource_state_read_only) == state;
+                }
+
+                //the states a compute command list can transition from and to
+                inline bool is_compute_state(uint32_t state)
+                {
+                    const uint32_t compute_states = cmd::resource_state_vertex_and_constant_buffer | cmd::resource_state_unordered_access | cmd::resource_state_non_pixel_shader_resource
+                                                  | cmd::resource_state_indirect_argument | cmd::resource_state_copy_dest | cmd::resource_state_copy_source;
+                    return (state & ~compute_states) == 0;
+                }
+
+                inline uint64_t align(uint64_t v, uint64_t alignment)
+                {
+                    return (v + alignment - 1) / alignment * alignment;
+                }
+
+                inline bool overlaps(uint32_t first0, uint32_t last0, uint32_t first1, uint32_t last1)
+                {
+                    return first0 <= last1 && first1 <= last0;
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            resource_handle frame_graph::create_transient(const char* name, const transient_desc& d)
+            {
+                resource r;
+
+                r.m_name            = name;
+                r.m_imported        = false;
+                r.m_initial_state   = cmd::resource_state_unknown;
+                r.m_final_state     = cmd::resource_state_unknown;
+                r.m_desc            = d;
+
+                m_resources.push_back(std::move(r));
+                return static_cast<resource_handle>(m_resources.size() - 1);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            resource_handle frame_graph::import_resource(const char* name, uint32_t initial_state, uint32_t final_state)
+            {
+                resource r;
+
+                r.m_name            = name;
+                r.m_imported        = true;
+                r.m_initial_state   = initial_state;
+                r.m_final_state     = final_state;
+
+                m_resources.push_back(std::move(r));
+                return static_cast<resource_handle>(m_resources.size() - 1);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            pass_handle frame_graph::add_pass(const char* name, pass_queue queue)
+            {
+                pass p;
+
+                p.m_name    = name;
+                p.m_queue   = queue;
+
+                m_passes.push_back(std::move(p));
+                return static_cast<pass_handle>(m_passes.size() - 1);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void frame_graph::read(pass_handle p, resource_handle r, uint32_t state)
+            {
+                add_access(p, r, state, false);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void frame_graph::write(pass_handle p, resource_handle r, uint32_t state)
+            {
+                add_access(p, r, state, true);
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void frame_graph::keep(pass_handle p)
+            {
+                m_passes[p].m_keep = true;
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void frame_graph::reset()
+            {
+                m_passes.clear();
+                m_resources.clear();
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void frame_graph::add_access(pass_handle p, resource_handle r, uint32_t state, bool write)
+            {
+                auto&& accesses = m_passes[p].m_accesses;
+
+                //one access per resource and pass, the write state wins, the read states combine
+                for (auto&& a : accesses)
+                {
+                    if (a.m_resource == r)
+                    {
+                        if (write)
+                        {
+                            a.m_state = a.m_write ? a.m_state | state : state;
+                            a.m_write = true;
+                        }
+                        else if (!a.m_write)
+                        {
+                            a.m_state |= state;
+                        }
+
+                        return;
+                    }
+                }
+
+                accesses.push_back({ r, state, write });
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void frame_graph::compile(compiled_frame_graph& g) const
+            {
+                const auto pass_count       = static_cast<uint32_t>(m_passes.size());
+                const auto resource_count   = static_cast<uint32_t>(m_resources.size());
+
+                g.m_passes.clear();
+                g.m_final_barriers.clear();
+                g.m_final_waits.clear();
+                g.m_resources.assign(resource_count, compiled_resource());
+                g.m_statistics = frame_graph_statistics();
+
+                //cull, a pass lives while a resource it writes is read by a live pass or imported
+                std::vector<uint32_t>                       pass_references(pass_count, 0);
+                std::vector<uint32_t>                       resource_references(resource_count, 0);
+                std::vector<std::vector<pass_handle>>       writers(resource_count);
+                std::vector<bool>                           alive(pass_count, true);
+                std::vector<resource_handle>                unreferenced;
+
+                for (auto p = 0U; p < pass_count; ++p)
+                {
+                    for (auto&& a : m_passes[p].m_accesses)
+                    {
+                        if (a.m_write)
+                        {
+                            pass_references[p]++;
+                            writers[a.m_resource].push_back(p);
+                        }
+                        else
+                        {
+                            resource_references[a.m_resource]++;
+                        }
+                    }
+                }
+
+                for (auto r = 0U; r < resource_count; ++r)
+                {
+                    if (m_resources[r].m_imported)
+                    {
+                        resource_references[r]++;
+                    }
+
+                    if (resource_references[r] == 0)
+                    {
+                        unreferenced.push_back(r);
+                    }
+                }
+
+                auto cull = [&](pass_handle p)
+                {
+                    alive[p] = false;
+                    g.m_statistics.m_culled_passes++;
+
+                    for (auto&& a : m_passes[p].m_accesses)
+                    {
+                        if (!a.m_write && --resource_references[a.m_resource] == 0)
+                        {
+                            unreferenced.push_back(a.m_resource);
+                        }
+                    }
+                };
+
+                for (auto p = 0U; p < pass_count; ++p)
+                {
+                    if (pass_references[p] == 0 && !m_passes[p].m_keep)
+                    {
+                        cull(p);
+                    }
+                }
+
+                while (!unreferenced.empty())
+                {
+                    auto r = unreferenced.back();
+                    unreferenced.pop_back();
+
+                    for (auto&& w : writers[r])
+                    {
+                        if (alive[w] && !m_passes[w].m_keep && --pass_references[w] == 0)
+                        {
+                            cull(w);
+                        }
+                    }
+                }
+
+                for (auto p = 0U; p < pass_count; ++p)
+                {
+                    if (alive[p])
+                    {
+                        compiled_pass c;
+                        c.m_pass = p;
+                        g.m_passes.push_back(std::move(c));
+                    }
+                }
+
+                const auto live_count = static_cast<uint32_t>(g.m_passes.size());
+
+                //the accesses of the live passes to every resource, in submission order, so the look aheads do not search the passes
+                struct use
+                {
+                    uint32_t        m_position;
+                    const access*   m_access;
+                };
+
+                std::vector<std::vector<use>> uses(resource_count);
+
+                for (auto i = 0U; i < live_count; ++i)
+                {
+                    for (auto&& a : m_passes[g.m_passes[i].m_pass].m_accesses)
+                    {
+                        uses[a.m_resource].push_back({ i, &a });
+                    }
+                }
+
+                //barriers, from the state of the previous access to the state of this one
+                std::vector<uint32_t>   states(resource_count);
+                std::vector<uint32_t>   next_use(resource_count, 0);
+                std::vector<bool>       last_write(resource_count, false);
+                std::vector<bool>       accessed(resource_count, false);
+
+                for (auto r = 0U; r < resource_count; ++r)
+                {
+                    states[r] = m_resources[r].m_initial_state;
+                }
+
+                for (auto i = 0U; i < live_count; ++i)
+                {
+                    auto&& c = g.m_passes[i];
+
+                    for (auto&& a : m_passes[c.m_pass].m_accesses)
+                    {
+                        auto r      = a.m_resource;
+                        auto target = a.m_state;
+                        auto&& u    = uses[r];
+
+                        next_use[r]++;
+
+                        //consecutive reads go to one combined read state, so there is one barrier for all of them
+                        if (!a.m_write && is_read_only(target))
+                        {
+                            for (auto j = next_use[r]; j < u.size(); ++j)
+                            {
+                                auto n = u[j].m_access;
+
+                                if (n->m_write || !is_read_only(n->m_state))
+                                {
+                                    break;
+                                }
+
+                                target |= n->m_state;
+                            }
+                        }
+
+                        auto&& cr = g.m_resources[r];
+
+                        if (cr.m_first == invalid_handle)
+                        {
+                            cr.m_first = i;
+                        }
+
+                        cr.m_last = i;
+
+                        if (states[r] == cmd::resource_state_unknown)
+                        {
+                            //first use of a transient, it is created in this state
+                            cr.m_initial_state = target;
+                            states[r]          = target;
+                        }
+                        else if (states[r] == target || (is_read_only(states[r]) && (target & ~states[r]) == 0 && !a.m_write))
+                        {
+                            if (target == cmd::resource_state_unordered_access && accessed[r] && (a.m_write || last_write[r]))
+                            {
+                                c.m_barriers.push_back({ barrier_type::uav, r, invalid_handle, target, target });
+                            }
+                        }
+                        else
+                        {
+                            c.m_barriers.push_back({ barrier_type::transition, r, invalid_handle, states[r], target });
+                            states[r] = target;
+                        }
+
+                        last_write[r] = a.m_write;
+                        accessed[r]   = true;
+                    }
+                }
+
+                for (auto r = 0U; r < resource_count; ++r)
+                {
+                    auto&& d = m_resources[r];
+
+                    if (d.m_imported)
+                    {
+                        g.m_resources[r].m_initial_state = d.m_initial_state;
+
+                        if (d.m_final_state != cmd::resource_state_unknown && d.m_final_state != states[r])
+                        {
+                            g.m_final_barriers.push_back({ barrier_type::transition, r, invalid_handle, states[r], d.m_final_state });
+                        }
+                    }
+                }
+
+                //async compute, only for the passes whose barriers the compute queue can do,
+                //and only if a graphics pass runs before the first pass that depends on them, otherwise the queues only wait for each other
+                std::vector<uint32_t> graphics_before(live_count + 1, 0);
+
+                for (auto i = 0U; i < live_count; ++i)
+                {
+                    graphics_before[i + 1] = graphics_before[i] + (m_passes[g.m_passes[i].m_pass].m_queue == pass_queue::graphics ? 1 : 0);
+                }
+
+                for (auto i = 0U; i < live_count; ++i)
+                {
+                    auto&& c = g.m_passes[i];
+                    auto&& p = m_passes[c.m_pass];
+
+                    if (p.m_queue != pass_queue::compute)
+                    {
+                        continue;
+                    }
+
+                    bool eligible = std::all_of(c.m_barriers.begin(), c.m_barriers.end(), [](const barrier& b)
+                    {
+                        return b.m_type != barrier_type::transition || (is_compute_state(b.m_before) && is_compute_state(b.m_after));
+                    });
+
+                    //the first later pass which writes what this pass accesses or accesses what it writes
+                    uint32_t dependent = live_count;
+
+                    for (auto&& a : p.m_accesses)
+                    {
+                        eligible = eligible && is_compute_state(a.m_state);
+
+                        auto&& u    = uses[a.m_resource];
+                        auto   next = std::upper_bound(u.begin(), u.end(), i, [](uint32_t position, const use& n) { return position < n.m_position; });
+
+                        for (; next != u.end() && next->m_position < dependent; ++next)
+                        {
+                            if (a.m_write || next->m_access->m_write)
+                            {
+                                dependent = next->m_position;
+                                break;
+                            }
+                        }
+                    }
+
+                    c.m_async = eligible && graphics_before[dependent] > graphics_before[i + 1];
+
+                    if (c.m_async)
+                    {
+                        g.m_statistics.m_async_passes++;
+                    }
+                }
+
+                //waits between the queues, for the last write before a read and for the reads and the write before a write
+                std::vector<uint32_t>               last_writer(resource_count, invalid_handle);
+                std::vector<std::vector<uint32_t>>  readers(resource_count);
+
+                for (auto i = 0U; i < live_count; ++i)
+                {
+                    auto&& c = g.m_passes[i];
+
+                    auto wait = [&g, &c](uint32_t position)
+                    {
+                        if (position != invalid_handle && g.m_passes[position].m_async != c.m_async)
+                        {
+                            auto q = g.m_passes[position].m_pass;
+
+                            if (std::find(c.m_waits.begin(), c.m_waits.end(), q) == c.m_waits.end())
+                            {
+                                c.m_waits.push_back(q);
+                            }
+                        }
+                    };
+
+                    for (auto&& a : m_passes[c.m_pass].m_accesses)
+                    {
+                        auto r = a.m_resource;
+
+                        wait(last_writer[r]);
+
+                        if (a.m_write)
+                        {
+                            for (auto&& reader : readers[r])
+                            {
+                                wait(reader);
+                            }
+
+                            readers[r].clear();
+                            last_writer[r] = i;
+                        }
+                        else
+                        {
+                            readers[r].push_back(i);
+                        }
+                    }
+                }
+
+                //the final barriers are on the graphics queue, they wait for the async passes which access the resources last
+                for (auto&& b : g.m_final_barriers)
+                {
+                    auto r = b.m_resource;
+
+                    auto wait = [&g](uint32_t position)
+                    {
+                        if (position != invalid_handle && g.m_passes[position].m_async)
+                        {
+                            auto q = g.m_passes[position].m_pass;
+
+                            if (std::find(g.m_final_waits.begin(), g.m_final_waits.end(), q) == g.m_final_waits.end())
+                            {
+                                g.m_final_waits.push_back(q);
+                            }
+                        }
+                    };
+
+                    wait(last_writer[r]);
+
+                    for (auto&& reader : readers[r])
+                    {
+                        wait(reader);
+                    }
+                }
+
+                //transient memory, first fit at the offsets where the resources with overlapping lifetimes end
+                //the transients of the async passes keep their memory, their lifetimes are not in submission order
+                struct placement
+                {
+                    resource_handle m_resource;
+                    uint64_t        m_offset;
+                    uint64_t        m_end;
+                };
+
+                std::vector<placement>          placements;
+                std::vector<const placement*>   live;
+                std::vector<bool>               async_used(resource_count, false);
+
+                for (auto&& c : g.m_passes)
+                {
+                    if (c.m_async)
+                    {
+                        for (auto&& a : m_passes[c.m_pass].m_accesses)
+                        {
+                            async_used[a.m_resource] = true;
+                        }
+                    }
+                }
+
+                uint64_t heap_size = 0;
+
+                for (auto r = 0U; r < resource_count; ++r)
+                {
+                    auto&& d  = m_resources[r];
+                    auto&& cr = g.m_resources[r];
+
+                    if (d.m_imported || cr.m_first == invalid_handle)
+                    {
+                        continue;
+                    }
+
+                    const auto size         = d.m_desc.m_size;
+                    const auto alignment    = std::max<uint64_t>(d.m_desc.m_alignment, 1);
+                    const auto first        = async_used[r] ? 0U : cr.m_first;
+                    const auto last         = async_used[r] ? live_count : cr.m_last;
+
+                    g.m_statistics.m_unaliased_size = align(g.m_statistics.m_unaliased_size, alignment) + size;
+                    g.m_statistics.m_heap_alignment = std::max(g.m_statistics.m_heap_alignment, alignment);
+
+                    //the lowest offset past the memory of the placed resources which live at the same time, swept in the order of their offsets
+                    live.clear();
+
+                    for (auto&& p : placements)
+                    {
+                        auto&& o = g.m_resources[p.m_resource];
+
+                        if (async_used[p.m_resource] || async_used[r] || overlaps(first, last, o.m_first, o.m_last))
+                        {
+                            live.push_back(&p);
+                        }
+                    }
+
+                    std::sort(live.begin(), live.end(), [](const placement* a, const placement* b) { return a->m_offset < b->m_offset; });
+
+                    uint64_t offset = 0;
+
+                    for (auto&& p : live)
+                    {
+                        if (offset + size <= p->m_offset)
+                        {
+                            break;
+                        }
+
+                        offset = std::max(offset, align(p->m_end, alignment));
+                    }
+
+                    cr.m_offset = offset;
+
+                    //the resource which used the memory last gives it over
+                    uint32_t        previous_last = 0;
+                    resource_handle previous      = invalid_handle;
+
+                    for (auto&& p : placements)
+                    {
+                        auto&& o = g.m_resources[p.m_resource];
+
+                        if (offset < p.m_end && p.m_offset < offset + size && (previous == invalid_handle || o.m_last >= previous_last))
+                        {
+                            previous      = p.m_resource;
+                            previous_last = o.m_last;
+                        }
+                    }
+
+                    if (previous != invalid_handle)
+                    {
+                        cr.m_aliased = true;
+                        g.m_statistics.m_aliased_resources++;
+
+                        auto&& barriers = g.m_passes[cr.m_first].m_barriers;
+                        barriers.insert(barriers.begin(), { barrier_type::aliasing, r, previous, cmd::resource_state_unknown, cr.m_initial_state });
+                    }
+
+                    placements.push_back({ r, offset, offset + size });
+                    heap_size = std::max(heap_size, offset + size);
+                }
+
+                g.m_statistics.m_heap_size = heap_size;
+
+                for (auto&& c : g.m_passes)
+                {
+                    g.m_statistics.m_barriers += static_cast<uint32_t>(c.m_barriers.size());
+                }
+
+                g.m_statistics.m_barriers += static_cast<uint32_t>(g.m_final_barriers.size());
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
@@ -11,8 +11,8 @@ namespace uc
         namespace geo
         {
             geometry_allocator::geometry_allocator(dx12::gpu_resource_create_context* rc, const geometry_allocator_options& options) :
-              m_skinned_meshes(rc, options.m_skinned_mesh_vertex_count)
-            , m_indices(rc, options.m_index_count)
+              m_skinned_meshes(rc, options.m_skinned_mesh_vertex_count, options.m_skinned_mesh_layout)
+            , m_indices(rc, options.m_index_count, options.m_index_16_count)
             , m_static_meshes(rc, options.m_static_mesh_vertex_count)
             , m_normal_meshes(rc, options.m_normal_mesh_vertex_count)
             {
@@ -31,9 +31,9 @@ namespace uc
                 m_skinned_meshes.free(free);
             }
 
-            geometry_allocator::indexed_allocation*  geometry_allocator::allocate_indices(size_t index_count)
+            geometry_allocator::indexed_allocation*  geometry_allocator::allocate_indices(size_t index_count, index_format format)
             {
-                return m_indices.allocate(static_cast<uint32_t>(index_count));
+                return m_indices.allocate(static_cast<uint32_t>(index_count), format);
             }
 
             void    geometry_allocator::free_indices(geometry_allocator::indexed_allocation* f)
@@ -71,9 +71,9 @@ namespace uc
                 return m_skinned_meshes.skinned_mesh_blend_index();
             }
 
-            dx12::gpu_buffer* geometry_allocator::indices() const
+            dx12::gpu_buffer* geometry_allocator::indices(index_format format) const
             {
-                return m_indices.indices();
+                return m_indices.indices(format);
             }
 
             vertex_buffer_view   geometry_allocator::skinned_mesh_position_view() const
@@ -107,9 +107,14 @@ namespace uc
                 return m_skinned_meshes.skinned_mesh_blend_index_view();
             }
 
-            index_buffer_view geometry_allocator::indices_view() const
+            vertex_layout geometry_allocator::skinned_mesh_layout() const
             {
-                return m_indices.indices_view();
+                return m_skinned_meshes.layout();
+            }
+
+            index_buffer_view geometry_allocator::indices_view(index_format format) const
+            {
+                return m_indices.indices_view(format);
             }
 
             //--------------------------------------------------------------------------------------------------------
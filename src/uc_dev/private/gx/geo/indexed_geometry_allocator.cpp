@@ -12,43 +12,73 @@ namespace uc
         {
             namespace details
             {
-                static inline uint32_t make_index_size(uint32_t index_count)
+                static inline uint32_t make_index_size(uint32_t index_count, index_format format)
                 {
-                    return index_count * default_geometry_index::stride::value;
+                    return index_count * index_stride(format);
                 }
 
+                static inline dx12::managed_gpu_buffer make_index_memory(dx12::gpu_resource_create_context* rc, uint32_t index_count, index_format format)
+                {
+                    return index_count > 0 ? dx12::create_buffer(rc, make_index_size(index_count, format)) : dx12::managed_gpu_buffer();
+                }
+
+                static inline gpu_virtual_address address(const dx12::managed_gpu_buffer& b)
+                {
+                    return b ? b->virtual_address() : 0;
+                }
+
+                static inline uint64_t size(const dx12::managed_gpu_buffer& b)
+                {
+                    return b ? dx12::size(b.get()) : 0;
+                }
             }
 
-            indexed_geometry_allocator::indexed_geometry_allocator(dx12::gpu_resource_create_context* rc, uint32_t index_count) :
-              m_index_memory(dx12::create_buffer(rc, details::make_index_size(index_count)))
-            , m_indices(m_index_memory->virtual_address(), size(m_index_memory.get()))
+            indexed_geometry_allocator::indexed_geometry_allocator(dx12::gpu_resource_create_context* rc, uint32_t index_count, uint32_t index_16_count) :
+              m_index_memory(details::make_index_memory(rc, index_count, index_format::r32_uint))
+            , m_index_memory_16(details::make_index_memory(rc, index_16_count, index_format::r16_uint))
+            , m_indices(details::address(m_index_memory), details::size(m_index_memory))
+            , m_indices_16(details::address(m_index_memory_16), details::size(m_index_memory_16), index_format::r16_uint)
             {
 
             }
 
-            indexed_geometry_allocator::indexed_allocation*  indexed_geometry_allocator::allocate(size_t index_count)
+            indexed_geometry_allocator::indexed_allocation*  indexed_geometry_allocator::allocate(size_t index_count, index_format format)
             {
+                if (format == index_format::r16_uint)
+                {
+                    assert(m_index_memory_16);
+                    return m_indices_16.allocate(static_cast<uint32_t>(index_count));
+                }
+
                 return m_indices.allocate(static_cast<uint32_t>(index_count));
             }
 
             void    indexed_geometry_allocator::free(indexed_geometry_allocator::indexed_allocation* f)
             {
-                m_indices.free(f);
+                if (f && f->format() == index_format::r16_uint)
+                {
+                    m_indices_16.free(f);
+                }
+                else
+                {
+                    m_indices.free(f);
+                }
             }
 
-            dx12::gpu_buffer* indexed_geometry_allocator::indices() const
+            dx12::gpu_buffer* indexed_geometry_allocator::indices(index_format format) const
             {
-                return m_index_memory.get();
+                return format == index_format::r16_uint ? m_index_memory_16.get() : m_index_memory.get();
             }
 
-            index_buffer_view indexed_geometry_allocator::indices_view() const
+            index_buffer_view indexed_geometry_allocator::indices_view(index_format format) const
             {
-                return m_indices.view();
+                return format == index_format::r16_uint ? m_indices_16.view() : m_indices.view();
             }
 
             void indexed_geometry_allocator::sync()
             {
                 m_indices.sync();
+                m_indices_16.sync();
             }
         }
     }
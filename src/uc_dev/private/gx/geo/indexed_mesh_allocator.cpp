@@ -5,6 +5,7 @@
 #include <vector>
 #include <uc_dev/util/pimpl_impl.h>
 #include <uc_dev/gx/geo/vertex_allocator.h>
+#include <uc_dev/gx/dx12/gpu/frames_in_flight.h>
 
 namespace uc
 {
@@ -19,12 +20,12 @@ namespace uc
                     return static_cast<uint32_t>(size_in_bytes / stride_in_bytes);
                 }
 
-                static inline index_buffer_view make_view(gpu_virtual_address address, size_t size)
+                static inline index_buffer_view make_view(gpu_virtual_address address, size_t size, index_format format)
                 {
                     index_buffer_view r;
                     r.BufferLocation = address;
                     r.SizeInBytes = static_cast<uint32_t>(size);
-                    r.Format = DXGI_FORMAT_R32_UINT;
+                    r.Format = format == index_format::r16_uint ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
                     return r;
                 }
             }
@@ -34,18 +35,19 @@ namespace uc
                 public:
                 gpu_virtual_address                     m_address;
                 uint64_t                                m_size;
-                static constexpr size_t                 m_stride = 4;
+                index_format                            m_format = index_format::r32_uint;
                 vertex_allocator                        m_allocator;
                 uint32_t                                m_frame_index = 0;
-                std::vector<vertex_allocator::handle>   m_pending_deletes[3];
+                std::vector<vertex_allocator::handle>   m_pending_deletes[dx12::max_frames_in_flight];
 
                 index_buffer_allocator_impl() : m_allocator(0)
                 {
 
                 }
 
-                index_buffer_allocator_impl(const gpu_virtual_address address, uint64_t size ) :
-                    m_allocator(details::get_index_count(size, m_stride))
+                index_buffer_allocator_impl(const gpu_virtual_address address, uint64_t size, index_format format ) :
+                    m_format(format)
+                    , m_allocator(details::get_index_count(size, index_stride(format)))
                 {
                     m_address = address;
                     m_size = size;
@@ -54,14 +56,19 @@ namespace uc
 
             template uc::util::details::pimpl<index_buffer_allocator::index_buffer_allocator_impl>;
 
-            index_buffer_allocator::index_buffer_allocator(const gpu_virtual_address address, uint64_t size) : m_impl(address, size)
+            index_buffer_allocator::index_buffer_allocator(const gpu_virtual_address address, uint64_t size, index_format format) : m_impl(address, size, format)
             {
 
             }
 
+            index_format index_buffer_allocator::format() const
+            {
+                return m_impl->m_format;
+            }
+
             uint32_t index_buffer_allocator::stride() const
             {
-                return static_cast<uint32_t>(m_impl->m_stride);
+                return index_stride(m_impl->m_format);
             }
 
             uint32_t index_buffer_allocator::size() const
@@ -75,13 +82,13 @@ namespace uc
 
             index_buffer_view  index_buffer_allocator::view( ) const
             {
-                return details::make_view(address(), size());
+                return details::make_view(address(), size(), format());
             }
 
             index_buffer_allocator::allocation* index_buffer_allocator::allocate(uint32_t vertex_count)
             {
                 auto r = m_impl->m_allocator.allocate(vertex_count);
-                return new index_buffer_allocator::allocation(r->count(), r->offset(), r);
+                return new index_buffer_allocator::allocation(r->count(), r->offset(), r, m_impl->m_format);
             }
 
             void index_buffer_allocator::free(index_buffer_allocator::allocation* free)
@@ -96,7 +103,7 @@ namespace uc
             void index_buffer_allocator::sync()
             {
                 m_impl->m_frame_index += 1;
-                m_impl->m_frame_index %= 3;
+                m_impl->m_frame_index %= dx12::max_frames_in_flight;
 
                 for (auto&& i : m_impl->m_pending_deletes[m_impl->m_frame_index])
                 {
@@ -105,10 +112,11 @@ namespace uc
                 m_impl->m_pending_deletes[m_impl->m_frame_index].resize(0);
             }
 
-            index_buffer_allocator::allocation::allocation(uint32_t index_count, uint32_t index_offset, void* opaque_handle) :
+            index_buffer_allocator::allocation::allocation(uint32_t index_count, uint32_t index_offset, void* opaque_handle, index_format format) :
                 m_index_count(index_count)
                 , m_index_offset(index_offset)
                 , m_opaque_handle(opaque_handle)
+                , m_format(format)
             {
 
             }
@@ -128,16 +136,19 @@ namespace uc
                 return m_index_offset;
             }
 
+            index_format index_buffer_allocator::allocation::format() const
+            {
+                return m_format;
+            }
+
             uint32_t index_buffer_allocator::allocation::byte_size() const
             {
-                uint32_t stride = 4;
-                return index_count() * stride;
+                return index_count() * index_stride(m_format);
             }
 
             uint32_t index_buffer_allocator::allocation::byte_offset() const
             {
-                uint32_t stride = 4;
-                return index_offset() * stride;
+                return index_offset() * index_stride(m_format);
             }
         }
     }
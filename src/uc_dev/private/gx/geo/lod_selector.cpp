@@ -0,0 +1,47 @@
+#include "pch.h"
+
+#include <uc_dev/gx/geo/lod_selector.h>
+
+#include <cmath>
+#include <limits>
+
+#include <uc_dev/gx/lip/model.h>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace geo
+        {
+            float lod_screen_size(float radius, float distance, float fov_y)
+            {
+                if (distance <= radius)
+                {
+                    return std::numeric_limits<float>::max();
+                }
+
+                return radius / (distance * std::tan(fov_y * 0.5f));
+            }
+
+            uint32_t select_lod(const lip::lod_chain& lods, float screen_size, float bias)
+            {
+                const float s = screen_size / bias;
+
+                uint32_t r = 0;
+
+                //the screen sizes of the levels decrease, take the coarsest, which is still allowed
+                for (auto i = 0U; i < lods.m_levels.size(); ++i)
+                {
+                    if (s > lods.m_levels[i].m_screen_size)
+                    {
+                        break;
+                    }
+
+                    r = i + 1;
+                }
+
+                return r;
+            }
+        }
+    }
+}
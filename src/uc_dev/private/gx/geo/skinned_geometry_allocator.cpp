@@ -12,34 +12,40 @@ namespace uc
         {
             namespace details
             {
-                static inline uint32_t make_positions_size( uint32_t vertex_count )
+                template <typename default_stride, typename packed_stride>
+                static inline uint32_t make_size(uint32_t vertex_count, vertex_layout layout)
                 {
-                    return vertex_count * default_geometry_position::stride::value;
+                    return vertex_count * (layout == vertex_layout::packed ? static_cast<uint32_t>(packed_stride::value) : static_cast<uint32_t>(default_stride::value));
                 }
 
-                static inline uint32_t make_uv_size(uint32_t vertex_count)
+                static inline uint32_t make_positions_size( uint32_t vertex_count, vertex_layout layout)
                 {
-                    return vertex_count * default_geometry_uv::stride::value;
+                    return make_size<default_geometry_position::stride, packed_geometry_position::stride>(vertex_count, layout);
                 }
 
-                static inline uint32_t make_normal_size(uint32_t vertex_count)
+                static inline uint32_t make_uv_size(uint32_t vertex_count, vertex_layout layout)
                 {
-                    return vertex_count * default_geometry_normal::stride::value;
+                    return make_size<default_geometry_uv::stride, packed_geometry_uv::stride>(vertex_count, layout);
                 }
 
-                static inline uint32_t make_tangent_size(uint32_t vertex_count)
+                static inline uint32_t make_normal_size(uint32_t vertex_count, vertex_layout layout)
                 {
-                    return vertex_count * default_geometry_tangent::stride::value;
+                    return make_size<default_geometry_normal::stride, packed_geometry_normal::stride>(vertex_count, layout);
                 }
 
-                static inline uint32_t make_blend_weight_size(uint32_t vertex_count)
+                static inline uint32_t make_tangent_size(uint32_t vertex_count, vertex_layout layout)
                 {
-                    return vertex_count * default_geometry_blend_weight::stride::value;
+                    return make_size<default_geometry_tangent::stride, packed_geometry_tangent::stride>(vertex_count, layout);
                 }
 
-                static inline uint32_t make_blend_index_size(uint32_t vertex_count)
+                static inline uint32_t make_blend_weight_size(uint32_t vertex_count, vertex_layout layout)
                 {
-                    return vertex_count * default_geometry_blend_index::stride::value;
+                    return make_size<default_geometry_blend_weight::stride, packed_geometry_blend_weight::stride>(vertex_count, layout);
+                }
+
+                static inline uint32_t make_blend_index_size(uint32_t vertex_count, vertex_layout layout)
+                {
+                    return make_size<default_geometry_blend_index::stride, packed_geometry_blend_index::stride>(vertex_count, layout);
                 }
 
                 static inline uint32_t make_index_size(uint32_t index_count)
@@ -53,10 +59,13 @@ namespace uc
                     const dx12::gpu_buffer* normal,
                     const dx12::gpu_buffer* tangent,
                     const dx12::gpu_buffer* blend_weight,
-                    const dx12::gpu_buffer* blend_index)
+                    const dx12::gpu_buffer* blend_index,
+                    vertex_layout           layout)
                 {
                     skinned_meshes_allocator::allocator_addresses r;
 
+                    r.m_layout = layout;
+
                     {
                         r.m_positions       = positions->virtual_address();
                         r.m_positions_size  = static_cast<uint32_t>(size(positions));
@@ -91,14 +100,14 @@ namespace uc
                 }
             }
 
-            skinned_geometry_allocator::skinned_geometry_allocator(dx12::gpu_resource_create_context* rc, uint32_t vertex_count) :
-            m_skinned_mesh_position (dx12::create_buffer(rc, details::make_positions_size( vertex_count)))
-            , m_skinned_mesh_uv(dx12::create_buffer(rc, details::make_uv_size(vertex_count)))
-            , m_skinned_mesh_normal(dx12::create_buffer(rc, details::make_normal_size(vertex_count)))
-            , m_skinned_mesh_tangent(dx12::create_buffer(rc, details::make_tangent_size(vertex_count)))
-            , m_skinned_mesh_blend_weight(dx12::create_buffer(rc, details::make_blend_weight_size(vertex_count)))
-            , m_skinned_mesh_blend_index(dx12::create_buffer(rc, details::make_blend_index_size(vertex_count)))
-            , m_skinned_meshes(details::make_skinned_addresses( m_skinned_mesh_position.get(), m_skinned_mesh_uv.get(), m_skinned_mesh_normal.get(), m_skinned_mesh_tangent.get(), m_skinned_mesh_blend_weight.get(), m_skinned_mesh_blend_index.get()))
+            skinned_geometry_allocator::skinned_geometry_allocator(dx12::gpu_resource_create_context* rc, uint32_t vertex_count, vertex_layout layout) :
+            m_skinned_mesh_position (dx12::create_buffer(rc, details::make_positions_size( vertex_count, layout)))
+            , m_skinned_mesh_uv(dx12::create_buffer(rc, details::make_uv_size(vertex_count, layout)))
+            , m_skinned_mesh_normal(dx12::create_buffer(rc, details::make_normal_size(vertex_count, layout)))
+            , m_skinned_mesh_tangent(dx12::create_buffer(rc, details::make_tangent_size(vertex_count, layout)))
+            , m_skinned_mesh_blend_weight(dx12::create_buffer(rc, details::make_blend_weight_size(vertex_count, layout)))
+            , m_skinned_mesh_blend_index(dx12::create_buffer(rc, details::make_blend_index_size(vertex_count, layout)))
+            , m_skinned_meshes(details::make_skinned_addresses( m_skinned_mesh_position.get(), m_skinned_mesh_uv.get(), m_skinned_mesh_normal.get(), m_skinned_mesh_tangent.get(), m_skinned_mesh_blend_weight.get(), m_skinned_mesh_blend_index.get(), layout))
             {
 
             }
@@ -173,6 +182,11 @@ namespace uc
                 return m_skinned_meshes.view(gx::geo::skinned_meshes_allocator::component::blend_index);
             }
 
+            vertex_layout skinned_geometry_allocator::layout() const
+            {
+                return m_skinned_meshes.layout();
+            }
+
             void skinned_geometry_allocator::sync()
             {
                 m_skinned_meshes.sync();
@@ -16,7 +16,7 @@ namespace uc
         {
             managed_skinned_mesh_geometry create_skinned_mesh(geometry_allocator* rc, gx::dx12::gpu_upload_queue* upload_queue, gsl::span<const gsl::byte> positions, gsl::span<const gsl::byte> uv, gsl::span<const gsl::byte> normals, gsl::span<const gsl::byte> tangents,  gsl::span<const gsl::byte> blend_weight, gsl::span<const gsl::byte> blend_index)
             {
-                size_t vertex_count = positions.size() / 12;    //stride
+                size_t vertex_count = positions.size() / rc->skinned_mesh_position_view().StrideInBytes;    //12 or 8 bytes, depends on the layout
 
                 managed_skinned_mesh_geometry r = make_managed_skinned_mesh_geometry(rc, vertex_count);
 
@@ -30,13 +30,13 @@ namespace uc
                 return r;
             }
 
-            managed_indexed_geometry create_indexed_geometry(geometry_allocator* rc, gx::dx12::gpu_upload_queue* upload_queue, gsl::span<const gsl::byte> indices)
+            managed_indexed_geometry create_indexed_geometry(geometry_allocator* rc, gx::dx12::gpu_upload_queue* upload_queue, gsl::span<const gsl::byte> indices, index_format format)
             {
-                size_t index_count = indices.size() / 4;    //stride
+                size_t index_count = indices.size() / index_stride(format);
 
-                managed_indexed_geometry r = make_managed_indexed_geometry(rc, index_count);
+                managed_indexed_geometry r = make_managed_indexed_geometry(rc, index_count, format);
 
-                upload_queue->upload_buffer(rc->indices(), &indices[0], indices.size(), r->byte_offset());
+                upload_queue->upload_buffer(rc->indices(format), &indices[0], indices.size(), r->byte_offset());
 
                 return r;
             }
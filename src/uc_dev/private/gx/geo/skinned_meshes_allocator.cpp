@@ -4,6 +4,7 @@
 #include <vector>
 #include <uc_dev/util/pimpl_impl.h>
 #include <uc_dev/gx/geo/vertex_allocator.h>
+#include <uc_dev/gx/dx12/gpu/frames_in_flight.h>
 
 namespace uc
 {
@@ -44,12 +45,13 @@ namespace uc
                         default_geometry_tangent::stride::value,
                         default_geometry_blend_weight::stride::value, 
                         default_geometry_blend_index::stride::value };
+                    vertex_layout       m_layout = vertex_layout::default_layout;
                 };
 
                 allocator_views                         m_views;
                 vertex_allocator                        m_allocator;
                 uint32_t                                m_frame_index = 0;
-                std::vector<vertex_allocator::handle>   m_pending_deletes[3];
+                std::vector<vertex_allocator::handle>   m_pending_deletes[dx12::max_frames_in_flight];
 
                 skinned_meshes_allocator_impl() : m_allocator(0)
                 {
@@ -84,6 +86,18 @@ namespace uc
                     r.m_sizes[static_cast<uint32_t>(skinned_meshes_allocator::component::blend_weight)] = options.m_blend_weights_size;
                     r.m_sizes[static_cast<uint32_t>(skinned_meshes_allocator::component::blend_index)] = options.m_blend_indices_size;
 
+                    r.m_layout = options.m_layout;
+
+                    if (options.m_layout == vertex_layout::packed)
+                    {
+                        r.m_strides[static_cast<uint32_t>(skinned_meshes_allocator::component::position)] = packed_geometry_position::stride::value;
+                        r.m_strides[static_cast<uint32_t>(skinned_meshes_allocator::component::uv)] = packed_geometry_uv::stride::value;
+                        r.m_strides[static_cast<uint32_t>(skinned_meshes_allocator::component::normal)] = packed_geometry_normal::stride::value;
+                        r.m_strides[static_cast<uint32_t>(skinned_meshes_allocator::component::tangent)] = packed_geometry_tangent::stride::value;
+                        r.m_strides[static_cast<uint32_t>(skinned_meshes_allocator::component::blend_weight)] = packed_geometry_blend_weight::stride::value;
+                        r.m_strides[static_cast<uint32_t>(skinned_meshes_allocator::component::blend_index)] = packed_geometry_blend_index::stride::value;
+                    }
+
                     return r;
                 }
             }
@@ -98,6 +112,11 @@ namespace uc
                 return static_cast<uint32_t>(m_impl->m_views.m_strides[static_cast<uint32_t>(c)]);
             }
 
+            vertex_layout skinned_meshes_allocator::layout() const
+            {
+                return m_impl->m_views.m_layout;
+            }
+
             uint32_t skinned_meshes_allocator::size(skinned_meshes_allocator::component c) const
             {
                 return static_cast<uint32_t>(m_impl->m_views.m_sizes[static_cast<uint32_t>(c)]);
@@ -130,7 +149,7 @@ namespace uc
             void skinned_meshes_allocator::sync()
             {
                 m_impl->m_frame_index += 1;
-                m_impl->m_frame_index %= 3;
+                m_impl->m_frame_index %= dx12::max_frames_in_flight;
 
                 for (auto&& i : m_impl->m_pending_deletes[m_impl->m_frame_index])
                 {
@@ -175,30 +194,12 @@ namespace uc
 
             uint32_t skinned_meshes_allocator::allocation::byte_size(skinned_meshes_allocator::component c) const
             {
-                uint32_t strides[] =
-                { 
-                    default_geometry_position::stride::value, 
-                    default_geometry_uv::stride::value, 
-                    default_geometry_normal::stride::value,
-                    default_geometry_tangent::stride::value,
-                    default_geometry_blend_weight::stride::value, 
-                    default_geometry_blend_index::stride::value
-                };
-                return draw_count() * strides[static_cast<uint32_t>(c)];
+                return draw_count() * m_allocator->stride(c);
             }
 
             uint32_t skinned_meshes_allocator::allocation::byte_offset(skinned_meshes_allocator::component c) const
             {
-                uint32_t strides[] =
-                {
-                    default_geometry_position::stride::value,
-                    default_geometry_uv::stride::value,
-                    default_geometry_normal::stride::value,
-                    default_geometry_tangent::stride::value,
-                    default_geometry_blend_weight::stride::value,
-                    default_geometry_blend_index::stride::value
-                };
-                return draw_offset() * strides[static_cast<uint32_t>(c)];
+                return draw_offset() * m_allocator->stride(c);
             }
         }
     }
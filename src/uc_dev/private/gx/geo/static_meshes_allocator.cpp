@@ -4,6 +4,7 @@
 #include <vector>
 #include <uc_dev/util/pimpl_impl.h>
 #include <uc_dev/gx/geo/vertex_allocator.h>
+#include <uc_dev/gx/dx12/gpu/frames_in_flight.h>
 
 namespace uc
 {
@@ -42,7 +43,7 @@ namespace uc
                 allocator_views                         m_views;
                 vertex_allocator                        m_allocator;
                 uint32_t                                m_frame_index = 0;
-                std::vector<vertex_allocator::handle>   m_pending_deletes[3];
+                std::vector<vertex_allocator::handle>   m_pending_deletes[dx12::max_frames_in_flight];
 
                 static_meshes_allocator_impl() : m_allocator(0)
                 {
@@ -114,7 +115,7 @@ namespace uc
             void static_meshes_allocator::sync()
             {
                 m_impl->m_frame_index += 1;
-                m_impl->m_frame_index %= 3;
+                m_impl->m_frame_index %= dx12::max_frames_in_flight;
 
                 for (auto&& i : m_impl->m_pending_deletes[m_impl->m_frame_index])
                 {
@@ -37,6 +37,11 @@ namespace uc
             LIP_RTTI_MEMBER(joint_linkage, m_parent)
             LIP_END_DEFINE_RTTI(joint_linkage)
 
+            LIP_BEGIN_DEFINE_RTTI(joint_bounding_volume)
+            LIP_RTTI_MEMBER(joint_bounding_volume, m_center)
+            LIP_RTTI_MEMBER(joint_bounding_volume, m_radius)
+            LIP_END_DEFINE_RTTI(joint_bounding_volume)
+
             LIP_BEGIN_DEFINE_RTTI(skeleton)
             LIP_RTTI_MEMBER(skeleton, m_joint_inverse_bind_pose)
             LIP_RTTI_MEMBER(skeleton, m_joint_inverse_bind_pose2)
@@ -48,6 +53,7 @@ namespace uc
             LIP_RTTI_MEMBER(skeleton, m_locomotion_joint_index)
             LIP_RTTI_MEMBER(skeleton, m_joint_local_transforms2)
             LIP_RTTI_MEMBER(skeleton, m_joint_linkage2)
+            LIP_RTTI_MEMBER(skeleton, m_joint_bounding_volumes)
             LIP_END_DEFINE_RTTI(skeleton)
 
             LIP_BEGIN_DEFINE_RTTI(joint_animation)
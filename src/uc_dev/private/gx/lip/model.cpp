@@ -9,6 +9,8 @@ namespace uc
     {
         LIP_BEGIN_DEFINE_RTTI(indices)
             LIP_RTTI_MEMBER(indices, m_data)
+            LIP_RTTI_MEMBER(indices, m_data_16)
+            LIP_RTTI_MEMBER(indices, m_format)
         LIP_END_DEFINE_RTTI(indices)
 
         LIP_BEGIN_DEFINE_RTTI(positions)
@@ -93,22 +95,65 @@ namespace uc
             LIP_RTTI_MEMBER(primitive_range, m_end)
         LIP_END_DEFINE_RTTI(primitive_range)
 
+        LIP_BEGIN_DEFINE_RTTI(meshlet)
+            LIP_RTTI_MEMBER(meshlet, m_vertex_offset)
+            LIP_RTTI_MEMBER(meshlet, m_triangle_offset)
+            LIP_RTTI_MEMBER(meshlet, m_vertex_count)
+            LIP_RTTI_MEMBER(meshlet, m_triangle_count)
+        LIP_END_DEFINE_RTTI(meshlet)
+
+        LIP_BEGIN_DEFINE_RTTI(meshlet_bounds)
+            LIP_RTTI_MEMBER(meshlet_bounds, m_center)
+            LIP_RTTI_MEMBER(meshlet_bounds, m_radius)
+            LIP_RTTI_MEMBER(meshlet_bounds, m_cone_axis)
+            LIP_RTTI_MEMBER(meshlet_bounds, m_cone_cutoff)
+        LIP_END_DEFINE_RTTI(meshlet_bounds)
+
+        LIP_BEGIN_DEFINE_RTTI(meshlets)
+            LIP_RTTI_MEMBER(meshlets, m_meshlets)
+            LIP_RTTI_MEMBER(meshlets, m_bounds)
+            LIP_RTTI_MEMBER(meshlets, m_ranges)
+            LIP_RTTI_MEMBER(meshlets, m_vertices)
+            LIP_RTTI_MEMBER(meshlets, m_triangles)
+        LIP_END_DEFINE_RTTI(meshlets)
+
+        LIP_BEGIN_DEFINE_RTTI(lod_level)
+            LIP_RTTI_MEMBER(lod_level, m_range_offset)
+            LIP_RTTI_MEMBER(lod_level, m_triangle_count)
+            LIP_RTTI_MEMBER(lod_level, m_error)
+            LIP_RTTI_MEMBER(lod_level, m_screen_size)
+        LIP_END_DEFINE_RTTI(lod_level)
+
+        LIP_BEGIN_DEFINE_RTTI(lod_chain)
+            LIP_RTTI_MEMBER(lod_chain, m_indices)
+            LIP_RTTI_MEMBER(lod_chain, m_levels)
+            LIP_RTTI_MEMBER(lod_chain, m_ranges)
+            LIP_RTTI_MEMBER(lod_chain, m_center)
+            LIP_RTTI_MEMBER(lod_chain, m_radius)
+        LIP_END_DEFINE_RTTI(lod_chain)
+
         LIP_BEGIN_DEFINE_RTTI(multi_textured_model)
             LIP_RTTI_BASE_CLASS(parametrized_model)
             LIP_RTTI_MEMBER(multi_textured_model, m_textures)
             LIP_RTTI_MEMBER(multi_textured_model, m_primitive_ranges)
+            LIP_RTTI_MEMBER(multi_textured_model, m_meshlets)
+            LIP_RTTI_MEMBER(multi_textured_model, m_lods)
         LIP_END_DEFINE_RTTI(multi_textured_model)
 
         LIP_BEGIN_DEFINE_RTTI(normal_multi_textured_model)
             LIP_RTTI_BASE_CLASS(normal_parametrized_model)
             LIP_RTTI_MEMBER(normal_multi_textured_model, m_textures)
             LIP_RTTI_MEMBER(normal_multi_textured_model, m_primitive_ranges)
+            LIP_RTTI_MEMBER(normal_multi_textured_model, m_meshlets)
+            LIP_RTTI_MEMBER(normal_multi_textured_model, m_lods)
         LIP_END_DEFINE_RTTI(normal_multi_textured_model)
 
         LIP_BEGIN_DEFINE_RTTI(derivatives_multi_textured_model)
             LIP_RTTI_BASE_CLASS(derivatives_parametrized_model)
             LIP_RTTI_MEMBER(derivatives_multi_textured_model, m_textures)
             LIP_RTTI_MEMBER(derivatives_multi_textured_model, m_primitive_ranges)
+            LIP_RTTI_MEMBER(derivatives_multi_textured_model, m_meshlets)
+            LIP_RTTI_MEMBER(derivatives_multi_textured_model, m_lods)
         LIP_END_DEFINE_RTTI(derivatives_multi_textured_model)
 
         LIP_BEGIN_DEFINE_RTTI(skinned_model)
@@ -128,6 +173,22 @@ namespace uc
             LIP_RTTI_MEMBER(derivatives_skinned_model, m_blend_weights)
             LIP_RTTI_MEMBER(derivatives_skinned_model, m_blend_indices)
         LIP_END_DEFINE_RTTI(derivatives_skinned_model)
+
+        LIP_BEGIN_DEFINE_RTTI(packed_skinned_model)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_indices)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_positions)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_uv)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_normals)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_tangents)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_blend_weights)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_blend_indices)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_textures)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_primitive_ranges)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_meshlets)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_lods)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_position_min)
+            LIP_RTTI_MEMBER(packed_skinned_model, m_position_extent)
+        LIP_END_DEFINE_RTTI(packed_skinned_model)
         
     }
 }
\ No newline at end of file
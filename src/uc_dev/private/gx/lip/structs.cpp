@@ -45,6 +45,23 @@ namespace uc
                 LIP_RTTI_MEMBER(uint4, m_w)
             LIP_END_DEFINE_RTTI(uint4)
 
+            LIP_BEGIN_DEFINE_RTTI(ushort4)
+                LIP_RTTI_MEMBER(ushort4, m_x)
+                LIP_RTTI_MEMBER(ushort4, m_y)
+                LIP_RTTI_MEMBER(ushort4, m_z)
+                LIP_RTTI_MEMBER(ushort4, m_w)
+            LIP_END_DEFINE_RTTI(ushort4)
+
+            LIP_BEGIN_DEFINE_RTTI(short2)
+                LIP_RTTI_MEMBER(short2, m_x)
+                LIP_RTTI_MEMBER(short2, m_y)
+            LIP_END_DEFINE_RTTI(short2)
+
+            LIP_BEGIN_DEFINE_RTTI(half2)
+                LIP_RTTI_MEMBER(half2, m_x)
+                LIP_RTTI_MEMBER(half2, m_y)
+            LIP_END_DEFINE_RTTI(half2)
+
             LIP_BEGIN_DEFINE_RTTI(float8a)
 
                 LIP_RTTI_MEMBER(float8a, m_x)
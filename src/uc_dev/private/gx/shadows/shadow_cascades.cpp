@@ -0,0 +1,245 @@
+#include "pch.h"
+
+#include <uc_dev/gx/shadows/shadow_cascades.h>
+#include <uc_dev/math/geometry_convex_clipping.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace uc
+{
+    namespace gx
+    {
+        namespace shadows
+        {
+            namespace
+            {
+                struct bounds
+                {
+                    float m_min[3];
+                    float m_max[3];
+                };
+
+                bounds make_bounds(const math::float4* points, uint32_t count, math::afloat4x4 m)
+                {
+                    const float v = std::numeric_limits<float>::max();
+                    bounds r = { { v, v, v }, { -v, -v, -v } };
+
+                    for (auto i = 0U; i < count; ++i)
+                    {
+                        alignas(16) float p[4];
+                        math::store4(&p[0], math::transform3(points[i], m));
+
+                        for (auto j = 0U; j < 3; ++j)
+                        {
+                            r.m_min[j] = std::min(r.m_min[j], p[j]);
+                            r.m_max[j] = std::max(r.m_max[j], p[j]);
+                        }
+                    }
+
+                    return r;
+                }
+
+                //radius of the sphere around the frustum slice, does not change when the camera rotates
+                float bounding_radius(const math::frustum_points& f)
+                {
+                    math::float4 center = math::zero();
+
+                    for (auto&& p : f.m_points)
+                    {
+                        center = math::add(center, p);
+                    }
+
+                    center = math::mul(center, 1.0f / f.m_points.size());
+
+                    float r = 0.0f;
+
+                    for (auto&& p : f.m_points)
+                    {
+                        r = std::max(r, math::get_x(math::length3(math::sub(p, center))));
+                    }
+
+                    //round up, so the size does not flicker with the float precision
+                    return std::ceil(r * 16.0f) / 16.0f;
+                }
+
+                void make_empty(shadow_cascade& c)
+                {
+                    c.m_camera.set_x_min(-1.0f);
+                    c.m_camera.set_x_max(1.0f);
+                    c.m_camera.set_y_min(-1.0f);
+                    c.m_camera.set_y_max(1.0f);
+                    c.m_camera.set_z_min(1.0f);
+                    c.m_camera.set_z_max(0.0f);
+
+                    c.m_view        = view_matrix(c.m_camera);
+                    c.m_projection  = perspective_matrix(c.m_camera);
+                    c.m_texel_size  = 0.0f;
+                    c.m_empty       = true;
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void make_split_distances(float near_plane, float far_plane, const cascade_settings& s, float* splits)
+            {
+                const uint32_t count = s.m_cascade_count;
+
+                const float lambda = s.m_split_scheme == split_scheme::uniform ? 0.0f : s.m_split_scheme == split_scheme::logarithmic ? 1.0f : s.m_split_lambda;
+
+                splits[0]       = near_plane;
+                splits[count]   = far_plane;
+
+                for (auto i = 1U; i < count; ++i)
+                {
+                    const float t           = static_cast<float>(i) / count;
+                    const float uniform     = near_plane + (far_plane - near_plane) * t;
+                    const float logarithmic = near_plane * std::pow(far_plane / near_plane, t);
+
+                    splits[i] = uniform + (logarithmic - uniform) * lambda;
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            math::frustum_points make_frustum_points(const pinhole_camera* camera, float near_plane, float far_plane)
+            {
+                using namespace math;
+
+                const float4 forward    = normalize3(camera->forward());
+                const float4 right      = normalize3(cross3(camera->up(), forward));
+                const float4 up         = cross3(forward, right);
+                const float4 position   = camera->position();
+
+                const float  tan_half   = std::tan(camera->fov() * 0.5f);
+
+                frustum_points r;
+
+                auto slice = [&](float d, uint32_t down_left, uint32_t down_right, uint32_t up_right, uint32_t up_left)
+                {
+                    const float4 center = mad(forward, splat(d), position);
+                    const float4 h      = mul(up, d * tan_half);
+                    const float4 w      = mul(right, d * tan_half * camera->aspect_ratio());
+
+                    r.m_points[down_left]   = sub(sub(center, w), h);
+                    r.m_points[down_right]  = sub(add(center, w), h);
+                    r.m_points[up_right]    = add(add(center, w), h);
+                    r.m_points[up_left]     = add(sub(center, w), h);
+                };
+
+                slice(near_plane, frustum_points::near_down_left, frustum_points::near_down_right, frustum_points::near_up_right, frustum_points::near_up_left);
+                slice(far_plane, frustum_points::far_down_left, frustum_points::far_down_right, frustum_points::far_up_right, frustum_points::far_up_left);
+
+                return r;
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void build_cascades(const pinhole_camera* camera, const math::aabb& scene, math::afloat4 light_direction, const cascade_settings& s, shadow_cascades& r)
+            {
+                using namespace math;
+
+                assert(s.m_cascade_count > 0 && s.m_cascade_count <= shadow_cascades::max_cascades);
+
+                float splits[shadow_cascades::max_cascades + 1];
+                make_split_distances(camera->get_near(), camera->get_far(), s, &splits[0]);
+
+                //the light space origin is fixed in the world, so the texel snapping is stable when the camera moves
+                const float4 forward    = normalize3(negate(light_direction));
+                const float4 up         = normalize3(orthogonal3_vector(forward));
+                const float4x4 light_view = view(point3(0.0f, 0.0f, 0.0f), forward, up);
+
+                //the scene box in light space does not move with the camera either, far cascades and small scenes use it instead of the slice sphere
+                const std::array<float4, 8> scene_points = make_points(scene);
+                const bounds scene_ls       = make_bounds(scene_points.data(), static_cast<uint32_t>(scene_points.size()), light_view);
+                const float  scene_extent   = std::max(scene_ls.m_max[0] - scene_ls.m_min[0], scene_ls.m_max[1] - scene_ls.m_min[1]);
+
+                r.m_count = s.m_cascade_count;
+
+                for (auto i = 0U; i < s.m_cascade_count; ++i)
+                {
+                    shadow_cascade& c = r.m_cascades[i];
+
+                    c.m_split_near  = splits[i];
+                    c.m_split_far   = splits[i + 1];
+                    c.m_empty       = false;
+
+                    c.m_camera.set_view_position(point3(0.0f, 0.0f, 0.0f));
+                    c.m_camera.set_forward(forward);
+                    c.m_camera.set_up(up);
+
+                    const frustum_points slice = make_frustum_points(camera, c.m_split_near, c.m_split_far);
+
+                    //receivers: the slice inside the scene, casters: the receivers extruded towards the light
+                    convex_clipping::convex_hull_cache& hull = r.m_hulls[i];
+                    hull.set_tolerance(s.m_hull_tolerance);
+
+                    const convex_clipping::fixed_convex_polyhedron* casters = hull.convex_hull_with_direction(slice, scene, light_direction);
+
+                    if (casters == nullptr)
+                    {
+                        make_empty(c);
+                        continue;
+                    }
+
+                    const convex_clipping::fixed_convex_polyhedron& receivers = hull.clipped();
+
+                    const bounds receivers_ls   = make_bounds(receivers.m_points.data(), receivers.m_point_count, light_view);
+                    const bounds casters_ls     = make_bounds(casters->m_points.data(), casters->m_point_count, light_view);
+
+                    const float resolution = static_cast<float>(s.m_resolution);
+
+                    float x_min;
+                    float y_min;
+                    float extent_x;
+                    float extent_y;
+
+                    if (s.m_stabilize && scene_extent <= 2.0f * bounding_radius(slice))
+                    {
+                        //the scene is the tighter of the two bounds that do not move with the camera, its window is fixed, so there is nothing to snap
+                        x_min       = scene_ls.m_min[0];
+                        y_min       = scene_ls.m_min[1];
+                        extent_x    = scene_ls.m_max[0] - x_min;
+                        extent_y    = scene_ls.m_max[1] - y_min;
+                        c.m_texel_size = scene_extent / resolution;
+                    }
+                    else if (s.m_stabilize)
+                    {
+                        //one texel is reserved for the snapping, so the receivers stay covered
+                        const float extent  = 2.0f * bounding_radius(slice);
+                        const float texel   = extent / (resolution - 1.0f);
+
+                        const float center_x = (receivers_ls.m_min[0] + receivers_ls.m_max[0]) * 0.5f;
+                        const float center_y = (receivers_ls.m_min[1] + receivers_ls.m_max[1]) * 0.5f;
+
+                        x_min       = std::floor((center_x - extent * 0.5f) / texel) * texel;
+                        y_min       = std::floor((center_y - extent * 0.5f) / texel) * texel;
+                        extent_x    = texel * resolution;
+                        extent_y    = texel * resolution;
+                        c.m_texel_size = texel;
+                    }
+                    else
+                    {
+                        const float texel = std::max(receivers_ls.m_max[0] - receivers_ls.m_min[0], receivers_ls.m_max[1] - receivers_ls.m_min[1]) / (resolution - 1.0f);
+
+                        x_min       = std::floor(receivers_ls.m_min[0] / texel) * texel;
+                        y_min       = std::floor(receivers_ls.m_min[1] / texel) * texel;
+                        extent_x    = std::ceil((receivers_ls.m_max[0] - x_min) / texel) * texel;
+                        extent_y    = std::ceil((receivers_ls.m_max[1] - y_min) / texel) * texel;
+                        c.m_texel_size = texel;
+                    }
+
+                    c.m_camera.set_x_min(x_min);
+                    c.m_camera.set_x_max(x_min + extent_x);
+                    c.m_camera.set_y_min(y_min);
+                    c.m_camera.set_y_max(y_min + extent_y);
+
+                    //reversed depth
+                    c.m_camera.set_z_min(casters_ls.m_max[2]);
+                    c.m_camera.set_z_max(casters_ls.m_min[2]);
+
+                    c.m_view        = view_matrix(c.m_camera);
+                    c.m_projection  = perspective_matrix(c.m_camera);
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
@@ -0,0 +1,164 @@
+#include "pch.h"
+
+#include <uc_dev/math/batch.h>
+#include <uc_dev/sys/cpu_features.h>
+
+namespace uc
+{
+    namespace math
+    {
+        namespace details
+        {
+            //the sse kernels are the single value functions in a loop, they also finish the tails of the wide kernels
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void mul_sse(const float4x4* a, const float4x4* b, float4x4* r, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    r[i] = mul(a[i], b[i]);
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void mul_broadcast_sse(const float4x4* a, const float4x4* b, float4x4* r, size_t count)
+            {
+                const float4x4 m = *b;
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    r[i] = mul(a[i], m);
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void quaternion_2_matrix_sse(const float4* q, float4x4* r, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    r[i] = math::quaternion_2_matrix(q[i]);
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void transform3_sse(const float4* v, const float4x4* m, float4* r, size_t count, bool vector)
+            {
+                float4x4 t = *m;
+
+                if (vector)
+                {
+                    t.r[3] = zero();
+                }
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    r[i] = math::transform3(v[i], t);
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void slerp_sse(const float4* a, const float4* b, const float* t, float4* r, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    r[i] = math::slerp(a[i], b[i], splat(t[i]));
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        void mul(const float4x4* a, const float4x4* b, float4x4* r, size_t count)
+        {
+            if (sys::is_avx512_supported())
+            {
+                details::mul_avx512(a, b, r, count);
+            }
+            else if (sys::is_avx2_supported())
+            {
+                details::mul_avx2(a, b, r, count);
+            }
+            else
+            {
+                details::mul_sse(a, b, r, count);
+            }
+        }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        void mul(const float4x4* a, afloat4x4 b, float4x4* r, size_t count)
+        {
+            const float4x4 m = b;
+
+            if (sys::is_avx512_supported())
+            {
+                details::mul_broadcast_avx512(a, &m, r, count);
+            }
+            else if (sys::is_avx2_supported())
+            {
+                details::mul_broadcast_avx2(a, &m, r, count);
+            }
+            else
+            {
+                details::mul_broadcast_sse(a, &m, r, count);
+            }
+        }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        void quaternion_2_matrix(const float4* q, float4x4* r, size_t count)
+        {
+            if (sys::is_avx512_supported())
+            {
+                details::quaternion_2_matrix_avx512(q, r, count);
+            }
+            else if (sys::is_avx2_supported())
+            {
+                details::quaternion_2_matrix_avx2(q, r, count);
+            }
+            else
+            {
+                details::quaternion_2_matrix_sse(q, r, count);
+            }
+        }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        namespace
+        {
+            void transform3(const float4* v, afloat4x4 m, float4* r, size_t count, bool vector)
+            {
+                const float4x4 t = m;
+
+                if (sys::is_avx512_supported())
+                {
+                    details::transform3_avx512(v, &t, r, count, vector);
+                }
+                else if (sys::is_avx2_supported())
+                {
+                    details::transform3_avx2(v, &t, r, count, vector);
+                }
+                else
+                {
+                    details::transform3_sse(v, &t, r, count, vector);
+                }
+            }
+        }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        void transform3(const float4* v, afloat4x4 m, float4* r, size_t count)
+        {
+            transform3(v, m, r, count, false);
+        }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        void transform3_vector(const float4* v, afloat4x4 m, float4* r, size_t count)
+        {
+            transform3(v, m, r, count, true);
+        }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        void slerp(const float4* a, const float4* b, const float* t, float4* r, size_t count)
+        {
+            if (sys::is_avx512_supported())
+            {
+                details::slerp_avx512(a, b, t, r, count);
+            }
+            else if (sys::is_avx2_supported())
+            {
+                details::slerp_avx2(a, b, t, r, count);
+            }
+            else
+            {
+                details::slerp_sse(a, b, t, r, count);
+            }
+        }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+}
@@ -0,0 +1,285 @@
+#include "pch.h"
+
+#include <uc_dev/math/batch.h>
+
+namespace uc
+{
+    namespace math
+    {
+        namespace details
+        {
+            namespace
+            {
+                //transposes 4x4 blocks in every 128 bit lane. with a, b, c, d loaded from 8 consecutive float4,
+                //lane j, element k of the result is element j + 2k of the input. the transform is its own inverse
+                inline void transpose(__m256& a, __m256& b, __m256& c, __m256& d)
+                {
+                    const __m256 t0 = _mm256_unpacklo_ps(a, b);
+                    const __m256 t1 = _mm256_unpackhi_ps(a, b);
+                    const __m256 t2 = _mm256_unpacklo_ps(c, d);
+                    const __m256 t3 = _mm256_unpackhi_ps(c, d);
+
+                    a = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+                    b = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+                    c = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+                    d = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+                }
+
+                inline __m256 splat_x(__m256 v) { return _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)); }
+                inline __m256 splat_y(__m256 v) { return _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)); }
+                inline __m256 splat_z(__m256 v) { return _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)); }
+                inline __m256 splat_w(__m256 v) { return _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+                //two rows of a times b, the rows of b are in both lanes
+                inline __m256 mul_rows(__m256 a, __m256 b0, __m256 b1, __m256 b2, __m256 b3)
+                {
+                    __m256 r = _mm256_mul_ps(splat_x(a), b0);
+                    r = _mm256_fmadd_ps(splat_y(a), b1, r);
+                    r = _mm256_fmadd_ps(splat_z(a), b2, r);
+                    return _mm256_fmadd_ps(splat_w(a), b3, r);
+                }
+
+                inline void store_rows(float4x4* r, __m256 rows_01, __m256 rows_23)
+                {
+                    float* p = reinterpret_cast<float*>(r);
+                    _mm256_storeu_ps(p + 0, rows_01);
+                    _mm256_storeu_ps(p + 8, rows_23);
+                }
+
+                //row0, row1, row2 hold the rows of two matrices, one per lane, row3 is the same for both
+                inline void store_matrices(float4x4* r, __m256 row0, __m256 row1, __m256 row2, __m256 row3)
+                {
+                    float* p = reinterpret_cast<float*>(r);
+                    _mm256_storeu_ps(p + 0,  _mm256_permute2f128_ps(row0, row1, 0x20));
+                    _mm256_storeu_ps(p + 8,  _mm256_permute2f128_ps(row2, row3, 0x20));
+                    _mm256_storeu_ps(p + 16, _mm256_permute2f128_ps(row0, row1, 0x31));
+                    _mm256_storeu_ps(p + 24, _mm256_permute2f128_ps(row2, row3, 0x31));
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //one matrix per iteration, two rows per register
+            void mul_avx2(const float4x4* a, const float4x4* b, float4x4* r, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const float* pa = reinterpret_cast<const float*>(&a[i]);
+                    const float* pb = reinterpret_cast<const float*>(&b[i]);
+
+                    const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 0));
+                    const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 4));
+                    const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 8));
+                    const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 12));
+
+                    const __m256 r01 = mul_rows(_mm256_loadu_ps(pa + 0), b0, b1, b2, b3);
+                    const __m256 r23 = mul_rows(_mm256_loadu_ps(pa + 8), b0, b1, b2, b3);
+
+                    store_rows(&r[i], r01, r23);
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void mul_broadcast_avx2(const float4x4* a, const float4x4* b, float4x4* r, size_t count)
+            {
+                const float* pb = reinterpret_cast<const float*>(b);
+
+                const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 0));
+                const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 4));
+                const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 8));
+                const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pb + 12));
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const float* pa = reinterpret_cast<const float*>(&a[i]);
+
+                    const __m256 r01 = mul_rows(_mm256_loadu_ps(pa + 0), b0, b1, b2, b3);
+                    const __m256 r23 = mul_rows(_mm256_loadu_ps(pa + 8), b0, b1, b2, b3);
+
+                    store_rows(&r[i], r01, r23);
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //8 quaternions per iteration in structure of arrays form
+            void quaternion_2_matrix_avx2(const float4* q, float4x4* r, size_t count)
+            {
+                const __m256 one    = _mm256_set1_ps(1.0f);
+                const __m256 two    = _mm256_set1_ps(2.0f);
+                const __m256 zero   = _mm256_setzero_ps();
+                const __m256 r3     = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+
+                size_t i = 0;
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    const float* p = reinterpret_cast<const float*>(&q[i]);
+
+                    __m256 x = _mm256_loadu_ps(p + 0);
+                    __m256 y = _mm256_loadu_ps(p + 8);
+                    __m256 z = _mm256_loadu_ps(p + 16);
+                    __m256 w = _mm256_loadu_ps(p + 24);
+
+                    transpose(x, y, z, w);
+
+                    const __m256 x2 = _mm256_mul_ps(x, two);
+                    const __m256 y2 = _mm256_mul_ps(y, two);
+                    const __m256 z2 = _mm256_mul_ps(z, two);
+
+                    const __m256 xx = _mm256_mul_ps(x, x2);
+                    const __m256 xy = _mm256_mul_ps(x, y2);
+                    const __m256 xz = _mm256_mul_ps(x, z2);
+                    const __m256 xw = _mm256_mul_ps(w, x2);
+                    const __m256 yy = _mm256_mul_ps(y, y2);
+                    const __m256 yz = _mm256_mul_ps(y, z2);
+                    const __m256 yw = _mm256_mul_ps(w, y2);
+                    const __m256 zz = _mm256_mul_ps(z, z2);
+                    const __m256 zw = _mm256_mul_ps(w, z2);
+
+                    __m256 m00 = _mm256_sub_ps(one, _mm256_add_ps(yy, zz));
+                    __m256 m01 = _mm256_add_ps(xy, zw);
+                    __m256 m02 = _mm256_sub_ps(xz, yw);
+                    __m256 m03 = zero;
+
+                    __m256 m10 = _mm256_sub_ps(xy, zw);
+                    __m256 m11 = _mm256_sub_ps(one, _mm256_add_ps(xx, zz));
+                    __m256 m12 = _mm256_add_ps(yz, xw);
+                    __m256 m13 = zero;
+
+                    __m256 m20 = _mm256_add_ps(xz, yw);
+                    __m256 m21 = _mm256_sub_ps(yz, xw);
+                    __m256 m22 = _mm256_sub_ps(one, _mm256_add_ps(xx, yy));
+                    __m256 m23 = zero;
+
+                    transpose(m00, m01, m02, m03);
+                    transpose(m10, m11, m12, m13);
+                    transpose(m20, m21, m22, m23);
+
+                    //register k holds the rows of the elements 2k and 2k + 1
+                    const __m256 rows0[4] = { m00, m01, m02, m03 };
+                    const __m256 rows1[4] = { m10, m11, m12, m13 };
+                    const __m256 rows2[4] = { m20, m21, m22, m23 };
+
+                    for (auto k = 0U; k < 4; ++k)
+                    {
+                        store_matrices(&r[i + 2 * k], rows0[k], rows1[k], rows2[k], r3);
+                    }
+                }
+
+                quaternion_2_matrix_sse(q + i, r + i, count - i);
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //two vectors per register
+            void transform3_avx2(const float4* v, const float4x4* m, float4* r, size_t count, bool vector)
+            {
+                const float* pm = reinterpret_cast<const float*>(m);
+
+                const __m256 m0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pm + 0));
+                const __m256 m1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pm + 4));
+                const __m256 m2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pm + 8));
+                const __m256 m3 = vector ? _mm256_setzero_ps() : _mm256_broadcast_ps(reinterpret_cast<const __m128*>(pm + 12));
+
+                size_t i = 0;
+
+                for (; i + 4 <= count; i += 4)
+                {
+                    const float* p = reinterpret_cast<const float*>(&v[i]);
+                    float*       o = reinterpret_cast<float*>(&r[i]);
+
+                    const __m256 a = _mm256_loadu_ps(p + 0);
+                    const __m256 b = _mm256_loadu_ps(p + 8);
+
+                    const __m256 ra = _mm256_fmadd_ps(splat_z(a), m2, _mm256_fmadd_ps(splat_y(a), m1, _mm256_fmadd_ps(splat_x(a), m0, m3)));
+                    const __m256 rb = _mm256_fmadd_ps(splat_z(b), m2, _mm256_fmadd_ps(splat_y(b), m1, _mm256_fmadd_ps(splat_x(b), m0, m3)));
+
+                    _mm256_storeu_ps(o + 0, ra);
+                    _mm256_storeu_ps(o + 8, rb);
+                }
+
+                transform3_sse(v + i, m, r + i, count - i, vector);
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //8 quaternion pairs per iteration in structure of arrays form, eberly's polynomial slerp as in quaternion.h
+            void slerp_avx2(const float4* a, const float4* b, const float* t, float4* r, size_t count)
+            {
+                const float one_plus_mu = 1.90110745351730037f;
+
+                const __m256  one       = _mm256_set1_ps(1.0f);
+                const __m256  zero      = _mm256_setzero_ps();
+                const __m256  sign_bit  = _mm256_set1_ps(-0.0f);
+
+                //element j + 2k sits in lane j, slot k after the transpose
+                const __m256i t_order   = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+                size_t i = 0;
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    const float* pa = reinterpret_cast<const float*>(&a[i]);
+                    const float* pb = reinterpret_cast<const float*>(&b[i]);
+
+                    __m256 ax = _mm256_loadu_ps(pa + 0);
+                    __m256 ay = _mm256_loadu_ps(pa + 8);
+                    __m256 az = _mm256_loadu_ps(pa + 16);
+                    __m256 aw = _mm256_loadu_ps(pa + 24);
+
+                    __m256 bx = _mm256_loadu_ps(pb + 0);
+                    __m256 by = _mm256_loadu_ps(pb + 8);
+                    __m256 bz = _mm256_loadu_ps(pb + 16);
+                    __m256 bw = _mm256_loadu_ps(pb + 24);
+
+                    transpose(ax, ay, az, aw);
+                    transpose(bx, by, bz, bw);
+
+                    const __m256 t1 = _mm256_permutevar8x32_ps(_mm256_loadu_ps(t + i), t_order);
+                    const __m256 t0 = _mm256_sub_ps(one, t1);
+
+                    __m256 cs = _mm256_mul_ps(ax, bx);
+                    cs = _mm256_fmadd_ps(ay, by, cs);
+                    cs = _mm256_fmadd_ps(az, bz, cs);
+                    cs = _mm256_fmadd_ps(aw, bw, cs);
+
+                    //take the shortest path
+                    const __m256 sign   = _mm256_and_ps(_mm256_cmp_ps(cs, zero, _CMP_LT_OQ), sign_bit);
+                    const __m256 csm1   = _mm256_sub_ps(_mm256_xor_ps(cs, sign), one);
+
+                    __m256 c0 = t0;
+                    __m256 c1 = t1;
+                    __m256 u0 = t0;
+                    __m256 u1 = t1;
+
+                    const __m256 s0 = _mm256_mul_ps(t0, t0);
+                    const __m256 s1 = _mm256_mul_ps(t1, t1);
+
+                    for (auto k = 1U; k <= 9; ++k)
+                    {
+                        const float f     = k == 9 ? one_plus_mu : 1.0f;
+                        const __m256 av   = _mm256_set1_ps(f / (k * (2.0f * k + 1.0f)));
+                        const __m256 bv   = _mm256_set1_ps(f * k / (2.0f * k + 1.0f));
+
+                        c0 = _mm256_mul_ps(c0, _mm256_mul_ps(_mm256_fmsub_ps(av, s0, bv), csm1));
+                        c1 = _mm256_mul_ps(c1, _mm256_mul_ps(_mm256_fmsub_ps(av, s1, bv), csm1));
+
+                        u0 = _mm256_add_ps(u0, c0);
+                        u1 = _mm256_add_ps(u1, c1);
+                    }
+
+                    u1 = _mm256_xor_ps(u1, sign);
+
+                    __m256 rx = _mm256_fmadd_ps(u1, bx, _mm256_mul_ps(u0, ax));
+                    __m256 ry = _mm256_fmadd_ps(u1, by, _mm256_mul_ps(u0, ay));
+                    __m256 rz = _mm256_fmadd_ps(u1, bz, _mm256_mul_ps(u0, az));
+                    __m256 rw = _mm256_fmadd_ps(u1, bw, _mm256_mul_ps(u0, aw));
+
+                    transpose(rx, ry, rz, rw);
+
+                    float* o = reinterpret_cast<float*>(&r[i]);
+                    _mm256_storeu_ps(o + 0, rx);
+                    _mm256_storeu_ps(o + 8, ry);
+                    _mm256_storeu_ps(o + 16, rz);
+                    _mm256_storeu_ps(o + 24, rw);
+                }
+
+                slerp_sse(a + i, b + i, t + i, r + i, count - i);
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
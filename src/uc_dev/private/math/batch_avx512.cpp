@@ -0,0 +1,279 @@
+#include "pch.h"
+
+#include <uc_dev/math/batch.h>
+
+namespace uc
+{
+    namespace math
+    {
+        namespace details
+        {
+            namespace
+            {
+                //transposes 4x4 blocks in every 128 bit lane. with a, b, c, d loaded from 16 consecutive float4,
+                //lane j, element k of the result is element j + 4k of the input. the transform is its own inverse
+                inline void transpose(__m512& a, __m512& b, __m512& c, __m512& d)
+                {
+                    const __m512 t0 = _mm512_unpacklo_ps(a, b);
+                    const __m512 t1 = _mm512_unpackhi_ps(a, b);
+                    const __m512 t2 = _mm512_unpacklo_ps(c, d);
+                    const __m512 t3 = _mm512_unpackhi_ps(c, d);
+
+                    a = _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+                    b = _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+                    c = _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+                    d = _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+                }
+
+                inline __m512 splat_x(__m512 v) { return _mm512_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)); }
+                inline __m512 splat_y(__m512 v) { return _mm512_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)); }
+                inline __m512 splat_z(__m512 v) { return _mm512_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)); }
+                inline __m512 splat_w(__m512 v) { return _mm512_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+                inline __m512 broadcast_row(const float* p)
+                {
+                    return _mm512_broadcast_f32x4(_mm_loadu_ps(p));
+                }
+
+                //the four rows of a times b, the rows of b are in all lanes
+                inline __m512 mul_rows(__m512 a, __m512 b0, __m512 b1, __m512 b2, __m512 b3)
+                {
+                    __m512 r = _mm512_mul_ps(splat_x(a), b0);
+                    r = _mm512_fmadd_ps(splat_y(a), b1, r);
+                    r = _mm512_fmadd_ps(splat_z(a), b2, r);
+                    return _mm512_fmadd_ps(splat_w(a), b3, r);
+                }
+
+                //row0, row1, row2 hold the rows of four matrices, one per lane, row3 is the same for all. transposes the 128 bit lanes
+                inline void store_matrices(float4x4* r, __m512 row0, __m512 row1, __m512 row2, __m512 row3)
+                {
+                    const __m512 t0 = _mm512_shuffle_f32x4(row0, row1, _MM_SHUFFLE(1, 0, 1, 0));
+                    const __m512 t1 = _mm512_shuffle_f32x4(row0, row1, _MM_SHUFFLE(3, 2, 3, 2));
+                    const __m512 t2 = _mm512_shuffle_f32x4(row2, row3, _MM_SHUFFLE(1, 0, 1, 0));
+                    const __m512 t3 = _mm512_shuffle_f32x4(row2, row3, _MM_SHUFFLE(3, 2, 3, 2));
+
+                    _mm512_storeu_ps(&r[0], _mm512_shuffle_f32x4(t0, t2, _MM_SHUFFLE(2, 0, 2, 0)));
+                    _mm512_storeu_ps(&r[1], _mm512_shuffle_f32x4(t0, t2, _MM_SHUFFLE(3, 1, 3, 1)));
+                    _mm512_storeu_ps(&r[2], _mm512_shuffle_f32x4(t1, t3, _MM_SHUFFLE(2, 0, 2, 0)));
+                    _mm512_storeu_ps(&r[3], _mm512_shuffle_f32x4(t1, t3, _MM_SHUFFLE(3, 1, 3, 1)));
+                }
+            }
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //one matrix per register
+            void mul_avx512(const float4x4* a, const float4x4* b, float4x4* r, size_t count)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const float* pb = reinterpret_cast<const float*>(&b[i]);
+
+                    const __m512 b0 = broadcast_row(pb + 0);
+                    const __m512 b1 = broadcast_row(pb + 4);
+                    const __m512 b2 = broadcast_row(pb + 8);
+                    const __m512 b3 = broadcast_row(pb + 12);
+
+                    const __m512 m  = mul_rows(_mm512_loadu_ps(&a[i]), b0, b1, b2, b3);
+
+                    _mm512_storeu_ps(&r[i], m);
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            void mul_broadcast_avx512(const float4x4* a, const float4x4* b, float4x4* r, size_t count)
+            {
+                const float* pb = reinterpret_cast<const float*>(b);
+
+                const __m512 b0 = broadcast_row(pb + 0);
+                const __m512 b1 = broadcast_row(pb + 4);
+                const __m512 b2 = broadcast_row(pb + 8);
+                const __m512 b3 = broadcast_row(pb + 12);
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    _mm512_storeu_ps(&r[i], mul_rows(_mm512_loadu_ps(&a[i]), b0, b1, b2, b3));
+                }
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //16 quaternions per iteration in structure of arrays form
+            void quaternion_2_matrix_avx512(const float4* q, float4x4* r, size_t count)
+            {
+                const __m512 one    = _mm512_set1_ps(1.0f);
+                const __m512 two    = _mm512_set1_ps(2.0f);
+                const __m512 zero   = _mm512_setzero_ps();
+                const __m512 r3     = _mm512_broadcast_f32x4(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+
+                size_t i = 0;
+
+                for (; i + 16 <= count; i += 16)
+                {
+                    const float* p = reinterpret_cast<const float*>(&q[i]);
+
+                    __m512 x = _mm512_loadu_ps(p + 0);
+                    __m512 y = _mm512_loadu_ps(p + 16);
+                    __m512 z = _mm512_loadu_ps(p + 32);
+                    __m512 w = _mm512_loadu_ps(p + 48);
+
+                    transpose(x, y, z, w);
+
+                    const __m512 x2 = _mm512_mul_ps(x, two);
+                    const __m512 y2 = _mm512_mul_ps(y, two);
+                    const __m512 z2 = _mm512_mul_ps(z, two);
+
+                    const __m512 xx = _mm512_mul_ps(x, x2);
+                    const __m512 xy = _mm512_mul_ps(x, y2);
+                    const __m512 xz = _mm512_mul_ps(x, z2);
+                    const __m512 xw = _mm512_mul_ps(w, x2);
+                    const __m512 yy = _mm512_mul_ps(y, y2);
+                    const __m512 yz = _mm512_mul_ps(y, z2);
+                    const __m512 yw = _mm512_mul_ps(w, y2);
+                    const __m512 zz = _mm512_mul_ps(z, z2);
+                    const __m512 zw = _mm512_mul_ps(w, z2);
+
+                    __m512 m00 = _mm512_sub_ps(one, _mm512_add_ps(yy, zz));
+                    __m512 m01 = _mm512_add_ps(xy, zw);
+                    __m512 m02 = _mm512_sub_ps(xz, yw);
+                    __m512 m03 = zero;
+
+                    __m512 m10 = _mm512_sub_ps(xy, zw);
+                    __m512 m11 = _mm512_sub_ps(one, _mm512_add_ps(xx, zz));
+                    __m512 m12 = _mm512_add_ps(yz, xw);
+                    __m512 m13 = zero;
+
+                    __m512 m20 = _mm512_add_ps(xz, yw);
+                    __m512 m21 = _mm512_sub_ps(yz, xw);
+                    __m512 m22 = _mm512_sub_ps(one, _mm512_add_ps(xx, yy));
+                    __m512 m23 = zero;
+
+                    transpose(m00, m01, m02, m03);
+                    transpose(m10, m11, m12, m13);
+                    transpose(m20, m21, m22, m23);
+
+                    //register k holds the rows of the elements 4k to 4k + 3
+                    const __m512 rows0[4] = { m00, m01, m02, m03 };
+                    const __m512 rows1[4] = { m10, m11, m12, m13 };
+                    const __m512 rows2[4] = { m20, m21, m22, m23 };
+
+                    for (auto k = 0U; k < 4; ++k)
+                    {
+                        store_matrices(&r[i + 4 * k], rows0[k], rows1[k], rows2[k], r3);
+                    }
+                }
+
+                quaternion_2_matrix_avx2(q + i, r + i, count - i);
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //four vectors per register
+            void transform3_avx512(const float4* v, const float4x4* m, float4* r, size_t count, bool vector)
+            {
+                const float* pm = reinterpret_cast<const float*>(m);
+
+                const __m512 m0 = broadcast_row(pm + 0);
+                const __m512 m1 = broadcast_row(pm + 4);
+                const __m512 m2 = broadcast_row(pm + 8);
+                const __m512 m3 = vector ? _mm512_setzero_ps() : broadcast_row(pm + 12);
+
+                size_t i = 0;
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    const float* p = reinterpret_cast<const float*>(&v[i]);
+                    float*       o = reinterpret_cast<float*>(&r[i]);
+
+                    const __m512 a = _mm512_loadu_ps(p + 0);
+                    const __m512 b = _mm512_loadu_ps(p + 16);
+
+                    const __m512 ra = _mm512_fmadd_ps(splat_z(a), m2, _mm512_fmadd_ps(splat_y(a), m1, _mm512_fmadd_ps(splat_x(a), m0, m3)));
+                    const __m512 rb = _mm512_fmadd_ps(splat_z(b), m2, _mm512_fmadd_ps(splat_y(b), m1, _mm512_fmadd_ps(splat_x(b), m0, m3)));
+
+                    _mm512_storeu_ps(o + 0, ra);
+                    _mm512_storeu_ps(o + 16, rb);
+                }
+
+                transform3_avx2(v + i, m, r + i, count - i, vector);
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //16 quaternion pairs per iteration in structure of arrays form, eberly's polynomial slerp as in quaternion.h
+            void slerp_avx512(const float4* a, const float4* b, const float* t, float4* r, size_t count)
+            {
+                const float one_plus_mu = 1.90110745351730037f;
+
+                const __m512  one       = _mm512_set1_ps(1.0f);
+                const __m512  zero      = _mm512_setzero_ps();
+
+                //element j + 4k sits in lane j, slot k after the transpose
+                const __m512i t_order   = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+
+                size_t i = 0;
+
+                for (; i + 16 <= count; i += 16)
+                {
+                    const float* pa = reinterpret_cast<const float*>(&a[i]);
+                    const float* pb = reinterpret_cast<const float*>(&b[i]);
+
+                    __m512 ax = _mm512_loadu_ps(pa + 0);
+                    __m512 ay = _mm512_loadu_ps(pa + 16);
+                    __m512 az = _mm512_loadu_ps(pa + 32);
+                    __m512 aw = _mm512_loadu_ps(pa + 48);
+
+                    __m512 bx = _mm512_loadu_ps(pb + 0);
+                    __m512 by = _mm512_loadu_ps(pb + 16);
+                    __m512 bz = _mm512_loadu_ps(pb + 32);
+                    __m512 bw = _mm512_loadu_ps(pb + 48);
+
+                    transpose(ax, ay, az, aw);
+                    transpose(bx, by, bz, bw);
+
+                    const __m512 t1 = _mm512_permutexvar_ps(t_order, _mm512_loadu_ps(t + i));
+                    const __m512 t0 = _mm512_sub_ps(one, t1);
+
+                    __m512 cs = _mm512_mul_ps(ax, bx);
+                    cs = _mm512_fmadd_ps(ay, by, cs);
+                    cs = _mm512_fmadd_ps(az, bz, cs);
+                    cs = _mm512_fmadd_ps(aw, bw, cs);
+
+                    //take the shortest path
+                    const __mmask16 negative = _mm512_cmp_ps_mask(cs, zero, _CMP_LT_OQ);
+                    const __m512    csm1     = _mm512_sub_ps(_mm512_mask_sub_ps(cs, negative, zero, cs), one);
+
+                    __m512 c0 = t0;
+                    __m512 c1 = t1;
+                    __m512 u0 = t0;
+                    __m512 u1 = t1;
+
+                    const __m512 s0 = _mm512_mul_ps(t0, t0);
+                    const __m512 s1 = _mm512_mul_ps(t1, t1);
+
+                    for (auto k = 1U; k <= 9; ++k)
+                    {
+                        const float f     = k == 9 ? one_plus_mu : 1.0f;
+                        const __m512 av   = _mm512_set1_ps(f / (k * (2.0f * k + 1.0f)));
+                        const __m512 bv   = _mm512_set1_ps(f * k / (2.0f * k + 1.0f));
+
+                        c0 = _mm512_mul_ps(c0, _mm512_mul_ps(_mm512_fmsub_ps(av, s0, bv), csm1));
+                        c1 = _mm512_mul_ps(c1, _mm512_mul_ps(_mm512_fmsub_ps(av, s1, bv), csm1));
+
+                        u0 = _mm512_add_ps(u0, c0);
+                        u1 = _mm512_add_ps(u1, c1);
+                    }
+
+                    u1 = _mm512_mask_sub_ps(u1, negative, zero, u1);
+
+                    __m512 rx = _mm512_fmadd_ps(u1, bx, _mm512_mul_ps(u0, ax));
+                    __m512 ry = _mm512_fmadd_ps(u1, by, _mm512_mul_ps(u0, ay));
+                    __m512 rz = _mm512_fmadd_ps(u1, bz, _mm512_mul_ps(u0, az));
+                    __m512 rw = _mm512_fmadd_ps(u1, bw, _mm512_mul_ps(u0, aw));
+
+                    transpose(rx, ry, rz, rw);
+
+                    float* o = reinterpret_cast<float*>(&r[i]);
+                    _mm512_storeu_ps(o + 0, rx);
+                    _mm512_storeu_ps(o + 16, ry);
+                    _mm512_storeu_ps(o + 32, rz);
+                    _mm512_storeu_ps(o + 48, rw);
+                }
+
+                slerp_avx2(a + i, b + i, t + i, r + i, count - i);
+            }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+}
@@ -2,7 +2,9 @@
 
 #include <uc_dev/math/geometry_convex_clipping.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <unordered_map>
 #include <tuple>
 
@@ -126,7 +128,7 @@ namespace uc
                                         f.m_edges.erase(std::remove_if(f.m_edges.begin(), f.m_edges.end(), [i](int32_t e0)
                                         {
                                             return i == e0;
-                                        }));
+                                        }), f.m_edges.end());
 
                                         if (f.m_edges.empty())
                                         {
@@ -651,7 +653,7 @@ namespace uc
                             {
                                 if (get_x(dot4(plane.m_value, v)) > 0.00001f)
                                 {
-                                    r.m_faces[i].m_plane.m_value = mul( plane.m_value, set(-1.0f, -1.0f, -1.0f, 1.0f) );
+                                    r.m_faces[i].m_plane.m_value = negate(plane.m_value);
                                     break;
                                 }
                             }
@@ -748,27 +750,26 @@ namespace uc
                 std::vector<plane> planes;
                 planes.resize(body.m_faces.size());
 
-                //compute planes
+                float4 center = zero();
+
+                for (auto&& v : body.m_points)
+                {
+                    center = add(center, v);
+                }
+
+                center = div(center, splat(static_cast<float>(body.m_points.size())));
+
+                //compute planes, normals point inside
                 for (auto i = 0U; i < planes.size(); ++i)
                 {
                     const float4 a = body.m_points[body.m_faces[i].m_indices[0]];
                     const float4 b = body.m_points[body.m_faces[i].m_indices[1]];
                     const float4 c = body.m_points[body.m_faces[i].m_indices[2]];
                     planes[i] = make_plane(a, b, c);
-                }
 
-                //orient normals to point inside
-                for (auto i = 0U; i < planes.size(); ++i)
-                {
-                    auto plane = planes[i];
-
-                    for (auto&& v : body.m_points)
+                    if (get_x(dot4(planes[i].m_value, center)) < 0.0f)
                     {
-                        if (get_x( dot4( plane.m_value, v ) ) > 0.00001f)
-                        {
-                            planes[i].m_value = mul(plane.m_value, set(-1.0f, -1.0f, -1.0f, 1.0f));
-                            break;
-                        }
+                        planes[i].m_value = negate(planes[i].m_value);
                     }
                 }
 
@@ -777,7 +778,8 @@ namespace uc
 
                 for (auto i = 0U; i < face_vector.size(); ++i)
                 {
-                    face_vector[i] = get_x(dot3(planes[i].m_value, vector) ) > 0.0f;
+                    //normals point inside, so the faces looking along the vector have them opposite to it
+                    face_vector[i] = get_x(dot3(planes[i].m_value, vector) ) < 0.0f;
                 }
 
                 //1. duplicate points and indices
@@ -885,7 +887,7 @@ namespace uc
                     {
                         if (get_x(dot4(plane.m_value, v) ) > 0.00001f)
                         {
-                            planes[i].m_value = mul(planes[i].m_value, set(-1.0f, -1.0f, -1.0f, 1.0f));
+                            planes[i].m_value = negate(planes[i].m_value);
                             break;
                         }
                     }
@@ -927,6 +929,536 @@ namespace uc
                 return r;
             }
 
+            namespace
+            {
+                //clips a convex polyhedron with a plane in place of the topological clipper above, everything in fixed arrays
+                struct fixed_clipper
+                {
+                    using polyhedron = fixed_convex_polyhedron;
+
+                    struct split_edge
+                    {
+                        uint8_t m_v0;
+                        uint8_t m_v1;
+                        uint8_t m_point;
+                    };
+
+                    static bool add_point(polyhedron& r, float4 p)
+                    {
+                        if (r.m_point_count == polyhedron::max_points)
+                        {
+                            return false;
+                        }
+
+                        r.m_points[r.m_point_count++] = p;
+                        return true;
+                    }
+
+                    //the face in progress is m_indices[m_faces[m_face_count], m_faces[m_face_count + 1])
+                    static bool add_index(polyhedron& r, uint32_t index)
+                    {
+                        if (r.m_face_count == polyhedron::max_faces || r.m_faces[r.m_face_count + 1] == polyhedron::max_indices)
+                        {
+                            return false;
+                        }
+
+                        r.m_indices[r.m_faces[r.m_face_count + 1]++] = static_cast<uint8_t>(index);
+                        return true;
+                    }
+
+                    static uint32_t face_in_progress_size(const polyhedron& r)
+                    {
+                        return r.m_face_count == polyhedron::max_faces ? 0 : r.m_faces[r.m_face_count + 1] - r.m_faces[r.m_face_count];
+                    }
+
+                    static void drop_face(polyhedron& r)
+                    {
+                        if (r.m_face_count < polyhedron::max_faces)
+                        {
+                            r.m_faces[r.m_face_count + 1] = r.m_faces[r.m_face_count];
+                        }
+                    }
+
+                    static bool end_face(polyhedron& r)
+                    {
+                        if (r.m_face_count == polyhedron::max_faces)
+                        {
+                            return false;
+                        }
+
+                        r.m_face_count++;
+
+                        if (r.m_face_count < polyhedron::max_faces)
+                        {
+                            r.m_faces[r.m_face_count + 1] = r.m_faces[r.m_face_count];
+                        }
+
+                        return true;
+                    }
+
+                    static void begin(polyhedron& r)
+                    {
+                        r.m_point_count = 0;
+                        r.m_face_count  = 0;
+                        r.m_faces[0]    = 0;
+                        r.m_faces[1]    = 0;
+                    }
+
+                    enum clip_result : int32_t
+                    {
+                        all_clipped = -1,
+                        clipped     = 0,
+                        not_clipped = 1,
+                        overflow    = 2
+                    };
+
+                    static clip_result clip(const polyhedron& p, const plane& clip_plane, polyhedron& r)
+                    {
+                        const float epsilon = 0.00001f;
+
+                        std::array<float, polyhedron::max_points>   distance;
+                        std::array<uint8_t, polyhedron::max_points> remap;
+                        std::array<bool, polyhedron::max_points>    on_plane;
+
+                        uint32_t positive = 0;
+                        uint32_t negative = 0;
+
+                        for (auto i = 0U; i < p.m_point_count; ++i)
+                        {
+                            float d = get_x(dot4(clip_plane.m_value, p.m_points[i]));
+
+                            if (d >= epsilon)
+                            {
+                                positive++;
+                            }
+                            else if (d <= -epsilon)
+                            {
+                                negative++;
+                            }
+                            else
+                            {
+                                d = 0.0f;
+                            }
+
+                            distance[i] = d;
+                        }
+
+                        if (negative == 0)
+                        {
+                            return not_clipped;
+                        }
+
+                        if (positive == 0)
+                        {
+                            return all_clipped;
+                        }
+
+                        begin(r);
+
+                        //keep the points on the non negative side
+                        for (auto i = 0U; i < p.m_point_count; ++i)
+                        {
+                            if (distance[i] >= 0.0f)
+                            {
+                                remap[i] = static_cast<uint8_t>(r.m_point_count);
+                                on_plane[r.m_point_count] = distance[i] == 0.0f;
+                                add_point(r, p.m_points[i]);
+                            }
+                        }
+
+                        std::array<split_edge, polyhedron::max_points> split;
+                        uint32_t split_count = 0;
+
+                        bool fits = true;
+
+                        for (auto f = 0U; f < p.m_face_count && fits; ++f)
+                        {
+                            const uint32_t face_begin   = p.m_faces[f];
+                            const uint32_t face_size    = p.m_faces[f + 1] - face_begin;
+
+                            for (auto k = 0U; k < face_size && fits; ++k)
+                            {
+                                const uint32_t i0 = p.m_indices[face_begin + k];
+                                const uint32_t i1 = p.m_indices[face_begin + (k + 1) % face_size];
+
+                                const float d0 = distance[i0];
+                                const float d1 = distance[i1];
+
+                                if (d0 >= 0.0f)
+                                {
+                                    fits = fits && add_index(r, remap[i0]);
+                                }
+
+                                if ((d0 > 0.0f && d1 < 0.0f) || (d0 < 0.0f && d1 > 0.0f))
+                                {
+                                    //the edge is shared by two faces, split it once
+                                    const uint8_t v0 = static_cast<uint8_t>(std::min(i0, i1));
+                                    const uint8_t v1 = static_cast<uint8_t>(std::max(i0, i1));
+
+                                    uint32_t s = 0;
+                                    for (; s < split_count; ++s)
+                                    {
+                                        if (split[s].m_v0 == v0 && split[s].m_v1 == v1)
+                                        {
+                                            break;
+                                        }
+                                    }
+
+                                    if (s == split_count)
+                                    {
+                                        const float t = d0 / (d0 - d1);
+
+                                        fits = fits && add_point(r, lerp(p.m_points[i0], p.m_points[i1], t));
+                                        on_plane[r.m_point_count - 1] = true;
+                                        split[split_count++] = { v0, v1, static_cast<uint8_t>(r.m_point_count - 1) };
+                                    }
+
+                                    fits = fits && add_index(r, split[s].m_point);
+                                }
+                            }
+
+                            if (face_in_progress_size(r) < 3)
+                            {
+                                //face was culled or collapsed on the plane
+                                drop_face(r);
+                            }
+                            else
+                            {
+                                fits = fits && end_face(r);
+                            }
+                        }
+
+                        //the new face closes the hole on the clip plane
+                        if (fits)
+                        {
+                            fits = close_face(r, clip_plane, on_plane);
+                        }
+
+                        return fits ? clipped : overflow;
+                    }
+
+                    static bool close_face(polyhedron& r, const plane& clip_plane, const std::array<bool, polyhedron::max_points>& on_plane)
+                    {
+                        std::array<uint8_t, polyhedron::max_points> cap;
+                        std::array<float, polyhedron::max_points>   angle;
+                        uint32_t cap_count = 0;
+
+                        float4 center = zero();
+
+                        for (auto i = 0U; i < r.m_point_count; ++i)
+                        {
+                            if (on_plane[i])
+                            {
+                                cap[cap_count++] = static_cast<uint8_t>(i);
+                                center = add(center, r.m_points[i]);
+                            }
+                        }
+
+                        if (cap_count < 3)
+                        {
+                            return true;
+                        }
+
+                        center = div(center, splat(static_cast<float>(cap_count)));
+
+                        //order around the center, counterclockwise when looking along the plane normal
+                        const float4 n = clip_plane.m_value;
+                        const float4 u = normalize3(sub(r.m_points[cap[0]], center));
+                        const float4 v = cross3(n, u);
+
+                        for (auto i = 0U; i < cap_count; ++i)
+                        {
+                            const float4 d  = sub(r.m_points[cap[i]], center);
+                            angle[i]        = std::atan2(get_x(dot3(d, v)), get_x(dot3(d, u)));
+                        }
+
+                        for (auto i = 1U; i < cap_count; ++i)
+                        {
+                            for (auto j = i; j > 0 && angle[j - 1] > angle[j]; --j)
+                            {
+                                std::swap(angle[j - 1], angle[j]);
+                                std::swap(cap[j - 1], cap[j]);
+                            }
+                        }
+
+                        for (auto i = 0U; i < cap_count; ++i)
+                        {
+                            if (!add_index(r, cap[i]))
+                            {
+                                return false;
+                            }
+                        }
+
+                        return end_face(r);
+                    }
+
+                    static bool clip(polyhedron& p, const aabb& b)
+                    {
+                        auto planes = make_face_planes(b);
+
+                        polyhedron t;
+
+                        for (auto i = 0U; i < planes.size(); ++i)
+                        {
+                            auto c = clip(p, planes[i], t);
+
+                            if (c == all_clipped || c == overflow)
+                            {
+                                return false;
+                            }
+
+                            if (c == clipped)
+                            {
+                                p = t;
+                            }
+                        }
+
+                        return true;
+                    }
+
+                    //face planes with the normals pointing inside
+                    static void make_planes(const polyhedron& p, std::array<plane, polyhedron::max_faces>& planes)
+                    {
+                        float4 center = zero();
+
+                        for (auto i = 0U; i < p.m_point_count; ++i)
+                        {
+                            center = add(center, p.m_points[i]);
+                        }
+
+                        center = div(center, splat(static_cast<float>(p.m_point_count)));
+
+                        for (auto i = 0U; i < p.m_face_count; ++i)
+                        {
+                            const uint32_t face = p.m_faces[i];
+
+                            planes[i] = make_plane(p.m_points[p.m_indices[face]], p.m_points[p.m_indices[face + 1]], p.m_points[p.m_indices[face + 2]]);
+
+                            if (get_x(dot4(planes[i].m_value, center)) < 0.0f)
+                            {
+                                planes[i].m_value = negate(planes[i].m_value);
+                            }
+                        }
+                    }
+
+                    //the face, which shares the directed edge v0, v1 with face f
+                    static uint32_t adjacent_face(const polyhedron& p, uint32_t f, uint32_t v0, uint32_t v1)
+                    {
+                        for (auto i = 0U; i < p.m_face_count; ++i)
+                        {
+                            if (i == f)
+                            {
+                                continue;
+                            }
+
+                            const uint32_t face_begin   = p.m_faces[i];
+                            const uint32_t face_size    = p.m_faces[i + 1] - face_begin;
+
+                            for (auto k = 0U; k < face_size; ++k)
+                            {
+                                const uint32_t i0 = p.m_indices[face_begin + k];
+                                const uint32_t i1 = p.m_indices[face_begin + (k + 1) % face_size];
+
+                                if ((i0 == v0 && i1 == v1) || (i0 == v1 && i1 == v0))
+                                {
+                                    return i;
+                                }
+                            }
+                        }
+
+                        return polyhedron::max_faces;
+                    }
+                };
+            }
+
+            bool clip(const frustum_points& f, const aabb& b, fixed_convex_polyhedron& r)
+            {
+                const uint8_t indices[6][4] =
+                {
+                    { 0,3,7,4 },
+                    { 1,5,6,2 },
+                    { 3,2,6,7 },
+                    { 4,5,1,0 },
+                    { 0,1,2,3 },
+                    { 5,4,7,6 }
+                };
+
+                fixed_clipper::begin(r);
+
+                for (auto&& p : f.m_points)
+                {
+                    fixed_clipper::add_point(r, p);
+                }
+
+                for (auto i = 0U; i < 6; ++i)
+                {
+                    for (auto j = 0U; j < 4; ++j)
+                    {
+                        fixed_clipper::add_index(r, indices[i][j]);
+                    }
+
+                    fixed_clipper::end_face(r);
+                }
+
+                return fixed_clipper::clip(r, b);
+            }
+
+            bool clip(const fixed_convex_polyhedron& f, const aabb& b, fixed_convex_polyhedron& r)
+            {
+                r = f;
+                return fixed_clipper::clip(r, b);
+            }
+
+            bool convex_hull_with_direction(const fixed_convex_polyhedron& body, float4 vector, fixed_convex_polyhedron& r)
+            {
+                using polyhedron = fixed_convex_polyhedron;
+
+                std::array<plane, polyhedron::max_faces> planes;
+                std::array<bool, polyhedron::max_faces>  face_vector;
+                std::array<uint8_t, polyhedron::max_points> points_indices;
+
+                fixed_clipper::make_planes(body, planes);
+
+                fixed_clipper::begin(r);
+
+                r.m_point_count = body.m_point_count;
+
+                std::copy(body.m_points.begin(), body.m_points.begin() + body.m_point_count, r.m_points.begin());
+
+                for (auto i = 0U; i < body.m_face_count; ++i)
+                {
+                    //normals point inside, so the faces looking along the vector have them opposite to it
+                    face_vector[i] = get_x(dot3(planes[i].m_value, vector)) < 0.0f;
+                }
+
+                //1. duplicate the points of the vector facing faces and move them
+                const uint8_t not_split = 0xFF;
+                std::fill(points_indices.begin(), points_indices.begin() + body.m_point_count, not_split);
+
+                for (auto i = 0U; i < body.m_face_count; ++i)
+                {
+                    if (face_vector[i])
+                    {
+                        for (auto k = body.m_faces[i]; k < body.m_faces[i + 1]; ++k)
+                        {
+                            const uint32_t index = body.m_indices[k];
+
+                            if (points_indices[index] == not_split)
+                            {
+                                points_indices[index] = static_cast<uint8_t>(r.m_point_count);
+
+                                if (!fixed_clipper::add_point(r, add(body.m_points[index], vector)))
+                                {
+                                    return false;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                //2. the faces, vector facing ones use the moved points
+                bool fits = true;
+
+                for (auto i = 0U; i < body.m_face_count && fits; ++i)
+                {
+                    for (auto k = body.m_faces[i]; k < body.m_faces[i + 1] && fits; ++k)
+                    {
+                        const uint32_t index = body.m_indices[k];
+                        fits = fixed_clipper::add_index(r, face_vector[i] ? points_indices[index] : index);
+                    }
+
+                    fits = fits && fixed_clipper::end_face(r);
+                }
+
+                //3. patch with quads along the silhouette, where a moved face meets a fixed one
+                for (auto i = 0U; i < body.m_face_count && fits; ++i)
+                {
+                    if (!face_vector[i])
+                    {
+                        continue;
+                    }
+
+                    const uint32_t face_begin   = body.m_faces[i];
+                    const uint32_t face_size    = body.m_faces[i + 1] - face_begin;
+
+                    for (auto k = 0U; k < face_size && fits; ++k)
+                    {
+                        const uint32_t index_0 = body.m_indices[face_begin + k];
+                        const uint32_t index_1 = body.m_indices[face_begin + (k + 1) % face_size];
+
+                        const uint32_t adjacent = fixed_clipper::adjacent_face(body, i, index_0, index_1);
+
+                        if (adjacent != polyhedron::max_faces && face_vector[adjacent])
+                        {
+                            continue;
+                        }
+
+                        fits = fits && fixed_clipper::add_index(r, index_0);
+                        fits = fits && fixed_clipper::add_index(r, index_1);
+                        fits = fits && fixed_clipper::add_index(r, points_indices[index_1]);
+                        fits = fits && fixed_clipper::add_index(r, points_indices[index_0]);
+                        fits = fits && fixed_clipper::end_face(r);
+                    }
+                }
+
+                return fits;
+            }
+
+            bool convex_hull_with_direction(const fixed_convex_polyhedron& body, float4 vector, const aabb& clip_body, fixed_convex_polyhedron& r)
+            {
+                float d = get_x(length4(clip_body.m_diagonal));
+                return convex_hull_with_direction(body, mul(splat(d), vector), r);
+            }
+
+            convex_polyhedron make_convex_polyhedron(const fixed_convex_polyhedron& p)
+            {
+                convex_polyhedron r;
+
+                r.m_points.assign(p.m_points.begin(), p.m_points.begin() + p.m_point_count);
+                r.m_faces.resize(p.m_face_count);
+
+                for (auto i = 0U; i < p.m_face_count; ++i)
+                {
+                    r.m_faces[i].m_indices.assign(p.m_indices.begin() + p.m_faces[i], p.m_indices.begin() + p.m_faces[i + 1]);
+                }
+
+                return r;
+            }
+
+            const fixed_convex_polyhedron* convex_hull_cache::convex_hull_with_direction(const frustum_points& f, const aabb& scene, float4 vector)
+            {
+                if (m_valid)
+                {
+                    auto distance = [](float4 a, float4 b)
+                    {
+                        float4 d = sub(a, b);
+                        return dot3(d, d);
+                    };
+
+                    float4 d = max(distance(m_scene.m_center, scene.m_center), distance(m_scene.m_diagonal, scene.m_diagonal));
+                    d = max(d, distance(m_vector, vector));
+
+                    for (auto i = 0U; i < f.m_points.size(); ++i)
+                    {
+                        d = max(d, distance(m_frustum.m_points[i], f.m_points[i]));
+                    }
+
+                    if (get_x(d) <= m_tolerance * m_tolerance)
+                    {
+                        return m_empty ? nullptr : &m_hull;
+                    }
+                }
+
+                m_frustum   = f;
+                m_scene     = scene;
+                m_vector    = vector;
+                m_valid     = true;
+
+                m_empty     = !clip(f, scene, m_clipped) || !convex_clipping::convex_hull_with_direction(m_clipped, vector, scene, m_hull);
+
+                return m_empty ? nullptr : &m_hull;
+            }
+
         }
     }
 }
@@ -73,7 +73,7 @@ namespace UniqueCreator
 
         const void* SkinnedModel::GetIndex() const
         {
-            return m_impl->m_model->m_indices.data();
+            return m_impl->indices();
         }
 
         uint64_t    SkinnedModel::GetIndexSize() const
@@ -34,9 +34,27 @@ namespace UniqueCreator
                     m_texture_storage[i]    = std::make_unique<Texture2DMipChainInternal>(&m_model->m_textures[i]);
                     m_texture_wrappers[i]   = m_texture_storage[i].get();
                 }
+
+                //the public interface hands out 32 bit indices
+                if (m_model->m_indices.is_16_bit())
+                {
+                    auto& indices = m_model->m_indices;
+                    m_indices_32.resize(indices.size());
+
+                    for (auto i = 0U; i < indices.size(); ++i)
+                    {
+                        m_indices_32[i] = indices[i];
+                    }
+                }
+            }
+
+            const uc::lip::index* indices() const
+            {
+                return m_model->m_indices.is_16_bit() ? m_indices_32.data() : m_model->m_indices.data();
             }
 
             uc::lip::unique_lip_pointer<uc::lip::derivatives_skinned_model> m_model;
+            std::vector< uc::lip::index >                       m_indices_32;
             std::vector< Texture2DMipChain* >                   m_texture_wrappers;
             std::vector< std::unique_ptr<Texture2DMipChain> >   m_texture_storage;
         };